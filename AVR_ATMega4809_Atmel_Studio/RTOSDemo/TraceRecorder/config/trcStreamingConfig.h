@@ -137,6 +137,69 @@ extern "C" {
  ******************************************************************************/
 #define TRC_CFG_ISR_TAILCHAINING_THRESHOLD 0
 
+/*******************************************************************************
+ * Configuration Macro: TRC_CFG_USE_EVENT_RINGS
+ *
+ * If 1, events are not written to the stream port (or the paged buffer) by the
+ * code that generates them. Each core instead has one event ring per context,
+ * i.e. task level and each interrupt level, and the TzCtrl task merges the
+ * rings into the stream in timestamp order. Storing an event is then a short
+ * copy into the ring of the current context, with no wait for the streaming
+ * interface and with interrupts left enabled in ISRs.
+ *
+ * Only the task ring has more than one writer (tasks preempting each other),
+ * so only its slot claim is done with interrupts masked, for a few
+ * instructions. An interrupt level can't preempt itself, so each ISR ring has
+ * a single writer and is lock-free. The rings require
+ * TRC_STREAM_PORT_USE_INTERNAL_BUFFER == 0.
+ *
+ * Events that don't fit are dropped and counted in the ring, see
+ * xTraceGetDroppedEvents. Dropped events show as gaps in the event sequence
+ * numbers in Tracealyzer, before the next event stored in the same ring.
+ ******************************************************************************/
+#define TRC_CFG_USE_EVENT_RINGS 1
+
+/*******************************************************************************
+ * Configuration Macro: TRC_CFG_EVENT_RING_SIZE
+ *
+ * The size in bytes of each task-level event ring. Must be a power of two and
+ * at most 32768. Each event takes 4 bytes more than its size in the stream.
+ ******************************************************************************/
+#define TRC_CFG_EVENT_RING_SIZE 512
+
+/*******************************************************************************
+ * Configuration Macro: TRC_CFG_ISR_EVENT_RING_SIZE
+ *
+ * The size in bytes of each interrupt-level event ring. Must be a power of two
+ * and at most 32768.
+ ******************************************************************************/
+#define TRC_CFG_ISR_EVENT_RING_SIZE 256
+
+/*******************************************************************************
+ * Configuration Macro: TRC_CFG_EVENT_RING_ISR_CONTEXTS
+ *
+ * The number of interrupt levels that may store events. The AVR CPUINT has two
+ * maskable levels (LVL0 and LVL1). NMI handlers must not be traced.
+ ******************************************************************************/
+#define TRC_CFG_EVENT_RING_ISR_CONTEXTS 2
+
+/*******************************************************************************
+ * Configuration Macro: TRC_CFG_CORE_COUNT
+ * Configuration Macro: TRC_CFG_GET_CURRENT_CORE
+ * Configuration Macro: TRC_CFG_GET_CURRENT_CONTEXT
+ *
+ * The number of cores with their own set of rings, and how to find the current
+ * core and context. The context is 0 at task level and 1 to
+ * TRC_CFG_EVENT_RING_ISR_CONTEXTS in interrupts, higher levels having higher
+ * numbers. On SMP ports TRACE_ENTER_CRITICAL_SECTION must also exclude the
+ * other cores, as a task may move to another core before its event is
+ * committed.
+ ******************************************************************************/
+#define TRC_CFG_CORE_COUNT 1
+#define TRC_CFG_GET_CURRENT_CORE() 0
+#define TRC_CFG_GET_CURRENT_CONTEXT() \
+	((CPUINT.STATUS & CPUINT_LVL1EX_bm) ? 2 : ((CPUINT.STATUS & CPUINT_LVL0EX_bm) ? 1 : 0))
+
 #ifdef __cplusplus
 }
 #endif
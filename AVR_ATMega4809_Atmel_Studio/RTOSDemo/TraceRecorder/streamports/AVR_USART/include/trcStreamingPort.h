@@ -76,7 +76,12 @@ extern "C" {
  * The size is depending on the amount of data produced.
  ******************************************************************************/    
 #if (TRC_UART_INT_MODE == 1)
+/* The event rings absorb the bursts, so a smaller buffer keeps RAM use the same */
+#if (TRC_CFG_USE_EVENT_RINGS == 1)
+#define TRC_CFG_USART_TX_BUFFER_SIZE    1024
+#else
 #define TRC_CFG_USART_TX_BUFFER_SIZE    2048
+#endif
 #else
 #define TRC_CFG_USART_TX_BUFFER_SIZE    1
 #endif
@@ -173,6 +173,19 @@ where no return value is to be provided. */
 where a return value is to be provided. */
 #define PSF_ASSERT_RET(_assert, _err, _return) if (! (_assert)){ prvTraceError(_err); return _return; }
 
+/* With event rings only the slot claim in prvTraceEventRingReserve needs to be
+atomic. Otherwise the event is written to the stream port, or the paged buffer,
+with interrupts masked. */
+#if (TRC_CFG_USE_EVENT_RINGS == 1)
+#define TRACE_EVENT_ALLOC_CRITICAL_SECTION()
+#define TRACE_EVENT_ENTER_CRITICAL_SECTION()
+#define TRACE_EVENT_EXIT_CRITICAL_SECTION()
+#else
+#define TRACE_EVENT_ALLOC_CRITICAL_SECTION() TRACE_ALLOC_CRITICAL_SECTION()
+#define TRACE_EVENT_ENTER_CRITICAL_SECTION() TRACE_ENTER_CRITICAL_SECTION()
+#define TRACE_EVENT_EXIT_CRITICAL_SECTION() TRACE_EXIT_CRITICAL_SECTION()
+#endif
+
 /* Part of the PSF format - encodes the number of 32-bit params in an event */
 #define PARAM_COUNT(n) ((n & 0xF) << 12)
 
@@ -235,6 +248,53 @@ char* EventBuffer = NULL;
 
 PSFExtensionInfoType PSFExtensionInfo = TRC_EXTENSION_INFO;
 
+#if (TRC_CFG_USE_EVENT_RINGS == 1)
+
+#if (((TRC_CFG_EVENT_RING_SIZE) & ((TRC_CFG_EVENT_RING_SIZE) - 1)) != 0) || ((TRC_CFG_EVENT_RING_SIZE) > 32768)
+#error "TRC_CFG_EVENT_RING_SIZE must be a power of two, at most 32768"
+#endif
+
+#if (((TRC_CFG_ISR_EVENT_RING_SIZE) & ((TRC_CFG_ISR_EVENT_RING_SIZE) - 1)) != 0) || ((TRC_CFG_ISR_EVENT_RING_SIZE) > 32768)
+#error "TRC_CFG_ISR_EVENT_RING_SIZE must be a power of two, at most 32768"
+#endif
+
+/* One ring for task level and one per interrupt level, on each core. */
+#define EVENT_RING_CONTEXTS ((TRC_CFG_EVENT_RING_ISR_CONTEXTS) + 1)
+#define EVENT_RING_COUNT ((TRC_CFG_CORE_COUNT) * EVENT_RING_CONTEXTS)
+
+/* Each event in a ring follows a 4-byte header holding its size in the low
+16 bits, and in the high 16 bits the number of events the ring dropped just
+before it. A header of zero marks unused space at the end of the ring, the next
+header is then at the start of the ring. */
+#define EVENT_RING_HEADER_SIZE 4
+#define EVENT_RING_HEADER_SIZE_MASK 0xFFFFUL
+#define EVENT_RING_HEADER_DROPS_SHIFT 16
+
+/* The indexes run freely and are masked with (size - 1) on access. */
+typedef struct{
+	volatile uint16_t head;			/* End of the reserved entries */
+	volatile uint16_t committed;	/* End of the completely written entries */
+	volatile uint16_t tail;			/* Start of the entries not yet transferred */
+	volatile uint8_t pending;		/* Entries reserved but not yet committed */
+	uint8_t shared;					/* Has more than one writer (task ring) */
+	uint16_t size;
+	uint8_t* data;
+	volatile uint32_t dropped;		/* Events dropped since the recording started */
+	uint16_t droppedPending;		/* Events dropped since the last entry was claimed */
+} EventRing;
+
+static uint32_t TaskEventRingData[TRC_CFG_CORE_COUNT][(TRC_CFG_EVENT_RING_SIZE) / 4];
+static uint32_t ISREventRingData[TRC_CFG_CORE_COUNT][TRC_CFG_EVENT_RING_ISR_CONTEXTS][(TRC_CFG_ISR_EVENT_RING_SIZE) / 4];
+
+static EventRing EventRings[TRC_CFG_CORE_COUNT][EVENT_RING_CONTEXTS];
+
+/* The sequence number of the last event merged into the stream. Events in the
+rings get their sequence numbers (and so their place in the stream) when merged
+by prvTraceEventRingsTransfer, the count in eventCounter isn't used for them. */
+static uint32_t ringEventCounter = 0;
+
+#endif
+
 /*******************************************************************************
  * NoRoomForSymbol
  *
@@ -322,6 +382,11 @@ static void prvTraceStoreExtensionInfo(void);
 /* Internal function for starting/stopping the recorder. */
 static void prvSetRecorderEnabled(uint32_t isEnabled);
 
+#if (TRC_CFG_USE_EVENT_RINGS == 1)
+/* Empties the event rings when the recording starts. */
+static void prvTraceEventRingsInit(void);
+#endif
+
 /* Mark the page read as complete. */
 static void prvPageReadComplete(int pageIndex);
 
@@ -839,6 +904,10 @@ static void prvSetRecorderEnabled(uint32_t isEnabled)
     	prvTraceStoreExtensionInfo();
         prvTraceStoreStartEvent();
         prvTraceStoreTSConfig();
+
+		#if (TRC_CFG_USE_EVENT_RINGS == 1)
+		prvTraceEventRingsInit();
+		#endif
 	}
     else
     {
@@ -1143,11 +1212,11 @@ static const char* prvTraceGetError(int errCode)
 /* Store an event with zero parameters (event ID only) */
 void prvTraceStoreEvent0(uint16_t eventID)
 {
-  	TRACE_ALLOC_CRITICAL_SECTION();
+  	TRACE_EVENT_ALLOC_CRITICAL_SECTION();
 
 	PSF_ASSERT_VOID(eventID < 4096, PSF_ERROR_EVENT_CODE_TOO_LARGE);
 
-	TRACE_ENTER_CRITICAL_SECTION();
+	TRACE_EVENT_ENTER_CRITICAL_SECTION();
 
 	if (RecorderEnabled)
 	{
@@ -1164,17 +1233,17 @@ void prvTraceStoreEvent0(uint16_t eventID)
 			}
 		}
 	}
-	TRACE_EXIT_CRITICAL_SECTION();
+	TRACE_EVENT_EXIT_CRITICAL_SECTION();
 }
 
 /* Store an event with one 32-bit parameter (pointer address or an int) */
 void prvTraceStoreEvent1(uint16_t eventID, uint32_t param1)
 {
-  	TRACE_ALLOC_CRITICAL_SECTION();
+  	TRACE_EVENT_ALLOC_CRITICAL_SECTION();
 
 	PSF_ASSERT_VOID(eventID < 4096, PSF_ERROR_EVENT_CODE_TOO_LARGE);
 
-	TRACE_ENTER_CRITICAL_SECTION();
+	TRACE_EVENT_ENTER_CRITICAL_SECTION();
 
 	if (RecorderEnabled)
 	{
@@ -1192,17 +1261,17 @@ void prvTraceStoreEvent1(uint16_t eventID, uint32_t param1)
 			}
 		}
 	}
-	TRACE_EXIT_CRITICAL_SECTION();
+	TRACE_EVENT_EXIT_CRITICAL_SECTION();
 }
 
 /* Store an event with two 32-bit parameters */
 void prvTraceStoreEvent2(uint16_t eventID, uint32_t param1, uint32_t param2)
 {
-  	TRACE_ALLOC_CRITICAL_SECTION();
+  	TRACE_EVENT_ALLOC_CRITICAL_SECTION();
 
 	PSF_ASSERT_VOID(eventID < 4096, PSF_ERROR_EVENT_CODE_TOO_LARGE);
 
-	TRACE_ENTER_CRITICAL_SECTION();
+	TRACE_EVENT_ENTER_CRITICAL_SECTION();
 
 	if (RecorderEnabled)
 	{
@@ -1221,7 +1290,7 @@ void prvTraceStoreEvent2(uint16_t eventID, uint32_t param1, uint32_t param2)
 			}
 		}
 	}
-	TRACE_EXIT_CRITICAL_SECTION();
+	TRACE_EVENT_EXIT_CRITICAL_SECTION();
 }
 
 /* Store an event with three 32-bit parameters */
@@ -1230,11 +1299,11 @@ void prvTraceStoreEvent3(	uint16_t eventID,
 						uint32_t param2,
 						uint32_t param3)
 {
-  	TRACE_ALLOC_CRITICAL_SECTION();
+  	TRACE_EVENT_ALLOC_CRITICAL_SECTION();
 
 	PSF_ASSERT_VOID(eventID < 4096, PSF_ERROR_EVENT_CODE_TOO_LARGE);
 
-	TRACE_ENTER_CRITICAL_SECTION();
+	TRACE_EVENT_ENTER_CRITICAL_SECTION();
 
 	if (RecorderEnabled)
 	{
@@ -1254,7 +1323,7 @@ void prvTraceStoreEvent3(	uint16_t eventID,
 			}
 		}
 	}
-	TRACE_EXIT_CRITICAL_SECTION();
+	TRACE_EVENT_EXIT_CRITICAL_SECTION();
 }
 
 /* Stores an event with <nParam> 32-bit integer parameters */
@@ -1262,11 +1331,11 @@ void prvTraceStoreEvent(int nParam, uint16_t eventID, ...)
 {
 	va_list vl;
 	int i;
-    TRACE_ALLOC_CRITICAL_SECTION();
+    TRACE_EVENT_ALLOC_CRITICAL_SECTION();
 
 	PSF_ASSERT_VOID(eventID < 4096, PSF_ERROR_EVENT_CODE_TOO_LARGE);
 
-	TRACE_ENTER_CRITICAL_SECTION();
+	TRACE_EVENT_ENTER_CRITICAL_SECTION();
 
 	if (RecorderEnabled)
 	{
@@ -1294,7 +1363,7 @@ void prvTraceStoreEvent(int nParam, uint16_t eventID, ...)
 			}
 		}
 	}
-	TRACE_EXIT_CRITICAL_SECTION();
+	TRACE_EVENT_EXIT_CRITICAL_SECTION();
 }
 
 /* Stories an event with a string and <nParam> 32-bit integer parameters */
@@ -1322,7 +1391,7 @@ static void prvTraceStoreStringEventHelper(int nArgs,
 	int nStrWords;
 	int i;
 	int offset = 0;
-  	TRACE_ALLOC_CRITICAL_SECTION();
+  	TRACE_EVENT_ALLOC_CRITICAL_SECTION();
 	
 	/* The string length in multiples of 32 bit words (+1 for null character) */
 	nStrWords = (len+1+3)/4;
@@ -1350,7 +1419,7 @@ static void prvTraceStoreStringEventHelper(int nArgs,
 		len = 15 * 4 - offset;
 	}
 
-	TRACE_ENTER_CRITICAL_SECTION();
+	TRACE_EVENT_ENTER_CRITICAL_SECTION();
 
 	if (RecorderEnabled)
 	{
@@ -1397,7 +1466,7 @@ static void prvTraceStoreStringEventHelper(int nArgs,
 		}
 	}
 	
-	TRACE_EXIT_CRITICAL_SECTION();
+	TRACE_EVENT_EXIT_CRITICAL_SECTION();
 }
 
 /* Internal common function for storing string events without additional arguments */
@@ -1411,7 +1480,7 @@ void prvTraceStoreSimpleStringEventHelper(uint16_t eventID,
 	int i;
 	int nArgs = 0;
 	int offset = 0;
-  	TRACE_ALLOC_CRITICAL_SECTION();
+  	TRACE_EVENT_ALLOC_CRITICAL_SECTION();
 
 	for (len = 0; (str[len] != 0) && (len < 52); len++); /* empty loop */
 	
@@ -1448,7 +1517,7 @@ void prvTraceStoreSimpleStringEventHelper(uint16_t eventID,
 		len = 15 * 4 - offset;
 	}
 
-	TRACE_ENTER_CRITICAL_SECTION();
+	TRACE_EVENT_ENTER_CRITICAL_SECTION();
 
 	if (RecorderEnabled)
 	{
@@ -1488,7 +1557,7 @@ void prvTraceStoreSimpleStringEventHelper(uint16_t eventID,
 		}
 	}
 	
-	TRACE_EXIT_CRITICAL_SECTION();
+	TRACE_EVENT_EXIT_CRITICAL_SECTION();
 }
 
 /* Saves a symbol name in the symbol table and returns the slot address */
@@ -2030,6 +2099,312 @@ void prvPagedEventBufferInit(char* buffer)
 
 }
 
+#if (TRC_CFG_USE_EVENT_RINGS == 1)
+
+/*******************************************************************************
+ * void prvTraceEventRingsInit(void)
+ *
+ * Empties the event rings and clears their drop counters. Called by
+ * prvSetRecorderEnabled after the header and start events have been written,
+ * so the merged events are numbered after them.
+ ******************************************************************************/
+static void prvTraceEventRingsInit(void)
+{
+	uint32_t core;
+	uint32_t context;
+	EventRing* ring;
+
+	for (core = 0; core < (TRC_CFG_CORE_COUNT); core++)
+	{
+		for (context = 0; context < EVENT_RING_CONTEXTS; context++)
+		{
+			ring = &EventRings[core][context];
+			ring->head = 0;
+			ring->committed = 0;
+			ring->tail = 0;
+			ring->pending = 0;
+			ring->dropped = 0;
+			ring->droppedPending = 0;
+
+			if (context == 0)
+			{
+				ring->data = (uint8_t*)TaskEventRingData[core];
+				ring->size = (TRC_CFG_EVENT_RING_SIZE);
+				ring->shared = 1;
+			}
+			else
+			{
+				ring->data = (uint8_t*)ISREventRingData[core][context - 1];
+				ring->size = (TRC_CFG_ISR_EVENT_RING_SIZE);
+				ring->shared = 0;
+			}
+		}
+	}
+
+	ringEventCounter = eventCounter;
+}
+
+/* Claims an entry for an event of the given size (a multiple of 4). Returns a
+pointer to the event, or NULL and counts a drop if the ring is full. */
+static void* prvEventRingClaim(EventRing* ring, uint16_t size)
+{
+	uint16_t offset = (uint16_t)(ring->head & (ring->size - 1));
+	uint16_t need = (uint16_t)(size + EVENT_RING_HEADER_SIZE);
+	uint16_t pad = 0;
+
+	if ((uint32_t)offset + need > ring->size)
+	{
+		/* Doesn't fit before the end of the ring, start over at the beginning */
+		pad = (uint16_t)(ring->size - offset);
+	}
+
+	if ((uint32_t)(uint16_t)(ring->head - ring->tail) + pad + need > ring->size)
+	{
+		ring->dropped++;
+		if (ring->droppedPending != 0xFFFF)
+		{
+			ring->droppedPending++;
+		}
+		return NULL;
+	}
+
+	if (pad != 0)
+	{
+		*(uint32_t*)&ring->data[offset] = 0;
+		offset = 0;
+	}
+
+	/* The drops are recorded with the next event stored, so the gap they
+	leave in the numbering is where the events were lost */
+	*(uint32_t*)&ring->data[offset] = size | ((uint32_t)ring->droppedPending << EVENT_RING_HEADER_DROPS_SHIFT);
+	ring->droppedPending = 0;
+	ring->head = (uint16_t)(ring->head + pad + need);
+	ring->pending++;
+
+	return &ring->data[offset + EVENT_RING_HEADER_SIZE];
+}
+
+/* Publishes the reserved entries to the reader once none is being written. */
+static void prvEventRingPublish(EventRing* ring)
+{
+	ring->pending--;
+	if (ring->pending == 0)
+	{
+		ring->committed = ring->head;
+	}
+}
+
+/* Frees the entries before newTail. The index store isn't atomic on 8-bit
+targets, so interrupts are masked for it. */
+static void prvEventRingRelease(EventRing* ring, uint16_t newTail)
+{
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	TRACE_ENTER_CRITICAL_SECTION();
+	ring->tail = newTail;
+	TRACE_EXIT_CRITICAL_SECTION();
+}
+
+/* Returns the oldest event in the ring, before the committed index given, or
+NULL if there is none. Skips the padding at the end of the ring. */
+static BaseEvent* prvEventRingPeek(EventRing* ring, uint16_t committed)
+{
+	uint16_t offset;
+
+	if (ring->tail == committed)
+	{
+		return NULL;
+	}
+
+	offset = (uint16_t)(ring->tail & (ring->size - 1));
+	if (*(uint32_t*)&ring->data[offset] == 0)
+	{
+		prvEventRingRelease(ring, (uint16_t)(ring->tail + ring->size - offset));
+		if (ring->tail == committed)
+		{
+			return NULL;
+		}
+		offset = 0;
+	}
+
+	return (BaseEvent*)&ring->data[offset + EVENT_RING_HEADER_SIZE];
+}
+
+/*******************************************************************************
+ * void* prvTraceEventRingReserve(uint32_t size, void** ring)
+ *
+ * Reserves space for an event in the ring of the current core and context,
+ * used by TRC_STREAM_PORT_ALLOCATE_EVENT. The ring is returned in *ring and is
+ * passed to prvTraceEventRingCommit when the event has been written.
+ *
+ * Only the task ring is written from more than one context, so only its claim
+ * is made with interrupts masked. The AVR has no compare-and-swap, and masking
+ * a few instructions costs less than a retry loop would.
+ *
+ * Return value: The event, or NULL if the ring is full.
+ ******************************************************************************/
+void* prvTraceEventRingReserve(uint32_t size, void** ring)
+{
+	EventRing* r = &EventRings[TRC_CFG_GET_CURRENT_CORE()][TRC_CFG_GET_CURRENT_CONTEXT()];
+	void* ret;
+
+	*ring = r;
+	size = (size + 3) & ~3UL;
+
+	if (r->shared)
+	{
+		TRACE_ALLOC_CRITICAL_SECTION();
+
+		TRACE_ENTER_CRITICAL_SECTION();
+		ret = prvEventRingClaim(r, (uint16_t)size);
+		TRACE_EXIT_CRITICAL_SECTION();
+	}
+	else
+	{
+		ret = prvEventRingClaim(r, (uint16_t)size);
+	}
+
+	return ret;
+}
+
+/*******************************************************************************
+ * void prvTraceEventRingCommit(void* ring)
+ *
+ * Marks the event reserved in the ring as written, used by
+ * TRC_STREAM_PORT_COMMIT_EVENT. If a task was preempted while writing an
+ * event to the task ring, the events reserved after it are published together
+ * with it.
+ ******************************************************************************/
+void prvTraceEventRingCommit(void* ring)
+{
+	EventRing* r = (EventRing*)ring;
+
+	if (r->shared)
+	{
+		TRACE_ALLOC_CRITICAL_SECTION();
+
+		TRACE_ENTER_CRITICAL_SECTION();
+		prvEventRingPublish(r);
+		TRACE_EXIT_CRITICAL_SECTION();
+	}
+	else
+	{
+		prvEventRingPublish(r);
+	}
+}
+
+/*******************************************************************************
+ * uint32_t prvTraceEventRingsTransfer(void)
+ *
+ * Merges the committed events of all rings into the stream, oldest timestamp
+ * first, using TRC_STREAM_PORT_WRITE_DATA. Events with equal timestamps are
+ * taken from the lower core and context first. The events are numbered here,
+ * and the events a ring dropped just before an event are skipped in the
+ * numbering before that event, so that Tracealyzer shows the gap where the
+ * events were lost. Drops after the last event stored in a ring show up with
+ * the next event stored in it.
+ *
+ * Called by the TzCtrl task. Returns the number of bytes sent, at most about
+ * one task ring. If non-zero, call again to send any remaining events.
+ ******************************************************************************/
+uint32_t prvTraceEventRingsTransfer(void)
+{
+	uint16_t committed[EVENT_RING_COUNT];
+	uint32_t bytesSent = 0;
+	uint32_t i;
+	EventRing* rings = &EventRings[0][0];
+	EventRing* next;
+	BaseEvent* nextEvent;
+	BaseEvent* event;
+	uint32_t header;
+	uint32_t size;
+	char* ptrWrite;
+	uint32_t writeSize;
+	int32_t bytesWritten;
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	/* Take a snapshot of what the rings hold. The index loads aren't atomic on
+	8-bit targets, so interrupts are masked while copying them. */
+	TRACE_ENTER_CRITICAL_SECTION();
+	for (i = 0; i < EVENT_RING_COUNT; i++)
+	{
+		committed[i] = rings[i].committed;
+	}
+	TRACE_EXIT_CRITICAL_SECTION();
+
+	while (bytesSent < (TRC_CFG_EVENT_RING_SIZE))
+	{
+		next = NULL;
+		nextEvent = NULL;
+
+		for (i = 0; i < EVENT_RING_COUNT; i++)
+		{
+			event = prvEventRingPeek(&rings[i], committed[i]);
+			if ((event != NULL) && ((nextEvent == NULL) || ((int32_t)(event->TS - nextEvent->TS) < 0)))
+			{
+				next = &rings[i];
+				nextEvent = event;
+			}
+		}
+
+		if (next == NULL)
+		{
+			break;
+		}
+
+		header = *((uint32_t*)nextEvent - 1);
+		size = header & EVENT_RING_HEADER_SIZE_MASK;
+		ringEventCounter += header >> EVENT_RING_HEADER_DROPS_SHIFT;
+		nextEvent->EventCount = (uint16_t)++ringEventCounter;
+
+		ptrWrite = (char*)nextEvent;
+		writeSize = size;
+		while (writeSize > 0)
+		{
+			bytesWritten = 0;
+			if (TRC_STREAM_PORT_WRITE_DATA(ptrWrite, writeSize, &bytesWritten) != 0)
+			{
+				/* Some error from the streaming interface... */
+				vTraceStop();
+				return 0;
+			}
+			ptrWrite += bytesWritten;
+			writeSize -= (uint32_t)bytesWritten;
+		}
+
+		prvEventRingRelease(next, (uint16_t)(next->tail + EVENT_RING_HEADER_SIZE + size));
+		bytesSent += size;
+	}
+
+	return bytesSent;
+}
+
+/*******************************************************************************
+ * uint32_t xTraceGetDroppedEvents(uint32_t core, uint32_t context)
+ *
+ * Returns the number of events the ring of the given core and context (0 for
+ * task level, 1 and up for interrupt levels) has dropped since the recording
+ * was started.
+ ******************************************************************************/
+uint32_t xTraceGetDroppedEvents(uint32_t core, uint32_t context)
+{
+	uint32_t dropped;
+	TRACE_ALLOC_CRITICAL_SECTION();
+
+	if ((core >= (TRC_CFG_CORE_COUNT)) || (context >= EVENT_RING_CONTEXTS))
+	{
+		return 0;
+	}
+
+	TRACE_ENTER_CRITICAL_SECTION();
+	dropped = EventRings[core][context].dropped;
+	TRACE_EXIT_CRITICAL_SECTION();
+
+	return dropped;
+}
+
+#endif /*(TRC_CFG_USE_EVENT_RINGS == 1)*/
+
 #endif /*(TRC_USE_TRACEALYZER_RECORDER == 1)*/
 
 #endif /*(TRC_CFG_RECORDER_MODE == TRC_RECORDER_MODE_STREAMING)*/
@@ -711,8 +711,9 @@ static void prvCheckRecorderStatus(void)
 /*******************************************************************************
  * TzCtrl
  *
- * Task for sending the trace data from the internal buffer to the stream 
- * interface (assuming TRC_STREAM_PORT_USE_INTERNAL_BUFFER == 1) and for
+ * Task for sending the trace data from the internal buffer or the event rings
+ * to the stream interface (assuming TRC_STREAM_PORT_USE_INTERNAL_BUFFER == 1
+ * or TRC_CFG_USE_EVENT_RINGS == 1) and for
  * receiving commands from Tracealyzer. Also does some diagnostics.
  ******************************************************************************/
 static portTASK_FUNCTION( TzCtrl, pvParameters )
@@ -745,8 +746,12 @@ static portTASK_FUNCTION( TzCtrl, pvParameters )
 			}
 
 /* If the internal buffer is disabled, the COMMIT macro instead sends the data directly 
-   from the "event functions" (using TRC_STREAM_PORT_WRITE_DATA). */			
-#if (TRC_STREAM_PORT_USE_INTERNAL_BUFFER == 1)
+   from the "event functions" (using TRC_STREAM_PORT_WRITE_DATA), unless the events are
+   stored in the event rings. */			
+#if (TRC_CFG_USE_EVENT_RINGS == 1)
+			/* Merges the events stored in the rings into the stream, oldest first. */
+			bytes = (int32_t)prvTraceEventRingsTransfer();
+#elif (TRC_STREAM_PORT_USE_INTERNAL_BUFFER == 1)
 			/* If there is a buffer page, this sends it to the streaming interface using TRC_STREAM_PORT_WRITE_DATA. */
 			bytes = prvPagedEventBufferTransfer();
 #endif			
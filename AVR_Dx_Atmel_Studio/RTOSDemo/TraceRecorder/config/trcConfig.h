@@ -344,6 +344,9 @@ extern "C" {
  * a stream port leveraging the internal buffer (like TCP/IP). A shorter delay
  * increases the CPU load of TzCtrl somewhat, but may improve the performance of
  * of the trace streaming, especially if the trace buffer is small.
+ *
+ * With TRC_CFG_USE_EVENT_RINGS, the event rings must hold the events stored
+ * during one delay, or events are dropped.
  ******************************************************************************/
 #define TRC_CFG_CTRL_TASK_DELAY 10
 
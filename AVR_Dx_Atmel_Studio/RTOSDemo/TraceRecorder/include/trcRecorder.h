@@ -1715,6 +1715,39 @@ if (!(eval)) \
 	}
 
 #endif
+#endif
+
+ /******************************************************************************
+ * Event rings (TRC_CFG_USE_EVENT_RINGS, see trcStreamingConfig.h)
+ *
+ * The ALLOCATE macros reserve the event in the ring of the current core and
+ * context, and COMMIT publishes it to the TzCtrl task, which does the actual
+ * TRC_STREAM_PORT_WRITE_DATA. The BLOCKING variants above are kept, so the
+ * header and tables in vTraceEnable are still written directly.
+ ******************************************************************************/
+#ifndef TRC_CFG_USE_EVENT_RINGS
+#define TRC_CFG_USE_EVENT_RINGS 0
+#endif
+
+#if (TRC_CFG_USE_EVENT_RINGS == 1)
+#if (TRC_STREAM_PORT_USE_INTERNAL_BUFFER == 1)
+#error "TRC_CFG_USE_EVENT_RINGS requires TRC_STREAM_PORT_USE_INTERNAL_BUFFER == 0"
+#endif
+
+void* prvTraceEventRingReserve(uint32_t size, void** ring);
+void prvTraceEventRingCommit(void* ring);
+
+#undef TRC_STREAM_PORT_ALLOCATE_EVENT
+#undef TRC_STREAM_PORT_ALLOCATE_DYNAMIC_EVENT
+#undef TRC_STREAM_PORT_COMMIT_EVENT
+
+#define TRC_STREAM_PORT_ALLOCATE_EVENT(_type, _ptrData, _size) \
+	void* _ptrData##Ring; \
+	_type* _ptrData = (_type*)prvTraceEventRingReserve(_size, &_ptrData##Ring);
+
+#define TRC_STREAM_PORT_ALLOCATE_DYNAMIC_EVENT(_type, _ptrData, _size) TRC_STREAM_PORT_ALLOCATE_EVENT(_type, _ptrData, _size)
+
+#define TRC_STREAM_PORT_COMMIT_EVENT(_ptrData, _size) prvTraceEventRingCommit(_ptrData##Ring);
 #endif
 
 /******************************************************************************
@@ -1932,6 +1965,14 @@ void* prvPagedEventBufferGetWritePointer(int sizeOfEvent);
 /* Transfer a full buffer page */
 uint32_t prvPagedEventBufferTransfer(void);
 
+#if (TRC_CFG_USE_EVENT_RINGS == 1)
+/* Merge the event rings into the stream, called by TzCtrl */
+uint32_t prvTraceEventRingsTransfer(void);
+
+/* Number of events dropped by a ring since the recording started */
+uint32_t xTraceGetDroppedEvents(uint32_t core, uint32_t context);
+#endif
+
 /* The data structure for commands (a bit overkill) */
 typedef struct
 {
@@ -78,7 +78,12 @@ extern "C" {
     
     
 #if (TRC_UART_INT_MODE == 1)
+/* The event rings absorb the bursts, so a smaller buffer keeps RAM use the same */
+#if (TRC_CFG_USE_EVENT_RINGS == 1)
+#define TRC_CFG_USART_TX_BUFFER_SIZE       1024
+#else
 #define TRC_CFG_USART_TX_BUFFER_SIZE       2048
+#endif
 #else
 #define TRC_CFG_USART_TX_BUFFER_SIZE         8
 #endif
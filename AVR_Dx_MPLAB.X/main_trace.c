@@ -50,6 +50,10 @@
  * send task writes to the queue every 200 milliseconds, the queue receive
  * task leaves the Blocked state every 200 milliseconds, and therefore toggles
  * the LED every 200 milliseconds.
+ *
+ * Before its first send, the queue send task also measures the cost of storing
+ * a trace event, in CPU cycles, using TCB1 as a cycle counter.  The result is
+ * shown on the "Trace cost" user event channel in Tracealyzer.
  */
 
 /* Scheduler include files. */
@@ -75,6 +79,14 @@ will remove items as they are added, meaning the send task should always find
 the queue empty. */
 #define mainQUEUE_LENGTH                    ( 1 )
 
+/* The recording cost is measured with TCB1 as a cycle counter, unless TCB1 is
+used for the tick. */
+#define mainMEASURE_TRACE_COST              ( configUSE_TIMER_INSTANCE != 1 )
+
+/* The number of events stored per measurement.  These must fit in the trace
+buffer together with the events of the other tasks. */
+#define mainTRACE_COST_EVENTS               ( 16 )
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -83,6 +95,14 @@ the queue empty. */
 static void prvQueueReceiveTask( void *pvParameters );
 static void prvQueueSendTask( void *pvParameters );
 
+#if ( mainMEASURE_TRACE_COST == 1 )
+/*
+ * Measures the cycles taken to store a user event and stores the result in
+ * the trace.
+ */
+static void prvMeasureTraceCost( void );
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* The queue used by both tasks. */
@@ -128,6 +148,15 @@ const unsigned long ulValueToSend = 100UL;
     /* Remove compiler warning about unused parameter. */
     ( void ) pvParameters;
 
+    #if ( mainMEASURE_TRACE_COST == 1 )
+    {
+        /* Let TzCtrl send the events stored during start up first, so none of
+        the measured events is dropped. */
+        vTaskDelay( mainQUEUE_SEND_FREQUENCY_MS );
+        prvMeasureTraceCost();
+    }
+    #endif
+
     /* Initialise xNextWakeTime - this only needs to be done once. */
     xNextWakeTime = xTaskGetTickCount();
 
@@ -177,4 +206,50 @@ const unsigned long ulExpectedValue = 100UL;
     }
 }
 
+/*-----------------------------------------------------------*/
+
+#if ( mainMEASURE_TRACE_COST == 1 )
+
+static void prvMeasureTraceCost( void )
+{
+traceString xChannel;
+uint16_t usStart, usLoopCycles, usEventCycles;
+uint8_t ucEvent;
+
+    xChannel = xTraceRegisterString( "Trace cost" );
+
+    /* Run TCB1 from CLK_PER in periodic interrupt mode, without the
+    interrupt, so CNT counts CPU cycles and wraps at CCMP. */
+    TCB1.CCMP = 0xFFFF;
+    TCB1.CTRLB = 0;
+    TCB1.CNT = 0;
+    TCB1.CTRLA = TCB_ENABLE_bm;
+
+    /* Interrupts are disabled so that only the events are counted.  The
+    cost of the loop itself is measured first and subtracted. */
+    taskENTER_CRITICAL();
+    {
+        usStart = TCB1.CNT;
+        for( ucEvent = 0; ucEvent < mainTRACE_COST_EVENTS; ucEvent++ )
+        {
+            __asm__ __volatile__ ( "" ::: "memory" );
+        }
+        usLoopCycles = TCB1.CNT - usStart;
+
+        usStart = TCB1.CNT;
+        for( ucEvent = 0; ucEvent < mainTRACE_COST_EVENTS; ucEvent++ )
+        {
+            vTracePrint( xChannel, "x" );
+        }
+        usEventCycles = TCB1.CNT - usStart;
+    }
+    taskEXIT_CRITICAL();
+
+    TCB1.CTRLA = 0;
+
+    vTracePrintF( xChannel, "%d cycles per event", ( uint32_t ) ( ( uint16_t ) ( usEventCycles - usLoopCycles ) / mainTRACE_COST_EVENTS ) );
+}
+
+#endif
+
 #endif
@@ -58,5 +58,7 @@
 #define configSTART_INTERRUPT_QUEUE_TESTS         0
 #define configSTART_REGISTER_TESTS                1
 #define configSTART_DELETE_SELF_TESTS             0
+#define configSTART_SMP_LATENCY_TESTS             0
+#define configSTART_THROUGHPUT_MONITOR            0
 
 #endif /* TEST_INCLUDES_H */
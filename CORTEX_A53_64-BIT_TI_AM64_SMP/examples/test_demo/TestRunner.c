@@ -62,9 +62,14 @@
 #include "StreamBufferDemo.h"
 #include "StreamBufferInterrupt.h"
 #include "RegTests.h"
+#include "SMPLatency.h"
 
 #include "TestIncludes.h"
 
+#if( configSTART_THROUGHPUT_MONITOR == 1 )
+	#include "ThroughputMonitor.h"
+#endif
+
 /**
  * Priorities at which the tasks are created.
  */
@@ -79,6 +84,7 @@
 #define testrunnerFLOP_TASK_PRIORITY			( tskIDLE_PRIORITY )
 #define testrunnerQUEUE_OVERWRITE_PRIORITY		( tskIDLE_PRIORITY )
 #define testrunnerREGISTER_TEST_PRIORITY		( tskIDLE_PRIORITY )
+#define testrunnerSMP_LATENCY_PRIORITY			( tskIDLE_PRIORITY + 1 )
 
 /**
  * Period used in timer tests.
@@ -97,6 +103,13 @@ static char *pcStatusMessage = "No errors";
  * still executing and error free.
  */
 static void prvCheckTask( void *pvParameters );
+
+#if( configSTART_THROUGHPUT_MONITOR == 1 )
+	/**
+	 * Registers the throughput counters of the tests that are enabled.
+	 */
+	static void prvRegisterThroughputCounters( void );
+#endif
 /*-----------------------------------------------------------*/
 
 void vStartTests( void )
@@ -259,6 +272,12 @@ void vStartTests( void )
 		}
 		#endif /* configSTART_REGISTER_TESTS */
 
+		#if( configSTART_SMP_LATENCY_TESTS == 1 )
+		{
+			vStartSMPLatencyTasks( testrunnerSMP_LATENCY_PRIORITY );
+		}
+		#endif /* configSTART_SMP_LATENCY_TESTS */
+
 		#if( configSTART_DELETE_SELF_TESTS == 1 )
 		{
 			/* The suicide tasks must be created last as they need to know how many
@@ -268,6 +287,12 @@ void vStartTests( void )
 			vCreateSuicidalTasks( testrunnerCREATOR_TASK_PRIORITY );
 		}
 		#endif /* configSTART_DELETE_SELF_TESTS */
+
+		#if( configSTART_THROUGHPUT_MONITOR == 1 )
+		{
+			prvRegisterThroughputCounters();
+		}
+		#endif /* configSTART_THROUGHPUT_MONITOR */
 	}
 
 	vTaskStartScheduler();
@@ -345,6 +370,16 @@ void vApplicationTickHook( void )
 }
 /*-----------------------------------------------------------*/
 
+uint32_t ulGetSMPLatencyTimestamp( void )
+{
+uint64_t ullCount;
+
+	/* The isb stops the read being performed early. */
+	__asm volatile ( "isb sy\n mrs %0, cntpct_el0" : "=r" ( ullCount ) :: "memory" );
+	return ( uint32_t ) ullCount;
+}
+/*-----------------------------------------------------------*/
+
 static void prvCheckTask( void *pvParameters )
 {
 TickType_t xNextWakeTime;
@@ -356,6 +391,13 @@ const TickType_t xCycleFrequency = pdMS_TO_TICKS( 5000UL );
 	/* Initialise xNextWakeTime - this only needs to be done once. */
 	xNextWakeTime = xTaskGetTickCount();
 
+	#if( configSTART_THROUGHPUT_MONITOR == 1 )
+	{
+		/* Start the first throughput measurement period. */
+		( void ) uxThroughputMonitorUpdate();
+	}
+	#endif /* configSTART_THROUGHPUT_MONITOR */
+
 	for( ;; )
 	{
 		/* Place this task in the blocked state until it is time to run again. */
@@ -577,6 +619,15 @@ const TickType_t xCycleFrequency = pdMS_TO_TICKS( 5000UL );
 		}
 		#endif /* configSTART_REGISTER_TESTS */
 
+		#if( configSTART_SMP_LATENCY_TESTS == 1 )
+		{
+			if( xAreSMPLatencyTasksStillRunning() != pdPASS )
+			{
+				pcStatusMessage = "Error: SMPLatency";
+			}
+		}
+		#endif /* configSTART_SMP_LATENCY_TESTS */
+
 		#if( configSTART_DELETE_SELF_TESTS == 1 )
 		{
 			if( xIsCreateTaskStillRunning() != pdTRUE )
@@ -587,6 +638,65 @@ const TickType_t xCycleFrequency = pdMS_TO_TICKS( 5000UL );
 		#endif /* configSTART_DELETE_SELF_TESTS */
 
 		configPRINTF( ( "%s \r\n", pcStatusMessage ) );
+
+		#if( configSTART_THROUGHPUT_MONITOR == 1 )
+		{
+			/* A drop is reported but is not an error, as a test can be slowed
+			 * down legitimately by the other tests sharing its core. */
+			configPRINTF( ( "Throughput, %u counter(s) dropped:\r\n", ( unsigned ) uxThroughputMonitorUpdate() ) );
+			vThroughputMonitorPrint();
+		}
+		#endif /* configSTART_THROUGHPUT_MONITOR */
 	}
 }
 /*-----------------------------------------------------------*/
+
+#if( configSTART_THROUGHPUT_MONITOR == 1 )
+
+	static void prvRegisterThroughputCounters( void )
+	{
+		#if( configSTART_TASK_NOTIFY_TESTS == 1 )
+		{
+			xThroughputMonitorAdd( "TaskNotify", "cycles", ulGetTaskNotifyCycles );
+		}
+		#endif /* configSTART_TASK_NOTIFY_TESTS */
+
+		#if( configSTART_BLOCKING_QUEUE_TESTS == 1 )
+		{
+			xThroughputMonitorAdd( "BlockQueue", "items", ulGetBlockingQueueItemsReceived );
+		}
+		#endif /* configSTART_BLOCKING_QUEUE_TESTS */
+
+		#if( configSTART_SEMAPHORE_TESTS == 1 )
+		{
+			xThroughputMonitorAdd( "SemTest", "takes", ulGetSemaphoreTakes );
+		}
+		#endif /* configSTART_SEMAPHORE_TESTS */
+
+		#if( configSTART_POLLED_QUEUE_TESTS == 1 )
+		{
+			xThroughputMonitorAdd( "PollQueue", "items", ulGetPollingQueueItemsReceived );
+		}
+		#endif /* configSTART_POLLED_QUEUE_TESTS */
+
+		#if( configSTART_RECURSIVE_MUTEX_TESTS == 1 )
+		{
+			xThroughputMonitorAdd( "RecMutex", "rounds", ulGetRecursiveMutexRounds );
+		}
+		#endif /* configSTART_RECURSIVE_MUTEX_TESTS */
+
+		#if( configSTART_MESSAGE_BUFFER_TESTS == 1 )
+		{
+			xThroughputMonitorAdd( "MessageBuffer", "bytes", ulGetMessageBufferBytesReceived );
+		}
+		#endif /* configSTART_MESSAGE_BUFFER_TESTS */
+
+		#if( configSTART_STREAM_BUFFER_TESTS == 1 )
+		{
+			xThroughputMonitorAdd( "StreamBuffer", "bytes", ulGetStreamBufferBytesReceived );
+		}
+		#endif /* configSTART_STREAM_BUFFER_TESTS */
+	}
+
+#endif /* configSTART_THROUGHPUT_MONITOR */
+/*-----------------------------------------------------------*/
@@ -184,6 +184,14 @@ uint32_t uiPortGetRunTimeCounterValue();
 
 #define configPRINTF( X ) DebugP_log X
 
+/* The cross-core latency benchmark compares timestamps read on the same core
+ * only, so it uses the generic timer's physical count, which needs no per core
+ * set up.  The function is provided by the test demo. */
+uint32_t ulGetSMPLatencyTimestamp( void );
+#define configSMP_LATENCY_GET_TIMESTAMP()      ulGetSMPLatencyTimestamp()
+#define configSMP_LATENCY_PRINTF( X )          DebugP_log X
+#define configTHROUGHPUT_PRINTF( X )           DebugP_log X
+
 #ifdef __cplusplus
 }
 #endif
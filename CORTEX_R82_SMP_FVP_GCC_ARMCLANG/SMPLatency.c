@@ -0,0 +1,732 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Measures how long it takes one core to hand work to another, for each
+ * ordered pair of cores ( a, b ) with a < b.  A task pinned to core a (the
+ * initiator) and a task pinned to core b (the echo task) bounce a token
+ * between them through, in turn, a pair of binary semaphores, a pair of length
+ * one queues, direct to task notifications, a pair of stream buffers, a pair of
+ * words held in different cache lines, and finally a raw inter-processor
+ * interrupt.
+ *
+ * The timestamp is only ever compared with another read on the same core, as
+ * the cycle counters of different cores need not be synchronised.  The
+ * initiator therefore records the round trip, and the one way latency is
+ * printed as half of it.  For the IPI test the initiator raises a yield
+ * interrupt on core b using portYIELD_CORE(), and the echo task spins reading
+ * the timestamp.  The interrupt shows up as a gap in the echo task's loop,
+ * which is the cost of the interrupt entry, vTaskSwitchContext() and the
+ * interrupt exit on core b, measured on core b's own clock.  Gaps that also
+ * include a tick are discarded.  If the timestamp is too coarse for the gap to
+ * be seen, the IPI test gives up and says so rather than reporting an error.
+ *
+ * configSMP_LATENCY_GET_TIMESTAMP() must return a free running 32-bit counter.
+ * It defaults to portGET_RUN_TIME_COUNTER_VALUE() when run time statistics
+ * are enabled.  p50, p99 and the maximum of each test are printed with
+ * configSMP_LATENCY_PRINTF(), which defaults to printf().  The tests run once,
+ * then xIsSMPLatencyTestComplete() returns pdTRUE.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "queue.h"
+#include "stream_buffer.h"
+
+/* Demo program include files. */
+#include "SMPLatency.h"
+
+/* Exclude the entire file if there is only one core. */
+#if ( configNUMBER_OF_CORES > 1 )
+
+    #if ( configUSE_CORE_AFFINITY != 1 )
+        #error This file pins its tasks to particular cores so needs configUSE_CORE_AFFINITY to be 1.
+    #endif
+
+    #ifndef configSMP_LATENCY_GET_TIMESTAMP
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            #define configSMP_LATENCY_GET_TIMESTAMP()    ( ( uint32_t ) portGET_RUN_TIME_COUNTER_VALUE() )
+        #else
+            #error Define configSMP_LATENCY_GET_TIMESTAMP() to read a free running counter, or set configGENERATE_RUN_TIME_STATS to 1.
+        #endif
+    #endif
+
+/* The results are always printed, so this does not default to configPRINTF(),
+ * which the kernel defines away to nothing when it is not set. */
+    #ifndef configSMP_LATENCY_PRINTF
+        #include <stdio.h>
+        #define configSMP_LATENCY_PRINTF( X )    printf X
+    #endif
+
+/* The number of samples recorded by each test, after the warm up round trips
+ * that are not recorded. */
+    #ifndef configSMP_LATENCY_ITERATIONS
+        #define configSMP_LATENCY_ITERATIONS    ( 1000 )
+    #endif
+    #define smplatWARM_UP_ITERATIONS            ( 10 )
+    #define smplatTOTAL_ITERATIONS              ( configSMP_LATENCY_ITERATIONS + smplatWARM_UP_ITERATIONS )
+
+/* The ping and pong words of the cache line test are this many bytes apart, so
+ * are never in the same cache line. */
+    #ifndef configSMP_LATENCY_CACHE_LINE_SIZE
+        #define configSMP_LATENCY_CACHE_LINE_SIZE    ( 64 )
+    #endif
+    #define smplatLINE_WORDS                    ( configSMP_LATENCY_CACHE_LINE_SIZE / sizeof( uint32_t ) )
+    #define smplatPING_INDEX                    ( 0 )
+    #define smplatPONG_INDEX                    ( smplatLINE_WORDS )
+
+/* Neither task should ever have to wait this long for the other. */
+    #define smplatBLOCK_TIME                    pdMS_TO_TICKS( ( TickType_t ) 1000 )
+
+/* How long the initiator waits for an IPI to be seen, and how many in a row
+ * can be missed before the IPI test is abandoned. */
+    #define smplatIPI_TIMEOUT                   ( pdMS_TO_TICKS( ( TickType_t ) 10 ) + 1 )
+    #define smplatMAX_IPI_MISSES                ( 8 )
+
+/* The echo task times its spin loop this many times, in each of
+ * smplatCALIBRATION_RUNS runs, to find the longest normal loop iteration. */
+    #define smplatCALIBRATION_LOOPS             ( 256 )
+    #define smplatCALIBRATION_RUNS              ( 4 )
+
+/* The size of the stack used by the tasks in this file. */
+    #define smplatTASK_STACK_SIZE               ( configMINIMAL_STACK_SIZE * 2 )
+
+/* The tests, in the order both tasks run them. */
+    typedef enum
+    {
+        eSemaphoreTest = 0,
+        eQueueTest,
+        eNotifyTest,
+        eStreamBufferTest,
+        eCacheLineTest,
+        eIPITest,
+        eNumberOfTests
+    } SMPLatencyTest_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Creates the initiator and echo tasks for each pair of cores in turn, and
+ * waits for them to finish.
+ */
+    static void prvControllerTask( void * pvParameters );
+
+/*
+ * Runs on the lower numbered core of the pair, times each round trip, and
+ * prints the results.
+ */
+    static void prvInitiatorTask( void * pvParameters );
+
+/*
+ * Runs on the higher numbered core of the pair, and returns everything the
+ * initiator sends.
+ */
+    static void prvEchoTask( void * pvParameters );
+
+/*
+ * Runs one test on the initiator side, returning the number of round trips
+ * recorded in ulSamples[].
+ */
+    static UBaseType_t prvMeasure( BaseType_t xTest );
+
+/*
+ * Raises an IPI on the target core and waits for the echo task to see it.
+ * Returns pdFAIL if it was not seen within smplatIPI_TIMEOUT.
+ */
+    static BaseType_t prvTriggerIPI( uint32_t ulValue );
+
+/*
+ * The echo task side of the IPI test.
+ */
+    static void prvEchoIPI( void );
+
+/*
+ * Returns the longest gap between two timestamps read by an uninterrupted
+ * iteration of the echo task's IPI loop.
+ */
+    static uint32_t prvCalibrateSpin( void );
+
+/*
+ * Sorts the samples and prints p50, p99 and the maximum.
+ */
+    static void prvReport( const char * pcName,
+                           uint32_t * pulSamples,
+                           UBaseType_t uxCount,
+                           BaseType_t xIsRoundTrip );
+
+/*-----------------------------------------------------------*/
+
+/* The objects used to pass the token, one of each in each direction. */
+    static SemaphoreHandle_t xToEchoSemaphore = NULL, xToInitiatorSemaphore = NULL;
+    static QueueHandle_t xToEchoQueue = NULL, xToInitiatorQueue = NULL;
+    static StreamBufferHandle_t xToEchoStream = NULL, xToInitiatorStream = NULL;
+
+/* The tasks, and the pair of cores currently being measured. */
+    static TaskHandle_t xControllerTask = NULL, xInitiatorTask = NULL, xEchoTask = NULL;
+    static BaseType_t xInitiatorCore = 0, xEchoCore = 0;
+
+/* The words written by the cache line test. */
+    static volatile uint32_t ulCacheLines[ 2 * smplatLINE_WORDS ];
+
+/* State shared by the two sides of the IPI test. */
+    static volatile uint32_t ulIPIRequest = 0, ulIPIAck = 0;
+    static volatile BaseType_t xIPIEchoReady = pdFALSE, xIPIStop = pdFALSE;
+
+/* The round trips recorded by the initiator, and the IPI handling times
+ * recorded by the echo task. */
+    static uint32_t ulSamples[ configSMP_LATENCY_ITERATIONS ];
+    static uint32_t ulHandlerSamples[ configSMP_LATENCY_ITERATIONS ];
+    static UBaseType_t uxHandlerSampleCount = 0;
+
+    static const char * const pcTestNames[ eNumberOfTests ] =
+    {
+        "semaphore",
+        "queue",
+        "task notification",
+        "stream buffer",
+        "cache line",
+        "IPI"
+    };
+
+/* Used so a check task can ensure this test is still executing, and not
+ * stalled. */
+    static volatile UBaseType_t uxCycleCounter = 0;
+
+/* Set to pdTRUE once every pair of cores has been measured. */
+    static volatile BaseType_t xTestComplete = pdFALSE;
+
+/* A variable that gets set to pdTRUE if an error is detected. */
+    static volatile BaseType_t xErrorOccurred = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+    void vStartSMPLatencyTasks( UBaseType_t uxPriority )
+    {
+        xToEchoSemaphore = xSemaphoreCreateBinary();
+        xToInitiatorSemaphore = xSemaphoreCreateBinary();
+        xToEchoQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+        xToInitiatorQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+
+        /* A trigger level of one means the receiver is unblocked as soon as
+         * anything is sent. */
+        xToEchoStream = xStreamBufferCreate( 2 * sizeof( uint32_t ), 1 );
+        xToInitiatorStream = xStreamBufferCreate( 2 * sizeof( uint32_t ), 1 );
+
+        configASSERT( xToEchoSemaphore );
+        configASSERT( xToInitiatorSemaphore );
+        configASSERT( xToEchoQueue );
+        configASSERT( xToInitiatorQueue );
+        configASSERT( xToEchoStream );
+        configASSERT( xToInitiatorStream );
+
+        /* The controller task is not pinned, and passes its priority on to
+         * the tasks it creates. */
+        xTaskCreate( prvControllerTask, "SMPLatCtl", smplatTASK_STACK_SIZE, ( void * ) uxPriority, uxPriority, &xControllerTask );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvControllerTask( void * pvParameters )
+    {
+        UBaseType_t uxPriority = ( UBaseType_t ) pvParameters;
+        UBaseType_t ux;
+
+        configSMP_LATENCY_PRINTF( ( "SMP latency: %u round trips per test, in timestamp counts\r\n", ( unsigned ) configSMP_LATENCY_ITERATIONS ) );
+
+        for( xInitiatorCore = 0; xInitiatorCore < ( configNUMBER_OF_CORES - 1 ); xInitiatorCore++ )
+        {
+            for( xEchoCore = xInitiatorCore + 1; xEchoCore < configNUMBER_OF_CORES; xEchoCore++ )
+            {
+                /* Nothing should be left over from the last pair, but make
+                 * sure after an error. */
+                ( void ) xSemaphoreTake( xToEchoSemaphore, 0 );
+                ( void ) xSemaphoreTake( xToInitiatorSemaphore, 0 );
+                ( void ) xQueueReset( xToEchoQueue );
+                ( void ) xQueueReset( xToInitiatorQueue );
+                ( void ) xStreamBufferReset( xToEchoStream );
+                ( void ) xStreamBufferReset( xToInitiatorStream );
+
+                ulCacheLines[ smplatPING_INDEX ] = 0;
+                ulCacheLines[ smplatPONG_INDEX ] = 0;
+                ulIPIRequest = 0;
+                ulIPIAck = 0;
+                xIPIEchoReady = pdFALSE;
+                xIPIStop = pdFALSE;
+                uxHandlerSampleCount = 0;
+
+                /* The initiator waits to be told both handles are valid
+                 * before it starts. */
+                xTaskCreateAffinitySet( prvInitiatorTask, "SMPLatIn", smplatTASK_STACK_SIZE, NULL, uxPriority, ( UBaseType_t ) 1U << xInitiatorCore, &xInitiatorTask );
+                xTaskCreateAffinitySet( prvEchoTask, "SMPLatEcho", smplatTASK_STACK_SIZE, NULL, uxPriority, ( UBaseType_t ) 1U << xEchoCore, &xEchoTask );
+                configASSERT( xInitiatorTask );
+                configASSERT( xEchoTask );
+                xTaskNotifyGive( xInitiatorTask );
+
+                /* Both tasks notify this task, then delete themselves. */
+                for( ux = 0; ux < 2; ux++ )
+                {
+                    ( void ) ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+                }
+
+                /* The echo task has finished with ulHandlerSamples[]. */
+                prvReport( "IPI handler", ulHandlerSamples, uxHandlerSampleCount, pdFALSE );
+                uxCycleCounter++;
+            }
+        }
+
+        configSMP_LATENCY_PRINTF( ( "SMP latency: complete%s\r\n", ( xErrorOccurred == pdFALSE ) ? "" : ", errors detected" ) );
+        xTestComplete = pdTRUE;
+        vTaskDelete( NULL );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInitiatorTask( void * pvParameters )
+    {
+        BaseType_t xTest;
+        UBaseType_t uxCount;
+
+        /* Avoid compiler warnings. */
+        ( void ) pvParameters;
+
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        for( xTest = 0; xTest < eNumberOfTests; xTest++ )
+        {
+            uxCount = prvMeasure( xTest );
+            prvReport( pcTestNames[ xTest ], ulSamples, uxCount, pdTRUE );
+            uxCycleCounter++;
+        }
+
+        xTaskNotifyGive( xControllerTask );
+        vTaskDelete( NULL );
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvMeasure( BaseType_t xTest )
+    {
+        uint32_t ul, ulValue, ulReceived = 0, ulStart, ulEnd;
+        UBaseType_t uxCount = 0, uxMisses = 0;
+        BaseType_t xRecord;
+        TickType_t xStartTick;
+
+        if( xTest == eIPITest )
+        {
+            /* Wait for the echo task to calibrate its loop. */
+            xStartTick = xTaskGetTickCount();
+
+            while( xIPIEchoReady == pdFALSE )
+            {
+                if( ( xTaskGetTickCount() - xStartTick ) > smplatBLOCK_TIME )
+                {
+                    xErrorOccurred = pdTRUE;
+                    break;
+                }
+            }
+        }
+
+        for( ul = 0; ul < smplatTOTAL_ITERATIONS; ul++ )
+        {
+            ulValue = ul + 1;
+            xRecord = pdTRUE;
+            ulStart = configSMP_LATENCY_GET_TIMESTAMP();
+
+            switch( xTest )
+            {
+                case eSemaphoreTest:
+                    ( void ) xSemaphoreGive( xToEchoSemaphore );
+                    xRecord = xSemaphoreTake( xToInitiatorSemaphore, smplatBLOCK_TIME );
+                    break;
+
+                case eQueueTest:
+                    ( void ) xQueueSend( xToEchoQueue, &ulValue, 0 );
+
+                    if( ( xQueueReceive( xToInitiatorQueue, &ulReceived, smplatBLOCK_TIME ) != pdPASS ) || ( ulReceived != ulValue ) )
+                    {
+                        xRecord = pdFALSE;
+                    }
+
+                    break;
+
+                case eNotifyTest:
+                    xTaskNotifyGive( xEchoTask );
+
+                    if( ulTaskNotifyTake( pdTRUE, smplatBLOCK_TIME ) == 0 )
+                    {
+                        xRecord = pdFALSE;
+                    }
+
+                    break;
+
+                case eStreamBufferTest:
+                    ( void ) xStreamBufferSend( xToEchoStream, &ulValue, sizeof( ulValue ), 0 );
+
+                    if( ( xStreamBufferReceive( xToInitiatorStream, &ulReceived, sizeof( ulReceived ), smplatBLOCK_TIME ) != sizeof( ulReceived ) ) || ( ulReceived != ulValue ) )
+                    {
+                        xRecord = pdFALSE;
+                    }
+
+                    break;
+
+                case eCacheLineTest:
+                    ulCacheLines[ smplatPING_INDEX ] = ulValue;
+
+                    while( ulCacheLines[ smplatPONG_INDEX ] != ulValue )
+                    {
+                    }
+
+                    break;
+
+                default:
+                    xRecord = prvTriggerIPI( ulValue );
+                    break;
+            }
+
+            ulEnd = configSMP_LATENCY_GET_TIMESTAMP();
+
+            if( xRecord == pdFALSE )
+            {
+                if( xTest == eIPITest )
+                {
+                    /* Missing an IPI is not an error, as the timestamp may
+                     * just be too coarse to see it. */
+                    uxMisses++;
+
+                    if( uxMisses >= smplatMAX_IPI_MISSES )
+                    {
+                        configSMP_LATENCY_PRINTF( ( "SMP %d->%d IPI: not seen, the timestamp may be too coarse\r\n", ( int ) xInitiatorCore, ( int ) xEchoCore ) );
+                        break;
+                    }
+                }
+                else
+                {
+                    xErrorOccurred = pdTRUE;
+                }
+            }
+            else
+            {
+                uxMisses = 0;
+
+                if( ( ul >= smplatWARM_UP_ITERATIONS ) && ( uxCount < configSMP_LATENCY_ITERATIONS ) )
+                {
+                    ulSamples[ uxCount ] = ulEnd - ulStart;
+                    uxCount++;
+                }
+            }
+        }
+
+        if( xTest == eIPITest )
+        {
+            xIPIStop = pdTRUE;
+        }
+
+        return uxCount;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvTriggerIPI( uint32_t ulValue )
+    {
+        TickType_t xStartTick;
+        BaseType_t xReturn = pdPASS;
+
+        ulIPIRequest = ulValue;
+
+        /* The kernel only yields another core from within a critical section,
+         * and leaving it orders the write above before the echo task's
+         * interrupt completes. */
+        taskENTER_CRITICAL();
+        {
+            portYIELD_CORE( xEchoCore );
+        }
+        taskEXIT_CRITICAL();
+
+        xStartTick = xTaskGetTickCount();
+
+        while( ulIPIAck != ulValue )
+        {
+            if( ( xTaskGetTickCount() - xStartTick ) > smplatIPI_TIMEOUT )
+            {
+                xReturn = pdFAIL;
+                break;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvEchoTask( void * pvParameters )
+    {
+        uint32_t ul, ulValue = 0;
+        BaseType_t xTest, xResult = pdPASS;
+
+        /* Avoid compiler warnings. */
+        ( void ) pvParameters;
+
+        for( xTest = 0; xTest < eIPITest; xTest++ )
+        {
+            for( ul = 1; ul <= smplatTOTAL_ITERATIONS; ul++ )
+            {
+                switch( xTest )
+                {
+                    case eSemaphoreTest:
+                        xResult = xSemaphoreTake( xToEchoSemaphore, smplatBLOCK_TIME );
+
+                        if( xResult == pdPASS )
+                        {
+                            ( void ) xSemaphoreGive( xToInitiatorSemaphore );
+                        }
+
+                        break;
+
+                    case eQueueTest:
+                        xResult = xQueueReceive( xToEchoQueue, &ulValue, smplatBLOCK_TIME );
+
+                        if( xResult == pdPASS )
+                        {
+                            ( void ) xQueueSend( xToInitiatorQueue, &ulValue, 0 );
+                        }
+
+                        break;
+
+                    case eNotifyTest:
+                        xResult = ( ulTaskNotifyTake( pdTRUE, smplatBLOCK_TIME ) != 0 ) ? pdPASS : pdFAIL;
+
+                        if( xResult == pdPASS )
+                        {
+                            xTaskNotifyGive( xInitiatorTask );
+                        }
+
+                        break;
+
+                    case eStreamBufferTest:
+                        xResult = ( xStreamBufferReceive( xToEchoStream, &ulValue, sizeof( ulValue ), smplatBLOCK_TIME ) == sizeof( ulValue ) ) ? pdPASS : pdFAIL;
+
+                        if( xResult == pdPASS )
+                        {
+                            ( void ) xStreamBufferSend( xToInitiatorStream, &ulValue, sizeof( ulValue ), 0 );
+                        }
+
+                        break;
+
+                    default:
+                        while( ulCacheLines[ smplatPING_INDEX ] != ul )
+                        {
+                        }
+
+                        ulCacheLines[ smplatPONG_INDEX ] = ul;
+                        xResult = pdPASS;
+                        break;
+                }
+
+                if( xResult != pdPASS )
+                {
+                    xErrorOccurred = pdTRUE;
+                }
+            }
+        }
+
+        prvEchoIPI();
+
+        xTaskNotifyGive( xControllerTask );
+        vTaskDelete( NULL );
+    }
+/*-----------------------------------------------------------*/
+
+    static uint32_t prvCalibrateSpin( void )
+    {
+        uint32_t ulLast, ulNow, ulGap, ulLongest, ulShortestLongest = ~( ( uint32_t ) 0 );
+        UBaseType_t uxRun, uxLoop;
+        volatile TickType_t xTick;
+
+        /* An interrupt during a run makes its longest gap too long, so the
+         * shortest of the runs' longest gaps is used. */
+        for( uxRun = 0; uxRun < smplatCALIBRATION_RUNS; uxRun++ )
+        {
+            ulLongest = 0;
+            ulLast = configSMP_LATENCY_GET_TIMESTAMP();
+
+            for( uxLoop = 0; uxLoop < smplatCALIBRATION_LOOPS; uxLoop++ )
+            {
+                /* The same work as an iteration of the loop in prvEchoIPI(). */
+                xTick = xTaskGetTickCount();
+                ulNow = configSMP_LATENCY_GET_TIMESTAMP();
+                ulGap = ulNow - ulLast;
+                ulLast = ulNow;
+
+                if( ( ulGap > ulLongest ) && ( ulIPIRequest == ulIPIAck ) )
+                {
+                    ulLongest = ulGap;
+                }
+            }
+
+            if( ulLongest < ulShortestLongest )
+            {
+                ulShortestLongest = ulLongest;
+            }
+        }
+
+        ( void ) xTick;
+
+        return ulShortestLongest;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvEchoIPI( void )
+    {
+        uint32_t ulThreshold, ulLast, ulNow, ulGap, ulAcks = 0;
+        TickType_t xTick, xLastTick;
+        UBaseType_t uxCount = 0;
+
+        ulThreshold = ( prvCalibrateSpin() * 2U ) + 1U;
+
+        xLastTick = xTaskGetTickCount();
+        ulLast = configSMP_LATENCY_GET_TIMESTAMP();
+        xIPIEchoReady = pdTRUE;
+
+        while( xIPIStop == pdFALSE )
+        {
+            xTick = xTaskGetTickCount();
+            ulNow = configSMP_LATENCY_GET_TIMESTAMP();
+            ulGap = ulNow - ulLast;
+
+            if( ( ulGap > ulThreshold ) && ( ulIPIRequest != ulIPIAck ) )
+            {
+                /* Only record the gap if no tick happened during it. */
+                if( ( xTick == xLastTick ) && ( ulAcks >= smplatWARM_UP_ITERATIONS ) && ( uxCount < configSMP_LATENCY_ITERATIONS ) )
+                {
+                    ulHandlerSamples[ uxCount ] = ulGap;
+                    uxCount++;
+                }
+
+                ulAcks++;
+                ulIPIAck = ulIPIRequest;
+
+                /* Don't count the time taken above in the next gap. */
+                xTick = xTaskGetTickCount();
+                ulNow = configSMP_LATENCY_GET_TIMESTAMP();
+            }
+
+            xLastTick = xTick;
+            ulLast = ulNow;
+        }
+
+        uxHandlerSampleCount = uxCount;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvReport( const char * pcName,
+                           uint32_t * pulSamples,
+                           UBaseType_t uxCount,
+                           BaseType_t xIsRoundTrip )
+    {
+        UBaseType_t uxGap, ux, uxInner, uxP50, uxP99;
+        uint32_t ulTemp;
+
+        if( uxCount == 0 )
+        {
+            configSMP_LATENCY_PRINTF( ( "SMP %d->%d %-17s: no samples\r\n", ( int ) xInitiatorCore, ( int ) xEchoCore, pcName ) );
+        }
+        else
+        {
+            /* Shell sort, as the samples are in a static buffer and the
+             * number of them is configurable. */
+            for( uxGap = uxCount / 2; uxGap > 0; uxGap /= 2 )
+            {
+                for( ux = uxGap; ux < uxCount; ux++ )
+                {
+                    ulTemp = pulSamples[ ux ];
+
+                    for( uxInner = ux; ( uxInner >= uxGap ) && ( pulSamples[ uxInner - uxGap ] > ulTemp ); uxInner -= uxGap )
+                    {
+                        pulSamples[ uxInner ] = pulSamples[ uxInner - uxGap ];
+                    }
+
+                    pulSamples[ uxInner ] = ulTemp;
+                }
+            }
+
+            /* Nearest rank percentiles. */
+            uxP50 = ( ( uxCount * 500U ) + 999U ) / 1000U - 1U;
+            uxP99 = ( ( uxCount * 990U ) + 999U ) / 1000U - 1U;
+
+            if( xIsRoundTrip != pdFALSE )
+            {
+                configSMP_LATENCY_PRINTF( ( "SMP %d->%d %-17s: n %u p50 %u p99 %u max %u, one way ~%u\r\n",
+                                ( int ) xInitiatorCore, ( int ) xEchoCore, pcName, ( unsigned ) uxCount,
+                                ( unsigned ) pulSamples[ uxP50 ], ( unsigned ) pulSamples[ uxP99 ],
+                                ( unsigned ) pulSamples[ uxCount - 1 ], ( unsigned ) ( pulSamples[ uxP50 ] / 2U ) ) );
+            }
+            else
+            {
+                configSMP_LATENCY_PRINTF( ( "SMP %d->%d %-17s: n %u p50 %u p99 %u max %u\r\n",
+                                ( int ) xInitiatorCore, ( int ) xEchoCore, pcName, ( unsigned ) uxCount,
+                                ( unsigned ) pulSamples[ uxP50 ], ( unsigned ) pulSamples[ uxP99 ],
+                                ( unsigned ) pulSamples[ uxCount - 1 ] ) );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xIsSMPLatencyTestComplete( void )
+    {
+        return xTestComplete;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xAreSMPLatencyTasksStillRunning( void )
+    {
+        static UBaseType_t uxLastCycleCounter = 0;
+        BaseType_t xReturn;
+
+        /* The tests stop making progress once they are complete. */
+        if( xTestComplete == pdFALSE )
+        {
+            if( uxCycleCounter == uxLastCycleCounter )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+            else
+            {
+                uxLastCycleCounter = uxCycleCounter;
+            }
+        }
+
+        if( xErrorOccurred != pdFALSE )
+        {
+            xReturn = pdFAIL;
+        }
+        else
+        {
+            xReturn = pdPASS;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/* Exclude the entire file if there is only one core. */
+#endif /* configNUMBER_OF_CORES > 1 */
@@ -194,6 +194,14 @@
         */
         void vConfigureTickInterrupt( void );
         #define configSETUP_TICK_INTERRUPT() vConfigureTickInterrupt()
+
+        /*
+        * The cross-core latency benchmark compares timestamps taken on the same
+        * core only, so the generic timer's physical count is used as it is
+        * readable from EL1 without any further set up.
+        */
+        uint32_t ulGetSMPLatencyTimestamp( void );
+        #define configSMP_LATENCY_GET_TIMESTAMP() ulGetSMPLatencyTimestamp()
     #endif
 #endif
 
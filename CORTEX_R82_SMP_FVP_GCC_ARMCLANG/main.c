@@ -12,6 +12,9 @@
 #include "semphr.h"
 #include "portmacro.h"
 
+/* Demo includes. */
+#include "SMPLatency.h"
+
 /* GIC includes. */
 #include "gic.h"
 
@@ -22,6 +25,7 @@
 #define TIMER_CTRL_ENABLE          ( 1UL << 0 )                                                       /* Timer ENABLE bit */
 #define TIMER_CTRL_IMASK           ( 1UL << 1 )                                                       /* Timer IMASK bit */
 #define DELAY_MS                   ( pdMS_TO_TICKS( 1000 ) )                                          /* Delay duration in milliseconds */
+#define SMP_LATENCY_PRIORITY       ( tskIDLE_PRIORITY + 1 )                                           /* Priority of the latency benchmark tasks */
 
 volatile uint64_t ulSharedFlag = 0;
 
@@ -128,6 +132,12 @@ int main()
         return EXIT_FAILURE;  /* Failed to create mutex */
     }
 
+    #if ( configNUMBER_OF_CORES > 1 )
+        /* Measure the cross-core handoff latencies once, alongside the ping
+         * pong tasks. */
+        vStartSMPLatencyTasks( SMP_LATENCY_PRIORITY );
+    #endif
+
     vTaskStartScheduler();
 
     /* If all is well, the scheduler will now be running, and the following
@@ -259,6 +269,15 @@ static void prvSetTimerClockHz ( uint64_t ullPhysicalTimerFreq )
     __asm volatile ( "msr cntfrq_el0, %0" :: "r" ( ullPhysicalTimerFreq ) );
 }
 
+uint32_t ulGetSMPLatencyTimestamp( void )
+{
+    uint64_t ullCount;
+
+    /* The isb stops the read being performed early. */
+    __asm volatile ( "isb sy\n mrs %0, cntpct_el0" : "=r" ( ullCount ) :: "memory" );
+    return ( uint32_t ) ullCount;
+}
+
 void vApplicationIRQHandler( uint32_t ulICCIAR )
 {
     /* The ID of the interrupt is obtained by bitwise anding the ICCIAR value
@@ -138,6 +138,12 @@ static int  exp_passes = 27;
 static int  exp_passes = 23;
 #endif
 
+/* Queue read by measure_kernel_queries(). */
+static QueueHandle_t xQueryQueue;
+
+/* Number of tick periods each kernel query is timed over. */
+#define QUERY_TICKS    20
+
 /* Stack size for nonrestricted tasks. */
 #define STACK_SIZE    ((XT_STACK_MIN_SIZE + 1024) / sizeof(StackType_t))
 
@@ -280,6 +286,54 @@ int check_mpu(char name[], uint32_t priv_code_attr, uint32_t priv_data_attr, uin
   return 0;
 }
 
+/* Times the read-only kernel queries that unprivileged tasks make through the
+ * MPU wrappers. CCOUNT can't be read from user mode, so count how many calls
+ * fit into QUERY_TICKS tick periods instead, and divide the cycles in those
+ * periods by that count. The result includes the loop and the tick interrupt,
+ * so only the difference between a privileged and an unprivileged caller, or
+ * between builds with and without configUSE_KERNEL_DATA_PAGE, is meaningful.
+ * The uxQueueMessagesWaiting() loop also reads the tick count, so the cost of
+ * that is subtracted.
+ */
+static void measure_kernel_queries(const char * name)
+{
+  const uint32_t cycles = (uint32_t)QUERY_TICKS * (configCPU_CLOCK_HZ / configTICK_RATE_HZ);
+  volatile UBaseType_t waiting;
+  TickType_t start;
+  uint32_t tick_calls = 0;
+  uint32_t queue_calls = 0;
+  uint32_t tick_cycles;
+  uint32_t queue_cycles;
+
+  /* Start each loop on a tick boundary. */
+  start = xTaskGetTickCount();
+  while (xTaskGetTickCount() == start);
+  start = xTaskGetTickCount();
+  while ((xTaskGetTickCount() - start) < QUERY_TICKS) {
+    tick_calls++;
+  }
+
+  start = xTaskGetTickCount();
+  while (xTaskGetTickCount() == start);
+  start = xTaskGetTickCount();
+  while ((xTaskGetTickCount() - start) < QUERY_TICKS) {
+    waiting = uxQueueMessagesWaiting(xQueryQueue);
+    queue_calls++;
+  }
+  UNUSED(waiting);
+
+  tick_cycles  = cycles / tick_calls;
+  queue_cycles = (cycles / queue_calls) - tick_cycles;
+
+  xt_printf("%s: xTaskGetTickCount %d cycles, uxQueueMessagesWaiting %d cycles", name, tick_cycles, queue_cycles);
+#if defined(configUSE_KERNEL_DATA_PAGE) && (configUSE_KERNEL_DATA_PAGE == 1) && \
+    defined(portKERNEL_DATA_PAGE_IS_USER_READABLE) && (portKERNEL_DATA_PAGE_IS_USER_READABLE == 1)
+  xt_printf(" (kernel data page)\n");
+#else
+  xt_printf("\n");
+#endif
+}
+
 /* Restricted threads only - check private memories attributes */
 int check_private_mpu(TaskParameters_t* taskParams)
 {
@@ -352,6 +406,11 @@ static void restrictedUserTask1( void *arg ) __attribute__ ((optimize("-O0")))
   TEST(0, "6th test",  readData = dummyARRAY1_2[0])
   xt_printf("6th test: readData 0x%x\n", readData);
 
+  /* Cost of read-only kernel queries without privilege, compare with
+   * restrictedPrivTask1.
+   */
+  measure_kernel_queries(__FUNCTION__);
+
   /* TODO: FETCH from privileged functions */
 
   /* TODO: WRITE to a restricted thread private space and read from that thread */
@@ -402,6 +461,11 @@ static void restrictedPrivTask1( void *arg ) __attribute__ ((optimize("-O0")))
   TEST(0, "2nd test", readData = *( volatile uint32_t *) privileged_functions_start);
   xt_printf("2nd test: readData 0x%x\n", readData);
 
+  /* Cost of read-only kernel queries with privilege, which don't need a
+   * system call.
+   */
+  measure_kernel_queries(__FUNCTION__);
+
   /* TODO: Write privileged code - no exception but how to test ? */
   puts("Exiting restrictedPrivTask1'\n");
   vTaskDelete( NULL );
@@ -601,6 +665,12 @@ int main( void )
     exit(1);
   }
 
+  xQueryQueue = xQueueCreate(1, sizeof(uint32_t));
+  if (xQueryQueue == NULL) {
+    printf("Queue Create FAILED!\n");
+    exit(1);
+  }
+
   puts("(MAIN)    xTaskCreate PrivTask1\n");
   xTaskCreate(PrivTask1,                   /* The function that implements the task. */
               "PrivTask1",                 /* Text name for the task. */
@@ -25,17 +25,55 @@
 // perf_test.c -- measure FreeRTOS operation timing.
 
 #include <xtensa/xtutil.h>
+#include <xtensa/hal.h>
 
 #include "testcommon.h"
 #include <stdio.h>
 #include "FreeRTOS.h"
+#include "xtensa_api.h"
 #include "task.h"
 #include "semphr.h"
 #include "event_groups.h"
 #include "queue.h"
+#include "stream_buffer.h"
+#if defined(configUSE_WAIT_OBJECTS) && (configUSE_WAIT_OBJECTS == 1)
+#include "wait_objects.h"
+#endif
+#if defined(configUSE_NOTIFY_OBJECTS) && (configUSE_NOTIFY_OBJECTS == 1)
+#include "notify_objects.h"
+#endif
 
 
+// Number of measured iterations per test case. Each case first runs
+// PERF_WARMUP extra iterations whose samples are discarded, so that cache
+// and branch predictor warm-up does not show up in the results.
+#ifndef TEST_ITER
 #define TEST_ITER  500
+#endif
+#ifndef PERF_WARMUP
+#define PERF_WARMUP  10
+#endif
+#define PERF_RUNS  (TEST_ITER + PERF_WARMUP)
+
+// Result format. Text is the human readable summary, JSON prints one object
+// per line and CSV prints a header followed by one row per result. The JSON
+// and CSV forms can be fed to perf_compare.py to check for regressions.
+#define PERF_OUTPUT_TEXT        0
+#define PERF_OUTPUT_JSON        1
+#define PERF_OUTPUT_CSV         2
+#ifndef PERF_OUTPUT
+#define PERF_OUTPUT             PERF_OUTPUT_TEXT
+#endif
+
+// Histogram buckets are powers of two: bucket n counts samples in the range
+// [2^n, 2^(n+1)), bucket 0 also counts zero and the last bucket counts
+// everything above.
+#define PERF_HIST_BUCKETS       16
+
+// Samples kept per result for the percentiles. The yield test records three
+// context switches per iteration.
+#define PERF_MAX_SAMPLES        (PERF_RUNS * 3)
+
 #define PERF_TEST_PRIORITY      5  // Priorities will vary between 2 and 7
 
 #if ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 0 )
@@ -54,37 +92,155 @@ static char clock_interrupted[TEST_ITER * 3] = {0};
 static volatile uint32_t indx = 0;
 static volatile uint32_t uiTaskResponse[4];
 static volatile uint32_t test_start = 0;
-static uint32_t test_total;
-static uint32_t test_max;
 
 static SemaphoreHandle_t  xSemaphore;
 static SemaphoreHandle_t  xMutex;
 static EventGroupHandle_t xGroupEvents;
 static QueueHandle_t      xQueue;
+static StreamBufferHandle_t xStream;
+static uint32_t event_intnum;
 
-// Compute statistics
+#define STREAM_MSG_SIZE     16
+#define WAIT_NUM_QUEUES     4
+
+// Compute statistics. The samples are kept so that percentiles can be
+// computed when the result is reported.
 typedef struct {
-    int cnt;
-    int sum;
-    int min;
-    int max;
+    uint32_t cnt;
+    uint32_t skip;      // Warm-up samples still to be discarded
+    uint64_t sum;
+    uint64_t sumsq;
+    uint32_t min;
+    uint32_t max;
+    uint32_t hist[PERF_HIST_BUCKETS];
+    uint32_t samples[PERF_MAX_SAMPLES];
 } stats_t;
 
-static void stats_reset(stats_t *s)
+// Results measured by the helper threads and by the test thread itself.
+// These are too large for the test task stacks.
+static stats_t test_stats;
+static stats_t aux_stats;
+
+// Name of the running test case, used to tag the JSON and CSV results.
+static const char * perf_case = "";
+
+static void stats_reset(stats_t *s, uint32_t warmup)
 {
-    s->cnt = s->sum = 0;
-    s->max = -0x7FFFFFFF; // Small number
-    s->min =  0x7FFFFFFF; // Large number
+    uint32_t i;
+
+    s->cnt = 0;
+    s->skip = warmup;
+    s->sum = s->sumsq = 0;
+    s->max = 0;
+    s->min = 0xFFFFFFFF;
+    for (i = 0; i < PERF_HIST_BUCKETS; i++)
+        s->hist[i] = 0;
 }
 
-static void stats_update(stats_t *s, int value)
+static void stats_update(stats_t *s, uint32_t value)
 {
+    uint32_t b;
+
+    if (s->skip) {
+        s->skip--;
+        return;
+    }
+
+    if (s->cnt < PERF_MAX_SAMPLES)
+        s->samples[s->cnt] = value;
     s->cnt++;
     s->sum += value;
+    s->sumsq += (uint64_t)value * value;
     if (s->max < value)
         s->max = value;
     if (s->min > value)
         s->min = value;
+
+    for (b = 0; (b < PERF_HIST_BUCKETS - 1) && (value >> (b + 1)); b++)
+        ;
+    s->hist[b]++;
+}
+
+// Integer square root, to avoid pulling in the math library.
+static uint32_t stats_sqrt(uint64_t v)
+{
+    uint64_t r = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > v)
+        bit >>= 2;
+    while (bit) {
+        if (v >= r + bit) {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        }
+        else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)r;
+}
+
+// Percentile in tenths of a percent, nearest rank. The samples must have
+// been sorted.
+static uint32_t stats_pct(const stats_t *s, uint32_t n, uint32_t permille)
+{
+    uint32_t rank = (uint32_t)(((uint64_t)n * permille + 999) / 1000);
+
+    return s->samples[rank ? rank - 1 : 0];
+}
+
+//-----------------------------------------------------------------------------
+// Print one result. The samples are sorted in place (shell sort, this runs on
+// the small test task stacks), so the stats must be reset before reuse.
+//-----------------------------------------------------------------------------
+static void perf_report(const char * name, stats_t *s)
+{
+    static const uint32_t gaps[] = { 701, 301, 132, 57, 23, 10, 4, 1 };
+    uint32_t n = s->cnt < PERF_MAX_SAMPLES ? s->cnt : PERF_MAX_SAMPLES;
+    uint32_t avg, p50, p99, p999, sd;
+    uint32_t g, i, j, v;
+
+    if (!printStats)
+        return;
+    if (n == 0) {
+        printf("%-37s: no samples\n", name);
+        return;
+    }
+
+    for (g = 0; g < sizeof(gaps) / sizeof(gaps[0]); g++) {
+        for (i = gaps[g]; i < n; i++) {
+            v = s->samples[i];
+            for (j = i; (j >= gaps[g]) && (s->samples[j - gaps[g]] > v); j -= gaps[g])
+                s->samples[j] = s->samples[j - gaps[g]];
+            s->samples[j] = v;
+        }
+    }
+
+    avg  = (uint32_t)(s->sum / s->cnt);
+    sd   = stats_sqrt((s->sumsq - (s->sum * s->sum) / s->cnt) / s->cnt);
+    p50  = stats_pct(s, n, 500);
+    p99  = stats_pct(s, n, 990);
+    p999 = stats_pct(s, n, 999);
+
+#if (PERF_OUTPUT == PERF_OUTPUT_JSON)
+    printf("{\"case\":\"%s\",\"metric\":\"%s\",\"n\":%u,\"min\":%u,\"avg\":%u,"
+           "\"p50\":%u,\"p99\":%u,\"p999\":%u,\"max\":%u,\"stddev\":%u,\"hist\":[",
+           perf_case, name, s->cnt, s->min, avg, p50, p99, p999, s->max, sd);
+    for (i = 0; i < PERF_HIST_BUCKETS; i++)
+        printf(i ? ",%u" : "%u", s->hist[i]);
+    printf("]}\n");
+#elif (PERF_OUTPUT == PERF_OUTPUT_CSV)
+    printf("%s,\"%s\",%u,%u,%u,%u,%u,%u,%u,%u",
+           perf_case, name, s->cnt, s->min, avg, p50, p99, p999, s->max, sd);
+    for (i = 0; i < PERF_HIST_BUCKETS; i++)
+        printf(",%u", s->hist[i]);
+    printf("\n");
+#else
+    printf("%-37s: avg %u p50 %u p99 %u p99.9 %u max %u sd %u cycles\n",
+           name, avg, p50, p99, p999, s->max, sd);
+#endif
 }
 
 static void yield_func(void * arg)
@@ -140,14 +296,13 @@ void sem_get(void * arg)
     volatile uint32_t* pResponse = (volatile uint32_t*)arg;
 
     *pResponse = 0;
-    for(i = 0; i < TEST_ITER; i++) {
+    for(i = 0; i < PERF_RUNS; i++) {
         xSemaphoreTake(xSemaphore, portMAX_DELAY);
         end = xthal_get_ccount();
         if (test_start) {
             uint32_t delta = end - test_start;
 
-            test_total += delta;
-            test_max = test_max >= delta ? test_max : delta;
+            stats_update(&test_stats, delta);
         }
     }
     *pResponse = 1;
@@ -161,8 +316,6 @@ void sem_test(void * arg)
 {
     uint32_t start;
     uint32_t delta;
-    uint32_t total = 0;
-    uint32_t max   = 0;
     uint32_t i;
     TaskHandle_t thandle;
     volatile uint32_t* pResponse = (volatile uint32_t*)arg;
@@ -172,39 +325,35 @@ void sem_test(void * arg)
     printf("\nSemaphore timing test"
            "\n---------------------\n");
 
-    xSemaphore = xSemaphoreCreateCounting( TEST_ITER, 0 );
+    xSemaphore = xSemaphoreCreateCounting( PERF_RUNS, 0 );
 
     portbenchmarkReset(); // If configBENCHMARK is enabled
 
     // First, just measure how long it takes to get and put a semaphore
     // with no contention and no waits/wakeups.
+    stats_reset(&aux_stats, PERF_WARMUP);
 
-    for(i = 0; i < TEST_ITER; i++) {
+    for(i = 0; i < PERF_RUNS; i++) {
         start = xthal_get_ccount();
         xSemaphoreGive(xSemaphore);
         delta = xthal_get_ccount() - start;
-        total += delta;
-        max = max >= delta ? max : delta;
+        stats_update(&aux_stats, delta);
     }
 
-    if (printStats)
-        printf("Semaphore put with no wake           : avg %u max %u cycles\n", total/TEST_ITER, max);
+    perf_report("Semaphore put with no wake", &aux_stats);
 
     // Measure time to get a semaphore with no contention and no waits/
     // wakeups.
-    total = 0;
-    max = 0;
+    stats_reset(&aux_stats, PERF_WARMUP);
 
-    for(i = 0; i < TEST_ITER; i++) {
+    for(i = 0; i < PERF_RUNS; i++) {
         start = xthal_get_ccount();
         xSemaphoreTake(xSemaphore, portMAX_DELAY);
         delta = xthal_get_ccount() - start;
-        total += delta;
-        max = max >= delta ? max : delta;
+        stats_update(&aux_stats, delta);
     }
 
-    if (printStats)
-        printf("Semaphore get with no contention     : avg %u max %u cycles\n", total/TEST_ITER, max);
+    perf_report("Semaphore get with no contention", &aux_stats);
 
     // Now measure the time taken to put a semaphore when a lower priority
     // thread has to be unblocked.
@@ -212,18 +361,16 @@ void sem_test(void * arg)
     uiTaskResponse[0] = 0;
     task_create(sem_get, "sem_get", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[0], portPRIVILEGE_BIT | (PERF_TEST_PRIORITY - 1), NULL);
 
-    total = 0;
-    max = 0;
+    stats_reset(&aux_stats, PERF_WARMUP);
 
-    for(i = 0; i < TEST_ITER; i++) {
+    for(i = 0; i < PERF_RUNS; i++) {
         // Yield CPU so that lower priority thread can run and block itself
         // on the semaphore.
         vTaskDelay(1);
         start = xthal_get_ccount();
         xSemaphoreGive(xSemaphore);
         delta = xthal_get_ccount() - start;
-        total += delta;
-        max = max >= delta ? max : delta;
+        stats_update(&aux_stats, delta);
     }
 
     while (!uiTaskResponse[0])
@@ -231,8 +378,7 @@ void sem_test(void * arg)
         vTaskDelay(10);
     }
 
-    if (printStats)
-        printf("Semaphore put with thread wake       : avg %u max %u cycles\n", total/TEST_ITER, max);
+    perf_report("Semaphore put with thread wake", &aux_stats);
 
     // Now measure the time taken to put a semaphore + context switch when
     // a higher priority thread is unblocked.
@@ -251,10 +397,9 @@ void sem_test(void * arg)
     UNUSED(thandle);
 #endif
 
-    test_total = 0;
-    test_max = 0;
+    stats_reset(&test_stats, PERF_WARMUP);
 
-    for(i = 0; i < TEST_ITER; i++) {
+    for(i = 0; i < PERF_RUNS; i++) {
         // No need to yield CPU here since the other thread is at a higher priority.
         test_start = xthal_get_ccount();
         xSemaphoreGive(xSemaphore);
@@ -265,8 +410,7 @@ void sem_test(void * arg)
         vTaskDelay(10);
     }
 
-    if (printStats)
-        printf("Semaphore put with context switch    : avg %u max %u cycles\n", test_total/TEST_ITER, test_max);
+    perf_report("Semaphore put with context switch", &test_stats);
     *pResponse = 1;
 
     portbenchmarkPrint();
@@ -284,7 +428,7 @@ void mutex_get(void * arg)
     volatile uint32_t* pResponse = (volatile uint32_t*)arg;
     *pResponse = 0;
 
-    for(i = 0; i < TEST_ITER; i ++)
+    for(i = 0; i < PERF_RUNS; i ++)
     {
         xSemaphoreTake(xMutex, portMAX_DELAY);
         xSemaphoreGive(xMutex);
@@ -304,15 +448,14 @@ void mutex_get2(void * arg)
     volatile uint32_t* pResponse = (volatile uint32_t*)arg;
     *pResponse = 0;
 
-    for(i = 0; i < TEST_ITER; i ++)
+    for(i = 0; i < PERF_RUNS; i ++)
     {
         // First get the semaphore to sync with lower priority thread
         xSemaphoreTake(xSemaphore, portMAX_DELAY);
         // Now block on the mutex
         xSemaphoreTake(xMutex, portMAX_DELAY);
         delta = xthal_get_ccount() - test_start;
-        test_total += delta;
-        test_max = test_max >= delta ? test_max : delta;
+        stats_update(&test_stats, delta);
         xSemaphoreGive(xMutex);
     }
 
@@ -327,8 +470,6 @@ void mutex_test(void * arg)
 {
     uint32_t start;
     uint32_t delta;
-    uint32_t total;
-    uint32_t max;
     uint32_t i;
     TaskHandle_t thandle;
     volatile uint32_t* pResponse = (volatile uint32_t*)arg;
@@ -344,42 +485,33 @@ void mutex_test(void * arg)
     // First, just measure how long it takes to lock a mutex with no contention
     // and no waits/wakeups. Also measure how long it takes to unlock.
 
-    test_total = 0;
-    test_max = 0;
-    total = 0;
-    max = 0;
+    stats_reset(&test_stats, PERF_WARMUP);
+    stats_reset(&aux_stats, PERF_WARMUP);
 
-    for(i = 0; i < TEST_ITER; i++)
+    for(i = 0; i < PERF_RUNS; i++)
     {
         start = xthal_get_ccount();
         xSemaphoreTake(xMutex, portMAX_DELAY);
         delta = xthal_get_ccount() - start;
-        test_total += delta;
-        test_max = test_max >= delta ? test_max : delta;
+        stats_update(&test_stats, delta);
 
         start = xthal_get_ccount();
         xSemaphoreGive(xMutex);
         delta = xthal_get_ccount() - start;
-        total += delta;
-        max = max >= delta ? max : delta;
+        stats_update(&aux_stats, delta);
     }
 
-    if (printStats){
-        printf("Mutex lock with no wake/contention   : avg %u max %u cycles\n",
-                test_total/TEST_ITER, test_max);
-        printf("Mutex unlock with no wake/contention : avg %u max %u cycles\n",
-                total/TEST_ITER, max);
-    }
+    perf_report("Mutex lock with no wake/contention", &test_stats);
+    perf_report("Mutex unlock with no wake/contention", &aux_stats);
 
     // Now measure the time taken to unlock a mutex when a lower priority
     // thread has to be unblocked.
     uiTaskResponse[1] = 0;
     task_create(mutex_get, "mutex_get", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[1], portPRIVILEGE_BIT | (PERF_TEST_PRIORITY - 1), NULL);
 
-    test_total = 0;
-    test_max = 0;
+    stats_reset(&test_stats, PERF_WARMUP);
 
-    for(i = 0; i < TEST_ITER; i++)
+    for(i = 0; i < PERF_RUNS; i++)
     {
         xSemaphoreTake(xMutex, portMAX_DELAY);
         // Let the other thread run so that it can block on the mutex
@@ -387,8 +519,7 @@ void mutex_test(void * arg)
         start = xthal_get_ccount();
         xSemaphoreGive(xMutex);
         delta = xthal_get_ccount() - start;
-        test_total += delta;
-        test_max = test_max >= delta ? test_max : delta;
+        stats_update(&test_stats, delta);
     }
 
     while (!uiTaskResponse[1])
@@ -396,9 +527,7 @@ void mutex_test(void * arg)
         vTaskDelay(10);
     }
 
-    if (printStats)
-        printf("Mutex unlock with thread wake        : avg %u max %u cycles\n",
-                test_total/TEST_ITER, test_max);
+    perf_report("Mutex unlock with thread wake", &test_stats);
     // Now measure the time taken to unlock a mutex + context switch when
     // a higher priority thread is unblocked.
 
@@ -415,10 +544,9 @@ void mutex_test(void * arg)
     UNUSED(thandle);
 #endif
 
-    test_total = 0;
-    test_max = 0;
+    stats_reset(&test_stats, PERF_WARMUP);
 
-    for(i = 0; i < TEST_ITER; i++)
+    for(i = 0; i < PERF_RUNS; i++)
     {
         xSemaphoreTake(xMutex, portMAX_DELAY);
         // Now signal the other thread with the semaphore. This will cause an
@@ -434,9 +562,97 @@ void mutex_test(void * arg)
         vTaskDelay(10);
     }
 
-    if (printStats)
-        printf("Mutex unlock with context switch     : avg %u max %u cycles\n",
-                test_total/TEST_ITER, test_max);
+    perf_report("Mutex unlock with context switch", &test_stats);
+
+    portbenchmarkPrint();
+
+    vSemaphoreDelete(xSemaphore);
+    vSemaphoreDelete(xMutex);
+
+    *pResponse = 1;
+    vTaskDelete(NULL);
+}
+
+#if defined(configUSE_PRIORITY_CEILING_MUTEXES) && (configUSE_PRIORITY_CEILING_MUTEXES == 1)
+//-----------------------------------------------------------------------------
+// Priority ceiling mutex timing test. Same measurements as mutex_test, with
+// the ceiling set to the priority of the highest priority user (mutex_get2).
+// The unlock with thread wake case is not measured since it needs the holder
+// to block while holding the mutex, which breaks the ceiling protocol.
+//-----------------------------------------------------------------------------
+void ceil_mutex_test(void * arg)
+{
+    uint32_t start;
+    uint32_t delta;
+    uint32_t i;
+    TaskHandle_t thandle;
+    volatile uint32_t* pResponse = (volatile uint32_t*)arg;
+    *pResponse = 0;
+    printf("\nCeiling mutex timing test"
+           "\n-------------------------\n");
+
+    xMutex = xSemaphoreCreateMutexWithCeiling(PERF_TEST_PRIORITY + 1);
+    vSemaphoreCreateBinary(xSemaphore);
+
+    portbenchmarkReset(); // If configBENCHMARK is enabled
+
+    // First measure lock and unlock with no contention. Lock raises this
+    // thread to the ceiling and unlock lowers it again.
+
+    stats_reset(&test_stats, PERF_WARMUP);
+    stats_reset(&aux_stats, PERF_WARMUP);
+
+    for(i = 0; i < PERF_RUNS; i++)
+    {
+        start = xthal_get_ccount();
+        xSemaphoreTake(xMutex, portMAX_DELAY);
+        delta = xthal_get_ccount() - start;
+        stats_update(&test_stats, delta);
+
+        start = xthal_get_ccount();
+        xSemaphoreGive(xMutex);
+        delta = xthal_get_ccount() - start;
+        stats_update(&aux_stats, delta);
+    }
+
+    perf_report("Ceiling mutex lock with no contention", &test_stats);
+    perf_report("Ceiling mutex unlock with no contention", &aux_stats);
+
+    // Now measure the time from unlock to a higher priority thread holding
+    // the mutex. Running at the ceiling, this thread is not preempted when it
+    // signals the other thread, so the other thread never blocks on the mutex
+    // and runs when the unlock lowers this thread's priority.
+
+    uiTaskResponse[1] = 0;
+    task_create(mutex_get2, "mutex_get2", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[1], portPRIVILEGE_BIT | (PERF_TEST_PRIORITY + 1), &thandle);
+
+#if (configNUMBER_OF_CORES > 1)
+    {
+        // Require mutex task and mutex_get2 to run on the same core for profiling
+        int core = portGET_CORE_ID();
+        vTaskCoreAffinitySet(NULL, 1 << core);
+        vTaskCoreAffinitySet(thandle, 1 << core);
+    }
+#else
+    UNUSED(thandle);
+#endif
+
+    stats_reset(&test_stats, PERF_WARMUP);
+
+    for(i = 0; i < PERF_RUNS; i++)
+    {
+        xSemaphoreTake(xMutex, portMAX_DELAY);
+        xSemaphoreGive(xSemaphore);
+        test_start = xthal_get_ccount();
+        xSemaphoreGive(xMutex);
+    }
+
+    while (!uiTaskResponse[1])
+    {
+        vTaskDelay(10);
+    }
+
+    perf_report("Ceiling mutex unlock to waiter running", &test_stats);
 
     portbenchmarkPrint();
 
@@ -446,6 +662,7 @@ void mutex_test(void * arg)
     *pResponse = 1;
     vTaskDelete(NULL);
 }
+#endif
 
 
 //-----------------------------------------------------------------------------
@@ -457,7 +674,7 @@ void event_get(void * arg)
     volatile uint32_t* pResponse = (volatile uint32_t*)arg;
 
     *pResponse = 0;
-    for(i = 0; i < TEST_ITER; i ++)
+    for(i = 0; i < PERF_RUNS; i ++)
     {
         xEventGroupWaitBits(xGroupEvents, 0xFFFF, pdFALSE, pdTRUE, portMAX_DELAY);
         xEventGroupClearBits(xGroupEvents, 0xFFFF);
@@ -479,15 +696,14 @@ void event_get2(void * arg)
     volatile uint32_t* pResponse = (volatile uint32_t*)arg;
 
     *pResponse = 0;
-    for(i = 0; i < TEST_ITER; i ++)
+    for(i = 0; i < PERF_RUNS; i ++)
     {
         // First get the semaphore to sync with lower priority thread
         xSemaphoreTake(xSemaphore, portMAX_DELAY);
         // Now block on the event
         xEventGroupWaitBits(xGroupEvents, 0xFFFF, pdFALSE, pdTRUE, portMAX_DELAY);
         delta = xthal_get_ccount() - test_start;
-        test_total += delta;
-        test_max = test_max >= delta ? test_max : delta;
+        stats_update(&test_stats, delta);
         xEventGroupClearBits(xGroupEvents, 0xFFFF);
     }
 
@@ -495,6 +711,77 @@ void event_get2(void * arg)
     vTaskDelete(NULL);
 }
 
+//-----------------------------------------------------------------------------
+// Helper thread 3 for event tests. Measures the time from an interrupt
+// handler being triggered to this thread running after the handler sets the
+// single event bit it is blocked on.
+//-----------------------------------------------------------------------------
+void event_get3(void * arg)
+{
+    uint32_t delta;
+    uint32_t i;
+
+    volatile uint32_t* pResponse = (volatile uint32_t*)arg;
+
+    *pResponse = 0;
+    for(i = 0; i < PERF_RUNS; i ++)
+    {
+        // First get the semaphore to sync with lower priority thread
+        xSemaphoreTake(xSemaphore, portMAX_DELAY);
+        // Now block on the event bit, clearing it on the way out
+        xEventGroupWaitBits(xGroupEvents, 0x1, pdTRUE, pdFALSE, portMAX_DELAY);
+        delta = xthal_get_ccount() - test_start;
+        stats_update(&test_stats, delta);
+    }
+
+    *pResponse = 1;
+    vTaskDelete(NULL);
+}
+
+
+//-----------------------------------------------------------------------------
+// Software interrupt handler for event tests. Sets the bit that event_get3
+// is blocked on. With configUSE_EVENT_GROUPS_DIRECT the bit is set here,
+// otherwise the operation is deferred to the timer task.
+//-----------------------------------------------------------------------------
+void event_isr(void * arg)
+{
+    BaseType_t xWoken = pdFALSE;
+
+    UNUSED(arg);
+    xEventGroupSetBitsFromISR(xGroupEvents, 0x1, &xWoken);
+    portYIELD_FROM_ISR(xWoken);
+}
+
+
+//-----------------------------------------------------------------------------
+// Find a software interrupt that can call FreeRTOS, or return -1.
+//-----------------------------------------------------------------------------
+static int32_t event_find_swint(void)
+{
+    int32_t i;
+#if XCHAL_HAVE_XEA3
+    int32_t rtos_int_found = 0;
+#endif
+
+    for (i = 0; i < XCHAL_NUM_INTERRUPTS; i++) {
+        if ((Xthal_inttype[i] == XTHAL_INTTYPE_SOFTWARE) &&
+            (Xthal_intlevel[i] <= XCHAL_EXCM_LEVEL)) {
+#if XCHAL_HAVE_XEA3
+            // The first one is reserved for the RTOS
+            if (!rtos_int_found) {
+                rtos_int_found = 1;
+                continue;
+            }
+#endif
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+
 //-----------------------------------------------------------------------------
 // Event operations timing test.
 //-----------------------------------------------------------------------------
@@ -502,9 +789,8 @@ void event_test(void * arg)
 {
     uint32_t start;
     uint32_t delta;
-    uint32_t total;
-    uint32_t max;
     uint32_t i;
+    int32_t intnum;
 
     TaskHandle_t thandle;
     volatile uint32_t* pResponse = (volatile uint32_t*)arg;
@@ -526,32 +812,24 @@ void event_test(void * arg)
     // First, just measure how long it takes to set an event with no contention
     // and no waits/wakeups. Also measure how long it takes to clear.
 
-    test_total = 0;
-    test_max = 0;
-    total = 0;
-    max = 0;
+    stats_reset(&test_stats, PERF_WARMUP);
+    stats_reset(&aux_stats, PERF_WARMUP);
 
-    for(i = 0; i < TEST_ITER; i++)
+    for(i = 0; i < PERF_RUNS; i++)
     {
         start = xthal_get_ccount();
         xEventGroupSetBits(xGroupEvents, 0xFFFF);
         delta = xthal_get_ccount() - start;
-        test_total += delta;
-        test_max = test_max >= delta ? test_max : delta;
+        stats_update(&test_stats, delta);
 
         start = xthal_get_ccount();
         xEventGroupClearBits(xGroupEvents, 0xFFFF);
         delta = xthal_get_ccount() - start;
-        total += delta;
-        max = max >= delta ? max : delta;
+        stats_update(&aux_stats, delta);
     }
 
-    if (printStats) {
-        printf("Event set with no wake/contention    : avg %u max %u cycles\n",
-                test_total/TEST_ITER, test_max);
-        printf("Event clear with no wake/contention  : avg %u max %u cycles\n",
-                total/TEST_ITER, max);
-    }
+    perf_report("Event set with no wake/contention", &test_stats);
+    perf_report("Event clear with no wake/contention", &aux_stats);
 
     // Now measure the time taken to set an event when a lower priority
     // thread has to be unblocked.
@@ -562,10 +840,9 @@ void event_test(void * arg)
     // Let the other thread run so that it can block on the event
     vTaskDelay(1);
 
-    test_total = 0;
-    test_max = 0;
+    stats_reset(&test_stats, PERF_WARMUP);
 
-    for(i = 0; i < TEST_ITER; i++)
+    for(i = 0; i < PERF_RUNS; i++)
     {
         xEventGroupClearBits(xGroupEvents, 0xFFFF);
         // Let the other thread run so that it can block on the event
@@ -573,8 +850,7 @@ void event_test(void * arg)
         start = xthal_get_ccount();
         xEventGroupSetBits(xGroupEvents, 0xFFFF);
         delta = xthal_get_ccount() - start;
-        test_total += delta;
-        test_max = test_max >= delta ? test_max : delta;
+        stats_update(&test_stats, delta);
     }
 
     while (!uiTaskResponse[1])
@@ -582,9 +858,7 @@ void event_test(void * arg)
         vTaskDelay(100);
     }
 
-    if (printStats)
-        printf("Event set with thread wake           : avg %u max %u cycles\n",
-                test_total/TEST_ITER, test_max);
+    perf_report("Event set with thread wake", &test_stats);
 
     // Now measure the time taken to set an event + context switch when
     // a higher priority thread is unblocked.
@@ -599,10 +873,9 @@ void event_test(void * arg)
     UNUSED(thandle);
 #endif
 
-    test_total = 0;
-    test_max = 0;
+    stats_reset(&test_stats, PERF_WARMUP);
 
-    for(i = 0; i < TEST_ITER; i++)
+    for(i = 0; i < PERF_RUNS; i++)
     {
         xEventGroupClearBits(xGroupEvents, 0xFFFF);
         // Now signal the other thread with the semaphore. This will cause an
@@ -618,9 +891,48 @@ void event_test(void * arg)
         vTaskDelay(100);
     }
 
-    if (printStats)
-        printf("Event set with context switch        : avg %u max %u cycles\n",
-                test_total/TEST_ITER, test_max);
+    perf_report("Event set with context switch", &test_stats);
+
+    // Now measure the set-to-wake latency when an interrupt handler sets the
+    // bit a higher priority thread is blocked on.
+
+    intnum = event_find_swint();
+    if (intnum < 0) {
+        printf("No software interrupt found, skipping event set from ISR test\n");
+    }
+    else {
+        event_intnum = (uint32_t)intnum;
+        xt_set_interrupt_handler(event_intnum, event_isr, NULL);
+        xt_interrupt_enable(event_intnum);
+
+        uiTaskResponse[1] = 0;
+        task_create(event_get3, "event_get3", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[1], portPRIVILEGE_BIT | (PERF_TEST_PRIORITY + 1), &thandle);
+
+#if (configNUMBER_OF_CORES > 1)
+        // The software interrupt is taken on this core, keep event_get3 here too
+        vTaskCoreAffinitySet(thandle, 1 << portGET_CORE_ID());
+#endif
+
+        stats_reset(&test_stats, PERF_WARMUP);
+
+        for(i = 0; i < PERF_RUNS; i++)
+        {
+            // Let the other thread block on the event bit, then trigger the
+            // interrupt that sets it.
+            xSemaphoreGive(xSemaphore);
+            test_start = xthal_get_ccount();
+            xt_interrupt_trigger(event_intnum);
+        }
+
+        while (!uiTaskResponse[1])
+        {
+            vTaskDelay(100);
+        }
+
+        xt_interrupt_disable(event_intnum);
+
+        perf_report("Event set from ISR with context switch", &test_stats);
+    }
 
     portbenchmarkPrint();
 
@@ -642,7 +954,7 @@ void msg_get(void * arg)
     volatile uint32_t* pResponse = (volatile uint32_t*)arg;
 
     *pResponse = 0;
-    for(i = 0; i < TEST_ITER; i++)
+    for(i = 0; i < PERF_RUNS; i++)
     {
         xQueueReceive(xQueue, msg, portMAX_DELAY);
     }
@@ -663,15 +975,14 @@ void msg_get2(void * arg)
     volatile uint32_t* pResponse = (volatile uint32_t*)arg;
 
     *pResponse = 0;
-    for(i = 0; i < TEST_ITER; i++)
+    for(i = 0; i < PERF_RUNS; i++)
     {
         // First get the semaphore to sync with lower priority thread
         xSemaphoreTake(xSemaphore, portMAX_DELAY);
         // Now block on the queue
         xQueueReceive(xQueue, msg, portMAX_DELAY);
         delta = xthal_get_ccount() - test_start;
-        test_total += delta;
-        test_max = test_max >= delta ? test_max : delta;
+        stats_update(&test_stats, delta);
  //       xEventGroupClearBits(xGroupEvents, 0xFFFF);
     }
 
@@ -685,13 +996,10 @@ void msg_get2(void * arg)
 //-----------------------------------------------------------------------------
 void msgq_test(void* arg)
 {
-    int32_t  i;
+    int32_t  i, j;
     uint32_t msg[4];
-    uint32_t sum = 0;
-    uint32_t max = 0;
     uint32_t start;
     uint32_t delta;
-    uint32_t get_avg, get_max, put_avg, put_max;
 
     TaskHandle_t thandle;
     volatile uint32_t* pResponse = (volatile uint32_t*)arg;
@@ -708,40 +1016,32 @@ void msgq_test(void* arg)
 
     portbenchmarkReset(); // If configBENCHMARK is enabled
 
-    for (i = 0; i < 16; i++)
-    {
-        start = xthal_get_ccount();
-        xQueueSend(xQueue, msg, portMAX_DELAY);
-        delta = xthal_get_ccount() - start;
-        sum += delta;
-        max = max >= delta ? max : delta;
-    }
-
-    put_avg = sum/16;
-    put_max = max;
+    // The queue holds 16 messages, so fill and drain it until every
+    // operation has been measured PERF_RUNS times.
+    stats_reset(&test_stats, PERF_WARMUP);
+    stats_reset(&aux_stats, PERF_WARMUP);
 
-    sum = 0;
-    max = 0;
-
-    for (i = 0; i < 16; i++)
+    for (i = 0; i < PERF_RUNS; i += 16)
     {
-        start = xthal_get_ccount();
+        for (j = 0; j < 16; j++)
+        {
+            start = xthal_get_ccount();
+            xQueueSend(xQueue, msg, portMAX_DELAY);
+            delta = xthal_get_ccount() - start;
+            stats_update(&aux_stats, delta);
+        }
 
-        xQueueReceive(xQueue, msg, portMAX_DELAY);
-        delta = xthal_get_ccount() - start;
-        sum += delta;
-        max = max >= delta ? max : delta;
+        for (j = 0; j < 16; j++)
+        {
+            start = xthal_get_ccount();
+            xQueueReceive(xQueue, msg, portMAX_DELAY);
+            delta = xthal_get_ccount() - start;
+            stats_update(&test_stats, delta);
+        }
     }
 
-    get_avg = sum/16;
-    get_max = max;
-
-    if (printStats) {
-        printf("Message put with no wake/contention  : avg %u max %u cycles\n",
-                put_avg, put_max);
-        printf("Message get with no wake/contention  : avg %u max %u cycles\n",
-                get_avg, get_max);
-    }
+    perf_report("Message put with no wake/contention", &aux_stats);
+    perf_report("Message get with no wake/contention", &test_stats);
 
     // Now measure the time taken to send a message when a lower priority
     // thread has to be unblocked.
@@ -749,18 +1049,16 @@ void msgq_test(void* arg)
     uiTaskResponse[1] = 0;
     task_create(msg_get, "msg_get", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[1], portPRIVILEGE_BIT | (PERF_TEST_PRIORITY - 1), NULL);
 
-    test_total = 0;
-    test_max = 0;
+    stats_reset(&test_stats, PERF_WARMUP);
 
-    for(i = 0; i < TEST_ITER; i++)
+    for(i = 0; i < PERF_RUNS; i++)
     {
         // Let the other thread run so that it can block on the event
         vTaskDelay(1);
         start = xthal_get_ccount();
         xQueueSend(xQueue, msg, portMAX_DELAY);
         delta = xthal_get_ccount() - start;
-        test_total += delta;
-        test_max = test_max >= delta ? test_max : delta;
+        stats_update(&test_stats, delta);
     }
 
     while (!uiTaskResponse[1])
@@ -768,9 +1066,7 @@ void msgq_test(void* arg)
         vTaskDelay(100);
     }
 
-    if (printStats)
-        printf("Message put with thread wake         : avg %u max %u cycles\n",
-                test_total/TEST_ITER, test_max);
+    perf_report("Message put with thread wake", &test_stats);
 
     // Now measure the time taken to set an event + context switch when
     // a higher priority thread is unblocked.
@@ -789,10 +1085,9 @@ void msgq_test(void* arg)
     UNUSED(thandle);
 #endif
 
-    test_total = 0;
-    test_max = 0;
+    stats_reset(&test_stats, PERF_WARMUP);
 
-    for(i = 0; i < TEST_ITER; i++)
+    for(i = 0; i < PERF_RUNS; i++)
     {
         // Now signal the other thread with the semaphore. This will cause an
         // immediate switch to the other thread, which will then block on the
@@ -807,9 +1102,7 @@ void msgq_test(void* arg)
         vTaskDelay(100);
     }
 
-    if (printStats)
-        printf("Message put with context switch      : avg %u max %u cycles\n",
-                test_total/TEST_ITER, test_max);
+    perf_report("Message put with context switch", &test_stats);
 
     portbenchmarkPrint();
 
@@ -819,54 +1112,659 @@ void msgq_test(void* arg)
 
 
 //-----------------------------------------------------------------------------
-// Yield test - runs in main thread. Start 3 threads to measure the context
-// switch time. Wait for them all to exit. Then compute the average and worst
-// case switch times.
+// Helper thread for stream buffer tests.
 //-----------------------------------------------------------------------------
-void yieldTest(void)
+void stream_get(void * arg)
 {
-#define OVERHEAD_MEASUREMENT_RPT	10
-    uint32_t oh_cycles;
     uint32_t i;
+    uint8_t data[STREAM_MSG_SIZE];
+    volatile uint32_t* pResponse = (volatile uint32_t*)arg;
 
-    printf("\nYield timing test"
-           "\n-----------------\n");
+    *pResponse = 0;
+    for(i = 0; i < PERF_RUNS; i++)
+    {
+        xStreamBufferReceive(xStream, data, sizeof(data), portMAX_DELAY);
+    }
 
-    // Measure the overhead of updating the cycle count
+    *pResponse = 1;
+    vTaskDelete(NULL);
+}
 
-    register uint32_t state0 = portENTER_CRITICAL_NESTED();
 
-    for (i = 0; i < OVERHEAD_MEASUREMENT_RPT; i++) {
-        // Copied from yield_func to calibrate timing
-        uint32_t state = portENTER_CRITICAL_NESTED();
-        clock_vals[indx++] = xthal_get_ccount();
-        portEXIT_CRITICAL_NESTED(state);
+//-----------------------------------------------------------------------------
+// Helper thread 2 for stream buffer tests.
+//-----------------------------------------------------------------------------
+void stream_get2(void * arg)
+{
+    uint32_t delta;
+    uint32_t i;
+    uint8_t data[STREAM_MSG_SIZE];
+    volatile uint32_t* pResponse = (volatile uint32_t*)arg;
+
+    *pResponse = 0;
+    for(i = 0; i < PERF_RUNS; i++)
+    {
+        // First get the semaphore to sync with lower priority thread
+        xSemaphoreTake(xSemaphore, portMAX_DELAY);
+        // Now block on the stream buffer
+        xStreamBufferReceive(xStream, data, sizeof(data), portMAX_DELAY);
+        delta = xthal_get_ccount() - test_start;
+        stats_update(&test_stats, delta);
     }
 
-    portEXIT_CRITICAL_NESTED(state0);
+    *pResponse = 1;
+    vTaskDelete(NULL);
+}
 
-    portbenchmarkReset(); // If configBENCHMARK is enabled
 
-    oh_cycles = (clock_vals[indx-1] - clock_vals[indx-OVERHEAD_MEASUREMENT_RPT]) / (OVERHEAD_MEASUREMENT_RPT -1);
-    indx = 0;
+//-----------------------------------------------------------------------------
+// Stream buffer test. The sender and receiver are always the only writer and
+// reader, so with configUSE_SB_LOCK_FREE the uncontended cases should not
+// enter a critical section or suspend the scheduler at all.
+//-----------------------------------------------------------------------------
+void stream_test(void* arg)
+{
+    int32_t  i, j;
+    uint8_t  data[STREAM_MSG_SIZE] = {0};
+    uint32_t start;
+    uint32_t delta;
 
-    // Launch test threads
-    uiTaskResponse[0] = uiTaskResponse[1] = uiTaskResponse[2] = 0;
-    vTaskPrioritySet( NULL, PERF_TEST_PRIORITY + 2);
-    task_create( yield_func, "thd1", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[0], portPRIVILEGE_BIT | (PERF_TEST_PRIORITY +2), NULL );
-    task_create( yield_func, "thd2", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[1], portPRIVILEGE_BIT | (PERF_TEST_PRIORITY +2), NULL );
-    task_create( yield_func, "thd3", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[2], portPRIVILEGE_BIT | (PERF_TEST_PRIORITY +2), NULL );
+    TaskHandle_t thandle;
+    volatile uint32_t* pResponse = (volatile uint32_t*)arg;
 
-    vTaskPrioritySet( NULL, PERF_TEST_PRIORITY);
-    // Wait for them all to finish
-    while (3 > (uiTaskResponse[0] + uiTaskResponse[1] + uiTaskResponse[2]))
-    {
-        vTaskDelay(50);
-    }
+    *pResponse = 0;
 
-    // Compute average values for solicited context switch
-    stats_t solicited;
-    stats_reset(&solicited);
+    printf("\nStream Buffer timing test"
+           "\n-------------------------\n");
+#if defined(configUSE_SB_LOCK_FREE) && (configUSE_SB_LOCK_FREE == 1)
+    printf("configUSE_SB_LOCK_FREE enabled\n");
+#else
+    printf("configUSE_SB_LOCK_FREE disabled\n");
+#endif
+
+    // First, measure the time taken to send and receive when no thread
+    // wakeup/context switch is involved.
+    vSemaphoreCreateBinary(xSemaphore);
+    xStream = xStreamBufferCreate(16 * STREAM_MSG_SIZE + 1, STREAM_MSG_SIZE);
+
+    portbenchmarkReset(); // If configBENCHMARK is enabled
+
+    // The buffer holds 16 messages, so fill and drain it until every
+    // operation has been measured PERF_RUNS times.
+    stats_reset(&test_stats, PERF_WARMUP);
+    stats_reset(&aux_stats, PERF_WARMUP);
+
+    for (i = 0; i < PERF_RUNS; i += 16)
+    {
+        for (j = 0; j < 16; j++)
+        {
+            start = xthal_get_ccount();
+            xStreamBufferSend(xStream, data, sizeof(data), portMAX_DELAY);
+            delta = xthal_get_ccount() - start;
+            stats_update(&aux_stats, delta);
+        }
+
+        for (j = 0; j < 16; j++)
+        {
+            start = xthal_get_ccount();
+            xStreamBufferReceive(xStream, data, sizeof(data), portMAX_DELAY);
+            delta = xthal_get_ccount() - start;
+            stats_update(&test_stats, delta);
+        }
+    }
+
+    perf_report("Stream send with no wake/contention", &aux_stats);
+    perf_report("Stream recv with no wake/contention", &test_stats);
+
+    // Now measure the time taken to send when a lower priority thread
+    // has to be unblocked.
+
+    uiTaskResponse[1] = 0;
+    task_create(stream_get, "stream_get", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[1], portPRIVILEGE_BIT | (PERF_TEST_PRIORITY - 1), NULL);
+
+    stats_reset(&test_stats, PERF_WARMUP);
+
+    for(i = 0; i < PERF_RUNS; i++)
+    {
+        // Let the other thread run so that it can block on the stream buffer
+        vTaskDelay(1);
+        start = xthal_get_ccount();
+        xStreamBufferSend(xStream, data, sizeof(data), portMAX_DELAY);
+        delta = xthal_get_ccount() - start;
+        stats_update(&test_stats, delta);
+    }
+
+    while (!uiTaskResponse[1])
+    {
+        vTaskDelay(100);
+    }
+
+    perf_report("Stream send with thread wake", &test_stats);
+
+    // Now measure the time taken to send + context switch when a higher
+    // priority thread is unblocked.
+
+    uiTaskResponse[1] = 0;
+    task_create(stream_get2, "stream_get2", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[1], portPRIVILEGE_BIT | (PERF_TEST_PRIORITY + 1), &thandle);
+
+#if (configNUMBER_OF_CORES > 1)
+    {
+        // Require stream task and stream_get2 to run on the same core for profiling
+        int core = portGET_CORE_ID();
+        vTaskCoreAffinitySet(NULL, 1 << core);
+        vTaskCoreAffinitySet(thandle, 1 << core);
+    }
+#else
+    UNUSED(thandle);
+#endif
+
+    stats_reset(&test_stats, PERF_WARMUP);
+
+    for(i = 0; i < PERF_RUNS; i++)
+    {
+        // Now signal the other thread with the semaphore. This will cause an
+        // immediate switch to the other thread, which will then block on the
+        // stream buffer and give back control to here.
+        xSemaphoreGive(xSemaphore);
+        test_start = xthal_get_ccount();
+        xStreamBufferSend(xStream, data, sizeof(data), portMAX_DELAY);
+    }
+
+    while (!uiTaskResponse[1])
+    {
+        vTaskDelay(100);
+    }
+
+    perf_report("Stream send with context switch", &test_stats);
+
+    portbenchmarkPrint();
+
+    vSemaphoreDelete(xSemaphore);
+    vStreamBufferDelete(xStream);
+
+    *pResponse = 1;
+    vTaskDelete(NULL);
+}
+
+
+#if defined(configUSE_WAIT_OBJECTS) && (configUSE_WAIT_OBJECTS == 1) && (configUSE_QUEUE_SETS == 1)
+
+static QueueHandle_t      xWaitQueues[WAIT_NUM_QUEUES];
+static QueueSetHandle_t   xWaitSet;
+
+//-----------------------------------------------------------------------------
+// Helper thread for multi-object wait tests. Blocks on all the queues through
+// a queue set, then reads from the queue that was selected.
+//-----------------------------------------------------------------------------
+void qset_get(void * arg)
+{
+    uint32_t delta;
+    uint32_t i;
+    uint32_t data;
+    QueueSetMemberHandle_t xMember;
+    volatile uint32_t* pResponse = (volatile uint32_t*)arg;
+
+    *pResponse = 0;
+    for(i = 0; i < PERF_RUNS; i++)
+    {
+        xMember = xQueueSelectFromSet(xWaitSet, portMAX_DELAY);
+        xQueueReceive((QueueHandle_t)xMember, &data, 0);
+        delta = xthal_get_ccount() - test_start;
+        stats_update(&test_stats, delta);
+    }
+
+    *pResponse = 1;
+    vTaskDelete(NULL);
+}
+
+
+//-----------------------------------------------------------------------------
+// Helper thread for multi-object wait tests. Blocks on all the queues with
+// xWaitForMultipleObjects(), then reads from the queue that is ready.
+//-----------------------------------------------------------------------------
+void waitobj_get(void * arg)
+{
+    uint32_t delta;
+    uint32_t i;
+    uint32_t data;
+    BaseType_t xIndex;
+    WaitObject_t xObjects[WAIT_NUM_QUEUES];
+    volatile uint32_t* pResponse = (volatile uint32_t*)arg;
+
+    for(i = 0; i < WAIT_NUM_QUEUES; i++)
+    {
+        xObjects[i].eType    = eWaitObjectQueue;
+        xObjects[i].pvObject = (void *)xWaitQueues[i];
+        xObjects[i].uxIndex  = 0;
+    }
+
+    *pResponse = 0;
+    for(i = 0; i < PERF_RUNS; i++)
+    {
+        xIndex = xWaitForMultipleObjects(xObjects, WAIT_NUM_QUEUES, portMAX_DELAY);
+        xQueueReceive(xWaitQueues[xIndex], &data, 0);
+        delta = xthal_get_ccount() - test_start;
+        stats_update(&test_stats, delta);
+    }
+
+    *pResponse = 1;
+    vTaskDelete(NULL);
+}
+
+
+//-----------------------------------------------------------------------------
+// Multi-object wait test. Measures the time from a send to one of several
+// queues until a higher priority thread that waits on all of them has read
+// the item, first waiting through a queue set and then with
+// xWaitForMultipleObjects(). The queue set copies a handle into the set queue
+// on every send and the reader has to take it out again, the wait object path
+// only sends a notification to the waiting thread.
+//-----------------------------------------------------------------------------
+void waitobj_test(void * arg)
+{
+    int32_t  i;
+    uint32_t data = 0;
+    char     name[40];
+
+    TaskHandle_t thandle;
+    volatile uint32_t* pResponse = (volatile uint32_t*)arg;
+
+    *pResponse = 0;
+
+    printf("\nMulti-object wait timing test"
+           "\n-----------------------------\n");
+
+    // First, wait through a queue set that holds every queue.
+    xWaitSet = xQueueCreateSet(WAIT_NUM_QUEUES);
+    for (i = 0; i < WAIT_NUM_QUEUES; i++)
+    {
+        xWaitQueues[i] = xQueueCreate(1, sizeof(uint32_t));
+        xQueueAddToSet(xWaitQueues[i], xWaitSet);
+    }
+
+    portbenchmarkReset(); // If configBENCHMARK is enabled
+
+    uiTaskResponse[1] = 0;
+    task_create(qset_get, "qset_get", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[1], portPRIVILEGE_BIT | (PERF_TEST_PRIORITY + 1), &thandle);
+
+#if (configNUMBER_OF_CORES > 1)
+    {
+        // Require waitobj task and qset_get to run on the same core for profiling
+        int core = portGET_CORE_ID();
+        vTaskCoreAffinitySet(NULL, 1 << core);
+        vTaskCoreAffinitySet(thandle, 1 << core);
+    }
+#else
+    UNUSED(thandle);
+#endif
+
+    stats_reset(&test_stats, PERF_WARMUP);
+
+    for(i = 0; i < PERF_RUNS; i++)
+    {
+        // The other thread has the higher priority, so it has read the item
+        // and blocked again by the time the send returns.
+        test_start = xthal_get_ccount();
+        xQueueSend(xWaitQueues[i % WAIT_NUM_QUEUES], &data, portMAX_DELAY);
+    }
+
+    while (!uiTaskResponse[1])
+    {
+        vTaskDelay(100);
+    }
+
+    snprintf(name, sizeof(name), "Queue set send to read (%d queues)", WAIT_NUM_QUEUES);
+    perf_report(name, &test_stats);
+
+    // A queue cannot be waited for while it is in a set, so remove them all
+    // before waiting on the same queues directly.
+    for (i = 0; i < WAIT_NUM_QUEUES; i++)
+    {
+        xQueueRemoveFromSet(xWaitQueues[i], xWaitSet);
+    }
+
+    uiTaskResponse[1] = 0;
+    task_create(waitobj_get, "waitobj_get", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[1], portPRIVILEGE_BIT | (PERF_TEST_PRIORITY + 1), &thandle);
+
+#if (configNUMBER_OF_CORES > 1)
+    {
+        int core = portGET_CORE_ID();
+        vTaskCoreAffinitySet(thandle, 1 << core);
+    }
+#endif
+
+    stats_reset(&test_stats, PERF_WARMUP);
+
+    for(i = 0; i < PERF_RUNS; i++)
+    {
+        test_start = xthal_get_ccount();
+        xQueueSend(xWaitQueues[i % WAIT_NUM_QUEUES], &data, portMAX_DELAY);
+    }
+
+    while (!uiTaskResponse[1])
+    {
+        vTaskDelay(100);
+    }
+
+    snprintf(name, sizeof(name), "Wait object send to read (%d queues)", WAIT_NUM_QUEUES);
+    perf_report(name, &test_stats);
+
+    portbenchmarkPrint();
+
+    for (i = 0; i < WAIT_NUM_QUEUES; i++)
+    {
+        vQueueDelete(xWaitQueues[i]);
+    }
+    vQueueDelete(xWaitSet);
+
+    *pResponse = 1;
+    vTaskDelete(NULL);
+}
+
+#endif // configUSE_WAIT_OBJECTS && configUSE_QUEUE_SETS
+
+
+#if defined(configUSE_NOTIFY_OBJECTS) && (configUSE_NOTIFY_OBJECTS == 1)
+
+#define NOTIFY_INDEX        0
+
+// Objects compared by the notification object test. Each notification object
+// is paired with the kernel object it replaces.
+enum {
+    NOTIFY_MODE_QUEUE,
+    NOTIFY_MODE_MAILBOX,
+    NOTIFY_MODE_SEMAPHORE,
+    NOTIFY_MODE_NOTIFY_SEM,
+    NOTIFY_MODE_EVENT,
+    NOTIFY_MODE_NOTIFY_FLAGS,
+    NOTIFY_MODE_COUNT
+};
+
+static const char * const notify_mode_names[NOTIFY_MODE_COUNT] = {
+    "Queue put (pointer)",
+    "Notify mailbox post",
+    "Semaphore put",
+    "Notify semaphore give",
+    "Event set",
+    "Notify event flags set",
+};
+
+static NotifyMailbox_t    xNotifyMailbox;
+static NotifySemaphore_t  xNotifySem;
+static NotifyEventFlags_t xNotifyFlags;
+static volatile uint32_t  notify_mode;
+static uint32_t           notify_msg;
+
+//-----------------------------------------------------------------------------
+// Helper thread for notification object tests. Blocks on the object selected
+// by notify_mode and measures the time from the put to this thread running.
+//-----------------------------------------------------------------------------
+void notify_get(void * arg)
+{
+    uint32_t delta;
+    uint32_t i;
+    void * pv;
+    volatile uint32_t* pResponse = (volatile uint32_t*)arg;
+
+    *pResponse = 0;
+    for(i = 0; i < PERF_RUNS; i++)
+    {
+        switch (notify_mode) {
+        case NOTIFY_MODE_QUEUE:
+            xQueueReceive(xQueue, &pv, portMAX_DELAY);
+            break;
+        case NOTIFY_MODE_MAILBOX:
+            xNotifyMailboxReceive(&xNotifyMailbox, &pv, portMAX_DELAY);
+            break;
+        case NOTIFY_MODE_SEMAPHORE:
+            xSemaphoreTake(xSemaphore, portMAX_DELAY);
+            break;
+        case NOTIFY_MODE_NOTIFY_SEM:
+            xNotifySemaphoreTake(&xNotifySem, portMAX_DELAY);
+            break;
+        case NOTIFY_MODE_EVENT:
+            xEventGroupWaitBits(xGroupEvents, 0x1, pdTRUE, pdFALSE, portMAX_DELAY);
+            break;
+        default:
+            ulNotifyEventFlagsWait(&xNotifyFlags, 0x1, pdTRUE, pdFALSE, portMAX_DELAY);
+            break;
+        }
+        delta = xthal_get_ccount() - test_start;
+        stats_update(&test_stats, delta);
+    }
+
+    *pResponse = 1;
+    vTaskDelete(NULL);
+}
+
+//-----------------------------------------------------------------------------
+// Put to the object selected by notify_mode.
+//-----------------------------------------------------------------------------
+static void notify_put(void)
+{
+    void * pv = &notify_msg;
+
+    switch (notify_mode) {
+    case NOTIFY_MODE_QUEUE:
+        xQueueSend(xQueue, &pv, portMAX_DELAY);
+        break;
+    case NOTIFY_MODE_MAILBOX:
+        xNotifyMailboxPost(&xNotifyMailbox, pv);
+        break;
+    case NOTIFY_MODE_SEMAPHORE:
+        xSemaphoreGive(xSemaphore);
+        break;
+    case NOTIFY_MODE_NOTIFY_SEM:
+        xNotifySemaphoreGive(&xNotifySem);
+        break;
+    case NOTIFY_MODE_EVENT:
+        xEventGroupSetBits(xGroupEvents, 0x1);
+        break;
+    default:
+        xNotifyEventFlagsSet(&xNotifyFlags, 0x1);
+        break;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Get from the object selected by notify_mode without blocking.
+//-----------------------------------------------------------------------------
+static void notify_get_nowait(void)
+{
+    void * pv;
+
+    switch (notify_mode) {
+    case NOTIFY_MODE_QUEUE:
+        xQueueReceive(xQueue, &pv, 0);
+        break;
+    case NOTIFY_MODE_MAILBOX:
+        xNotifyMailboxReceive(&xNotifyMailbox, &pv, 0);
+        break;
+    case NOTIFY_MODE_SEMAPHORE:
+        xSemaphoreTake(xSemaphore, 0);
+        break;
+    case NOTIFY_MODE_NOTIFY_SEM:
+        xNotifySemaphoreTake(&xNotifySem, 0);
+        break;
+    case NOTIFY_MODE_EVENT:
+        xEventGroupWaitBits(xGroupEvents, 0x1, pdTRUE, pdFALSE, 0);
+        break;
+    default:
+        ulNotifyEventFlagsWait(&xNotifyFlags, 0x1, pdTRUE, pdFALSE, 0);
+        break;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Point the notification objects at a new owner.
+//-----------------------------------------------------------------------------
+static void notify_init(TaskHandle_t owner)
+{
+    vNotifyMailboxInit(&xNotifyMailbox, owner, NOTIFY_INDEX);
+    vNotifySemaphoreInit(&xNotifySem, owner, NOTIFY_INDEX);
+    vNotifyEventFlagsInit(&xNotifyFlags, owner, NOTIFY_INDEX);
+}
+
+//-----------------------------------------------------------------------------
+// Notification object test. Measures the mailboxes, counting semaphores and
+// event flags from notify_objects.h side by side with the queue, semaphore
+// and event group operations they replace. First a put followed by a get in
+// the same thread, then a put that switches to a higher priority thread
+// blocked on the object.
+//-----------------------------------------------------------------------------
+void notify_test(void * arg)
+{
+    uint32_t start;
+    uint32_t delta;
+    uint32_t i;
+    char     name[48];
+
+    TaskHandle_t thandle;
+    volatile uint32_t* pResponse = (volatile uint32_t*)arg;
+
+    *pResponse = 0;
+
+    printf("\nNotification object timing test"
+           "\n-------------------------------\n");
+
+#if (configNUMBER_OF_CORES > 1)
+    // Prevent notify test from changing cores
+    vTaskCoreAffinitySet(NULL, 1 << portGET_CORE_ID());
+#endif
+
+    xQueue = xQueueCreate(1, sizeof(void *));
+    xSemaphore = xSemaphoreCreateCounting(PERF_RUNS, 0);
+    xGroupEvents = xEventGroupCreate();
+
+    portbenchmarkReset(); // If configBENCHMARK is enabled
+
+    // First, the objects are owned by this thread, so nothing ever blocks or
+    // gets woken up.
+    notify_init(xTaskGetCurrentTaskHandle());
+
+    for (notify_mode = 0; notify_mode < NOTIFY_MODE_COUNT; notify_mode++)
+    {
+        stats_reset(&aux_stats, PERF_WARMUP);
+        stats_reset(&test_stats, PERF_WARMUP);
+
+        for(i = 0; i < PERF_RUNS; i++)
+        {
+            start = xthal_get_ccount();
+            notify_put();
+            delta = xthal_get_ccount() - start;
+            stats_update(&aux_stats, delta);
+
+            start = xthal_get_ccount();
+            notify_get_nowait();
+            delta = xthal_get_ccount() - start;
+            stats_update(&test_stats, delta);
+        }
+
+        snprintf(name, sizeof(name), "%s no wake", notify_mode_names[notify_mode]);
+        perf_report(name, &aux_stats);
+        snprintf(name, sizeof(name), "%s then get", notify_mode_names[notify_mode]);
+        perf_report(name, &test_stats);
+    }
+
+    // Now measure the time taken to put + context switch when a higher
+    // priority thread is blocked on the object.
+    for (notify_mode = 0; notify_mode < NOTIFY_MODE_COUNT; notify_mode++)
+    {
+        uiTaskResponse[1] = 0;
+
+        // The helper runs as soon as it is created, so the objects must
+        // point at it before it gets the chance.
+        vTaskSuspendAll();
+        task_create(notify_get, "notify_get", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[1], portPRIVILEGE_BIT | (PERF_TEST_PRIORITY + 1), &thandle);
+        notify_init(thandle);
+        xTaskResumeAll();
+
+#if (configNUMBER_OF_CORES > 1)
+        // Require notify task and notify_get to run on the same core for profiling
+        vTaskCoreAffinitySet(thandle, 1 << portGET_CORE_ID());
+#endif
+
+        stats_reset(&test_stats, PERF_WARMUP);
+
+        for(i = 0; i < PERF_RUNS; i++)
+        {
+            // The other thread has the higher priority, so it has run and
+            // blocked again by the time the put returns.
+            test_start = xthal_get_ccount();
+            notify_put();
+        }
+
+        while (!uiTaskResponse[1])
+        {
+            vTaskDelay(100);
+        }
+
+        snprintf(name, sizeof(name), "%s with context switch", notify_mode_names[notify_mode]);
+        perf_report(name, &test_stats);
+    }
+
+    portbenchmarkPrint();
+
+    vQueueDelete(xQueue);
+    vSemaphoreDelete(xSemaphore);
+    vEventGroupDelete(xGroupEvents);
+
+    *pResponse = 1;
+    vTaskDelete(NULL);
+}
+
+#endif // configUSE_NOTIFY_OBJECTS
+
+
+//-----------------------------------------------------------------------------
+// Yield test - runs in main thread. Start 3 threads to measure the context
+// switch time. Wait for them all to exit. Then compute the average and worst
+// case switch times.
+//-----------------------------------------------------------------------------
+void yieldTest(void)
+{
+#define OVERHEAD_MEASUREMENT_RPT	10
+    uint32_t oh_cycles;
+    uint32_t i;
+
+    printf("\nYield timing test"
+           "\n-----------------\n");
+
+    // Measure the overhead of updating the cycle count
+
+    register uint32_t state0 = portENTER_CRITICAL_NESTED();
+
+    for (i = 0; i < OVERHEAD_MEASUREMENT_RPT; i++) {
+        // Copied from yield_func to calibrate timing
+        uint32_t state = portENTER_CRITICAL_NESTED();
+        clock_vals[indx++] = xthal_get_ccount();
+        portEXIT_CRITICAL_NESTED(state);
+    }
+
+    portEXIT_CRITICAL_NESTED(state0);
+
+    portbenchmarkReset(); // If configBENCHMARK is enabled
+
+    oh_cycles = (clock_vals[indx-1] - clock_vals[indx-OVERHEAD_MEASUREMENT_RPT]) / (OVERHEAD_MEASUREMENT_RPT -1);
+    indx = 0;
+
+    // Launch test threads
+    uiTaskResponse[0] = uiTaskResponse[1] = uiTaskResponse[2] = 0;
+    vTaskPrioritySet( NULL, PERF_TEST_PRIORITY + 2);
+    task_create( yield_func, "thd1", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[0], portPRIVILEGE_BIT | (PERF_TEST_PRIORITY +2), NULL );
+    task_create( yield_func, "thd2", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[1], portPRIVILEGE_BIT | (PERF_TEST_PRIORITY +2), NULL );
+    task_create( yield_func, "thd3", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[2], portPRIVILEGE_BIT | (PERF_TEST_PRIORITY +2), NULL );
+
+    vTaskPrioritySet( NULL, PERF_TEST_PRIORITY);
+    // Wait for them all to finish
+    while (3 > (uiTaskResponse[0] + uiTaskResponse[1] + uiTaskResponse[2]))
+    {
+        vTaskDelay(50);
+    }
+
+    // Compute statistics for solicited context switch. The edges are already
+    // thrown away below, so no further warm-up samples are skipped.
+    stats_reset(&test_stats, 0);
 
     // Throw first and last values containing delete tasks instructions (FreeRTOS) and such
     for (i = OVERHEAD_MEASUREMENT_RPT + 2; i < indx - 3; i++) {
@@ -875,23 +1773,24 @@ void yieldTest(void)
             continue;
         }
         uint32_t delta = clock_vals[i] - clock_vals[i-1] - oh_cycles;
-        stats_update(&solicited, (int)delta);
+        stats_update(&test_stats, delta);
     }
 
     if (printStats)
-        printf("Solicited context switch time : min %u avg %u max %u cycles [calibration %d]\n",
-                solicited.min,
-                (solicited.sum / solicited.cnt),
-                solicited.max,
-                oh_cycles);
+        printf("Counter read calibration             : %u cycles\n", oh_cycles);
+    perf_report("Solicited context switch time", &test_stats);
 
     portbenchmarkIntWait();
     portbenchmarkPrint();
 }
 
+#ifndef UNSOLICITED_ITER
+#define UNSOLICITED_ITER        16
+#endif
+
 volatile unsigned unsolicited_done = 0;
 volatile unsigned unsolicited_cycles = 0;
-stats_t unsolicited_stats;
+unsigned unsolicited_calib;
 
 #if (configNUMBER_OF_CORES > 1)
 // Wait to run unsolicited test until both tasks land on the same core
@@ -924,10 +1823,10 @@ void unsolicited_hipriority(void *arg)
         vTaskDelay(10);
     }
 #endif
-    for (i = 0; i < 16; i++) {
+    for (i = 0; i < UNSOLICITED_ITER; i++) {
         vTaskDelay(10); // Give time to background task
         unsigned cycles = xthal_get_ccount() - unsolicited_cycles;
-        stats_update(&unsolicited_stats, (int)cycles);
+        stats_update(&test_stats, cycles - unsolicited_calib);
     }
     unsolicited_done = 1;
     vTaskDelete(NULL);
@@ -944,7 +1843,13 @@ void unsolicitedTest(void)
     printf("\nUnsolicited context switch timing test"
            "\n--------------------------------------\n");
 
-    stats_reset(&unsolicited_stats);
+    // Calibrate read counter function (approximate calibration)
+    unsolicited_calib = xthal_get_ccount();
+    unsolicited_calib = xthal_get_ccount() - unsolicited_calib;
+
+    // Each sample takes 10 ticks, so there are few of them and none is
+    // thrown away.
+    stats_reset(&test_stats, 0);
 
     // Launch test threads
     vTaskPrioritySet( NULL, PERF_TEST_PRIORITY + 2);
@@ -969,17 +1874,9 @@ void unsolicitedTest(void)
         vTaskDelay(50);
     }
 
-    // Calibrate read counter function (approximate calibration)
-    unsigned calib = xthal_get_ccount();
-    calib = xthal_get_ccount() - calib;
-
     if (printStats)
-        printf("Unsolicited context switch time      : min %u avg %u max %u cycles [calibration %d]\n",
-                (unsigned)unsolicited_stats.min - calib,
-                (unsigned)(unsolicited_stats.sum + unsolicited_stats.cnt - 1) /
-    				(unsigned)unsolicited_stats.cnt - calib,
-                (unsigned)unsolicited_stats.max - calib,
-                calib);
+        printf("Counter read calibration             : %u cycles\n", unsolicited_calib);
+    perf_report("Unsolicited context switch time", &test_stats);
 
     portbenchmarkPrint();
 }
@@ -1013,6 +1910,21 @@ void mutexTest(void)
     vTaskPrioritySet( NULL, PERF_TEST_PRIORITY);
 }
 
+#if defined(configUSE_PRIORITY_CEILING_MUTEXES) && (configUSE_PRIORITY_CEILING_MUTEXES == 1)
+void ceilMutexTest(void)
+{
+    uiTaskResponse[0] = 0;
+    vTaskPrioritySet( NULL, PERF_TEST_PRIORITY + 1);
+    task_create( ceil_mutex_test, "ceil_mutex_test", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[0], portPRIVILEGE_BIT | PERF_TEST_PRIORITY, NULL );
+    vTaskPrioritySet( NULL, PERF_TEST_PRIORITY - 2);
+    while (!uiTaskResponse[0])
+    {
+        vTaskDelay(10);
+    }
+    vTaskPrioritySet( NULL, PERF_TEST_PRIORITY);
+}
+#endif
+
 void eventTest(void)
 {
     uiTaskResponse[0] = 0;
@@ -1039,8 +1951,81 @@ void queueTest(void)
     vTaskPrioritySet( NULL, PERF_TEST_PRIORITY);
 }
 
+void streamBufferTest(void)
+{
+    uiTaskResponse[0] = 0;
+    vTaskPrioritySet( NULL, PERF_TEST_PRIORITY + 1);
+    task_create( stream_test, "stream_test", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[0], portPRIVILEGE_BIT | PERF_TEST_PRIORITY, NULL );
+    vTaskPrioritySet( NULL, PERF_TEST_PRIORITY - 2);
+    while (!uiTaskResponse[0])
+    {
+        vTaskDelay(10);
+    }
+    vTaskPrioritySet( NULL, PERF_TEST_PRIORITY);
+}
+
+#if defined(configUSE_WAIT_OBJECTS) && (configUSE_WAIT_OBJECTS == 1) && (configUSE_QUEUE_SETS == 1)
+void waitObjectTest(void)
+{
+    uiTaskResponse[0] = 0;
+    vTaskPrioritySet( NULL, PERF_TEST_PRIORITY + 1);
+    task_create( waitobj_test, "waitobj_test", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[0], portPRIVILEGE_BIT | PERF_TEST_PRIORITY, NULL );
+    vTaskPrioritySet( NULL, PERF_TEST_PRIORITY - 2);
+    while (!uiTaskResponse[0])
+    {
+        vTaskDelay(10);
+    }
+    vTaskPrioritySet( NULL, PERF_TEST_PRIORITY);
+}
+#endif
+
+#if defined(configUSE_NOTIFY_OBJECTS) && (configUSE_NOTIFY_OBJECTS == 1)
+void notifyObjectTest(void)
+{
+    uiTaskResponse[0] = 0;
+    vTaskPrioritySet( NULL, PERF_TEST_PRIORITY + 1);
+    task_create( notify_test, "notify_test", configMINIMAL_STACK_SIZE, (void *)&uiTaskResponse[0], portPRIVILEGE_BIT | PERF_TEST_PRIORITY, NULL );
+    vTaskPrioritySet( NULL, PERF_TEST_PRIORITY - 2);
+    while (!uiTaskResponse[0])
+    {
+        vTaskDelay(10);
+    }
+    vTaskPrioritySet( NULL, PERF_TEST_PRIORITY);
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// Test case registry. The cases run in this order and their results are
+// tagged with the name given here.
+//-----------------------------------------------------------------------------
+typedef struct {
+    const char * name;
+    void (*run)(void);
+} perf_case_t;
+
+static const perf_case_t perf_cases[] = {
+    { "yield",       yieldTest },
+    { "unsolicited", unsolicitedTest },
+    { "sem",         semaphoreTest },
+    { "mutex",       mutexTest },
+#if defined(configUSE_PRIORITY_CEILING_MUTEXES) && (configUSE_PRIORITY_CEILING_MUTEXES == 1)
+    { "ceil_mutex",  ceilMutexTest },
+#endif
+    { "event",       eventTest },
+    { "msgq",        queueTest },
+    { "stream",      streamBufferTest },
+#if defined(configUSE_WAIT_OBJECTS) && (configUSE_WAIT_OBJECTS == 1) && (configUSE_QUEUE_SETS == 1)
+    { "waitobj",     waitObjectTest },
+#endif
+#if defined(configUSE_NOTIFY_OBJECTS) && (configUSE_NOTIFY_OBJECTS == 1)
+    { "notify",      notifyObjectTest },
+#endif
+};
+
 void test(void* pArg)
 {
+    uint32_t i;
+
     UNUSED(pArg);
     #if configBENCHMARK
     printStats = 0;
@@ -1048,21 +2033,26 @@ void test(void* pArg)
             "affected by the benchmarking code. TURN OFF configBENCHMARK to obtain context switch timing.\n");
     #endif
 
+    printf("\n%u iterations per result, %u warm-up iterations discarded\n",
+           (unsigned)TEST_ITER, (unsigned)PERF_WARMUP);
+#if (PERF_OUTPUT == PERF_OUTPUT_CSV)
+    printf("case,metric,n,min,avg,p50,p99,p999,max,stddev");
+    for (i = 0; i < PERF_HIST_BUCKETS; i++)
+        printf(",hist%u", (unsigned)i);
+    printf("\n");
+#endif
+
     /* Delays between tests are inserted to allow the idle task to run.
        The idle task frees up memory from deleted tasks and makes that
        memory available to the next test.
      */
-    yieldTest();
-    vTaskDelay(1);
-    unsolicitedTest();
-    vTaskDelay(1);
-    semaphoreTest();
-    vTaskDelay(1);
-    mutexTest();
-    vTaskDelay(1);
-    eventTest();
-    vTaskDelay(1);
-    queueTest();
+    for (i = 0; i < sizeof(perf_cases) / sizeof(perf_cases[0]); i++)
+    {
+        if (i)
+            vTaskDelay(1);
+        perf_case = perf_cases[i].name;
+        perf_cases[i].run();
+    }
     printf("\nTest PASSED\n");
     test_exit(0);
 }
@@ -23,11 +23,14 @@
 // FreeRTOS version of XTOS single-image multicore example mc_demo.c 
 // Demonstrates multiple cores working on shared data in parallel,
 // relying on hardware coherency to keep shared memory in sync.
+// The work is split across cores by the fork-join runtime in
+// xt_parallel.c, and the multiply is timed on 1, 2, ... N cores.
 
 
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <xtensa/hal.h>
 
@@ -35,9 +38,8 @@
 
 #include "FreeRTOS.h"
 #include "task.h"
-#include "queue.h"
-#include "semphr.h"
-#include "event_groups.h"
+
+#include "xt_parallel.h"
 
 
 #if !(defined configNUMBER_OF_CORES) || (configNUMBER_OF_CORES == 1)
@@ -50,38 +52,11 @@
 #if XCHAL_HAVE_PRID && XCHAL_HAVE_EXCLUSIVE && (XSHAL_RAM_SIZE > 0) && \
     XCHAL_DCACHE_IS_COHERENT && (XCHAL_L2CC_NUM_CORES > 1)
 
-// Set USE_MUTEX to zero to disable use of the FreeRTOS mutex.
-// The difference will be seen in the stdout output.
-#ifndef USE_MUTEX
-#define USE_MUTEX           1
-#endif
-
-#if USE_MUTEX
-SemaphoreHandle_t mtx0;
-#endif
-
-static void mlock(void)
-{
-#if USE_MUTEX
-    // Block for a short time since lock shouldn't be held for long
-    while (!xSemaphoreTake(mtx0, 2))
-        ;
-#endif
-}
-
-static void munlock(void)
-{
-#if USE_MUTEX
-    xSemaphoreGive(mtx0);
-#endif
-}
-
+// Print macro for convenience. Only the control task prints.
+#define PRINT(...)    { printf("core%d: ", portGET_CORE_ID()); printf(__VA_ARGS__); }
 
-// Print macro for convenience.
-#define PRINT(...)    { mlock(); printf("core%d: ", portGET_CORE_ID()); printf(__VA_ARGS__); munlock(); }
-#define PRINT_UNLOCKED(...)    { printf("core%d: ", portGET_CORE_ID()); printf(__VA_ARGS__); }
-
-// Task parameters
+// Task parameters. The workers run at the same priority as the control
+// task, which blocks while they work.
 #define TASK_PRIO           (20)
 #if (defined XT_CFLAGS_O0)
 #define TASK_STK_SIZE       ((XT_STACK_MIN_SIZE + 0x1800) / sizeof(StackType_t))
@@ -92,11 +67,10 @@ static void munlock(void)
 
 #define NUM_CORES           (configNUMBER_OF_CORES)
 
-// Barriers implemented using FreeRTOS EventGroup objects
-EventGroupHandle_t barrier;
-
-#define BARRIER_WAIT_ALL    ((1 << NUM_CORES) - 1)
-#define BARRIER_SET_CURR    (1 << portGET_CORE_ID())
+// Rows per chunk of the parallel multiply, 0 to let the runtime choose.
+#ifndef CHUNK_ROWS
+#define CHUNK_ROWS          0
+#endif
 
 
 // Try to keep the row size a multiple of the L1 cache line size.
@@ -140,15 +114,23 @@ generate_matrix(matrix * pmat, uint32_t size)
     }
 }
 
+//---------------------------------------------------------------------
+// Task group wrapper for generate_matrix().
+//---------------------------------------------------------------------
+static void
+generate_task(void *arg)
+{
+    generate_matrix((matrix *)arg, ROW_SIZE);
+}
+
 //---------------------------------------------------------------------
 // Check that the two matrices are identical in every element.
 //---------------------------------------------------------------------
 static bool
-check_matrix(const matrix * m1, const matrix * m2, uint32_t prid)
+check_matrix(const matrix * m1, const matrix * m2)
 {
     uint32_t i, j;
     uint32_t err = 0;
-    UNUSED(prid);
 
     for (i = 0; i < m1->size; i++) {
         for (j = 0; j < m1->size; j++) {
@@ -173,20 +155,17 @@ check_matrix(const matrix * m1, const matrix * m2, uint32_t prid)
 }
 
 //---------------------------------------------------------------------
-// Multiply two input matrices into the output matrix, either the full
-// matrix or a slice of it as specified by prid and nrows. Matrix size
-// must have been set beforehand. Output matrix must have been zeroed.
+// Multiply two input matrices into rows [rstart, rend) of the output
+// matrix. Matrix size must have been set beforehand. Output matrix
+// must have been zeroed.
 //---------------------------------------------------------------------
 __attribute__ ((noinline))
 static void
 mul_matrix(const matrix * m, const matrix * n, matrix * r,
-           uint32_t prid, uint32_t nrows)
+           uint32_t rstart, uint32_t rend)
 {
     uint32_t i, j, k;
 
-    uint32_t rstart = prid * nrows;
-    uint32_t rend   = rstart + nrows;
-
     for (i = rstart; i < rend; ++i) {
         for (j = 0; j < n->size; ++j) {
             for (k = 0; k < n->size; ++k) {
@@ -197,85 +176,95 @@ mul_matrix(const matrix * m, const matrix * n, matrix * r,
     }
 }
 
+//---------------------------------------------------------------------
+// Parallel loop body: multiply a chunk of rows into out2.
+//---------------------------------------------------------------------
+static void
+mul_rows(uint32_t start, uint32_t end, void *arg)
+{
+    UNUSED(arg);
+    mul_matrix(&in1, &in2, &out2, start, end);
+}
+
+//---------------------------------------------------------------------
+// Time one parallel multiply on the current number of cores. A first
+// untimed run warms the caches of all the cores taking part, so that
+// every core count is measured the same way.
+//---------------------------------------------------------------------
+static uint32_t
+run_parallel(void)
+{
+    uint32_t c1 = 0, c2 = 0;
+    int      i;
+
+    for (i = 0; i < 2; i++) {
+        memset(out2.elements, 0, sizeof(out2.elements));
+        c1 = xthal_get_cycle_count();
+        xt_parallel_for(0, ROW_SIZE, CHUNK_ROWS, mul_rows, NULL);
+        c2 = xthal_get_cycle_count();
+    }
+
+    return c2 - c1;
+}
+
 
 //---------------------------------------------------------------------
-// Task code that manages the matrix test itself.  The same task is
-// instantiated multiple times, with each instance pinned to run on
-// a different core.
+// Control task. Generates the inputs and a single-core reference
+// result, then runs the multiply on 1 .. N cores and reports the
+// speed-up over the 1 core run.
 //---------------------------------------------------------------------
 static void
 matrix_task(void *pdata)
 {
-    bool     ok;
-    int32_t  ret;
-    uint32_t c1, c2;
-    uint32_t c3, c4;
-    uint32_t prid = portGET_CORE_ID();
+    xt_task_group_t group;
+    bool     ok = true;
+    uint32_t c3 = 0, c4 = 0;
+    uint32_t t1 = 0;
+    uint32_t t, n, i;
     UNUSED(pdata);
 
-    if (prid == 0) {
-        PRINT("core 0 starting...\n");
-        // Generate the input matrices.
-        PRINT("Test matrix size is %u x %u\n", ROW_SIZE, COL_SIZE);
-        generate_matrix(&in1, ROW_SIZE);
-        generate_matrix(&in2, ROW_SIZE);
-        out1.size = ROW_SIZE;
-        out2.size = ROW_SIZE;
-
-        // Invalidate entire dcache. We want to measure cycles
-        // with both L1 and L2 cache empty.
-        xthal_dcache_all_writeback_inv();
-
-        // Generate the single-core result.
-        PRINT("Running mul_matrix() on core 0\n");
+    PRINT("Test matrix size is %u x %u\n", ROW_SIZE, COL_SIZE);
+
+    // Generate the input matrices in parallel as a task group.
+    xt_task_group_init(&group);
+    xt_task_group_run(&group, generate_task, &in1);
+    xt_task_group_run(&group, generate_task, &in2);
+    xt_task_group_wait(&group);
+    out1.size = ROW_SIZE;
+    out2.size = ROW_SIZE;
+
+    // Generate the single-core result, warm like the parallel runs.
+    PRINT("Running mul_matrix() on core %d\n", portGET_CORE_ID());
+    for (i = 0; i < 2; i++) {
+        memset(out1.elements, 0, sizeof(out1.elements));
         c3 = xthal_get_cycle_count();
         mul_matrix(&in1, &in2, &out1, 0, ROW_SIZE);
         c4 = xthal_get_cycle_count();
-        PRINT("mul_matrix() complete\n");
     }
+    PRINT("single-core time : %u cycles\n", c4 - c3);
 
-    // Ensure all cores measure cycles with L1 and L2 caches empty.
-    xthal_dcache_all_writeback_inv();
+    for (n = 1; n <= NUM_CORES; n++) {
+        xt_parallel_set_cores(n);
+        t = run_parallel();
+        if (n == 1) {
+            t1 = t;
+        }
 
-    // Wait for everyone to arrive at the barrier.
-    ret = xEventGroupSync( barrier, BARRIER_SET_CURR, BARRIER_WAIT_ALL, portMAX_DELAY );
-    if ((ret & BARRIER_WAIT_ALL) != BARRIER_WAIT_ALL) {
-        fprintf(stderr, "Barrier wait error\n");
-    }
+        PRINT("%u core(s) time : %u cycles, speed-up %u.%02u\n", n, t,
+              t1 / t, ((t1 % t) * 100) / t);
+        for (i = 0; i < n; i++) {
+            uint32_t chunks, stolen;
 
-    // The shared computation is done outside of an exclusion region,
-    // so that all cores run in parallel.
-    PRINT("Running mul_matrix() on core %d\n", prid);
-    c1 = xthal_get_cycle_count();
-    mul_matrix(&in1, &in2, &out2, prid, ROW_SIZE/NUM_CORES);
-    c2 = xthal_get_cycle_count();
-    PRINT("mul_matrix() complete\n");
-
-    // Sync here to make sure that all cores have finished their
-    // work before checking results.
-    xEventGroupSync( barrier, BARRIER_SET_CURR, BARRIER_WAIT_ALL, portMAX_DELAY );
-
-    PRINT("Running check_matrix() on core %d\n", prid);
-    ok = check_matrix(&out1, &out2, prid);
-
-    if (prid == 0) {
-        mlock();
-        PRINT_UNLOCKED("single-core time : %u cycles\n", c4 - c3);
-        PRINT_UNLOCKED("multi-core time  : %u cycles\n", c2 - c1);
-        munlock();
-    }
-    else {
-        PRINT("multi-core time  : %u cycles\n", c2 - c1);
-    }
+            xt_parallel_get_stats(i, &chunks, &stolen);
+            PRINT("    core %u ran %u chunks, %u stolen\n", i, chunks, stolen);
+        }
 
-    // Sync again at the exit barrier. This prevents one core from
-    // terminating the simulation and closing global file handles
-    // before the others are done using them.
-    xEventGroupSync( barrier, BARRIER_SET_CURR, BARRIER_WAIT_ALL, portMAX_DELAY );
-    if (prid == 0) {
-        PRINT(ok ? "PASS\n" : "FAIL\n");
+        if (!check_matrix(&out1, &out2)) {
+            ok = false;
+        }
     }
-    xEventGroupSync( barrier, BARRIER_SET_CURR, BARRIER_WAIT_ALL, portMAX_DELAY );
+
+    PRINT(ok ? "PASS\n" : "FAIL\n");
 
     test_exit(0);
 }
@@ -306,36 +295,25 @@ main()
     // The sim-mc LSP will set up all of sysram to be cached shared.
     // Nothing required here unless shared memory is to be arranged
     // in a different way.
-    int i;
+    TaskHandle_t handle;
+    int err;
 
-#if USE_MUTEX
-    // Init the mutex before calling PRINT()
-    mtx0 = xSemaphoreCreateMutex();
-    if (mtx0 == NULL) {
-        PRINT("Warning: mutex creation failed\n");
-    }
-#endif
     PRINT("core 0 starting...\n");
 
-    barrier = xEventGroupCreate();
-    if (!barrier) {
-        PRINT("ERROR: Event group / barrier creation FAILED\n");
+    if (xt_parallel_init(TASK_PRIO) != 0) {
+        PRINT("ERROR: parallel runtime init FAILED\n");
         return -1;
     }
 
-    for (i = 0; i < NUM_CORES; i++) {
-        TaskHandle_t handle;
-        int err = xTaskCreate(matrix_task,
-                              "matrix task",
-                              TASK_STK_SIZE,
-                              NULL,
-                              TASK_PRIO,
-                              &handle);
-        if (err != pdPASS) {
-            PRINT("FAILED to create matrix task %d\n", i);
-            return -1;
-        }
-        vTaskCoreAffinitySet(handle, 1 << i);   // pin to core i
+    err = xTaskCreate(matrix_task,
+                      "matrix task",
+                      TASK_STK_SIZE,
+                      NULL,
+                      TASK_PRIO,
+                      &handle);
+    if (err != pdPASS) {
+        PRINT("FAILED to create matrix task\n");
+        return -1;
     }
 
     // Start scheduler
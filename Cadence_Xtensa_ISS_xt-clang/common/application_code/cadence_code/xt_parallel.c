@@ -0,0 +1,360 @@
+/*******************************************************************************
+// Copyright (c) 2003-2025 Cadence Design Systems, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------
+*/
+
+/*
+ * Fork-join runtime for FreeRTOS SMP, see xt_parallel.h.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <xtensa/hal.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "xt_parallel.h"
+
+#if (configUSE_CORE_AFFINITY == 0)
+#error configUSE_CORE_AFFINITY required for the parallel runtime
+#endif
+
+
+#if (defined XT_CFLAGS_O0)
+#define WORKER_STK_SIZE         ((XT_STACK_MIN_SIZE + 0x1800) / sizeof(StackType_t))
+#else
+#define WORKER_STK_SIZE         ((XT_STACK_MIN_SIZE + 0x800) / sizeof(StackType_t))
+#endif
+
+/* Chunks per core when the caller lets the runtime choose the chunk size. */
+#define CHUNKS_PER_CORE         4
+
+/* A core's remaining chunks [lo, hi) are packed into one word so that they
+ * can be claimed with a single compare-and-set, which limits a loop to this
+ * many chunks.
+ */
+#define MAX_CHUNKS              0xFFFFU
+#define RANGE(lo, hi)           ((int)(((uint32_t)(hi) << 16) | (uint32_t)(lo)))
+#define RANGE_LO(r)             ((uint32_t)(r) & 0xFFFFU)
+#define RANGE_HI(r)             ((uint32_t)(r) >> 16)
+
+#if XCHAL_DCACHE_LINESIZE > 0
+#define PAR_LINE_SIZE           XCHAL_DCACHE_LINESIZE
+#else
+#define PAR_LINE_SIZE           4
+#endif
+
+
+/* Per-core state, one cache line each so that cores taking their own chunks
+ * do not contend with each other.
+ */
+typedef struct core_state {
+    volatile int  range;        // Remaining chunks, see RANGE()
+    uint32_t      chunks;       // Chunks run during the last loop
+    uint32_t      stolen;       // ... of which stolen from other cores
+    TaskHandle_t  worker;
+} __attribute__ ((aligned(PAR_LINE_SIZE))) core_state_t;
+
+/* The loop currently running. Only one runs at a time. */
+typedef struct job {
+    xt_par_body_t body;
+    void *        arg;
+    uint32_t      start;
+    uint32_t      end;
+    uint32_t      chunk;
+    uint32_t      ncores;       // Cores taking part
+    volatile int  active;       // Workers still running
+    TaskHandle_t  waiter;
+} job_t;
+
+static core_state_t      core_state[configNUMBER_OF_CORES];
+static job_t             job;
+static SemaphoreHandle_t job_mutex;
+static uint32_t          par_cores = configNUMBER_OF_CORES;
+
+
+//-----------------------------------------------------------------------------
+// Atomically replace *addr with newval if it still holds oldval.
+//-----------------------------------------------------------------------------
+static inline bool
+par_cas(volatile int *addr, int oldval, int newval)
+{
+    return xthal_compare_and_set((int *)addr, oldval, newval) == oldval;
+}
+
+
+//-----------------------------------------------------------------------------
+// Claim a chunk from a core's range: the owner takes from the bottom, and
+// other cores steal from the top, so they only meet on the last chunk.
+//-----------------------------------------------------------------------------
+static bool
+take_chunk(core_state_t *cs, bool own, uint32_t *chunk)
+{
+    int      r;
+    int      nr;
+    uint32_t lo;
+    uint32_t hi;
+
+    do {
+        r  = cs->range;
+        lo = RANGE_LO(r);
+        hi = RANGE_HI(r);
+        if (lo >= hi) {
+            return false;
+        }
+        if (own) {
+            *chunk = lo;
+            nr = RANGE(lo + 1, hi);
+        }
+        else {
+            *chunk = hi - 1;
+            nr = RANGE(lo, hi - 1);
+        }
+    } while (!par_cas(&cs->range, r, nr));
+
+    return true;
+}
+
+
+static void
+run_chunk(uint32_t chunk)
+{
+    uint32_t s = job.start + (chunk * job.chunk);
+    uint32_t e = s + job.chunk;
+
+    if ((e > job.end) || (e < s)) {
+        e = job.end;
+    }
+    job.body(s, e, job.arg);
+}
+
+
+//-----------------------------------------------------------------------------
+// Worker task, one pinned to each core. Blocks until given a loop, runs its
+// own chunks, then steals from the other cores until there are none left.
+// Ranges only shrink during a loop, so one pass over the other cores is
+// enough. The last worker to finish wakes the caller.
+//-----------------------------------------------------------------------------
+static void
+worker_task(void *pdata)
+{
+    uint32_t      core = (uint32_t)(uintptr_t)pdata;
+    core_state_t *cs   = &core_state[core];
+    uint32_t      chunk;
+    uint32_t      i;
+    int           a;
+
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while (take_chunk(cs, true, &chunk)) {
+            run_chunk(chunk);
+            cs->chunks++;
+        }
+
+        for (i = 1; i < job.ncores; i++) {
+            core_state_t *victim = &core_state[(core + i) % job.ncores];
+
+            while (take_chunk(victim, false, &chunk)) {
+                run_chunk(chunk);
+                cs->chunks++;
+                cs->stolen++;
+            }
+        }
+
+        do {
+            a = job.active;
+        } while (!par_cas(&job.active, a, a - 1));
+
+        if (a == 1) {
+            xTaskNotifyGive(job.waiter);
+        }
+    }
+}
+
+
+int32_t
+xt_parallel_init(UBaseType_t prio)
+{
+    uint32_t i;
+
+    job_mutex = xSemaphoreCreateMutex();
+    if (job_mutex == NULL) {
+        return -1;
+    }
+
+    for (i = 0; i < configNUMBER_OF_CORES; i++) {
+        BaseType_t err = xTaskCreate(worker_task,
+                                     "par_worker",
+                                     WORKER_STK_SIZE,
+                                     (void *)(uintptr_t)i,
+                                     prio,
+                                     &core_state[i].worker);
+        if (err != pdPASS) {
+            return -1;
+        }
+        vTaskCoreAffinitySet(core_state[i].worker, 1 << i);
+    }
+
+    return 0;
+}
+
+
+uint32_t
+xt_parallel_set_cores(uint32_t ncores)
+{
+    if (ncores < 1) {
+        ncores = 1;
+    }
+    if (ncores > configNUMBER_OF_CORES) {
+        ncores = configNUMBER_OF_CORES;
+    }
+
+    /* Don't change the core count under a running loop. */
+    xSemaphoreTake(job_mutex, portMAX_DELAY);
+    par_cores = ncores;
+    xSemaphoreGive(job_mutex);
+
+    return ncores;
+}
+
+
+int32_t
+xt_parallel_for(uint32_t start, uint32_t end, uint32_t chunk,
+                xt_par_body_t body, void *arg)
+{
+    uint32_t n;
+    uint32_t nchunks;
+    uint32_t i;
+
+    if ((job_mutex == NULL) || (body == NULL)) {
+        return -1;
+    }
+    if (end <= start) {
+        return 0;
+    }
+
+    xSemaphoreTake(job_mutex, portMAX_DELAY);
+
+    n = end - start;
+    if (chunk == 0) {
+        chunk = n / (par_cores * CHUNKS_PER_CORE);
+        if (chunk == 0) {
+            chunk = 1;
+        }
+    }
+    nchunks = (n / chunk) + ((n % chunk) ? 1 : 0);
+    while (nchunks > MAX_CHUNKS) {
+        chunk  *= 2;
+        nchunks = (n / chunk) + ((n % chunk) ? 1 : 0);
+    }
+
+    job.body   = body;
+    job.arg    = arg;
+    job.start  = start;
+    job.end    = end;
+    job.chunk  = chunk;
+    job.ncores = par_cores;
+    job.active = (int)par_cores;
+    job.waiter = xTaskGetCurrentTaskHandle();
+
+    for (i = 0; i < job.ncores; i++) {
+        configASSERT(core_state[i].worker != job.waiter);
+        core_state[i].range  = RANGE((nchunks * i) / job.ncores, (nchunks * (i + 1)) / job.ncores);
+        core_state[i].chunks = 0;
+        core_state[i].stolen = 0;
+    }
+    for (; i < configNUMBER_OF_CORES; i++) {
+        core_state[i].range  = RANGE(0, 0);
+        core_state[i].chunks = 0;
+        core_state[i].stolen = 0;
+    }
+
+    /* The notifications order the writes above before the workers run. */
+    for (i = 0; i < job.ncores; i++) {
+        xTaskNotifyGive(core_state[i].worker);
+    }
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    xSemaphoreGive(job_mutex);
+    return 0;
+}
+
+
+void
+xt_task_group_init(xt_task_group_t * group)
+{
+    group->count = 0;
+}
+
+
+int32_t
+xt_task_group_run(xt_task_group_t * group, xt_par_task_t func, void *arg)
+{
+    if ((func == NULL) || (group->count >= XT_TASK_GROUP_MAX)) {
+        return -1;
+    }
+    group->func[group->count] = func;
+    group->arg[group->count]  = arg;
+    group->count++;
+    return 0;
+}
+
+
+static void
+group_body(uint32_t start, uint32_t end, void *arg)
+{
+    xt_task_group_t *group = (xt_task_group_t *)arg;
+    uint32_t         i;
+
+    for (i = start; i < end; i++) {
+        group->func[i](group->arg[i]);
+    }
+}
+
+
+int32_t
+xt_task_group_wait(xt_task_group_t * group)
+{
+    /* Each task is a chunk of its own, so idle cores steal them. */
+    int32_t ret = xt_parallel_for(0, group->count, 1, group_body, group);
+
+    group->count = 0;
+    return ret;
+}
+
+
+void
+xt_parallel_get_stats(uint32_t core, uint32_t *chunks, uint32_t *stolen)
+{
+    if (core < configNUMBER_OF_CORES) {
+        *chunks = core_state[core].chunks;
+        *stolen = core_state[core].stolen;
+    }
+    else {
+        *chunks = 0;
+        *stolen = 0;
+    }
+}
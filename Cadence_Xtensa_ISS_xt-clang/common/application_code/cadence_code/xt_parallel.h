@@ -0,0 +1,107 @@
+/*******************************************************************************
+// Copyright (c) 2003-2025 Cadence Design Systems, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+--------------------------------------------------------------------------------
+*/
+
+/*
+ * Small fork-join runtime for FreeRTOS SMP.
+ *
+ * One worker task is pinned to each core. A parallel loop splits its index
+ * range into chunks and gives each taking part core a contiguous run of them.
+ * A worker runs its own chunks from the bottom of its run, then steals from
+ * the top of the other cores' runs, so a core that is slow or busy with a
+ * higher priority task does not hold up the loop. The caller blocks until
+ * every chunk is done; workers with nothing to do stay blocked.
+ *
+ * Loops and task groups must not be started from inside a loop body or a
+ * group task. The calling task's notification value is used to wait for the
+ * workers.
+ */
+
+#ifndef XT_PARALLEL_H
+#define XT_PARALLEL_H
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+#if ( configNUMBER_OF_CORES <= 1 )
+#error The parallel runtime requires > 1 core
+#endif
+
+
+/* Maximum number of tasks in a task group. */
+#ifndef XT_TASK_GROUP_MAX
+#define XT_TASK_GROUP_MAX       16
+#endif
+
+
+/* Loop body, called for each chunk with indices [start, end). */
+typedef void (*xt_par_body_t)(uint32_t start, uint32_t end, void *arg);
+
+/* Task group task. */
+typedef void (*xt_par_task_t)(void *arg);
+
+/* Task group. Tasks added with xt_task_group_run() are started by
+ * xt_task_group_wait(), which returns when they have all completed.
+ */
+typedef struct xt_task_group {
+    uint32_t      count;
+    xt_par_task_t func[XT_TASK_GROUP_MAX];
+    void *        arg[XT_TASK_GROUP_MAX];
+} xt_task_group_t;
+
+
+/*
+ * Create the worker tasks, one pinned to each core, at the given priority.
+ * May be called before the scheduler is started. Returns 0 on success.
+ */
+int32_t xt_parallel_init(UBaseType_t prio);
+
+/*
+ * Limit loops to cores 0 .. ncores - 1, e.g. to measure speed-up. The default
+ * is all cores. Returns the number of cores that will be used.
+ */
+uint32_t xt_parallel_set_cores(uint32_t ncores);
+
+/*
+ * Call body for every index in [start, end), chunk indices at a time. If chunk
+ * is 0 a size giving a few chunks per core is chosen. Returns when all chunks
+ * have completed; returns 0 on success.
+ */
+int32_t xt_parallel_for(uint32_t start, uint32_t end, uint32_t chunk,
+                        xt_par_body_t body, void *arg);
+
+/*
+ * Task groups.
+ */
+void    xt_task_group_init(xt_task_group_t * group);
+int32_t xt_task_group_run(xt_task_group_t * group, xt_par_task_t func, void *arg);
+int32_t xt_task_group_wait(xt_task_group_t * group);
+
+/*
+ * Number of chunks run by a core during the last loop, and how many of those
+ * it stole from other cores.
+ */
+void    xt_parallel_get_stats(uint32_t core, uint32_t *chunks, uint32_t *stolen);
+
+#endif /* XT_PARALLEL_H */
@@ -49,6 +49,8 @@
 #include "queue.h"
 #include "semphr.h"
 
+#include "SMPLatency.h"
+
 #if ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 0 )
 #error configUSE_CORE_AFFINITY required for this test in SMP mode
 #endif
@@ -62,6 +64,19 @@
 #define TEST_TASK_LOOPS         100
 #define TEST_TASK_SLEEPS        10
 
+/* Context switch throughput test: tasks per core, yields per task, and a
+ * priority below the control task so that it can poll without interfering.
+ */
+#define SWITCH_TASKS_PER_CORE   2
+#define SWITCH_TASK_LOOPS       5000
+#define SWITCH_TASK_PRIO        ((20 - 1) | portPRIVILEGE_BIT)
+
+/* Latency test: the benchmark tasks run below the control task, which only
+ * wakes up to check on their progress.
+ */
+#define LATENCY_TASK_PRIO       ((20 - 1) | portPRIVILEGE_BIT)
+#define LATENCY_CHECK_TICKS     pdMS_TO_TICKS(1000)
+
 
 /* Some basic task synchronization that relies on coherent shared memory */
 volatile uint32_t task_done[configNUMBER_OF_CORES];
@@ -69,6 +84,11 @@ volatile uint32_t task_done[configNUMBER_OF_CORES];
 /* Global structures used for SMP tests */
 static SemaphoreHandle_t xSemA, xSemB;
 
+/* Context switch test control */
+static volatile uint32_t switch_go;
+static volatile uint32_t switch_done[configNUMBER_OF_CORES * SWITCH_TASKS_PER_CORE];
+static volatile uint32_t switch_stolen[configNUMBER_OF_CORES * SWITCH_TASKS_PER_CORE];
+
 
 /* Initialize task control flags */
 static void task_ctrl_init(void)
@@ -223,6 +243,128 @@ done:
 }
 
 
+/* Task that yields to its sibling on the same core as fast as it can.
+ * The task is pinned, so it must never be observed running on another core.
+ */
+static void Switch_Task(void *pdata)
+{
+    int id   = (int)pdata;
+    int core = id / SWITCH_TASKS_PER_CORE;
+    int i;
+
+    while (switch_go == 0) {
+        taskYIELD();
+    }
+
+    for (i = 0; i < SWITCH_TASK_LOOPS; i++) {
+        if (portGET_CORE_ID() != core) {
+            switch_stolen[id]++;
+        }
+        taskYIELD();
+    }
+
+    switch_done[id] = 1;
+    vTaskDelete(NULL);
+}
+
+/* Run the yield workload on the first "ncores" cores and return the
+ * number of context switches per second, or 0 on failure.
+ */
+static uint32_t run_switch_pass(int ncores)
+{
+    TaskHandle_t task;
+    TickType_t start_ticks, total_ticks;
+    uint32_t stolen = 0;
+    int ntasks = ncores * SWITCH_TASKS_PER_CORE;
+    int err, i;
+
+    switch_go = 0;
+    for (i = 0; i < ntasks; i++) {
+        switch_done[i] = 0;
+        switch_stolen[i] = 0;
+        err = xTaskCreateAffinitySet(Switch_Task,
+                                     "Switch_Task",
+                                     INIT_TASK_STK_SIZE,
+                                     (void *)i,
+                                     SWITCH_TASK_PRIO,
+                                     1 << (i / SWITCH_TASKS_PER_CORE),
+                                     &task);
+        if (err != pdPASS) {
+            xt_printf(" FAILED to create Switch_Task %d\n", i);
+            return 0;
+        }
+    }
+
+    /* Line up on a tick boundary, then release all tasks together */
+    start_ticks = xTaskGetTickCount();
+    while (xTaskGetTickCount() == start_ticks) {
+    }
+    start_ticks = xTaskGetTickCount();
+    switch_go = 1;
+
+    for (i = 0; i < ntasks; i++) {
+        while (switch_done[i] == 0) {
+            vTaskDelay(1);
+        }
+    }
+    total_ticks = xTaskGetTickCount() - start_ticks;
+    if (total_ticks == 0) {
+        total_ticks = 1;
+    }
+
+    for (i = 0; i < ntasks; i++) {
+        stolen += switch_stolen[i];
+    }
+    if (stolen != 0) {
+        xt_printf(" pinned tasks ran on the wrong core %d times\n", (int)stolen);
+        return 0;
+    }
+
+    /* Let the idle tasks reclaim the deleted tasks before the next pass */
+    vTaskDelay(10);
+
+    return (uint32_t)(((uint64_t)ntasks * SWITCH_TASK_LOOPS * configTICK_RATE_HZ) / total_ticks);
+}
+
+
+// SMP Context Switch Throughput Test
+// ----------------------------------
+// Pin SWITCH_TASKS_PER_CORE tasks to each of the first N cores and have
+// them yield to each other, for N = 1 .. configNUMBER_OF_CORES.  Cores
+// schedule independently, so the aggregate context switch rate should
+// scale with the number of cores; contention on shared scheduler state
+// shows up directly as lost scaling.  Pinned tasks are also checked to
+// never run on any core other than the one they were assigned to.
+//
+static int run_switch_test(void)
+{
+    uint32_t rate[configNUMBER_OF_CORES];
+    int n;
+
+    xt_printf("\nSMP Switch test started on core %d\n", portGET_CORE_ID());
+
+    for (n = 1; n <= configNUMBER_OF_CORES; n++) {
+        rate[n - 1] = run_switch_pass(n);
+        if (rate[n - 1] == 0) {
+            goto done;
+        }
+        xt_printf("%d core(s): %d switches/sec (%d%% of linear)\n", n,
+                  (int)rate[n - 1],
+                  (int)(((uint64_t)rate[n - 1] * 100) / ((uint64_t)rate[0] * n)));
+    }
+
+    /* As with the task test, only check that adding cores helped at all */
+    if ((configNUMBER_OF_CORES == 1) || (rate[configNUMBER_OF_CORES - 1] > rate[0])) {
+        xt_printf("SMP Switch test succeeded\n");
+        return 0;
+    }
+
+done:
+    xt_printf("SMP Switch test FAILED\n");
+    return 1;
+}
+
+
 /* Task to decrement and increment semaphores.  Will move between cores. */
 static void Sem_Task(void *pdata)
 {
@@ -307,13 +449,45 @@ static int run_sem_test(void)
 }
 
 
+// SMP Latency Test
+// ----------------
+// Runs the cross-core latency benchmark from the common demo files, which
+// measures semaphore, queue, task notification, stream buffer, cache line
+// and raw IPI round trips between each pair of cores and prints p50, p99
+// and max for each.  The test fails if any handoff times out or the
+// benchmark stops making progress.
+//
+static int run_latency_test(void)
+{
+    xt_printf("\nSMP Latency test started on core %d\n", portGET_CORE_ID());
+
+    vStartSMPLatencyTasks(LATENCY_TASK_PRIO);
+
+    while (xIsSMPLatencyTestComplete() == pdFALSE) {
+        vTaskDelay(LATENCY_CHECK_TICKS);
+        if (xAreSMPLatencyTasksStillRunning() != pdPASS) {
+            break;
+        }
+    }
+
+    if ((xIsSMPLatencyTestComplete() != pdFALSE) && (xAreSMPLatencyTasksStillRunning() == pdPASS)) {
+        xt_printf("SMP Latency test succeeded\n");
+        return 0;
+    }
+    xt_printf("SMP Latency test FAILED\n");
+    return 1;
+}
+
+
 static void Core_Task(void *pdata)
 {
     int status;
     UNUSED(pdata);
 
     status = run_task_test();
+    status |= run_switch_test();
     status |= run_sem_test();
+    status |= run_latency_test();
 
     /* Somewhat arbitrary check to confirm multi-core time is faster than single-core */
     if (status == 0) {
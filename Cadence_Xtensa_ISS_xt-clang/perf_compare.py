@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2003-2025 Cadence Design Systems, Inc.
+#
+# Permission is hereby granted, free of charge, to any person obtaining
+# a copy of this software and associated documentation files (the
+# "Software"), to deal in the Software without restriction, including
+# without limitation the rights to use, copy, modify, merge, publish,
+# distribute, sublicense, and/or sell copies of the Software, and to
+# permit persons to whom the Software is furnished to do so, subject to
+# the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+# MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+# IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+# CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+# TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+# SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+
+# perf_compare.py -- compare perf_test results against a stored baseline.
+#
+# Build perf_test with -DPERF_OUTPUT=1 (JSON) or -DPERF_OUTPUT=2 (CSV) and
+# save the console output. The results are picked out of the rest of the
+# output, so a complete log can be given for both the baseline and the new
+# run:
+#
+#     xt-run build/perf_test.exe > baseline.log
+#     ...
+#     xt-run build/perf_test.exe > new.log
+#     ./perf_compare.py baseline.log new.log
+#
+# A result regresses when one of the compared statistics grows by more than
+# the threshold percentage and by more than the minimum number of cycles.
+# The exit status is 1 if anything regressed, or if a baseline result is
+# missing from the new run.
+
+import argparse
+import csv
+import json
+import sys
+
+STATS = ("min", "avg", "p50", "p99", "p999", "max", "stddev")
+
+
+def load(path):
+    """Return {(case, metric): {stat: value}} for the results in a log."""
+    results = {}
+    header = None
+
+    with open(path, newline="") as f:
+        for line in f:
+            line = line.strip()
+            if line.startswith("{") and '"metric"' in line:
+                try:
+                    r = json.loads(line)
+                except ValueError:
+                    continue
+                results[(r["case"], r["metric"])] = r
+            elif line.startswith("case,metric,"):
+                header = line.split(",")
+            elif header and line.count(",") >= len(header) - 1:
+                row = next(csv.reader([line]))
+                if len(row) != len(header):
+                    continue
+                r = dict(zip(header, row))
+                try:
+                    for s in STATS + ("n",):
+                        r[s] = int(r[s])
+                except (KeyError, ValueError):
+                    continue
+                results[(r["case"], r["metric"])] = r
+
+    return results
+
+
+def main():
+    ap = argparse.ArgumentParser(
+        description="Compare perf_test results against a stored baseline.")
+    ap.add_argument("baseline", help="console log of the baseline run")
+    ap.add_argument("new", help="console log of the run to check")
+    ap.add_argument("-s", "--stats", default="p50,p99",
+                    help="comma separated statistics to compare "
+                         "(default p50,p99; choose from %s)" % ",".join(STATS))
+    ap.add_argument("-t", "--threshold", type=float, default=5.0,
+                    help="allowed growth in percent (default 5)")
+    ap.add_argument("-m", "--min-cycles", type=int, default=10,
+                    help="ignore changes of up to this many cycles (default 10)")
+    args = ap.parse_args()
+
+    stats = args.stats.split(",")
+    for s in stats:
+        if s not in STATS:
+            ap.error("unknown statistic '%s'" % s)
+
+    base = load(args.baseline)
+    new = load(args.new)
+    if not base:
+        sys.exit("%s: no results found" % args.baseline)
+
+    failed = 0
+    for key in sorted(base):
+        if key not in new:
+            print("MISSING    %-12s %s" % key)
+            failed += 1
+            continue
+
+        for s in stats:
+            b = base[key][s]
+            n = new[key][s]
+            diff = n - b
+            pct = 100.0 * diff / b if b else 0.0
+            if diff > args.min_cycles and (b == 0 or pct > args.threshold):
+                tag = "REGRESSED"
+                failed += 1
+            elif -diff > args.min_cycles and (b == 0 or -pct > args.threshold):
+                tag = "improved"
+            else:
+                continue
+            print("%-10s %-12s %-44s %-6s %8d -> %8d (%+.1f%%)"
+                  % (tag, key[0], key[1], s, b, n, pct))
+
+    for key in sorted(set(new) - set(base)):
+        print("new        %-12s %s" % key)
+
+    print("%d results compared, %d regressions" % (len(base), failed))
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -83,6 +83,19 @@
  * Period used in timer tests.
  */
 #define testrunnerTIMER_TEST_PERIOD				( 50 )
+
+/**
+ * Set configSTRESS_TEST_THROUGHPUT to 1 to have the check task print the
+ * operations per second achieved by the tests that keep throughput counters,
+ * and flag any that drop well below their running average.
+ */
+#ifndef configSTRESS_TEST_THROUGHPUT
+	#define configSTRESS_TEST_THROUGHPUT		0
+#endif
+
+#if( configSTRESS_TEST_THROUGHPUT == 1 )
+	#include "ThroughputMonitor.h"
+#endif
 /*-----------------------------------------------------------*/
 
 /**
@@ -96,6 +109,13 @@ static char *pcStatusMessage = "No errors";
  * still executing and error free.
  */
 static void prvCheckTask( void *pvParameters );
+
+#if( configSTRESS_TEST_THROUGHPUT == 1 )
+	/**
+	 * Registers the throughput counters of the tests that are enabled.
+	 */
+	static void prvRegisterThroughputCounters( void );
+#endif
 /*-----------------------------------------------------------*/
 
 void vStartTests( void )
@@ -269,6 +289,12 @@ void vStartTests( void )
 			vCreateSuicidalTasks( testrunnerCREATOR_TASK_PRIORITY );
 		}
 		#endif /* configSTART_DELETE_SELF_TESTS */
+
+		#if( configSTRESS_TEST_THROUGHPUT == 1 )
+		{
+			prvRegisterThroughputCounters();
+		}
+		#endif /* configSTRESS_TEST_THROUGHPUT */
 	}
 
 	vTaskStartScheduler();
@@ -358,6 +384,13 @@ uint32_t xTestMask = 0;
 	/* Initialise xNextWakeTime - this only needs to be done once. */
 	xNextWakeTime = xTaskGetTickCount();
 
+	#if( configSTRESS_TEST_THROUGHPUT == 1 )
+	{
+		/* Start the first throughput measurement period. */
+		( void ) uxThroughputMonitorUpdate();
+	}
+	#endif /* configSTRESS_TEST_THROUGHPUT */
+
 	for( ;; )
 	{
 		/* Place this task in the blocked state until it is time to run again. */
@@ -614,9 +647,68 @@ uint32_t xTestMask = 0;
 		#endif /* configSTART_DELETE_SELF_TESTS */
 
 		configPRINTF( ( "%s (test mask 0x%08x)\r\n", pcStatusMessage, xTestMask ) );
+
+		#if( configSTRESS_TEST_THROUGHPUT == 1 )
+		{
+			/* A drop is reported but is not an error, as a test can be slowed
+			 * down legitimately by the other tests running alongside it. */
+			configPRINTF( ( "Throughput, %u counter(s) dropped:\r\n", ( unsigned ) uxThroughputMonitorUpdate() ) );
+			vThroughputMonitorPrint();
+		}
+		#endif /* configSTRESS_TEST_THROUGHPUT */
 #if (defined configSTRESS_TEST_CONTINUOUS) && !configSTRESS_TEST_CONTINUOUS
 		exit(strcmp(pcStatusMessage, "No errors"));
 #endif
 	}
 }
 /*-----------------------------------------------------------*/
+
+#if( configSTRESS_TEST_THROUGHPUT == 1 )
+
+	static void prvRegisterThroughputCounters( void )
+	{
+		#if( configSTART_TASK_NOTIFY_TESTS == 1 )
+		{
+			xThroughputMonitorAdd( "TaskNotify", "cycles", ulGetTaskNotifyCycles );
+		}
+		#endif /* configSTART_TASK_NOTIFY_TESTS */
+
+		#if( configSTART_BLOCKING_QUEUE_TESTS == 1 )
+		{
+			xThroughputMonitorAdd( "BlockQueue", "items", ulGetBlockingQueueItemsReceived );
+		}
+		#endif /* configSTART_BLOCKING_QUEUE_TESTS */
+
+		#if( configSTART_SEMAPHORE_TESTS == 1 )
+		{
+			xThroughputMonitorAdd( "SemTest", "takes", ulGetSemaphoreTakes );
+		}
+		#endif /* configSTART_SEMAPHORE_TESTS */
+
+		#if( configSTART_POLLED_QUEUE_TESTS == 1 )
+		{
+			xThroughputMonitorAdd( "PollQueue", "items", ulGetPollingQueueItemsReceived );
+		}
+		#endif /* configSTART_POLLED_QUEUE_TESTS */
+
+		#if( configSTART_RECURSIVE_MUTEX_TESTS == 1 )
+		{
+			xThroughputMonitorAdd( "RecMutex", "rounds", ulGetRecursiveMutexRounds );
+		}
+		#endif /* configSTART_RECURSIVE_MUTEX_TESTS */
+
+		#if( configSTART_MESSAGE_BUFFER_TESTS == 1 )
+		{
+			xThroughputMonitorAdd( "MessageBuffer", "bytes", ulGetMessageBufferBytesReceived );
+		}
+		#endif /* configSTART_MESSAGE_BUFFER_TESTS */
+
+		#if( configSTART_STREAM_BUFFER_TESTS == 1 )
+		{
+			xThroughputMonitorAdd( "StreamBuffer", "bytes", ulGetStreamBufferBytesReceived );
+		}
+		#endif /* configSTART_STREAM_BUFFER_TESTS */
+	}
+
+#endif /* configSTRESS_TEST_THROUGHPUT */
+/*-----------------------------------------------------------*/
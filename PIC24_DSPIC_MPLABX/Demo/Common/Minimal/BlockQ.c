@@ -25,7 +25,7 @@
  */
 
 /*
- * Creates six tasks that operate on three queues as follows:
+ * Creates eight tasks that operate on four queues as follows:
  *
  * The first two tasks send and receive an incrementing number to/from a queue.
  * One task acts as a producer and the other as the consumer.  The consumer is a
@@ -46,6 +46,12 @@
  * executing when either the queue becomes full (causing the producer to block) or
  * a context switch occurs (tasks of the same priority will time slice).
  *
+ * The final two tasks pass the same incrementing number, but a batch at a time
+ * using xQueueSendMultiple() and xQueueReceiveMultiple().  The batch size does
+ * not divide the queue length, so batches regularly wrap around the end of the
+ * queue storage area.  The consumer has the higher priority and checks the
+ * numbers arrive in exactly the same order as they do when sent one at a time.
+ *
  */
 
 #include <stdlib.h>
@@ -57,9 +63,11 @@
 
 /* Demo program include files. */
 #include "BlockQ.h"
+#include "ThroughputMonitor.h"
 
 #define blckqSTACK_SIZE       configMINIMAL_STACK_SIZE
-#define blckqNUM_TASK_SETS    ( 3 )
+#define blckqNUM_TASK_SETS    ( 4 )
+#define blckqBATCH_SIZE       ( 3 )
 
 #if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
     #error This example cannot be used if dynamic allocation is not allowed.
@@ -71,6 +79,7 @@ typedef struct BLOCKING_QUEUE_PARAMETERS
     QueueHandle_t xQueue;             /*< The queue to be used by the task. */
     TickType_t xBlockTime;            /*< The block time to use on queue reads/writes. */
     volatile short * psCheckVariable; /*< Incremented on each successful cycle to check the task is still running. */
+    volatile uint32_t * pulItemCount; /*< Consumers only - incremented for each item removed from the queue. */
 } xBlockingQueueParameters;
 
 /* Task function that creates an incrementing number and posts it on a queue. */
@@ -80,14 +89,23 @@ static portTASK_FUNCTION_PROTO( vBlockingQueueProducer, pvParameters );
  * it is the expected number. */
 static portTASK_FUNCTION_PROTO( vBlockingQueueConsumer, pvParameters );
 
+/* As vBlockingQueueProducer() and vBlockingQueueConsumer(), but moving
+ * blckqBATCH_SIZE numbers at a time. */
+static portTASK_FUNCTION_PROTO( vBlockingQueueMultipleProducer, pvParameters );
+static portTASK_FUNCTION_PROTO( vBlockingQueueMultipleConsumer, pvParameters );
+
 /* Variables which are incremented each time an item is removed from a queue, and
  * found to be the expected value.
  * These are used to check that the tasks are still running. */
-static volatile short sBlockingConsumerCount[ blckqNUM_TASK_SETS ] = { ( uint16_t ) 0, ( uint16_t ) 0, ( uint16_t ) 0 };
+static volatile short sBlockingConsumerCount[ blckqNUM_TASK_SETS ] = { ( uint16_t ) 0, ( uint16_t ) 0, ( uint16_t ) 0, ( uint16_t ) 0 };
 
 /* Variable which are incremented each time an item is posted on a queue.   These
  * are used to check that the tasks are still running. */
-static volatile short sBlockingProducerCount[ blckqNUM_TASK_SETS ] = { ( uint16_t ) 0, ( uint16_t ) 0, ( uint16_t ) 0 };
+static volatile short sBlockingProducerCount[ blckqNUM_TASK_SETS ] = { ( uint16_t ) 0, ( uint16_t ) 0, ( uint16_t ) 0, ( uint16_t ) 0 };
+
+/* The number of items removed from each queue, for throughput reporting.  The
+ * 16 bit check variables above wrap too quickly to be used for that. */
+static volatile uint32_t ulBlockingItemsReceived[ blckqNUM_TASK_SETS ] = { 0 };
 
 /*-----------------------------------------------------------*/
 
@@ -96,6 +114,7 @@ void vStartBlockingQueueTasks( UBaseType_t uxPriority )
     xBlockingQueueParameters * pxQueueParameters1, * pxQueueParameters2;
     xBlockingQueueParameters * pxQueueParameters3, * pxQueueParameters4;
     xBlockingQueueParameters * pxQueueParameters5, * pxQueueParameters6;
+    xBlockingQueueParameters * pxQueueParameters7, * pxQueueParameters8;
     const UBaseType_t uxQueueSize1 = 1, uxQueueSize5 = 5;
     const TickType_t xBlockTime = pdMS_TO_TICKS( ( TickType_t ) 1000 );
     const TickType_t xDontBlock = ( TickType_t ) 0;
@@ -115,6 +134,7 @@ void vStartBlockingQueueTasks( UBaseType_t uxPriority )
     /* Pass in the variable that this task is going to increment so we can check it
      * is still running. */
     pxQueueParameters1->psCheckVariable = &( sBlockingConsumerCount[ 0 ] );
+    pxQueueParameters1->pulItemCount = &( ulBlockingItemsReceived[ 0 ] );
 
     /* Create the structure used to pass parameters to the producer task. */
     pxQueueParameters2 = ( xBlockingQueueParameters * ) pvPortMalloc( sizeof( xBlockingQueueParameters ) );
@@ -129,6 +149,7 @@ void vStartBlockingQueueTasks( UBaseType_t uxPriority )
     /* Pass in the variable that this task is going to increment so we can check
      * it is still running. */
     pxQueueParameters2->psCheckVariable = &( sBlockingProducerCount[ 0 ] );
+    pxQueueParameters2->pulItemCount = NULL;
 
 
     /* Note the producer has a lower priority than the consumer when the tasks are
@@ -145,11 +166,13 @@ void vStartBlockingQueueTasks( UBaseType_t uxPriority )
     pxQueueParameters3->xQueue = xQueueCreate( uxQueueSize1, ( UBaseType_t ) sizeof( uint16_t ) );
     pxQueueParameters3->xBlockTime = xDontBlock;
     pxQueueParameters3->psCheckVariable = &( sBlockingProducerCount[ 1 ] );
+    pxQueueParameters3->pulItemCount = &( ulBlockingItemsReceived[ 1 ] );
 
     pxQueueParameters4 = ( xBlockingQueueParameters * ) pvPortMalloc( sizeof( xBlockingQueueParameters ) );
     pxQueueParameters4->xQueue = pxQueueParameters3->xQueue;
     pxQueueParameters4->xBlockTime = xBlockTime;
     pxQueueParameters4->psCheckVariable = &( sBlockingConsumerCount[ 1 ] );
+    pxQueueParameters4->pulItemCount = NULL;
 
     xTaskCreate( vBlockingQueueConsumer, "QConsB3", blckqSTACK_SIZE, ( void * ) pxQueueParameters3, tskIDLE_PRIORITY, NULL );
     xTaskCreate( vBlockingQueueProducer, "QProdB4", blckqSTACK_SIZE, ( void * ) pxQueueParameters4, uxPriority, NULL );
@@ -162,14 +185,34 @@ void vStartBlockingQueueTasks( UBaseType_t uxPriority )
     pxQueueParameters5->xQueue = xQueueCreate( uxQueueSize5, ( UBaseType_t ) sizeof( uint16_t ) );
     pxQueueParameters5->xBlockTime = xBlockTime;
     pxQueueParameters5->psCheckVariable = &( sBlockingProducerCount[ 2 ] );
+    pxQueueParameters5->pulItemCount = NULL;
 
     pxQueueParameters6 = ( xBlockingQueueParameters * ) pvPortMalloc( sizeof( xBlockingQueueParameters ) );
     pxQueueParameters6->xQueue = pxQueueParameters5->xQueue;
     pxQueueParameters6->xBlockTime = xBlockTime;
     pxQueueParameters6->psCheckVariable = &( sBlockingConsumerCount[ 2 ] );
+    pxQueueParameters6->pulItemCount = &( ulBlockingItemsReceived[ 2 ] );
 
     xTaskCreate( vBlockingQueueProducer, "QProdB5", blckqSTACK_SIZE, ( void * ) pxQueueParameters5, tskIDLE_PRIORITY, NULL );
     xTaskCreate( vBlockingQueueConsumer, "QConsB6", blckqSTACK_SIZE, ( void * ) pxQueueParameters6, tskIDLE_PRIORITY, NULL );
+
+
+
+    /* Create the batch tasks as described at the top of the file. */
+    pxQueueParameters7 = ( xBlockingQueueParameters * ) pvPortMalloc( sizeof( xBlockingQueueParameters ) );
+    pxQueueParameters7->xQueue = xQueueCreate( uxQueueSize5, ( UBaseType_t ) sizeof( uint16_t ) );
+    pxQueueParameters7->xBlockTime = xBlockTime;
+    pxQueueParameters7->psCheckVariable = &( sBlockingProducerCount[ 3 ] );
+    pxQueueParameters7->pulItemCount = NULL;
+
+    pxQueueParameters8 = ( xBlockingQueueParameters * ) pvPortMalloc( sizeof( xBlockingQueueParameters ) );
+    pxQueueParameters8->xQueue = pxQueueParameters7->xQueue;
+    pxQueueParameters8->xBlockTime = xBlockTime;
+    pxQueueParameters8->psCheckVariable = &( sBlockingConsumerCount[ 3 ] );
+    pxQueueParameters8->pulItemCount = &( ulBlockingItemsReceived[ 3 ] );
+
+    xTaskCreate( vBlockingQueueMultipleProducer, "QProdB7", blckqSTACK_SIZE, ( void * ) pxQueueParameters7, tskIDLE_PRIORITY, NULL );
+    xTaskCreate( vBlockingQueueMultipleConsumer, "QConsB8", blckqSTACK_SIZE, ( void * ) pxQueueParameters8, uxPriority, NULL );
 }
 /*-----------------------------------------------------------*/
 
@@ -220,6 +263,8 @@ static portTASK_FUNCTION( vBlockingQueueConsumer, pvParameters )
     {
         if( xQueueReceive( pxQueueParameters->xQueue, &usData, pxQueueParameters->xBlockTime ) == pdPASS )
         {
+            tputCOUNTER_ADD( *pxQueueParameters->pulItemCount, 1 );
+
             if( usData != usExpectedValue )
             {
                 /* Catch-up. */
@@ -254,11 +299,106 @@ static portTASK_FUNCTION( vBlockingQueueConsumer, pvParameters )
 }
 /*-----------------------------------------------------------*/
 
+static portTASK_FUNCTION( vBlockingQueueMultipleProducer, pvParameters )
+{
+    uint16_t usValues[ blckqBATCH_SIZE ], usValue = 0;
+    xBlockingQueueParameters * pxQueueParameters;
+    short sErrorEverOccurred = pdFALSE;
+    BaseType_t xIndex, xPosted, xSent;
+
+    pxQueueParameters = ( xBlockingQueueParameters * ) pvParameters;
+
+    for( ; ; )
+    {
+        for( xIndex = 0; xIndex < blckqBATCH_SIZE; xIndex++ )
+        {
+            usValues[ xIndex ] = usValue;
+            ++usValue;
+        }
+
+        /* Fewer items than requested are posted if the queue does not have
+         * room for the whole batch, so keep going until all are sent. */
+        xSent = 0;
+
+        while( xSent < blckqBATCH_SIZE )
+        {
+            xPosted = xQueueSendMultiple( pxQueueParameters->xQueue, ( void * ) &( usValues[ xSent ] ), ( UBaseType_t ) ( blckqBATCH_SIZE - xSent ), pxQueueParameters->xBlockTime );
+
+            if( xPosted == 0 )
+            {
+                sErrorEverOccurred = pdTRUE;
+            }
+
+            xSent += xPosted;
+        }
+
+        /* We have successfully posted a batch, so increment the variable used
+         * to check we are still running. */
+        if( sErrorEverOccurred == pdFALSE )
+        {
+            ( *pxQueueParameters->psCheckVariable )++;
+        }
+
+        #if configUSE_PREEMPTION == 0
+            taskYIELD();
+        #endif
+    }
+}
+/*-----------------------------------------------------------*/
+
+static portTASK_FUNCTION( vBlockingQueueMultipleConsumer, pvParameters )
+{
+    uint16_t usData[ blckqBATCH_SIZE ], usExpectedValue = 0;
+    xBlockingQueueParameters * pxQueueParameters;
+    short sErrorEverOccurred = pdFALSE;
+    BaseType_t xIndex, xReceived;
+
+    pxQueueParameters = ( xBlockingQueueParameters * ) pvParameters;
+
+    for( ; ; )
+    {
+        xReceived = xQueueReceiveMultiple( pxQueueParameters->xQueue, ( void * ) usData, blckqBATCH_SIZE, pxQueueParameters->xBlockTime );
+
+        if( xReceived > blckqBATCH_SIZE )
+        {
+            sErrorEverOccurred = pdTRUE;
+            xReceived = 0;
+        }
+
+        tputCOUNTER_ADD( *pxQueueParameters->pulItemCount, xReceived );
+
+        for( xIndex = 0; xIndex < xReceived; xIndex++ )
+        {
+            if( usData[ xIndex ] != usExpectedValue )
+            {
+                /* Catch-up. */
+                usExpectedValue = usData[ xIndex ];
+
+                sErrorEverOccurred = pdTRUE;
+            }
+
+            ++usExpectedValue;
+        }
+
+        if( ( xReceived > 0 ) && ( sErrorEverOccurred == pdFALSE ) )
+        {
+            /* We have successfully received some items, so increment the
+             * variable used to check we are still running. */
+            ( *pxQueueParameters->psCheckVariable )++;
+        }
+
+        #if configUSE_PREEMPTION == 0
+            taskYIELD();
+        #endif
+    }
+}
+/*-----------------------------------------------------------*/
+
 /* This is called to check that all the created tasks are still running. */
 BaseType_t xAreBlockingQueuesStillRunning( void )
 {
-    static short sLastBlockingConsumerCount[ blckqNUM_TASK_SETS ] = { ( uint16_t ) 0, ( uint16_t ) 0, ( uint16_t ) 0 };
-    static short sLastBlockingProducerCount[ blckqNUM_TASK_SETS ] = { ( uint16_t ) 0, ( uint16_t ) 0, ( uint16_t ) 0 };
+    static short sLastBlockingConsumerCount[ blckqNUM_TASK_SETS ] = { ( uint16_t ) 0, ( uint16_t ) 0, ( uint16_t ) 0, ( uint16_t ) 0 };
+    static short sLastBlockingProducerCount[ blckqNUM_TASK_SETS ] = { ( uint16_t ) 0, ( uint16_t ) 0, ( uint16_t ) 0, ( uint16_t ) 0 };
     BaseType_t xReturn = pdPASS, xTasks;
 
     /* Not too worried about mutual exclusion on these variables as they are 16
@@ -287,3 +427,23 @@ BaseType_t xAreBlockingQueuesStillRunning( void )
 
     return xReturn;
 }
+/*-----------------------------------------------------------*/
+
+uint32_t ulGetBlockingQueueItemsReceived( void )
+{
+    uint32_t ulTotal = 0;
+    BaseType_t x;
+
+    /* A 32-bit read is not atomic on 16-bit ports. */
+    taskENTER_CRITICAL();
+    {
+        for( x = 0; x < blckqNUM_TASK_SETS; x++ )
+        {
+            ulTotal += ulBlockingItemsReceived[ x ];
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return ulTotal;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,324 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Demonstrates and tests priority ceiling mutexes.  A controlling task at the
+ * lowest priority takes two mutexes with different ceilings and checks its
+ * priority is raised to the ceiling of each in turn, and lowered again as each
+ * mutex is given back - in the order taken, and out of order, with either
+ * mutex taken first.  A third mutex shares the higher ceiling, to check the
+ * task stays at that ceiling until both mutexes with it are given back.  While holding the mutex with the higher ceiling it
+ * unblocks a peer task that also uses that mutex, and checks the peer does not
+ * run until the mutex is given back, and that the peer then obtains the mutex
+ * without blocking.  Finally it raises its own priority above a ceiling and
+ * takes that mutex, to check the violation is reported through
+ * vApplicationMutexCeilingViolationHook().
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* Demo program include files. */
+#include "CeilingMutex.h"
+
+/* Exclude the entire file if configUSE_PRIORITY_CEILING_MUTEXES is 0. */
+#if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+
+    #if ( configUSE_MUTEX_CEILING_VIOLATION_HOOK != 1 )
+        #error configUSE_MUTEX_CEILING_VIOLATION_HOOK must be 1 for this demo, and the hook must call vCeilingMutexViolationDetected().
+    #endif
+
+/* The priorities used by this file.  The ceiling of the mutex shared with the
+ * peer task is above the peer's priority, so time slicing between tasks of the
+ * ceiling priority cannot let the peer run while the mutex is held. */
+    #define ceilCONTROL_TASK_PRIORITY    ( tskIDLE_PRIORITY + 1 )
+    #define ceilPEER_TASK_PRIORITY       ( tskIDLE_PRIORITY + 2 )
+    #define ceilLOW_CEILING              ( tskIDLE_PRIORITY + 2 )
+    #define ceilHIGH_CEILING             ( tskIDLE_PRIORITY + 3 )
+
+/* The time the controlling task waits between each cycle of the test. */
+    #define ceilCYCLE_DELAY              pdMS_TO_TICKS( ( TickType_t ) 10 )
+
+/* The size of the stack used by the tasks in this file. */
+    #define ceilTASK_STACK_SIZE          ( configMINIMAL_STACK_SIZE * 2 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task that takes and gives the mutexes and checks its own priority.
+ */
+    static void prvCeilingControlTask( void * pvParameters );
+
+/*
+ * The task that is unblocked while the controlling task holds the mutex with
+ * the high ceiling, and then takes that mutex itself.
+ */
+    static void prvCeilingPeerTask( void * pvParameters );
+
+/*
+ * Sets xErrorOccurred if the priority of the calling task is not
+ * uxExpectedPriority.
+ */
+    static void prvCheckPriority( UBaseType_t uxExpectedPriority );
+
+/*-----------------------------------------------------------*/
+
+/* The mutexes used by the tasks in this file. */
+    static SemaphoreHandle_t xLowCeilingMutex = NULL, xHighCeilingMutex = NULL, xSecondHighCeilingMutex = NULL;
+
+/* The handle of the peer task, which the controlling task notifies. */
+    static TaskHandle_t xPeerTask = NULL;
+
+/* Incremented by the peer task each time it obtains the mutex. */
+    static volatile uint32_t ulPeerCycles = 0;
+
+/* The number of violations reported, and the number the controlling task
+ * expects - violations it did not cause itself are errors. */
+    static volatile uint32_t ulViolationsReported = 0, ulViolationsExpected = 0;
+
+/* Used so a check task can ensure this test is still executing, and not
+ * stalled. */
+    static volatile UBaseType_t uxCycleCounter = 0;
+
+/* A variable that gets set to pdTRUE if an error is detected. */
+    static volatile BaseType_t xErrorOccurred = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+    void vStartCeilingMutexTasks( void )
+    {
+        xLowCeilingMutex = xSemaphoreCreateMutexWithCeiling( ceilLOW_CEILING );
+        xHighCeilingMutex = xSemaphoreCreateMutexWithCeiling( ceilHIGH_CEILING );
+        xSecondHighCeilingMutex = xSemaphoreCreateMutexWithCeiling( ceilHIGH_CEILING );
+
+        configASSERT( xLowCeilingMutex );
+        configASSERT( xHighCeilingMutex );
+        configASSERT( xSecondHighCeilingMutex );
+
+        xTaskCreate( prvCeilingPeerTask, "CeilPeer", ceilTASK_STACK_SIZE, NULL, ceilPEER_TASK_PRIORITY, &xPeerTask );
+        xTaskCreate( prvCeilingControlTask, "CeilCtrl", ceilTASK_STACK_SIZE, NULL, ceilCONTROL_TASK_PRIORITY, NULL );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCheckPriority( UBaseType_t uxExpectedPriority )
+    {
+        if( uxTaskPriorityGet( NULL ) != uxExpectedPriority )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCeilingControlTask( void * pvParameters )
+    {
+        uint32_t ulPeerCyclesBefore;
+
+        /* Avoid compiler warnings. */
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            /* Nested, given back in the opposite order to that taken.  Each
+             * give must return the task to the priority it had before the
+             * matching take. */
+            if( xSemaphoreTake( xLowCeilingMutex, 0 ) != pdPASS )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            prvCheckPriority( ceilLOW_CEILING );
+
+            if( xSemaphoreTake( xHighCeilingMutex, 0 ) != pdPASS )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            prvCheckPriority( ceilHIGH_CEILING );
+
+            /* The peer task has a higher priority than this task's base
+             * priority, but a lower priority than the ceiling, so must not run
+             * while the mutex is held. */
+            ulPeerCyclesBefore = ulPeerCycles;
+            xTaskNotifyGive( xPeerTask );
+
+            if( ulPeerCycles != ulPeerCyclesBefore )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            ( void ) xSemaphoreGive( xHighCeilingMutex );
+
+            /* This task is still at the low ceiling, which is the priority of
+             * the peer task, so the peer runs either when the give lowers this
+             * task's priority or when this task yields - and must then obtain
+             * the mutex without blocking. */
+            prvCheckPriority( ceilLOW_CEILING );
+            taskYIELD();
+
+            if( ulPeerCycles != ( ulPeerCyclesBefore + 1UL ) )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            ( void ) xSemaphoreGive( xLowCeilingMutex );
+            prvCheckPriority( ceilCONTROL_TASK_PRIORITY );
+
+            /* Nested, but given back in the order taken.  The priority must
+             * not fall while the mutex with the higher ceiling is still held. */
+            ( void ) xSemaphoreTake( xLowCeilingMutex, 0 );
+            ( void ) xSemaphoreTake( xHighCeilingMutex, 0 );
+            ( void ) xSemaphoreGive( xLowCeilingMutex );
+            prvCheckPriority( ceilHIGH_CEILING );
+            ( void ) xSemaphoreGive( xHighCeilingMutex );
+            prvCheckPriority( ceilCONTROL_TASK_PRIORITY );
+
+            /* Nested with the higher ceiling taken first.  Taking the mutex
+             * with the lower ceiling while running at the higher ceiling is not
+             * a violation, as only the base priority of the task counts.  Given
+             * back in the opposite order to that taken. */
+            ( void ) xSemaphoreTake( xHighCeilingMutex, 0 );
+            prvCheckPriority( ceilHIGH_CEILING );
+            ( void ) xSemaphoreTake( xLowCeilingMutex, 0 );
+            prvCheckPriority( ceilHIGH_CEILING );
+            ( void ) xSemaphoreGive( xLowCeilingMutex );
+            prvCheckPriority( ceilHIGH_CEILING );
+            ( void ) xSemaphoreGive( xHighCeilingMutex );
+            prvCheckPriority( ceilCONTROL_TASK_PRIORITY );
+
+            /* As above, but given back in the order taken.  Giving back the
+             * mutex with the higher ceiling must leave the task at the ceiling
+             * of the mutex it still holds, not at its base priority. */
+            ( void ) xSemaphoreTake( xHighCeilingMutex, 0 );
+            ( void ) xSemaphoreTake( xLowCeilingMutex, 0 );
+            ( void ) xSemaphoreGive( xHighCeilingMutex );
+            prvCheckPriority( ceilLOW_CEILING );
+            ( void ) xSemaphoreGive( xLowCeilingMutex );
+            prvCheckPriority( ceilCONTROL_TASK_PRIORITY );
+
+            /* Two mutexes with the same ceiling.  Giving one back must leave
+             * the task at that ceiling while the other is still held, and only
+             * giving back the second lets it fall to the lower ceiling. */
+            ( void ) xSemaphoreTake( xHighCeilingMutex, 0 );
+            ( void ) xSemaphoreTake( xSecondHighCeilingMutex, 0 );
+            ( void ) xSemaphoreTake( xLowCeilingMutex, 0 );
+            ( void ) xSemaphoreGive( xHighCeilingMutex );
+            prvCheckPriority( ceilHIGH_CEILING );
+            ( void ) xSemaphoreGive( xSecondHighCeilingMutex );
+            prvCheckPriority( ceilLOW_CEILING );
+            ( void ) xSemaphoreGive( xLowCeilingMutex );
+            prvCheckPriority( ceilCONTROL_TASK_PRIORITY );
+
+            /* A task with a priority above the ceiling taking the mutex breaks
+             * the protocol, so must be reported. */
+            vTaskPrioritySet( NULL, ceilHIGH_CEILING );
+            ulViolationsExpected++;
+
+            if( xSemaphoreTake( xLowCeilingMutex, 0 ) != pdPASS )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            prvCheckPriority( ceilHIGH_CEILING );
+            ( void ) xSemaphoreGive( xLowCeilingMutex );
+            prvCheckPriority( ceilHIGH_CEILING );
+            vTaskPrioritySet( NULL, ceilCONTROL_TASK_PRIORITY );
+
+            if( ulViolationsReported != ulViolationsExpected )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            uxCycleCounter++;
+            vTaskDelay( ceilCYCLE_DELAY );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCeilingPeerTask( void * pvParameters )
+    {
+        /* Avoid compiler warnings. */
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+            /* The controlling task cannot be holding the mutex when this task
+             * runs, so it must be available without blocking. */
+            if( xSemaphoreTake( xHighCeilingMutex, 0 ) != pdPASS )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+            else
+            {
+                ulPeerCycles++;
+                ( void ) xSemaphoreGive( xHighCeilingMutex );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vCeilingMutexViolationDetected( QueueHandle_t xMutex,
+                                         TaskHandle_t xTask )
+    {
+        ( void ) xMutex;
+        ( void ) xTask;
+
+        ulViolationsReported++;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xAreCeilingMutexTasksStillRunning( void )
+    {
+        static UBaseType_t uxLastCycleCounter = 0;
+        BaseType_t xReturn;
+
+        if( uxCycleCounter == uxLastCycleCounter )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+        else
+        {
+            uxLastCycleCounter = uxCycleCounter;
+        }
+
+        if( xErrorOccurred != pdFALSE )
+        {
+            xReturn = pdFAIL;
+        }
+        else
+        {
+            xReturn = pdPASS;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/* Exclude the entire file if configUSE_PRIORITY_CEILING_MUTEXES is 0. */
+#endif /* configUSE_PRIORITY_CEILING_MUTEXES == 1 */
@@ -28,7 +28,8 @@
 /*
  * Tests the extra queue functionality introduced in FreeRTOS.org V4.5.0 -
  * including xQueueSendToFront(), xQueueSendToBack(), xQueuePeek() and
- * mutex behaviour.
+ * mutex behaviour - along with xQueueSendMultiple() and
+ * xQueueReceiveMultiple().
  *
  * See the comments above the prvSendFrontAndBackTest() and
  * prvLowPriorityMutexTask() prototypes below for more information.
@@ -72,6 +73,14 @@
  */
 static void prvSendFrontAndBackTest( void * pvParameters );
 
+/*
+ * Tests xQueueSendMultiple() and xQueueReceiveMultiple() are equivalent to
+ * sending and receiving the same items one at a time, including when the
+ * items wrap around the end of the queue storage area.  Called from
+ * prvSendFrontAndBackTest() on the same (empty) queue.
+ */
+static void prvSendReceiveMultipleTest( QueueHandle_t xQueue );
+
 /*
  * The following three tasks are used to demonstrate the mutex behaviour.
  * Each task is given a different priority to demonstrate the priority
@@ -427,6 +436,8 @@ static void prvSendFrontAndBackTest( void * pvParameters )
             xErrorDetected = pdTRUE;
         }
 
+        prvSendReceiveMultipleTest( xQueue );
+
         /* Increment the loop counter to indicate these tasks are still
          * executing. */
         ulLoopCounter++;
@@ -434,6 +445,136 @@ static void prvSendFrontAndBackTest( void * pvParameters )
 }
 /*-----------------------------------------------------------*/
 
+static void prvSendReceiveMultipleTest( QueueHandle_t xQueue )
+{
+    uint32_t ulData, ulValues[ genqQUEUE_LENGTH + 2 ], ulReceived[ genqQUEUE_LENGTH ];
+    UBaseType_t uxOffset, uxIndex, uxNext;
+    BaseType_t xReturned;
+
+    /* Move the queue's read and write positions on by a different amount each
+     * time round so the multiple item copies are tested both with and without
+     * wrapping around the end of the queue storage area. */
+    for( uxOffset = 0; uxOffset < genqQUEUE_LENGTH; uxOffset++ )
+    {
+        for( uxIndex = 0; uxIndex < uxOffset; uxIndex++ )
+        {
+            ulData = ( uint32_t ) uxIndex;
+            xQueueSendToBack( xQueue, ( void * ) &ulData, intsemNO_BLOCK );
+            xQueueReceive( xQueue, ( void * ) &ulData, intsemNO_BLOCK );
+        }
+
+        if( uxQueueMessagesWaiting( xQueue ) != 0 )
+        {
+            xErrorDetected = pdTRUE;
+        }
+
+        for( uxIndex = 0; uxIndex < ( genqQUEUE_LENGTH + 2 ); uxIndex++ )
+        {
+            ulValues[ uxIndex ] = ulLoopCounter + ( uint32_t ) uxIndex;
+        }
+
+        /* Only genqQUEUE_LENGTH of the items will fit. */
+        xReturned = xQueueSendMultiple( xQueue, ( void * ) ulValues, genqQUEUE_LENGTH + 2, intsemNO_BLOCK );
+
+        if( xReturned != genqQUEUE_LENGTH )
+        {
+            xErrorDetected = pdTRUE;
+        }
+
+        if( uxQueueMessagesWaiting( xQueue ) != genqQUEUE_LENGTH )
+        {
+            xErrorDetected = pdTRUE;
+        }
+
+        /* The queue is full so nothing more can be sent. */
+        if( xQueueSendMultiple( xQueue, ( void * ) ulValues, 1, intsemNO_BLOCK ) != 0 )
+        {
+            xErrorDetected = pdTRUE;
+        }
+
+        /* Items posted together must come out one at a time in the same order
+         * as if they had been posted one at a time... */
+        for( uxIndex = 0; uxIndex < 2; uxIndex++ )
+        {
+            if( xQueueReceive( xQueue, ( void * ) &ulData, intsemNO_BLOCK ) != pdPASS )
+            {
+                xErrorDetected = pdTRUE;
+            }
+
+            if( ulData != ulValues[ uxIndex ] )
+            {
+                xErrorDetected = pdTRUE;
+            }
+        }
+
+        /* ...and together.  Asking for more items than are available returns
+         * the items that are available. */
+        xReturned = xQueueReceiveMultiple( xQueue, ( void * ) ulReceived, genqQUEUE_LENGTH, intsemNO_BLOCK );
+
+        if( xReturned != ( genqQUEUE_LENGTH - 2 ) )
+        {
+            xErrorDetected = pdTRUE;
+        }
+
+        for( uxIndex = 0; uxIndex < ( genqQUEUE_LENGTH - 2 ); uxIndex++ )
+        {
+            if( ulReceived[ uxIndex ] != ulValues[ uxIndex + 2 ] )
+            {
+                xErrorDetected = pdTRUE;
+            }
+        }
+
+        if( uxQueueMessagesWaiting( xQueue ) != 0 )
+        {
+            xErrorDetected = pdTRUE;
+        }
+
+        /* Items posted one at a time must come out in the same order when they
+         * are received a few at a time. */
+        for( uxIndex = 0; uxIndex < genqQUEUE_LENGTH; uxIndex++ )
+        {
+            if( xQueueSendToBack( xQueue, ( void * ) &( ulValues[ uxIndex ] ), intsemNO_BLOCK ) != pdPASS )
+            {
+                xErrorDetected = pdTRUE;
+            }
+        }
+
+        uxNext = 0;
+
+        while( uxNext < genqQUEUE_LENGTH )
+        {
+            xReturned = xQueueReceiveMultiple( xQueue, ( void * ) ulReceived, 2, intsemNO_BLOCK );
+
+            if( ( xReturned <= 0 ) || ( xReturned > 2 ) )
+            {
+                xErrorDetected = pdTRUE;
+                break;
+            }
+
+            for( uxIndex = 0; uxIndex < ( UBaseType_t ) xReturned; uxIndex++ )
+            {
+                if( ulReceived[ uxIndex ] != ulValues[ uxNext ] )
+                {
+                    xErrorDetected = pdTRUE;
+                }
+
+                uxNext++;
+            }
+        }
+
+        /* The queue is empty so nothing more can be received. */
+        if( xQueueReceiveMultiple( xQueue, ( void * ) ulReceived, genqQUEUE_LENGTH, intsemNO_BLOCK ) != 0 )
+        {
+            xErrorDetected = pdTRUE;
+        }
+
+        #if configUSE_PREEMPTION == 0
+            taskYIELD();
+        #endif
+    }
+}
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_xTaskAbortDelay == 1 )
 
     static void prvHighPriorityTimeout( SemaphoreHandle_t xMutex )
@@ -37,6 +37,12 @@
  * The tests also ensure that a low priority task is never able to successfully
  * read from or write to a queue when a task of higher priority is attempting
  * the same operation.
+ *
+ * If configUSE_WORK_QUEUES is 1 each interrupt also submits a work item to a
+ * work queue that runs above the priority of the test tasks, so the work
+ * items are run while the queues are under test.  The time each work item
+ * waits to run after being submitted can be obtained from
+ * vGetIntQueueWorkQueueStats().
  */
 
 /* Standard includes. */
@@ -46,6 +52,7 @@
 #include "FreeRTOS.h"
 #include "queue.h"
 #include "task.h"
+#include "work_queue.h"
 
 /* Demo app includes. */
 #include "IntQueue.h"
@@ -91,6 +98,11 @@
  * from each queue by each task, otherwise an error is detected. */
 #define intqMIN_ACCEPTABLE_TASK_COUNT    ( 5 )
 
+/* The priority of the work queue used when configUSE_WORK_QUEUES is 1, and the
+ * number of work items submitted to it - one per interrupt. */
+#define intqWORK_QUEUE_PRIORITY          ( intqHIGHER_PRIORITY + 1 )
+#define intqNUM_WORK_ITEMS               ( 2 )
+
 /* Send the next value to the queue that is normally empty.  This is called
  * from within the interrupts. */
 #define timerNORMALLY_EMPTY_TX()                                                                                                          \
@@ -195,6 +207,24 @@ static void prvRecordValue_NormallyFull( UBaseType_t uxValue,
 /* Logs the line on which an error occurred. */
 static void prvQueueAccessLogError( UBaseType_t uxLine );
 
+#if ( configUSE_WORK_QUEUES == 1 )
+
+/* The work queue the interrupts defer work to, and the work items each
+ * interrupt submits to it. */
+    static WorkQueueHandle_t xIntQueueWorkQueue = NULL;
+    static WorkItemHandle_t xIntQueueWorkItems[ intqNUM_WORK_ITEMS ] = { NULL };
+    static StaticWorkItem_t xIntQueueWorkItemBuffers[ intqNUM_WORK_ITEMS ];
+
+/* Incremented each time a work item runs. */
+    static volatile UBaseType_t uxWorkItemsRun[ intqNUM_WORK_ITEMS ] = { 0 };
+
+/* The function run by the work items.  ulWorkItem is the index of the work
+ * item within xIntQueueWorkItems[]. */
+    static void prvIntQueueWorkItem( void * pvParameter1,
+                                     uint32_t ulWorkItem );
+
+#endif /* configUSE_WORK_QUEUES */
+
 /*-----------------------------------------------------------*/
 
 void vStartInterruptQueueTasks( void )
@@ -220,6 +250,20 @@ void vStartInterruptQueueTasks( void )
      * defined to be less than 1. */
     vQueueAddToRegistry( xNormallyFullQueue, "NormallyFull" );
     vQueueAddToRegistry( xNormallyEmptyQueue, "NormallyEmpty" );
+
+    #if ( configUSE_WORK_QUEUES == 1 )
+    {
+        UBaseType_t uxWorkItem;
+
+        xIntQueueWorkQueue = xWorkQueueCreate( "IntQWk", intqWORK_QUEUE_PRIORITY, configMINIMAL_STACK_SIZE );
+        configASSERT( xIntQueueWorkQueue );
+
+        for( uxWorkItem = 0; uxWorkItem < intqNUM_WORK_ITEMS; uxWorkItem++ )
+        {
+            xIntQueueWorkItems[ uxWorkItem ] = xWorkItemCreateStatic( prvIntQueueWorkItem, NULL, ( uint32_t ) uxWorkItem, &( xIntQueueWorkItemBuffers[ uxWorkItem ] ) );
+        }
+    }
+    #endif /* configUSE_WORK_QUEUES */
 }
 /*-----------------------------------------------------------*/
 
@@ -654,6 +698,15 @@ BaseType_t xFirstTimerHandler( void )
         timerNORMALLY_FULL_RX();
     }
 
+    #if ( configUSE_WORK_QUEUES == 1 )
+    {
+        if( xIntQueueWorkQueue != NULL )
+        {
+            ( void ) xWorkQueueSubmitFromISR( xIntQueueWorkQueue, xIntQueueWorkItems[ 0 ], &xHigherPriorityTaskWoken );
+        }
+    }
+    #endif
+
     return xHigherPriorityTaskWoken;
 }
 /*-----------------------------------------------------------*/
@@ -685,10 +738,37 @@ BaseType_t xSecondTimerHandler( void )
         timerNORMALLY_FULL_TX();
     }
 
+    #if ( configUSE_WORK_QUEUES == 1 )
+    {
+        if( xIntQueueWorkQueue != NULL )
+        {
+            ( void ) xWorkQueueSubmitFromISR( xIntQueueWorkQueue, xIntQueueWorkItems[ 1 ], &xHigherPriorityTaskWoken );
+        }
+    }
+    #endif
+
     return xHigherPriorityTaskWoken;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_WORK_QUEUES == 1 )
+
+    static void prvIntQueueWorkItem( void * pvParameter1,
+                                     uint32_t ulWorkItem )
+    {
+        ( void ) pvParameter1;
+
+        uxWorkItemsRun[ ulWorkItem ]++;
+    }
+/*-----------------------------------------------------------*/
+
+    void vGetIntQueueWorkQueueStats( WorkQueueStats_t * pxStats )
+    {
+        vWorkQueueGetStats( xIntQueueWorkQueue, pxStats );
+    }
+
+#endif /* configUSE_WORK_QUEUES */
+/*-----------------------------------------------------------*/
 
 BaseType_t xAreIntQueueTasksStillRunning( void )
 {
@@ -729,5 +809,23 @@ BaseType_t xAreIntQueueTasksStillRunning( void )
 
     uxLastLowPriorityLoops2 = uxLowPriorityLoops2;
 
+    #if ( configUSE_WORK_QUEUES == 1 )
+    {
+        static UBaseType_t uxLastWorkItemsRun[ intqNUM_WORK_ITEMS ] = { 0 };
+        UBaseType_t uxWorkItem;
+
+        for( uxWorkItem = 0; uxWorkItem < intqNUM_WORK_ITEMS; uxWorkItem++ )
+        {
+            if( uxWorkItemsRun[ uxWorkItem ] == uxLastWorkItemsRun[ uxWorkItem ] )
+            {
+                /* The interrupt's work item has not run. */
+                prvQueueAccessLogError( __LINE__ );
+            }
+
+            uxLastWorkItemsRun[ uxWorkItem ] = uxWorkItemsRun[ uxWorkItem ];
+        }
+    }
+    #endif /* configUSE_WORK_QUEUES */
+
     return xErrorStatus;
 }
@@ -27,6 +27,12 @@
 
 /*
  * Demonstrates and tests mutexes being used from an interrupt.
+ *
+ * If configUSE_WORK_QUEUES is 1 the interrupt also defers work to two work
+ * queues, one at a high and one at a low priority, to demonstrate and test
+ * work items being submitted from an interrupt.  The time each work item waits
+ * to run after being submitted can be obtained from
+ * vInterruptSemaphoreGetWorkQueueStats().
  */
 
 
@@ -36,6 +42,7 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "semphr.h"
+#include "work_queue.h"
 
 /* Demo program include files. */
 #include "IntSemTest.h"
@@ -56,6 +63,14 @@
  * interrupt. */
 #define intsemMAX_COUNT                         3
 
+/* The priorities of the work queues used when configUSE_WORK_QUEUES is 1, and
+ * the indexes used to tell the work item function which work queue ran it. */
+#define intsemHIGH_WORK_QUEUE_PRIORITY          ( configMAX_PRIORITIES - 1 )
+#define intsemLOW_WORK_QUEUE_PRIORITY           ( tskIDLE_PRIORITY + 1 )
+#define intsemHIGH_WORK_QUEUE                   0UL
+#define intsemLOW_WORK_QUEUE                    1UL
+#define intsemNUM_WORK_QUEUES                   2
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -91,6 +106,15 @@ static void prvTakeAndGiveInTheOppositeOrder( void );
  */
 static void vInterruptCountingSemaphoreTask( void * pvParameters );
 
+/*
+ * The function run by the work items the interrupt submits to the work queues.
+ * ulWorkQueue is the index of the work queue the work item was submitted to.
+ */
+#if ( configUSE_WORK_QUEUES == 1 )
+    static void prvInterruptWorkItem( void * pvParameter1,
+                                      uint32_t ulWorkQueue );
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* Flag that will be latched to pdTRUE should any unexpected behaviour be
@@ -125,6 +149,18 @@ static BaseType_t xOkToGiveMutex = pdFALSE, xOkToGiveCountingSemaphore = pdFALSE
 /* Used to coordinate timing between tasks and the interrupt. */
 const TickType_t xInterruptGivePeriod = pdMS_TO_TICKS( intsemINTERRUPT_MUTEX_GIVE_PERIOD_MS );
 
+#if ( configUSE_WORK_QUEUES == 1 )
+
+/* The work queues, and the work items the interrupt submits to them.  The work
+ * items are never copied, so must remain in scope while they are submitted. */
+    static WorkQueueHandle_t xWorkQueues[ intsemNUM_WORK_QUEUES ] = { NULL };
+    static WorkItemHandle_t xWorkItems[ intsemNUM_WORK_QUEUES ] = { NULL };
+    static StaticWorkItem_t xWorkItemBuffers[ intsemNUM_WORK_QUEUES ];
+
+/* Incremented each time a work item runs. */
+    static volatile uint32_t ulWorkItemsRun[ intsemNUM_WORK_QUEUES ] = { 0 };
+#endif
+
 /*-----------------------------------------------------------*/
 
 void vStartInterruptSemaphoreTasks( void )
@@ -147,6 +183,23 @@ void vStartInterruptSemaphoreTasks( void )
 
     /* Create the task that blocks on the counting semaphore. */
     xTaskCreate( vInterruptCountingSemaphoreTask, "IntCnt", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL );
+
+    #if ( configUSE_WORK_QUEUES == 1 )
+    {
+        UBaseType_t uxWorkQueue;
+
+        /* Create the work queues the interrupt defers work to, and one work
+         * item for each. */
+        xWorkQueues[ intsemHIGH_WORK_QUEUE ] = xWorkQueueCreate( "IntWkH", intsemHIGH_WORK_QUEUE_PRIORITY, configMINIMAL_STACK_SIZE );
+        xWorkQueues[ intsemLOW_WORK_QUEUE ] = xWorkQueueCreate( "IntWkL", intsemLOW_WORK_QUEUE_PRIORITY, configMINIMAL_STACK_SIZE );
+
+        for( uxWorkQueue = 0; uxWorkQueue < intsemNUM_WORK_QUEUES; uxWorkQueue++ )
+        {
+            configASSERT( xWorkQueues[ uxWorkQueue ] );
+            xWorkItems[ uxWorkQueue ] = xWorkItemCreateStatic( prvInterruptWorkItem, NULL, ( uint32_t ) uxWorkQueue, &( xWorkItemBuffers[ uxWorkQueue ] ) );
+        }
+    }
+    #endif /* configUSE_WORK_QUEUES */
 }
 /*-----------------------------------------------------------*/
 
@@ -465,6 +518,32 @@ static void vInterruptCountingSemaphoreTask( void * pvParameters )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_WORK_QUEUES == 1 )
+
+    static void prvInterruptWorkItem( void * pvParameter1,
+                                      uint32_t ulWorkQueue )
+    {
+        ( void ) pvParameter1;
+
+        /* The work item must run in the task of the work queue it was
+         * submitted to, and must be available to submit again as soon as it
+         * starts to run. */
+        if( xTaskGetCurrentTaskHandle() != xWorkQueueGetTaskHandle( xWorkQueues[ ulWorkQueue ] ) )
+        {
+            xErrorDetected = pdTRUE;
+        }
+
+        if( xWorkItemIsPending( xWorkItems[ ulWorkQueue ] ) != pdFALSE )
+        {
+            xErrorDetected = pdTRUE;
+        }
+
+        ulWorkItemsRun[ ulWorkQueue ]++;
+    }
+
+#endif /* configUSE_WORK_QUEUES */
+/*-----------------------------------------------------------*/
+
 void vInterruptSemaphorePeriodicTest( void )
 {
     static TickType_t xLastGiveTime = 0;
@@ -494,6 +573,27 @@ void vInterruptSemaphorePeriodicTest( void )
             xSemaphoreGiveFromISR( xISRCountingSemaphore, &xHigherPriorityTaskWoken );
         }
 
+        #if ( configUSE_WORK_QUEUES == 1 )
+        {
+            UBaseType_t uxWorkQueue;
+
+            for( uxWorkQueue = 0; uxWorkQueue < intsemNUM_WORK_QUEUES; uxWorkQueue++ )
+            {
+                if( xWorkQueues[ uxWorkQueue ] != NULL )
+                {
+                    /* Neither work queue's task can run before this interrupt
+                     * exits, so the work item must still be pending when it is
+                     * submitted for the second time, and the second submit
+                     * must do nothing. */
+                    if( xWorkQueueSubmitFromISR( xWorkQueues[ uxWorkQueue ], xWorkItems[ uxWorkQueue ], &xHigherPriorityTaskWoken ) == pdPASS )
+                    {
+                        configASSERT( xWorkQueueSubmitFromISR( xWorkQueues[ uxWorkQueue ], xWorkItems[ uxWorkQueue ], &xHigherPriorityTaskWoken ) == pdFAIL );
+                    }
+                }
+            }
+        }
+        #endif /* configUSE_WORK_QUEUES */
+
         xLastGiveTime = xTimeNow;
     }
 
@@ -523,8 +623,39 @@ BaseType_t xAreInterruptSemaphoreTasksStillRunning( void )
 
     ulLastCountingSemaphoreLoops = ulCountingSemaphoreLoops++;
 
+    #if ( configUSE_WORK_QUEUES == 1 )
+    {
+        static uint32_t ulLastWorkItemsRun[ intsemNUM_WORK_QUEUES ] = { 0 };
+        UBaseType_t uxWorkQueue;
+
+        /* The interrupt submits to both work queues once per give period, so
+         * both must have run work items since this function was last called. */
+        for( uxWorkQueue = 0; uxWorkQueue < intsemNUM_WORK_QUEUES; uxWorkQueue++ )
+        {
+            if( ulLastWorkItemsRun[ uxWorkQueue ] == ulWorkItemsRun[ uxWorkQueue ] )
+            {
+                xErrorDetected = pdTRUE;
+            }
+
+            ulLastWorkItemsRun[ uxWorkQueue ] = ulWorkItemsRun[ uxWorkQueue ];
+        }
+    }
+    #endif /* configUSE_WORK_QUEUES */
+
     /* Errors detected in the task itself will have latched xErrorDetected
      * to true. */
 
     return ( BaseType_t ) !xErrorDetected;
 }
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WORK_QUEUES == 1 )
+
+    void vInterruptSemaphoreGetWorkQueueStats( WorkQueueStats_t * pxHighPriorityStats,
+                                               WorkQueueStats_t * pxLowPriorityStats )
+    {
+        vWorkQueueGetStats( xWorkQueues[ intsemHIGH_WORK_QUEUE ], pxHighPriorityStats );
+        vWorkQueueGetStats( xWorkQueues[ intsemLOW_WORK_QUEUE ], pxLowPriorityStats );
+    }
+
+#endif /* configUSE_WORK_QUEUES */
@@ -35,6 +35,7 @@
 
 /* Demo app includes. */
 #include "MessageBufferDemo.h"
+#include "ThroughputMonitor.h"
 
 /* The number of bytes of storage in the message buffers used in this test. */
 #define mbMESSAGE_BUFFER_LENGTH_BYTES      ( ( size_t ) 50 )
@@ -68,6 +69,22 @@
  */
 static void prvSingleTaskTests( MessageBufferHandle_t xMessageBuffer );
 
+/*
+ * Tests the zero copy functions on an empty message buffer - a message that is
+ * split by the end of the storage area, a message length that is split by the
+ * end of the storage area, and abandoning a reservation.
+ */
+static void prvZeroCopyTests( MessageBufferHandle_t xMessageBuffer );
+
+/*
+ * Writes then discards a message so the next message written to the empty
+ * buffer xMessageBuffer starts xOffset bytes into the storage area.  The buffer
+ * must be empty with its next message starting at xCurrentOffset.
+ */
+static void prvMoveToOffset( MessageBufferHandle_t xMessageBuffer,
+                             size_t xCurrentOffset,
+                             size_t xOffset );
+
 /*
  * Tests sending and receiving various lengths of messages via a message buffer.
  * The echo client sends the messages to the echo server, which then sends the
@@ -123,6 +140,10 @@ typedef struct ECHO_MESSAGE_BUFFERS
 } EchoMessageBuffers_t;
 static uint32_t ulEchoLoopCounters[ mbNUMBER_OF_ECHO_CLIENTS ] = { 0 };
 
+/* The number of bytes each echo client has had echoed back to it, for
+ * throughput reporting.  Each element is only written by one client task. */
+static volatile uint32_t ulEchoBytesReceived[ mbNUMBER_OF_ECHO_CLIENTS ] = { 0 };
+
 /* The non-blocking tasks monitor their operation, and if no errors have been
  * found, increment ulNonBlockingRxCounter.  xAreMessageBufferTasksStillRunning()
  * then checks ulNonBlockingRxCounter and only returns pdPASS if
@@ -458,6 +479,143 @@ static void prvSingleTaskTests( MessageBufferHandle_t xMessageBuffer )
 }
 /*-----------------------------------------------------------*/
 
+static void prvMoveToOffset( MessageBufferHandle_t xMessageBuffer,
+                             size_t xCurrentOffset,
+                             size_t xOffset )
+{
+    size_t xReturned, xMessageLength;
+    void * pvData, * pvWrappedData;
+
+    /* The message and its length together must span exactly the distance to
+     * move, so the message itself is mbBYTES_TO_STORE_MESSAGE_LENGTH bytes
+     * shorter. */
+    configASSERT( xOffset > ( xCurrentOffset + mbBYTES_TO_STORE_MESSAGE_LENGTH ) );
+    xMessageLength = xOffset - xCurrentOffset - mbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+    xReturned = xMessageBufferSend( xMessageBuffer, ( const void * ) pc55ByteString, xMessageLength, mbDONT_BLOCK );
+    configASSERT( xReturned == xMessageLength );
+
+    /* Discard the message without copying it out. */
+    xReturned = xMessageBufferPeek( xMessageBuffer, &pvData, &pvWrappedData, &xMessageLength, mbDONT_BLOCK );
+    configASSERT( xReturned == xMessageLength );
+    configASSERT( pvWrappedData == NULL );
+    xReturned = xMessageBufferConsume( xMessageBuffer, xMessageLength );
+    configASSERT( xReturned == xMessageLength );
+    configASSERT( xMessageBufferIsEmpty( xMessageBuffer ) == pdTRUE );
+
+    /* In case configASSERT() is not defined. */
+    ( void ) xReturned;
+    ( void ) pvData;
+}
+/*-----------------------------------------------------------*/
+
+static void prvZeroCopyTests( MessageBufferHandle_t xMessageBuffer )
+{
+    size_t xReturned, xFirstPart, xMessageLength;
+    uint8_t * pucData, * pucWrappedData, * pucAbandoned;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    /* The storage area is one byte longer than mbMESSAGE_BUFFER_LENGTH_BYTES.
+     * A 20 byte message written 40 bytes in has its length before the end of
+     * the storage area and its data split by the end of the storage area, as
+     * long as the length takes fewer than 11 bytes.  A message written one byte
+     * from the end has its length split by the end of the storage area, as long
+     * as the length takes more than one byte. */
+    const size_t xStorageLength = mbMESSAGE_BUFFER_LENGTH_BYTES + 1;
+    const size_t xSplitDataOffset = 40, xSplitLengthOffset = xStorageLength - 1;
+    const size_t x6ByteLength = 6, x20ByteLength = 20;
+
+    /* Reserve a message that is split by the end of the storage area. */
+    prvMoveToOffset( xMessageBuffer, 0, xSplitDataOffset );
+    xFirstPart = xStorageLength - xSplitDataOffset - mbBYTES_TO_STORE_MESSAGE_LENGTH;
+    xReturned = xMessageBufferReserve( xMessageBuffer, ( void ** ) &pucData, ( void ** ) &pucWrappedData, x20ByteLength, mbDONT_BLOCK );
+    configASSERT( xReturned == xFirstPart );
+    configASSERT( pucWrappedData != NULL );
+    memcpy( ( void * ) pucData, ( const void * ) pc55ByteString, xFirstPart );
+    memcpy( ( void * ) pucWrappedData, ( const void * ) &( pc55ByteString[ xFirstPart ] ), x20ByteLength - xFirstPart );
+
+    /* Nothing is visible to the reader until the message is committed. */
+    configASSERT( xMessageBufferIsEmpty( xMessageBuffer ) == pdTRUE );
+    xReturned = xMessageBufferCommit( xMessageBuffer, x20ByteLength );
+    configASSERT( xReturned == x20ByteLength );
+    xMessageLength = xMessageBufferNextLengthBytes( xMessageBuffer );
+    configASSERT( xMessageLength == x20ByteLength );
+
+    /* Committing zero bytes abandons a reservation, so nothing more reaches
+     * the reader and the same space is handed out again. */
+    xReturned = xMessageBufferReserve( xMessageBuffer, ( void ** ) &pucAbandoned, ( void ** ) &pucWrappedData, x6ByteLength, mbDONT_BLOCK );
+    configASSERT( xReturned == x6ByteLength );
+    memset( ( void * ) pucAbandoned, 0x00, x6ByteLength );
+    configASSERT( xMessageBufferCommit( xMessageBuffer, 0 ) == ( size_t ) 0 );
+    xReturned = xMessageBufferReserve( xMessageBuffer, ( void ** ) &pucData, ( void ** ) &pucWrappedData, x6ByteLength, mbDONT_BLOCK );
+    configASSERT( xReturned == x6ByteLength );
+    configASSERT( pucData == pucAbandoned );
+    configASSERT( xMessageBufferCommit( xMessageBuffer, 0 ) == ( size_t ) 0 );
+
+    /* Peek the message back in place, in the same two parts.  The 'FromISR'
+     * version of consume is used to give it some exercise, so must be called
+     * from a critical section for ports that don't support interrupt nesting. */
+    xReturned = xMessageBufferPeek( xMessageBuffer, ( void ** ) &pucData, ( void ** ) &pucWrappedData, &xMessageLength, mbDONT_BLOCK );
+    configASSERT( xReturned == xFirstPart );
+    configASSERT( xMessageLength == x20ByteLength );
+    configASSERT( memcmp( ( const void * ) pucData, ( const void * ) pc55ByteString, xFirstPart ) == 0 );
+    configASSERT( pucWrappedData != NULL );
+    configASSERT( memcmp( ( const void * ) pucWrappedData, ( const void * ) &( pc55ByteString[ xFirstPart ] ), x20ByteLength - xFirstPart ) == 0 );
+
+    taskENTER_CRITICAL();
+    {
+        xReturned = xMessageBufferConsumeFromISR( xMessageBuffer, xMessageLength, &xHigherPriorityTaskWoken );
+    }
+    taskEXIT_CRITICAL();
+    configASSERT( xReturned == x20ByteLength );
+    configASSERT( xHigherPriorityTaskWoken == pdFALSE );
+    configASSERT( xMessageBufferIsEmpty( xMessageBuffer ) == pdTRUE );
+
+    /* Reserve a message whose length is split by the end of the storage area.
+     * The length is only written when the message is committed, this time
+     * using the 'FromISR' version. */
+    prvMoveToOffset( xMessageBuffer, ( xSplitDataOffset + mbBYTES_TO_STORE_MESSAGE_LENGTH + x20ByteLength ) - xStorageLength, xSplitLengthOffset );
+    xReturned = xMessageBufferReserve( xMessageBuffer, ( void ** ) &pucData, ( void ** ) &pucWrappedData, x6ByteLength, mbDONT_BLOCK );
+    configASSERT( xReturned == x6ByteLength );
+    configASSERT( pucWrappedData == NULL );
+    memcpy( ( void * ) pucData, ( const void * ) pc55ByteString, x6ByteLength );
+
+    taskENTER_CRITICAL();
+    {
+        xReturned = xMessageBufferCommitFromISR( xMessageBuffer, x6ByteLength, &xHigherPriorityTaskWoken );
+    }
+    taskEXIT_CRITICAL();
+    configASSERT( xReturned == x6ByteLength );
+    configASSERT( xHigherPriorityTaskWoken == pdFALSE );
+
+    /* The length must read back correctly from both ends of the storage
+     * area. */
+    xMessageLength = xMessageBufferNextLengthBytes( xMessageBuffer );
+    configASSERT( xMessageLength == x6ByteLength );
+    xReturned = xMessageBufferPeek( xMessageBuffer, ( void ** ) &pucWrappedData, ( void ** ) &pucAbandoned, &xMessageLength, mbDONT_BLOCK );
+    configASSERT( xReturned == x6ByteLength );
+    configASSERT( xMessageLength == x6ByteLength );
+    configASSERT( pucWrappedData == pucData );
+    configASSERT( pucAbandoned == NULL );
+    configASSERT( memcmp( ( const void * ) pucData, ( const void * ) pc55ByteString, x6ByteLength ) == 0 );
+    xReturned = xMessageBufferConsume( xMessageBuffer, xMessageLength );
+    configASSERT( xReturned == x6ByteLength );
+
+    /* Nothing is left to peek. */
+    configASSERT( xMessageBufferIsEmpty( xMessageBuffer ) == pdTRUE );
+    xReturned = xMessageBufferPeek( xMessageBuffer, ( void ** ) &pucData, ( void ** ) &pucWrappedData, &xMessageLength, mbDONT_BLOCK );
+    configASSERT( xReturned == ( size_t ) 0 );
+    configASSERT( xMessageLength == ( size_t ) 0 );
+    configASSERT( pucData == NULL );
+
+    /* In case configASSERT() is not defined. */
+    ( void ) xReturned;
+    ( void ) pucAbandoned;
+
+    xMessageBufferReset( xMessageBuffer );
+}
+/*-----------------------------------------------------------*/
+
 static void prvNonBlockingSenderTask( void * pvParameters )
 {
     MessageBufferHandle_t xMessageBuffer;
@@ -609,6 +767,7 @@ static void prvNonBlockingReceiverTask( void * pvParameters )
             /* Here prvSingleTaskTests() performs various tests on a message buffer
              * that was created statically. */
             prvSingleTaskTests( xMessageBuffer );
+            prvZeroCopyTests( xMessageBuffer );
             xTaskCreate( prvReceiverTask, "MsgReceiver", xBlockingStackSize, ( void * ) xMessageBuffer, mbHIGHER_PRIORITY, NULL );
         }
         else
@@ -769,6 +928,7 @@ static void prvEchoClient( void * pvParameters )
         xMessageBufferReceive( pxMessageBuffers->xEchoServerBuffer, ( void * ) pcStringReceived, xSendLength, portMAX_DELAY );
 
         configASSERT( strcmp( pcStringToSend, pcStringReceived ) == 0 );
+        tputCOUNTER_ADD( ulEchoBytesReceived[ uxIndex ], xSendLength );
     }
 }
 /*-----------------------------------------------------------*/
@@ -817,6 +977,7 @@ static void prvEchoServer( void * pvParameters )
         /* Here prvSingleTaskTests() performs various tests on a message buffer
          * that was created dynamically. */
         prvSingleTaskTests( xMessageBuffers.xEchoClientBuffer );
+        prvZeroCopyTests( xMessageBuffers.xEchoClientBuffer );
         xTaskCreate( prvEchoClient, "EchoClient", configMINIMAL_STACK_SIZE, ( void * ) &xMessageBuffers, mbLOWER_PRIORITY, NULL );
     }
 
@@ -969,3 +1130,22 @@ BaseType_t xAreMessageBufferTasksStillRunning( void )
     return xReturn;
 }
 /*-----------------------------------------------------------*/
+
+uint32_t ulGetMessageBufferBytesReceived( void )
+{
+    uint32_t ulTotal = 0;
+    BaseType_t x;
+
+    /* A 32-bit read is not atomic on 16-bit ports. */
+    taskENTER_CRITICAL();
+    {
+        for( x = 0; x < mbNUMBER_OF_ECHO_CLIENTS; x++ )
+        {
+            ulTotal += ulEchoBytesReceived[ x ];
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return ulTotal;
+}
+/*-----------------------------------------------------------*/
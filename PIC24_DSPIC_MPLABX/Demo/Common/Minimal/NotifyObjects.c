@@ -0,0 +1,405 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Demonstrates and tests the mailboxes, counting semaphores and event flags in
+ * notify_objects.h.  A receiving task owns one of each, each held in a
+ * different index of its task notification array.  A lower priority sending
+ * task posts to the mailbox, gives the semaphore and sets the event flags, and
+ * checks the receiving task has done what was expected each time it returns.
+ * This includes checking a full mailbox rejects a second message, that a wait
+ * for all of a set of event flags only returns once the last one is set, and
+ * that a receive from an empty mailbox times out.  One event flag is only ever
+ * set from the tick hook, so the interrupt safe functions are also tested.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "notify_objects.h"
+
+/* Demo program include files. */
+#include "NotifyObjects.h"
+
+/* Exclude the entire file if configUSE_NOTIFY_OBJECTS is 0. */
+#if ( configUSE_NOTIFY_OBJECTS == 1 )
+
+    #if ( configTASK_NOTIFICATION_ARRAY_ENTRIES < 3 )
+        #error This file uses three task notification indexes and needs configTASK_NOTIFICATION_ARRAY_ENTRIES to be at least 3.
+    #endif
+
+/* The priorities of the tasks created by this file.  The receiving task has the
+ * higher priority so it runs as soon as one of its objects unblocks it. */
+    #define notifySENDER_TASK_PRIORITY      ( tskIDLE_PRIORITY + 1 )
+    #define notifyRECEIVER_TASK_PRIORITY    ( tskIDLE_PRIORITY + 2 )
+
+/* The index of the receiving task's notification array used by each object. */
+    #define notifyMAILBOX_INDEX             ( 0 )
+    #define notifySEMAPHORE_INDEX           ( 1 )
+    #define notifyEVENT_FLAGS_INDEX         ( 2 )
+
+/* The event flags.  The task flags are set by the sending task one at a time,
+ * and the receiving task waits for both.  The ISR flag is only set from the tick
+ * hook. */
+    #define notifyTASK_FLAG_0               ( 0x01UL )
+    #define notifyTASK_FLAG_1               ( 0x02UL )
+    #define notifyTASK_FLAGS                ( notifyTASK_FLAG_0 | notifyTASK_FLAG_1 )
+    #define notifyISR_FLAG                  ( 0x80UL )
+
+/* The number of times the semaphore is given before the receiving task gets to
+ * run, and so the number of times it must then be taken. */
+    #define notifySEMAPHORE_GIVES           ( 3 )
+
+/* The number of ticks between each time the tick hook sets the ISR flag. */
+    #define notifyISR_SET_PERIOD            ( ( TickType_t ) 10 )
+
+/* Each wait of the receiving task other than the one on the empty mailbox is
+ * ended within notifyISR_SET_PERIOD ticks, by the sending task or by the tick
+ * hook, so it should never time out.  Many periods are allowed so it does not
+ * when the other demo tasks keep the sending task from running. */
+    #define notifyRECEIVER_BLOCK_TIME       ( notifyISR_SET_PERIOD * ( TickType_t ) 20 )
+
+/* The time the receiving task waits on the empty mailbox.  It spans at least one
+ * setting of the ISR flag, so also checks that a notification sent to the event
+ * flags' index does not end a wait on the mailbox's index. */
+    #define notifySHORT_BLOCK_TIME          ( notifyISR_SET_PERIOD * ( TickType_t ) 2 )
+
+/* The size of the stack used by the tasks in this file. */
+    #define notifyTASK_STACK_SIZE           ( configMINIMAL_STACK_SIZE * 2 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task that owns the objects, and receives from, takes and waits on them.
+ */
+    static void prvNotifyObjectsReceiver( void * pvParameters );
+
+/*
+ * The task that posts to, gives and sets the objects, and checks the receiving
+ * task has reacted.
+ */
+    static void prvNotifyObjectsSender( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+/* The objects, all owned by the receiving task. */
+    static NotifyMailbox_t xMailbox;
+    static NotifySemaphore_t xSemaphore;
+    static NotifyEventFlags_t xEventFlags;
+
+/* The messages posted to the mailbox.  Two are needed as a second message is
+ * posted while the first is still in the mailbox. */
+    static uint32_t ulMessages[ 2 ];
+
+/* The next value the sending task posts, and the next value the receiving task
+ * expects to receive. */
+    static uint32_t ulNextValueToSend = 0, ulNextValueExpected = 0;
+
+/* The number of times the receiving task has completed each operation. */
+    static volatile uint32_t ulMessagesReceived = 0;
+    static volatile uint32_t ulSemaphoresTaken = 0;
+    static volatile uint32_t ulTaskFlagWaits = 0;
+    static volatile uint32_t ulISRFlagWaits = 0;
+
+/* Used so a check task can ensure this test is still executing, and not
+ * stalled. */
+    static volatile UBaseType_t uxCycleCounter = 0;
+
+/* A variable that gets set to pdTRUE if an error is detected. */
+    static volatile BaseType_t xErrorOccurred = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+    void vStartNotifyObjectTasks( void )
+    {
+        TaskHandle_t xReceiverTask = NULL;
+
+        /* Create the receiving task first, as it owns all the objects. */
+        xTaskCreate( prvNotifyObjectsReceiver, "NotifyRx", notifyTASK_STACK_SIZE, NULL, notifyRECEIVER_TASK_PRIORITY, &xReceiverTask );
+        configASSERT( xReceiverTask );
+
+        vNotifyMailboxInit( &xMailbox, xReceiverTask, notifyMAILBOX_INDEX );
+        vNotifySemaphoreInit( &xSemaphore, xReceiverTask, notifySEMAPHORE_INDEX );
+        vNotifyEventFlagsInit( &xEventFlags, xReceiverTask, notifyEVENT_FLAGS_INDEX );
+
+        xTaskCreate( prvNotifyObjectsSender, "NotifyTx", notifyTASK_STACK_SIZE, NULL, notifySENDER_TASK_PRIORITY, NULL );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvNotifyObjectsReceiver( void * pvParameters )
+    {
+        void * pvMessage;
+        uint32_t ulFlags;
+        TickType_t xTimeBefore, xTimeAfter;
+        BaseType_t x;
+
+        /* Avoid compiler warnings. */
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            /* The sending task posts one message, then a second that must be
+             * received in the same order. */
+            for( x = 0; x < 2; x++ )
+            {
+                if( xNotifyMailboxReceive( &xMailbox, &pvMessage, notifyRECEIVER_BLOCK_TIME ) != pdPASS )
+                {
+                    xErrorOccurred = pdTRUE;
+                }
+                else
+                {
+                    if( *( ( uint32_t * ) pvMessage ) != ulNextValueExpected )
+                    {
+                        xErrorOccurred = pdTRUE;
+                    }
+
+                    ulNextValueExpected++;
+                    ulMessagesReceived++;
+                }
+            }
+
+            /* The semaphore is given several times before this task runs, so
+             * it must be possible to take it that many times and no more. */
+            for( x = 0; x < notifySEMAPHORE_GIVES; x++ )
+            {
+                if( xNotifySemaphoreTake( &xSemaphore, notifyRECEIVER_BLOCK_TIME ) != pdPASS )
+                {
+                    xErrorOccurred = pdTRUE;
+                }
+                else
+                {
+                    ulSemaphoresTaken++;
+                }
+            }
+
+            if( xNotifySemaphoreTake( &xSemaphore, 0 ) != pdFAIL )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            /* Wait for both the task flags, which are set one at a time. */
+            ulFlags = ulNotifyEventFlagsWait( &xEventFlags, notifyTASK_FLAGS, pdTRUE, pdTRUE, notifyRECEIVER_BLOCK_TIME );
+
+            if( ( ulFlags & notifyTASK_FLAGS ) != notifyTASK_FLAGS )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+            else
+            {
+                ulTaskFlagWaits++;
+            }
+
+            /* Wait for the flag set by the tick hook. */
+            ulFlags = ulNotifyEventFlagsWait( &xEventFlags, notifyISR_FLAG, pdTRUE, pdFALSE, notifyRECEIVER_BLOCK_TIME );
+
+            if( ( ulFlags & notifyISR_FLAG ) == 0UL )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+            else
+            {
+                ulISRFlagWaits++;
+            }
+
+            /* Nothing is posted to the mailbox until this task completes the
+             * cycle, so this must time out, and not before the block time.  The
+             * sending task waits for the cycle to complete, so a wait that never
+             * timed out would stop the cycle counter. */
+            xTimeBefore = xTaskGetTickCount();
+
+            if( ( xNotifyMailboxReceive( &xMailbox, &pvMessage, notifySHORT_BLOCK_TIME ) != pdFAIL ) || ( pvMessage != NULL ) )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            xTimeAfter = xTaskGetTickCount();
+
+            if( ( TickType_t ) ( xTimeAfter - xTimeBefore ) < notifySHORT_BLOCK_TIME )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            uxCycleCounter++;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvNotifyObjectsSender( void * pvParameters )
+    {
+        uint32_t ulCountBefore;
+        UBaseType_t uxCycleBefore;
+        BaseType_t x;
+
+        /* Avoid compiler warnings. */
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            /* The receiving task is waiting for the first message of the
+             * cycle. */
+            uxCycleBefore = uxCycleCounter;
+
+            /* The receiving task has the higher priority, so it must have
+             * received the message before the post returns. */
+            ulCountBefore = ulMessagesReceived;
+            ulMessages[ 0 ] = ulNextValueToSend++;
+
+            if( xNotifyMailboxPost( &xMailbox, &( ulMessages[ 0 ] ) ) != pdPASS )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            if( ulMessagesReceived != ( ulCountBefore + 1UL ) )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            /* With the scheduler suspended the receiving task cannot run, so
+             * the mailbox is still full when a second post is attempted. */
+            ulCountBefore = ulMessagesReceived;
+            ulMessages[ 1 ] = ulNextValueToSend++;
+
+            vTaskSuspendAll();
+            {
+                if( xNotifyMailboxPost( &xMailbox, &( ulMessages[ 1 ] ) ) != pdPASS )
+                {
+                    xErrorOccurred = pdTRUE;
+                }
+
+                if( xNotifyMailboxPost( &xMailbox, &( ulMessages[ 0 ] ) ) != pdFAIL )
+                {
+                    xErrorOccurred = pdTRUE;
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            if( ulMessagesReceived != ( ulCountBefore + 1UL ) )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            /* Give the semaphore several times before the receiving task can
+             * run, so its count has to go above one. */
+            ulCountBefore = ulSemaphoresTaken;
+
+            vTaskSuspendAll();
+            {
+                for( x = 0; x < notifySEMAPHORE_GIVES; x++ )
+                {
+                    if( xNotifySemaphoreGive( &xSemaphore ) != pdPASS )
+                    {
+                        xErrorOccurred = pdTRUE;
+                    }
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            if( ulSemaphoresTaken != ( ulCountBefore + ( uint32_t ) notifySEMAPHORE_GIVES ) )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            /* The receiving task waits for both task flags, so setting the
+             * first must not let it return, but setting the second must. */
+            ulCountBefore = ulTaskFlagWaits;
+            ( void ) xNotifyEventFlagsSet( &xEventFlags, notifyTASK_FLAG_0 );
+
+            if( ulTaskFlagWaits != ulCountBefore )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            ( void ) xNotifyEventFlagsSet( &xEventFlags, notifyTASK_FLAG_1 );
+
+            if( ulTaskFlagWaits != ( ulCountBefore + 1UL ) )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            /* The receiving task cleared the flags it waited for on exit. */
+            if( ( ulNotifyEventFlagsClear( &xEventFlags, 0UL ) & notifyTASK_FLAGS ) != 0UL )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            /* Leave the receiving task to wait for the ISR flag and to time
+             * out on the empty mailbox, however long the other demo tasks keep
+             * it from running, before posting the next message. */
+            while( uxCycleCounter == uxCycleBefore )
+            {
+                vTaskDelay( notifyISR_SET_PERIOD );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vNotifyObjectsAccessFromISR( void )
+    {
+        static TickType_t xCallCount = 0;
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+        xCallCount++;
+
+        if( ( xCallCount % notifyISR_SET_PERIOD ) == 0 )
+        {
+            ( void ) xNotifyEventFlagsSetFromISR( &xEventFlags, notifyISR_FLAG, &xHigherPriorityTaskWoken );
+
+            /* The tick hook is called from within the tick interrupt, which
+             * performs a context switch itself if one is needed. */
+            ( void ) xHigherPriorityTaskWoken;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xAreNotifyObjectTasksStillRunning( void )
+    {
+        static UBaseType_t uxLastCycleCounter = 0;
+        BaseType_t xReturn;
+
+        if( uxCycleCounter == uxLastCycleCounter )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+        else
+        {
+            uxLastCycleCounter = uxCycleCounter;
+        }
+
+        if( xErrorOccurred != pdFALSE )
+        {
+            xReturn = pdFAIL;
+        }
+        else
+        {
+            xReturn = pdPASS;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/* Exclude the entire file if configUSE_NOTIFY_OBJECTS is 0. */
+#endif /* configUSE_NOTIFY_OBJECTS == 1 */
@@ -63,6 +63,7 @@
 
 /* Demo program include files. */
 #include "PollQ.h"
+#include "ThroughputMonitor.h"
 
 #define pollqSTACK_SIZE           configMINIMAL_STACK_SIZE
 #define pollqQUEUE_SIZE           ( 10 )
@@ -82,6 +83,10 @@ static portTASK_FUNCTION_PROTO( vPolledQueueConsumer, pvParameters );
  * errors. */
 static volatile BaseType_t xPollingConsumerCount = pollqINITIAL_VALUE, xPollingProducerCount = pollqINITIAL_VALUE;
 
+/* The number of items the consumer has removed from the queue, for throughput
+ * reporting.  Unlike the check variables above this is never reset. */
+static volatile uint32_t ulPollingItemsReceived = 0;
+
 /*-----------------------------------------------------------*/
 
 void vStartPolledQueueTasks( UBaseType_t uxPriority )
@@ -159,6 +164,8 @@ static portTASK_FUNCTION( vPolledQueueConsumer, pvParameters )
         {
             if( xQueueReceive( *( ( QueueHandle_t * ) pvParameters ), &usData, pollqNO_DELAY ) == pdPASS )
             {
+                tputCOUNTER_ADD( ulPollingItemsReceived, 1 );
+
                 if( usData != usExpectedValue )
                 {
                     /* This is not what we expected to receive so an error has
@@ -220,3 +227,19 @@ BaseType_t xArePollingQueuesStillRunning( void )
 
     return xReturn;
 }
+/*-----------------------------------------------------------*/
+
+uint32_t ulGetPollingQueueItemsReceived( void )
+{
+    uint32_t ulCount;
+
+    /* A 32-bit read is not atomic on 16-bit ports. */
+    taskENTER_CRITICAL();
+    {
+        ulCount = ulPollingItemsReceived;
+    }
+    taskEXIT_CRITICAL();
+
+    return ulCount;
+}
+/*-----------------------------------------------------------*/
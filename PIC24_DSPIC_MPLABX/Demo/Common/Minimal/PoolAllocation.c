@@ -0,0 +1,487 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A variant of the StaticAllocation.c demo that demonstrates and tests memory
+ * pools.  A pool is created from pre-allocated memory, checked, and deleted
+ * again, repeatedly, using the same memory each time.  Blocks are allocated
+ * and freed from both task and interrupt API functions, and a second, higher
+ * priority, task checks that a task blocked waiting for a block is given the
+ * next block freed, whether it is freed by a task or from an interrupt, and
+ * that a task times out correctly if no block is freed.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pool.h"
+
+/* Demo program include files. */
+#include "PoolAllocation.h"
+
+/* Exclude the entire file if configSUPPORT_STATIC_ALLOCATION is 0. */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+/* The priority at which the task that performs the tests is created. */
+    #define poolTASK_PRIORITY              ( tskIDLE_PRIORITY + 2 )
+
+/* The task that waits for blocks runs at a higher priority, so it runs as soon
+ * as it is given a block. */
+    #define poolWAITER_TASK_PRIORITY       ( tskIDLE_PRIORITY + 3 )
+
+/* The number of blocks in the pool used by the tests. */
+    #define poolNUMBER_OF_BLOCKS           ( 4 )
+
+/* A block time of 0 simply means "don't block". */
+    #define poolDONT_BLOCK                 ( ( TickType_t ) 0 )
+
+/* The time to block when allocating from a pool that has no free blocks. */
+    #define poolSHORT_BLOCK_TIME           pdMS_TO_TICKS( ( TickType_t ) 20 )
+
+/* The size of the stack used by the tasks in this file. */
+    #define poolTASK_STACK_SIZE            ( configMINIMAL_STACK_SIZE * 2 )
+
+/* The value written into each block of the pool. */
+    #define poolFILL_VALUE                 ( 0x5aa5a55aUL )
+
+/*-----------------------------------------------------------*/
+
+/* The type of the blocks allocated from the pool.  The size of the structure is
+ * a multiple of 8 bytes, so an array of the structures used as the pool storage
+ * area is already a whole number of blocks. */
+    typedef struct POOL_MESSAGE
+    {
+        uint64_t ullSequenceNumber;
+        uint32_t ulPayload[ 6 ];
+    } PoolMessage_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task that repeatedly creates and deletes pools, and uses them to test the
+ * pool API functions.
+ */
+    static void prvPoolCreator( void * pvParameters );
+
+/*
+ * The task that blocks waiting for a block to be freed to the pool.
+ */
+    static void prvPoolWaiter( void * pvParameters );
+
+/*
+ * Creates a pool, checks it using prvSanityCheckCreatedPool(), then deletes
+ * it again.
+ */
+    static void prvCreateAndDeleteStaticallyAllocatedPool( void );
+
+/*
+ * Checks that a task blocked on a pool that has no free blocks is unblocked
+ * when a block is freed by a task or from an interrupt.
+ */
+    static void prvTestBlockingOnPool( void );
+
+/*
+ * Checks the basic operation of a pool after it has been created.
+ */
+    static void prvSanityCheckCreatedPool( PoolHandle_t xPool );
+
+/*
+ * Allocates every block from xPool, using pvPoolAlloc() or
+ * pvPoolAllocFromISR() in turn, and checks each block is one of the blocks in
+ * the pool storage area and is not already in use.
+ */
+    static void prvAllocateAllBlocks( PoolHandle_t xPool,
+                                      PoolMessage_t * pxBlocks[] );
+
+/*-----------------------------------------------------------*/
+
+/* The storage area of the pool and the structure used to hold the pool's state.
+ * StaticPool_t is a publicly accessible structure that has the same size and
+ * alignment requirements as the real pool structure.  It is provided as a
+ * mechanism for applications to know the size of the pool (which is dependent
+ * on the architecture and configuration file settings) without breaking the
+ * strict data hiding policy by exposing the real pool internals.  Both are
+ * reused every time a pool is created. */
+    static PoolMessage_t xPoolStorage[ poolNUMBER_OF_BLOCKS ];
+    static StaticPool_t xStaticPool;
+
+/* The TCBs and stacks of the tasks created by this file. */
+    static StaticTask_t xCreatorTaskTCBBuffer, xWaiterTaskTCBBuffer;
+    static StackType_t uxCreatorTaskStackBuffer[ poolTASK_STACK_SIZE ];
+    static StackType_t uxWaiterTaskStackBuffer[ poolTASK_STACK_SIZE ];
+
+/* The pool the waiter task allocates from, the block it was given and the
+ * handle of the waiter task. */
+    static PoolHandle_t xWaiterPool = NULL;
+    static volatile PoolMessage_t * pxWaiterBlock = NULL;
+    static TaskHandle_t xWaiterTask = NULL;
+
+/* Used so a check task can ensure this test is still executing, and not
+ * stalled. */
+    static volatile UBaseType_t uxCycleCounter = 0;
+
+/* A variable that gets set to pdTRUE if an error is detected. */
+    static volatile BaseType_t xErrorOccurred = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+    void vStartPoolAllocationTasks( void )
+    {
+        /* Create the task that waits for blocks first, so its handle is
+         * available to the task that performs the tests. */
+        xWaiterTask = xTaskCreateStatic( prvPoolWaiter,
+                                         "PoolWait",
+                                         poolTASK_STACK_SIZE,
+                                         NULL,
+                                         poolWAITER_TASK_PRIORITY,
+                                         &( uxWaiterTaskStackBuffer[ 0 ] ),
+                                         &xWaiterTaskTCBBuffer );
+
+        xTaskCreateStatic( prvPoolCreator,
+                           "PoolCreate",
+                           poolTASK_STACK_SIZE,
+                           NULL,
+                           poolTASK_PRIORITY,
+                           &( uxCreatorTaskStackBuffer[ 0 ] ),
+                           &xCreatorTaskTCBBuffer );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPoolCreator( void * pvParameters )
+    {
+        /* Avoid compiler warnings. */
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            prvCreateAndDeleteStaticallyAllocatedPool();
+
+            /* Delay to ensure lower priority tasks get CPU time, and increment
+             * the cycle counter so a 'check' task can determine that this task
+             * is still executing. */
+            vTaskDelay( poolSHORT_BLOCK_TIME );
+            uxCycleCounter++;
+
+            prvTestBlockingOnPool();
+
+            vTaskDelay( poolSHORT_BLOCK_TIME );
+            uxCycleCounter++;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPoolWaiter( void * pvParameters )
+    {
+        PoolMessage_t * pxBlock;
+
+        /* Avoid compiler warnings. */
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            /* Wait to be told a pool with no free blocks has been created. */
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+            /* Wait for a block to be freed, then tell the creator task which
+             * block was received.  The creator task frees the block. */
+            pxBlock = ( PoolMessage_t * ) pvPoolAlloc( xWaiterPool, portMAX_DELAY );
+
+            if( pxBlock == NULL )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            pxWaiterBlock = pxBlock;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCreateAndDeleteStaticallyAllocatedPool( void )
+    {
+        PoolHandle_t xPool;
+
+        /* The storage area is an array of PoolMessage_t structures, so each
+         * block must be exactly one structure. */
+        configASSERT( poolBLOCK_SIZE( sizeof( PoolMessage_t ) ) == sizeof( PoolMessage_t ) );
+
+        /* Create the pool.  Pools can only be created from statically allocated
+         * memory.  The storage area holds the blocks, and the StaticPool_t
+         * structure holds the state of the pool in an anonymous way. */
+        xPool = xPoolCreateStatic( sizeof( PoolMessage_t ),          /* The size of each block. */
+                                   poolNUMBER_OF_BLOCKS,             /* The number of blocks in the pool. */
+                                   ( uint8_t * ) xPoolStorage,       /* The buffer that holds the blocks. */
+                                   &xStaticPool );                   /* The static pool structure that will hold the state of the pool. */
+
+        /* The pool handle should equal the static pool structure passed into
+         * the xPoolCreateStatic() function. */
+        configASSERT( xPool == ( PoolHandle_t ) &xStaticPool );
+
+        /* Ensure the pool passes a few sanity checks as a valid pool. */
+        prvSanityCheckCreatedPool( xPool );
+
+        /* Delete the pool again so the buffers can be reused. */
+        vPoolDelete( xPool );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSanityCheckCreatedPool( PoolHandle_t xPool )
+    {
+        PoolMessage_t * pxBlocks[ poolNUMBER_OF_BLOCKS ];
+        UBaseType_t uxBlock, x;
+        TickType_t xTimeBefore, xTimeAfter;
+
+        /* Every block should be free. */
+        if( uxPoolGetBlocksAvailable( xPool ) != poolNUMBER_OF_BLOCKS )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+
+        prvAllocateAllBlocks( xPool, pxBlocks );
+
+        /* Fill every block, so any overlap between the blocks is detected
+         * below. */
+        for( uxBlock = 0; uxBlock < poolNUMBER_OF_BLOCKS; uxBlock++ )
+        {
+            pxBlocks[ uxBlock ]->ullSequenceNumber = ( uint64_t ) uxBlock;
+
+            for( x = 0; x < ( sizeof( pxBlocks[ uxBlock ]->ulPayload ) / sizeof( uint32_t ) ); x++ )
+            {
+                pxBlocks[ uxBlock ]->ulPayload[ x ] = poolFILL_VALUE ^ ( uint32_t ) uxBlock;
+            }
+        }
+
+        /* There are no free blocks left, so further allocations must fail,
+         * whether or not a block time is used. */
+        if( pvPoolAlloc( xPool, poolDONT_BLOCK ) != NULL )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+
+        if( pvPoolAllocFromISR( xPool ) != NULL )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+
+        xTimeBefore = xTaskGetTickCount();
+
+        if( pvPoolAlloc( xPool, poolSHORT_BLOCK_TIME ) != NULL )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+
+        xTimeAfter = xTaskGetTickCount();
+
+        /* The allocation must not have given up before the block time expired.
+         * A pool times out through the same event list mechanism as a queue, so
+         * how long after that the task runs again depends only on the other
+         * tasks in the system, and, as in StaticAllocation.c, is not checked. */
+        if( ( TickType_t ) ( xTimeAfter - xTimeBefore ) < poolSHORT_BLOCK_TIME )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+
+        /* Check the contents of each block, and free the blocks again using
+         * both the task and interrupt API functions. */
+        for( uxBlock = 0; uxBlock < poolNUMBER_OF_BLOCKS; uxBlock++ )
+        {
+            if( pxBlocks[ uxBlock ]->ullSequenceNumber != ( uint64_t ) uxBlock )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            for( x = 0; x < ( sizeof( pxBlocks[ uxBlock ]->ulPayload ) / sizeof( uint32_t ) ); x++ )
+            {
+                if( pxBlocks[ uxBlock ]->ulPayload[ x ] != ( poolFILL_VALUE ^ ( uint32_t ) uxBlock ) )
+                {
+                    xErrorOccurred = pdTRUE;
+                }
+            }
+
+            if( ( uxBlock & ( UBaseType_t ) 1 ) == ( UBaseType_t ) 0 )
+            {
+                vPoolFree( xPool, pxBlocks[ uxBlock ] );
+            }
+            else
+            {
+                vPoolFreeFromISR( xPool, pxBlocks[ uxBlock ], NULL );
+            }
+        }
+
+        if( uxPoolGetBlocksAvailable( xPool ) != poolNUMBER_OF_BLOCKS )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTestBlockingOnPool( void )
+    {
+        PoolMessage_t * pxBlocks[ poolNUMBER_OF_BLOCKS ];
+        PoolHandle_t xPool;
+        BaseType_t xHigherPriorityTaskWoken;
+        UBaseType_t uxBlock;
+
+        xPool = xPoolCreateStatic( sizeof( PoolMessage_t ), poolNUMBER_OF_BLOCKS, ( uint8_t * ) xPoolStorage, &xStaticPool );
+        configASSERT( xPool );
+        prvAllocateAllBlocks( xPool, pxBlocks );
+
+        /* Tell the higher priority waiter task to allocate from the pool.  It
+         * runs straight away, finds there are no free blocks, so blocks. */
+        xWaiterPool = xPool;
+        pxWaiterBlock = NULL;
+        xTaskNotifyGive( xWaiterTask );
+
+        if( ( eTaskGetState( xWaiterTask ) != eBlocked ) || ( pxWaiterBlock != NULL ) )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+
+        /* Freeing a block must unblock the waiter task, which has a higher
+         * priority so runs before vPoolFree() returns, and must be given the
+         * block that was freed. */
+        vPoolFree( xPool, pxBlocks[ 0 ] );
+
+        if( pxWaiterBlock != pxBlocks[ 0 ] )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+
+        if( uxPoolGetBlocksAvailable( xPool ) != 0 )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+
+        /* Do the same again, but free the block using the interrupt API.  This
+         * time the waiter task does not run until this task yields. */
+        pxWaiterBlock = NULL;
+        xTaskNotifyGive( xWaiterTask );
+        xHigherPriorityTaskWoken = pdFALSE;
+
+        taskENTER_CRITICAL();
+        {
+            vPoolFreeFromISR( xPool, pxBlocks[ 1 ], &xHigherPriorityTaskWoken );
+        }
+        taskEXIT_CRITICAL();
+
+        if( xHigherPriorityTaskWoken != pdTRUE )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+
+        taskYIELD();
+
+        if( pxWaiterBlock != pxBlocks[ 1 ] )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+
+        /* The waiter task has handed back both blocks, so free every block and
+         * delete the pool. */
+        for( uxBlock = 0; uxBlock < poolNUMBER_OF_BLOCKS; uxBlock++ )
+        {
+            vPoolFree( xPool, pxBlocks[ uxBlock ] );
+        }
+
+        if( uxPoolGetBlocksAvailable( xPool ) != poolNUMBER_OF_BLOCKS )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+
+        vPoolDelete( xPool );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvAllocateAllBlocks( PoolHandle_t xPool,
+                                      PoolMessage_t * pxBlocks[] )
+    {
+        UBaseType_t uxBlock, x;
+
+        for( uxBlock = 0; uxBlock < poolNUMBER_OF_BLOCKS; uxBlock++ )
+        {
+            if( ( uxBlock & ( UBaseType_t ) 1 ) == ( UBaseType_t ) 0 )
+            {
+                pxBlocks[ uxBlock ] = ( PoolMessage_t * ) pvPoolAlloc( xPool, poolDONT_BLOCK );
+            }
+            else
+            {
+                pxBlocks[ uxBlock ] = ( PoolMessage_t * ) pvPoolAllocFromISR( xPool );
+            }
+
+            /* The block must be one of the blocks in the storage area. */
+            if( ( pxBlocks[ uxBlock ] < &( xPoolStorage[ 0 ] ) ) || ( pxBlocks[ uxBlock ] > &( xPoolStorage[ poolNUMBER_OF_BLOCKS - 1 ] ) ) )
+            {
+                xErrorOccurred = pdTRUE;
+
+                /* Don't go on to use a block that is not valid. */
+                configASSERT( xErrorOccurred == pdFALSE );
+            }
+
+            /* The same block must not be allocated twice. */
+            for( x = 0; x < uxBlock; x++ )
+            {
+                if( pxBlocks[ x ] == pxBlocks[ uxBlock ] )
+                {
+                    xErrorOccurred = pdTRUE;
+                }
+            }
+        }
+
+        if( uxPoolGetBlocksAvailable( xPool ) != 0 )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xArePoolAllocationTasksStillRunning( void )
+    {
+        static UBaseType_t uxLastCycleCounter = 0;
+        BaseType_t xReturn;
+
+        if( uxCycleCounter == uxLastCycleCounter )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+        else
+        {
+            uxLastCycleCounter = uxCycleCounter;
+        }
+
+        if( xErrorOccurred != pdFALSE )
+        {
+            xReturn = pdFAIL;
+        }
+        else
+        {
+            xReturn = pdPASS;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/* Exclude the entire file if configSUPPORT_STATIC_ALLOCATION is 0. */
+#endif /* configSUPPORT_STATIC_ALLOCATION == 1 */
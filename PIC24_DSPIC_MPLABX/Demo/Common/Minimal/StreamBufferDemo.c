@@ -35,6 +35,7 @@
 
 /* Demo app includes. */
 #include "StreamBufferDemo.h"
+#include "ThroughputMonitor.h"
 
 /* The number of bytes of storage in the stream buffers used in this test. */
 #define sbSTREAM_BUFFER_LENGTH_BYTES    ( ( size_t ) 30 )
@@ -87,6 +88,13 @@
  */
 static void prvSingleTaskTests( StreamBufferHandle_t xStreamBuffer );
 
+/*
+ * Tests the zero copy functions on an empty stream buffer - reserving and
+ * committing across the end of the storage area, abandoning a reservation,
+ * and peeking and consuming across the end of the storage area.
+ */
+static void prvZeroCopyTests( StreamBufferHandle_t xStreamBuffer );
+
 /*
  * Tests sending and receiving various lengths of data via a stream buffer.
  * The echo client sends the data to the echo server, which then sends the
@@ -112,6 +120,9 @@ static void prvCheckExpectedState( BaseType_t xState );
  * A task that creates a stream buffer with a specific trigger level, then
  * receives a string from an interrupt (the RTOS tick hook) byte by byte to
  * check it is only unblocked when the specified trigger level is reached.
+ * Alternate runs write the bytes in place with xStreamBufferReserve() and
+ * xStreamBufferCommitFromISR(), which must honour the trigger level in the same
+ * way.
  */
 static void prvInterruptTriggerLevelTest( void * pvParameters );
 
@@ -145,6 +156,10 @@ typedef struct ECHO_STREAM_BUFFERS
 } EchoStreamBuffers_t;
 static volatile uint32_t ulEchoLoopCounters[ sbNUMBER_OF_ECHO_CLIENTS ] = { 0 };
 
+/* The number of bytes each echo client has had echoed back to it, for
+ * throughput reporting.  Each element is only written by one client task. */
+static volatile uint32_t ulEchoBytesReceived[ sbNUMBER_OF_ECHO_CLIENTS ] = { 0 };
+
 /* The non-blocking tasks monitor their operation, and if no errors have been
  * found, increment ulNonBlockingRxCounter.  xAreStreamBufferTasksStillRunning()
  * then checks ulNonBlockingRxCounter and only returns pdPASS if
@@ -162,6 +177,10 @@ static volatile uint32_t ulInterruptTriggerCounter = 0UL;
  * in between test runs. */
 static volatile StreamBufferHandle_t xInterruptStreamBuffer = NULL;
 
+/* Set to pdTRUE when the tick interrupt should write to xInterruptStreamBuffer
+ * using the zero copy functions rather than xStreamBufferSendFromISR(). */
+static volatile BaseType_t xInterruptUsesZeroCopy = pdFALSE;
+
 /* The data sent from the tick interrupt to the task that tests the trigger
  * level functionality. */
 static const char * pcDataSentFromInterrupt = "0123456789";
@@ -573,6 +592,108 @@ static void prvSingleTaskTests( StreamBufferHandle_t xStreamBuffer )
 }
 /*-----------------------------------------------------------*/
 
+static void prvZeroCopyTests( StreamBufferHandle_t xStreamBuffer )
+{
+    size_t xReturned;
+    uint8_t * pucReserved, * pucWrapped, * pucPeeked;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    /* The storage area is one byte longer than sbSTREAM_BUFFER_LENGTH_BYTES, so
+     * once 20 bytes have passed through the buffer there are 11 bytes between
+     * the head and the end of the storage area. */
+    const size_t xBytesToMove = 20, xBytesBeforeWrap = ( sbSTREAM_BUFFER_LENGTH_BYTES + 1 ) - xBytesToMove;
+    const size_t x4ByteLength = 4, x5ByteLength = 5, x17ByteLength = 17;
+
+    /* Move the head and tail towards the end of the storage area.  The bytes
+     * do not need to be read, so are discarded without being copied out. */
+    xReturned = xStreamBufferSend( xStreamBuffer, ( const void * ) pc55ByteString, xBytesToMove, sbDONT_BLOCK );
+    prvCheckExpectedState( xReturned == xBytesToMove );
+    xReturned = xStreamBufferConsume( xStreamBuffer, xBytesToMove );
+    prvCheckExpectedState( xReturned == xBytesToMove );
+    prvCheckExpectedState( xStreamBufferIsEmpty( xStreamBuffer ) == pdTRUE );
+
+    /* Reserve 17 bytes.  Only the bytes before the end of the storage area can
+     * be handed out in one block. */
+    xReturned = xStreamBufferReserve( xStreamBuffer, ( void ** ) &pucReserved, x17ByteLength, sbDONT_BLOCK );
+    prvCheckExpectedState( xReturned == xBytesBeforeWrap );
+    memcpy( ( void * ) pucReserved, ( const void * ) pc54ByteString, xBytesBeforeWrap );
+
+    /* Nothing is visible to the reader until the reservation is committed. */
+    prvCheckExpectedState( xStreamBufferBytesAvailable( xStreamBuffer ) == ( size_t ) 0 );
+    xReturned = xStreamBufferCommit( xStreamBuffer, xBytesBeforeWrap );
+    prvCheckExpectedState( xReturned == xBytesBeforeWrap );
+    prvCheckExpectedState( xStreamBufferBytesAvailable( xStreamBuffer ) == xBytesBeforeWrap );
+
+    /* Reserving again obtains the rest of the 17 bytes from the start of the
+     * storage area.  The 'FromISR' version of commit is used to give it some
+     * exercise, so must be called from a critical section for ports that don't
+     * support interrupt nesting. */
+    xReturned = xStreamBufferReserve( xStreamBuffer, ( void ** ) &pucWrapped, x17ByteLength - xBytesBeforeWrap, sbDONT_BLOCK );
+    prvCheckExpectedState( xReturned == ( x17ByteLength - xBytesBeforeWrap ) );
+    prvCheckExpectedState( ( pucWrapped + xBytesToMove ) == pucReserved );
+    memcpy( ( void * ) pucWrapped, ( const void * ) &( pc54ByteString[ xBytesBeforeWrap ] ), x17ByteLength - xBytesBeforeWrap );
+
+    taskENTER_CRITICAL();
+    {
+        xReturned = xStreamBufferCommitFromISR( xStreamBuffer, x17ByteLength - xBytesBeforeWrap, &xHigherPriorityTaskWoken );
+    }
+    taskEXIT_CRITICAL();
+    prvCheckExpectedState( xReturned == ( x17ByteLength - xBytesBeforeWrap ) );
+    prvCheckExpectedState( xStreamBufferBytesAvailable( xStreamBuffer ) == x17ByteLength );
+
+    /* No task is blocked on the buffer, so none can have been woken. */
+    prvCheckExpectedState( xHigherPriorityTaskWoken == pdFALSE );
+
+    /* Committing zero bytes abandons a reservation, so the same space is handed
+     * out again by the next reservation and nothing reaches the reader. */
+    xReturned = xStreamBufferReserve( xStreamBuffer, ( void ** ) &pucReserved, x5ByteLength, sbDONT_BLOCK );
+    prvCheckExpectedState( xReturned == x5ByteLength );
+    memset( ( void * ) pucReserved, 0x00, x5ByteLength );
+    prvCheckExpectedState( xStreamBufferCommit( xStreamBuffer, 0 ) == ( size_t ) 0 );
+    prvCheckExpectedState( xStreamBufferBytesAvailable( xStreamBuffer ) == x17ByteLength );
+    xReturned = xStreamBufferReserve( xStreamBuffer, ( void ** ) &pucPeeked, x5ByteLength, sbDONT_BLOCK );
+    prvCheckExpectedState( xReturned == x5ByteLength );
+    prvCheckExpectedState( pucPeeked == pucReserved );
+    prvCheckExpectedState( xStreamBufferCommit( xStreamBuffer, 0 ) == ( size_t ) 0 );
+
+    /* Peek the 17 bytes back out in place.  Again only the bytes before the end
+     * of the storage area are handed out in one block.  Consume part of them to
+     * check the next peek starts where the last consume finished. */
+    xReturned = xStreamBufferPeekContiguous( xStreamBuffer, ( void ** ) &pucPeeked, sbDONT_BLOCK );
+    prvCheckExpectedState( xReturned == xBytesBeforeWrap );
+    prvCheckExpectedState( memcmp( ( const void * ) pucPeeked, ( const void * ) pc54ByteString, xBytesBeforeWrap ) == 0 );
+    prvCheckExpectedState( xStreamBufferConsume( xStreamBuffer, x4ByteLength ) == x4ByteLength );
+    prvCheckExpectedState( xStreamBufferBytesAvailable( xStreamBuffer ) == ( x17ByteLength - x4ByteLength ) );
+
+    xReturned = xStreamBufferPeekContiguous( xStreamBuffer, ( void ** ) &pucPeeked, sbDONT_BLOCK );
+    prvCheckExpectedState( xReturned == ( xBytesBeforeWrap - x4ByteLength ) );
+    prvCheckExpectedState( memcmp( ( const void * ) pucPeeked, ( const void * ) &( pc54ByteString[ x4ByteLength ] ), xBytesBeforeWrap - x4ByteLength ) == 0 );
+
+    taskENTER_CRITICAL();
+    {
+        xReturned = xStreamBufferConsumeFromISR( xStreamBuffer, xBytesBeforeWrap - x4ByteLength, &xHigherPriorityTaskWoken );
+    }
+    taskEXIT_CRITICAL();
+    prvCheckExpectedState( xReturned == ( xBytesBeforeWrap - x4ByteLength ) );
+    prvCheckExpectedState( xHigherPriorityTaskWoken == pdFALSE );
+
+    /* The remaining bytes are at the start of the storage area. */
+    xReturned = xStreamBufferPeekContiguous( xStreamBuffer, ( void ** ) &pucPeeked, sbDONT_BLOCK );
+    prvCheckExpectedState( xReturned == ( x17ByteLength - xBytesBeforeWrap ) );
+    prvCheckExpectedState( pucPeeked == pucWrapped );
+    prvCheckExpectedState( memcmp( ( const void * ) pucPeeked, ( const void * ) &( pc54ByteString[ xBytesBeforeWrap ] ), x17ByteLength - xBytesBeforeWrap ) == 0 );
+    prvCheckExpectedState( xStreamBufferConsume( xStreamBuffer, x17ByteLength - xBytesBeforeWrap ) == ( x17ByteLength - xBytesBeforeWrap ) );
+
+    /* Nothing is left to peek. */
+    prvCheckExpectedState( xStreamBufferIsEmpty( xStreamBuffer ) == pdTRUE );
+    xReturned = xStreamBufferPeekContiguous( xStreamBuffer, ( void ** ) &pucPeeked, sbDONT_BLOCK );
+    prvCheckExpectedState( xReturned == ( size_t ) 0 );
+    prvCheckExpectedState( pucPeeked == NULL );
+
+    xStreamBufferReset( xStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
 static void prvNonBlockingSenderTask( void * pvParameters )
 {
     StreamBufferHandle_t xStreamBuffer;
@@ -724,6 +845,7 @@ static void prvNonBlockingReceiverTask( void * pvParameters )
             /* Here prvSingleTaskTests() performs various tests on a stream buffer
              * that was created statically. */
             prvSingleTaskTests( xStreamBuffer );
+            prvZeroCopyTests( xStreamBuffer );
             xTaskCreate( prvReceiverTask, "StrReceiver", sbSMALLER_STACK_SIZE, ( void * ) xStreamBuffer, sbHIGHER_PRIORITY, NULL );
         }
         else
@@ -883,6 +1005,7 @@ static void prvEchoClient( void * pvParameters )
         xStreamBufferReceive( pxStreamBuffers->xEchoServerBuffer, ( void * ) pcStringReceived, xSendLength, portMAX_DELAY );
 
         prvCheckExpectedState( strcmp( pcStringToSend, pcStringReceived ) == 0 );
+        tputCOUNTER_ADD( ulEchoBytesReceived[ uxIndex ], xSendLength );
 
         /* Maintain a count of the number of times this code executes so a
          * check task can determine if this task is still functioning as
@@ -986,6 +1109,7 @@ static void prvEchoServer( void * pvParameters )
         /* Here prvSingleTaskTests() performs various tests on a stream buffer
          * that was created dynamically. */
         prvSingleTaskTests( xStreamBuffers.xEchoClientBuffer );
+        prvZeroCopyTests( xStreamBuffers.xEchoClientBuffer );
         xTaskCreate( prvEchoClient, "EchoClient", sbSMALLER_STACK_SIZE, ( void * ) &xStreamBuffers, sbLOWER_PRIORITY, NULL );
     }
 
@@ -1009,6 +1133,7 @@ void vPeriodicStreamBufferProcessing( void )
 {
     static size_t xNextChar = 0;
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    char * pcReserved;
 
     /* Called from the tick interrupt hook.  If the global stream buffer
      * variable is not NULL then the prvInterruptTriggerTest() task expects a byte
@@ -1018,7 +1143,21 @@ void vPeriodicStreamBufferProcessing( void )
         /* One character from the pcDataSentFromInterrupt string is sent on each
          * interrupt.  The task blocked on the stream buffer should not be
          * unblocked until the defined trigger level is hit. */
-        xStreamBufferSendFromISR( xInterruptStreamBuffer, ( const void * ) &( pcDataSentFromInterrupt[ xNextChar ] ), sizeof( char ), &xHigherPriorityTaskWoken );
+        if( xInterruptUsesZeroCopy != pdFALSE )
+        {
+            /* Write the character in place.  Reserving without a block time is
+             * safe from an interrupt, and committing it wakes the task in the
+             * same way as xStreamBufferSendFromISR(). */
+            if( xStreamBufferReserve( xInterruptStreamBuffer, ( void ** ) &pcReserved, sizeof( char ), 0 ) == sizeof( char ) )
+            {
+                *pcReserved = pcDataSentFromInterrupt[ xNextChar ];
+                ( void ) xStreamBufferCommitFromISR( xInterruptStreamBuffer, sizeof( char ), &xHigherPriorityTaskWoken );
+            }
+        }
+        else
+        {
+            xStreamBufferSendFromISR( xInterruptStreamBuffer, ( const void * ) &( pcDataSentFromInterrupt[ xNextChar ] ), sizeof( char ), &xHigherPriorityTaskWoken );
+        }
 
         if( xNextChar < strlen( pcDataSentFromInterrupt ) )
         {
@@ -1036,7 +1175,7 @@ void vPeriodicStreamBufferProcessing( void )
 static void prvInterruptTriggerLevelTest( void * pvParameters )
 {
     StreamBufferHandle_t xStreamBuffer;
-    size_t xTriggerLevel = 1, xBytesReceived;
+    size_t xTriggerLevel = 1, xBytesReceived, xSingleByteReceives;
     const size_t xStreamBufferSizeBytes = ( size_t ) 9, xMaxTriggerLevel = ( size_t ) 7, xMinTriggerLevel = ( size_t ) 2;
     const TickType_t xReadBlockTime = 5, xCycleBlockTime = pdMS_TO_TICKS( 100 );
     uint8_t ucRxData[ 9 ];
@@ -1053,6 +1192,8 @@ static void prvInterruptTriggerLevelTest( void * pvParameters )
 
     for( ; ; )
     {
+        xSingleByteReceives = 0;
+
         for( xTriggerLevel = xMinTriggerLevel; xTriggerLevel < xMaxTriggerLevel; xTriggerLevel++ )
         {
             /* This test is very time sensitive so delay at the beginning to ensure
@@ -1163,6 +1304,11 @@ static void prvInterruptTriggerLevelTest( void * pvParameters )
                 }
             }
 
+            if( xBytesReceived == ( size_t ) 1 )
+            {
+                xSingleByteReceives++;
+            }
+
             if( xBytesReceived > sizeof( ucRxData ) )
             {
                 xErrorDetected = pdTRUE;
@@ -1183,6 +1329,26 @@ static void prvInterruptTriggerLevelTest( void * pvParameters )
             /* Tidy up ready for the next loop. */
             vStreamBufferDelete( xStreamBuffer );
         }
+
+        /* Receiving a single byte is allowed for above because the interrupt
+         * might write one before this task blocks, but that cannot happen for
+         * every trigger level.  If it does then the task is being unblocked
+         * before the trigger level is reached. */
+        if( xSingleByteReceives == ( xMaxTriggerLevel - xMinTriggerLevel ) )
+        {
+            xErrorDetected = pdTRUE;
+        }
+
+        /* Repeat the test writing from the interrupt the other way.  The
+         * interrupt is not using a stream buffer at this point. */
+        if( xInterruptUsesZeroCopy == pdFALSE )
+        {
+            xInterruptUsesZeroCopy = pdTRUE;
+        }
+        else
+        {
+            xInterruptUsesZeroCopy = pdFALSE;
+        }
     }
 }
 /*-----------------------------------------------------------*/
@@ -1245,3 +1411,22 @@ BaseType_t xAreStreamBufferTasksStillRunning( void )
     return xErrorStatus;
 }
 /*-----------------------------------------------------------*/
+
+uint32_t ulGetStreamBufferBytesReceived( void )
+{
+    uint32_t ulTotal = 0;
+    BaseType_t x;
+
+    /* A 32-bit read is not atomic on 16-bit ports. */
+    taskENTER_CRITICAL();
+    {
+        for( x = 0; x < sbNUMBER_OF_ECHO_CLIENTS; x++ )
+        {
+            ulTotal += ulEchoBytesReceived[ x ];
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return ulTotal;
+}
+/*-----------------------------------------------------------*/
@@ -39,6 +39,7 @@
 
 /* Demo program include files. */
 #include "TaskNotify.h"
+#include "ThroughputMonitor.h"
 
 /* Allow parameters to be overridden on a demo by demo basis. */
 #ifndef notifyNOTIFIED_TASK_STACK_SIZE
@@ -187,7 +188,7 @@ static void prvSingleTaskTests( void )
     ( void ) ulNotifiedValue;
 
     /* Incremented to show the task is still running. */
-    ulNotifyCycleCount++;
+    tputCOUNTER_ADD( ulNotifyCycleCount, 1 );
 
 
 
@@ -429,7 +430,7 @@ static void prvSingleTaskTests( void )
     configASSERT( xSingleTaskTimer );
 
     /* Incremented to show the task is still running. */
-    ulNotifyCycleCount++;
+    tputCOUNTER_ADD( ulNotifyCycleCount, 1 );
 
     /* Ensure no notifications are pending. */
     xTaskNotifyWait( notifyUINT32_MAX, 0, NULL, 0 );
@@ -452,7 +453,7 @@ static void prvSingleTaskTests( void )
     ( void ) xReturned; /* In case configASSERT() is not defined. */
 
     /* Incremented to show the task is still running. */
-    ulNotifyCycleCount++;
+    tputCOUNTER_ADD( ulNotifyCycleCount, 1 );
 
     /* Start the timer that will try notifying this task while it is
      * suspended, then wait for a notification.  The second time the callback
@@ -472,7 +473,7 @@ static void prvSingleTaskTests( void )
     xTimerDelete( xSingleTaskTimer, portMAX_DELAY );
 
     /* Incremented to show the task is still running. */
-    ulNotifyCycleCount++;
+    tputCOUNTER_ADD( ulNotifyCycleCount, 1 );
 
     /* Leave all bits cleared. */
     xTaskNotifyWait( notifyUINT32_MAX, 0, NULL, 0 );
@@ -618,7 +619,7 @@ static void prvNotifiedTask( void * pvParameters )
         }
 
         /* Incremented to show the task is still running. */
-        ulNotifyCycleCount++;
+        tputCOUNTER_ADD( ulNotifyCycleCount, 1 );
     }
 }
 /*-----------------------------------------------------------*/
@@ -718,3 +719,18 @@ static UBaseType_t prvRand( void )
     return( ( uxNextRand >> 16 ) & ( ( size_t ) 0x7fff ) );
 }
 /*-----------------------------------------------------------*/
+
+uint32_t ulGetTaskNotifyCycles( void )
+{
+    uint32_t ulCount;
+
+    /* A 32-bit read is not atomic on 16-bit ports. */
+    taskENTER_CRITICAL();
+    {
+        ulCount = ulNotifyCycleCount;
+    }
+    taskEXIT_CRITICAL();
+
+    return ulCount;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,217 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Turns the free running operation counters kept by the standard demo tasks
+ * (items moved through the blocking queues, semaphore takes, bytes echoed
+ * through the stream buffers, and so on) into operations per second, so a
+ * stress run shows how fast the kernel is going as well as whether it is still
+ * going.
+ *
+ * Each counter is registered with xThroughputMonitorAdd(), normally before the
+ * scheduler is started.  The check task then calls uxThroughputMonitorUpdate()
+ * once per check period.  The first period after the first update is treated
+ * as a warm up and only seeds the baseline, which is then a moving average of
+ * the later rates, each new rate having a weight of
+ * 1 / ( 1 << tputBASELINE_SHIFT ).  A rate that falls more than
+ * configTHROUGHPUT_DROP_PERCENT below the baseline is flagged as a drop, and is
+ * left out of the baseline so that a collapse does not become the new normal.
+ * uxThroughputMonitorUpdate() returns the number of counters that dropped in
+ * the period just ended.
+ *
+ * vThroughputMonitorPrint() prints one line per counter with
+ * configTHROUGHPUT_PRINTF(), which defaults to printf().  Whether a drop is an
+ * error is left to the caller, as rates on a host or a shared simulator are
+ * not always repeatable.
+ *
+ * The functions other than xThroughputMonitorAdd() must only be called from
+ * one task.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo program include files. */
+#include "ThroughputMonitor.h"
+
+/* The maximum number of counters that can be registered. */
+#ifndef configTHROUGHPUT_MAX_COUNTERS
+    #define configTHROUGHPUT_MAX_COUNTERS    ( 16 )
+#endif
+
+/* How far below the baseline, in percent, a rate has to fall to count as a
+ * drop. */
+#ifndef configTHROUGHPUT_DROP_PERCENT
+    #define configTHROUGHPUT_DROP_PERCENT    ( 50 )
+#endif
+
+/* The rates are always printed when asked for, so this does not default to
+ * configPRINTF(), which the kernel defines away to nothing when it is not
+ * set. */
+#ifndef configTHROUGHPUT_PRINTF
+    #include <stdio.h>
+    #define configTHROUGHPUT_PRINTF( X )    printf X
+#endif
+
+/* The weight of each new rate in the baseline is 1 / ( 1 << this ). */
+#define tputBASELINE_SHIFT                  ( 3 )
+
+/*-----------------------------------------------------------*/
+
+typedef struct THROUGHPUT_COUNTER
+{
+    const char * pcName;
+    const char * pcUnit;
+    ThroughputCounter_t pxGetCount;
+    uint32_t ulLastCount; /* The count at the end of the last period. */
+    uint32_t ulRate;      /* Operations per second during the last period. */
+    uint32_t ulBaseline;  /* Moving average of the rates that were not drops. */
+    uint32_t ulDrops;     /* The number of periods that were drops. */
+    BaseType_t xDropped;  /* pdTRUE if the last period was a drop. */
+} ThroughputCounterInfo_t;
+
+static ThroughputCounterInfo_t xCounters[ configTHROUGHPUT_MAX_COUNTERS ];
+static UBaseType_t uxNumCounters = 0;
+
+/* The number of updates so far, saturating at 2 as only the first two are
+ * special. */
+static UBaseType_t uxUpdates = 0;
+static TickType_t xLastUpdateTime = 0;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xThroughputMonitorAdd( const char * pcName,
+                                  const char * pcUnit,
+                                  ThroughputCounter_t pxGetCount )
+{
+    BaseType_t xReturn = pdFAIL;
+
+    configASSERT( pxGetCount );
+
+    taskENTER_CRITICAL();
+    {
+        if( uxNumCounters < configTHROUGHPUT_MAX_COUNTERS )
+        {
+            xCounters[ uxNumCounters ].pcName = pcName;
+            xCounters[ uxNumCounters ].pcUnit = pcUnit;
+            xCounters[ uxNumCounters ].pxGetCount = pxGetCount;
+            xCounters[ uxNumCounters ].ulLastCount = 0;
+            xCounters[ uxNumCounters ].ulRate = 0;
+            xCounters[ uxNumCounters ].ulBaseline = 0;
+            xCounters[ uxNumCounters ].ulDrops = 0;
+            xCounters[ uxNumCounters ].xDropped = pdFALSE;
+            uxNumCounters++;
+            xReturn = pdPASS;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxThroughputMonitorUpdate( void )
+{
+    TickType_t xNow, xElapsed;
+    UBaseType_t ux, uxDropped = 0;
+    ThroughputCounterInfo_t * pxCounter;
+    uint32_t ulCount, ulThreshold;
+
+    xNow = xTaskGetTickCount();
+    xElapsed = xNow - xLastUpdateTime;
+    xLastUpdateTime = xNow;
+
+    for( ux = 0; ux < uxNumCounters; ux++ )
+    {
+        pxCounter = &( xCounters[ ux ] );
+        ulCount = pxCounter->pxGetCount();
+
+        /* The first update only records where the counters start from. */
+        if( ( uxUpdates > 0 ) && ( xElapsed > 0 ) )
+        {
+            /* Unsigned subtraction copes with the counter wrapping. */
+            pxCounter->ulRate = ( uint32_t ) ( ( ( uint64_t ) ( uint32_t ) ( ulCount - pxCounter->ulLastCount ) * configTICK_RATE_HZ ) / xElapsed );
+            pxCounter->xDropped = pdFALSE;
+
+            if( uxUpdates == 1 )
+            {
+                /* End of the warm up period. */
+                pxCounter->ulBaseline = pxCounter->ulRate;
+            }
+            else
+            {
+                ulThreshold = ( uint32_t ) ( ( ( uint64_t ) pxCounter->ulBaseline * ( 100 - configTHROUGHPUT_DROP_PERCENT ) ) / 100 );
+
+                if( pxCounter->ulRate < ulThreshold )
+                {
+                    pxCounter->xDropped = pdTRUE;
+                    pxCounter->ulDrops++;
+                    uxDropped++;
+                }
+                else
+                {
+                    pxCounter->ulBaseline = ( uint32_t ) ( ( ( ( uint64_t ) pxCounter->ulBaseline << tputBASELINE_SHIFT ) - pxCounter->ulBaseline + pxCounter->ulRate ) >> tputBASELINE_SHIFT );
+                }
+            }
+        }
+
+        pxCounter->ulLastCount = ulCount;
+    }
+
+    if( uxUpdates < 2 )
+    {
+        uxUpdates++;
+    }
+
+    return uxDropped;
+}
+/*-----------------------------------------------------------*/
+
+void vThroughputMonitorPrint( void )
+{
+    UBaseType_t ux;
+    ThroughputCounterInfo_t * pxCounter;
+
+    /* Nothing to print until a full period has been measured. */
+    if( uxUpdates < 2 )
+    {
+        return;
+    }
+
+    for( ux = 0; ux < uxNumCounters; ux++ )
+    {
+        pxCounter = &( xCounters[ ux ] );
+        configTHROUGHPUT_PRINTF( ( "    %-18s %10lu %s/s, baseline %lu, drops %lu%s\r\n",
+                                   pxCounter->pcName,
+                                   ( unsigned long ) pxCounter->ulRate,
+                                   pxCounter->pcUnit,
+                                   ( unsigned long ) pxCounter->ulBaseline,
+                                   ( unsigned long ) pxCounter->ulDrops,
+                                   ( pxCounter->xDropped != pdFALSE ) ? " <- DROP" : "" ) );
+    }
+}
+/*-----------------------------------------------------------*/
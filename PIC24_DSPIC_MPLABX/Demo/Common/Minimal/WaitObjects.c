@@ -0,0 +1,497 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Demonstrates and tests xWaitForMultipleObjects().  A receiving task blocks on
+ * two queues, a semaphore, a stream buffer and one of its own task
+ * notifications at once.  A lower priority sending task writes to each object
+ * in turn and checks the receiving task unblocks and reads from the object
+ * that was written to before the send function returns.  It also writes to
+ * two objects with the scheduler suspended to check the object with the
+ * lowest position in the array is reported first, and checks that
+ * xWaitForMultipleObjects() times out when no object becomes ready.  One of
+ * the queues is only written to from the tick hook, so the interrupt safe API
+ * functions are also tested.  Each time the receiving task reads from that
+ * queue it also writes to, then reads back from, the object the sending task
+ * waits on when checking the timeout, so the sending task is repeatedly
+ * unblocked without finding anything to read and must keep waiting for what
+ * is left of its original block time.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "wait_objects.h"
+
+/* Demo program include files. */
+#include "WaitObjects.h"
+
+/* Exclude the entire file if configUSE_WAIT_OBJECTS is 0. */
+#if ( configUSE_WAIT_OBJECTS == 1 )
+
+/* The priorities of the tasks created by this file.  The receiving task has the
+ * higher priority so it runs as soon as an object it is waiting for becomes
+ * ready. */
+    #define waitSENDER_TASK_PRIORITY       ( tskIDLE_PRIORITY + 1 )
+    #define waitRECEIVER_TASK_PRIORITY     ( tskIDLE_PRIORITY + 2 )
+
+/* The position of each object in the array the receiving task waits on. */
+    #define waitTASK_QUEUE_INDEX           ( 0 )
+    #define waitISR_QUEUE_INDEX            ( 1 )
+    #define waitSEMAPHORE_INDEX            ( 2 )
+    #define waitSTREAM_BUFFER_INDEX        ( 3 )
+    #define waitNOTIFICATION_INDEX         ( 4 )
+    #define waitNUMBER_OF_OBJECTS          ( 5 )
+
+/* The notification index of the receiving task that is waited for. */
+    #define waitNOTIFICATION_ARRAY_INDEX   ( 0 )
+
+/* The length of the queues and the size of the stream buffer. */
+    #define waitQUEUE_LENGTH               ( 5 )
+    #define waitSTREAM_BUFFER_SIZE         ( sizeof( uint32_t ) * 5 )
+
+/* The number of ticks between each value sent to the queue that is only
+ * written to from the tick hook. */
+    #define waitISR_SEND_PERIOD            ( ( TickType_t ) 10 )
+
+/* The receiving task should never time out, as the tick hook writes to one of
+ * the objects it waits for every waitISR_SEND_PERIOD ticks. */
+    #define waitRECEIVER_BLOCK_TIME        ( waitISR_SEND_PERIOD * ( TickType_t ) 20 )
+
+/* The time the sending task waits for an object that never holds any data.
+ * The object is written to and read back every waitISR_SEND_PERIOD ticks, so
+ * the sending task is unblocked several times before the block time expires.
+ * A timeout that restarted each time the task was unblocked would never
+ * expire, which stops the sending task cycling, so only a timeout that
+ * expires early is checked for directly. */
+    #define waitSHORT_BLOCK_TIME           ( waitISR_SEND_PERIOD * ( TickType_t ) 3 )
+
+/* The size of the stack used by the tasks in this file. */
+    #define waitTASK_STACK_SIZE            ( configMINIMAL_STACK_SIZE * 2 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task that blocks on all the objects, and reads from whichever object is
+ * ready.
+ */
+    static void prvWaitObjectsReceiver( void * pvParameters );
+
+/*
+ * The task that writes to each object in turn, and checks the receiving task
+ * reads from it.
+ */
+    static void prvWaitObjectsSender( void * pvParameters );
+
+/*
+ * Reads from the object at position xIndex in xObjects[], checks the value
+ * read is the value expected, and counts the number of times each object was
+ * reported as ready.
+ */
+    static void prvReadFromObject( BaseType_t xIndex );
+
+/*
+ * Writes to the object at position xIndex in xObjects[] from the sending
+ * task.
+ */
+    static void prvWriteToObject( BaseType_t xIndex );
+
+/*-----------------------------------------------------------*/
+
+/* The objects waited for by the receiving task. */
+    static QueueHandle_t xTaskQueue = NULL, xISRQueue = NULL;
+    static SemaphoreHandle_t xSemaphore = NULL;
+    static StreamBufferHandle_t xStreamBuffer = NULL;
+    static WaitObject_t xObjects[ waitNUMBER_OF_OBJECTS ];
+
+/* The queue the sending task waits on to check the timeout.  Anything written
+ * to it is read back before the sending task can run. */
+    static QueueHandle_t xEmptyQueue = NULL;
+
+/* The handle of the receiving task, which the sending task notifies. */
+    static TaskHandle_t xReceiverTask = NULL;
+
+/* The number of times the receiving task has read from each object. */
+    static volatile uint32_t ulReadCount[ waitNUMBER_OF_OBJECTS ] = { 0 };
+
+/* The position of the last object read that is written to by the sending
+ * task, rather than by the tick hook. */
+    static volatile BaseType_t xLastTaskObjectRead = waitOBJECTS_TIMEOUT;
+
+/* The next value the sending task and the tick hook write, and the next value
+ * the receiving task expects to read from each. */
+    static uint32_t ulNextTaskValueToSend = 0, ulNextTaskValueExpected = 0;
+    static uint32_t ulNextISRValueToSend = 0, ulNextISRValueExpected = 0;
+
+/* Used so a check task can ensure this test is still executing, and not
+ * stalled. */
+    static volatile UBaseType_t uxCycleCounter = 0;
+
+/* A variable that gets set to pdTRUE if an error is detected. */
+    static volatile BaseType_t xErrorOccurred = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+    void vStartWaitObjectTasks( void )
+    {
+        xTaskQueue = xQueueCreate( waitQUEUE_LENGTH, sizeof( uint32_t ) );
+        xISRQueue = xQueueCreate( waitQUEUE_LENGTH, sizeof( uint32_t ) );
+        xSemaphore = xSemaphoreCreateBinary();
+        xEmptyQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+
+        /* A trigger level of 1 means the receiving task is unblocked as soon as
+         * any data is written to the stream buffer. */
+        xStreamBuffer = xStreamBufferCreate( waitSTREAM_BUFFER_SIZE, 1 );
+
+        configASSERT( xTaskQueue );
+        configASSERT( xISRQueue );
+        configASSERT( xSemaphore );
+        configASSERT( xEmptyQueue );
+        configASSERT( xStreamBuffer );
+
+        /* Build the array of objects the receiving task waits for.  The
+         * notification is one of the receiving task's own notifications, so
+         * no handle is needed. */
+        xObjects[ waitTASK_QUEUE_INDEX ].eType = eWaitObjectQueue;
+        xObjects[ waitTASK_QUEUE_INDEX ].pvObject = ( void * ) xTaskQueue;
+        xObjects[ waitISR_QUEUE_INDEX ].eType = eWaitObjectQueue;
+        xObjects[ waitISR_QUEUE_INDEX ].pvObject = ( void * ) xISRQueue;
+        xObjects[ waitSEMAPHORE_INDEX ].eType = eWaitObjectQueue;
+        xObjects[ waitSEMAPHORE_INDEX ].pvObject = ( void * ) xSemaphore;
+        xObjects[ waitSTREAM_BUFFER_INDEX ].eType = eWaitObjectStreamBuffer;
+        xObjects[ waitSTREAM_BUFFER_INDEX ].pvObject = ( void * ) xStreamBuffer;
+        xObjects[ waitNOTIFICATION_INDEX ].eType = eWaitObjectNotification;
+        xObjects[ waitNOTIFICATION_INDEX ].pvObject = NULL;
+        xObjects[ waitNOTIFICATION_INDEX ].uxIndex = waitNOTIFICATION_ARRAY_INDEX;
+
+        /* Create the receiving task first, so its handle is available to the
+         * sending task. */
+        xTaskCreate( prvWaitObjectsReceiver, "WaitRx", waitTASK_STACK_SIZE, NULL, waitRECEIVER_TASK_PRIORITY, &xReceiverTask );
+        xTaskCreate( prvWaitObjectsSender, "WaitTx", waitTASK_STACK_SIZE, NULL, waitSENDER_TASK_PRIORITY, NULL );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWaitObjectsReceiver( void * pvParameters )
+    {
+        BaseType_t xIndex;
+
+        /* Avoid compiler warnings. */
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            xIndex = xWaitForMultipleObjects( xObjects, waitNUMBER_OF_OBJECTS, waitRECEIVER_BLOCK_TIME );
+
+            if( ( xIndex < 0 ) || ( xIndex >= waitNUMBER_OF_OBJECTS ) )
+            {
+                /* Either the call timed out, which it should not, or the index
+                 * returned is not valid. */
+                xErrorOccurred = pdTRUE;
+            }
+            else
+            {
+                prvReadFromObject( xIndex );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvReadFromObject( BaseType_t xIndex )
+    {
+        uint32_t ulReceived = 0;
+        BaseType_t xRead = pdFAIL;
+
+        /* The object reported as ready must be ready, so it must be possible to
+         * read from it without blocking. */
+        switch( xIndex )
+        {
+            case waitTASK_QUEUE_INDEX:
+                xRead = xQueueReceive( xTaskQueue, &ulReceived, 0 );
+
+                if( ulReceived != ulNextTaskValueExpected )
+                {
+                    xErrorOccurred = pdTRUE;
+                }
+
+                ulNextTaskValueExpected++;
+                break;
+
+            case waitISR_QUEUE_INDEX:
+                xRead = xQueueReceive( xISRQueue, &ulReceived, 0 );
+
+                if( ulReceived != ulNextISRValueExpected )
+                {
+                    xErrorOccurred = pdTRUE;
+                }
+
+                ulNextISRValueExpected++;
+
+                /* Unblock the sending task if it is waiting on xEmptyQueue,
+                 * but empty the queue again before the lower priority sending
+                 * task gets a chance to run. */
+                if( ( xQueueSend( xEmptyQueue, &ulReceived, 0 ) != pdPASS ) ||
+                    ( xQueueReceive( xEmptyQueue, &ulReceived, 0 ) != pdPASS ) )
+                {
+                    xErrorOccurred = pdTRUE;
+                }
+
+                break;
+
+            case waitSEMAPHORE_INDEX:
+                xRead = xSemaphoreTake( xSemaphore, 0 );
+                break;
+
+            case waitSTREAM_BUFFER_INDEX:
+
+                if( xStreamBufferReceive( xStreamBuffer, &ulReceived, sizeof( ulReceived ), 0 ) == sizeof( ulReceived ) )
+                {
+                    xRead = pdPASS;
+                }
+
+                if( ulReceived != ulNextTaskValueExpected )
+                {
+                    xErrorOccurred = pdTRUE;
+                }
+
+                ulNextTaskValueExpected++;
+                break;
+
+            case waitNOTIFICATION_INDEX:
+
+                if( ulTaskNotifyTakeIndexed( waitNOTIFICATION_ARRAY_INDEX, pdTRUE, 0 ) != 0 )
+                {
+                    xRead = pdPASS;
+                }
+
+                break;
+
+            default:
+                break;
+        }
+
+        if( xRead != pdPASS )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+
+        if( xIndex != waitISR_QUEUE_INDEX )
+        {
+            xLastTaskObjectRead = xIndex;
+        }
+
+        ulReadCount[ xIndex ]++;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWriteToObject( BaseType_t xIndex )
+    {
+        BaseType_t xWritten = pdFAIL;
+
+        switch( xIndex )
+        {
+            case waitTASK_QUEUE_INDEX:
+                xWritten = xQueueSend( xTaskQueue, &ulNextTaskValueToSend, 0 );
+                ulNextTaskValueToSend++;
+                break;
+
+            case waitSEMAPHORE_INDEX:
+                xWritten = xSemaphoreGive( xSemaphore );
+                break;
+
+            case waitSTREAM_BUFFER_INDEX:
+
+                if( xStreamBufferSend( xStreamBuffer, &ulNextTaskValueToSend, sizeof( ulNextTaskValueToSend ), 0 ) == sizeof( ulNextTaskValueToSend ) )
+                {
+                    xWritten = pdPASS;
+                }
+
+                ulNextTaskValueToSend++;
+                break;
+
+            case waitNOTIFICATION_INDEX:
+                xWritten = xTaskNotifyGiveIndexed( xReceiverTask, waitNOTIFICATION_ARRAY_INDEX );
+                break;
+
+            default:
+                break;
+        }
+
+        if( xWritten != pdPASS )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWaitObjectsSender( void * pvParameters )
+    {
+        static const BaseType_t xTaskObjects[] = { waitTASK_QUEUE_INDEX, waitSEMAPHORE_INDEX, waitSTREAM_BUFFER_INDEX, waitNOTIFICATION_INDEX };
+        WaitObject_t xEmptyObject;
+        TickType_t xTimeBefore, xTimeAfter;
+        uint32_t ulCountBefore;
+        size_t x;
+
+        /* Avoid compiler warnings. */
+        ( void ) pvParameters;
+
+        /* A queue that never holds data when this task runs, used to check
+         * the timeout. */
+        xEmptyObject.eType = eWaitObjectQueue;
+        xEmptyObject.pvObject = ( void * ) xEmptyQueue;
+        xEmptyObject.uxIndex = 0;
+
+        for( ; ; )
+        {
+            /* Write to each object in turn.  The receiving task has the higher
+             * priority, so it must have read from the object before the write
+             * returns. */
+            for( x = 0; x < ( sizeof( xTaskObjects ) / sizeof( xTaskObjects[ 0 ] ) ); x++ )
+            {
+                ulCountBefore = ulReadCount[ xTaskObjects[ x ] ];
+                prvWriteToObject( xTaskObjects[ x ] );
+
+                if( ( ulReadCount[ xTaskObjects[ x ] ] != ( ulCountBefore + 1UL ) ) ||
+                    ( xLastTaskObjectRead != xTaskObjects[ x ] ) )
+                {
+                    xErrorOccurred = pdTRUE;
+                }
+            }
+
+            /* Write to the notification and then the queue with the scheduler
+             * suspended, so both are ready when the receiving task runs.  The
+             * queue has the lower position in the array so must be read first,
+             * and the notification read last. */
+            ulCountBefore = ulReadCount[ waitTASK_QUEUE_INDEX ];
+
+            vTaskSuspendAll();
+            {
+                prvWriteToObject( waitNOTIFICATION_INDEX );
+                prvWriteToObject( waitTASK_QUEUE_INDEX );
+            }
+            ( void ) xTaskResumeAll();
+
+            if( ( ulReadCount[ waitTASK_QUEUE_INDEX ] != ( ulCountBefore + 1UL ) ) ||
+                ( xLastTaskObjectRead != waitNOTIFICATION_INDEX ) )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            /* Wait for an object that never holds data when this task runs,
+             * which must time out after the block time even though the task is
+             * unblocked a few times before then. */
+            xTimeBefore = xTaskGetTickCount();
+
+            if( xWaitForMultipleObjects( &xEmptyObject, 1, waitSHORT_BLOCK_TIME ) != waitOBJECTS_TIMEOUT )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            xTimeAfter = xTaskGetTickCount();
+
+            if( ( TickType_t ) ( xTimeAfter - xTimeBefore ) < waitSHORT_BLOCK_TIME )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            /* A block time of zero must return straight away. */
+            if( xWaitForMultipleObjects( &xEmptyObject, 1, 0 ) != waitOBJECTS_TIMEOUT )
+            {
+                xErrorOccurred = pdTRUE;
+            }
+
+            uxCycleCounter++;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vWaitObjectsAccessFromISR( void )
+    {
+        static TickType_t xCallCount = 0;
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+        /* Called from the tick hook, so xISRQueue must have been created as the
+         * scheduler is running. */
+        xCallCount++;
+
+        if( ( xCallCount % waitISR_SEND_PERIOD ) == 0 )
+        {
+            /* The queue is read each time it is written to, so it can only be
+             * full if the receiving task has stopped running. */
+            if( xQueueSendFromISR( xISRQueue, &ulNextISRValueToSend, &xHigherPriorityTaskWoken ) == pdPASS )
+            {
+                ulNextISRValueToSend++;
+            }
+
+            /* The tick hook is called from within the tick interrupt, which
+             * performs a context switch itself if one is needed. */
+            ( void ) xHigherPriorityTaskWoken;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xAreWaitObjectTasksStillRunning( void )
+    {
+        static UBaseType_t uxLastCycleCounter = 0;
+        static uint32_t ulLastISRReadCount = 0;
+        BaseType_t xReturn;
+
+        if( uxCycleCounter == uxLastCycleCounter )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+        else
+        {
+            uxLastCycleCounter = uxCycleCounter;
+        }
+
+        /* The values written from the tick hook must also be being read. */
+        if( ulReadCount[ waitISR_QUEUE_INDEX ] == ulLastISRReadCount )
+        {
+            xErrorOccurred = pdTRUE;
+        }
+        else
+        {
+            ulLastISRReadCount = ulReadCount[ waitISR_QUEUE_INDEX ];
+        }
+
+        if( xErrorOccurred != pdFALSE )
+        {
+            xReturn = pdFAIL;
+        }
+        else
+        {
+            xReturn = pdPASS;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/* Exclude the entire file if configUSE_WAIT_OBJECTS is 0. */
+#endif /* configUSE_WAIT_OBJECTS == 1 */
@@ -67,6 +67,7 @@
 
 /* Demo app include files. */
 #include "recmutex.h"
+#include "ThroughputMonitor.h"
 
 /* Priorities assigned to the three tasks.  recmuCONTROLLING_TASK_PRIORITY can
  * be overridden by a definition in FreeRTOSConfig.h. */
@@ -100,6 +101,11 @@ static SemaphoreHandle_t xMutex;
 static volatile BaseType_t xErrorOccurred = pdFALSE, xControllingIsSuspended = pdFALSE, xBlockingIsSuspended = pdFALSE;
 static volatile UBaseType_t uxControllingCycles = 0, uxBlockingCycles = 0, uxPollingCycles = 0;
 
+/* The number of times the mutex has been passed round all three tasks, for
+ * throughput reporting.  Only written by the polling task, and 32 bits wide
+ * whatever the size of UBaseType_t. */
+static volatile uint32_t ulMutexRounds = 0;
+
 /* Handles of the two higher priority tasks, required so they can be resumed
  * (unsuspended). */
 static TaskHandle_t xControllingTaskHandle, xBlockingTaskHandle;
@@ -297,6 +303,7 @@ static void prvRecursiveMutexPollingTask( void * pvParameters )
                 /* Keep count of the number of cycles this task has performed
                  * so a stall can be detected. */
                 uxPollingCycles++;
+                tputCOUNTER_ADD( ulMutexRounds, 1 );
 
                 /* We can resume the other tasks here even though they have a
                  * higher priority than the polling task.  When they execute they
@@ -409,3 +416,19 @@ BaseType_t xAreRecursiveMutexTasksStillRunning( void )
 
     return xReturn;
 }
+/*-----------------------------------------------------------*/
+
+uint32_t ulGetRecursiveMutexRounds( void )
+{
+    uint32_t ulCount;
+
+    /* A 32-bit read is not atomic on 16-bit ports. */
+    taskENTER_CRITICAL();
+    {
+        ulCount = ulMutexRounds;
+    }
+    taskEXIT_CRITICAL();
+
+    return ulCount;
+}
+/*-----------------------------------------------------------*/
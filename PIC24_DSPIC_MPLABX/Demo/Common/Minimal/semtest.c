@@ -57,6 +57,7 @@
 
 /* Demo app include files. */
 #include "semtest.h"
+#include "ThroughputMonitor.h"
 
 /* The value to which the shared variables are counted. */
 #define semtstBLOCKING_EXPECTED_VALUE        ( ( uint32_t ) 0xfff )
@@ -83,6 +84,10 @@ typedef struct SEMAPHORE_PARAMETERS
 static volatile short sCheckVariables[ semtstNUM_TASKS ] = { 0 };
 static volatile short sNextCheckVariable = 0;
 
+/* The number of times each task has obtained its semaphore, for throughput
+ * reporting.  Indexed in the same way as sCheckVariables. */
+static volatile uint32_t ulSemaphoreTakes[ semtstNUM_TASKS ] = { 0 };
+
 /*-----------------------------------------------------------*/
 
 void vStartSemaphoreTasks( UBaseType_t uxPriority )
@@ -191,6 +196,11 @@ static portTASK_FUNCTION( prvSemaphoreTest, pvParameters )
         /* Try to obtain the semaphore. */
         if( xSemaphoreTake( pxParameters->xSemaphore, pxParameters->xBlockTime ) == pdPASS )
         {
+            if( sCheckVariableToUse < semtstNUM_TASKS )
+            {
+                tputCOUNTER_ADD( ulSemaphoreTakes[ sCheckVariableToUse ], 1 );
+            }
+
             /* We have the semaphore and so expect any other tasks using the
              * shared variable to have left it in the state we expect to find
              * it. */
@@ -269,3 +279,23 @@ BaseType_t xAreSemaphoreTasksStillRunning( void )
 
     return xReturn;
 }
+/*-----------------------------------------------------------*/
+
+uint32_t ulGetSemaphoreTakes( void )
+{
+    uint32_t ulTotal = 0;
+    BaseType_t xTask;
+
+    /* A 32-bit read is not atomic on 16-bit ports. */
+    taskENTER_CRITICAL();
+    {
+        for( xTask = 0; xTask < semtstNUM_TASKS; xTask++ )
+        {
+            ulTotal += ulSemaphoreTakes[ xTask ];
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return ulTotal;
+}
+/*-----------------------------------------------------------*/
@@ -29,5 +29,6 @@
 
 void vStartBlockingQueueTasks( UBaseType_t uxPriority );
 BaseType_t xAreBlockingQueuesStillRunning( void );
+uint32_t ulGetBlockingQueueItemsReceived( void );
 
 #endif
@@ -32,4 +32,8 @@ BaseType_t xAreIntQueueTasksStillRunning( void );
 BaseType_t xFirstTimerHandler( void );
 BaseType_t xSecondTimerHandler( void );
 
+#if ( configUSE_WORK_QUEUES == 1 )
+    void vGetIntQueueWorkQueueStats( WorkQueueStats_t * pxStats );
+#endif
+
 #endif /* QUEUE_ACCESS_TEST */
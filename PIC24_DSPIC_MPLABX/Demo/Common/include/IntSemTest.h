@@ -31,4 +31,9 @@ void vStartInterruptSemaphoreTasks( void );
 BaseType_t xAreInterruptSemaphoreTasksStillRunning( void );
 void vInterruptSemaphorePeriodicTest( void );
 
+#if ( configUSE_WORK_QUEUES == 1 )
+    void vInterruptSemaphoreGetWorkQueueStats( WorkQueueStats_t * pxHighPriorityStats,
+                                               WorkQueueStats_t * pxLowPriorityStats );
+#endif
+
 #endif /* INT_SEM_TEST_H */
@@ -29,5 +29,6 @@
 
 void vStartMessageBufferTasks( configSTACK_DEPTH_TYPE xStackSize );
 BaseType_t xAreMessageBufferTasksStillRunning( void );
+uint32_t ulGetMessageBufferBytesReceived( void );
 
 #endif /* MESSAGE_BUFFER_TEST_H */
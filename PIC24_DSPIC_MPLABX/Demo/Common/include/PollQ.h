@@ -29,5 +29,6 @@
 
 void vStartPolledQueueTasks( UBaseType_t uxPriority );
 BaseType_t xArePollingQueuesStillRunning( void );
+uint32_t ulGetPollingQueueItemsReceived( void );
 
 #endif
@@ -30,5 +30,6 @@
 void vStartStreamBufferTasks( void );
 BaseType_t xAreStreamBufferTasksStillRunning( void );
 void vPeriodicStreamBufferProcessing( void );
+uint32_t ulGetStreamBufferBytesReceived( void );
 
 #endif /* STREAM_BUFFER_TEST_H */
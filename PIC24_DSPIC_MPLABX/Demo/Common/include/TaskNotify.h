@@ -29,6 +29,7 @@
 
 void vStartTaskNotifyTask( void );
 BaseType_t xAreTaskNotificationTasksStillRunning( void );
+uint32_t ulGetTaskNotifyCycles( void );
 void xNotifyTaskFromISR( void );
 
 #endif /* TASK_NOTIFY_H */
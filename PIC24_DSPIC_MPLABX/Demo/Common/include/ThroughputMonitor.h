@@ -0,0 +1,63 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef THROUGHPUT_MONITOR_H
+#define THROUGHPUT_MONITOR_H
+
+/* Returns a free running count of operations, which is allowed to wrap.  A
+ * 32-bit read is not atomic on ports where UBaseType_t is narrower than 32 bits
+ * (such as the 16-bit PIC24), so counters read the count inside a critical
+ * section. */
+typedef uint32_t ( * ThroughputCounter_t )( void );
+
+/* Adds ulAmount to a 32-bit counter from a task.  Where UBaseType_t is narrower
+ * than 32 bits the update takes more than one instruction, and a task switch
+ * part way through would let the counter be read torn, so there the update is
+ * made inside a critical section.  The test is on constant sizes, so costs
+ * nothing on 32-bit ports. */
+#define tputCOUNTER_ADD( ulCounter, ulAmount )               \
+    do {                                                     \
+        if( sizeof( UBaseType_t ) < sizeof( uint32_t ) )     \
+        {                                                    \
+            taskENTER_CRITICAL();                            \
+            {                                                \
+                ( ulCounter ) += ( uint32_t ) ( ulAmount );  \
+            }                                                \
+            taskEXIT_CRITICAL();                             \
+        }                                                    \
+        else                                                 \
+        {                                                    \
+            ( ulCounter ) += ( uint32_t ) ( ulAmount );      \
+        }                                                    \
+    } while( 0 )
+
+BaseType_t xThroughputMonitorAdd( const char * pcName,
+                                  const char * pcUnit,
+                                  ThroughputCounter_t pxGetCount );
+UBaseType_t uxThroughputMonitorUpdate( void );
+void vThroughputMonitorPrint( void );
+
+#endif /* THROUGHPUT_MONITOR_H */
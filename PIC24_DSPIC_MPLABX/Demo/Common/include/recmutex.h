@@ -29,5 +29,6 @@
 
 void vStartRecursiveMutexTasks( void );
 BaseType_t xAreRecursiveMutexTasksStillRunning( void );
+uint32_t ulGetRecursiveMutexRounds( void );
 
 #endif
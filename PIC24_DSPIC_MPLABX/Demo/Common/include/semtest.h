@@ -29,5 +29,6 @@
 
 void vStartSemaphoreTasks( UBaseType_t uxPriority );
 BaseType_t xAreSemaphoreTasksStillRunning( void );
+uint32_t ulGetSemaphoreTakes( void );
 
 #endif
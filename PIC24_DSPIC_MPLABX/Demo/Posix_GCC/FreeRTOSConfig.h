@@ -0,0 +1,115 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+ * Application specific definitions.
+ *
+ * These definitions are used by the POSIX host build of the standard demo
+ * tasks.  The kernel runs on top of the GCC_POSIX port, with each task backed
+ * by a host thread, so timing is approximate and not real time.
+ *
+ * See http://www.freertos.org/a00110.html.
+ *----------------------------------------------------------*/
+
+#define configUSE_PREEMPTION                       1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
+#define configUSE_IDLE_HOOK                        1
+#define configUSE_TICK_HOOK                        1
+#define configUSE_DAEMON_TASK_STARTUP_HOOK         0
+#define configTICK_RATE_HZ                         ( ( TickType_t ) 1000 )
+#define configMINIMAL_STACK_SIZE                   ( ( unsigned short ) 1024 )
+#define configTOTAL_HEAP_SIZE                      ( ( size_t ) ( 2 * 1024 * 1024 ) )
+#define configMAX_TASK_NAME_LEN                    ( 16 )
+#define configMAX_PRIORITIES                       ( 7 )
+#define configUSE_TRACE_FACILITY                   1
+#define configUSE_16_BIT_TICKS                     0
+#define configIDLE_SHOULD_YIELD                    1
+#define configUSE_MUTEXES                          1
+#define configUSE_RECURSIVE_MUTEXES                1
+#define configUSE_PRIORITY_CEILING_MUTEXES         1
+#define configUSE_MUTEX_CEILING_VIOLATION_HOOK     1
+#define configUSE_COUNTING_SEMAPHORES              1
+#define configUSE_QUEUE_SETS                       1
+#define configUSE_TASK_NOTIFICATIONS               1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES      3
+#define configUSE_WAIT_OBJECTS                     1
+#define configUSE_WORK_QUEUES                      1
+#define configUSE_NOTIFY_OBJECTS                   1
+#define configUSE_QUEUE_SIZED_COPY                 1
+#define configQUEUE_REGISTRY_SIZE                  20
+#define configUSE_MALLOC_FAILED_HOOK               1
+#define configCHECK_FOR_STACK_OVERFLOW             0
+#define configUSE_APPLICATION_TASK_TAG             1
+#define configUSE_ALTERNATIVE_API                  0
+#define configSUPPORT_STATIC_ALLOCATION            1
+#define configSUPPORT_DYNAMIC_ALLOCATION           1
+#define configGENERATE_RUN_TIME_STATS              1
+#define configUSE_RUN_TIME_HISTOGRAMS              1
+#define configUSE_STACK_SAMPLER                    1
+#define configUSE_KERNEL_DATA_PAGE                 1
+#define configKERNEL_DATA_PAGE_QUEUES              64
+#define configKERNEL_DATA_PAGE_TASKS               128
+#define configUSE_CO_ROUTINES                      0
+#define configMAX_CO_ROUTINE_PRIORITIES            ( 2 )
+
+/* Software timer definitions.  The timer demo requires the daemon task to run
+ * at the highest priority. */
+#define configUSE_TIMERS                           1
+#define configTIMER_TASK_PRIORITY                  ( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH                   20
+#define configTIMER_TASK_STACK_DEPTH               ( configMINIMAL_STACK_SIZE * 2 )
+
+/* Set the following definitions to 1 to include the API function, or zero
+ * to exclude the API function. */
+#define INCLUDE_vTaskPrioritySet                   1
+#define INCLUDE_uxTaskPriorityGet                  1
+#define INCLUDE_vTaskDelete                        1
+#define INCLUDE_vTaskCleanUpResources              0
+#define INCLUDE_vTaskSuspend                       1
+#define INCLUDE_vTaskDelayUntil                    1
+#define INCLUDE_vTaskDelay                         1
+#define INCLUDE_uxTaskGetStackHighWaterMark        1
+#define INCLUDE_xTaskGetSchedulerState             1
+#define INCLUDE_xTimerGetTimerDaemonTaskHandle     1
+#define INCLUDE_xTaskGetIdleTaskHandle             1
+#define INCLUDE_xTaskGetHandle                     1
+#define INCLUDE_eTaskGetState                      1
+#define INCLUDE_xSemaphoreGetMutexHolder           1
+#define INCLUDE_xTimerPendFunctionCall             1
+#define INCLUDE_xTaskAbortDelay                    1
+
+/* Host timer signals can be delivered late when the host is busy, so allow the
+ * stream buffer trigger level test to see a couple of extra bytes. */
+#define configSTREAM_BUFFER_TRIGGER_LEVEL_TEST_MARGIN    2
+
+#define configASSERT( x )    if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ )
+extern void vAssertCalled( const char * pcFile,
+                           unsigned long ulLine );
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,74 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Drives the "timer interrupts" of the IntQueue.c demo on the POSIX port, which
+ * has no timer interrupts of its own other than the tick.  The tick hook runs
+ * in the tick signal handler, so the two handlers call the FromISR API
+ * functions from interrupt context, as they would from a hardware timer.  The
+ * handlers run at different rates, but cannot nest.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "work_queue.h"
+
+/* Demo includes. */
+#include "IntQueueTimer.h"
+#include "IntQueue.h"
+
+/* The second handler runs once every this many ticks, the first every tick. */
+#define tmrSECOND_HANDLER_TICKS    ( 3U )
+
+/*-----------------------------------------------------------*/
+
+void vInitialiseTimerForIntQueueTest( void )
+{
+    /* The handlers are called from the tick hook, so there is nothing to
+     * initialise. */
+}
+/*-----------------------------------------------------------*/
+
+void vIntQueueTimerTickHook( void )
+{
+    static unsigned uTicks = 0U;
+
+    /* A task woken by either handler sets the kernel's pending yield, which
+     * the tick handler acts on when the tick hook returns, so the results of
+     * the handlers are not needed here.  portYIELD_FROM_ISR() cannot be used
+     * from within the tick hook. */
+    ( void ) xFirstTimerHandler();
+
+    uTicks++;
+
+    if( uTicks >= tmrSECOND_HANDLER_TICKS )
+    {
+        uTicks = 0U;
+        ( void ) xSecondTimerHandler();
+    }
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,721 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Creates the standard demo tasks that can run without target hardware, then
+ * starts the scheduler on the POSIX host port.  The WEB documentation provides
+ * more details of the standard demo application tasks.  In addition to the
+ * standard demo tasks, the following task and hooks are defined within this
+ * file:
+ *
+ * "Check" task - This runs every mainCHECK_TASK_PERIOD milliseconds at a high
+ * priority.  It checks that all the standard demo tasks are still operational
+ * and prints the result, along with the operations per second achieved by the
+ * demos that keep throughput counters.  After mainCHECK_CYCLES cycles it ends
+ * the scheduler, and the program exits with EXIT_SUCCESS if no error was ever
+ * found, or EXIT_FAILURE otherwise, so the demo can be used as a test in CI.
+ * Throughput drops are reported but are not errors, as the host does not give
+ * repeatable timing.
+ *
+ * Tick hook - The demos that exercise the "FromISR" API functions are driven
+ * from the tick hook, which the POSIX port calls from its tick signal handler.
+ * This includes the "timer interrupts" of IntQueue.c - see IntQueueTimer.c.
+ *
+ * Idle hook - Sleeps briefly so the idle task does not keep a host CPU busy.
+ *
+ * Building with mainCREATE_TICKLESS_DEMO_ONLY set to 1 runs the tickless idle
+ * demo in main_tickless.c instead of the standard demo tasks.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#include "work_queue.h"
+
+#if ( configUSE_KERNEL_DATA_PAGE == 1 )
+    #include "kernel_data.h"
+#endif
+
+/* Standard demo includes. */
+#include "AbortDelay.h"
+#include "BlockQ.h"
+#include "blocktim.h"
+#include "CeilingMutex.h"
+#include "countsem.h"
+#include "death.h"
+#include "dynamic.h"
+#include "EventGroupsDemo.h"
+#include "flop.h"
+#include "GenQTest.h"
+#include "integer.h"
+#include "IntQueue.h"
+#include "IntQueueTimer.h"
+#include "IntSemTest.h"
+#include "MessageBufferAMP.h"
+#include "MessageBufferDemo.h"
+#include "NotifyObjects.h"
+#include "PollQ.h"
+#include "PoolAllocation.h"
+#include "QPeek.h"
+#include "QueueOverwrite.h"
+#include "QueueSet.h"
+#include "QueueSetPolling.h"
+#include "recmutex.h"
+#include "semtest.h"
+#include "StaticAllocation.h"
+#include "StreamBufferDemo.h"
+#include "StreamBufferInterrupt.h"
+#include "TaskNotify.h"
+#include "TaskNotifyArray.h"
+#include "ThroughputMonitor.h"
+#include "TimerDemo.h"
+#include "WaitObjects.h"
+
+/* Demo task priorities. */
+#define mainQUEUE_POLL_PRIORITY         ( tskIDLE_PRIORITY + 1 )
+#define mainSEM_TEST_PRIORITY           ( tskIDLE_PRIORITY + 1 )
+#define mainBLOCK_Q_PRIORITY            ( tskIDLE_PRIORITY + 2 )
+#define mainCREATOR_TASK_PRIORITY       ( tskIDLE_PRIORITY + 3 )
+#define mainCHECK_TASK_PRIORITY         ( configMAX_PRIORITIES - 2 )
+#define mainINTEGER_TASK_PRIORITY       ( tskIDLE_PRIORITY )
+#define mainGEN_QUEUE_TASK_PRIORITY     ( tskIDLE_PRIORITY )
+#define mainFLOP_TASK_PRIORITY          ( tskIDLE_PRIORITY )
+#define mainQUEUE_OVERWRITE_PRIORITY    ( tskIDLE_PRIORITY )
+
+/* The period of the software timers used by the timer demo. */
+#define mainTIMER_TEST_PERIOD           ( 50 )
+
+/* The execution period of the check task, and the number of times it runs
+ * before the demo ends.  Both can be overridden from the compiler command
+ * line, for example to run the demo for longer as a soak test. */
+#ifndef mainCHECK_TASK_PERIOD
+    #define mainCHECK_TASK_PERIOD       ( pdMS_TO_TICKS( 5000UL ) )
+#endif
+
+#ifndef mainCHECK_CYCLES
+    #define mainCHECK_CYCLES            ( 4 )
+#endif
+
+/* Set mainCREATE_TICKLESS_DEMO_ONLY to 1 on the compiler command line, along
+ * with configUSE_TICKLESS_IDLE, to run the tickless idle demo. */
+#ifndef mainCREATE_TICKLESS_DEMO_ONLY
+    #define mainCREATE_TICKLESS_DEMO_ONLY    0
+#endif
+
+#if ( mainCREATE_TICKLESS_DEMO_ONLY == 1 ) && ( configUSE_TICKLESS_IDLE == 0 )
+    #error mainCREATE_TICKLESS_DEMO_ONLY requires configUSE_TICKLESS_IDLE to be set to 1
+#endif
+
+/* Set by CMakeLists.txt when FREERTOS_HEAP selects heap_5.c or heap_6.c. */
+#ifndef mainDEFINE_HEAP_REGIONS
+    #define mainDEFINE_HEAP_REGIONS    0
+#endif
+
+/* How long the idle hook sleeps for each time it is called. */
+#define mainIDLE_SLEEP_US               ( 1000 )
+
+/* The length of the queue the check task compares with the kernel data page,
+ * which is also the number of items it sends and receives in one batch. */
+#define mainKERNEL_DATA_QUEUE_LENGTH    ( 3 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The check task as described at the top of this file.
+ */
+static void prvCheckTask( void * pvParameters );
+
+/*
+ * Returns a string describing the first demo found to have failed, or NULL if
+ * all the demos are still running as expected.
+ */
+static const char * prvCheckDemoTasks( void );
+
+/*
+ * The tickless idle demo, defined in main_tickless.c.
+ */
+extern int main_tickless( void );
+
+/*
+ * heap_5.c and heap_6.c have no heap until one is defined, so when the build
+ * selects either of them the heap is defined as two regions, to exercise
+ * allocation across regions.
+ */
+#if ( mainDEFINE_HEAP_REGIONS == 1 )
+    static void prvDefineHeapRegions( void );
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* The value main() returns once the check task has ended the scheduler. */
+static volatile int iExitStatus = EXIT_FAILURE;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    #if ( mainDEFINE_HEAP_REGIONS == 1 )
+    {
+        prvDefineHeapRegions();
+    }
+    #endif
+
+    #if ( mainCREATE_TICKLESS_DEMO_ONLY == 1 )
+    {
+        return main_tickless();
+    }
+    #endif
+
+    /* Create the standard demo tasks. */
+    vStartTaskNotifyTask();
+    vStartTaskNotifyArrayTask();
+    vStartBlockingQueueTasks( mainBLOCK_Q_PRIORITY );
+    vStartSemaphoreTasks( mainSEM_TEST_PRIORITY );
+    vStartPolledQueueTasks( mainQUEUE_POLL_PRIORITY );
+    vStartIntegerMathTasks( mainINTEGER_TASK_PRIORITY );
+    vStartGenericQueueTasks( mainGEN_QUEUE_TASK_PRIORITY );
+    vStartQueuePeekTasks();
+    vStartMathTasks( mainFLOP_TASK_PRIORITY );
+    vStartRecursiveMutexTasks();
+    vStartCountingSemaphoreTasks();
+    vStartDynamicPriorityTasks();
+    vStartQueueOverwriteTask( mainQUEUE_OVERWRITE_PRIORITY );
+    vStartQueueSetTasks();
+    vStartQueueSetPollingTask();
+    vStartEventGroupTasks();
+    vStartInterruptQueueTasks();
+    vStartInterruptSemaphoreTasks();
+    vStartMessageBufferTasks( configMINIMAL_STACK_SIZE );
+    vStartMessageBufferAMPTasks( configMINIMAL_STACK_SIZE );
+    vStartStreamBufferTasks();
+    vStartStreamBufferInterruptDemo();
+    vStartTimerDemoTask( mainTIMER_TEST_PERIOD );
+    vCreateBlockTimeTasks();
+    vCreateAbortDelayTasks();
+    vStartStaticallyAllocatedTasks();
+    vStartPoolAllocationTasks();
+    vStartWaitObjectTasks();
+    vStartNotifyObjectTasks();
+    vStartCeilingMutexTasks();
+
+    /* Register the throughput counters of the demos created above with the
+     * throughput monitor, which the check task updates. */
+    xThroughputMonitorAdd( "BlockQ", "items", ulGetBlockingQueueItemsReceived );
+    xThroughputMonitorAdd( "PollQ", "items", ulGetPollingQueueItemsReceived );
+    xThroughputMonitorAdd( "SemTest", "takes", ulGetSemaphoreTakes );
+    xThroughputMonitorAdd( "RecMutex", "rounds", ulGetRecursiveMutexRounds );
+    xThroughputMonitorAdd( "TaskNotify", "cycles", ulGetTaskNotifyCycles );
+    xThroughputMonitorAdd( "StreamBuffer", "bytes", ulGetStreamBufferBytesReceived );
+    xThroughputMonitorAdd( "MessageBuffer", "bytes", ulGetMessageBufferBytesReceived );
+
+    /* Create the check task defined within this file. */
+    xTaskCreate( prvCheckTask, "Check", configMINIMAL_STACK_SIZE, NULL, mainCHECK_TASK_PRIORITY, NULL );
+
+    /* The suicide tasks must be created last as they need to know how many
+     * tasks were running prior to their creation in order to ascertain
+     * whether or not the correct/expected number of tasks are running at any
+     * given time. */
+    vCreateSuicidalTasks( mainCREATOR_TASK_PRIORITY );
+
+    /* Start the scheduler.  This only returns once the check task has ended
+     * the scheduler, or if there was insufficient heap to create the idle and
+     * timer tasks. */
+    vTaskStartScheduler();
+
+    return iExitStatus;
+}
+/*-----------------------------------------------------------*/
+
+#if ( mainDEFINE_HEAP_REGIONS == 1 )
+
+    static void prvDefineHeapRegions( void )
+    {
+        /* configTOTAL_HEAP_SIZE bytes, split into two regions.  The regions are
+         * listed in address order, as heap_5.c requires. */
+        static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ] __attribute__( ( aligned( portBYTE_ALIGNMENT ) ) );
+        const HeapRegion_t xHeapRegions[] =
+        {
+            { ucHeap,                                  configTOTAL_HEAP_SIZE / 2U },
+            { ucHeap + ( configTOTAL_HEAP_SIZE / 2U ), configTOTAL_HEAP_SIZE / 2U },
+            { NULL,                                    0                          }
+        };
+
+        vPortDefineHeapRegions( xHeapRegions );
+    }
+
+#endif /* mainDEFINE_HEAP_REGIONS */
+/*-----------------------------------------------------------*/
+
+static void prvCheckTask( void * pvParameters )
+{
+    TickType_t xLastExecutionTime;
+    const char * pcStatusMessage;
+    BaseType_t xErrorFound = pdFALSE;
+    UBaseType_t uxCycle, uxThroughputDrops;
+
+    #if ( configUSE_WORK_QUEUES == 1 )
+        WorkQueueStats_t xHighWorkStats, xLowWorkStats, xIntQueueWorkStats;
+    #endif
+
+    #if ( configUSE_STACK_SAMPLER == 1 )
+        TaskStackSample_t xStackSample;
+        BaseType_t xStackSampled;
+    #endif
+
+    #if ( configUSE_KERNEL_DATA_PAGE == 1 )
+        QueueHandle_t xKernelDataQueue;
+        UBaseType_t uxPageMessagesWaiting;
+        eTaskState ePageState;
+        const uint32_t ulItems[ mainKERNEL_DATA_QUEUE_LENGTH ] = { 0UL };
+        uint32_t ulReceived[ mainKERNEL_DATA_QUEUE_LENGTH ];
+    #endif
+
+    #if ( configUSE_RUN_TIME_HISTOGRAMS == 1 )
+        CoreRunTime_t xLastCoreRunTime, xCoreRunTime;
+        TaskHistogram_t xHistogram;
+        uint32_t ulLastRunSlices = 0UL, ulRunSlices;
+        configRUN_TIME_COUNTER_TYPE ulTotalTime;
+        UBaseType_t uxBucket;
+        unsigned uLoad;
+
+        vTaskGetCoreRunTime( &xLastCoreRunTime );
+    #endif
+
+    ( void ) pvParameters;
+
+    #if ( configUSE_KERNEL_DATA_PAGE == 1 )
+    {
+        /* A queue whose count is checked against the kernel data page.  It
+         * is created after the queues of the standard demos, so
+         * configKERNEL_DATA_PAGE_QUEUES is set high enough for it to still
+         * get a slot of the page. */
+        xKernelDataQueue = xQueueCreate( mainKERNEL_DATA_QUEUE_LENGTH, sizeof( uint32_t ) );
+        configASSERT( xKernelDataQueue );
+    }
+    #endif
+
+    /* Initialise xLastExecutionTime so the first call to vTaskDelayUntil()
+     * works correctly. */
+    xLastExecutionTime = xTaskGetTickCount();
+
+    /* Start the first throughput measurement period. */
+    ( void ) uxThroughputMonitorUpdate();
+
+    for( uxCycle = 1; uxCycle <= mainCHECK_CYCLES; uxCycle++ )
+    {
+        vTaskDelayUntil( &xLastExecutionTime, mainCHECK_TASK_PERIOD );
+
+        pcStatusMessage = prvCheckDemoTasks();
+        uxThroughputDrops = uxThroughputMonitorUpdate();
+
+        #if ( configUSE_WORK_QUEUES == 1 )
+            vInterruptSemaphoreGetWorkQueueStats( &xHighWorkStats, &xLowWorkStats );
+            vGetIntQueueWorkQueueStats( &xIntQueueWorkStats );
+        #endif
+
+        #if ( configUSE_RUN_TIME_HISTOGRAMS == 1 )
+        {
+            /* The check task runs once per cycle, so its run slice histogram
+             * must have gained at least one count since the last cycle. */
+            vTaskGetRunTimeHistogram( NULL, &xHistogram );
+            ulRunSlices = 0UL;
+
+            for( uxBucket = 0; uxBucket < configRUN_TIME_HISTOGRAM_BUCKETS; uxBucket++ )
+            {
+                ulRunSlices += xHistogram.ulRunSlice[ uxBucket ];
+            }
+
+            if( ulRunSlices == ulLastRunSlices )
+            {
+                pcStatusMessage = "Error: RunTimeHistograms";
+            }
+
+            ulLastRunSlices = ulRunSlices;
+
+            vTaskGetCoreRunTime( &xCoreRunTime );
+            ulTotalTime = ( xCoreRunTime.ulBusyTime - xLastCoreRunTime.ulBusyTime ) +
+                          ( xCoreRunTime.ulIdleTime - xLastCoreRunTime.ulIdleTime );
+            uLoad = ( ulTotalTime == 0 ) ? 0U :
+                    ( unsigned ) ( ( ( xCoreRunTime.ulBusyTime - xLastCoreRunTime.ulBusyTime ) * 100UL ) / ulTotalTime );
+            xLastCoreRunTime = xCoreRunTime;
+        }
+        #endif /* configUSE_RUN_TIME_HISTOGRAMS */
+
+        #if ( configUSE_STACK_SAMPLER == 1 )
+        {
+            /* The sampler's cached high water mark can lag the real one, but
+             * can never show less free stack than a full scan.  How quickly
+             * passes complete depends on how much time the idle task gets, so
+             * no pass count is expected here. */
+            xStackSampled = xTaskGetStackSample( NULL, &xStackSample );
+
+            if( ( xStackSampled != pdFALSE ) &&
+                ( xStackSample.uxHighWaterMark < ( configSTACK_DEPTH_TYPE ) uxTaskGetStackHighWaterMark( NULL ) ) )
+            {
+                pcStatusMessage = "Error: StackSampler";
+            }
+        }
+        #endif /* configUSE_STACK_SAMPLER */
+
+        #if ( configUSE_KERNEL_DATA_PAGE == 1 )
+        {
+            /* The kernel data page must agree with the kernel.  The tick
+             * count can move on between the two reads. */
+            if( ( xTaskGetTickCount() - xKernelDataGetTickCount() ) > ( TickType_t ) 1 )
+            {
+                pcStatusMessage = "Error: KernelDataPage";
+            }
+
+            if( ( xKernelDataGetTaskState( xTaskGetCurrentTaskHandle(), &ePageState ) == pdFALSE ) ||
+                ( ePageState != eRunning ) )
+            {
+                pcStatusMessage = "Error: KernelDataPage";
+            }
+
+            ( void ) xQueueSend( xKernelDataQueue, &( ulItems[ 0 ] ), 0 );
+
+            if( ( xKernelDataGetQueueMessagesWaiting( xKernelDataQueue, &uxPageMessagesWaiting ) == pdFALSE ) ||
+                ( uxPageMessagesWaiting != ( UBaseType_t ) 1 ) )
+            {
+                pcStatusMessage = "Error: KernelDataPage";
+            }
+
+            ( void ) xQueueReceive( xKernelDataQueue, &( ulReceived[ 0 ] ), 0 );
+
+            if( ( xKernelDataGetQueueMessagesWaiting( xKernelDataQueue, &uxPageMessagesWaiting ) == pdFALSE ) ||
+                ( uxPageMessagesWaiting != ( UBaseType_t ) 0 ) )
+            {
+                pcStatusMessage = "Error: KernelDataPage";
+            }
+
+            /* Batch sends and receives update the page too. */
+            ( void ) xQueueSendMultiple( xKernelDataQueue, ulItems, mainKERNEL_DATA_QUEUE_LENGTH, 0 );
+
+            if( ( xKernelDataGetQueueMessagesWaiting( xKernelDataQueue, &uxPageMessagesWaiting ) == pdFALSE ) ||
+                ( uxPageMessagesWaiting != ( UBaseType_t ) mainKERNEL_DATA_QUEUE_LENGTH ) )
+            {
+                pcStatusMessage = "Error: KernelDataPage";
+            }
+
+            ( void ) xQueueReceiveMultiple( xKernelDataQueue, ulReceived, mainKERNEL_DATA_QUEUE_LENGTH, 0 );
+
+            if( ( xKernelDataGetQueueMessagesWaiting( xKernelDataQueue, &uxPageMessagesWaiting ) == pdFALSE ) ||
+                ( uxPageMessagesWaiting != ( UBaseType_t ) 0 ) )
+            {
+                pcStatusMessage = "Error: KernelDataPage";
+            }
+        }
+        #endif /* configUSE_KERNEL_DATA_PAGE */
+
+        if( pcStatusMessage != NULL )
+        {
+            xErrorFound = pdTRUE;
+        }
+
+        /* stdout is shared with the host, so print from a critical section to
+         * prevent a context switch while the C library holds its lock. */
+        taskENTER_CRITICAL();
+        {
+            printf( "Cycle %u of %u, tick count %lu: %s\n",
+                    ( unsigned ) uxCycle,
+                    ( unsigned ) mainCHECK_CYCLES,
+                    ( unsigned long ) xTaskGetTickCount(),
+                    ( pcStatusMessage != NULL ) ? pcStatusMessage : "OK" );
+
+            #if ( configUSE_RUN_TIME_HISTOGRAMS == 1 )
+                printf( "    Busy %u%%, check task run slices by log2 length:", uLoad );
+
+                for( uxBucket = 0; uxBucket < configRUN_TIME_HISTOGRAM_BUCKETS; uxBucket++ )
+                {
+                    printf( " %lu", ( unsigned long ) xHistogram.ulRunSlice[ uxBucket ] );
+                }
+
+                printf( "\n" );
+            #endif
+
+            #if ( configUSE_STACK_SAMPLER == 1 )
+                printf( "    Check task stack high water mark %lu words after %lu sampling passes\n",
+                        ( unsigned long ) xStackSample.uxHighWaterMark,
+                        ( unsigned long ) xStackSample.ulPasses );
+            #endif
+
+            printf( "    Throughput, %u counter(s) dropped:\n", ( unsigned ) uxThroughputDrops );
+            vThroughputMonitorPrint();
+
+            #if ( configUSE_WORK_QUEUES == 1 )
+                printf( "    Interrupt work queue latency (max/mean us): high %lu/%lu, low %lu/%lu\n",
+                        ( unsigned long ) xHighWorkStats.ulMaxLatency,
+                        ( unsigned long ) ( ( xHighWorkStats.ulItemsRun == 0UL ) ? 0UL : ( xHighWorkStats.ulTotalLatency / xHighWorkStats.ulItemsRun ) ),
+                        ( unsigned long ) xLowWorkStats.ulMaxLatency,
+                        ( unsigned long ) ( ( xLowWorkStats.ulItemsRun == 0UL ) ? 0UL : ( xLowWorkStats.ulTotalLatency / xLowWorkStats.ulItemsRun ) ) );
+                printf( "    IntQueue work queue latency (max/mean us): %lu/%lu\n",
+                        ( unsigned long ) xIntQueueWorkStats.ulMaxLatency,
+                        ( unsigned long ) ( ( xIntQueueWorkStats.ulItemsRun == 0UL ) ? 0UL : ( xIntQueueWorkStats.ulTotalLatency / xIntQueueWorkStats.ulItemsRun ) ) );
+            #endif
+
+            fflush( stdout );
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    iExitStatus = ( xErrorFound == pdFALSE ) ? EXIT_SUCCESS : EXIT_FAILURE;
+    vTaskEndScheduler();
+
+    /* Not reached. */
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static const char * prvCheckDemoTasks( void )
+{
+    const char * pcStatusMessage = NULL;
+
+    if( xAreTaskNotificationTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: Notification";
+    }
+    else if( xAreTaskNotificationArrayTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: NotificationArray";
+    }
+    else if( xAreBlockingQueuesStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: BlockQueue";
+    }
+    else if( xAreSemaphoreTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: SemTest";
+    }
+    else if( xArePollingQueuesStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: PollQueue";
+    }
+    else if( xAreIntegerMathsTaskStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: IntMath";
+    }
+    else if( xAreGenericQueueTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: GenQueue";
+    }
+    else if( xAreQueuePeekTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: QueuePeek";
+    }
+    else if( xAreMathsTaskStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: Flop";
+    }
+    else if( xAreRecursiveMutexTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: RecMutex";
+    }
+    else if( xAreCountingSemaphoreTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: CountSem";
+    }
+    else if( xAreDynamicPriorityTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: Dynamic";
+    }
+    else if( xIsQueueOverwriteTaskStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: QueueOverwrite";
+    }
+    else if( xAreQueueSetTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: QueueSet";
+    }
+    else if( xAreQueueSetPollTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: QueueSetPolling";
+    }
+    else if( xAreEventGroupTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: EventGroup";
+    }
+    else if( xAreIntQueueTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: IntQueue";
+    }
+    else if( xAreInterruptSemaphoreTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: IntSem";
+    }
+    else if( xAreMessageBufferTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: MessageBuffer";
+    }
+    else if( xAreMessageBufferAMPTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: MessageBufferAMP";
+    }
+    else if( xAreStreamBufferTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: StreamBuffer";
+    }
+    else if( xIsInterruptStreamBufferDemoStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: StreamBufferInterrupt";
+    }
+    else if( xAreTimerDemoTasksStillRunning( mainCHECK_TASK_PERIOD ) != pdTRUE )
+    {
+        pcStatusMessage = "Error: TimerDemo";
+    }
+    else if( xAreBlockTimeTestTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: BlockTime";
+    }
+    else if( xAreAbortDelayTestTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: AbortDelay";
+    }
+    else if( xAreStaticAllocationTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: StaticAllocation";
+    }
+    else if( xArePoolAllocationTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: PoolAllocation";
+    }
+    else if( xAreWaitObjectTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: WaitObjects";
+    }
+    else if( xAreNotifyObjectTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: NotifyObjects";
+    }
+    else if( xAreCeilingMutexTasksStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: CeilingMutex";
+    }
+    else if( xIsCreateTaskStillRunning() != pdTRUE )
+    {
+        pcStatusMessage = "Error: Death";
+    }
+
+    return pcStatusMessage;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+    /* Call the periodic "interrupt" tests of the standard demo tasks, which
+     * are not created by the tickless demo. */
+    #if ( mainCREATE_TICKLESS_DEMO_ONLY == 0 )
+    {
+        vTimerPeriodicISRTests();
+        vQueueOverwritePeriodicISRDemo();
+        vQueueSetAccessQueueSetFromISR();
+        vQueueSetPollingInterruptAccess();
+        vPeriodicEventGroupsProcessing();
+        vPeriodicStreamBufferProcessing();
+        vBasicStreamBufferSendFromISR();
+        vIntQueueTimerTickHook();
+        vInterruptSemaphorePeriodicTest();
+        xNotifyTaskFromISR();
+        xNotifyArrayTaskFromISR();
+        vWaitObjectsAccessFromISR();
+        vNotifyObjectsAccessFromISR();
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+    /* Yield the host CPU.  The sleep is cut short by the next tick.  With
+     * tickless idle the port sleeps instead, for as long as no task needs to
+     * run. */
+    #if ( configUSE_TICKLESS_IDLE == 0 )
+    {
+        usleep( mainIDLE_SLEEP_US );
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+    vAssertCalled( __FILE__, __LINE__ );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMutexCeilingViolationHook( QueueHandle_t xMutex,
+                                            TaskHandle_t xTask )
+{
+    /* The ceiling mutex demo breaks the protocol on purpose, and checks each
+     * violation is reported. */
+    vCeilingMutexViolationDetected( xMutex, xTask );
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine )
+{
+    taskENTER_CRITICAL();
+    {
+        fprintf( stderr, "ASSERT: %s:%lu\n", pcFile, ulLine );
+        exit( EXIT_FAILURE );
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+/* configSUPPORT_STATIC_ALLOCATION is set to 1, so the application must provide
+ * the memory used by the idle and timer tasks. */
+void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                    StackType_t ** ppxIdleTaskStackBuffer,
+                                    uint32_t * pulIdleTaskStackSize )
+{
+    static StaticTask_t xIdleTaskTCB;
+    static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+    *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+    *ppxIdleTaskStackBuffer = uxIdleTaskStack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationGetTimerTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer,
+                                     StackType_t ** ppxTimerTaskStackBuffer,
+                                     uint32_t * pulTimerTaskStackSize )
+{
+    static StaticTask_t xTimerTaskTCB;
+    static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+
+    *ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+    *ppxTimerTaskStackBuffer = uxTimerTaskStack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
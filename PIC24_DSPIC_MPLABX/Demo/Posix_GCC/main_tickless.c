@@ -0,0 +1,321 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A demo of tickless idle on the POSIX port, selected by building with
+ * mainCREATE_TICKLESS_DEMO_ONLY set to 1 and configUSE_TICKLESS_IDLE set to 1.
+ * Unlike the full demo, no task runs at the idle priority, so the idle task
+ * can suppress the tick whenever every task is blocked.
+ *
+ * A set of auto-reload software timers with different periods provides a
+ * timer load that is typical of a low power application.  Each callback
+ * checks it is not executing before the tick at which its timer was due to
+ * expire, or more than mainMAX_TIMER_LATENESS ticks after it, so a tick that
+ * is stepped incorrectly while the tick is suppressed is detected.  Building with configUSE_TIMER_WHEEL set to 1 as
+ * well checks that the timer service task only wakes when a timer expires.
+ *
+ * As in the AVR tickless demos, a Tx task periodically sends to a queue on
+ * which an Rx task is blocked.
+ *
+ * A check task prints the tickless statistics every
+ * mainTICKLESS_CHECK_PERIOD, when configUSE_TICKLESS_STATS is set to 1, along
+ * with the difference between the tick count and the time that actually
+ * passed on the host.  After mainTICKLESS_CHECK_CYCLES it ends the scheduler,
+ * and main_tickless() returns EXIT_SUCCESS only if every timer ran on time and
+ * the tick was suppressed at least once in every cycle.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "queue.h"
+
+/* Exclude the entire file if configUSE_TICKLESS_IDLE is 0. */
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+/* Priorities at which the tasks are created. */
+#define mainQUEUE_RECEIVE_TASK_PRIORITY    ( tskIDLE_PRIORITY + 1 )
+#define mainQUEUE_SEND_TASK_PRIORITY       ( tskIDLE_PRIORITY + 2 )
+#define mainTICKLESS_CHECK_PRIORITY        ( configMAX_PRIORITIES - 2 )
+
+/* The block time used by the Tx task. */
+#define mainSEND_PERIOD                    pdMS_TO_TICKS( 500UL )
+
+/* The host does not run the timer service task's thread the instant it is
+ * unblocked, so if the idle task woke late the next tick can occur before a
+ * timer callback executes. */
+#define mainMAX_TIMER_LATENESS             ( ( TickType_t ) 2 )
+
+/* The value sent from the Tx task to the Rx task. */
+#define mainQUEUED_VALUE                   ( 100UL )
+
+/* The execution period of the check task, and the number of times it runs
+ * before the demo ends. */
+#ifndef mainTICKLESS_CHECK_PERIOD
+    #define mainTICKLESS_CHECK_PERIOD      pdMS_TO_TICKS( 5000UL )
+#endif
+
+#ifndef mainTICKLESS_CHECK_CYCLES
+    #define mainTICKLESS_CHECK_CYCLES      ( 4 )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The tasks and timer callback as described at the top of this file.
+ */
+static void prvQueueSendTask( void * pvParameters );
+static void prvQueueReceiveTask( void * pvParameters );
+static void prvTicklessCheckTask( void * pvParameters );
+static void prvLoadTimerCallback( TimerHandle_t xTimer );
+
+/*-----------------------------------------------------------*/
+
+/* The periods of the load timers, chosen so their expiry times rarely
+ * coincide. */
+static const TickType_t xLoadTimerPeriods[] =
+{
+    pdMS_TO_TICKS( 10UL ),
+    pdMS_TO_TICKS( 35UL ),
+    pdMS_TO_TICKS( 100UL ),
+    pdMS_TO_TICKS( 250UL ),
+    pdMS_TO_TICKS( 1000UL )
+};
+
+#define mainNUM_LOAD_TIMERS    ( sizeof( xLoadTimerPeriods ) / sizeof( xLoadTimerPeriods[ 0 ] ) )
+
+/* The number of times each load timer has expired, and the number of times
+ * any load timer expired at the wrong tick. */
+static volatile uint32_t ulLoadTimerExpiries[ mainNUM_LOAD_TIMERS ] = { 0 };
+static volatile uint32_t ulLateTimerExpiries = 0;
+
+/* The queue used by the Tx and Rx tasks, and the number of values received. */
+static QueueHandle_t xQueue = NULL;
+static volatile uint32_t ulValuesReceived = 0;
+
+/* The value main_tickless() returns once the check task has ended the
+ * scheduler. */
+static volatile int iTicklessExitStatus = EXIT_FAILURE;
+
+/*-----------------------------------------------------------*/
+
+int main_tickless( void )
+{
+    TimerHandle_t xTimer;
+    size_t x;
+
+    xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+    configASSERT( xQueue );
+
+    for( x = 0; x < mainNUM_LOAD_TIMERS; x++ )
+    {
+        xTimer = xTimerCreate( "Load", xLoadTimerPeriods[ x ], pdTRUE, ( void * ) x, prvLoadTimerCallback );
+        configASSERT( xTimer );
+        ( void ) xTimerStart( xTimer, 0 );
+    }
+
+    xTaskCreate( prvQueueReceiveTask, "Rx", configMINIMAL_STACK_SIZE, NULL, mainQUEUE_RECEIVE_TASK_PRIORITY, NULL );
+    xTaskCreate( prvQueueSendTask, "Tx", configMINIMAL_STACK_SIZE, NULL, mainQUEUE_SEND_TASK_PRIORITY, NULL );
+    xTaskCreate( prvTicklessCheckTask, "Check", configMINIMAL_STACK_SIZE, NULL, mainTICKLESS_CHECK_PRIORITY, NULL );
+
+    /* Only returns once the check task has ended the scheduler, or if there
+     * was insufficient heap to create the idle and timer tasks. */
+    vTaskStartScheduler();
+
+    return iTicklessExitStatus;
+}
+/*-----------------------------------------------------------*/
+
+static void prvLoadTimerCallback( TimerHandle_t xTimer )
+{
+    const size_t xIndex = ( size_t ) pvTimerGetTimerID( xTimer );
+    const TickType_t xLateness = xTaskGetTickCount() - ( xTimerGetExpiryTime( xTimer ) - xTimerGetPeriod( xTimer ) );
+
+    /* The timer has already been reloaded, so it was due to expire one period
+     * before its new expiry time.  The timer service task has the highest
+     * priority, so it runs on the tick at which the timer expires.  A callback
+     * that executes early wraps xLateness round to a large value. */
+    if( xLateness > mainMAX_TIMER_LATENESS )
+    {
+        ulLateTimerExpiries++;
+    }
+
+    ulLoadTimerExpiries[ xIndex ]++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueSendTask( void * pvParameters )
+{
+    const uint32_t ulValueToSend = mainQUEUED_VALUE;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        vTaskDelay( mainSEND_PERIOD );
+        ( void ) xQueueSend( xQueue, &ulValueToSend, 0 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueReceiveTask( void * pvParameters )
+{
+    uint32_t ulReceivedValue;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) xQueueReceive( xQueue, &ulReceivedValue, portMAX_DELAY );
+
+        if( ulReceivedValue == mainQUEUED_VALUE )
+        {
+            ulValuesReceived++;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvTicklessCheckTask( void * pvParameters )
+{
+    TickType_t xLastExecutionTime, xTicksSinceStart;
+    uint32_t ulLastExpiries[ mainNUM_LOAD_TIMERS ] = { 0 };
+    uint32_t ulLastValuesReceived = 0;
+    const char * pcStatusMessage;
+    BaseType_t xErrorFound = pdFALSE;
+    UBaseType_t uxCycle;
+    unsigned long ulHostMsSinceStart;
+    size_t x;
+
+    #if ( configUSE_TICKLESS_STATS == 1 )
+        TicklessStats_t xStats;
+        uint32_t ulLastSleepCount = 0;
+    #endif
+
+    ( void ) pvParameters;
+
+    xLastExecutionTime = xTaskGetTickCount();
+
+    for( uxCycle = 1; uxCycle <= mainTICKLESS_CHECK_CYCLES; uxCycle++ )
+    {
+        vTaskDelayUntil( &xLastExecutionTime, mainTICKLESS_CHECK_PERIOD );
+        pcStatusMessage = NULL;
+
+        /* Every timer must still be running, and must have run on time. */
+        for( x = 0; x < mainNUM_LOAD_TIMERS; x++ )
+        {
+            if( ulLoadTimerExpiries[ x ] == ulLastExpiries[ x ] )
+            {
+                pcStatusMessage = "Error: timer stopped";
+            }
+
+            ulLastExpiries[ x ] = ulLoadTimerExpiries[ x ];
+        }
+
+        if( ulLateTimerExpiries != 0 )
+        {
+            pcStatusMessage = "Error: timer expired at the wrong time";
+        }
+
+        if( ulValuesReceived == ulLastValuesReceived )
+        {
+            pcStatusMessage = "Error: queue";
+        }
+
+        ulLastValuesReceived = ulValuesReceived;
+
+        #if ( configUSE_TICKLESS_STATS == 1 )
+        {
+            vTaskGetTicklessStats( &xStats );
+
+            /* Every task spends most of its time blocked, so the tick must
+             * have been suppressed. */
+            if( xStats.ulSleepCount == ulLastSleepCount )
+            {
+                pcStatusMessage = "Error: tick never suppressed";
+            }
+
+            ulLastSleepCount = xStats.ulSleepCount;
+        }
+        #endif
+
+        if( pcStatusMessage != NULL )
+        {
+            xErrorFound = pdTRUE;
+        }
+
+        /* The tick count and the host's clock both started when the scheduler
+         * started, so the difference between them is the drift of the tick. */
+        xTicksSinceStart = xTaskGetTickCount();
+        ulHostMsSinceStart = ulPortGetRunTime() / 1000UL;
+
+        /* stdout is shared with the host, so print from a critical section to
+         * prevent a context switch while the C library holds its lock. */
+        taskENTER_CRITICAL();
+        {
+            printf( "Cycle %u of %u, tick count %lu, host time %lu ms: %s\n",
+                    ( unsigned ) uxCycle,
+                    ( unsigned ) mainTICKLESS_CHECK_CYCLES,
+                    ( unsigned long ) xTicksSinceStart,
+                    ulHostMsSinceStart,
+                    ( pcStatusMessage != NULL ) ? pcStatusMessage : "OK" );
+
+            #if ( configUSE_TICKLESS_STATS == 1 )
+            {
+                printf( "  Slept %lu of %lu expected ticks in %lu sleeps (%lu aborted, %lu woke early), "
+                        "%lu ticks lost, wake compensation %lu us, last wake error %ld us, drift %ld us\n",
+                        ( unsigned long ) xStats.ulTicksSlept,
+                        ( unsigned long ) xStats.ulTicksExpected,
+                        ( unsigned long ) xStats.ulSleepCount,
+                        ( unsigned long ) xStats.ulAbortedCount,
+                        ( unsigned long ) xStats.ulEarlyWakeCount,
+                        ( unsigned long ) xStats.ulTicksLost,
+                        ( unsigned long ) xStats.ulWakeCompensation,
+                        ( long ) xStats.lLastWakeError,
+                        ( long ) xStats.lTickDrift );
+            }
+            #endif
+
+            fflush( stdout );
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    iTicklessExitStatus = ( xErrorFound == pdFALSE ) ? EXIT_SUCCESS : EXIT_FAILURE;
+    vTaskEndScheduler();
+
+    /* Not reached. */
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+/* Exclude the entire file if configUSE_TICKLESS_IDLE is 0. */
+#endif /* configUSE_TICKLESS_IDLE != 0 */
@@ -0,0 +1,386 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Host side benchmark for the delayed task list.
+ *
+ * tasks.c is compiled into this file so 256 statically allocated tasks can be
+ * moved in and out of the Blocked state directly, without a scheduler.  Each
+ * task in turn is made the "current" task and passed to
+ * prvAddCurrentTaskToDelayedList(), which is the part of every blocking call
+ * that runs with the scheduler suspended or inside a critical section.  The
+ * tick interrupt is simulated by calling xTaskIncrementTick().  The same file
+ * is built once with the sorted delayed task lists
+ * (configUSE_DELAYED_TASK_WHEEL == 0) and once with the delayed task wheel
+ * (configUSE_DELAYED_TASK_WHEEL == 1).
+ *
+ * For each of the scenarios below the benchmark reports the average, the 99.9th
+ * percentile and the longest time taken to place a task in the Blocked state,
+ * and the same for a tick interrupt.  The longest times bound the interrupt
+ * latency added by the delayed task structure.  The host can preempt the
+ * benchmark at any point, so the longest times include some noise, which the
+ * 99.9th percentile filters out.
+ *
+ * + Random: every task blocks for a random time of up to 10,000 ticks.
+ *
+ * + Last: every task blocks for 256 ticks, one task waking on each tick, so
+ *   each task entering the Blocked state wakes after every other Blocked task.
+ *   This is the worst case for inserting into a sorted list.
+ *
+ * + Burst: every task blocks for the same number of ticks, so all 256 tasks
+ *   wake in the same tick interrupt.
+ *
+ * Every scenario starts shortly before the tick count overflows.  A checksum of
+ * the order in which tasks wake, and the tick count at which they wake, is
+ * printed for each scenario and must be the same for both builds.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Start the tick count close enough to its overflow that every scenario
+ * crosses it. */
+#define configINITIAL_TICK_COUNT    ( ( TickType_t ) 0xfffff000UL )
+
+/* The task implementation under test.  The include path must contain
+ * PIC24_DSPIC_MPLABX/Source. */
+#include "tasks.c"
+
+/* The number of Blocked tasks. */
+#define benchNUM_TASKS          ( 256 )
+
+/* The number of tick interrupts simulated by each scenario. */
+#define benchTICKS              ( 200000UL )
+
+/* The priority of every benchmark task. */
+#define benchTASK_PRIORITY      ( tskIDLE_PRIORITY + 1 )
+
+/* The most timings kept for the percentile calculation in each scenario. */
+#define benchMAX_SAMPLES        ( 500000UL )
+
+/* The scenarios. */
+typedef enum
+{
+    eRandom = 0,
+    eLast,
+    eBurst
+} Scenario_t;
+
+/* Timing statistics. */
+typedef struct BENCH_STATS
+{
+    uint64_t ullTotal;
+    uint32_t ulCount;
+    uint32_t ulSamples[ benchMAX_SAMPLES ];
+} BenchStats_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Run one scenario, printing its results.
+ */
+static void prvRunScenario( Scenario_t eScenario,
+                            const char * pcName );
+
+/*
+ * Return the number of ticks the task that has just been made the current task
+ * blocks for.
+ */
+static TickType_t prvTicksToBlock( Scenario_t eScenario,
+                                   UBaseType_t uxTask );
+
+/*
+ * Place the current task in the Blocked state, timing how long it takes.
+ */
+static void prvBlockCurrentTask( TickType_t xTicksToWait );
+
+static void prvRecord( BenchStats_t * pxStats,
+                       uint64_t ullStart );
+static void prvPrintStats( const BenchStats_t * pxStats );
+static int prvCompareSamples( const void * pvA,
+                              const void * pvB );
+static uint32_t prvRand( void );
+static uint64_t prvNanoseconds( void );
+
+/*-----------------------------------------------------------*/
+
+static StaticTask_t xTaskBuffers[ benchNUM_TASKS ];
+static StackType_t uxTaskStacks[ benchNUM_TASKS ][ configMINIMAL_STACK_SIZE ];
+static TaskHandle_t xTasks[ benchNUM_TASKS ];
+
+static BenchStats_t xBlockStats, xTickStats;
+static uint32_t ulChecksum = 0;
+static uint32_t ulRandSeed = 0x12345678UL;
+
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void * pvParameters )
+{
+    /* Never runs, as the scheduler is not started. */
+    ( void ) pvParameters;
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    UBaseType_t uxTask;
+
+    for( uxTask = 0; uxTask < benchNUM_TASKS; uxTask++ )
+    {
+        xTasks[ uxTask ] = xTaskCreateStatic( prvBenchTask, "Bench", configMINIMAL_STACK_SIZE, NULL, benchTASK_PRIORITY, uxTaskStacks[ uxTask ], &( xTaskBuffers[ uxTask ] ) );
+        configASSERT( xTasks[ uxTask ] );
+    }
+
+    printf( "Delayed task backend: %s, %d Blocked tasks\r\n", ( configUSE_DELAYED_TASK_WHEEL == 1 ) ? "timing wheel" : "sorted lists", benchNUM_TASKS );
+    printf( "%-8s %30s %30s %10s\r\n", "", "block (ns)", "tick (ns)", "" );
+    printf( "%-8s %10s%10s%10s %10s%10s%10s %10s\r\n", "scenario", "mean", "p99.9", "max", "mean", "p99.9", "max", "checksum" );
+
+    prvRunScenario( eRandom, "random" );
+    prvRunScenario( eLast, "last" );
+    prvRunScenario( eBurst, "burst" );
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunScenario( Scenario_t eScenario,
+                            const char * pcName )
+{
+    List_t * const pxReadyList = &( pxReadyTasksLists[ benchTASK_PRIORITY ] );
+    UBaseType_t uxTask;
+    uint32_t ulTick;
+    uint64_t ullStart;
+
+    xBlockStats.ullTotal = 0;
+    xBlockStats.ulCount = 0;
+    xTickStats.ullTotal = 0;
+    xTickStats.ulCount = 0;
+    ulChecksum = 0;
+
+    /* Every task is in the Ready state at the start of each scenario. */
+    for( uxTask = 0; uxTask < benchNUM_TASKS; uxTask++ )
+    {
+        pxCurrentTCB = xTasks[ uxTask ];
+        prvBlockCurrentTask( prvTicksToBlock( eScenario, uxTask ) );
+    }
+
+    for( ulTick = 0; ulTick < benchTICKS; ulTick++ )
+    {
+        ullStart = prvNanoseconds();
+        ( void ) xTaskIncrementTick();
+        prvRecord( &xTickStats, ullStart );
+
+        /* Tasks unblocked by the tick are added to the end of the ready list
+         * in the order in which they were unblocked.  Each one blocks again
+         * straight away. */
+        while( listLIST_IS_EMPTY( pxReadyList ) == pdFALSE )
+        {
+            pxCurrentTCB = listGET_OWNER_OF_HEAD_ENTRY( pxReadyList );
+            uxTask = ( UBaseType_t ) ( ( StaticTask_t * ) pxCurrentTCB - xTaskBuffers );
+            ulChecksum = ( ulChecksum * 31UL ) ^ ( ( uint32_t ) uxTask * 2654435761UL ) ^ ( uint32_t ) xTickCount;
+            prvBlockCurrentTask( prvTicksToBlock( eScenario, uxTask ) );
+        }
+    }
+
+    printf( "%-8s ", pcName );
+    prvPrintStats( &xBlockStats );
+    prvPrintStats( &xTickStats );
+    printf( "0x%08lx\r\n", ( unsigned long ) ulChecksum );
+
+    /* Unblock every task ready for the next scenario. */
+    for( uxTask = 0; uxTask < benchNUM_TASKS; uxTask++ )
+    {
+        ( void ) uxListRemove( &( ( ( TCB_t * ) xTasks[ uxTask ] )->xStateListItem ) );
+        prvAddTaskToReadyList( ( ( TCB_t * ) xTasks[ uxTask ] ) );
+    }
+
+    prvResetNextTaskUnblockTime();
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvTicksToBlock( Scenario_t eScenario,
+                                   UBaseType_t uxTask )
+{
+    static BaseType_t xStarted = pdFALSE;
+    TickType_t xTicksToWait;
+
+    switch( eScenario )
+    {
+        case eRandom:
+            xTicksToWait = ( TickType_t ) ( ( prvRand() % 10000UL ) + 1UL );
+            break;
+
+        case eLast:
+
+            /* The first time through stagger the wake times so one task
+             * wakes on each tick. */
+            if( xStarted == pdFALSE )
+            {
+                xTicksToWait = ( TickType_t ) ( uxTask + 1U );
+                xStarted = ( uxTask == ( benchNUM_TASKS - 1 ) ) ? pdTRUE : pdFALSE;
+            }
+            else
+            {
+                xTicksToWait = ( TickType_t ) benchNUM_TASKS;
+            }
+
+            break;
+
+        default:
+            xTicksToWait = ( TickType_t ) 1000UL;
+            break;
+    }
+
+    return xTicksToWait;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBlockCurrentTask( TickType_t xTicksToWait )
+{
+    const uint64_t ullStart = prvNanoseconds();
+
+    prvAddCurrentTaskToDelayedList( xTicksToWait, pdFALSE );
+    prvRecord( &xBlockStats, ullStart );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecord( BenchStats_t * pxStats,
+                       uint64_t ullStart )
+{
+    const uint64_t ullElapsed = prvNanoseconds() - ullStart;
+
+    if( pxStats->ulCount < benchMAX_SAMPLES )
+    {
+        pxStats->ullTotal += ullElapsed;
+        pxStats->ulSamples[ pxStats->ulCount ] = ( ullElapsed > UINT32_MAX ) ? UINT32_MAX : ( uint32_t ) ullElapsed;
+        pxStats->ulCount++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintStats( const BenchStats_t * pxStats )
+{
+    static uint32_t ulSorted[ benchMAX_SAMPLES ];
+
+    memcpy( ulSorted, pxStats->ulSamples, pxStats->ulCount * sizeof( uint32_t ) );
+    qsort( ulSorted, pxStats->ulCount, sizeof( uint32_t ), prvCompareSamples );
+
+    printf( "%10.1f%10lu%10lu ",
+            ( double ) pxStats->ullTotal / ( double ) pxStats->ulCount,
+            ( unsigned long ) ulSorted[ ( pxStats->ulCount * 999UL ) / 1000UL ],
+            ( unsigned long ) ulSorted[ pxStats->ulCount - 1UL ] );
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompareSamples( const void * pvA,
+                              const void * pvB )
+{
+    const uint32_t ulA = *( const uint32_t * ) pvA;
+    const uint32_t ulB = *( const uint32_t * ) pvB;
+
+    return ( ulA > ulB ) - ( ulA < ulB );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+    /* xorshift32, so both builds see the same sequence on every host. */
+    ulRandSeed ^= ulRandSeed << 13;
+    ulRandSeed ^= ulRandSeed >> 17;
+    ulRandSeed ^= ulRandSeed << 5;
+
+    return ulRandSeed;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Stand-ins for the port layer and the other kernel functions used by tasks.c.
+ */
+
+StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
+                                     TaskFunction_t pxCode,
+                                     void * pvParameters )
+{
+    ( void ) pxCode;
+    ( void ) pvParameters;
+
+    return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+    return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerCreateTimerTask( void )
+{
+    return pdFAIL;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                    StackType_t ** ppxIdleTaskStackBuffer,
+                                    uint32_t * pulIdleTaskStackSize )
+{
+    static StaticTask_t xIdleTaskTCB;
+    static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+    *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+    *ppxIdleTaskStackBuffer = uxIdleTaskStack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine )
+{
+    fprintf( stderr, "Assert failed: %s:%lu\r\n", pcFile, ulLine );
+    abort();
+}
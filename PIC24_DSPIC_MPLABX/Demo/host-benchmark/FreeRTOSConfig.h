@@ -0,0 +1,80 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+ * Application specific definitions.
+ *
+ * These definitions are used by the host side benchmarks, which compile kernel
+ * source files directly into a native executable so the cost of the kernel
+ * data structures can be measured without target hardware.
+ *
+ * See http://www.freertos.org/a00110.html.
+ *----------------------------------------------------------*/
+
+#define configUSE_PREEMPTION                1
+#define configUSE_IDLE_HOOK                 0
+#define configUSE_TICK_HOOK                 0
+#define configTICK_RATE_HZ                  ( ( TickType_t ) 1000 )
+#define configCPU_CLOCK_HZ                  ( ( unsigned long ) 1000000000 )
+#define configMAX_PRIORITIES                ( 8 )
+#define configMINIMAL_STACK_SIZE            ( 256 )
+#define configMAX_TASK_NAME_LEN             ( 16 )
+#define configUSE_TRACE_FACILITY            0
+#define configUSE_16_BIT_TICKS              0
+#define configIDLE_SHOULD_YIELD             1
+#define configSUPPORT_STATIC_ALLOCATION     1
+
+/* Only the heap benchmark, which links in one of the heap_n.c files, builds
+ * with dynamic allocation. */
+#ifndef configSUPPORT_DYNAMIC_ALLOCATION
+    #define configSUPPORT_DYNAMIC_ALLOCATION    0
+#endif
+
+/* Software timer definitions.  The timing wheel can be selected from the
+ * command line so both timer backends can be built from the same sources. */
+#define configUSE_TIMERS                    1
+#define configTIMER_TASK_PRIORITY           ( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH            ( 16 )
+#define configTIMER_TASK_STACK_DEPTH        ( configMINIMAL_STACK_SIZE )
+
+#ifndef configUSE_TIMER_WHEEL
+    #define configUSE_TIMER_WHEEL           0
+#endif
+
+#define INCLUDE_xTimerPendFunctionCall      0
+
+#define configASSERT( x )    if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ )
+extern void vAssertCalled( const char * pcFile, unsigned long ulLine );
+
+/* There is no scheduler port for the host benchmarks, so bring in the stub
+ * port layer from this directory rather than letting portable.h select one of
+ * the MPLAB ports. */
+#include "portmacro.h"
+
+#endif /* FREERTOS_CONFIG_H */
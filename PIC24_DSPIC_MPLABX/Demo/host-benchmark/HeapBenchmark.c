@@ -0,0 +1,441 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Host side benchmark for the heap implementations.
+ *
+ * The same file is linked with heap_5.c and with heap_6.c.  Both are given the
+ * same three heap regions, and then:
+ *
+ * + random - a long sequence of allocations of random sizes, and frees of
+ *   randomly chosen allocations, with up to benchMAX_LIVE_BLOCKS allocations
+ *   held at any one time.  Each allocation is filled with a pattern that is
+ *   checked again before it is freed, so overlapping allocations are caught.
+ *
+ * + fragmented - the heap is filled with small blocks and every other block
+ *   is freed, leaving a large number of small free blocks.  Large allocations
+ *   that cannot be satisfied are then timed, which is the worst case for a
+ *   heap that has to search a list of free blocks.
+ *
+ * For each scenario the mean, 99.9th percentile and longest time taken by
+ * pvPortMalloc() and vPortFree() are reported, along with the number of
+ * failed allocations and the heap statistics.  Finally every block is freed
+ * and the benchmark checks the heap has coalesced back to one free block per
+ * region.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Size of each heap region. */
+#define benchREGION_SIZE          ( 256UL * 1024UL )
+
+/* Number of operations in the random scenario. */
+#define benchRANDOM_OPERATIONS    ( 400000UL )
+
+/* The most allocations held at any one time in the random scenario. */
+#define benchMAX_LIVE_BLOCKS      ( 2000UL )
+
+/* Largest allocation made in the random scenario. */
+#define benchMAX_RANDOM_SIZE      ( 1024UL )
+
+/* Size of the blocks used to fragment the heap, and of the allocations that
+ * are then attempted. */
+#define benchSMALL_SIZE           ( 24UL )
+#define benchLARGE_SIZE           ( 4096UL )
+#define benchLARGE_ATTEMPTS       ( 2000UL )
+
+/* The most timings kept for the percentile calculation in each scenario. */
+#define benchMAX_SAMPLES          ( 500000UL )
+
+/* The most blocks held in the fragmented scenario. */
+#define benchMAX_SMALL_BLOCKS     ( ( 3UL * benchREGION_SIZE ) / benchSMALL_SIZE )
+
+/* Timing statistics. */
+typedef struct BENCH_STATS
+{
+    uint64_t ullTotal;
+    uint32_t ulCount;
+    uint32_t ulSamples[ benchMAX_SAMPLES ];
+} BenchStats_t;
+
+/* An allocation held by the benchmark. */
+typedef struct BENCH_BLOCK
+{
+    uint8_t * pucData;
+    size_t xSize;
+} BenchBlock_t;
+
+/*-----------------------------------------------------------*/
+
+static void prvRandomScenario( void );
+static void prvFragmentedScenario( void );
+
+/*
+ * Allocate or free a block, timing the call and filling or checking the
+ * block's contents.
+ */
+static void * prvTimedMalloc( size_t xSize );
+static void prvTimedFree( BenchBlock_t * pxBlock );
+
+static void prvPrintResults( const char * pcName );
+static void prvResetStats( void );
+static void prvRecord( BenchStats_t * pxStats,
+                       uint64_t ullStart );
+static void prvPrintStats( const BenchStats_t * pxStats );
+static int prvCompareSamples( const void * pvA,
+                              const void * pvB );
+static uint32_t prvRand( void );
+static uint64_t prvNanoseconds( void );
+
+/*-----------------------------------------------------------*/
+
+/* The heap regions.  heap_5.c requires the regions to be listed in address
+ * order, so the table is sorted in main(). */
+static uint8_t ucRegion0[ benchREGION_SIZE ] __attribute__( ( aligned( portBYTE_ALIGNMENT ) ) );
+static uint8_t ucRegion1[ benchREGION_SIZE ] __attribute__( ( aligned( portBYTE_ALIGNMENT ) ) );
+static uint8_t ucRegion2[ benchREGION_SIZE ] __attribute__( ( aligned( portBYTE_ALIGNMENT ) ) );
+static HeapRegion_t xHeapRegions[] =
+{
+    { ucRegion0, benchREGION_SIZE },
+    { ucRegion1, benchREGION_SIZE },
+    { ucRegion2, benchREGION_SIZE },
+    { NULL,      0                }
+};
+
+static BenchBlock_t xBlocks[ benchMAX_SMALL_BLOCKS ];
+static BenchStats_t xMallocStats, xFreeStats;
+static uint32_t ulFailedAllocations = 0;
+static uint32_t ulRandSeed = 0x12345678UL;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    HeapRegion_t xTemp;
+    HeapStats_t xStats;
+    size_t xInitialFreeSpace;
+    int i, j;
+
+    for( i = 0; i < 2; i++ )
+    {
+        for( j = 0; j < 2 - i; j++ )
+        {
+            if( xHeapRegions[ j ].pucStartAddress > xHeapRegions[ j + 1 ].pucStartAddress )
+            {
+                xTemp = xHeapRegions[ j ];
+                xHeapRegions[ j ] = xHeapRegions[ j + 1 ];
+                xHeapRegions[ j + 1 ] = xTemp;
+            }
+        }
+    }
+
+    vPortDefineHeapRegions( xHeapRegions );
+    xInitialFreeSpace = xPortGetFreeHeapSize();
+
+    printf( "Heap: %s, 3 regions of %lu bytes, %lu bytes free\r\n", benchHEAP_NAME, benchREGION_SIZE, ( unsigned long ) xInitialFreeSpace );
+    printf( "%-10s %30s %30s %8s %10s %10s %8s\r\n", "", "malloc (ns)", "free (ns)", "", "", "", "" );
+    printf( "%-10s %10s%10s%10s %10s%10s%10s %8s %10s %10s %8s\r\n", "scenario", "mean", "p99.9", "max", "mean", "p99.9", "max", "failed", "free", "largest", "blocks" );
+
+    prvRandomScenario();
+    prvFragmentedScenario();
+
+    /* Everything has been freed, so each region must be one free block
+     * again. */
+    vPortGetHeapStats( &xStats );
+    printf( "After freeing everything: %lu bytes free in %lu blocks, minimum ever free %lu bytes\r\n",
+            ( unsigned long ) xStats.xAvailableHeapSpaceInBytes,
+            ( unsigned long ) xStats.xNumberOfFreeBlocks,
+            ( unsigned long ) xStats.xMinimumEverFreeBytesRemaining );
+    configASSERT( xStats.xAvailableHeapSpaceInBytes == xInitialFreeSpace );
+    configASSERT( xStats.xNumberOfFreeBlocks == 3 );
+    configASSERT( xStats.xNumberOfSuccessfulAllocations == xStats.xNumberOfSuccessfulFrees );
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRandomScenario( void )
+{
+    uint32_t ulOperation, ulLive = 0, ulIndex;
+    size_t xSize;
+
+    prvResetStats();
+
+    for( ulOperation = 0; ulOperation < benchRANDOM_OPERATIONS; ulOperation++ )
+    {
+        /* Allocate while there are few blocks held, and free while there are
+         * many, so the number held wanders between the two. */
+        if( ( ulLive == 0 ) || ( ( ulLive < benchMAX_LIVE_BLOCKS ) && ( ( prvRand() % benchMAX_LIVE_BLOCKS ) >= ulLive ) ) )
+        {
+            /* Mostly small allocations, with an occasional large one. */
+            xSize = ( size_t ) ( prvRand() % benchMAX_RANDOM_SIZE ) + 1U;
+
+            if( ( prvRand() % 64UL ) == 0 )
+            {
+                xSize *= 16U;
+            }
+
+            xBlocks[ ulLive ].pucData = prvTimedMalloc( xSize );
+            xBlocks[ ulLive ].xSize = xSize;
+
+            if( xBlocks[ ulLive ].pucData != NULL )
+            {
+                ulLive++;
+            }
+        }
+        else
+        {
+            ulIndex = prvRand() % ulLive;
+            prvTimedFree( &( xBlocks[ ulIndex ] ) );
+            ulLive--;
+            xBlocks[ ulIndex ] = xBlocks[ ulLive ];
+        }
+    }
+
+    prvPrintResults( "random" );
+
+    while( ulLive > 0 )
+    {
+        ulLive--;
+        prvTimedFree( &( xBlocks[ ulLive ] ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvFragmentedScenario( void )
+{
+    uint32_t ulLive = 0, ulIndex, ulAttempt;
+    BenchBlock_t xLarge;
+
+    prvResetStats();
+
+    /* Fill the heap with small blocks. */
+    while( ulLive < benchMAX_SMALL_BLOCKS )
+    {
+        xBlocks[ ulLive ].pucData = prvTimedMalloc( benchSMALL_SIZE );
+        xBlocks[ ulLive ].xSize = benchSMALL_SIZE;
+
+        if( xBlocks[ ulLive ].pucData == NULL )
+        {
+            break;
+        }
+
+        ulLive++;
+    }
+
+    /* Free every other block, so no two free blocks are adjacent. */
+    for( ulIndex = 0; ulIndex < ulLive; ulIndex += 2 )
+    {
+        prvTimedFree( &( xBlocks[ ulIndex ] ) );
+        xBlocks[ ulIndex ].pucData = NULL;
+    }
+
+    /* Only the timings for the large allocations are reported. */
+    prvResetStats();
+
+    for( ulAttempt = 0; ulAttempt < benchLARGE_ATTEMPTS; ulAttempt++ )
+    {
+        xLarge.pucData = prvTimedMalloc( benchLARGE_SIZE );
+        xLarge.xSize = benchLARGE_SIZE;
+
+        if( xLarge.pucData != NULL )
+        {
+            prvTimedFree( &xLarge );
+        }
+    }
+
+    prvPrintResults( "fragmented" );
+
+    for( ulIndex = 1; ulIndex < ulLive; ulIndex += 2 )
+    {
+        prvTimedFree( &( xBlocks[ ulIndex ] ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void * prvTimedMalloc( size_t xSize )
+{
+    const uint64_t ullStart = prvNanoseconds();
+    uint8_t * pucData;
+
+    pucData = pvPortMalloc( xSize );
+    prvRecord( &xMallocStats, ullStart );
+
+    if( pucData != NULL )
+    {
+        configASSERT( ( ( uintptr_t ) pucData & portBYTE_ALIGNMENT_MASK ) == 0 );
+        memset( pucData, ( int ) ( ( uintptr_t ) pucData >> 3 ) & 0xff, xSize );
+    }
+    else
+    {
+        ulFailedAllocations++;
+    }
+
+    return pucData;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimedFree( BenchBlock_t * pxBlock )
+{
+    const uint8_t ucPattern = ( uint8_t ) ( ( ( uintptr_t ) pxBlock->pucData >> 3 ) & 0xff );
+    uint64_t ullStart;
+    size_t x;
+
+    /* Another allocation overlapping this one would have overwritten the
+     * pattern. */
+    for( x = 0; x < pxBlock->xSize; x++ )
+    {
+        configASSERT( pxBlock->pucData[ x ] == ucPattern );
+    }
+
+    ullStart = prvNanoseconds();
+    vPortFree( pxBlock->pucData );
+    prvRecord( &xFreeStats, ullStart );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintResults( const char * pcName )
+{
+    HeapStats_t xStats;
+
+    vPortGetHeapStats( &xStats );
+
+    printf( "%-10s ", pcName );
+    prvPrintStats( &xMallocStats );
+    prvPrintStats( &xFreeStats );
+    printf( "%8lu %10lu %10lu %8lu\r\n",
+            ( unsigned long ) ulFailedAllocations,
+            ( unsigned long ) xStats.xAvailableHeapSpaceInBytes,
+            ( unsigned long ) xStats.xSizeOfLargestFreeBlockInBytes,
+            ( unsigned long ) xStats.xNumberOfFreeBlocks );
+}
+/*-----------------------------------------------------------*/
+
+static void prvResetStats( void )
+{
+    xMallocStats.ullTotal = 0;
+    xMallocStats.ulCount = 0;
+    xFreeStats.ullTotal = 0;
+    xFreeStats.ulCount = 0;
+    ulFailedAllocations = 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecord( BenchStats_t * pxStats,
+                       uint64_t ullStart )
+{
+    const uint64_t ullElapsed = prvNanoseconds() - ullStart;
+
+    if( pxStats->ulCount < benchMAX_SAMPLES )
+    {
+        pxStats->ullTotal += ullElapsed;
+        pxStats->ulSamples[ pxStats->ulCount ] = ( ullElapsed > UINT32_MAX ) ? UINT32_MAX : ( uint32_t ) ullElapsed;
+        pxStats->ulCount++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintStats( const BenchStats_t * pxStats )
+{
+    static uint32_t ulSorted[ benchMAX_SAMPLES ];
+
+    if( pxStats->ulCount == 0 )
+    {
+        printf( "%10s%10s%10s ", "-", "-", "-" );
+        return;
+    }
+
+    memcpy( ulSorted, pxStats->ulSamples, pxStats->ulCount * sizeof( uint32_t ) );
+    qsort( ulSorted, pxStats->ulCount, sizeof( uint32_t ), prvCompareSamples );
+
+    printf( "%10.1f%10lu%10lu ",
+            ( double ) pxStats->ullTotal / ( double ) pxStats->ulCount,
+            ( unsigned long ) ulSorted[ ( pxStats->ulCount * 999UL ) / 1000UL ],
+            ( unsigned long ) ulSorted[ pxStats->ulCount - 1UL ] );
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompareSamples( const void * pvA,
+                              const void * pvB )
+{
+    const uint32_t ulA = *( const uint32_t * ) pvA;
+    const uint32_t ulB = *( const uint32_t * ) pvB;
+
+    return ( ulA > ulB ) - ( ulA < ulB );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+    /* xorshift32, so both builds see the same sequence on every host. */
+    ulRandSeed ^= ulRandSeed << 13;
+    ulRandSeed ^= ulRandSeed >> 17;
+    ulRandSeed ^= ulRandSeed << 5;
+
+    return ulRandSeed;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Stand-ins for the kernel functions used by the heap implementations.  There
+ * is only one thread, so suspending the scheduler does nothing.
+ */
+
+void vTaskSuspendAll( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskResumeAll( void )
+{
+    return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine )
+{
+    fprintf( stderr, "Assert failed: %s:%lu\r\n", pcFile, ulLine );
+    abort();
+}
@@ -0,0 +1,394 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Host side benchmark for configUSE_CACHE_LINE_LAYOUT.
+ *
+ * The same file is built with configUSE_CACHE_LINE_LAYOUT set to 0 and to 1.
+ * Two host threads, pinned to different CPUs, use semaphores that are created
+ * next to each other in one array, as statically allocated kernel objects
+ * usually are:
+ *
+ * + round trip - the first thread gives the ping semaphore and polls the pong
+ *   semaphore, the second polls the ping semaphore and gives the pong
+ *   semaphore.  The time for each round trip is reported.
+ *
+ * + private - each thread gives and takes its own semaphore and never touches
+ *   the other thread's semaphore.  Any slow down compared to one thread on its
+ *   own comes from the two semaphores sharing a cache line.
+ *
+ * queue.c is used unmodified.  Critical sections are memory barriers rather
+ * than locks, which is enough because no semaphore is ever written by both
+ * threads at the same time, and because the semaphores are only ever polled
+ * no task ever blocks.  At least two host CPUs are needed.
+ */
+
+/* Standard includes. */
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* Number of round trips, or give and take pairs, timed in each run. */
+#define benchITERATIONS    ( 2000000UL )
+
+/* Number of times each scenario is run.  The fastest run is reported along
+ * with the mean, as the fastest is the least disturbed by the host. */
+#define benchRUNS          ( 5 )
+
+/* The semaphores used by the scenarios, adjacent in memory. */
+#define benchPING          ( 0 )
+#define benchPONG          ( 1 )
+#define benchSEMAPHORES    ( 2 )
+
+/* Arguments passed to each thread. */
+typedef struct BENCH_THREAD
+{
+    int iCPU;
+    void * ( *pvFunction )( void * );
+    SemaphoreHandle_t xOwn;
+    SemaphoreHandle_t xOther;
+    uint64_t ullNanoseconds;
+} BenchThread_t;
+
+/*-----------------------------------------------------------*/
+
+static void prvRunScenario( const char * pcName,
+                            void * ( *pvFirst )( void * ),
+                            void * ( *pvSecond )( void * ),
+                            BaseType_t xBothTimed );
+static void prvRunThreads( BenchThread_t * pxThreads,
+                           BaseType_t xThreads );
+static void prvCreateSemaphores( void );
+
+/*
+ * Thread functions for the two scenarios.
+ */
+static void * prvPingThread( void * pvParameters );
+static void * prvPongThread( void * pvParameters );
+static void * prvPrivateThread( void * pvParameters );
+
+static uint64_t prvNanoseconds( void );
+
+/*-----------------------------------------------------------*/
+
+static StaticSemaphore_t xSemaphoreBuffers[ benchSEMAPHORES ];
+static SemaphoreHandle_t xSemaphores[ benchSEMAPHORES ];
+
+/* Set once both threads are running, so neither is timed while the other is
+ * still being created. */
+static volatile BaseType_t xStart = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    const uintptr_t uxDistance = ( uintptr_t ) &( xSemaphoreBuffers[ 1 ] ) - ( uintptr_t ) &( xSemaphoreBuffers[ 0 ] );
+
+    printf( "configUSE_CACHE_LINE_LAYOUT %d, semaphore size %lu bytes, %lu bytes apart, first at offset %lu in a %d byte line\r\n",
+            configUSE_CACHE_LINE_LAYOUT,
+            ( unsigned long ) sizeof( StaticSemaphore_t ),
+            ( unsigned long ) uxDistance,
+            ( unsigned long ) ( ( uintptr_t ) &( xSemaphoreBuffers[ 0 ] ) % configCACHE_LINE_SIZE ),
+            configCACHE_LINE_SIZE );
+
+    if( sysconf( _SC_NPROCESSORS_ONLN ) < 2 )
+    {
+        printf( "At least two host CPUs are needed, skipped\r\n" );
+        return 0;
+    }
+
+    printf( "%-12s %10s %10s\r\n", "scenario", "mean (ns)", "best (ns)" );
+
+    prvRunScenario( "private x1", prvPrivateThread, NULL, pdFALSE );
+    prvRunScenario( "private x2", prvPrivateThread, prvPrivateThread, pdTRUE );
+    prvRunScenario( "round trip", prvPingThread, prvPongThread, pdFALSE );
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunScenario( const char * pcName,
+                            void * ( *pvFirst )( void * ),
+                            void * ( *pvSecond )( void * ),
+                            BaseType_t xBothTimed )
+{
+    BenchThread_t xThreads[ 2 ];
+    uint64_t ullTotal = 0, ullBest = UINT64_MAX, ullRun;
+    int iRun;
+
+    for( iRun = 0; iRun < benchRUNS; iRun++ )
+    {
+        prvCreateSemaphores();
+
+        xThreads[ 0 ].iCPU = 0;
+        xThreads[ 0 ].pvFunction = pvFirst;
+        xThreads[ 0 ].xOwn = xSemaphores[ benchPING ];
+        xThreads[ 0 ].xOther = xSemaphores[ benchPONG ];
+        xThreads[ 1 ].iCPU = 1;
+        xThreads[ 1 ].pvFunction = pvSecond;
+        xThreads[ 1 ].xOwn = xSemaphores[ benchPONG ];
+        xThreads[ 1 ].xOther = xSemaphores[ benchPING ];
+
+        prvRunThreads( xThreads, ( pvSecond == NULL ) ? 1 : 2 );
+
+        ullRun = xThreads[ 0 ].ullNanoseconds;
+
+        if( xBothTimed != pdFALSE )
+        {
+            ullRun = ( ullRun + xThreads[ 1 ].ullNanoseconds ) / 2U;
+        }
+
+        ullTotal += ullRun;
+
+        if( ullRun < ullBest )
+        {
+            ullBest = ullRun;
+        }
+    }
+
+    printf( "%-12s %10.1f %10.1f\r\n", pcName,
+            ( double ) ullTotal / ( double ) ( benchRUNS * benchITERATIONS ),
+            ( double ) ullBest / ( double ) benchITERATIONS );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunThreads( BenchThread_t * pxThreads,
+                           BaseType_t xThreads )
+{
+    pthread_t xHandles[ 2 ];
+    cpu_set_t xCPUs;
+    BaseType_t x;
+
+    xStart = pdFALSE;
+
+    for( x = 0; x < xThreads; x++ )
+    {
+        configASSERT( pthread_create( &( xHandles[ x ] ), NULL, pxThreads[ x ].pvFunction, &( pxThreads[ x ] ) ) == 0 );
+
+        CPU_ZERO( &xCPUs );
+        CPU_SET( pxThreads[ x ].iCPU, &xCPUs );
+        ( void ) pthread_setaffinity_np( xHandles[ x ], sizeof( xCPUs ), &xCPUs );
+    }
+
+    __atomic_store_n( &xStart, pdTRUE, __ATOMIC_SEQ_CST );
+
+    for( x = 0; x < xThreads; x++ )
+    {
+        configASSERT( pthread_join( xHandles[ x ], NULL ) == 0 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCreateSemaphores( void )
+{
+    BaseType_t x;
+
+    for( x = 0; x < benchSEMAPHORES; x++ )
+    {
+        xSemaphores[ x ] = xSemaphoreCreateBinaryStatic( &( xSemaphoreBuffers[ x ] ) );
+        configASSERT( xSemaphores[ x ] != NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void * prvPingThread( void * pvParameters )
+{
+    BenchThread_t * pxThread = ( BenchThread_t * ) pvParameters;
+    uint64_t ullStart;
+    uint32_t ul;
+
+    while( __atomic_load_n( &xStart, __ATOMIC_SEQ_CST ) == pdFALSE )
+    {
+    }
+
+    ullStart = prvNanoseconds();
+
+    for( ul = 0; ul < benchITERATIONS; ul++ )
+    {
+        configASSERT( xSemaphoreGive( pxThread->xOwn ) == pdPASS );
+
+        while( xSemaphoreTake( pxThread->xOther, 0 ) != pdPASS )
+        {
+        }
+    }
+
+    pxThread->ullNanoseconds = prvNanoseconds() - ullStart;
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void * prvPongThread( void * pvParameters )
+{
+    BenchThread_t * pxThread = ( BenchThread_t * ) pvParameters;
+    uint32_t ul;
+
+    for( ul = 0; ul < benchITERATIONS; ul++ )
+    {
+        while( xSemaphoreTake( pxThread->xOther, 0 ) != pdPASS )
+        {
+        }
+
+        configASSERT( xSemaphoreGive( pxThread->xOwn ) == pdPASS );
+    }
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void * prvPrivateThread( void * pvParameters )
+{
+    BenchThread_t * pxThread = ( BenchThread_t * ) pvParameters;
+    uint64_t ullStart;
+    uint32_t ul;
+
+    while( __atomic_load_n( &xStart, __ATOMIC_SEQ_CST ) == pdFALSE )
+    {
+    }
+
+    ullStart = prvNanoseconds();
+
+    for( ul = 0; ul < benchITERATIONS; ul++ )
+    {
+        configASSERT( xSemaphoreGive( pxThread->xOwn ) == pdPASS );
+        configASSERT( xSemaphoreTake( pxThread->xOwn, 0 ) == pdPASS );
+    }
+
+    pxThread->ullNanoseconds = prvNanoseconds() - ullStart;
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xNow;
+
+    clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+/* The semaphores are only ever polled, so none of the functions that block a
+ * task or unblock a waiting task are reached. */
+void vPortYield( void )
+{
+    configASSERT( pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskGetSchedulerState( void )
+{
+    return taskSCHEDULER_RUNNING;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxTaskGetNumberOfTasks( void )
+{
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskSuspendAll( void )
+{
+    configASSERT( pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskResumeAll( void )
+{
+    configASSERT( pdFALSE );
+    return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    ( void ) pxTimeOut;
+    configASSERT( pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
+                                 TickType_t * const pxTicksToWait )
+{
+    ( void ) pxTimeOut;
+    ( void ) pxTicksToWait;
+    configASSERT( pdFALSE );
+    return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskMissedYield( void )
+{
+    configASSERT( pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnEventList( List_t * const pxEventList,
+                            const TickType_t xTicksToWait )
+{
+    ( void ) pxEventList;
+    ( void ) xTicksToWait;
+    configASSERT( pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
+                                      TickType_t xTicksToWait,
+                                      const BaseType_t xWaitIndefinitely )
+{
+    ( void ) pxEventList;
+    ( void ) xTicksToWait;
+    ( void ) xWaitIndefinitely;
+    configASSERT( pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
+{
+    ( void ) pxEventList;
+    configASSERT( pdFALSE );
+    return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine )
+{
+    fprintf( stderr, "Assert failed: %s:%lu\r\n", pcFile, ulLine );
+    abort();
+}
@@ -0,0 +1,280 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Host side benchmark for configUSE_QUEUE_SIZED_COPY.
+ *
+ * The same file is built with configUSE_QUEUE_SIZED_COPY set to 0 and to 1.
+ * For each item size a queue is created, then an item is repeatedly sent to
+ * the queue and received from it again.  The time for each send and receive
+ * pair is reported.  Item sizes of 1, 2, 4 and 8 bytes use the sized copy when
+ * it is enabled, 12 bytes always uses memcpy() and shows the cost of the extra
+ * size checks.
+ *
+ * The "4 unaligned" scenario sends 4 byte items from, and receives them into,
+ * buffers at odd addresses, which the sized copy must handle as well as aligned
+ * ones.  The "4 offset 2" scenario uses buffers that are 2 but not 4 byte
+ * aligned, which is all a port with a portBYTE_ALIGNMENT of 2 can rely on.
+ *
+ * A third build also sets queueCOPY_HALF_WORDS to 1, so the 16-bit half word
+ * copy that queue.c selects on such ports is run on the host.
+ *
+ * Every received item is checked against the item sent, and a checksum of all
+ * the items received is printed, which must be the same for both builds.
+ *
+ * On the target the same comparison is made by building the kernel twice with
+ * configUSE_QUEUE_SIZED_COPY set to 0 and 1.  The sized copy relies on the
+ * compiler expanding a memcpy() of constant size inline, so the difference
+ * depends on the compiler and optimisation level.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Number of send and receive pairs timed in each run. */
+#define benchITERATIONS    ( 2000000UL )
+
+/* Number of times each scenario is run.  The fastest run is reported along
+ * with the mean, as the fastest is the least disturbed by the host. */
+#define benchRUNS          ( 5 )
+
+/* The queue length used by every scenario.  The queue never holds more than
+ * one item, but the item moves through the whole storage area, so wraps. */
+#define benchQUEUE_LENGTH  ( 8 )
+
+/* The largest item size used. */
+#define benchMAX_ITEM_SIZE ( 12 )
+
+/*-----------------------------------------------------------*/
+
+static void prvRunScenario( const char * pcName,
+                            UBaseType_t uxItemSize,
+                            size_t xOffset );
+
+static uint64_t prvNanoseconds( void );
+
+/*-----------------------------------------------------------*/
+
+static StaticQueue_t xQueueBuffer;
+
+/* Storage for the queue, aligned as statically allocated storage usually is. */
+static uint64_t ullQueueStorage[ ( ( benchQUEUE_LENGTH * benchMAX_ITEM_SIZE ) + sizeof( uint64_t ) - 1 ) / sizeof( uint64_t ) ];
+
+/* Buffers the items are sent from and received into.  The item used starts
+ * xOffset bytes into the buffer. */
+static uint64_t ullTxBuffer[ 3 ];
+static uint64_t ullRxBuffer[ 3 ];
+
+/* Sum of every byte received, across all the scenarios. */
+static uint32_t ulChecksum = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    printf( "configUSE_QUEUE_SIZED_COPY %d\r\n", configUSE_QUEUE_SIZED_COPY );
+
+    #ifdef queueCOPY_HALF_WORDS
+        printf( "queueCOPY_HALF_WORDS %d\r\n", queueCOPY_HALF_WORDS );
+    #endif
+
+    printf( "%-12s %10s %10s\r\n", "item size", "mean (ns)", "best (ns)" );
+
+    prvRunScenario( "1", 1, 0 );
+    prvRunScenario( "2", 2, 0 );
+    prvRunScenario( "4", 4, 0 );
+    prvRunScenario( "8", 8, 0 );
+    prvRunScenario( "12", 12, 0 );
+    prvRunScenario( "4 unaligned", 4, 1 );
+    prvRunScenario( "4 offset 2", 4, 2 );
+
+    printf( "checksum %08lx\r\n", ( unsigned long ) ulChecksum );
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunScenario( const char * pcName,
+                            UBaseType_t uxItemSize,
+                            size_t xOffset )
+{
+    uint8_t * const pucTx = ( uint8_t * ) ullTxBuffer + xOffset;
+    uint8_t * const pucRx = ( uint8_t * ) ullRxBuffer + xOffset;
+    QueueHandle_t xQueue;
+    uint64_t ullTotal = 0, ullBest = UINT64_MAX, ullStart, ullRun;
+    uint32_t ul;
+    UBaseType_t ux;
+    int iRun;
+
+    xQueue = xQueueCreateStatic( benchQUEUE_LENGTH, uxItemSize, ( uint8_t * ) ullQueueStorage, &xQueueBuffer );
+    configASSERT( xQueue != NULL );
+
+    for( iRun = 0; iRun < benchRUNS; iRun++ )
+    {
+        ullStart = prvNanoseconds();
+
+        for( ul = 0; ul < benchITERATIONS; ul++ )
+        {
+            pucTx[ 0 ] = ( uint8_t ) ul;
+            pucTx[ uxItemSize - 1U ] = ( uint8_t ) ( ul >> 8 );
+
+            configASSERT( xQueueSend( xQueue, pucTx, 0 ) == pdPASS );
+            configASSERT( xQueueReceive( xQueue, pucRx, 0 ) == pdPASS );
+
+            /* Only the first and last bytes change, which is enough to show a
+             * copy of the wrong length or from the wrong place. */
+            configASSERT( pucRx[ 0 ] == pucTx[ 0 ] );
+            configASSERT( pucRx[ uxItemSize - 1U ] == pucTx[ uxItemSize - 1U ] );
+        }
+
+        ullRun = prvNanoseconds() - ullStart;
+        ullTotal += ullRun;
+
+        if( ullRun < ullBest )
+        {
+            ullBest = ullRun;
+        }
+    }
+
+    for( ux = 0; ux < uxItemSize; ux++ )
+    {
+        ulChecksum = ( ulChecksum * 31U ) + pucRx[ ux ];
+    }
+
+    printf( "%-12s %10.1f %10.1f\r\n", pcName,
+            ( double ) ullTotal / ( double ) ( benchRUNS * benchITERATIONS ),
+            ( double ) ullBest / ( double ) benchITERATIONS );
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xNow;
+
+    clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+/* The queue is only ever used without a block time by one thread, so none of
+ * the functions that block a task or unblock a waiting task are reached. */
+void vPortYield( void )
+{
+    configASSERT( pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskGetSchedulerState( void )
+{
+    return taskSCHEDULER_RUNNING;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxTaskGetNumberOfTasks( void )
+{
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskSuspendAll( void )
+{
+    configASSERT( pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskResumeAll( void )
+{
+    configASSERT( pdFALSE );
+    return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    ( void ) pxTimeOut;
+    configASSERT( pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
+                                 TickType_t * const pxTicksToWait )
+{
+    ( void ) pxTimeOut;
+    ( void ) pxTicksToWait;
+    configASSERT( pdFALSE );
+    return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskMissedYield( void )
+{
+    configASSERT( pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnEventList( List_t * const pxEventList,
+                            const TickType_t xTicksToWait )
+{
+    ( void ) pxEventList;
+    ( void ) xTicksToWait;
+    configASSERT( pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
+                                      TickType_t xTicksToWait,
+                                      const BaseType_t xWaitIndefinitely )
+{
+    ( void ) pxEventList;
+    ( void ) xTicksToWait;
+    ( void ) xWaitIndefinitely;
+    configASSERT( pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
+{
+    ( void ) pxEventList;
+    configASSERT( pdFALSE );
+    return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine )
+{
+    fprintf( stderr, "Assert failed: %s:%lu\r\n", pcFile, ulLine );
+    abort();
+}
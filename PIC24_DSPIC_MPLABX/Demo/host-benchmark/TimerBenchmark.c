@@ -0,0 +1,482 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Host side benchmark for the software timer service.
+ *
+ * timers.c is compiled into this file so the private functions that make up the
+ * timer service task can be driven one loop iteration at a time from a single
+ * native thread.  The queue and task functions that timers.c depends on are
+ * replaced by the simple stand-ins below, and the tick count only moves
+ * forward when the timer service task would otherwise block.  The same file is
+ * built once with the sorted active timer lists (configUSE_TIMER_WHEEL == 0)
+ * and once with the timing wheel (configUSE_TIMER_WHEEL == 1).
+ *
+ * Three things are reported for 10, 100, 1,000 and 10,000 active timers:
+ *
+ * + The average cost of the timer service task processing a reset command,
+ *   which removes a timer from the active timers and inserts it again.
+ *
+ * + The average cost of the timer service task processing an expiry,
+ *   including any work done moving timers between wheel levels.
+ *
+ * + A checksum of the identity of each timer that expired and the tick count
+ *   at which it expired, for a run of random start, reset, stop and period
+ *   change commands that crosses a tick count overflow.  The checksum must be
+ *   the same for both builds, otherwise the timing wheel has changed the
+ *   behaviour of the timers.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* The timer implementation under test.  The include path must contain
+ * PIC24_DSPIC_MPLABX/Source. */
+#include "timers.c"
+
+/* Number of commands sent by each timing measurement. */
+#define benchRESET_COMMANDS       ( 20000UL )
+
+/* Number of expiries timed by each timing measurement. */
+#define benchEXPIRIES             ( 20000UL )
+
+/* Number of random commands sent while computing the checksum. */
+#define benchCHECKSUM_COMMANDS    ( 200000UL )
+
+/* Largest number of timers used by any test. */
+#define benchMAX_TIMERS           ( 10000UL )
+
+/* Tick count at the start of each test.  Close enough to the overflow that
+ * the overflow is crossed during every test. */
+#define benchSTART_TICK           ( ( TickType_t ) ( portMAX_DELAY - ( TickType_t ) 50000UL ) )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Run one iteration of the timer service task's loop, then move the tick
+ * count forward to whichever comes first out of the time at which the task
+ * would unblock and xWakeTime, at which point a command is sent to the task.
+ * Returns pdTRUE when xWakeTime has been reached.
+ */
+static BaseType_t prvServiceTimers( TickType_t xWakeTime );
+
+/*
+ * Run the timer service task until the tick count reaches xWakeTime.
+ */
+static void prvRunUntil( TickType_t xWakeTime );
+
+/*
+ * Start uxTimers auto-reload timers with random periods in the range
+ * [ 1, xMaxPeriod ], having first stopped any timers left over from a previous
+ * test.
+ */
+static void prvStartTimers( UBaseType_t uxTimers,
+                            TickType_t xMaxPeriod );
+
+static void prvTimerCallback( TimerHandle_t xTimer );
+static uint32_t prvRand( void );
+static uint64_t prvNanoseconds( void );
+
+/*-----------------------------------------------------------*/
+
+/* The timers, and the stand-in for the timer command queue. */
+static StaticTimer_t xTimerBuffers[ benchMAX_TIMERS ];
+static TimerHandle_t xTimers[ benchMAX_TIMERS ];
+static StaticQueue_t xStaticTimerQueue;
+static DaemonTaskMessage_t xCommands[ configTIMER_QUEUE_LENGTH ];
+static UBaseType_t uxCommandHead = 0, uxCommandsWaiting = 0;
+
+/* The simulated tick count, and the state of the simulated timer service
+ * task. */
+static TickType_t xTickCount = benchSTART_TICK;
+static BaseType_t xTimerTaskWaiting = pdFALSE;
+static BaseType_t xTimerTaskBlocked = pdFALSE;
+static BaseType_t xTimerTaskBlockIndefinitely = pdFALSE;
+static TickType_t xTimerTaskBlockTime = 0;
+
+/* Expiry statistics. */
+static uint32_t ulExpiries = 0, ulChecksum = 0;
+static uint32_t ulRandSeed = 0x12345678UL;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    static const UBaseType_t uxTimerCounts[] = { 10U, 100U, 1000U, 10000U };
+    UBaseType_t uxTest, uxTimer;
+    uint32_t ulCommand, ulFirstExpiry;
+    uint64_t ullStart, ullResetTime, ullExpiryTime;
+    TickType_t xNow;
+    BaseType_t xCommandId;
+
+    for( uxTimer = 0; uxTimer < benchMAX_TIMERS; uxTimer++ )
+    {
+        xTimers[ uxTimer ] = xTimerCreateStatic( "Bench", 1, pdTRUE, ( void * ) uxTimer, prvTimerCallback, &( xTimerBuffers[ uxTimer ] ) );
+        configASSERT( xTimers[ uxTimer ] );
+    }
+
+    printf( "Timer backend: %s\r\n", ( configUSE_TIMER_WHEEL == 1 ) ? "timing wheel" : "sorted lists" );
+    printf( "%8s %12s %12s\r\n", "timers", "reset (ns)", "expiry (ns)" );
+
+    for( uxTest = 0; uxTest < ( sizeof( uxTimerCounts ) / sizeof( uxTimerCounts[ 0 ] ) ); uxTest++ )
+    {
+        /* Timers with long periods so the reset commands do not also cause
+         * expiries. */
+        prvStartTimers( uxTimerCounts[ uxTest ], ( TickType_t ) 1000000UL );
+        ullStart = prvNanoseconds();
+
+        for( ulCommand = 0; ulCommand < benchRESET_COMMANDS; ulCommand++ )
+        {
+            xTimerReset( xTimers[ prvRand() % uxTimerCounts[ uxTest ] ], 0 );
+            prvProcessReceivedCommands();
+        }
+
+        ullResetTime = prvNanoseconds() - ullStart;
+
+        /* Timers with periods that spread the expiries over the whole range of
+         * wheel levels. */
+        prvStartTimers( uxTimerCounts[ uxTest ], ( TickType_t ) ( uxTimerCounts[ uxTest ] * 1000UL ) );
+        ulFirstExpiry = ulExpiries;
+        ullStart = prvNanoseconds();
+
+        while( ( ulExpiries - ulFirstExpiry ) < benchEXPIRIES )
+        {
+            ( void ) prvServiceTimers( xTickCount + ( TickType_t ) 0x7fffffffUL );
+        }
+
+        ullExpiryTime = prvNanoseconds() - ullStart;
+
+        printf( "%8lu %12.1f %12.1f\r\n",
+                ( unsigned long ) uxTimerCounts[ uxTest ],
+                ( double ) ullResetTime / ( double ) benchRESET_COMMANDS,
+                ( double ) ullExpiryTime / ( double ) ( ulExpiries - ulFirstExpiry ) );
+    }
+
+    /* Random commands sent at random times, with a mix of one-shot and
+     * auto-reload timers, and periods that include the shortest possible. */
+    prvStartTimers( 200U, ( TickType_t ) 5000UL );
+    ulExpiries = 0;
+    ulChecksum = 0;
+
+    for( ulCommand = 0; ulCommand < benchCHECKSUM_COMMANDS; ulCommand++ )
+    {
+        prvRunUntil( xTickCount + ( TickType_t ) ( prvRand() % 50UL ) );
+
+        uxTimer = ( UBaseType_t ) ( prvRand() % 200UL );
+        xNow = xTaskGetTickCount();
+
+        switch( prvRand() % 4UL )
+        {
+            case 0:
+                xCommandId = tmrCOMMAND_START;
+                break;
+
+            case 1:
+                xCommandId = tmrCOMMAND_RESET;
+                break;
+
+            case 2:
+                xCommandId = tmrCOMMAND_STOP;
+                break;
+
+            default:
+                xCommandId = tmrCOMMAND_CHANGE_PERIOD;
+                vTimerSetReloadMode( xTimers[ uxTimer ], ( ( prvRand() & 1UL ) != 0UL ) ? pdTRUE : pdFALSE );
+                xNow = ( TickType_t ) ( ( prvRand() % 5000UL ) + 1UL );
+                break;
+        }
+
+        ( void ) xTimerGenericCommand( xTimers[ uxTimer ], xCommandId, xNow, NULL, 0 );
+    }
+
+    prvRunUntil( xTickCount + ( TickType_t ) 100000UL );
+
+    printf( "Expiries: %lu, checksum: 0x%08lx\r\n", ( unsigned long ) ulExpiries, ( unsigned long ) ulChecksum );
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvServiceTimers( TickType_t xWakeTime )
+{
+    TickType_t xNextExpireTime, xTicksToWake;
+    BaseType_t xListWasEmpty, xWoken = pdFALSE;
+
+    xTimerTaskBlocked = pdFALSE;
+
+    /* The body of prvTimerTask(). */
+    xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
+    prvProcessTimerOrBlockTask( xNextExpireTime, xListWasEmpty );
+    prvProcessReceivedCommands();
+
+    if( xTimerTaskBlocked != pdFALSE )
+    {
+        xTicksToWake = xWakeTime - xTickCount;
+
+        if( ( xTimerTaskBlockIndefinitely != pdFALSE ) || ( xTimerTaskBlockTime >= xTicksToWake ) )
+        {
+            xTickCount = xWakeTime;
+            xWoken = pdTRUE;
+        }
+        else
+        {
+            xTickCount += xTimerTaskBlockTime;
+        }
+    }
+
+    return xWoken;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunUntil( TickType_t xWakeTime )
+{
+    while( prvServiceTimers( xWakeTime ) == pdFALSE )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartTimers( UBaseType_t uxTimers,
+                            TickType_t xMaxPeriod )
+{
+    UBaseType_t uxTimer;
+
+    for( uxTimer = 0; uxTimer < benchMAX_TIMERS; uxTimer++ )
+    {
+        xTimerStop( xTimers[ uxTimer ], 0 );
+        prvProcessReceivedCommands();
+    }
+
+    for( uxTimer = 0; uxTimer < uxTimers; uxTimer++ )
+    {
+        vTimerSetReloadMode( xTimers[ uxTimer ], pdTRUE );
+        xTimerChangePeriod( xTimers[ uxTimer ], ( TickType_t ) ( ( prvRand() % xMaxPeriod ) + 1UL ), 0 );
+        prvProcessReceivedCommands();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+    ulExpiries++;
+    ulChecksum = ( ulChecksum * 31UL ) ^ ( ( uint32_t ) ( uintptr_t ) pvTimerGetTimerID( xTimer ) * 2654435761UL ) ^ ( uint32_t ) xTickCount;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+    /* xorshift32, so both builds see the same sequence on every host. */
+    ulRandSeed ^= ulRandSeed << 13;
+    ulRandSeed ^= ulRandSeed >> 17;
+    ulRandSeed ^= ulRandSeed << 5;
+
+    return ulRandSeed;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNanoseconds( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Stand-ins for the kernel functions used by timers.c.
+ */
+
+QueueHandle_t xQueueGenericCreateStatic( const UBaseType_t uxQueueLength,
+                                         const UBaseType_t uxItemSize,
+                                         uint8_t * pucQueueStorage,
+                                         StaticQueue_t * pxStaticQueue,
+                                         const uint8_t ucQueueType )
+{
+    ( void ) uxQueueLength;
+    ( void ) pucQueueStorage;
+    ( void ) ucQueueType;
+    configASSERT( uxItemSize == sizeof( DaemonTaskMessage_t ) );
+
+    return ( QueueHandle_t ) &xStaticTimerQueue;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
+                              const void * const pvItemToQueue,
+                              TickType_t xTicksToWait,
+                              const BaseType_t xCopyPosition )
+{
+    BaseType_t xReturn = pdFAIL;
+
+    ( void ) xQueue;
+    ( void ) xTicksToWait;
+
+    if( uxCommandsWaiting < configTIMER_QUEUE_LENGTH )
+    {
+        if( xCopyPosition == queueSEND_TO_FRONT )
+        {
+            uxCommandHead = ( uxCommandHead + configTIMER_QUEUE_LENGTH - 1U ) % configTIMER_QUEUE_LENGTH;
+            memcpy( &( xCommands[ uxCommandHead ] ), pvItemToQueue, sizeof( DaemonTaskMessage_t ) );
+        }
+        else
+        {
+            memcpy( &( xCommands[ ( uxCommandHead + uxCommandsWaiting ) % configTIMER_QUEUE_LENGTH ] ), pvItemToQueue, sizeof( DaemonTaskMessage_t ) );
+        }
+
+        uxCommandsWaiting++;
+        xReturn = pdPASS;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
+                                     const void * const pvItemToQueue,
+                                     BaseType_t * const pxHigherPriorityTaskWoken,
+                                     const BaseType_t xCopyPosition )
+{
+    if( pxHigherPriorityTaskWoken != NULL )
+    {
+        *pxHigherPriorityTaskWoken = pdFALSE;
+    }
+
+    return xQueueGenericSend( xQueue, pvItemToQueue, 0, xCopyPosition );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceive( QueueHandle_t xQueue,
+                          void * const pvBuffer,
+                          TickType_t xTicksToWait )
+{
+    BaseType_t xReturn = pdFAIL;
+
+    ( void ) xQueue;
+    ( void ) xTicksToWait;
+
+    if( uxCommandsWaiting > 0U )
+    {
+        memcpy( pvBuffer, &( xCommands[ uxCommandHead ] ), sizeof( DaemonTaskMessage_t ) );
+        uxCommandHead = ( uxCommandHead + 1U ) % configTIMER_QUEUE_LENGTH;
+        uxCommandsWaiting--;
+        xReturn = pdPASS;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vQueueWaitForMessageRestricted( QueueHandle_t xQueue,
+                                     TickType_t xTicksToWait,
+                                     const BaseType_t xWaitIndefinitely )
+{
+    ( void ) xQueue;
+
+    /* As with the real function, the task only waits if the queue is empty. */
+    if( uxCommandsWaiting == 0U )
+    {
+        xTimerTaskWaiting = pdTRUE;
+        xTimerTaskBlockTime = xTicksToWait;
+        xTimerTaskBlockIndefinitely = xWaitIndefinitely;
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+    xTimerTaskBlocked = xTimerTaskWaiting;
+    xTimerTaskWaiting = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xTaskGetTickCount( void )
+{
+    return xTickCount;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskGetSchedulerState( void )
+{
+    return taskSCHEDULER_RUNNING;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskSuspendAll( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskResumeAll( void )
+{
+    /* Never report that a yield has already been performed, so the timer
+     * service task always calls portYIELD_WITHIN_API() when it blocks. */
+    return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xTaskCreateStatic( TaskFunction_t pxTaskCode,
+                                const char * const pcName,
+                                const uint32_t ulStackDepth,
+                                void * const pvParameters,
+                                UBaseType_t uxPriority,
+                                StackType_t * const puxStackBuffer,
+                                StaticTask_t * const pxTaskBuffer )
+{
+    ( void ) pxTaskCode;
+    ( void ) pcName;
+    ( void ) ulStackDepth;
+    ( void ) pvParameters;
+    ( void ) uxPriority;
+    ( void ) puxStackBuffer;
+
+    return ( TaskHandle_t ) pxTaskBuffer;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationGetTimerTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer,
+                                     StackType_t ** ppxTimerTaskStackBuffer,
+                                     uint32_t * pulTimerTaskStackSize )
+{
+    static StaticTask_t xTimerTaskTCB;
+    static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+
+    *ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+    *ppxTimerTaskStackBuffer = uxTimerTaskStack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine )
+{
+    fprintf( stderr, "Assert failed: %s:%lu\r\n", pcFile, ulLine );
+    abort();
+}
@@ -0,0 +1,105 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+/*-----------------------------------------------------------
+ * Port specific definitions for the host side benchmarks.
+ *
+ * The benchmarks drive the kernel data structures directly from a single
+ * native thread, so there is no context switching and no interrupts to mask.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions. */
+#define portCHAR          char
+#define portFLOAT         float
+#define portDOUBLE        double
+#define portLONG          long
+#define portSHORT         short
+#define portSTACK_TYPE    uintptr_t
+#define portBASE_TYPE     long
+
+typedef portSTACK_TYPE   StackType_t;
+typedef long             BaseType_t;
+typedef unsigned long    UBaseType_t;
+
+#if ( configUSE_16_BIT_TICKS == 1 )
+    typedef uint16_t     TickType_t;
+    #define portMAX_DELAY    ( TickType_t ) 0xffff
+#else
+    typedef uint32_t     TickType_t;
+    #define portMAX_DELAY    ( TickType_t ) 0xffffffffUL
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portBYTE_ALIGNMENT     8
+#define portSTACK_GROWTH       ( -1 )
+#define portTICK_PERIOD_MS     ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portPOINTER_SIZE_TYPE  uintptr_t
+/*-----------------------------------------------------------*/
+
+/* Critical section management.  Nothing can interrupt the benchmark thread.
+ * The layout benchmark runs two threads that never write the same kernel
+ * object at the same time, so there critical sections only need to order
+ * memory accesses. */
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
+
+#if ( benchTHREADED == 1 )
+    #define portENTER_CRITICAL()    __atomic_thread_fence( __ATOMIC_SEQ_CST )
+    #define portEXIT_CRITICAL()     __atomic_thread_fence( __ATOMIC_SEQ_CST )
+#else
+    #define portENTER_CRITICAL()
+    #define portEXIT_CRITICAL()
+#endif
+/*-----------------------------------------------------------*/
+
+/* Alignment of the task and queue structures, only wanted when
+ * configUSE_CACHE_LINE_LAYOUT is set to 1. */
+#if ( configUSE_CACHE_LINE_LAYOUT == 1 )
+    #define portCACHE_LINE_ALIGNED    __attribute__( ( aligned( configCACHE_LINE_SIZE ) ) )
+#endif
+/*-----------------------------------------------------------*/
+
+/* Task utilities.  A yield is where the calling task would block, which the
+ * benchmark records so it can move time forward instead. */
+extern void vPortYield( void );
+#define portYIELD()    vPortYield()
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters )    void vFunction( void * pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters )          void vFunction( void * pvParameters )
+/*-----------------------------------------------------------*/
+
+#define portNOP()
+
+#endif /* PORTMACRO_H */
@@ -55,6 +55,7 @@
 #define configUSE_TRACE_FACILITY		0
 #define configUSE_16_BIT_TICKS			1
 #define configIDLE_SHOULD_YIELD			1
+#define configUSE_QUEUE_SIZED_COPY		1
 #define configCHECK_FOR_STACK_OVERFLOW  2
 
 /* Co-routine definitions. */
@@ -61,11 +61,43 @@
     #define eventEVENT_BITS_CONTROL_BYTES    0xff000000UL
 #endif
 
+/* When configUSE_EVENT_GROUPS_DIRECT is 1 interrupts access event groups
+ * directly, so event groups are protected by critical sections rather than by
+ * suspending the scheduler.  Tasks waiting for a single bit, or for all of a
+ * set of bits, are then held on a list per event bit. */
+#if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+    #if configUSE_16_BIT_TICKS == 1
+        #define eventNUMBER_OF_EVENT_BITS    8U
+    #else
+        #define eventNUMBER_OF_EVENT_BITS    24U
+    #endif
+
+    #define eventENTER_LOCK()    taskENTER_CRITICAL()
+    #define eventEXIT_LOCK()     prvExitCritical()
+#else
+    #define eventENTER_LOCK()    vTaskSuspendAll()
+    #define eventEXIT_LOCK()     xTaskResumeAll()
+#endif
+
+#if ( configUSE_PREEMPTION == 0 )
+
+/* If the cooperative scheduler is being used then a yield should not be
+ * performed just because a higher priority task has been woken. */
+    #define eventYIELD_IF_USING_PREEMPTION()
+#else
+    #define eventYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
+#endif
+
 typedef struct EventGroupDef_t
 {
     EventBits_t uxEventBits;
     List_t xTasksWaitingForBits; /*< List of tasks waiting for a bit to be set. */
 
+    #if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+        EventBits_t uxWaitAnyBits;                               /*< The bits waited for by the tasks in xTasksWaitingForBits, which then only holds tasks waiting for any one of several bits.  Can include bits that are no longer waited for. */
+        List_t xTasksWaitingForBit[ eventNUMBER_OF_EVENT_BITS ]; /*< Tasks waiting for a single bit, or for all of a set of bits, held on the list of a bit that is not yet set. */
+    #endif
+
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxEventGroupNumber;
     #endif
@@ -89,6 +121,61 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
                                         const EventBits_t uxBitsToWaitFor,
                                         const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Place the calling task on the list of tasks waiting for bits to be set in the
+ * event group, storing uxBitsToWaitFor and uxControlBits in its event list
+ * item, then block it for up to xTicksToWait ticks.
+ */
+static void prvPlaceOnWaitList( EventGroup_t * pxEventBits,
+                                const EventBits_t uxBitsToWaitFor,
+                                const EventBits_t uxControlBits,
+                                const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock every task on pxWaitList, returning 0 as the bits it was waiting
+ * for.  Used when the event group is deleted.
+ */
+static BaseType_t prvUnblockAllWaiters( const List_t * pxWaitList ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+
+/*
+ * Initialise the per bit lists of waiting tasks of a new event group.
+ */
+    static void prvInitialiseBitWaitLists( EventGroup_t * pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Set bits in the event group then unblock the tasks whose wait condition is
+ * met, only visiting the tasks that wait for the bits being set.  Must be
+ * called from a critical section, which can be within an ISR.  Returns pdTRUE
+ * if a task with a priority above that of the calling task was unblocked.
+ */
+    static BaseType_t prvSetBits( EventGroup_t * pxEventBits,
+                                  const EventBits_t uxBitsToSet ) PRIVILEGED_FUNCTION;
+
+/*
+ * Test each task on pxWaitList after bits have been set.  Tasks whose wait
+ * condition is met are unblocked, and tasks waiting for all of a set of bits
+ * that are not all set yet are moved to the list of a bit that is still clear.
+ */
+    static BaseType_t prvProcessWaitList( EventGroup_t * pxEventBits,
+                                          List_t * pxWaitList,
+                                          EventBits_t * puxBitsToClear ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the list of tasks waiting for the lowest bit set in uxBits.
+ */
+    static List_t * prvGetBitWaitList( EventGroup_t * pxEventBits,
+                                       const EventBits_t uxBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Exit a critical section, returning pdFALSE in place of the "already yielded"
+ * value returned by xTaskResumeAll().
+ */
+    static BaseType_t prvExitCritical( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_EVENT_GROUPS_DIRECT */
+
 /*-----------------------------------------------------------*/
 
 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -118,6 +205,12 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
             pxEventBits->uxEventBits = 0;
             vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+            #if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+            {
+                prvInitialiseBitWaitLists( pxEventBits );
+            }
+            #endif
+
             #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
             {
                 /* Both static and dynamic allocation can be used, so note that
@@ -169,6 +262,12 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
             pxEventBits->uxEventBits = 0;
             vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+            #if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+            {
+                prvInitialiseBitWaitLists( pxEventBits );
+            }
+            #endif
+
             #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
             {
                 /* Both static and dynamic allocation can be used, so note this
@@ -201,6 +300,10 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
     BaseType_t xAlreadyYielded;
     BaseType_t xTimeoutOccurred = pdFALSE;
 
+    #if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+        BaseType_t xYieldRequired;
+    #endif
+
     configASSERT( ( uxBitsToWaitFor & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
     configASSERT( uxBitsToWaitFor != 0 );
     #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
@@ -209,11 +312,19 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
     }
     #endif
 
-    vTaskSuspendAll();
+    eventENTER_LOCK();
     {
         uxOriginalBitValue = pxEventBits->uxEventBits;
 
-        ( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
+        #if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+        {
+            xYieldRequired = prvSetBits( pxEventBits, uxBitsToSet );
+        }
+        #else
+        {
+            ( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
+        }
+        #endif
 
         if( ( ( uxOriginalBitValue | uxBitsToSet ) & uxBitsToWaitFor ) == uxBitsToWaitFor )
         {
@@ -235,7 +346,7 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
                 /* Store the bits that the calling task is waiting for in the
                  * task's event list item so the kernel knows when a match is
                  * found.  Then enter the blocked state. */
-                vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+                prvPlaceOnWaitList( pxEventBits, uxBitsToWaitFor, ( eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
                 /* This assignment is obsolete as uxReturn will get set after
                  * the task unblocks, but some compilers mistakenly generate a
@@ -252,7 +363,23 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
             }
         }
     }
-    xAlreadyYielded = xTaskResumeAll();
+    xAlreadyYielded = eventEXIT_LOCK();
+
+    #if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+    {
+        /* Setting the bits might have unblocked a higher priority task.  The
+         * scheduler was not suspended, so yield here if the calling task is not
+         * about to block anyway. */
+        if( ( xYieldRequired != pdFALSE ) && ( xTicksToWait == ( TickType_t ) 0 ) )
+        {
+            eventYIELD_IF_USING_PREEMPTION();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif
 
     if( xTicksToWait != ( TickType_t ) 0 )
     {
@@ -336,7 +463,7 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
     }
     #endif
 
-    vTaskSuspendAll();
+    eventENTER_LOCK();
     {
         const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
 
@@ -394,7 +521,7 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
             /* Store the bits that the calling task is waiting for in the
              * task's event list item so the kernel knows when a match is
              * found.  Then enter the blocked state. */
-            vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+            prvPlaceOnWaitList( pxEventBits, uxBitsToWaitFor, uxControlBits, xTicksToWait );
 
             /* This is obsolete as it will get set after the task unblocks, but
              * some compilers mistakenly generate a warning about the variable
@@ -404,7 +531,7 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
             traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
         }
     }
-    xAlreadyYielded = xTaskResumeAll();
+    xAlreadyYielded = eventEXIT_LOCK();
 
     if( xTicksToWait != ( TickType_t ) 0 )
     {
@@ -498,7 +625,31 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+#if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+
+    BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup,
+                                            const EventBits_t uxBitsToClear )
+    {
+        EventGroup_t * pxEventBits = xEventGroup;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( xEventGroup );
+        configASSERT( ( uxBitsToClear & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+        traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear );
+
+        /* Clearing bits cannot unblock a task, so the bits are cleared directly
+         * rather than by deferring the operation to the timer task. */
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            pxEventBits->uxEventBits &= ~uxBitsToClear;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return pdPASS;
+    }
+
+#elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
     BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup,
                                             const EventBits_t uxBitsToClear )
@@ -511,7 +662,7 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
         return xReturn;
     }
 
-#endif /* if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) */
+#endif /* if ( configUSE_EVENT_GROUPS_DIRECT == 1 ) */
 /*-----------------------------------------------------------*/
 
 EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
@@ -530,6 +681,43 @@ EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
 } /*lint !e818 EventGroupHandle_t is a typedef used in other functions to so can't be pointer to const. */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+
+    EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
+                                    const EventBits_t uxBitsToSet )
+    {
+        EventGroup_t * pxEventBits = xEventGroup;
+        EventBits_t uxReturn;
+        BaseType_t xYieldRequired;
+
+        /* Check the user is not attempting to set the bits used by the kernel
+         * itself. */
+        configASSERT( xEventGroup );
+        configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+        taskENTER_CRITICAL();
+        {
+            traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
+
+            xYieldRequired = prvSetBits( pxEventBits, uxBitsToSet );
+            uxReturn = pxEventBits->uxEventBits;
+        }
+        taskEXIT_CRITICAL();
+
+        if( xYieldRequired != pdFALSE )
+        {
+            eventYIELD_IF_USING_PREEMPTION();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxReturn;
+    }
+
+#else /* configUSE_EVENT_GROUPS_DIRECT */
+
 EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
                                 const EventBits_t uxBitsToSet )
 {
@@ -624,30 +812,49 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
 
     return pxEventBits->uxEventBits;
 }
+
+#endif /* configUSE_EVENT_GROUPS_DIRECT */
 /*-----------------------------------------------------------*/
 
 void vEventGroupDelete( EventGroupHandle_t xEventGroup )
 {
     EventGroup_t * pxEventBits = xEventGroup;
-    const List_t * pxTasksWaitingForBits;
+    BaseType_t xYieldRequired;
 
     configASSERT( pxEventBits );
 
-    pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
-
-    vTaskSuspendAll();
+    eventENTER_LOCK();
     {
         traceEVENT_GROUP_DELETE( xEventGroup );
 
-        while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+        xYieldRequired = prvUnblockAllWaiters( &( pxEventBits->xTasksWaitingForBits ) );
+
+        #if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
         {
-            /* Unblock the task, returning 0 as the event list is being deleted
-             * and cannot therefore have any bits set. */
-            configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-            vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+            UBaseType_t uxBit;
+
+            for( uxBit = 0; uxBit < eventNUMBER_OF_EVENT_BITS; uxBit++ )
+            {
+                if( prvUnblockAllWaiters( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) ) != pdFALSE )
+                {
+                    xYieldRequired = pdTRUE;
+                }
+            }
         }
+        #endif
+    }
+
+    if( ( eventEXIT_LOCK() == pdFALSE ) && ( xYieldRequired != pdFALSE ) )
+    {
+        /* Only reached when configUSE_EVENT_GROUPS_DIRECT is 1, as
+         * xTaskResumeAll() performs any yield needed when the scheduler was
+         * suspended. */
+        eventYIELD_IF_USING_PREEMPTION();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
     }
-    ( void ) xTaskResumeAll();
 
     #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
     {
@@ -727,7 +934,286 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+static void prvPlaceOnWaitList( EventGroup_t * pxEventBits,
+                                const EventBits_t uxBitsToWaitFor,
+                                const EventBits_t uxControlBits,
+                                const TickType_t xTicksToWait )
+{
+    List_t * pxWaitList;
+
+    #if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+    {
+        if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) != ( EventBits_t ) 0 )
+        {
+            /* The wait condition cannot be met until every bit not yet set
+             * is set, so wait on the list of one of them. */
+            pxWaitList = prvGetBitWaitList( pxEventBits, uxBitsToWaitFor & ~( pxEventBits->uxEventBits ) );
+        }
+        else if( ( uxBitsToWaitFor & ( uxBitsToWaitFor - ( EventBits_t ) 1 ) ) == ( EventBits_t ) 0 )
+        {
+            /* Waiting for a single bit. */
+            pxWaitList = prvGetBitWaitList( pxEventBits, uxBitsToWaitFor );
+        }
+        else
+        {
+            /* Waiting for any one of several bits. */
+            pxWaitList = &( pxEventBits->xTasksWaitingForBits );
+            pxEventBits->uxWaitAnyBits |= uxBitsToWaitFor;
+        }
+    }
+    #else /* if ( configUSE_EVENT_GROUPS_DIRECT == 1 ) */
+    {
+        pxWaitList = &( pxEventBits->xTasksWaitingForBits );
+    }
+    #endif /* if ( configUSE_EVENT_GROUPS_DIRECT == 1 ) */
+
+    vTaskPlaceOnUnorderedEventList( pxWaitList, ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockAllWaiters( const List_t * pxWaitList )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    while( listCURRENT_LIST_LENGTH( pxWaitList ) > ( UBaseType_t ) 0 )
+    {
+        /* Unblock the task, returning 0 as the event list is being deleted
+         * and cannot therefore have any bits set. */
+        configASSERT( pxWaitList->xListEnd.pxNext != ( const ListItem_t * ) &( pxWaitList->xListEnd ) );
+
+        #if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+        {
+            if( xTaskRemoveItemFromEventList( pxWaitList->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE )
+            {
+                xHigherPriorityTaskWoken = pdTRUE;
+            }
+        }
+        #else
+        {
+            vTaskRemoveFromUnorderedEventList( pxWaitList->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+        }
+        #endif
+    }
+
+    return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+
+    static void prvInitialiseBitWaitLists( EventGroup_t * pxEventBits )
+    {
+        UBaseType_t uxBit;
+
+        pxEventBits->uxWaitAnyBits = 0;
+
+        for( uxBit = 0; uxBit < eventNUMBER_OF_EVENT_BITS; uxBit++ )
+        {
+            vListInitialise( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
+        }
+    }
+
+#endif /* configUSE_EVENT_GROUPS_DIRECT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+
+    static BaseType_t prvSetBits( EventGroup_t * pxEventBits,
+                                  const EventBits_t uxBitsToSet )
+    {
+        EventBits_t uxBitsToClear = 0, uxBitsToProcess;
+        UBaseType_t uxBit;
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+        /* Set the bits. */
+        pxEventBits->uxEventBits |= uxBitsToSet;
+
+        /* A task waiting for a single bit, or for all of a set of bits, is
+         * held on the list of a bit that was clear when it was placed there,
+         * so only the lists of the bits being set need to be looked at. */
+        uxBitsToProcess = uxBitsToSet;
+
+        for( uxBit = 0; ( uxBitsToProcess != ( EventBits_t ) 0 ) && ( uxBit < eventNUMBER_OF_EVENT_BITS ); uxBit++ )
+        {
+            if( ( uxBitsToProcess & ( ( EventBits_t ) 1 << uxBit ) ) != ( EventBits_t ) 0 )
+            {
+                uxBitsToProcess &= ~( ( EventBits_t ) 1 << uxBit );
+
+                if( prvProcessWaitList( pxEventBits, &( pxEventBits->xTasksWaitingForBit[ uxBit ] ), &uxBitsToClear ) != pdFALSE )
+                {
+                    xHigherPriorityTaskWoken = pdTRUE;
+                }
+            }
+        }
+
+        /* Tasks waiting for any one of several bits share one list, which is
+         * only looked at if one of the bits being set might be waited for.
+         * uxWaitAnyBits is rebuilt from the tasks that remain blocked. */
+        if( ( uxBitsToSet & pxEventBits->uxWaitAnyBits ) != ( EventBits_t ) 0 )
+        {
+            pxEventBits->uxWaitAnyBits = 0;
+
+            if( prvProcessWaitList( pxEventBits, &( pxEventBits->xTasksWaitingForBits ), &uxBitsToClear ) != pdFALSE )
+            {
+                xHigherPriorityTaskWoken = pdTRUE;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
+         * bit was set in the control word. */
+        pxEventBits->uxEventBits &= ~uxBitsToClear;
+
+        return xHigherPriorityTaskWoken;
+    }
+
+#endif /* configUSE_EVENT_GROUPS_DIRECT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+
+    static BaseType_t prvProcessWaitList( EventGroup_t * pxEventBits,
+                                          List_t * pxWaitList,
+                                          EventBits_t * puxBitsToClear )
+    {
+        ListItem_t * pxListItem;
+        ListItem_t * pxNext;
+        ListItem_t const * pxListEnd = listGET_END_MARKER( pxWaitList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+        EventBits_t uxBitsWaitedFor, uxControlBits;
+        BaseType_t xWaitForAllBits, xHigherPriorityTaskWoken = pdFALSE;
+
+        pxListItem = listGET_HEAD_ENTRY( pxWaitList );
+
+        while( pxListItem != pxListEnd )
+        {
+            pxNext = listGET_NEXT( pxListItem );
+            uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+
+            /* Split the bits waited for from the control bits. */
+            uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+            uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+            xWaitForAllBits = ( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) != ( EventBits_t ) 0 ) ? pdTRUE : pdFALSE;
+
+            if( prvTestWaitCondition( pxEventBits->uxEventBits, uxBitsWaitedFor, xWaitForAllBits ) != pdFALSE )
+            {
+                if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+                {
+                    *puxBitsToClear |= uxBitsWaitedFor;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Store the actual event flag value in the task's event list
+                 * item before removing the task from the event list.  The
+                 * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+                 * that is was unblocked due to its required bits matching, rather
+                 * than because it timed out. */
+                if( xTaskRemoveItemFromEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE )
+                {
+                    xHigherPriorityTaskWoken = pdTRUE;
+                }
+            }
+            else if( xWaitForAllBits != pdFALSE )
+            {
+                /* Some of the bits are still clear.  Move the task to the list
+                 * of one of them so it is not looked at again until that bit
+                 * is set. */
+                listREMOVE_ITEM( pxListItem );
+                listINSERT_END( prvGetBitWaitList( pxEventBits, uxBitsWaitedFor & ~( pxEventBits->uxEventBits ) ), pxListItem );
+            }
+            else
+            {
+                /* Still waiting for any one of several bits. */
+                pxEventBits->uxWaitAnyBits |= uxBitsWaitedFor;
+            }
+
+            pxListItem = pxNext;
+        }
+
+        return xHigherPriorityTaskWoken;
+    }
+
+#endif /* configUSE_EVENT_GROUPS_DIRECT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+
+    static List_t * prvGetBitWaitList( EventGroup_t * pxEventBits,
+                                       const EventBits_t uxBits )
+    {
+        UBaseType_t uxBit = 0;
+
+        configASSERT( uxBits != ( EventBits_t ) 0 );
+
+        while( ( ( uxBits & ( ( EventBits_t ) 1 << uxBit ) ) == ( EventBits_t ) 0 ) && ( uxBit < ( eventNUMBER_OF_EVENT_BITS - 1U ) ) )
+        {
+            uxBit++;
+        }
+
+        return &( pxEventBits->xTasksWaitingForBit[ uxBit ] );
+    }
+
+#endif /* configUSE_EVENT_GROUPS_DIRECT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+
+    static BaseType_t prvExitCritical( void )
+    {
+        taskEXIT_CRITICAL();
+
+        return pdFALSE;
+    }
+
+#endif /* configUSE_EVENT_GROUPS_DIRECT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+
+    BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
+                                          const EventBits_t uxBitsToSet,
+                                          BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        EventGroup_t * pxEventBits = xEventGroup;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( xEventGroup );
+        configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+        traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
+
+        /* Only the tasks waiting for the bits being set are looked at, so the
+         * bits are set directly rather than by deferring the operation to the
+         * timer task. */
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( prvSetBits( pxEventBits, uxBitsToSet ) != pdFALSE )
+            {
+                if( pxHigherPriorityTaskWoken != NULL )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return pdPASS;
+    }
+
+#elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
     BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
                                           const EventBits_t uxBitsToSet,
@@ -741,7 +1227,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
         return xReturn;
     }
 
-#endif /* if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) */
+#endif /* if ( configUSE_EVENT_GROUPS_DIRECT == 1 ) */
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_TRACE_FACILITY == 1 )
@@ -355,6 +355,61 @@
 
 #endif /* configUSE_TIMERS */
 
+/* Set configUSE_TIMER_WHEEL to 1 to hold active software timers in a
+ * hierarchical timing wheel instead of a sorted list, making timer start, reset
+ * and stop O(1) in the timer service task.  Each level of the wheel has
+ * ( 1 << configTIMER_WHEEL_SLOT_BITS ) slots. */
+#ifndef configUSE_TIMER_WHEEL
+    #define configUSE_TIMER_WHEEL    0
+#endif
+
+#ifndef configTIMER_WHEEL_SLOT_BITS
+    #define configTIMER_WHEEL_SLOT_BITS    4
+#endif
+
+#if ( configUSE_TIMER_WHEEL == 1 ) && ( ( configTIMER_WHEEL_SLOT_BITS < 1 ) || ( configTIMER_WHEEL_SLOT_BITS > 5 ) )
+    #error configTIMER_WHEEL_SLOT_BITS must be between 1 and 5 inclusive.
+#endif
+
+/* Set configUSE_DELAYED_TASK_WHEEL to 1 to hold Blocked state tasks that have a
+ * timeout in a hierarchical timing wheel instead of a sorted list, so a task
+ * entering the Blocked state does not have to walk the list of other Blocked
+ * tasks.  Each level of the wheel has ( 1 << configDELAYED_TASK_WHEEL_SLOT_BITS )
+ * slots. */
+#ifndef configUSE_DELAYED_TASK_WHEEL
+    #define configUSE_DELAYED_TASK_WHEEL    0
+#endif
+
+#ifndef configDELAYED_TASK_WHEEL_SLOT_BITS
+    #define configDELAYED_TASK_WHEEL_SLOT_BITS    4
+#endif
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 ) && ( ( configDELAYED_TASK_WHEEL_SLOT_BITS < 1 ) || ( configDELAYED_TASK_WHEEL_SLOT_BITS > 5 ) )
+    #error configDELAYED_TASK_WHEEL_SLOT_BITS must be between 1 and 5 inclusive.
+#endif
+
+/* Memory pools update their free block lists with the compare and swap
+ * function from atomic.h.  atomic.h is only safe to use from both tasks and
+ * interrupts if the port can mask interrupts from any context, so by default
+ * pools only use it if the port defines portSET_INTERRUPT_MASK_FROM_ISR(), and
+ * otherwise update the free block list inside a critical section.  This must
+ * be checked before portSET_INTERRUPT_MASK_FROM_ISR() is given a default
+ * definition below. */
+#ifndef configPOOL_USE_ATOMICS
+    #ifdef portSET_INTERRUPT_MASK_FROM_ISR
+        #define configPOOL_USE_ATOMICS    1
+    #else
+        #define configPOOL_USE_ATOMICS    0
+    #endif
+#endif
+
+/* Work queues add items to their list of pending work with the same atomic.h
+ * functions, and for the same reason only do so by default when memory pools
+ * do. */
+#ifndef configWORK_QUEUE_USE_ATOMICS
+    #define configWORK_QUEUE_USE_ATOMICS    configPOOL_USE_ATOMICS
+#endif
+
 #ifndef portSET_INTERRUPT_MASK_FROM_ISR
     #define portSET_INTERRUPT_MASK_FROM_ISR()    0
 #endif
@@ -458,6 +513,24 @@
     #define traceTASK_PRIORITY_DISINHERIT( pxTCBOfMutexHolder, uxOriginalPriority )
 #endif
 
+#ifndef traceTASK_PRIORITY_CEILING
+
+/* Called when a task that takes a priority ceiling mutex is raised to the
+ * mutex's ceiling priority, and when it gives the mutex back and its priority
+ * is lowered again.  pxTCB is a pointer to the TCB of the task, and uxPriority
+ * is the task's new priority. */
+    #define traceTASK_PRIORITY_CEILING( pxTCB, uxPriority )
+#endif
+
+#ifndef traceMUTEX_CEILING_VIOLATION
+
+/* Called when the priority ceiling protocol is broken - either a task with a
+ * priority above the ceiling of a priority ceiling mutex takes the mutex, or a
+ * task finds the mutex held by another task, which can only happen if the
+ * holder blocked or was suspended while it held the mutex. */
+    #define traceMUTEX_CEILING_VIOLATION( pxMutex )
+#endif
+
 #ifndef traceBLOCKING_ON_QUEUE_RECEIVE
 
 /* Task is about to block because it cannot read from a
@@ -807,6 +880,74 @@
     #define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )
 #endif
 
+#ifndef traceCREATE_POOL
+    #define traceCREATE_POOL( xPool )
+#endif
+
+#ifndef traceCREATE_POOL_FAILED
+    #define traceCREATE_POOL_FAILED()
+#endif
+
+#ifndef traceALLOC_FROM_POOL
+    #define traceALLOC_FROM_POOL( xPool, pvBlock )
+#endif
+
+#ifndef traceALLOC_FROM_POOL_FAILED
+    #define traceALLOC_FROM_POOL_FAILED( xPool )
+#endif
+
+#ifndef traceBLOCKING_ON_POOL_ALLOC
+    #define traceBLOCKING_ON_POOL_ALLOC( xPool )
+#endif
+
+#ifndef traceALLOC_FROM_POOL_FROM_ISR
+    #define traceALLOC_FROM_POOL_FROM_ISR( xPool, pvBlock )
+#endif
+
+#ifndef traceALLOC_FROM_POOL_FROM_ISR_FAILED
+    #define traceALLOC_FROM_POOL_FROM_ISR_FAILED( xPool )
+#endif
+
+#ifndef traceFREE_TO_POOL
+    #define traceFREE_TO_POOL( xPool, pvBlock )
+#endif
+
+#ifndef traceFREE_TO_POOL_FROM_ISR
+    #define traceFREE_TO_POOL_FROM_ISR( xPool, pvBlock )
+#endif
+
+#ifndef traceDELETE_POOL
+    #define traceDELETE_POOL( xPool )
+#endif
+
+#ifndef traceBLOCKING_ON_WAIT_OBJECTS
+    #define traceBLOCKING_ON_WAIT_OBJECTS( pxObjects, uxObjectCount )
+#endif
+
+#ifndef traceWAIT_OBJECTS_READY
+    #define traceWAIT_OBJECTS_READY( pxObjects, xObjectIndex )
+#endif
+
+#ifndef traceWORK_QUEUE_CREATE
+    #define traceWORK_QUEUE_CREATE( xWorkQueue )
+#endif
+
+#ifndef traceWORK_QUEUE_CREATE_FAILED
+    #define traceWORK_QUEUE_CREATE_FAILED()
+#endif
+
+#ifndef traceWORK_QUEUE_SUBMIT
+    #define traceWORK_QUEUE_SUBMIT( xWorkQueue, xWorkItem, xSubmitted )
+#endif
+
+#ifndef traceWORK_QUEUE_SUBMIT_FROM_ISR
+    #define traceWORK_QUEUE_SUBMIT_FROM_ISR( xWorkQueue, xWorkItem, xSubmitted )
+#endif
+
+#ifndef traceWORK_QUEUE_RUN_ITEM
+    #define traceWORK_QUEUE_RUN_ITEM( xWorkQueue, xWorkItem )
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
     #define configGENERATE_RUN_TIME_STATS    0
 #endif
@@ -857,6 +998,25 @@
     #define configUSE_TICKLESS_IDLE    0
 #endif
 
+/* Set configUSE_TICKLESS_STATS to 1 to have the idle task record how often and
+ * for how long the tick was suppressed, and to let the port learn how late it
+ * wakes from its low power state so it can wake correspondingly earlier.  See
+ * vTaskGetTicklessStats() and ulTaskGetTicklessWakeCompensation(). */
+#ifndef configUSE_TICKLESS_STATS
+    #define configUSE_TICKLESS_STATS    0
+#endif
+
+/* Each wake error reported by the port moves the learned wake compensation by
+ * 1 / ( 2 ^ configTICKLESS_WAKE_LATENCY_SHIFT ) of the error, so the
+ * compensation follows the average latency rather than the latest one. */
+#ifndef configTICKLESS_WAKE_LATENCY_SHIFT
+    #define configTICKLESS_WAKE_LATENCY_SHIFT    3
+#endif
+
+#if ( ( configUSE_TICKLESS_STATS == 1 ) && ( configUSE_TICKLESS_IDLE == 0 ) )
+    #error configUSE_TICKLESS_STATS requires configUSE_TICKLESS_IDLE to be set to a value other than 0
+#endif
+
 #ifndef configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING
     #define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )
 #endif
@@ -885,6 +1045,31 @@
     #define portDONT_DISCARD
 #endif
 
+/* Set configUSE_CACHE_LINE_LAYOUT to 1 to order the members of the task and
+ * queue structures so the members used on every scheduling decision and every
+ * queue send and receive are held together at the start of the structure, and
+ * to align task and queue structures to configCACHE_LINE_SIZE bytes so no two
+ * of them share a cache line.  The port, or FreeRTOSConfig.h, must then define
+ * portCACHE_LINE_ALIGNED as the compiler's way of aligning a structure member
+ * to configCACHE_LINE_SIZE bytes.  Objects allocated by pvPortMalloc() are
+ * only aligned to portBYTE_ALIGNMENT bytes, so create tasks and queues
+ * statically where the alignment is required. */
+#ifndef configUSE_CACHE_LINE_LAYOUT
+    #define configUSE_CACHE_LINE_LAYOUT    0
+#endif
+
+#ifndef configCACHE_LINE_SIZE
+    #define configCACHE_LINE_SIZE    64
+#endif
+
+#ifndef portCACHE_LINE_ALIGNED
+    #if ( configUSE_CACHE_LINE_LAYOUT == 1 )
+        #error portCACHE_LINE_ALIGNED must be defined if configUSE_CACHE_LINE_LAYOUT is set to 1, for example as __attribute__( ( aligned( configCACHE_LINE_SIZE ) ) ) for GCC.
+    #else
+        #define portCACHE_LINE_ALIGNED
+    #endif
+#endif
+
 #ifndef configUSE_TIME_SLICING
     #define configUSE_TIME_SLICING    1
 #endif
@@ -947,6 +1132,182 @@
     #define configUSE_SB_COMPLETED_CALLBACK    0
 #endif
 
+/* Set configUSE_SB_LOCK_FREE to 1 to have stream and message buffers rely on
+ * their single writer and single reader, so a task sending to or receiving
+ * from a buffer only enters a critical section when it has to block, and the
+ * default send and receive completed actions only suspend the scheduler when
+ * a task is actually waiting.  xHead and xTail are then published with
+ * portMEMORY_BARRIER(), which the port must define to order memory accesses
+ * (a compiler barrier is enough on a single core), and reads and writes of a
+ * size_t must be single, indivisible accesses. */
+#ifndef configUSE_SB_LOCK_FREE
+    #define configUSE_SB_LOCK_FREE    0
+#endif
+
+/* Set configUSE_EVENT_GROUPS_DIRECT to 1 to protect event groups with critical
+ * sections instead of by suspending the scheduler.  Waiting tasks are then
+ * indexed by the event bits they wait for, so setting bits only visits the
+ * tasks waiting for those bits, and xEventGroupSetBitsFromISR() and
+ * xEventGroupClearBitsFromISR() update the event group directly rather than
+ * deferring the operation to the timer service task.  Each event group then
+ * holds one list per event bit, so uses more RAM. */
+#ifndef configUSE_EVENT_GROUPS_DIRECT
+    #define configUSE_EVENT_GROUPS_DIRECT    0
+#endif
+
+/* Set configUSE_WAIT_OBJECTS to 1 to include xWaitForMultipleObjects(), which
+ * lets a task block on any mix of queues, semaphores, stream buffers, message
+ * buffers and its own task notifications at once.  A task waiting for several
+ * objects is unblocked using the task notification at index
+ * configWAIT_OBJECTS_NOTIFY_INDEX, so tasks that call xWaitForMultipleObjects()
+ * must not use that index for anything else. */
+#ifndef configUSE_WAIT_OBJECTS
+    #define configUSE_WAIT_OBJECTS    0
+#endif
+
+#ifndef configWAIT_OBJECTS_NOTIFY_INDEX
+    #define configWAIT_OBJECTS_NOTIFY_INDEX    ( configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 )
+#endif
+
+#if ( ( configUSE_WAIT_OBJECTS == 1 ) && ( configUSE_TASK_NOTIFICATIONS != 1 ) )
+    #error configUSE_WAIT_OBJECTS requires configUSE_TASK_NOTIFICATIONS to be set to 1
+#endif
+
+/* Set configUSE_RUN_TIME_HISTOGRAMS to 1 to have the kernel keep, for each
+ * task, a histogram of the length of the periods it spends in the Running
+ * state and a histogram of how long it waits in the Ready state before it
+ * runs, along with the total busy and idle time of the processor.  Bucket n of
+ * each histogram counts periods of between 2^n and (2^(n+1))-1 run time
+ * counter ticks, with bucket 0 also counting periods of 0 ticks and the last
+ * bucket also counting all longer periods.  Uses the run time stats counter,
+ * so configGENERATE_RUN_TIME_STATS must also be 1. */
+#ifndef configUSE_RUN_TIME_HISTOGRAMS
+    #define configUSE_RUN_TIME_HISTOGRAMS    0
+#endif
+
+#ifndef configRUN_TIME_HISTOGRAM_BUCKETS
+    #define configRUN_TIME_HISTOGRAM_BUCKETS    16
+#endif
+
+#if ( ( configUSE_RUN_TIME_HISTOGRAMS == 1 ) && ( configGENERATE_RUN_TIME_STATS != 1 ) )
+    #error configUSE_RUN_TIME_HISTOGRAMS requires configGENERATE_RUN_TIME_STATS to be set to 1
+#endif
+
+#if ( ( configRUN_TIME_HISTOGRAM_BUCKETS < 1 ) || ( configRUN_TIME_HISTOGRAM_BUCKETS > 32 ) )
+    #error configRUN_TIME_HISTOGRAM_BUCKETS must be between 1 and 32
+#endif
+
+/* Set configUSE_STACK_SAMPLER to 1 to have the idle task find the stack high
+ * water mark of every task a little at a time, so monitoring code can read a
+ * recent value with xTaskGetStackSample() instead of calling
+ * uxTaskGetStackHighWaterMark(), which scans the whole of the unused stack in
+ * one go.  Each time the idle task runs it checks at most
+ * configSTACK_SAMPLER_WORDS_PER_STEP words of one task's stack.  On ports where
+ * pxTopOfStack holds the saved stack pointer of the task being switched out
+ * when vTaskSwitchContext() is called - the ports that support stack overflow
+ * checking method 1 - also set configSTACK_SAMPLER_RECORD_SWITCH_SP to 1 to
+ * record the deepest stack pointer seen at a context switch. */
+#ifndef configUSE_STACK_SAMPLER
+    #define configUSE_STACK_SAMPLER    0
+#endif
+
+#ifndef configSTACK_SAMPLER_WORDS_PER_STEP
+    #define configSTACK_SAMPLER_WORDS_PER_STEP    32
+#endif
+
+#ifndef configSTACK_SAMPLER_RECORD_SWITCH_SP
+    #define configSTACK_SAMPLER_RECORD_SWITCH_SP    0
+#endif
+
+#if ( configSTACK_SAMPLER_WORDS_PER_STEP < 1 )
+    #error configSTACK_SAMPLER_WORDS_PER_STEP must be at least 1
+#endif
+
+/* Set configUSE_QUEUE_SIZED_COPY to 1 to have queues copy items of 1, 2, 4 and
+ * 8 bytes with a memcpy() of constant size, which an optimising compiler
+ * expands inline, instead of a memcpy() of a size only known at run time,
+ * which it cannot.  On GCC based ports where portBYTE_ALIGNMENT is 2, such as
+ * PIC24, dsPIC and PIC32MM, items of 2, 4 and 8 bytes with even source and
+ * destination addresses are copied as 16-bit half words instead.  See
+ * Demo/host-benchmark for how the option is measured. */
+#ifndef configUSE_QUEUE_SIZED_COPY
+    #define configUSE_QUEUE_SIZED_COPY    0
+#endif
+
+/* Set configUSE_PRIORITY_CEILING_MUTEXES to 1 to include
+ * xSemaphoreCreateMutexWithCeiling(), which creates a mutex that uses the
+ * immediate priority ceiling protocol in place of priority inheritance.  A task
+ * that takes such a mutex is raised to the mutex's ceiling priority straight
+ * away, so no other task that uses the mutex can run until it is given back.
+ * Set configUSE_MUTEX_CEILING_VIOLATION_HOOK to 1 to have
+ * vApplicationMutexCeilingViolationHook() called when the protocol is broken. */
+#ifndef configUSE_PRIORITY_CEILING_MUTEXES
+    #define configUSE_PRIORITY_CEILING_MUTEXES    0
+#endif
+
+#ifndef configUSE_MUTEX_CEILING_VIOLATION_HOOK
+    #define configUSE_MUTEX_CEILING_VIOLATION_HOOK    0
+#endif
+
+#if ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_PRIORITY_CEILING_MUTEXES requires configUSE_MUTEXES to be set to 1
+#endif
+
+/* Set configUSE_WORK_QUEUES to 1 to include the work queue API in
+ * work_queue.h.  A work queue is a kernel owned task, created at a priority
+ * chosen by the application, that runs work items submitted to it from tasks
+ * and interrupts.  Each application can create as many work queues as it has
+ * priority levels of deferred work. */
+#ifndef configUSE_WORK_QUEUES
+    #define configUSE_WORK_QUEUES    0
+#endif
+
+#if ( ( configUSE_WORK_QUEUES == 1 ) && ( configUSE_TASK_NOTIFICATIONS != 1 ) )
+    #error configUSE_WORK_QUEUES requires configUSE_TASK_NOTIFICATIONS to be set to 1
+#endif
+
+/* Set configUSE_NOTIFY_OBJECTS to 1 to include the mailboxes, counting
+ * semaphores and event flags in notify_objects.h.  Each of those objects is
+ * owned by a single task and held in one index of that task's notification
+ * array, so is smaller and faster than the equivalent queue, semaphore or event
+ * group, but only its owner can block on it. */
+#ifndef configUSE_NOTIFY_OBJECTS
+    #define configUSE_NOTIFY_OBJECTS    0
+#endif
+
+#if ( ( configUSE_NOTIFY_OBJECTS == 1 ) && ( configUSE_TASK_NOTIFICATIONS != 1 ) )
+    #error configUSE_NOTIFY_OBJECTS requires configUSE_TASK_NOTIFICATIONS to be set to 1
+#endif
+
+/* Set configUSE_KERNEL_DATA_PAGE to 1 to have the kernel keep copies of the
+ * tick count, the number of items in each of the first
+ * configKERNEL_DATA_PAGE_QUEUES queues and the state of each of the first
+ * configKERNEL_DATA_PAGE_TASKS tasks in the kernel data page described in
+ * kernel_data.h. */
+#ifndef configUSE_KERNEL_DATA_PAGE
+    #define configUSE_KERNEL_DATA_PAGE    0
+#endif
+
+/* An MPU port whose linker script and MPU set up map the kernel_data_page
+ * section so unprivileged tasks can read but not write it defines
+ * portKERNEL_DATA_PAGE_IS_USER_READABLE as 1.  Only then do the MPU wrappers
+ * read the kernel data page instead of raising the privilege level. */
+#ifndef portKERNEL_DATA_PAGE_IS_USER_READABLE
+    #define portKERNEL_DATA_PAGE_IS_USER_READABLE    0
+#endif
+
+#ifndef configKERNEL_DATA_PAGE_QUEUES
+    #define configKERNEL_DATA_PAGE_QUEUES    8
+#endif
+
+#ifndef configKERNEL_DATA_PAGE_TASKS
+    #define configKERNEL_DATA_PAGE_TASKS    8
+#endif
+
+#if ( ( configUSE_KERNEL_DATA_PAGE == 1 ) && ( ( configKERNEL_DATA_PAGE_QUEUES < 1 ) || ( configKERNEL_DATA_PAGE_TASKS < 1 ) ) )
+    #error configKERNEL_DATA_PAGE_QUEUES and configKERNEL_DATA_PAGE_TASKS must both be at least 1
+#endif
+
 #ifndef portTICK_TYPE_IS_ATOMIC
     #define portTICK_TYPE_IS_ATOMIC    0
 #endif
@@ -1255,26 +1616,45 @@ typedef struct xSTATIC_LIST
  */
 typedef struct xSTATIC_TCB
 {
-    void * pxDummy1;
+    void * pxDummy1 portCACHE_LINE_ALIGNED;
     #if ( portUSING_MPU_WRAPPERS == 1 )
         xMPU_SETTINGS xDummy2;
     #endif
     StaticListItem_t xDummy3[ 2 ];
     UBaseType_t uxDummy5;
+    #if ( configUSE_CACHE_LINE_LAYOUT == 1 )
+        #if ( portCRITICAL_NESTING_IN_TCB == 1 )
+            UBaseType_t uxDummy9;
+        #endif
+        #if ( configUSE_MUTEXES == 1 )
+            UBaseType_t uxDummy12[ 2 ];
+        #endif
+        #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+            uint32_t ulDummy18[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+            uint8_t ucDummy19[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+        #endif
+        #if ( INCLUDE_xTaskAbortDelay == 1 )
+            uint8_t ucDummy21;
+        #endif
+    #endif
     void * pxDummy6;
     uint8_t ucDummy7[ configMAX_TASK_NAME_LEN ];
     #if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
         void * pxDummy8;
     #endif
-    #if ( portCRITICAL_NESTING_IN_TCB == 1 )
+    #if ( ( portCRITICAL_NESTING_IN_TCB == 1 ) && ( configUSE_CACHE_LINE_LAYOUT == 0 ) )
         UBaseType_t uxDummy9;
     #endif
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy10[ 2 ];
     #endif
-    #if ( configUSE_MUTEXES == 1 )
+    #if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_CACHE_LINE_LAYOUT == 0 ) )
         UBaseType_t uxDummy12[ 2 ];
     #endif
+    #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+        UBaseType_t uxDummy32[ 2 ];
+        uint8_t ucDummy31[ configMAX_PRIORITIES ];
+    #endif
     #if ( configUSE_APPLICATION_TASK_TAG == 1 )
         void * pxDummy14;
     #endif
@@ -1287,7 +1667,7 @@ typedef struct xSTATIC_TCB
     #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
         configTLS_BLOCK_TYPE xDummy17;
     #endif
-    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+    #if ( ( configUSE_TASK_NOTIFICATIONS == 1 ) && ( configUSE_CACHE_LINE_LAYOUT == 0 ) )
         uint32_t ulDummy18[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
         uint8_t ucDummy19[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
     #endif
@@ -1295,12 +1675,30 @@ typedef struct xSTATIC_TCB
         uint8_t uxDummy20;
     #endif
 
-    #if ( INCLUDE_xTaskAbortDelay == 1 )
+    #if ( ( INCLUDE_xTaskAbortDelay == 1 ) && ( configUSE_CACHE_LINE_LAYOUT == 0 ) )
         uint8_t ucDummy21;
     #endif
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iDummy22;
     #endif
+    #if ( configUSE_WAIT_OBJECTS == 1 )
+        UBaseType_t uxDummy23;
+    #endif
+    #if ( configUSE_RUN_TIME_HISTOGRAMS == 1 )
+        UBaseType_t uxDummy24;
+        configRUN_TIME_COUNTER_TYPE ulDummy25;
+        uint32_t ulDummy26[ 2 ][ configRUN_TIME_HISTOGRAM_BUCKETS ];
+    #endif
+    #if ( configUSE_STACK_SAMPLER == 1 )
+        void * pxDummy27[ 3 ];
+        uint32_t ulDummy28;
+        #if ( configSTACK_SAMPLER_RECORD_SWITCH_SP == 1 )
+            void * pxDummy29;
+        #endif
+    #endif
+    #if ( configUSE_KERNEL_DATA_PAGE == 1 )
+        UBaseType_t uxDummy30;
+    #endif
 } StaticTask_t;
 
 /*
@@ -1319,17 +1717,28 @@ typedef struct xSTATIC_TCB
  */
 typedef struct xSTATIC_QUEUE
 {
-    void * pvDummy1[ 3 ];
+    void * pvDummy1[ 3 ] portCACHE_LINE_ALIGNED;
 
     union
     {
         void * pvDummy2;
         UBaseType_t uxDummy2;
+        #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+            UBaseType_t uxDummy11[ 2 ];
+        #endif
     } u;
 
+    #if ( configUSE_CACHE_LINE_LAYOUT == 1 )
+        UBaseType_t uxDummy4[ 3 ];
+        uint8_t ucDummy5[ 2 ];
+    #endif
+
     StaticList_t xDummy3[ 2 ];
-    UBaseType_t uxDummy4[ 3 ];
-    uint8_t ucDummy5[ 2 ];
+
+    #if ( configUSE_CACHE_LINE_LAYOUT == 0 )
+        UBaseType_t uxDummy4[ 3 ];
+        uint8_t ucDummy5[ 2 ];
+    #endif
 
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucDummy6;
@@ -1343,6 +1752,14 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( configUSE_WAIT_OBJECTS == 1 )
+        void * pvDummy10;
+    #endif
+
+    #if ( configUSE_KERNEL_DATA_PAGE == 1 )
+        UBaseType_t uxDummy11;
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1365,6 +1782,15 @@ typedef struct xSTATIC_EVENT_GROUP
     TickType_t xDummy1;
     StaticList_t xDummy2;
 
+    #if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+        TickType_t xDummy5;
+        #if ( configUSE_16_BIT_TICKS == 1 )
+            StaticList_t xDummy6[ 8 ];
+        #else
+            StaticList_t xDummy6[ 24 ];
+        #endif
+    #endif
+
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy3;
     #endif
@@ -1426,11 +1852,71 @@ typedef struct xSTATIC_STREAM_BUFFER
     #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
         void * pvDummy5[ 2 ];
     #endif
+    #if ( configUSE_WAIT_OBJECTS == 1 )
+        void * pvDummy6;
+    #endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with software engineering best practice, especially when supplying a
+ * library that is likely to change in future versions, FreeRTOS implements a
+ * strict data hiding policy.  This means the memory pool structure used
+ * internally by FreeRTOS is not accessible to application code.  However, the
+ * application writer must provide the memory required to create a memory pool,
+ * so the size of the memory pool object needs to be known.  The StaticPool_t
+ * structure below is provided for this purpose.  Its size and alignment
+ * requirements are guaranteed to match those of the genuine structure, no
+ * matter which architecture is being used, and no matter how the values in
+ * FreeRTOSConfig.h are set.  Its contents are somewhat obfuscated in the hope
+ * users will recognise that it would be unwise to make direct use of the
+ * structure members.
+ */
+typedef struct xSTATIC_POOL
+{
+    void * pvDummy1;
+    size_t xDummy2;
+    UBaseType_t uxDummy3;
+    uint32_t ulDummy4[ 2 ];
+    StaticList_t xDummy5;
+    int8_t cDummy6;
+    #if ( configUSE_TRACE_FACILITY == 1 )
+        UBaseType_t uxDummy7;
+    #endif
+} StaticPool_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the work queue and work item structures used
+ * internally by FreeRTOS are not accessible to application code.  The
+ * StaticWorkQueue_t and StaticWorkItem_t structures below are provided so the
+ * application writer can provide the memory for them.  Their size and
+ * alignment requirements are guaranteed to match those of the genuine
+ * structures, no matter which architecture is being used, and no matter how the
+ * values in FreeRTOSConfig.h are set.
+ */
+typedef struct xSTATIC_WORK_ITEM
+{
+    void * pvDummy1;
+    TaskFunction_t pvDummy2;
+    void * pvDummy3;
+    uint32_t ulDummy4[ 2 ];
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulDummy5;
+    #endif
+} StaticWorkItem_t;
+
+typedef struct xSTATIC_WORK_QUEUE
+{
+    void * pvDummy1[ 2 ];
+    uint32_t ulDummy2;
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulDummy3[ 2 ];
+    #endif
+} StaticWorkQueue_t;
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
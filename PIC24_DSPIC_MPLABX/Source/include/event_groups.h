@@ -376,6 +376,10 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
  * timer task to have the clear operation performed in the context of the timer
  * task.
  *
+ * If configUSE_EVENT_GROUPS_DIRECT is set to 1 in FreeRTOSConfig.h then event
+ * groups are protected by critical sections instead, and the bits are cleared
+ * directly without involving the timer task.  pdPASS is then always returned.
+ *
  * @note If this function returns pdPASS then the timer task is ready to run
  * and a portYIELD_FROM_ISR(pdTRUE) should be executed to perform the needed
  * clear on the event group.  This behavior is different from
@@ -418,7 +422,7 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
  * \defgroup xEventGroupClearBitsFromISR xEventGroupClearBitsFromISR
  * \ingroup EventGroup
  */
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUPS_DIRECT == 1 )
     BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup,
                                             const EventBits_t uxBitsToClear ) PRIVILEGED_FUNCTION;
 #else
@@ -517,6 +521,14 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
  * context of the timer task - where a scheduler lock is used in place of a
  * critical section.
  *
+ * If configUSE_EVENT_GROUPS_DIRECT is set to 1 in FreeRTOSConfig.h then tasks
+ * waiting for a single bit, or for all of a set of bits, are indexed by the
+ * bits they wait for, so only the tasks waiting for the bits being set are
+ * tested.  Event groups are then protected by critical sections, and the bits
+ * are set directly without involving the timer task.  pdPASS is then always
+ * returned, and *pxHigherPriorityTaskWoken is set to pdTRUE if setting the bits
+ * unblocked a task with a priority above that of the interrupted task.
+ *
  * @param xEventGroup The event group in which the bits are to be set.
  *
  * @param uxBitsToSet A bitwise value that indicates the bit or bits to set.
@@ -573,7 +585,7 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
  * \defgroup xEventGroupSetBitsFromISR xEventGroupSetBitsFromISR
  * \ingroup EventGroup
  */
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUPS_DIRECT == 1 )
     BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
                                           const EventBits_t uxBitsToSet,
                                           BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
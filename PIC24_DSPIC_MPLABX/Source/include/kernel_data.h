@@ -0,0 +1,188 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef KERNEL_DATA_H
+#define KERNEL_DATA_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include kernel_data.h"
+#endif
+
+#include "task.h"
+#include "queue.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * The kernel data page holds copies of kernel state that tasks commonly poll -
+ * the tick count, the number of items in a queue and the state of a task.
+ * The kernel updates the page as the state changes.  Nothing else writes to
+ * it, so it can be read without a critical section and without calling into
+ * the kernel.
+ *
+ * On ports that use an MPU the page is placed in the kernel_data_page section.
+ * If the port maps that section so it is readable, but not writable, by
+ * unprivileged tasks, and says so by defining
+ * portKERNEL_DATA_PAGE_IS_USER_READABLE as 1, then the MPU wrappers for
+ * xTaskGetTickCount(), uxQueueMessagesWaiting() and eTaskGetState() read the
+ * page instead of raising and resetting the privilege level, and unprivileged
+ * tasks can also call the xKernelDataGet...() functions below directly.
+ * Otherwise the wrappers make the system call as usual.
+ *
+ * Only the first configKERNEL_DATA_PAGE_QUEUES queues and the first
+ * configKERNEL_DATA_PAGE_TASKS tasks created are described by the page, with
+ * slots being reused as queues and tasks are deleted.  Queries about anything
+ * else return pdFALSE, and the MPU wrappers then fall back to the system call.
+ */
+
+/*
+ * One queue slot of the kernel data page.  Semaphores and mutexes are queues,
+ * so also use queue slots.
+ */
+typedef struct xKERNEL_DATA_QUEUE
+{
+    void * volatile pvQueue;                /*< The queue described by this slot, or NULL if the slot is free. */
+    volatile UBaseType_t uxMessagesWaiting; /*< The number of items in the queue. */
+} KernelDataQueue_t;
+
+/*
+ * One task slot of the kernel data page.
+ */
+typedef struct xKERNEL_DATA_TASK
+{
+    void * volatile pvTask;     /*< The task described by this slot, or NULL if the slot is free. */
+    volatile eTaskState eState; /*< The state of the task, as it would be returned by eTaskGetState(). */
+} KernelDataTask_t;
+
+/*
+ * The kernel data page.  The members must not be accessed directly - use the
+ * xKernelDataGet...() functions.
+ */
+typedef struct xKERNEL_DATA_PAGE
+{
+    volatile TickType_t xTickCount;                             /*< The tick count. */
+    KernelDataQueue_t xQueues[ configKERNEL_DATA_PAGE_QUEUES ]; /*< The queues described by the page. */
+    KernelDataTask_t xTasks[ configKERNEL_DATA_PAGE_TASKS ];    /*< The tasks described by the page. */
+} KernelDataPage_t;
+
+extern KernelDataPage_t xKernelDataPage;
+
+/**
+ * kernel_data.h
+ * @code{c}
+ * TickType_t xKernelDataGetTickCount( void );
+ * @endcode
+ *
+ * Returns the tick count from the kernel data page.  Can be called by an
+ * unprivileged task without raising its privilege level, and from an
+ * interrupt.
+ *
+ * @return The count of ticks since vTaskStartScheduler was called.
+ *
+ * \defgroup xKernelDataGetTickCount xKernelDataGetTickCount
+ * \ingroup KernelData
+ */
+TickType_t xKernelDataGetTickCount( void );
+
+/**
+ * kernel_data.h
+ * @code{c}
+ * BaseType_t xKernelDataGetQueueMessagesWaiting( QueueHandle_t xQueue, UBaseType_t * puxMessagesWaiting );
+ * @endcode
+ *
+ * Reads the number of items in a queue, or the count of a semaphore, from the
+ * kernel data page.  Can be called by an unprivileged task without raising
+ * its privilege level, and from an interrupt.
+ *
+ * @param xQueue The queue being queried.
+ *
+ * @param puxMessagesWaiting Used to pass out the number of items in the queue.
+ * Not written if the function returns pdFALSE.
+ *
+ * @return pdTRUE if the queue has a slot in the kernel data page, otherwise
+ * pdFALSE, in which case use uxQueueMessagesWaiting() instead.
+ *
+ * \defgroup xKernelDataGetQueueMessagesWaiting xKernelDataGetQueueMessagesWaiting
+ * \ingroup KernelData
+ */
+BaseType_t xKernelDataGetQueueMessagesWaiting( QueueHandle_t xQueue,
+                                               UBaseType_t * puxMessagesWaiting );
+
+/**
+ * kernel_data.h
+ * @code{c}
+ * BaseType_t xKernelDataGetTaskState( TaskHandle_t xTask, eTaskState * peState );
+ * @endcode
+ *
+ * Reads the state of a task from the kernel data page.  Can be called by an
+ * unprivileged task without raising its privilege level, and from an
+ * interrupt.  Unlike eTaskGetState(), xTask cannot be NULL.
+ *
+ * @param xTask The task being queried.
+ *
+ * @param peState Used to pass out the state of the task, as eTaskGetState()
+ * would return it.  Not written if the function returns pdFALSE.
+ *
+ * @return pdTRUE if the task has a slot in the kernel data page, otherwise
+ * pdFALSE, in which case use eTaskGetState() instead.
+ *
+ * \defgroup xKernelDataGetTaskState xKernelDataGetTaskState
+ * \ingroup KernelData
+ */
+BaseType_t xKernelDataGetTaskState( TaskHandle_t xTask,
+                                    eTaskState * peState );
+
+/*-----------------------------------------------------------
+* SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
+*----------------------------------------------------------*/
+
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  They are used by
+ * queue.c and tasks.c to claim and release slots of the kernel data page, and
+ * must be called from a critical section.  The claim functions return
+ * configKERNEL_DATA_PAGE_QUEUES or configKERNEL_DATA_PAGE_TASKS if there is no
+ * free slot.
+ */
+UBaseType_t uxKernelDataClaimQueueSlot( void * pvQueue,
+                                        UBaseType_t uxMessagesWaiting ) PRIVILEGED_FUNCTION;
+void vKernelDataReleaseQueueSlot( UBaseType_t uxSlot ) PRIVILEGED_FUNCTION;
+UBaseType_t uxKernelDataClaimTaskSlot( void * pvTask,
+                                       eTaskState eState ) PRIVILEGED_FUNCTION;
+void vKernelDataReleaseTaskSlot( UBaseType_t uxSlot ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* KERNEL_DATA_H */
@@ -847,6 +847,148 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
 #define xMessageBufferReceiveCompletedFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) \
     xStreamBufferReceiveCompletedFromISR( ( xMessageBuffer ), ( pxHigherPriorityTaskWoken ) )
 
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferReserve( MessageBufferHandle_t xMessageBuffer,
+ *                               void ** ppvData,
+ *                               void ** ppvWrappedData,
+ *                               size_t xDataLengthBytes,
+ *                               TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Zero copy alternative to xMessageBufferSend().  Reserves space for a message
+ * of xDataLengthBytes bytes directly in the message buffer's storage area.  The
+ * message is written in place then made available to the reader by
+ * xMessageBufferCommit(), which also writes the message length.
+ *
+ * The message may be split by the end of the storage area.  The return value is
+ * the number of bytes at *ppvData.  If that is less than xDataLengthBytes then
+ * the remaining bytes are at *ppvWrappedData, which is otherwise set to NULL.
+ *
+ * @param xMessageBuffer The handle of the message buffer being written to.
+ *
+ * @param ppvData Set to point to the first part of the reserved message.
+ *
+ * @param ppvWrappedData Set to point to the second part of the reserved
+ * message, or NULL if the message is not split.
+ *
+ * @param xDataLengthBytes The length of the message.
+ *
+ * @param xTicksToWait The maximum amount of time to wait for space for the
+ * whole message, as per xMessageBufferSend().
+ *
+ * @return The number of bytes at *ppvData, or 0 if the message could not be
+ * reserved.
+ *
+ * Example use:
+ * @code{c}
+ * void vAFunction( MessageBufferHandle_t xMessageBuffer )
+ * {
+ * uint8_t *pucFirst, *pucWrapped;
+ * size_t xFirst;
+ * const size_t xLength = 20;
+ *
+ *  xFirst = xMessageBufferReserve( xMessageBuffer, ( void ** ) &pucFirst, ( void ** ) &pucWrapped, xLength, 0 );
+ *
+ *  if( xFirst > 0 )
+ *  {
+ *      // Build the message in place.  Bytes 0 to ( xFirst - 1 ) are at
+ *      // pucFirst, and any remaining bytes are at pucWrapped.
+ *      vBuildMessage( pucFirst, xFirst, pucWrapped, xLength - xFirst );
+ *      xMessageBufferCommit( xMessageBuffer, xLength );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xMessageBufferReserve xMessageBufferReserve
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReserve( xMessageBuffer, ppvData, ppvWrappedData, xDataLengthBytes, xTicksToWait ) \
+    xStreamBufferReserveMessage( ( xMessageBuffer ), ( ppvData ), ( ppvWrappedData ), ( xDataLengthBytes ), ( xTicksToWait ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferCommit( MessageBufferHandle_t xMessageBuffer,
+ *                              size_t xDataLengthBytes );
+ * @endcode
+ *
+ * Writes the length of a message reserved by xMessageBufferReserve() and makes
+ * the message available to the reader.  xDataLengthBytes must be the length
+ * that was reserved, or 0 to abandon the reservation.
+ *
+ * Use xMessageBufferCommitFromISR() to commit from an interrupt service
+ * routine.
+ *
+ * @return The length of the message committed.
+ *
+ * \defgroup xMessageBufferCommit xMessageBufferCommit
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferCommit( xMessageBuffer, xDataLengthBytes ) \
+    xStreamBufferCommit( ( xMessageBuffer ), ( xDataLengthBytes ) )
+
+#define xMessageBufferCommitFromISR( xMessageBuffer, xDataLengthBytes, pxHigherPriorityTaskWoken ) \
+    xStreamBufferCommitFromISR( ( xMessageBuffer ), ( xDataLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferPeek( MessageBufferHandle_t xMessageBuffer,
+ *                            void ** ppvData,
+ *                            void ** ppvWrappedData,
+ *                            size_t * pxMessageLengthBytes,
+ *                            TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Zero copy alternative to xMessageBufferReceive().  Obtains pointers to the
+ * next message in the message buffer, split at the end of the storage area in
+ * the same way as xMessageBufferReserve(), without copying it out.  The message
+ * remains in the buffer until it is released by xMessageBufferConsume().
+ *
+ * @param pxMessageLengthBytes Set to the total length of the message, which
+ * must later be passed to xMessageBufferConsume().
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for a message, as per xMessageBufferReceive().
+ *
+ * @return The number of bytes at *ppvData, or 0 if the buffer is empty.
+ *
+ * \defgroup xMessageBufferPeek xMessageBufferPeek
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferPeek( xMessageBuffer, ppvData, ppvWrappedData, pxMessageLengthBytes, xTicksToWait ) \
+    xStreamBufferPeekMessage( ( xMessageBuffer ), ( ppvData ), ( ppvWrappedData ), ( pxMessageLengthBytes ), ( xTicksToWait ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferConsume( MessageBufferHandle_t xMessageBuffer,
+ *                               size_t xDataLengthBytes );
+ * @endcode
+ *
+ * Releases the message obtained from xMessageBufferPeek() so its space can be
+ * reused.  xDataLengthBytes must be the message length returned by
+ * xMessageBufferPeek().
+ *
+ * Use xMessageBufferConsumeFromISR() to consume from an interrupt service
+ * routine.
+ *
+ * @return The length of the message released.
+ *
+ * \defgroup xMessageBufferConsume xMessageBufferConsume
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferConsume( xMessageBuffer, xDataLengthBytes ) \
+    xStreamBufferConsume( ( xMessageBuffer ), ( xDataLengthBytes ) )
+
+#define xMessageBufferConsumeFromISR( xMessageBuffer, xDataLengthBytes, pxHigherPriorityTaskWoken ) \
+    xStreamBufferConsumeFromISR( ( xMessageBuffer ), ( xDataLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+
 /* *INDENT-OFF* */
 #if defined( __cplusplus )
     } /* extern "C" */
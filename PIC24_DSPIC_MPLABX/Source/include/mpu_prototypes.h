@@ -92,6 +92,11 @@ UBaseType_t MPU_uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
                                       configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) FREERTOS_SYSTEM_CALL;
 configRUN_TIME_COUNTER_TYPE MPU_ulTaskGetIdleRunTimeCounter( void ) FREERTOS_SYSTEM_CALL;
 configRUN_TIME_COUNTER_TYPE MPU_ulTaskGetIdleRunTimePercent( void ) FREERTOS_SYSTEM_CALL;
+void MPU_vTaskGetRunTimeHistogram( TaskHandle_t xTask,
+                                   TaskHistogram_t * pxHistogram ) FREERTOS_SYSTEM_CALL;
+void MPU_vTaskGetCoreRunTime( CoreRunTime_t * pxCoreRunTime ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xTaskGetStackSample( TaskHandle_t xTask,
+                                    TaskStackSample_t * pxSample ) FREERTOS_SYSTEM_CALL;
 void MPU_vTaskList( char * pcWriteBuffer ) FREERTOS_SYSTEM_CALL;
 void MPU_vTaskGetRunTimeStats( char * pcWriteBuffer ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xTaskGenericNotify( TaskHandle_t xTaskToNotify,
@@ -129,6 +134,14 @@ BaseType_t MPU_xQueueGenericSend( QueueHandle_t xQueue,
 BaseType_t MPU_xQueueReceive( QueueHandle_t xQueue,
                               void * const pvBuffer,
                               TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xQueueSendMultiple( QueueHandle_t xQueue,
+                                   const void * const pvItemsToQueue,
+                                   const UBaseType_t uxItemCount,
+                                   TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                      void * const pvBuffer,
+                                      const UBaseType_t uxMaxItems,
+                                      TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xQueuePeek( QueueHandle_t xQueue,
                            void * const pvBuffer,
                            TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
@@ -140,6 +153,9 @@ void MPU_vQueueDelete( QueueHandle_t xQueue ) FREERTOS_SYSTEM_CALL;
 QueueHandle_t MPU_xQueueCreateMutex( const uint8_t ucQueueType ) FREERTOS_SYSTEM_CALL;
 QueueHandle_t MPU_xQueueCreateMutexStatic( const uint8_t ucQueueType,
                                            StaticQueue_t * pxStaticQueue ) FREERTOS_SYSTEM_CALL;
+QueueHandle_t MPU_xQueueCreateMutexWithCeiling( UBaseType_t uxCeilingPriority ) FREERTOS_SYSTEM_CALL;
+QueueHandle_t MPU_xQueueCreateMutexWithCeilingStatic( UBaseType_t uxCeilingPriority,
+                                                      StaticQueue_t * pxStaticQueue ) FREERTOS_SYSTEM_CALL;
 QueueHandle_t MPU_xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
                                                  const UBaseType_t uxInitialCount ) FREERTOS_SYSTEM_CALL;
 QueueHandle_t MPU_xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
@@ -246,6 +262,27 @@ size_t MPU_xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer ) FR
 size_t MPU_xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer,
                                              size_t xTriggerLevel ) FREERTOS_SYSTEM_CALL;
+size_t MPU_xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+                                 void ** ppvData,
+                                 size_t xDataLengthBytes,
+                                 TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+size_t MPU_xStreamBufferReserveMessage( StreamBufferHandle_t xStreamBuffer,
+                                        void ** ppvData,
+                                        void ** ppvWrappedData,
+                                        size_t xDataLengthBytes,
+                                        TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+size_t MPU_xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer,
+                                size_t xDataLengthBytes ) FREERTOS_SYSTEM_CALL;
+size_t MPU_xStreamBufferPeekContiguous( StreamBufferHandle_t xStreamBuffer,
+                                        void ** ppvData,
+                                        TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+size_t MPU_xStreamBufferPeekMessage( StreamBufferHandle_t xStreamBuffer,
+                                     void ** ppvData,
+                                     void ** ppvWrappedData,
+                                     size_t * pxMessageLengthBytes,
+                                     TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+size_t MPU_xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer,
+                                 size_t xDataLengthBytes ) FREERTOS_SYSTEM_CALL;
 StreamBufferHandle_t MPU_xStreamBufferGenericCreate( size_t xBufferSizeBytes,
                                                      size_t xTriggerLevelBytes,
                                                      BaseType_t xIsMessageBuffer,
@@ -259,6 +296,44 @@ StreamBufferHandle_t MPU_xStreamBufferGenericCreateStatic( size_t xBufferSizeByt
                                                            StreamBufferCallbackFunction_t pxSendCompletedCallback,
                                                            StreamBufferCallbackFunction_t pxReceiveCompletedCallback ) FREERTOS_SYSTEM_CALL;
 
+/* MPU versions of pool.h API functions. */
+PoolHandle_t MPU_xPoolCreateStatic( size_t xBlockSize,
+                                    UBaseType_t uxNumberOfBlocks,
+                                    uint8_t * pucPoolStorage,
+                                    StaticPool_t * pxStaticPool ) FREERTOS_SYSTEM_CALL;
+void * MPU_pvPoolAlloc( PoolHandle_t xPool,
+                        TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+void MPU_vPoolFree( PoolHandle_t xPool,
+                    void * pvBlock ) FREERTOS_SYSTEM_CALL;
+UBaseType_t MPU_uxPoolGetBlocksAvailable( PoolHandle_t xPool ) FREERTOS_SYSTEM_CALL;
+void MPU_vPoolDelete( PoolHandle_t xPool ) FREERTOS_SYSTEM_CALL;
+
+/* MPU versions of wait_objects.h API functions. */
+BaseType_t MPU_xWaitForMultipleObjects( const WaitObject_t * const pxObjects,
+                                        UBaseType_t uxObjectCount,
+                                        TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+
+/* MPU versions of work_queue.h API functions. */
+WorkQueueHandle_t MPU_xWorkQueueCreate( const char * const pcName,
+                                        UBaseType_t uxPriority,
+                                        configSTACK_DEPTH_TYPE usStackDepth ) FREERTOS_SYSTEM_CALL;
+WorkQueueHandle_t MPU_xWorkQueueCreateStatic( const char * const pcName,
+                                              UBaseType_t uxPriority,
+                                              uint32_t ulStackDepth,
+                                              StackType_t * const puxStackBuffer,
+                                              StaticTask_t * const pxTaskBuffer,
+                                              StaticWorkQueue_t * const pxWorkQueueBuffer ) FREERTOS_SYSTEM_CALL;
+WorkItemHandle_t MPU_xWorkItemCreateStatic( WorkFunction_t pxFunction,
+                                            void * pvParameter1,
+                                            uint32_t ulParameter2,
+                                            StaticWorkItem_t * const pxWorkItemBuffer ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue,
+                                 WorkItemHandle_t xWorkItem ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xWorkItemIsPending( WorkItemHandle_t xWorkItem ) FREERTOS_SYSTEM_CALL;
+void MPU_vWorkQueueGetStats( WorkQueueHandle_t xWorkQueue,
+                             WorkQueueStats_t * pxStats ) FREERTOS_SYSTEM_CALL;
+TaskHandle_t MPU_xWorkQueueGetTaskHandle( WorkQueueHandle_t xWorkQueue ) FREERTOS_SYSTEM_CALL;
+
 
 
 #endif /* MPU_PROTOTYPES_H */
@@ -78,6 +78,9 @@
         #define vTaskGetRunTimeStats                   MPU_vTaskGetRunTimeStats
         #define ulTaskGetIdleRunTimeCounter            MPU_ulTaskGetIdleRunTimeCounter
         #define ulTaskGetIdleRunTimePercent            MPU_ulTaskGetIdleRunTimePercent
+        #define vTaskGetRunTimeHistogram               MPU_vTaskGetRunTimeHistogram
+        #define vTaskGetCoreRunTime                    MPU_vTaskGetCoreRunTime
+        #define xTaskGetStackSample                    MPU_xTaskGetStackSample
         #define xTaskGenericNotify                     MPU_xTaskGenericNotify
         #define xTaskGenericNotifyWait                 MPU_xTaskGenericNotifyWait
         #define ulTaskGenericNotifyTake                MPU_ulTaskGenericNotifyTake
@@ -93,6 +96,8 @@
 /* Map standard queue.h API functions to the MPU equivalents. */
         #define xQueueGenericSend                      MPU_xQueueGenericSend
         #define xQueueReceive                          MPU_xQueueReceive
+        #define xQueueSendMultiple                     MPU_xQueueSendMultiple
+        #define xQueueReceiveMultiple                  MPU_xQueueReceiveMultiple
         #define xQueuePeek                             MPU_xQueuePeek
         #define xQueueSemaphoreTake                    MPU_xQueueSemaphoreTake
         #define uxQueueMessagesWaiting                 MPU_uxQueueMessagesWaiting
@@ -100,6 +105,8 @@
         #define vQueueDelete                           MPU_vQueueDelete
         #define xQueueCreateMutex                      MPU_xQueueCreateMutex
         #define xQueueCreateMutexStatic                MPU_xQueueCreateMutexStatic
+        #define xQueueCreateMutexWithCeiling           MPU_xQueueCreateMutexWithCeiling
+        #define xQueueCreateMutexWithCeilingStatic     MPU_xQueueCreateMutexWithCeilingStatic
         #define xQueueCreateCountingSemaphore          MPU_xQueueCreateCountingSemaphore
         #define xQueueCreateCountingSemaphoreStatic    MPU_xQueueCreateCountingSemaphoreStatic
         #define xQueueGetMutexHolder                   MPU_xQueueGetMutexHolder
@@ -152,9 +159,34 @@
         #define xStreamBufferSpacesAvailable           MPU_xStreamBufferSpacesAvailable
         #define xStreamBufferBytesAvailable            MPU_xStreamBufferBytesAvailable
         #define xStreamBufferSetTriggerLevel           MPU_xStreamBufferSetTriggerLevel
+        #define xStreamBufferReserve                   MPU_xStreamBufferReserve
+        #define xStreamBufferReserveMessage            MPU_xStreamBufferReserveMessage
+        #define xStreamBufferCommit                    MPU_xStreamBufferCommit
+        #define xStreamBufferPeekContiguous            MPU_xStreamBufferPeekContiguous
+        #define xStreamBufferPeekMessage               MPU_xStreamBufferPeekMessage
+        #define xStreamBufferConsume                   MPU_xStreamBufferConsume
         #define xStreamBufferGenericCreate             MPU_xStreamBufferGenericCreate
         #define xStreamBufferGenericCreateStatic       MPU_xStreamBufferGenericCreateStatic
 
+/* Map standard pool.h API functions to the MPU equivalents. */
+        #define xPoolCreateStatic                      MPU_xPoolCreateStatic
+        #define pvPoolAlloc                            MPU_pvPoolAlloc
+        #define vPoolFree                              MPU_vPoolFree
+        #define uxPoolGetBlocksAvailable               MPU_uxPoolGetBlocksAvailable
+        #define vPoolDelete                            MPU_vPoolDelete
+
+/* Map standard wait_objects.h API functions to the MPU equivalents. */
+        #define xWaitForMultipleObjects                MPU_xWaitForMultipleObjects
+
+/* Map standard work_queue.h API functions to the MPU equivalents. */
+        #define xWorkQueueCreate                       MPU_xWorkQueueCreate
+        #define xWorkQueueCreateStatic                 MPU_xWorkQueueCreateStatic
+        #define xWorkItemCreateStatic                  MPU_xWorkItemCreateStatic
+        #define xWorkQueueSubmit                       MPU_xWorkQueueSubmit
+        #define xWorkItemIsPending                     MPU_xWorkItemIsPending
+        #define vWorkQueueGetStats                     MPU_vWorkQueueGetStats
+        #define xWorkQueueGetTaskHandle                MPU_xWorkQueueGetTaskHandle
+
 
 /* Remove the privileged function macro, but keep the PRIVILEGED_DATA
  * macro so applications can place data in privileged access sections
@@ -162,6 +194,7 @@
         #define PRIVILEGED_FUNCTION
         #define PRIVILEGED_DATA    __attribute__( ( section( "privileged_data" ) ) )
         #define FREERTOS_SYSTEM_CALL
+        #define KERNEL_DATA_PAGE   __attribute__( ( section( "kernel_data_page" ) ) )
 
     #else /* MPU_WRAPPERS_INCLUDED_FROM_API_FILE */
 
@@ -169,6 +202,7 @@
         #define PRIVILEGED_FUNCTION     __attribute__( ( section( "privileged_functions" ) ) )
         #define PRIVILEGED_DATA         __attribute__( ( section( "privileged_data" ) ) )
         #define FREERTOS_SYSTEM_CALL    __attribute__( ( section( "freertos_system_calls" ) ) )
+        #define KERNEL_DATA_PAGE        __attribute__( ( section( "kernel_data_page" ) ) )
 
     #endif /* MPU_WRAPPERS_INCLUDED_FROM_API_FILE */
 
@@ -177,6 +211,7 @@
     #define PRIVILEGED_FUNCTION
     #define PRIVILEGED_DATA
     #define FREERTOS_SYSTEM_CALL
+    #define KERNEL_DATA_PAGE
 
 #endif /* portUSING_MPU_WRAPPERS */
 
@@ -0,0 +1,430 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef NOTIFY_OBJECTS_H
+#define NOTIFY_OBJECTS_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include notify_objects.h"
+#endif
+
+#include "task.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Notification objects are mailboxes, counting semaphores and event flags that
+ * are built on the task notification array, in the same way that semphr.h
+ * builds semaphores on queue.h.  Each object belongs to a single task - the
+ * only task that can receive from, take or wait on it - and to one index of
+ * that task's notification array.  Any task or interrupt can post to, give or
+ * set the object.
+ *
+ * Because a notification object does not hold a list of waiting tasks and
+ * unblocks its owner directly, it is smaller and faster than the equivalent
+ * queue, semaphore or event group.  The cost is that the owning task must not
+ * use the object's notification index for anything else, including
+ * configWAIT_OBJECTS_NOTIFY_INDEX if the task also calls
+ * xWaitForMultipleObjects(), and that only the owner can block on it.
+ *
+ * The functions in this file only use the public task notification API, so
+ * they are not part of the kernel's privileged code on ports that use an MPU.
+ */
+
+/*
+ * A mailbox holds one pointer sized message.  The message itself is held in
+ * the mailbox, not in the notification value, because a notification value is
+ * only 32-bits and a pointer can be wider.  The members must not be accessed
+ * directly - use vNotifyMailboxInit() to initialise the structure.
+ */
+typedef struct xNOTIFY_MAILBOX
+{
+    TaskHandle_t xReader;      /*< The only task that receives from the mailbox. */
+    UBaseType_t uxIndex;       /*< The index of xReader's notification array used by the mailbox. */
+    void * volatile pvMessage; /*< The message waiting to be received, or NULL if the mailbox is empty. */
+} NotifyMailbox_t;
+
+/*
+ * A counting semaphore held in the notification value of its owner.  The
+ * members must not be accessed directly - use vNotifySemaphoreInit() to
+ * initialise the structure.
+ */
+typedef struct xNOTIFY_SEMAPHORE
+{
+    TaskHandle_t xOwner; /*< The only task that takes the semaphore. */
+    UBaseType_t uxIndex; /*< The index of xOwner's notification array used as the count. */
+} NotifySemaphore_t;
+
+/*
+ * Up to 32 event flags held in the notification value of their owner.  The
+ * members must not be accessed directly - use vNotifyEventFlagsInit() to
+ * initialise the structure.
+ */
+typedef struct xNOTIFY_EVENT_FLAGS
+{
+    TaskHandle_t xOwner; /*< The only task that waits for the flags. */
+    UBaseType_t uxIndex; /*< The index of xOwner's notification array that holds the flags. */
+} NotifyEventFlags_t;
+
+/**
+ * notify_objects.h
+ * @code{c}
+ * void vNotifyMailboxInit( NotifyMailbox_t * const pxMailbox,
+ *                          TaskHandle_t xReader,
+ *                          UBaseType_t uxIndex );
+ * @endcode
+ *
+ * Initialises an empty mailbox.
+ *
+ * @param pxMailbox The mailbox being initialised.
+ *
+ * @param xReader The handle of the only task that will receive from the
+ * mailbox.
+ *
+ * @param uxIndex The index of xReader's notification array used to unblock
+ * xReader when a message is posted.  Must be less than
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES.
+ *
+ * Example use:
+ * @code{c}
+ *
+ * static NotifyMailbox_t xRxMailbox;
+ *
+ * // Runs in the task that created xRxTask.
+ * vNotifyMailboxInit( &xRxMailbox, xRxTask, 1 );
+ *
+ * // Runs in any task, or in an interrupt using xNotifyMailboxPostFromISR().
+ * if( xNotifyMailboxPost( &xRxMailbox, pxBuffer ) != pdPASS )
+ * {
+ *     // The previous message has not been received yet.
+ * }
+ *
+ * // Runs in xRxTask.
+ * void * pvBuffer;
+ *
+ * if( xNotifyMailboxReceive( &xRxMailbox, &pvBuffer, portMAX_DELAY ) == pdPASS )
+ * {
+ *     // Process the buffer pointed to by pvBuffer here.
+ * }
+ *
+ * @endcode
+ * \defgroup vNotifyMailboxInit vNotifyMailboxInit
+ * \ingroup NotifyObjects
+ */
+void vNotifyMailboxInit( NotifyMailbox_t * const pxMailbox,
+                         TaskHandle_t xReader,
+                         UBaseType_t uxIndex );
+
+/**
+ * notify_objects.h
+ * @code{c}
+ * BaseType_t xNotifyMailboxPost( NotifyMailbox_t * const pxMailbox,
+ *                                void * pvMessage );
+ * @endcode
+ *
+ * Posts a message to a mailbox and unblocks the mailbox's reader if it is
+ * waiting for the message.  A mailbox holds a single message, so posting never
+ * blocks - it fails if the previous message has not been received.
+ *
+ * Do not call this function from an interrupt service routine.  See
+ * xNotifyMailboxPostFromISR() for an alternative that can be used from an ISR.
+ *
+ * @param pxMailbox The mailbox to which the message is posted.
+ *
+ * @param pvMessage The message.  Must not be NULL, as NULL marks an empty
+ * mailbox.
+ *
+ * @return pdPASS if the message was posted, or pdFAIL if the mailbox already
+ * held a message.
+ *
+ * \defgroup xNotifyMailboxPost xNotifyMailboxPost
+ * \ingroup NotifyObjects
+ */
+BaseType_t xNotifyMailboxPost( NotifyMailbox_t * const pxMailbox,
+                               void * pvMessage );
+
+/**
+ * notify_objects.h
+ * @code{c}
+ * BaseType_t xNotifyMailboxPostFromISR( NotifyMailbox_t * const pxMailbox,
+ *                                       void * pvMessage,
+ *                                       BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xNotifyMailboxPost() that can be called from an interrupt
+ * service routine (ISR).
+ *
+ * @param pxMailbox The mailbox to which the message is posted.
+ *
+ * @param pvMessage The message.  Must not be NULL.
+ *
+ * @param pxHigherPriorityTaskWoken *pxHigherPriorityTaskWoken is set to pdTRUE
+ * if posting the message unblocked the mailbox's reader, and the reader has a
+ * priority above that of the task that was interrupted, in which case a
+ * context switch should be requested before the interrupt is exited.
+ *
+ * @return pdPASS if the message was posted, or pdFAIL if the mailbox already
+ * held a message.
+ *
+ * \defgroup xNotifyMailboxPostFromISR xNotifyMailboxPostFromISR
+ * \ingroup NotifyObjects
+ */
+BaseType_t xNotifyMailboxPostFromISR( NotifyMailbox_t * const pxMailbox,
+                                      void * pvMessage,
+                                      BaseType_t * pxHigherPriorityTaskWoken );
+
+/**
+ * notify_objects.h
+ * @code{c}
+ * BaseType_t xNotifyMailboxReceive( NotifyMailbox_t * const pxMailbox,
+ *                                   void ** ppvMessage,
+ *                                   TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receives the message held in a mailbox, leaving the mailbox empty.  Must only
+ * be called by the mailbox's reader.
+ *
+ * @param pxMailbox The mailbox from which the message is received.
+ *
+ * @param ppvMessage The message is written to *ppvMessage.  *ppvMessage is set
+ * to NULL if no message was received.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state for a
+ * message to be posted if the mailbox is empty.
+ *
+ * @return pdPASS if a message was received, or pdFAIL if the mailbox was still
+ * empty when xTicksToWait expired.
+ *
+ * \defgroup xNotifyMailboxReceive xNotifyMailboxReceive
+ * \ingroup NotifyObjects
+ */
+BaseType_t xNotifyMailboxReceive( NotifyMailbox_t * const pxMailbox,
+                                  void ** ppvMessage,
+                                  TickType_t xTicksToWait );
+
+/**
+ * notify_objects.h
+ * @code{c}
+ * void vNotifySemaphoreInit( NotifySemaphore_t * const pxSemaphore,
+ *                            TaskHandle_t xOwner,
+ *                            UBaseType_t uxIndex );
+ * @endcode
+ *
+ * Initialises a counting semaphore, and sets its count to zero.
+ *
+ * @param pxSemaphore The semaphore being initialised.
+ *
+ * @param xOwner The handle of the only task that will take the semaphore.
+ *
+ * @param uxIndex The index of xOwner's notification array used to hold the
+ * semaphore's count.  Must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.
+ *
+ * \defgroup vNotifySemaphoreInit vNotifySemaphoreInit
+ * \ingroup NotifyObjects
+ */
+void vNotifySemaphoreInit( NotifySemaphore_t * const pxSemaphore,
+                           TaskHandle_t xOwner,
+                           UBaseType_t uxIndex );
+
+/**
+ * notify_objects.h
+ * @code{c}
+ * BaseType_t xNotifySemaphoreGive( NotifySemaphore_t * const pxSemaphore );
+ * @endcode
+ *
+ * Increments a semaphore's count, unblocking its owner if the owner is waiting
+ * to take it.  The count cannot overflow in practice, so giving always passes.
+ *
+ * \defgroup xNotifySemaphoreGive xNotifySemaphoreGive
+ * \ingroup NotifyObjects
+ */
+#define xNotifySemaphoreGive( pxSemaphore ) \
+    xTaskNotifyGiveIndexed( ( pxSemaphore )->xOwner, ( pxSemaphore )->uxIndex )
+
+/**
+ * notify_objects.h
+ * @code{c}
+ * void vNotifySemaphoreGiveFromISR( NotifySemaphore_t * const pxSemaphore,
+ *                                   BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xNotifySemaphoreGive() that can be called from an interrupt
+ * service routine (ISR).  *pxHigherPriorityTaskWoken is set to pdTRUE if a
+ * context switch should be requested before the interrupt is exited.
+ *
+ * \defgroup vNotifySemaphoreGiveFromISR vNotifySemaphoreGiveFromISR
+ * \ingroup NotifyObjects
+ */
+#define vNotifySemaphoreGiveFromISR( pxSemaphore, pxHigherPriorityTaskWoken ) \
+    vTaskNotifyGiveIndexedFromISR( ( pxSemaphore )->xOwner, ( pxSemaphore )->uxIndex, ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * notify_objects.h
+ * @code{c}
+ * BaseType_t xNotifySemaphoreTake( NotifySemaphore_t * const pxSemaphore,
+ *                                  TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Decrements a semaphore's count, waiting up to xTicksToWait ticks for the
+ * count to become non-zero.  Must only be called by the semaphore's owner.
+ *
+ * @return pdPASS if the semaphore was taken, or pdFAIL if the count was still
+ * zero when xTicksToWait expired.
+ *
+ * \defgroup xNotifySemaphoreTake xNotifySemaphoreTake
+ * \ingroup NotifyObjects
+ */
+#define xNotifySemaphoreTake( pxSemaphore, xTicksToWait ) \
+    ( ( ulTaskNotifyTakeIndexed( ( pxSemaphore )->uxIndex, pdFALSE, ( xTicksToWait ) ) != 0UL ) ? pdPASS : pdFAIL )
+
+/**
+ * notify_objects.h
+ * @code{c}
+ * void vNotifyEventFlagsInit( NotifyEventFlags_t * const pxFlags,
+ *                             TaskHandle_t xOwner,
+ *                             UBaseType_t uxIndex );
+ * @endcode
+ *
+ * Initialises a set of event flags, and clears all the flags.
+ *
+ * @param pxFlags The event flags being initialised.
+ *
+ * @param xOwner The handle of the only task that will wait for the flags.
+ *
+ * @param uxIndex The index of xOwner's notification array used to hold the
+ * flags.  Must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.
+ *
+ * \defgroup vNotifyEventFlagsInit vNotifyEventFlagsInit
+ * \ingroup NotifyObjects
+ */
+void vNotifyEventFlagsInit( NotifyEventFlags_t * const pxFlags,
+                            TaskHandle_t xOwner,
+                            UBaseType_t uxIndex );
+
+/**
+ * notify_objects.h
+ * @code{c}
+ * BaseType_t xNotifyEventFlagsSet( NotifyEventFlags_t * const pxFlags,
+ *                                  uint32_t ulFlagsToSet );
+ * @endcode
+ *
+ * Sets event flags, unblocking their owner if it is waiting for them.  Always
+ * returns pdPASS.
+ *
+ * \defgroup xNotifyEventFlagsSet xNotifyEventFlagsSet
+ * \ingroup NotifyObjects
+ */
+#define xNotifyEventFlagsSet( pxFlags, ulFlagsToSet ) \
+    xTaskNotifyIndexed( ( pxFlags )->xOwner, ( pxFlags )->uxIndex, ( ulFlagsToSet ), eSetBits )
+
+/**
+ * notify_objects.h
+ * @code{c}
+ * BaseType_t xNotifyEventFlagsSetFromISR( NotifyEventFlags_t * const pxFlags,
+ *                                         uint32_t ulFlagsToSet,
+ *                                         BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xNotifyEventFlagsSet() that can be called from an interrupt
+ * service routine (ISR).  Unlike xEventGroupSetBitsFromISR() the flags are
+ * set directly, not by the timer service task.
+ *
+ * \defgroup xNotifyEventFlagsSetFromISR xNotifyEventFlagsSetFromISR
+ * \ingroup NotifyObjects
+ */
+#define xNotifyEventFlagsSetFromISR( pxFlags, ulFlagsToSet, pxHigherPriorityTaskWoken ) \
+    xTaskNotifyIndexedFromISR( ( pxFlags )->xOwner, ( pxFlags )->uxIndex, ( ulFlagsToSet ), eSetBits, ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * notify_objects.h
+ * @code{c}
+ * uint32_t ulNotifyEventFlagsClear( NotifyEventFlags_t * const pxFlags,
+ *                                   uint32_t ulFlagsToClear );
+ * @endcode
+ *
+ * Clears event flags.  Can be called by any task.
+ *
+ * @return The value of the flags before any were cleared.
+ *
+ * \defgroup ulNotifyEventFlagsClear ulNotifyEventFlagsClear
+ * \ingroup NotifyObjects
+ */
+#define ulNotifyEventFlagsClear( pxFlags, ulFlagsToClear ) \
+    ulTaskNotifyValueClearIndexed( ( pxFlags )->xOwner, ( pxFlags )->uxIndex, ( ulFlagsToClear ) )
+
+/**
+ * notify_objects.h
+ * @code{c}
+ * uint32_t ulNotifyEventFlagsWait( NotifyEventFlags_t * const pxFlags,
+ *                                  uint32_t ulFlagsToWaitFor,
+ *                                  BaseType_t xClearOnExit,
+ *                                  BaseType_t xWaitForAllFlags,
+ *                                  TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Waits for one or all of a set of event flags to be set, with the same
+ * semantics as xEventGroupWaitBits().  Must only be called by the flags' owner.
+ *
+ * @param pxFlags The event flags being waited for.
+ *
+ * @param ulFlagsToWaitFor A bitwise value of the flags to wait for.  Must not
+ * be zero.
+ *
+ * @param xClearOnExit If xClearOnExit is pdTRUE the flags in ulFlagsToWaitFor
+ * are cleared before the function returns, but only if the wait condition was
+ * met.
+ *
+ * @param xWaitForAllFlags If pdTRUE the function waits for all the flags in
+ * ulFlagsToWaitFor to be set, otherwise it waits for any one of them.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state for the
+ * wait condition to be met.
+ *
+ * @return The value of the flags when the wait condition was met, or when
+ * xTicksToWait expired.  The value is taken before any flags are cleared.
+ *
+ * \defgroup ulNotifyEventFlagsWait ulNotifyEventFlagsWait
+ * \ingroup NotifyObjects
+ */
+uint32_t ulNotifyEventFlagsWait( NotifyEventFlags_t * const pxFlags,
+                                 uint32_t ulFlagsToWaitFor,
+                                 BaseType_t xClearOnExit,
+                                 BaseType_t xWaitForAllFlags,
+                                 TickType_t xTicksToWait );
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* NOTIFY_OBJECTS_H */
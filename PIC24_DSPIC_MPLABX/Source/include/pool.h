@@ -0,0 +1,333 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include pool.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * A memory pool is a statically allocated array of equally sized blocks.
+ * Allocating a block from a pool and freeing it back to the pool both take a
+ * constant, short, amount of time, cannot fragment memory, and can be done
+ * from an interrupt, so pools are a good fit for objects and message payloads
+ * that are always the same size.  Unlike pvPortMalloc(), the pool functions do
+ * not suspend the scheduler unless a task has to wait for a block to become
+ * free.
+ *
+ * If configPOOL_USE_ATOMICS is 1 the free blocks are held on a list that is
+ * updated using the compare and swap function from atomic.h, so a task
+ * allocating or freeing a block can be interrupted by an interrupt that
+ * allocates or frees a block from the same pool without either of them having
+ * to enter a critical section.  configPOOL_USE_ATOMICS defaults to 1 on ports
+ * that define portSET_INTERRUPT_MASK_FROM_ISR(), which atomic.h needs to be
+ * safe to use from tasks and interrupts.  On other ports the list is updated
+ * inside a very short critical section instead.
+ *
+ * A task can optionally enter the Blocked state to wait for a block to become
+ * free, in the same way a task can wait for space to become available in a
+ * queue.
+ */
+
+/**
+ * pool.h
+ *
+ * Type by which memory pools are referenced.  For example, a call to
+ * xPoolCreateStatic() returns a PoolHandle_t variable that can then be used as
+ * a parameter to pvPoolAlloc(), vPoolFree(), etc.
+ *
+ * \defgroup PoolHandle_t PoolHandle_t
+ * \ingroup MemoryPools
+ */
+struct PoolDefinition;
+typedef struct PoolDefinition * PoolHandle_t;
+
+/**
+ * pool.h
+ *
+ * The number of bytes each block of a pool actually occupies when the pool
+ * was created with a block size of xBlockSize.  Blocks must be large enough to
+ * hold the link used to build the list of free blocks, and are a multiple of
+ * portBYTE_ALIGNMENT bytes so every block is as aligned as the pool storage
+ * area.
+ */
+#define poolBLOCK_SIZE( xBlockSize )                        ( ( ( ( ( size_t ) ( xBlockSize ) < sizeof( uint32_t ) ) ? sizeof( uint32_t ) : ( size_t ) ( xBlockSize ) ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/**
+ * pool.h
+ *
+ * The size, in bytes, of the storage area needed by a pool that holds
+ * uxNumberOfBlocks blocks of xBlockSize bytes each.
+ */
+#define poolSTORAGE_SIZE_BYTES( xBlockSize, uxNumberOfBlocks )    ( poolBLOCK_SIZE( xBlockSize ) * ( size_t ) ( uxNumberOfBlocks ) )
+
+/* The largest number of blocks a pool can hold. */
+#define poolMAX_BLOCKS                                      ( ( UBaseType_t ) 0xfffe )
+
+/**
+ * pool.h
+ * @code{c}
+ * PoolHandle_t xPoolCreateStatic( size_t xBlockSize,
+ *                                 UBaseType_t uxNumberOfBlocks,
+ *                                 uint8_t * pucPoolStorage,
+ *                                 StaticPool_t * pxStaticPool );
+ * @endcode
+ *
+ * Creates a new memory pool using statically allocated memory.
+ *
+ * @param xBlockSize The size, in bytes, of each block that can be allocated
+ * from the pool.
+ *
+ * @param uxNumberOfBlocks The number of blocks in the pool, which must not be
+ * zero and must not be greater than poolMAX_BLOCKS.
+ *
+ * @param pucPoolStorage Must point to an array of at least
+ * poolSTORAGE_SIZE_BYTES( xBlockSize, uxNumberOfBlocks ) bytes that is aligned
+ * to portBYTE_ALIGNMENT.  The blocks are allocated from this array.
+ *
+ * @param pxStaticPool Must point to a variable of type StaticPool_t, which
+ * will be used to hold the pool's data structure.
+ *
+ * @return If the pool is created successfully then a handle to the created
+ * pool is returned.  If either pucPoolStorage or pxStaticPool is NULL then NULL
+ * is returned.
+ *
+ * Example use:
+ * @code{c}
+ *
+ * typedef struct MESSAGE
+ * {
+ *     uint32_t ulID;
+ *     uint32_t ulData[ 7 ];
+ * } Message_t;
+ *
+ * #define NUMBER_OF_MESSAGES    10
+ *
+ * // Storage for the blocks.  An array of the type being allocated has the
+ * // required alignment on most architectures.
+ * static Message_t xMessageStorage[ NUMBER_OF_MESSAGES ];
+ *
+ * // The variable used to hold the pool's data structure.
+ * static StaticPool_t xPoolStruct;
+ *
+ * void MyFunction( void )
+ * {
+ *     PoolHandle_t xPool;
+ *
+ *     configASSERT( poolBLOCK_SIZE( sizeof( Message_t ) ) == sizeof( Message_t ) );
+ *
+ *     xPool = xPoolCreateStatic( sizeof( Message_t ),
+ *                                NUMBER_OF_MESSAGES,
+ *                                ( uint8_t * ) xMessageStorage,
+ *                                &xPoolStruct );
+ *
+ *     // As neither the pucPoolStorage or pxStaticPool parameters were NULL,
+ *     // xPool will not be NULL, and can be used to reference the created pool
+ *     // in other pool API calls.
+ * }
+ *
+ * @endcode
+ * \defgroup xPoolCreateStatic xPoolCreateStatic
+ * \ingroup MemoryPools
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    PoolHandle_t xPoolCreateStatic( size_t xBlockSize,
+                                    UBaseType_t uxNumberOfBlocks,
+                                    uint8_t * pucPoolStorage,
+                                    StaticPool_t * pxStaticPool ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * pool.h
+ * @code{c}
+ * void * pvPoolAlloc( PoolHandle_t xPool,
+ *                     TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Allocates a block from a pool.  The contents of the block are not
+ * initialised.
+ *
+ * If the pool has no free blocks the calling task can optionally enter the
+ * Blocked state to wait for a block to be freed.  If more than one task is
+ * waiting then the highest priority task that has been waiting longest is
+ * given the next block that is freed, as with tasks waiting to send to a
+ * queue.
+ *
+ * Do not call this function from an interrupt service routine.  See
+ * pvPoolAllocFromISR() for an alternative that can be used from an ISR.
+ *
+ * @param xPool The handle of the pool to allocate the block from.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for a block to become free if the pool has no free
+ * blocks when the function is called.  The time is specified in ticks - the
+ * macro pdMS_TO_TICKS() can be used to convert a time specified in
+ * milliseconds to a time specified in ticks.  Setting xTicksToWait to
+ * portMAX_DELAY will cause the task to wait indefinitely (without timing out),
+ * provided INCLUDE_vTaskSuspend is set to 1 in FreeRTOSConfig.h.  The function
+ * returns immediately if xTicksToWait is 0.
+ *
+ * @return A pointer to the allocated block, or NULL if a block was not
+ * allocated before xTicksToWait expired.
+ *
+ * \defgroup pvPoolAlloc pvPoolAlloc
+ * \ingroup MemoryPools
+ */
+void * pvPoolAlloc( PoolHandle_t xPool,
+                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ * @code{c}
+ * void * pvPoolAllocFromISR( PoolHandle_t xPool );
+ * @endcode
+ *
+ * A version of pvPoolAlloc() that can be called from an interrupt service
+ * routine (ISR).  The function never blocks.
+ *
+ * @param xPool The handle of the pool to allocate the block from.
+ *
+ * @return A pointer to the allocated block, or NULL if the pool had no free
+ * blocks.
+ *
+ * \defgroup pvPoolAllocFromISR pvPoolAllocFromISR
+ * \ingroup MemoryPools
+ */
+void * pvPoolAllocFromISR( PoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ * @code{c}
+ * void vPoolFree( PoolHandle_t xPool,
+ *                 void * pvBlock );
+ * @endcode
+ *
+ * Returns a block allocated by pvPoolAlloc() or pvPoolAllocFromISR() to the
+ * pool it was allocated from.  If any tasks are blocked waiting for a block
+ * then the highest priority of those tasks is unblocked.
+ *
+ * Do not call this function from an interrupt service routine.  See
+ * vPoolFreeFromISR() for an alternative that can be used from an ISR.
+ *
+ * @param xPool The handle of the pool the block was allocated from.
+ *
+ * @param pvBlock The block being freed.
+ *
+ * \defgroup vPoolFree vPoolFree
+ * \ingroup MemoryPools
+ */
+void vPoolFree( PoolHandle_t xPool,
+                void * pvBlock ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ * @code{c}
+ * void vPoolFreeFromISR( PoolHandle_t xPool,
+ *                        void * pvBlock,
+ *                        BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of vPoolFree() that can be called from an interrupt service
+ * routine (ISR).
+ *
+ * @param xPool The handle of the pool the block was allocated from.
+ *
+ * @param pvBlock The block being freed.
+ *
+ * @param pxHigherPriorityTaskWoken *pxHigherPriorityTaskWoken will be set to
+ * pdTRUE if freeing the block unblocked a task that has a priority above the
+ * priority of the currently running task.  If vPoolFreeFromISR() sets this
+ * value to pdTRUE then a context switch should be requested before the
+ * interrupt is exited.  pxHigherPriorityTaskWoken is optional and can be NULL.
+ *
+ * \defgroup vPoolFreeFromISR vPoolFreeFromISR
+ * \ingroup MemoryPools
+ */
+void vPoolFreeFromISR( PoolHandle_t xPool,
+                       void * pvBlock,
+                       BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ * @code{c}
+ * UBaseType_t uxPoolGetBlocksAvailable( PoolHandle_t xPool );
+ * @endcode
+ *
+ * Queries how many blocks in a pool are free.  Other tasks and interrupts can
+ * allocate and free blocks at any time, so the returned value is only a
+ * snapshot.
+ *
+ * @param xPool The handle of the pool being queried.
+ *
+ * @return The number of free blocks in the pool.
+ *
+ * \defgroup uxPoolGetBlocksAvailable uxPoolGetBlocksAvailable
+ * \ingroup MemoryPools
+ */
+UBaseType_t uxPoolGetBlocksAvailable( PoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ * @code{c}
+ * void vPoolDelete( PoolHandle_t xPool );
+ * @endcode
+ *
+ * Deletes a pool previously created by xPoolCreateStatic(), after which the
+ * pool storage area and the StaticPool_t variable can be reused.  A pool must
+ * not be deleted while tasks are blocked waiting to allocate from it, or while
+ * any of its blocks are still in use.
+ *
+ * @param xPool The handle of the pool being deleted.
+ *
+ * \defgroup vPoolDelete vPoolDelete
+ * \ingroup MemoryPools
+ */
+void vPoolDelete( PoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/* For internal use only. */
+#if ( configUSE_TRACE_FACILITY == 1 )
+    UBaseType_t uxPoolGetPoolNumber( PoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+    void vPoolSetPoolNumber( PoolHandle_t xPool,
+                             UBaseType_t uxPoolNumber ) PRIVILEGED_FUNCTION;
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* POOL_H */
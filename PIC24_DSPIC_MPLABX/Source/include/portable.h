@@ -50,7 +50,11 @@
  * included here.  In this case the path to the correct portmacro.h header file
  * must be set in the compiler's include path. */
 #ifndef portENTER_CRITICAL
-#ifdef __dsPIC33A__
+#if defined( __unix__ ) || defined( __APPLE__ )
+    /* Host builds (such as the POSIX port) find portmacro.h through the
+     * include path set up by the port's build files. */
+    #include "portmacro.h"
+#elif defined( __dsPIC33A__ )
     #include "../../Source/portable/MPLAB/dsPIC33A/portmacro.h"
 #else
     #include "../../Source/portable/MPLAB/PIC24_dsPIC/portmacro.h"
@@ -134,8 +138,8 @@
     #endif
 #endif /* if ( portUSING_MPU_WRAPPERS == 1 ) */
 
-/* Used by heap_5.c to define the start address and size of each memory region
- * that together comprise the total FreeRTOS heap space. */
+/* Used by heap_5.c and heap_6.c to define the start address and size of each
+ * memory region that together comprise the total FreeRTOS heap space. */
 typedef struct HeapRegion
 {
     uint8_t * pucStartAddress;
@@ -155,8 +159,8 @@ typedef struct xHeapStats
 } HeapStats_t;
 
 /*
- * Used to define multiple heap regions for use by heap_5.c.  This function
- * must be called before any calls to pvPortMalloc() - not creating a task,
+ * Used to define multiple heap regions for use by heap_5.c and heap_6.c.  This
+ * function must be called before any calls to pvPortMalloc() - not creating a task,
  * queue, semaphore, mutex, software timer, event group, etc. will result in
  * pvPortMalloc being called.
  *
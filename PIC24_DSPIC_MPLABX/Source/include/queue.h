@@ -885,6 +885,111 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                           void * const pvBuffer,
                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendMultiple(
+ *                                QueueHandle_t xQueue,
+ *                                const void * const pvItemsToQueue,
+ *                                const UBaseType_t uxItemCount,
+ *                                TickType_t xTicksToWait
+ *                           );
+ * @endcode
+ *
+ * Post up to uxItemCount items to the back of a queue in one operation.  The
+ * items are copied into the queue under a single critical section, using at
+ * most two copies, and tasks waiting to receive are unblocked once per call
+ * rather than once per item.  This is much cheaper than calling xQueueSend()
+ * uxItemCount times when many small items are posted together.
+ *
+ * As many items as will fit are posted.  The function only blocks if the queue
+ * is full, so fewer than uxItemCount items can be posted - check the return
+ * value.
+ *
+ * This function must not be used with semaphores or mutexes, and must not be
+ * called from an interrupt service routine.  See xQueueSendMultipleFromISR()
+ * for an alternative which may be used in an ISR.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to an array of uxItemCount items, each the
+ * size the queue was created to hold.
+ *
+ * @param uxItemCount The number of items in the array.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for space to become available on the queue, should it already be full.
+ *
+ * @return The number of items posted, or 0 if the queue remained full for the
+ * whole block time.
+ *
+ * Example usage:
+ * @code{c}
+ * void vForwardLogEntries( QueueHandle_t xLogQueue, const LogEntry_t * pxEntries, UBaseType_t uxCount )
+ * {
+ * BaseType_t xPosted;
+ *
+ *  while( uxCount > 0 )
+ *  {
+ *      xPosted = xQueueSendMultiple( xLogQueue, pxEntries, uxCount, portMAX_DELAY );
+ *      pxEntries += xPosted;
+ *      uxCount -= ( UBaseType_t ) xPosted;
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+                               const void * const pvItemsToQueue,
+                               const UBaseType_t uxItemCount,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReceiveMultiple(
+ *                                   QueueHandle_t xQueue,
+ *                                   void * const pvBuffer,
+ *                                   const UBaseType_t uxMaxItems,
+ *                                   TickType_t xTicksToWait
+ *                              );
+ * @endcode
+ *
+ * Receive up to uxMaxItems items from a queue in one operation.  The items are
+ * removed under a single critical section, using at most two copies, and tasks
+ * waiting to send are unblocked once per call rather than once per item.
+ *
+ * The function only blocks if the queue is empty, and returns as soon as at
+ * least one item is available, so fewer than uxMaxItems items can be received.
+ *
+ * This function must not be used with semaphores or mutexes, and must not be
+ * called from an interrupt service routine.  See
+ * xQueueReceiveMultipleFromISR() for an alternative which may be used in an
+ * ISR.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to an array with room for uxMaxItems items into which
+ * the received items will be copied.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for an item to receive should the queue be empty at the time of the call.
+ *
+ * @return The number of items received, or 0 if the queue remained empty for
+ * the whole block time.
+ *
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                  void * const pvBuffer,
+                                  const UBaseType_t uxMaxItems,
+                                  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * queue. h
  * @code{c}
@@ -1418,6 +1523,64 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
                                  void * const pvBuffer,
                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendMultipleFromISR(
+ *                                       QueueHandle_t xQueue,
+ *                                       const void * const pvItemsToQueue,
+ *                                       const UBaseType_t uxItemCount,
+ *                                       BaseType_t * const pxHigherPriorityTaskWoken
+ *                                  );
+ * @endcode
+ *
+ * A version of xQueueSendMultiple() that can be used in an interrupt service
+ * routine.  Posts as many of the uxItemCount items as will fit.
+ *
+ * @param pxHigherPriorityTaskWoken xQueueSendMultipleFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if posting the items caused a task to
+ * unblock, and the unblocked task has a priority higher than the currently
+ * running task.
+ *
+ * @return The number of items posted.
+ *
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                      const void * const pvItemsToQueue,
+                                      const UBaseType_t uxItemCount,
+                                      BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReceiveMultipleFromISR(
+ *                                          QueueHandle_t xQueue,
+ *                                          void * const pvBuffer,
+ *                                          const UBaseType_t uxMaxItems,
+ *                                          BaseType_t * const pxHigherPriorityTaskWoken
+ *                                     );
+ * @endcode
+ *
+ * A version of xQueueReceiveMultiple() that can be used in an interrupt service
+ * routine.  Receives up to uxMaxItems of the items available.
+ *
+ * @param pxHigherPriorityTaskWoken xQueueReceiveMultipleFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if removing the items caused a task
+ * waiting for space to unblock, and the unblocked task has a priority higher
+ * than the currently running task.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup xQueueReceiveMultipleFromISR xQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                         void * const pvBuffer,
+                                         const UBaseType_t uxMaxItems,
+                                         BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from within an ISR, or within a critical section.
@@ -1456,6 +1619,9 @@ BaseType_t xQueueCRReceive( QueueHandle_t xQueue,
 QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType,
                                        StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+QueueHandle_t xQueueCreateMutexWithCeiling( UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+QueueHandle_t xQueueCreateMutexWithCeilingStatic( UBaseType_t uxCeilingPriority,
+                                                  StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
                                              const UBaseType_t uxInitialCount ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
@@ -1712,6 +1878,31 @@ void vQueueSetQueueNumber( QueueHandle_t xQueue,
 UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 uint8_t ucQueueGetQueueType( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_WAIT_OBJECTS == 1 )
+
+/*
+ * Record xTask as the task to notify when data is sent to xQueue, or stop
+ * notifying any task if xTask is NULL.  Used by xWaitForMultipleObjects(), and
+ * must be called from a critical section.
+ */
+    void vQueueSetWaitObjectTask( QueueHandle_t xQueue,
+                                  TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_MUTEX_CEILING_VIOLATION_HOOK == 1 )
+
+/*
+ * Application hook called when the priority ceiling protocol is broken on the
+ * priority ceiling mutex xMutex by xTask - either because xTask has a priority
+ * above the mutex's ceiling, or because xTask found the mutex held by a task
+ * that blocked while holding it.  The hook is called with the scheduler
+ * suspended when xTask is about to block on the mutex, so must not call API
+ * functions that might block.
+ */
+    void vApplicationMutexCeilingViolationHook( QueueHandle_t xMutex,
+                                                TaskHandle_t xTask );
+#endif
+
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
@@ -798,6 +798,66 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreCreateMutexStatic( pxMutexBuffer )    xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
 #endif
 
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateMutexWithCeiling( UBaseType_t uxCeilingPriority );
+ * SemaphoreHandle_t xSemaphoreCreateMutexWithCeilingStatic( UBaseType_t uxCeilingPriority, StaticSemaphore_t *pxMutexBuffer );
+ * @endcode
+ *
+ * Creates a new mutex type semaphore that uses the immediate priority ceiling
+ * protocol in place of priority inheritance, and returns a handle by which the
+ * new mutex can be referenced.  configUSE_PRIORITY_CEILING_MUTEXES must be set
+ * to 1 in FreeRTOSConfig.h for these macros to be available.
+ *
+ * A task that takes the mutex is raised to uxCeilingPriority at once.  When it
+ * gives the mutex back it is returned to the highest of its base priority and
+ * the ceilings of the other ceiling mutexes it still holds.  If
+ * uxCeilingPriority is at least the priority of every task that uses the mutex
+ * then no task that uses the mutex can preempt the holder, so a task never
+ * finds the mutex held and never blocks on it, and the kernel has nothing to
+ * track when the mutex is contended.  The cost is that the holder runs at the
+ * ceiling whether or not another task wants the mutex.  If
+ * configUSE_TIME_SLICING is 1, a task whose priority equals the ceiling can
+ * still be given a time slice while another task holds the mutex, so set the
+ * ceiling above the priority of every task that uses the mutex if that
+ * matters.
+ *
+ * The protocol is broken if a task with a base priority above
+ * uxCeilingPriority takes the mutex, or if a task blocks or is suspended while
+ * holding it.  A task raised above the ceiling only by another mutex it holds
+ * does not break the protocol.  The kernel calls
+ * traceMUTEX_CEILING_VIOLATION(), and also
+ * vApplicationMutexCeilingViolationHook() if
+ * configUSE_MUTEX_CEILING_VIOLATION_HOOK is 1, when it detects either.  A task
+ * that finds the mutex held blocks as it would for any mutex, but does not
+ * raise the priority of the holder.
+ *
+ * Mutexes created using these macros are accessed using the xSemaphoreTake()
+ * and xSemaphoreGive() macros, and can be given back in any order.  A task
+ * that also holds a mutex that uses priority inheritance keeps its priority
+ * until it gives that mutex back, as it would with priority inheritance alone.
+ *
+ * @param uxCeilingPriority The priority to which a task that takes the mutex is
+ * raised.  Must be less than configMAX_PRIORITIES.
+ *
+ * @param pxMutexBuffer Must point to a variable of type StaticSemaphore_t,
+ * which will be used to hold the mutex's data structure.
+ *
+ * @return If the mutex was successfully created then a handle to the created
+ * mutex is returned.  Otherwise NULL is returned.
+ *
+ * \defgroup xSemaphoreCreateMutexWithCeiling xSemaphoreCreateMutexWithCeiling
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) )
+    #define xSemaphoreCreateMutexWithCeiling( uxCeilingPriority )    xQueueCreateMutexWithCeiling( ( uxCeilingPriority ) )
+#endif
+
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) )
+    #define xSemaphoreCreateMutexWithCeilingStatic( uxCeilingPriority, pxMutexBuffer )    xQueueCreateMutexWithCeilingStatic( ( uxCeilingPriority ), ( pxMutexBuffer ) )
+#endif
+
 
 /**
  * semphr. h
@@ -879,6 +879,302 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer,
                                                  BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+ *                              void ** ppvData,
+ *                              size_t xDataLengthBytes,
+ *                              TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Zero copy alternative to xStreamBufferSend().  Obtains a pointer directly
+ * into the stream buffer's storage area so the data can be written in place,
+ * rather than being copied in from a separate buffer.  The data does not
+ * become visible to the reader until xStreamBufferCommit() is called.
+ *
+ * The block handed out never crosses the end of the storage area, so fewer
+ * bytes than requested may be returned even when more space is free.  Call
+ * xStreamBufferReserve() again after committing to obtain the bytes that wrap
+ * to the start of the storage area.
+ *
+ * Stream buffers only - use xMessageBufferReserve() with message buffers.  As
+ * with xStreamBufferSend(), only one task or interrupt can write to the buffer
+ * at a time, and a reservation must be committed before the next is taken.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being written to.
+ *
+ * @param ppvData Set to point to the reserved bytes, or NULL if no bytes were
+ * reserved.
+ *
+ * @param xDataLengthBytes The number of bytes wanted.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for xDataLengthBytes (capped to the length of the
+ * buffer) to become free, as per xStreamBufferSend().
+ *
+ * @return The number of contiguous bytes reserved at *ppvData.
+ *
+ * Example use:
+ * @code{c}
+ * void vAFunction( StreamBufferHandle_t xStreamBuffer )
+ * {
+ * uint8_t *pucData;
+ * size_t xReserved;
+ *
+ *  // Reserve space for up to 32 bytes.
+ *  xReserved = xStreamBufferReserve( xStreamBuffer, ( void ** ) &pucData, 32, pdMS_TO_TICKS( 100 ) );
+ *
+ *  if( xReserved > 0 )
+ *  {
+ *      // Fill pucData[ 0 ] to pucData[ xReserved - 1 ] directly, for
+ *      // example from a peripheral, then publish however many bytes were
+ *      // actually written.
+ *      xStreamBufferCommit( xStreamBuffer, xReserved );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xStreamBufferReserve xStreamBufferReserve
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+                             void ** ppvData,
+                             size_t xDataLengthBytes,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReserveMessage( StreamBufferHandle_t xStreamBuffer,
+ *                                     void ** ppvData,
+ *                                     void ** ppvWrappedData,
+ *                                     size_t xDataLengthBytes,
+ *                                     TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Message buffer version of xStreamBufferReserve(), normally called through the
+ * xMessageBufferReserve() macro.  Reserves space for a whole message of
+ * xDataLengthBytes bytes plus its length.  The length itself is written by
+ * xStreamBufferCommit().
+ *
+ * A message may be split by the end of the storage area.  The return value is
+ * the number of bytes at *ppvData.  If that is less than xDataLengthBytes then
+ * the remaining bytes are at *ppvWrappedData, which is otherwise set to NULL.
+ *
+ * @param xStreamBuffer The handle of the message buffer being written to.
+ *
+ * @param ppvData Set to point to the first part of the reserved message.
+ *
+ * @param ppvWrappedData Set to point to the second part of the reserved
+ * message, or NULL if the message is not split.
+ *
+ * @param xDataLengthBytes The length of the message.
+ *
+ * @param xTicksToWait The maximum amount of time to wait for space for the
+ * whole message, as per xMessageBufferSend().
+ *
+ * @return The number of bytes at *ppvData, or 0 if the message could not be
+ * reserved.
+ *
+ * \defgroup xStreamBufferReserveMessage xStreamBufferReserveMessage
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReserveMessage( StreamBufferHandle_t xStreamBuffer,
+                                    void ** ppvData,
+                                    void ** ppvWrappedData,
+                                    size_t xDataLengthBytes,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer,
+ *                             size_t xDataLengthBytes );
+ * @endcode
+ *
+ * Makes xDataLengthBytes bytes written in place after a call to
+ * xStreamBufferReserve() or xStreamBufferReserveMessage() available to the
+ * reader.  The reader is notified in the same way as xStreamBufferSend() -
+ * that is, once the number of bytes in the buffer reaches the trigger level.
+ *
+ * For stream buffers xDataLengthBytes can be less than was reserved.  For
+ * message buffers it must be the length that was reserved.  Committing zero
+ * bytes abandons the reservation.
+ *
+ * Use xStreamBufferCommitFromISR() to commit from an interrupt service
+ * routine.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being written to.
+ *
+ * @param xDataLengthBytes The number of bytes to commit.
+ *
+ * @return The number of bytes committed.
+ *
+ * \defgroup xStreamBufferCommit xStreamBufferCommit
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer,
+                            size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                    size_t xDataLengthBytes,
+ *                                    BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * An interrupt safe version of xStreamBufferCommit().  Reservations never block
+ * when taken with a block time of zero, so xStreamBufferReserve() and
+ * xStreamBufferReserveMessage() can be used from an interrupt in that case.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if committing the data
+ * unblocked a task that has a priority above the interrupted task, as per
+ * xStreamBufferSendFromISR().
+ *
+ * \defgroup xStreamBufferCommitFromISR xStreamBufferCommitFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                   size_t xDataLengthBytes,
+                                   BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferPeekContiguous( StreamBufferHandle_t xStreamBuffer,
+ *                                     void ** ppvData,
+ *                                     TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Zero copy alternative to xStreamBufferReceive().  Obtains a pointer to the
+ * oldest bytes in the stream buffer so they can be processed in place.  The
+ * bytes remain in the buffer until they are released by
+ * xStreamBufferConsume().
+ *
+ * The block handed out never crosses the end of the storage area, so fewer
+ * bytes than are available may be returned.  Call
+ * xStreamBufferPeekContiguous() again after consuming to obtain the bytes that
+ * wrap to the start of the storage area.
+ *
+ * Stream buffers only - use xMessageBufferPeek() with message buffers.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being read.
+ *
+ * @param ppvData Set to point to the oldest bytes in the buffer, or NULL if
+ * the buffer is empty.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for data, as per xStreamBufferReceive().
+ *
+ * @return The number of contiguous bytes at *ppvData.
+ *
+ * \defgroup xStreamBufferPeekContiguous xStreamBufferPeekContiguous
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferPeekContiguous( StreamBufferHandle_t xStreamBuffer,
+                                    void ** ppvData,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferPeekMessage( StreamBufferHandle_t xStreamBuffer,
+ *                                  void ** ppvData,
+ *                                  void ** ppvWrappedData,
+ *                                  size_t * pxMessageLengthBytes,
+ *                                  TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Message buffer version of xStreamBufferPeekContiguous(), normally called
+ * through the xMessageBufferPeek() macro.  Obtains pointers to the next message
+ * in the buffer, split at the end of the storage area in the same way as
+ * xStreamBufferReserveMessage().
+ *
+ * @param xStreamBuffer The handle of the message buffer being read.
+ *
+ * @param ppvData Set to point to the first part of the message.
+ *
+ * @param ppvWrappedData Set to point to the second part of the message, or
+ * NULL if the message is not split.
+ *
+ * @param pxMessageLengthBytes Set to the total length of the message, which
+ * must later be passed to xStreamBufferConsume().
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for a message, as per xMessageBufferReceive().
+ *
+ * @return The number of bytes at *ppvData, or 0 if the buffer is empty.
+ *
+ * \defgroup xStreamBufferPeekMessage xStreamBufferPeekMessage
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferPeekMessage( StreamBufferHandle_t xStreamBuffer,
+                                 void ** ppvData,
+                                 void ** ppvWrappedData,
+                                 size_t * pxMessageLengthBytes,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer,
+ *                              size_t xDataLengthBytes );
+ * @endcode
+ *
+ * Releases xDataLengthBytes bytes obtained from xStreamBufferPeekContiguous()
+ * or xStreamBufferPeekMessage() so the space can be reused by the writer, and
+ * notifies a writer that is waiting for space in the same way as
+ * xStreamBufferReceive().
+ *
+ * For stream buffers xDataLengthBytes can be less than was peeked.  For
+ * message buffers it must be the length of the message, and the whole message
+ * is released.
+ *
+ * Use xStreamBufferConsumeFromISR() to consume from an interrupt service
+ * routine.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being read.
+ *
+ * @param xDataLengthBytes The number of bytes to release.
+ *
+ * @return The number of bytes released.
+ *
+ * \defgroup xStreamBufferConsume xStreamBufferConsume
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer,
+                             size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                     size_t xDataLengthBytes,
+ *                                     BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * An interrupt safe version of xStreamBufferConsume().
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if releasing the space
+ * unblocked a task that has a priority above the interrupted task, as per
+ * xStreamBufferReceiveFromISR().
+ *
+ * \defgroup xStreamBufferConsumeFromISR xStreamBufferConsumeFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+                                    size_t xDataLengthBytes,
+                                    BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
                                                  size_t xTriggerLevelBytes,
@@ -904,6 +1200,18 @@ size_t xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer )
     uint8_t ucStreamBufferGetStreamBufferType( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( configUSE_WAIT_OBJECTS == 1 )
+
+/*
+ * Record xTask as the task to notify when the trigger level of xStreamBuffer
+ * is reached, or stop notifying any task if xTask is NULL.  Used by
+ * xWaitForMultipleObjects(), and must be called from a critical section.
+ * xTask is a TaskHandle_t, which is not declared if task.h is not included.
+ */
+    void vStreamBufferSetWaitObjectTask( StreamBufferHandle_t xStreamBuffer,
+                                         struct tskTaskControlBlock * xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /* *INDENT-OFF* */
 #if defined( __cplusplus )
     }
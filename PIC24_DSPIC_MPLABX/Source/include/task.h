@@ -178,6 +178,49 @@ typedef enum
     #endif /* INCLUDE_vTaskSuspend */
 } eSleepModeStatus;
 
+/* Used with vTaskGetTicklessStats() to obtain statistics on the periods during
+ * which the tick was suppressed.  Only available when configUSE_TICKLESS_STATS
+ * is set to 1. */
+typedef struct xTICKLESS_STATS
+{
+    uint32_t ulSleepCount;       /* The number of times portSUPPRESS_TICKS_AND_SLEEP() was called. */
+    uint32_t ulAbortedCount;     /* The number of those calls during which no tick period passed, normally because the sleep was aborted. */
+    uint32_t ulEarlyWakeCount;   /* The number of those calls that returned before the expected idle time had passed, for example because an interrupt other than the tick woke the processor. */
+    uint32_t ulTicksExpected;    /* The total of the expected idle times passed to portSUPPRESS_TICKS_AND_SLEEP(). */
+    uint32_t ulTicksSlept;       /* The total number of tick periods that passed during those calls. */
+    uint32_t ulTicksLost;        /* The total number of tick periods the port reported it could not add to the tick count. */
+    int32_t lLastWakeError;      /* The last wake error reported by the port, in the units of the port's timer.  Positive if the processor woke late. */
+    int32_t lTickDrift;          /* The sum of the wake errors reported by the port, in the units of the port's timer. */
+    uint32_t ulWakeCompensation; /* How much earlier than the expected idle time the port is currently waking, in the units of the port's timer. */
+} TicklessStats_t;
+
+/* Used with vTaskGetRunTimeHistogram() to obtain the run time histograms of a
+ * task.  Bucket n of each histogram counts periods of between 2^n and
+ * (2^(n+1))-1 run time counter ticks.  Only available when
+ * configUSE_RUN_TIME_HISTOGRAMS is set to 1. */
+typedef struct xTASK_HISTOGRAM
+{
+    uint32_t ulRunSlice[ configRUN_TIME_HISTOGRAM_BUCKETS ];     /* Counts the periods the task spent in the Running state before another task was selected. */
+    uint32_t ulReadyLatency[ configRUN_TIME_HISTOGRAM_BUCKETS ]; /* Counts the periods between the task entering the Ready state, or being preempted, and it next running. */
+} TaskHistogram_t;
+
+/* Used with vTaskGetCoreRunTime() to obtain the split between busy and idle
+ * time.  Only available when configUSE_RUN_TIME_HISTOGRAMS is set to 1. */
+typedef struct xCORE_RUN_TIME
+{
+    configRUN_TIME_COUNTER_TYPE ulBusyTime; /* The total time the processor spent running tasks other than the idle task. */
+    configRUN_TIME_COUNTER_TYPE ulIdleTime; /* The total time the processor spent running the idle task. */
+} CoreRunTime_t;
+
+/* Used with xTaskGetStackSample() to obtain the stack usage of a task found by
+ * the stack sampler.  Only available when configUSE_STACK_SAMPLER is set to 1. */
+typedef struct xTASK_STACK_SAMPLE
+{
+    configSTACK_DEPTH_TYPE uxHighWaterMark;       /* The smallest amount of free stack space, in words, the sampler has found. */
+    configSTACK_DEPTH_TYPE uxSwitchHighWaterMark; /* The free stack space, in words, beyond the deepest stack pointer saved at a context switch.  Only set if configSTACK_SAMPLER_RECORD_SWITCH_SP is 1. */
+    uint32_t ulPasses;                            /* The number of times the sampler has finished checking the task's stack. */
+} TaskStackSample_t;
+
 /**
  * Defines the priority used by the idle task.  This must not be modified.
  *
@@ -1569,6 +1612,38 @@ UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask ) PRIVILEGED_FUNCTIO
  */
 configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
+/**
+ * task.h
+ * @code{c}
+ * BaseType_t xTaskGetStackSample( TaskHandle_t xTask, TaskStackSample_t * pxSample );
+ * @endcode
+ *
+ * configUSE_STACK_SAMPLER must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Returns the stack high water mark of xTask most recently found by the stack
+ * sampler, without scanning the stack.  Each time the idle task runs the
+ * sampler checks a few words of one task's stack, moving on to the next task
+ * each time it has checked all of the unused stack of the current one, so the
+ * value can lag behind the value uxTaskGetStackHighWaterMark() would return by
+ * up to one pass over every task.  It is never smaller than that value.
+ *
+ * @param xTask Handle of the task associated with the stack to be queried.
+ * Set xTask to NULL to query the stack of the calling task.
+ *
+ * @param pxSample A pointer to the TaskStackSample_t structure into which the
+ * results are copied.
+ *
+ * @return pdTRUE if the sampler has checked the whole of xTask's unused stack
+ * at least once.  pdFALSE if it has not, in which case the uxHighWaterMark
+ * member of pxSample is only an upper bound.
+ *
+ * \defgroup xTaskGetStackSample xTaskGetStackSample
+ * \ingroup TaskUtils
+ */
+BaseType_t xTaskGetStackSample( TaskHandle_t xTask,
+                                TaskStackSample_t * pxSample ) PRIVILEGED_FUNCTION;
+
 /* When using trace macros it is sometimes necessary to include task.h before
  * FreeRTOS.h.  When this is done TaskHookFunction_t will not yet have been defined,
  * so the following two prototypes will cause a compilation error.  This can be
@@ -1959,6 +2034,62 @@ void vTaskGetRunTimeStats( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetRunTimeHistogram( TaskHandle_t xTask, TaskHistogram_t * pxHistogram );
+ * @endcode
+ *
+ * configUSE_RUN_TIME_HISTOGRAMS must be defined as 1 for this function to be
+ * available.  See the configuration section for more information.
+ *
+ * When configUSE_RUN_TIME_HISTOGRAMS is 1 the kernel records, each time the
+ * Running state task changes, how long the outgoing task ran for and how long
+ * the incoming task waited in the Ready state, each in one bucket of a
+ * histogram with logarithmically sized buckets.  This function copies the
+ * histograms of a task without suspending the scheduler or entering a critical
+ * section - if a context switch updates the histograms while they are being
+ * copied then the copy is repeated.  Counts are never reset, so take two
+ * snapshots and subtract them to obtain the histograms for an interval.
+ *
+ * The period the task is currently running for, if it is the Running state
+ * task, is not included until another task is selected.
+ *
+ * @param xTask Handle of the task to query.  Passing NULL obtains the
+ * histograms of the calling task.
+ *
+ * @param pxHistogram A pointer to the TaskHistogram_t structure into which the
+ * histograms are copied.
+ *
+ * \defgroup vTaskGetRunTimeHistogram vTaskGetRunTimeHistogram
+ * \ingroup TaskUtils
+ */
+void vTaskGetRunTimeHistogram( TaskHandle_t xTask,
+                               TaskHistogram_t * pxHistogram ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetCoreRunTime( CoreRunTime_t * pxCoreRunTime );
+ * @endcode
+ *
+ * configUSE_RUN_TIME_HISTOGRAMS must be defined as 1 for this function to be
+ * available.
+ *
+ * Obtains the total time the processor has spent running the idle task and
+ * running all other tasks, in the units of the run time stats counter, without
+ * suspending the scheduler or entering a critical section.  The load over an
+ * interval is the change in ulBusyTime divided by the change in the sum of
+ * ulBusyTime and ulIdleTime.
+ *
+ * @param pxCoreRunTime A pointer to the CoreRunTime_t structure into which the
+ * times are copied.
+ *
+ * \defgroup vTaskGetCoreRunTime vTaskGetCoreRunTime
+ * \ingroup TaskUtils
+ */
+void vTaskGetCoreRunTime( CoreRunTime_t * pxCoreRunTime ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * @code{c}
@@ -2903,6 +3034,47 @@ BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
  */
 BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp ) PRIVILEGED_FUNCTION;
 
+/**
+ * task.h
+ * @code{c}
+ * void vTaskGetTicklessStats( TicklessStats_t * pxTicklessStats );
+ * @endcode
+ *
+ * configUSE_TICKLESS_IDLE and configUSE_TICKLESS_STATS must both be set for
+ * this function to be available.
+ *
+ * Obtains statistics on the periods during which the idle task suppressed the
+ * tick, and the wake latency the port has learned.  The time spent asleep is
+ * ulTicksSlept tick periods, so comparing it with the tick count shows the
+ * proportion of the time the processor spent in its low power state.  The
+ * wake error and drift are only updated by ports that measure them.
+ *
+ * @param pxTicklessStats A pointer to the TicklessStats_t structure into which
+ * the statistics are written.
+ *
+ * \defgroup vTaskGetTicklessStats vTaskGetTicklessStats
+ * \ingroup TaskUtils
+ */
+void vTaskGetTicklessStats( TicklessStats_t * pxTicklessStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * task.h
+ * @code{c}
+ * void vTaskResetTicklessStats( void );
+ * @endcode
+ *
+ * configUSE_TICKLESS_IDLE and configUSE_TICKLESS_STATS must both be set for
+ * this function to be available.
+ *
+ * Sets the counts returned by vTaskGetTicklessStats() back to zero, so a
+ * measurement can be started from a known point.  The learned wake
+ * compensation is kept.
+ *
+ * \defgroup vTaskResetTicklessStats vTaskResetTicklessStats
+ * \ingroup TaskUtils
+ */
+void vTaskResetTicklessStats( void ) PRIVILEGED_FUNCTION;
+
 
 /*-----------------------------------------------------------
 * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
@@ -3005,6 +3177,48 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEG
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
                                         const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be called
+ * from a critical section within an ISR.
+ *
+ * The equivalent of vTaskRemoveFromUnorderedEventList() used by event groups
+ * when configUSE_EVENT_GROUPS_DIRECT is 1.  As the scheduler need not be
+ * suspended, the task is held on the pending ready list if it is.
+ *
+ * @return pdTRUE if the task being removed has a higher priority than the task
+ * making the call, otherwise pdFALSE.
+ */
+#if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+    BaseType_t xTaskRemoveItemFromEventList( ListItem_t * pxEventListItem,
+                                             const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF xWaitForMultipleObjects().
+ *
+ * Sets the notification indexes of the calling task that are among the
+ * objects it is waiting for, one bit per index.  Notifying any of those
+ * indexes then also notifies index configWAIT_OBJECTS_NOTIFY_INDEX.
+ */
+#if ( configUSE_WAIT_OBJECTS == 1 )
+    void vTaskSetWaitObjectNotifyMask( UBaseType_t uxIndexMask ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF xWaitForMultipleObjects().
+ *
+ * Returns one bit for each notification index of the calling task that holds
+ * a notification that has not been waited for.
+ */
+#if ( configUSE_WAIT_OBJECTS == 1 )
+    UBaseType_t uxTaskGetNotifyPendingMask( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
@@ -3061,6 +3275,22 @@ BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder ) PRIVILEGE
 void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
                                           UBaseType_t uxHighestPriorityWaitingTask ) PRIVILEGED_FUNCTION;
 
+/*
+ * Raises the priority of the calling task to uxCeilingPriority, should the
+ * calling task have a lower priority, when it takes a priority ceiling mutex,
+ * and records that the task holds a mutex with that ceiling.  Returns pdFAIL if
+ * the base priority of the task is above the ceiling, otherwise pdPASS.
+ */
+BaseType_t xTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+
+/*
+ * Lowers the priority of a task giving back a priority ceiling mutex to the
+ * highest of its base priority and the ceilings of the ceiling mutexes it still
+ * holds.  Returns pdTRUE if a context switch is required.
+ */
+BaseType_t xTaskPriorityRestoreFromCeiling( TaskHandle_t const pxMutexHolder,
+                                            UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+
 /*
  * Get the uxTaskNumber assigned to the task referenced by the xTask parameter.
  */
@@ -3099,6 +3329,29 @@ void vTaskStepTick( TickType_t xTicksToJump ) PRIVILEGED_FUNCTION;
  */
 eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Only available when configUSE_TICKLESS_STATS is set to 1.
+ * Provided for use within portSUPPRESS_TICKS_AND_SLEEP().  Returns how much
+ * earlier, in the units of the port's timer, the port should program its wake
+ * up to allow for the time it takes to wake from the low power state.  The
+ * value is learned from the errors reported by vTaskReportTicklessWakeError().
+ */
+uint32_t ulTaskGetTicklessWakeCompensation( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Only available when configUSE_TICKLESS_STATS is set to 1.
+ * Provided for use within portSUPPRESS_TICKS_AND_SLEEP(), with interrupts
+ * disabled, after a sleep that ran to the expected idle time.  lWakeError is
+ * the time at which the port actually woke minus the time at which it intended
+ * to wake, in the units of the port's timer, so is positive if the port woke
+ * late even after applying ulTaskGetTicklessWakeCompensation().  xTicksLost is
+ * the number of whole tick periods that passed that the port could not add to
+ * the tick count, because vTaskStepTick() cannot step past the expected idle
+ * time.
+ */
+void vTaskReportTicklessWakeError( int32_t lWakeError,
+                                   TickType_t xTicksLost ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Increment the mutex held count when a mutex is
  * taken and return the handle of the task that has taken the mutex.
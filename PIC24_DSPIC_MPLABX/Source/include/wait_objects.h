@@ -0,0 +1,180 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef WAIT_OBJECTS_H
+#define WAIT_OBJECTS_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include wait_objects.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * xWaitForMultipleObjects() lets a task block once on any mix of queues,
+ * semaphores, mutexes, stream buffers, message buffers and its own task
+ * notifications, and returns the position of an object that is ready in the
+ * array of objects it was given.
+ *
+ * Unlike a queue set, no queue of handles is needed.  An object records the
+ * task that is waiting for it, and when the object becomes ready it unblocks
+ * that task by sending it a task notification, so sending to an object costs
+ * the same whatever the number of other objects the task is waiting for, and
+ * nothing is copied a second time.  The task notification at index
+ * configWAIT_OBJECTS_NOTIFY_INDEX is used, so a task that calls
+ * xWaitForMultipleObjects() must not use that index for anything else.
+ *
+ * Only one task at a time can wait for a given queue, semaphore or stream
+ * buffer as one of several objects, and an object must not be deleted while a
+ * task is waiting for it.
+ *
+ * configUSE_WAIT_OBJECTS must be set to 1 in FreeRTOSConfig.h for
+ * xWaitForMultipleObjects() to be available.
+ */
+
+/**
+ * wait_objects.h
+ *
+ * The kinds of object that can be waited for.
+ *
+ * \ingroup WaitObjects
+ */
+typedef enum
+{
+    eWaitObjectQueue = 0,    /* A queue that holds data, or a semaphore or mutex that is available to take. */
+    eWaitObjectStreamBuffer, /* A stream buffer or message buffer that holds data. */
+    eWaitObjectNotification  /* A notification of the calling task that has not been waited for. */
+} eWaitObjectType;
+
+/**
+ * wait_objects.h
+ *
+ * One object in the array passed to xWaitForMultipleObjects().
+ *
+ * \ingroup WaitObjects
+ */
+typedef struct xWAIT_OBJECT
+{
+    eWaitObjectType eType; /* The kind of object. */
+    void * pvObject;       /* The QueueHandle_t, SemaphoreHandle_t or StreamBufferHandle_t of the object.  Not used for notifications. */
+    UBaseType_t uxIndex;   /* The notification index when eType is eWaitObjectNotification, otherwise not used. */
+} WaitObject_t;
+
+/* Returned by xWaitForMultipleObjects() if no object became ready. */
+#define waitOBJECTS_TIMEOUT    ( ( BaseType_t ) -1 )
+
+/**
+ * wait_objects.h
+ * @code{c}
+ * BaseType_t xWaitForMultipleObjects( const WaitObject_t * const pxObjects,
+ *                                     UBaseType_t uxObjectCount,
+ *                                     TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Block until at least one of uxObjectCount objects is ready.
+ *
+ * + A queue is ready when it holds at least one item.  A semaphore or mutex is
+ *   ready when it can be taken.
+ * + A stream buffer or message buffer is ready when it is not empty.  As with
+ *   xStreamBufferReceive(), a task that is blocked is only unblocked once the
+ *   number of bytes in a stream buffer reaches its trigger level.
+ * + A notification is ready when the calling task has received a notification
+ *   at that index that has not yet been waited for, for example using
+ *   ulTaskNotifyTakeIndexed() or xTaskNotifyWaitIndexed().
+ *
+ * Nothing is read from the object that is ready.  The calling task must then
+ * read from the object using the function normally used to do so, with a block
+ * time of zero.  If several objects are ready the one with the lowest position
+ * in pxObjects is returned.
+ *
+ * Must not be called from an interrupt service routine.
+ *
+ * @param pxObjects An array of uxObjectCount objects to wait for.
+ *
+ * @param uxObjectCount The number of objects in pxObjects.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for an object to be ready.  Setting xTicksToWait to
+ * portMAX_DELAY will cause the task to wait indefinitely (without timing out),
+ * provided INCLUDE_vTaskSuspend is set to 1 in FreeRTOSConfig.h.
+ *
+ * @return The position in pxObjects of an object that is ready, or
+ * waitOBJECTS_TIMEOUT if none was ready before xTicksToWait expired.
+ *
+ * Example use:
+ * @code{c}
+ * void vAFunction( QueueHandle_t xQueue, SemaphoreHandle_t xSemaphore )
+ * {
+ *     uint32_t ulReceived;
+ *     WaitObject_t xObjects[ 3 ] =
+ *     {
+ *         { eWaitObjectQueue,        ( void * ) xQueue,     0 },
+ *         { eWaitObjectQueue,        ( void * ) xSemaphore, 0 },
+ *         { eWaitObjectNotification, NULL,                  0 }
+ *     };
+ *
+ *     for( ;; )
+ *     {
+ *         switch( xWaitForMultipleObjects( xObjects, 3, portMAX_DELAY ) )
+ *         {
+ *             case 0:
+ *                 xQueueReceive( xQueue, &ulReceived, 0 );
+ *                 break;
+ *
+ *             case 1:
+ *                 xSemaphoreTake( xSemaphore, 0 );
+ *                 break;
+ *
+ *             case 2:
+ *                 ulTaskNotifyTakeIndexed( 0, pdTRUE, 0 );
+ *                 break;
+ *
+ *             default:
+ *                 break;
+ *         }
+ *     }
+ * }
+ * @endcode
+ * \defgroup xWaitForMultipleObjects xWaitForMultipleObjects
+ * \ingroup WaitObjects
+ */
+BaseType_t xWaitForMultipleObjects( const WaitObject_t * const pxObjects,
+                                    UBaseType_t uxObjectCount,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* WAIT_OBJECTS_H */
@@ -0,0 +1,388 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef WORK_QUEUE_H
+#define WORK_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include work_queue.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * A work queue is a task, created and owned by the kernel, that runs work items
+ * submitted to it by other tasks and by interrupts.  Work queues are used to
+ * defer processing from an interrupt to a task, in the same way as
+ * xTimerPendFunctionCallFromISR(), but:
+ *
+ * + Work items are allocated by the application, usually statically, and are
+ *   linked into the work queue directly, so submitting a work item never
+ *   copies anything and never fails because a queue is full.
+ *
+ * + The application can create a work queue for each priority level of
+ *   deferred work it needs, instead of running all deferred work at
+ *   configTIMER_TASK_PRIORITY behind any timer callbacks.
+ *
+ * + Submitting a work item that is already waiting to run does nothing, so an
+ *   interrupt that fires again before its deferred work has run does not need
+ *   a second work item.
+ *
+ * If configWORK_QUEUE_USE_ATOMICS is 1 work items are added to a work queue
+ * using the compare and swap function from atomic.h, so submitting a work item
+ * from an interrupt does not need a critical section.  configWORK_QUEUE_USE_ATOMICS
+ * defaults to the value of configPOOL_USE_ATOMICS.
+ *
+ * If configGENERATE_RUN_TIME_STATS is 1 each work queue also records the time
+ * between a work item being submitted and the work item starting to run - see
+ * vWorkQueueGetStats().
+ */
+
+/**
+ * work_queue.h
+ *
+ * Type by which work queues are referenced.  For example, a call to
+ * xWorkQueueCreate() returns a WorkQueueHandle_t variable that can then be used
+ * as a parameter to xWorkQueueSubmit(), xWorkQueueSubmitFromISR(), etc.
+ *
+ * \defgroup WorkQueueHandle_t WorkQueueHandle_t
+ * \ingroup WorkQueues
+ */
+struct WorkQueueDefinition;
+typedef struct WorkQueueDefinition * WorkQueueHandle_t;
+
+/**
+ * work_queue.h
+ *
+ * Type by which work items are referenced.  A call to xWorkItemCreateStatic()
+ * returns a WorkItemHandle_t variable that can then be submitted to a work
+ * queue.
+ *
+ * \defgroup WorkItemHandle_t WorkItemHandle_t
+ * \ingroup WorkQueues
+ */
+struct WorkItemDefinition;
+typedef struct WorkItemDefinition * WorkItemHandle_t;
+
+/*
+ * Defines the prototype to which work item functions must conform.  This is
+ * the same as the prototype of functions passed to
+ * xTimerPendFunctionCallFromISR(), so existing deferred functions can be run
+ * from a work queue unchanged.
+ */
+typedef void (* WorkFunction_t)( void * pvParameter1,
+                                 uint32_t ulParameter2 );
+
+/*
+ * Used with vWorkQueueGetStats() to obtain the statistics kept by a work queue.
+ * The latency of a work item is the time between it being submitted and it
+ * starting to run, measured in the units of the run time counter.  The latency
+ * members are only updated if configGENERATE_RUN_TIME_STATS is 1.
+ */
+typedef struct xWORK_QUEUE_STATS
+{
+    uint32_t ulItemsRun;                        /*< The number of work items the work queue has run. */
+    configRUN_TIME_COUNTER_TYPE ulTotalLatency; /*< The sum of the latencies of all the work items run. */
+    configRUN_TIME_COUNTER_TYPE ulMaxLatency;   /*< The longest latency of any work item run. */
+} WorkQueueStats_t;
+
+/**
+ * work_queue.h
+ * @code{c}
+ * WorkQueueHandle_t xWorkQueueCreate( const char * const pcName,
+ *                                     UBaseType_t uxPriority,
+ *                                     configSTACK_DEPTH_TYPE usStackDepth );
+ * @endcode
+ *
+ * Creates a new work queue, and the task that runs the work items submitted to
+ * it, using memory allocated from the FreeRTOS heap.
+ *
+ * Work items run in the work queue's task, one after the other, in the order in
+ * which they were submitted.  Like software timer callbacks they run in
+ * privileged mode on ports that use an MPU.  A work item must not block for
+ * long, as doing so delays all the work items behind it.
+ *
+ * @param pcName A descriptive name for the work queue's task.
+ *
+ * @param uxPriority The priority at which the work queue's task runs.  Work
+ * items submitted from an interrupt run as soon as the interrupt exits if this
+ * is higher than the priority of any other task that is able to run.
+ *
+ * @param usStackDepth The size of the work queue task's stack, specified as the
+ * number of words the stack can hold, as with xTaskCreate().  It must be large
+ * enough for the work item function that uses the most stack.
+ *
+ * @return If the work queue is created successfully then a handle to the
+ * created work queue is returned.  If there was not enough heap memory
+ * available to create the work queue then NULL is returned.
+ *
+ * Example use:
+ * @code{c}
+ *
+ * static WorkQueueHandle_t xRxWorkQueue;
+ * static StaticWorkItem_t xRxWorkItemBuffer;
+ * static WorkItemHandle_t xRxWorkItem;
+ *
+ * // Runs in the work queue's task each time the interrupt submits xRxWorkItem.
+ * static void prvProcessRx( void * pvParameter1,
+ *                           uint32_t ulParameter2 )
+ * {
+ *     // Empty the peripheral's receive FIFO here.
+ * }
+ *
+ * void vSetupRx( void )
+ * {
+ *     xRxWorkQueue = xWorkQueueCreate( "RxWork", configMAX_PRIORITIES - 1, configMINIMAL_STACK_SIZE );
+ *     xRxWorkItem = xWorkItemCreateStatic( prvProcessRx, NULL, 0, &xRxWorkItemBuffer );
+ * }
+ *
+ * void vRxISR( void )
+ * {
+ *     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *     // Disable the peripheral's receive interrupt here, then defer the
+ *     // rest of the processing to the work queue.
+ *     xWorkQueueSubmitFromISR( xRxWorkQueue, xRxWorkItem, &xHigherPriorityTaskWoken );
+ *
+ *     portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ *
+ * @endcode
+ * \defgroup xWorkQueueCreate xWorkQueueCreate
+ * \ingroup WorkQueues
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    WorkQueueHandle_t xWorkQueueCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                        UBaseType_t uxPriority,
+                                        configSTACK_DEPTH_TYPE usStackDepth ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * work_queue.h
+ * @code{c}
+ * WorkQueueHandle_t xWorkQueueCreateStatic( const char * const pcName,
+ *                                           UBaseType_t uxPriority,
+ *                                           uint32_t ulStackDepth,
+ *                                           StackType_t * const puxStackBuffer,
+ *                                           StaticTask_t * const pxTaskBuffer,
+ *                                           StaticWorkQueue_t * const pxWorkQueueBuffer );
+ * @endcode
+ *
+ * Creates a new work queue, and the task that runs the work items submitted to
+ * it, using memory provided by the application.  See xWorkQueueCreate() for a
+ * description of the other parameters.
+ *
+ * @param puxStackBuffer Must point to a StackType_t array that has at least
+ * ulStackDepth indexes.  The array is used as the work queue task's stack.
+ *
+ * @param pxTaskBuffer Must point to a variable of type StaticTask_t, which is
+ * used to hold the work queue task's data structure.
+ *
+ * @param pxWorkQueueBuffer Must point to a variable of type StaticWorkQueue_t,
+ * which is used to hold the work queue's data structure.
+ *
+ * @return If none of the buffers are NULL then a handle to the created work
+ * queue is returned, otherwise NULL is returned.
+ *
+ * \defgroup xWorkQueueCreateStatic xWorkQueueCreateStatic
+ * \ingroup WorkQueues
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    WorkQueueHandle_t xWorkQueueCreateStatic( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                              UBaseType_t uxPriority,
+                                              uint32_t ulStackDepth,
+                                              StackType_t * const puxStackBuffer,
+                                              StaticTask_t * const pxTaskBuffer,
+                                              StaticWorkQueue_t * const pxWorkQueueBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * work_queue.h
+ * @code{c}
+ * WorkItemHandle_t xWorkItemCreateStatic( WorkFunction_t pxFunction,
+ *                                         void * pvParameter1,
+ *                                         uint32_t ulParameter2,
+ *                                         StaticWorkItem_t * const pxWorkItemBuffer );
+ * @endcode
+ *
+ * Initialises a work item.  A work item is always provided by the application,
+ * so it can be submitted to a work queue without any memory being allocated,
+ * and is available to be submitted again as soon as its function starts to
+ * run.  The memory used by a work item must remain valid while the work item
+ * is waiting to run.
+ *
+ * @param pxFunction The function the work item runs.  The function must
+ * conform to the WorkFunction_t prototype.
+ *
+ * @param pvParameter1 The value passed into pxFunction as its first parameter.
+ *
+ * @param ulParameter2 The value passed into pxFunction as its second parameter.
+ *
+ * @param pxWorkItemBuffer Must point to a variable of type StaticWorkItem_t,
+ * which is used to hold the work item's data structure.
+ *
+ * @return A handle to the work item, or NULL if pxWorkItemBuffer was NULL.
+ *
+ * \defgroup xWorkItemCreateStatic xWorkItemCreateStatic
+ * \ingroup WorkQueues
+ */
+WorkItemHandle_t xWorkItemCreateStatic( WorkFunction_t pxFunction,
+                                        void * pvParameter1,
+                                        uint32_t ulParameter2,
+                                        StaticWorkItem_t * const pxWorkItemBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * work_queue.h
+ * @code{c}
+ * BaseType_t xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue,
+ *                              WorkItemHandle_t xWorkItem );
+ * @endcode
+ *
+ * Submits a work item to a work queue, so the work item's function is run by
+ * the work queue's task after any work items that were submitted before it.
+ *
+ * Do not call this function from an interrupt service routine.  See
+ * xWorkQueueSubmitFromISR() for an alternative that can be used from an ISR.
+ *
+ * @param xWorkQueue The handle of the work queue to which the work item is
+ * submitted.
+ *
+ * @param xWorkItem The handle of the work item being submitted.
+ *
+ * @return pdPASS if the work item was submitted.  pdFAIL if the work item was
+ * already waiting to run, in which case it still only runs once.
+ *
+ * \defgroup xWorkQueueSubmit xWorkQueueSubmit
+ * \ingroup WorkQueues
+ */
+BaseType_t xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue,
+                             WorkItemHandle_t xWorkItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * work_queue.h
+ * @code{c}
+ * BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue,
+ *                                     WorkItemHandle_t xWorkItem,
+ *                                     BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xWorkQueueSubmit() that can be called from an interrupt service
+ * routine (ISR).
+ *
+ * @param xWorkQueue The handle of the work queue to which the work item is
+ * submitted.
+ *
+ * @param xWorkItem The handle of the work item being submitted.
+ *
+ * @param pxHigherPriorityTaskWoken *pxHigherPriorityTaskWoken is set to pdTRUE
+ * if submitting the work item unblocked the work queue's task, and the work
+ * queue's task has a priority above that of the task that was interrupted, in
+ * which case a context switch should be requested before the interrupt is
+ * exited.
+ *
+ * @return pdPASS if the work item was submitted.  pdFAIL if the work item was
+ * already waiting to run, in which case it still only runs once.
+ *
+ * \defgroup xWorkQueueSubmitFromISR xWorkQueueSubmitFromISR
+ * \ingroup WorkQueues
+ */
+BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue,
+                                    WorkItemHandle_t xWorkItem,
+                                    BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * work_queue.h
+ * @code{c}
+ * BaseType_t xWorkItemIsPending( WorkItemHandle_t xWorkItem );
+ * @endcode
+ *
+ * Queries whether a work item has been submitted to a work queue but has not
+ * yet started to run.
+ *
+ * @param xWorkItem The handle of the work item being queried.
+ *
+ * @return pdTRUE if the work item is waiting to run, otherwise pdFALSE.
+ *
+ * \defgroup xWorkItemIsPending xWorkItemIsPending
+ * \ingroup WorkQueues
+ */
+BaseType_t xWorkItemIsPending( WorkItemHandle_t xWorkItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * work_queue.h
+ * @code{c}
+ * void vWorkQueueGetStats( WorkQueueHandle_t xWorkQueue,
+ *                          WorkQueueStats_t * pxStats );
+ * @endcode
+ *
+ * Obtains the number of work items a work queue has run and, if
+ * configGENERATE_RUN_TIME_STATS is 1, the total and maximum time the work
+ * items waited to start running after being submitted.  The statistics are
+ * updated each time the work queue's task finishes running the work items that
+ * were waiting when it last woke up.
+ *
+ * @param xWorkQueue The handle of the work queue being queried.
+ *
+ * @param pxStats The work queue's statistics are written to the structure
+ * pointed to by pxStats.
+ *
+ * \defgroup vWorkQueueGetStats vWorkQueueGetStats
+ * \ingroup WorkQueues
+ */
+void vWorkQueueGetStats( WorkQueueHandle_t xWorkQueue,
+                         WorkQueueStats_t * pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * work_queue.h
+ * @code{c}
+ * TaskHandle_t xWorkQueueGetTaskHandle( WorkQueueHandle_t xWorkQueue );
+ * @endcode
+ *
+ * Returns the handle of the task that runs a work queue's work items, for
+ * example so its priority can be changed with vTaskPrioritySet().
+ *
+ * @param xWorkQueue The handle of the work queue being queried.
+ *
+ * @return The handle of the work queue's task.
+ *
+ * \defgroup xWorkQueueGetTaskHandle xWorkQueueGetTaskHandle
+ * \ingroup WorkQueues
+ */
+TaskHandle_t xWorkQueueGetTaskHandle( WorkQueueHandle_t xWorkQueue ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* WORK_QUEUE_H */
@@ -0,0 +1,283 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "kernel_data.h"
+
+/* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the kernel data page.  This #if is closed at the very bottom of
+ * this file. */
+#if ( configUSE_KERNEL_DATA_PAGE == 1 )
+
+/* The page is deliberately not PRIVILEGED_DATA, as unprivileged tasks must be
+ * able to read it.  The reader functions below are not PRIVILEGED_FUNCTIONs for
+ * the same reason. */
+    KERNEL_DATA_PAGE KernelDataPage_t xKernelDataPage = { ( TickType_t ) configINITIAL_TICK_COUNT };
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the slot at which to start looking for the slot that describes
+ * pvObject, or a free slot for it.  Claiming a slot and looking one up both
+ * start from the same slot, so a lookup normally finds the object in the first
+ * slot it reads instead of searching the whole page.
+ */
+    static UBaseType_t prvKernelDataFirstSlot( const void * pvObject,
+                                               UBaseType_t uxSlots );
+
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvKernelDataFirstSlot( const void * pvObject,
+                                               UBaseType_t uxSlots )
+    {
+        /* Objects are at least portBYTE_ALIGNMENT aligned, so the low bits of
+         * the address carry no information. */
+        return ( UBaseType_t ) ( ( ( portPOINTER_SIZE_TYPE ) pvObject / ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT ) % ( portPOINTER_SIZE_TYPE ) uxSlots ); /*lint !e923 !e9078 Only the value of the address is used. */
+    }
+/*-----------------------------------------------------------*/
+
+    TickType_t xKernelDataGetTickCount( void )
+    {
+        TickType_t xTicks;
+
+        #if ( portTICK_TYPE_IS_ATOMIC == 0 )
+        {
+            /* The tick count cannot be read in one access, and interrupts
+             * cannot be disabled from an unprivileged task, so read it until
+             * two reads agree to be sure it did not change part way through. */
+            do
+            {
+                xTicks = xKernelDataPage.xTickCount;
+            } while( xTicks != xKernelDataPage.xTickCount );
+        }
+        #else
+        {
+            xTicks = xKernelDataPage.xTickCount;
+        }
+        #endif
+
+        return xTicks;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xKernelDataGetQueueMessagesWaiting( QueueHandle_t xQueue,
+                                                   UBaseType_t * puxMessagesWaiting )
+    {
+        UBaseType_t uxSlot, uxSlotsSearched, uxMessagesWaiting;
+        BaseType_t xReturn = pdFALSE;
+
+        configASSERT( puxMessagesWaiting );
+
+        /* The queue is normally in the first slot read.  Only a queue that
+         * does not have a slot requires every slot to be read. */
+        uxSlot = prvKernelDataFirstSlot( ( void * ) xQueue, ( UBaseType_t ) configKERNEL_DATA_PAGE_QUEUES );
+
+        for( uxSlotsSearched = 0; uxSlotsSearched < ( UBaseType_t ) configKERNEL_DATA_PAGE_QUEUES; uxSlotsSearched++ )
+        {
+            if( xKernelDataPage.xQueues[ uxSlot ].pvQueue == ( void * ) xQueue )
+            {
+                uxMessagesWaiting = xKernelDataPage.xQueues[ uxSlot ].uxMessagesWaiting;
+
+                /* Only use the count if the slot was not released, and
+                 * possibly claimed by another queue, while it was read. */
+                if( xKernelDataPage.xQueues[ uxSlot ].pvQueue == ( void * ) xQueue )
+                {
+                    *puxMessagesWaiting = uxMessagesWaiting;
+                    xReturn = pdTRUE;
+                }
+
+                break;
+            }
+
+            uxSlot++;
+
+            if( uxSlot == ( UBaseType_t ) configKERNEL_DATA_PAGE_QUEUES )
+            {
+                uxSlot = 0;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xKernelDataGetTaskState( TaskHandle_t xTask,
+                                        eTaskState * peState )
+    {
+        UBaseType_t uxSlot, uxSlotsSearched;
+        eTaskState eState;
+        BaseType_t xReturn = pdFALSE;
+
+        configASSERT( peState );
+
+        uxSlot = prvKernelDataFirstSlot( ( void * ) xTask, ( UBaseType_t ) configKERNEL_DATA_PAGE_TASKS );
+
+        for( uxSlotsSearched = 0; uxSlotsSearched < ( UBaseType_t ) configKERNEL_DATA_PAGE_TASKS; uxSlotsSearched++ )
+        {
+            if( xKernelDataPage.xTasks[ uxSlot ].pvTask == ( void * ) xTask )
+            {
+                eState = xKernelDataPage.xTasks[ uxSlot ].eState;
+
+                if( xKernelDataPage.xTasks[ uxSlot ].pvTask == ( void * ) xTask )
+                {
+                    *peState = eState;
+                    xReturn = pdTRUE;
+                }
+
+                break;
+            }
+
+            uxSlot++;
+
+            if( uxSlot == ( UBaseType_t ) configKERNEL_DATA_PAGE_TASKS )
+            {
+                uxSlot = 0;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxKernelDataClaimQueueSlot( void * pvQueue,
+                                            UBaseType_t uxMessagesWaiting )
+    {
+        UBaseType_t uxSlot, uxSlotsSearched;
+
+        configASSERT( pvQueue );
+
+        /* Use the first free slot from the one lookups start at. */
+        uxSlot = prvKernelDataFirstSlot( pvQueue, ( UBaseType_t ) configKERNEL_DATA_PAGE_QUEUES );
+
+        for( uxSlotsSearched = 0; uxSlotsSearched < ( UBaseType_t ) configKERNEL_DATA_PAGE_QUEUES; uxSlotsSearched++ )
+        {
+            if( xKernelDataPage.xQueues[ uxSlot ].pvQueue == NULL )
+            {
+                /* Set the count before the handle so a reader never sees the
+                 * count left by the slot's previous queue. */
+                xKernelDataPage.xQueues[ uxSlot ].uxMessagesWaiting = uxMessagesWaiting;
+                portMEMORY_BARRIER();
+                xKernelDataPage.xQueues[ uxSlot ].pvQueue = pvQueue;
+                break;
+            }
+
+            uxSlot++;
+
+            if( uxSlot == ( UBaseType_t ) configKERNEL_DATA_PAGE_QUEUES )
+            {
+                uxSlot = 0;
+            }
+        }
+
+        if( uxSlotsSearched == ( UBaseType_t ) configKERNEL_DATA_PAGE_QUEUES )
+        {
+            /* The page is full. */
+            uxSlot = ( UBaseType_t ) configKERNEL_DATA_PAGE_QUEUES;
+        }
+
+        return uxSlot;
+    }
+/*-----------------------------------------------------------*/
+
+    void vKernelDataReleaseQueueSlot( UBaseType_t uxSlot )
+    {
+        if( uxSlot < ( UBaseType_t ) configKERNEL_DATA_PAGE_QUEUES )
+        {
+            xKernelDataPage.xQueues[ uxSlot ].pvQueue = NULL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxKernelDataClaimTaskSlot( void * pvTask,
+                                           eTaskState eState )
+    {
+        UBaseType_t uxSlot, uxSlotsSearched;
+
+        configASSERT( pvTask );
+
+        uxSlot = prvKernelDataFirstSlot( pvTask, ( UBaseType_t ) configKERNEL_DATA_PAGE_TASKS );
+
+        for( uxSlotsSearched = 0; uxSlotsSearched < ( UBaseType_t ) configKERNEL_DATA_PAGE_TASKS; uxSlotsSearched++ )
+        {
+            if( xKernelDataPage.xTasks[ uxSlot ].pvTask == NULL )
+            {
+                xKernelDataPage.xTasks[ uxSlot ].eState = eState;
+                portMEMORY_BARRIER();
+                xKernelDataPage.xTasks[ uxSlot ].pvTask = pvTask;
+                break;
+            }
+
+            uxSlot++;
+
+            if( uxSlot == ( UBaseType_t ) configKERNEL_DATA_PAGE_TASKS )
+            {
+                uxSlot = 0;
+            }
+        }
+
+        if( uxSlotsSearched == ( UBaseType_t ) configKERNEL_DATA_PAGE_TASKS )
+        {
+            uxSlot = ( UBaseType_t ) configKERNEL_DATA_PAGE_TASKS;
+        }
+
+        return uxSlot;
+    }
+/*-----------------------------------------------------------*/
+
+    void vKernelDataReleaseTaskSlot( UBaseType_t uxSlot )
+    {
+        if( uxSlot < ( UBaseType_t ) configKERNEL_DATA_PAGE_TASKS )
+        {
+            xKernelDataPage.xTasks[ uxSlot ].pvTask = NULL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_KERNEL_DATA_PAGE */
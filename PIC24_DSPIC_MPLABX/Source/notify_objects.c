@@ -0,0 +1,305 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Notification objects only use the public task notification API, so unlike
+ * the other source files in this directory this file does not define
+ * MPU_WRAPPERS_INCLUDED_FROM_API_FILE.  On ports that use an MPU its functions
+ * run with the privilege of the calling task, and call the kernel through the
+ * MPU wrappers. */
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "notify_objects.h"
+
+/* This entire source file will be skipped if the application is not configured
+ * to include notification object functionality.  This #if is closed at the very
+ * bottom of this file. */
+#if ( configUSE_NOTIFY_OBJECTS == 1 )
+
+/* Only the task that owns a notification object can block on it, as it is that
+ * task's notification that unblocks it. */
+    #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+        #define notifyASSERT_OWNER( xOwner )    configASSERT( ( xOwner ) == xTaskGetCurrentTaskHandle() )
+    #else
+        #define notifyASSERT_OWNER( xOwner )
+    #endif
+
+/*
+ * Clears the notification value and state at uxIndex of xOwner's notification
+ * array, so a new object starts with no count, no flags and no pending
+ * notification left over from a previous user of the same index.
+ */
+    static void prvResetNotification( TaskHandle_t xOwner,
+                                      UBaseType_t uxIndex );
+
+/*-----------------------------------------------------------*/
+
+    static void prvResetNotification( TaskHandle_t xOwner,
+                                      UBaseType_t uxIndex )
+    {
+        configASSERT( xOwner != NULL );
+        configASSERT( uxIndex < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+        ( void ) ulTaskNotifyValueClearIndexed( xOwner, uxIndex, ~( ( uint32_t ) 0UL ) );
+        ( void ) xTaskNotifyStateClearIndexed( xOwner, uxIndex );
+    }
+/*-----------------------------------------------------------*/
+
+    void vNotifyMailboxInit( NotifyMailbox_t * const pxMailbox,
+                             TaskHandle_t xReader,
+                             UBaseType_t uxIndex )
+    {
+        configASSERT( pxMailbox );
+
+        prvResetNotification( xReader, uxIndex );
+
+        pxMailbox->xReader = xReader;
+        pxMailbox->uxIndex = uxIndex;
+        pxMailbox->pvMessage = NULL;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xNotifyMailboxPost( NotifyMailbox_t * const pxMailbox,
+                                   void * pvMessage )
+    {
+        BaseType_t xReturn = pdFAIL;
+
+        configASSERT( pxMailbox );
+        configASSERT( pvMessage != NULL );
+
+        taskENTER_CRITICAL();
+        {
+            if( pxMailbox->pvMessage == NULL )
+            {
+                pxMailbox->pvMessage = pvMessage;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /* The reader is notified outside of the critical section.  If it runs
+         * between the two it finds the message without blocking, and the
+         * notification left behind only makes its next receive check the
+         * mailbox once more before blocking. */
+        if( xReturn == pdPASS )
+        {
+            ( void ) xTaskNotifyGiveIndexed( pxMailbox->xReader, pxMailbox->uxIndex );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xNotifyMailboxPostFromISR( NotifyMailbox_t * const pxMailbox,
+                                          void * pvMessage,
+                                          BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        BaseType_t xReturn = pdFAIL;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( pxMailbox );
+        configASSERT( pvMessage != NULL );
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( pxMailbox->pvMessage == NULL )
+            {
+                pxMailbox->pvMessage = pvMessage;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        if( xReturn == pdPASS )
+        {
+            vTaskNotifyGiveIndexedFromISR( pxMailbox->xReader, pxMailbox->uxIndex, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xNotifyMailboxReceive( NotifyMailbox_t * const pxMailbox,
+                                      void ** ppvMessage,
+                                      TickType_t xTicksToWait )
+    {
+        TimeOut_t xTimeOut;
+        void * pvMessage;
+
+        configASSERT( pxMailbox );
+        configASSERT( ppvMessage );
+        notifyASSERT_OWNER( pxMailbox->xReader );
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                pvMessage = pxMailbox->pvMessage;
+                pxMailbox->pvMessage = NULL;
+            }
+            taskEXIT_CRITICAL();
+
+            if( pvMessage != NULL )
+            {
+                break;
+            }
+            else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                break;
+            }
+            else
+            {
+                /* A notification can be left over from a message that was
+                 * received without blocking, so the mailbox is checked again
+                 * each time this returns. */
+                ( void ) ulTaskNotifyTakeIndexed( pxMailbox->uxIndex, pdTRUE, xTicksToWait );
+            }
+        }
+
+        *ppvMessage = pvMessage;
+
+        return ( pvMessage != NULL ) ? pdPASS : pdFAIL;
+    }
+/*-----------------------------------------------------------*/
+
+    void vNotifySemaphoreInit( NotifySemaphore_t * const pxSemaphore,
+                               TaskHandle_t xOwner,
+                               UBaseType_t uxIndex )
+    {
+        configASSERT( pxSemaphore );
+
+        prvResetNotification( xOwner, uxIndex );
+
+        pxSemaphore->xOwner = xOwner;
+        pxSemaphore->uxIndex = uxIndex;
+    }
+/*-----------------------------------------------------------*/
+
+    void vNotifyEventFlagsInit( NotifyEventFlags_t * const pxFlags,
+                                TaskHandle_t xOwner,
+                                UBaseType_t uxIndex )
+    {
+        configASSERT( pxFlags );
+
+        prvResetNotification( xOwner, uxIndex );
+
+        pxFlags->xOwner = xOwner;
+        pxFlags->uxIndex = uxIndex;
+    }
+/*-----------------------------------------------------------*/
+
+    uint32_t ulNotifyEventFlagsWait( NotifyEventFlags_t * const pxFlags,
+                                     uint32_t ulFlagsToWaitFor,
+                                     BaseType_t xClearOnExit,
+                                     BaseType_t xWaitForAllFlags,
+                                     TickType_t xTicksToWait )
+    {
+        TimeOut_t xTimeOut;
+        uint32_t ulFlags;
+        BaseType_t xWaitConditionMet;
+
+        configASSERT( pxFlags );
+        configASSERT( ulFlagsToWaitFor != 0UL );
+        notifyASSERT_OWNER( pxFlags->xOwner );
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        for( ; ; )
+        {
+            /* Reading the flags and clearing the ones waited for must be
+             * atomic, or a flag set by an interrupt in between would be lost. */
+            taskENTER_CRITICAL();
+            {
+                ulFlags = ulTaskNotifyValueClearIndexed( NULL, pxFlags->uxIndex, 0UL );
+
+                if( xWaitForAllFlags == pdFALSE )
+                {
+                    xWaitConditionMet = ( ( ulFlags & ulFlagsToWaitFor ) != 0UL ) ? pdTRUE : pdFALSE;
+                }
+                else
+                {
+                    xWaitConditionMet = ( ( ulFlags & ulFlagsToWaitFor ) == ulFlagsToWaitFor ) ? pdTRUE : pdFALSE;
+                }
+
+                if( ( xWaitConditionMet != pdFALSE ) && ( xClearOnExit != pdFALSE ) )
+                {
+                    ( void ) ulTaskNotifyValueClearIndexed( NULL, pxFlags->uxIndex, ulFlagsToWaitFor );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xWaitConditionMet != pdFALSE )
+            {
+                break;
+            }
+            else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                break;
+            }
+            else
+            {
+                /* Flags are only ever added by a notification, so wait for the
+                 * next one without changing the value and test again.  A
+                 * notification left over from flags that were already set makes
+                 * this return straight away, after which it blocks. */
+                ( void ) xTaskNotifyWaitIndexed( pxFlags->uxIndex, 0UL, 0UL, NULL, xTicksToWait );
+            }
+        }
+
+        return ulFlags;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include notification object functionality.  If you want to include
+ * notification objects then ensure configUSE_NOTIFY_OBJECTS is set to 1 in
+ * FreeRTOSConfig.h. */
+#endif /* configUSE_NOTIFY_OBJECTS == 1 */
@@ -0,0 +1,696 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+#include "pool.h"
+
+/* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021 See comment above. */
+
+/* Pools can only be created from statically allocated memory, so this file
+ * builds to nothing if configSUPPORT_STATIC_ALLOCATION is not set to 1. */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+/* Constants used with the cFreeLock structure member. */
+    #define poolUNLOCKED             ( ( int8_t ) -1 )
+    #define poolLOCKED_UNMODIFIED    ( ( int8_t ) 0 )
+    #define poolINT8_MAX             ( ( int8_t ) 127 )
+
+/* The head of the free block list holds the index of the first free block in
+ * its low 16 bits, and a count of the changes made to the list in its high 16
+ * bits.  The count changes every time the list changes, so a compare and swap
+ * that was based on an out of date head fails even if the same block has since
+ * returned to the head of the list (the 'ABA' problem).  The link stored in
+ * each free block is just the index of the next free block. */
+    #define poolINDEX_MASK           ( ( uint32_t ) 0x0000ffffUL )
+    #define poolCOUNT_MASK           ( ( uint32_t ) 0xffff0000UL )
+    #define poolCOUNT_INCREMENT      ( ( uint32_t ) 0x00010000UL )
+    #define poolNO_BLOCK             ( ( uint32_t ) 0x0000ffffUL )
+
+    #if ( configPOOL_USE_ATOMICS == 1 )
+
+/* The free block list is updated using atomic.h, so no critical section is
+ * needed around prvPopFreeBlock() and prvPushFreeBlock(). */
+        #define poolCOMPARE_AND_SWAP( pulDestination, ulExchange, ulComparand )    Atomic_CompareAndSwap_u32( ( pulDestination ), ( ulExchange ), ( ulComparand ) )
+        #define poolINCREMENT( pulAddend )                                         ( void ) Atomic_Increment_u32( pulAddend )
+        #define poolDECREMENT( pulAddend )                                         ( void ) Atomic_Decrement_u32( pulAddend )
+        #define poolENTER_CRITICAL()
+        #define poolEXIT_CRITICAL()
+        #define poolSET_INTERRUPT_MASK_FROM_ISR()                                  ( ( UBaseType_t ) 0 )
+        #define poolCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedStatusValue )            ( void ) ( uxSavedStatusValue )
+    #else
+
+/* The port cannot use atomic.h from both tasks and interrupts (see the
+ * definition of configPOOL_USE_ATOMICS in FreeRTOS.h), so prvPopFreeBlock() and
+ * prvPushFreeBlock() are called from inside a critical section, and the compare
+ * and swap always succeeds. */
+        #define poolCOMPARE_AND_SWAP( pulDestination, ulExchange, ulComparand )    ( ( *( pulDestination ) = ( ulExchange ) ), ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+        #define poolINCREMENT( pulAddend )                                         ( *( pulAddend ) )++
+        #define poolDECREMENT( pulAddend )                                         ( *( pulAddend ) )--
+        #define poolENTER_CRITICAL()                                               taskENTER_CRITICAL()
+        #define poolEXIT_CRITICAL()                                                taskEXIT_CRITICAL()
+        #define poolSET_INTERRUPT_MASK_FROM_ISR()                                  portSET_INTERRUPT_MASK_FROM_ISR()
+        #define poolCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedStatusValue )            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedStatusValue )
+    #endif /* configPOOL_USE_ATOMICS */
+
+    #if ( configUSE_PREEMPTION == 0 )
+
+/* If the cooperative scheduler is being used then a yield should not be
+ * performed just because a higher priority task has been woken. */
+        #define poolYIELD_IF_USING_PREEMPTION()
+    #else
+        #define poolYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
+    #endif
+
+/*
+ * Definition of a memory pool.
+ */
+    typedef struct PoolDefinition
+    {
+        uint8_t * pucStorage;                     /*< Points to the first block. */
+        size_t xBlockSize;                        /*< The size of each block, including any padding. */
+        UBaseType_t uxNumberOfBlocks;             /*< The number of blocks in the pool. */
+        volatile uint32_t ulFreeListHead;         /*< The index of the first free block and the list change count - see poolINDEX_MASK. */
+        volatile uint32_t ulBlocksAvailable;      /*< The number of free blocks. */
+        List_t xTasksWaitingToAllocate;           /*< List of tasks that are blocked waiting for a free block.  Stored in priority order. */
+        volatile int8_t cFreeLock;                /*< Stores the number of blocks freed from interrupts while the pool was locked.  Set to poolUNLOCKED when the pool is not locked. */
+
+        #if ( configUSE_TRACE_FACILITY == 1 )
+            UBaseType_t uxPoolNumber;
+        #endif
+    } Pool_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Remove the block at the head of the free block list, or return NULL if there
+ * are no free blocks.  If configPOOL_USE_ATOMICS is 1 this can be called from
+ * tasks and interrupts without a critical section.
+ */
+    static void * prvPopFreeBlock( Pool_t * const pxPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add a block to the head of the free block list.  If configPOOL_USE_ATOMICS
+ * is 1 this can be called from tasks and interrupts without a critical
+ * section.
+ */
+    static void prvPushFreeBlock( Pool_t * const pxPool,
+                                  void * pvBlock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unlocks a pool locked by a call to prvLockPool.  Locking a pool does not
+ * prevent an ISR from freeing blocks to the pool, but does prevent an ISR from
+ * removing tasks from the pool's event list.  If an ISR finds a pool is locked
+ * it increments the pool's lock count instead, so when the pool is unlocked
+ * one waiting task can be unblocked for each block freed while it was locked.
+ */
+    static void prvUnlockPool( Pool_t * const pxPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if the pool has no free blocks, otherwise pdFALSE.
+ */
+    static BaseType_t prvIsPoolEmpty( const Pool_t * pxPool ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Macro to mark a pool as locked.  Locking a pool prevents an ISR from
+ * accessing the pool's event list.
+ */
+    #define prvLockPool( pxPool )                              \
+    taskENTER_CRITICAL();                                      \
+    {                                                          \
+        if( ( pxPool )->cFreeLock == poolUNLOCKED )            \
+        {                                                      \
+            ( pxPool )->cFreeLock = poolLOCKED_UNMODIFIED;     \
+        }                                                      \
+    }                                                          \
+    taskEXIT_CRITICAL()
+
+/*
+ * Macro to increment the cFreeLock member of the pool data structure.  It is
+ * capped at the number of tasks in the system as we cannot unblock more tasks
+ * than the number of tasks in the system.
+ */
+    #define prvIncrementPoolFreeLock( pxPool, cFreeLock )                             \
+    {                                                                                 \
+        const UBaseType_t uxNumberOfTasks = uxTaskGetNumberOfTasks();                 \
+        if( ( UBaseType_t ) ( cFreeLock ) < uxNumberOfTasks )                         \
+        {                                                                             \
+            configASSERT( ( cFreeLock ) != poolINT8_MAX );                            \
+            ( pxPool )->cFreeLock = ( int8_t ) ( ( cFreeLock ) + ( int8_t ) 1 );      \
+        }                                                                             \
+    }
+
+/*-----------------------------------------------------------*/
+
+    PoolHandle_t xPoolCreateStatic( size_t xBlockSize,
+                                    UBaseType_t uxNumberOfBlocks,
+                                    uint8_t * pucPoolStorage,
+                                    StaticPool_t * pxStaticPool )
+    {
+        Pool_t * const pxPool = ( Pool_t * ) pxStaticPool; /*lint !e740 !e9087 Pool_t and StaticPool_t are deliberately aliased for data hiding purposes and guaranteed to have the same size and alignment requirement - checked by configASSERT(). */
+        UBaseType_t uxBlock;
+        uint8_t * pucBlock;
+        uint32_t ulNextBlock;
+        PoolHandle_t xReturn;
+
+        configASSERT( pucPoolStorage );
+        configASSERT( pxStaticPool );
+        configASSERT( xBlockSize > ( size_t ) 0 );
+        configASSERT( ( uxNumberOfBlocks > ( UBaseType_t ) 0 ) && ( uxNumberOfBlocks <= poolMAX_BLOCKS ) );
+
+        /* The storage area must be aligned so every block is aligned. */
+        configASSERT( ( ( portPOINTER_SIZE_TYPE ) pucPoolStorage & ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) == 0UL );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticPool_t equals the size of the real pool
+             * structure. */
+            volatile size_t xSize = sizeof( StaticPool_t );
+            configASSERT( xSize == sizeof( Pool_t ) );
+        } /*lint !e529 xSize is referenced if configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        if( ( pucPoolStorage != NULL ) && ( pxStaticPool != NULL ) )
+        {
+            pxPool->pucStorage = pucPoolStorage;
+            pxPool->xBlockSize = poolBLOCK_SIZE( xBlockSize );
+            pxPool->uxNumberOfBlocks = uxNumberOfBlocks;
+            pxPool->ulBlocksAvailable = ( uint32_t ) uxNumberOfBlocks;
+            pxPool->cFreeLock = poolUNLOCKED;
+            vListInitialise( &( pxPool->xTasksWaitingToAllocate ) );
+
+            /* Link every block into the free block list, in address order. */
+            pucBlock = pucPoolStorage;
+
+            for( uxBlock = 0; uxBlock < uxNumberOfBlocks; uxBlock++ )
+            {
+                ulNextBlock = ( ( uxBlock + ( UBaseType_t ) 1 ) < uxNumberOfBlocks ) ? ( uint32_t ) ( uxBlock + ( UBaseType_t ) 1 ) : poolNO_BLOCK;
+                *( ( uint32_t * ) pucBlock ) = ulNextBlock; /*lint !e9087 !e826 The block is aligned and at least sizeof( uint32_t ) bytes. */
+                pucBlock += pxPool->xBlockSize;
+            }
+
+            pxPool->ulFreeListHead = 0;
+
+            #if ( configUSE_TRACE_FACILITY == 1 )
+            {
+                pxPool->uxPoolNumber = 0;
+            }
+            #endif
+
+            traceCREATE_POOL( pxPool );
+            xReturn = pxPool;
+        }
+        else
+        {
+            traceCREATE_POOL_FAILED();
+            xReturn = NULL;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvPoolAlloc( PoolHandle_t xPool,
+                        TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Pool_t * const pxPool = xPool;
+        void * pvReturn;
+
+        configASSERT( pxPool );
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904  This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            /* Taking a block from the free block list does not require a
+             * critical section if configPOOL_USE_ATOMICS is 1, so when the pool
+             * has a free block this is the only work done. */
+            poolENTER_CRITICAL();
+            {
+                pvReturn = prvPopFreeBlock( pxPool );
+            }
+            poolEXIT_CRITICAL();
+
+            if( pvReturn != NULL )
+            {
+                traceALLOC_FROM_POOL( pxPool, pvReturn );
+                return pvReturn;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                /* The pool was empty and no block time is specified (or the
+                 * block time has expired) so leave now. */
+                traceALLOC_FROM_POOL_FAILED( pxPool );
+                return NULL;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                /* The pool was empty and a block time was specified so
+                 * configure the timeout structure. */
+                vTaskSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+            }
+            else
+            {
+                /* Entry time was already set. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            vTaskSuspendAll();
+            prvLockPool( pxPool );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                /* The timeout has not expired.  If the pool is still empty
+                 * place the task on the list of tasks waiting to allocate from
+                 * the pool.  A block freed by an interrupt from now on will
+                 * increment the lock count, so will unblock this task when the
+                 * pool is unlocked below. */
+                if( prvIsPoolEmpty( pxPool ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_POOL_ALLOC( pxPool );
+                    vTaskPlaceOnEventList( &( pxPool->xTasksWaitingToAllocate ), xTicksToWait );
+                    prvUnlockPool( pxPool );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* A block was freed.  Loop back to try and allocate it. */
+                    prvUnlockPool( pxPool );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out.  Loop back for one last attempt to allocate a
+                 * block, which will return NULL if the pool is still empty. */
+                prvUnlockPool( pxPool );
+                ( void ) xTaskResumeAll();
+                xTicksToWait = ( TickType_t ) 0;
+            }
+        } /*lint -restore */
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvPoolAllocFromISR( PoolHandle_t xPool )
+    {
+        Pool_t * const pxPool = xPool;
+        UBaseType_t uxSavedInterruptStatus;
+        void * pvReturn;
+
+        configASSERT( pxPool );
+
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum system call (or maximum API call) interrupt priority.
+         * Interrupts that are above the maximum system call priority are kept
+         * permanently enabled, even when the RTOS kernel is in a critical
+         * section, but cannot make any calls to FreeRTOS API functions.  If
+         * configASSERT() is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an
+         * assertion failure if a FreeRTOS API function is called from an
+         * interrupt that has been assigned a priority above the configured
+         * maximum system call priority. */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* Allocating a block never touches the event list, so the lock does
+         * not need to be checked. */
+        uxSavedInterruptStatus = poolSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            pvReturn = prvPopFreeBlock( pxPool );
+        }
+        poolCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        if( pvReturn != NULL )
+        {
+            traceALLOC_FROM_POOL_FROM_ISR( pxPool, pvReturn );
+        }
+        else
+        {
+            traceALLOC_FROM_POOL_FROM_ISR_FAILED( pxPool );
+        }
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPoolFree( PoolHandle_t xPool,
+                    void * pvBlock )
+    {
+        Pool_t * const pxPool = xPool;
+
+        configASSERT( pxPool );
+        configASSERT( pvBlock );
+
+        poolENTER_CRITICAL();
+        {
+            prvPushFreeBlock( pxPool, pvBlock );
+        }
+        poolEXIT_CRITICAL();
+
+        traceFREE_TO_POOL( pxPool, pvBlock );
+
+        /* Only tasks add themselves to the event list, and they do so with the
+         * scheduler suspended, so the list can be checked without a critical
+         * section - the critical section is only needed if there is a task to
+         * unblock. */
+        if( listLIST_IS_EMPTY( &( pxPool->xTasksWaitingToAllocate ) ) == pdFALSE )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* The waiting task may have timed out since the list was
+                 * checked. */
+                if( listLIST_IS_EMPTY( &( pxPool->xTasksWaitingToAllocate ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxPool->xTasksWaitingToAllocate ) ) != pdFALSE )
+                    {
+                        /* The unblocked task has a priority higher than our
+                         * own so yield immediately. */
+                        poolYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vPoolFreeFromISR( PoolHandle_t xPool,
+                           void * pvBlock,
+                           BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        Pool_t * const pxPool = xPool;
+        UBaseType_t uxSavedInterruptStatus;
+        int8_t cFreeLock;
+
+        configASSERT( pxPool );
+        configASSERT( pvBlock );
+
+        /* See the comment in pvPoolAllocFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = poolSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            prvPushFreeBlock( pxPool, pvBlock );
+        }
+        poolCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        traceFREE_TO_POOL_FROM_ISR( pxPool, pvBlock );
+
+        /* The lock and the event list are only changed by tasks, which cannot
+         * run while this interrupt is executing, so if the pool is unlocked and
+         * no tasks are waiting there is nothing more to do. */
+        if( ( pxPool->cFreeLock != poolUNLOCKED ) || ( listLIST_IS_EMPTY( &( pxPool->xTasksWaitingToAllocate ) ) == pdFALSE ) )
+        {
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+            {
+                cFreeLock = pxPool->cFreeLock;
+
+                if( cFreeLock == poolUNLOCKED )
+                {
+                    if( listLIST_IS_EMPTY( &( pxPool->xTasksWaitingToAllocate ) ) == pdFALSE )
+                    {
+                        if( xTaskRemoveFromEventList( &( pxPool->xTasksWaitingToAllocate ) ) != pdFALSE )
+                        {
+                            /* The task unblocked has a priority higher than
+                             * the interrupted task, so record that a context
+                             * switch is required. */
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* Increment the lock count so the task that unlocks the
+                     * pool knows a block was freed while it was locked. */
+                    prvIncrementPoolFreeLock( pxPool, cFreeLock );
+                }
+            }
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxPoolGetBlocksAvailable( PoolHandle_t xPool )
+    {
+        const Pool_t * const pxPool = xPool;
+
+        configASSERT( pxPool );
+
+        return ( UBaseType_t ) pxPool->ulBlocksAvailable;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPoolDelete( PoolHandle_t xPool )
+    {
+        Pool_t * const pxPool = xPool;
+
+        configASSERT( pxPool );
+
+        /* There must be no tasks waiting for a block, and every block must
+         * have been freed. */
+        configASSERT( listLIST_IS_EMPTY( &( pxPool->xTasksWaitingToAllocate ) ) != pdFALSE );
+        configASSERT( pxPool->ulBlocksAvailable == ( uint32_t ) pxPool->uxNumberOfBlocks );
+
+        traceDELETE_POOL( pxPool );
+
+        /* The pool was created from statically allocated memory, so there is
+         * nothing to free. */
+    }
+/*-----------------------------------------------------------*/
+
+    static void * prvPopFreeBlock( Pool_t * const pxPool )
+    {
+        uint32_t ulHead, ulIndex, ulNewHead;
+        void * pvReturn = NULL;
+
+        do
+        {
+            ulHead = pxPool->ulFreeListHead;
+            ulIndex = ulHead & poolINDEX_MASK;
+
+            if( ulIndex == poolNO_BLOCK )
+            {
+                break;
+            }
+
+            /* If another task or interrupt takes this block before the compare
+             * and swap below then the link read here may already have been
+             * overwritten, but the compare and swap will then fail because the
+             * change count in the head will have changed. */
+            pvReturn = pxPool->pucStorage + ( ( size_t ) ulIndex * pxPool->xBlockSize );
+            ulNewHead = ( ( ulHead & poolCOUNT_MASK ) + poolCOUNT_INCREMENT ) | ( *( ( volatile uint32_t * ) pvReturn ) & poolINDEX_MASK );
+        } while( poolCOMPARE_AND_SWAP( &( pxPool->ulFreeListHead ), ulNewHead, ulHead ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS );
+
+        if( ulIndex != poolNO_BLOCK )
+        {
+            poolDECREMENT( &( pxPool->ulBlocksAvailable ) );
+        }
+        else
+        {
+            pvReturn = NULL;
+        }
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPushFreeBlock( Pool_t * const pxPool,
+                                  void * pvBlock )
+    {
+        uint32_t ulHead, ulIndex, ulNewHead;
+        size_t xOffset;
+
+        /* The block must be one of the blocks in this pool. */
+        configASSERT( ( uint8_t * ) pvBlock >= pxPool->pucStorage );
+        xOffset = ( size_t ) ( ( uint8_t * ) pvBlock - pxPool->pucStorage );
+        configASSERT( ( xOffset % pxPool->xBlockSize ) == ( size_t ) 0 );
+        ulIndex = ( uint32_t ) ( xOffset / pxPool->xBlockSize );
+        configASSERT( ulIndex < ( uint32_t ) pxPool->uxNumberOfBlocks );
+
+        do
+        {
+            ulHead = pxPool->ulFreeListHead;
+            *( ( volatile uint32_t * ) pvBlock ) = ulHead & poolINDEX_MASK;
+            ulNewHead = ( ( ulHead & poolCOUNT_MASK ) + poolCOUNT_INCREMENT ) | ulIndex;
+        } while( poolCOMPARE_AND_SWAP( &( pxPool->ulFreeListHead ), ulNewHead, ulHead ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS );
+
+        poolINCREMENT( &( pxPool->ulBlocksAvailable ) );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvUnlockPool( Pool_t * const pxPool )
+    {
+        /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
+
+        /* The lock count contains the number of blocks freed from interrupts
+         * while the pool was locked.  When a pool is locked blocks can be
+         * freed, but the event list cannot be updated. */
+        taskENTER_CRITICAL();
+        {
+            int8_t cFreeLock = pxPool->cFreeLock;
+
+            while( cFreeLock > poolLOCKED_UNMODIFIED )
+            {
+                /* Tasks that are removed from the event list will get added to
+                 * the pending ready list as the scheduler is still suspended. */
+                if( listLIST_IS_EMPTY( &( pxPool->xTasksWaitingToAllocate ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxPool->xTasksWaitingToAllocate ) ) != pdFALSE )
+                    {
+                        /* The task waiting has a higher priority so record that
+                         * a context switch is required. */
+                        vTaskMissedYield();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    break;
+                }
+
+                --cFreeLock;
+            }
+
+            pxPool->cFreeLock = poolUNLOCKED;
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvIsPoolEmpty( const Pool_t * pxPool )
+    {
+        BaseType_t xReturn;
+
+        if( ( pxPool->ulFreeListHead & poolINDEX_MASK ) == poolNO_BLOCK )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TRACE_FACILITY == 1 )
+
+        UBaseType_t uxPoolGetPoolNumber( PoolHandle_t xPool )
+        {
+            return xPool->uxPoolNumber;
+        }
+
+    #endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TRACE_FACILITY == 1 )
+
+        void vPoolSetPoolNumber( PoolHandle_t xPool,
+                                 UBaseType_t uxPoolNumber )
+        {
+            xPool->uxPoolNumber = uxPoolNumber;
+        }
+
+    #endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include static allocation.  If you want to include memory pools then ensure
+ * configSUPPORT_STATIC_ALLOCATION is set to 1 in FreeRTOSConfig.h. */
+#endif /* configSUPPORT_STATIC_ALLOCATION == 1 */
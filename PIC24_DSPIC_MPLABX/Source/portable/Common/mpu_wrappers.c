@@ -43,6 +43,10 @@
 #include "timers.h"
 #include "event_groups.h"
 #include "stream_buffer.h"
+#include "pool.h"
+#include "wait_objects.h"
+#include "work_queue.h"
+#include "kernel_data.h"
 #include "mpu_prototypes.h"
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
@@ -269,8 +273,23 @@
         eTaskState MPU_eTaskGetState( TaskHandle_t pxTask ) /* FREERTOS_SYSTEM_CALL */
         {
             eTaskState eReturn;
+            BaseType_t xReadFromPage = pdFALSE;
 
-            if( portIS_PRIVILEGED() == pdFALSE )
+            #if ( ( configUSE_KERNEL_DATA_PAGE == 1 ) && ( portKERNEL_DATA_PAGE_IS_USER_READABLE == 1 ) )
+            {
+                if( pxTask != NULL )
+                {
+                    xReadFromPage = xKernelDataGetTaskState( pxTask, &eReturn );
+                }
+            }
+            #endif
+
+            if( xReadFromPage != pdFALSE )
+            {
+                /* The state was read from the kernel data page, which does
+                 * not require the privilege level to be raised. */
+            }
+            else if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
@@ -433,21 +452,31 @@
     {
         TickType_t xReturn;
 
-        if( portIS_PRIVILEGED() == pdFALSE )
+        #if ( ( configUSE_KERNEL_DATA_PAGE == 1 ) && ( portKERNEL_DATA_PAGE_IS_USER_READABLE == 1 ) )
         {
-            portRAISE_PRIVILEGE();
-            portMEMORY_BARRIER();
-
-            xReturn = xTaskGetTickCount();
-            portMEMORY_BARRIER();
-
-            portRESET_PRIVILEGE();
-            portMEMORY_BARRIER();
+            /* The kernel data page is readable without raising the privilege
+             * level. */
+            xReturn = xKernelDataGetTickCount();
         }
-        else
+        #else
         {
-            xReturn = xTaskGetTickCount();
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xTaskGetTickCount();
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xTaskGetTickCount();
+            }
         }
+        #endif /* if ( ( configUSE_KERNEL_DATA_PAGE == 1 ) && ( portKERNEL_DATA_PAGE_IS_USER_READABLE == 1 ) ) */
 
         return xReturn;
     }
@@ -597,6 +626,78 @@
     #endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_RUN_TIME_HISTOGRAMS == 1 )
+        void MPU_vTaskGetRunTimeHistogram( TaskHandle_t xTask,
+                                           TaskHistogram_t * pxHistogram ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                vTaskGetRunTimeHistogram( xTask, pxHistogram );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vTaskGetRunTimeHistogram( xTask, pxHistogram );
+            }
+        }
+    #endif /* if ( configUSE_RUN_TIME_HISTOGRAMS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_RUN_TIME_HISTOGRAMS == 1 )
+        void MPU_vTaskGetCoreRunTime( CoreRunTime_t * pxCoreRunTime ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                vTaskGetCoreRunTime( pxCoreRunTime );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vTaskGetCoreRunTime( pxCoreRunTime );
+            }
+        }
+    #endif /* if ( configUSE_RUN_TIME_HISTOGRAMS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_STACK_SAMPLER == 1 )
+        BaseType_t MPU_xTaskGetStackSample( TaskHandle_t xTask,
+                                            TaskStackSample_t * pxSample ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xTaskGetStackSample( xTask, pxSample );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xTaskGetStackSample( xTask, pxSample );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_STACK_SAMPLER == 1 ) */
+/*-----------------------------------------------------------*/
+
     #if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
         configRUN_TIME_COUNTER_TYPE MPU_ulTaskGetIdleRunTimeCounter( void ) /* FREERTOS_SYSTEM_CALL */
         {
@@ -1206,8 +1307,20 @@
     UBaseType_t MPU_uxQueueMessagesWaiting( const QueueHandle_t pxQueue ) /* FREERTOS_SYSTEM_CALL */
     {
         UBaseType_t uxReturn;
+        BaseType_t xReadFromPage = pdFALSE;
 
-        if( portIS_PRIVILEGED() == pdFALSE )
+        #if ( ( configUSE_KERNEL_DATA_PAGE == 1 ) && ( portKERNEL_DATA_PAGE_IS_USER_READABLE == 1 ) )
+        {
+            xReadFromPage = xKernelDataGetQueueMessagesWaiting( pxQueue, &uxReturn );
+        }
+        #endif
+
+        if( xReadFromPage != pdFALSE )
+        {
+            /* The count was read from the kernel data page, which does not
+             * require the privilege level to be raised. */
+        }
+        else if( portIS_PRIVILEGED() == pdFALSE )
         {
             portRAISE_PRIVILEGE();
             portMEMORY_BARRIER();
@@ -1277,6 +1390,60 @@
     }
 /*-----------------------------------------------------------*/
 
+    BaseType_t MPU_xQueueSendMultiple( QueueHandle_t xQueue,
+                                       const void * const pvItemsToQueue,
+                                       const UBaseType_t uxItemCount,
+                                       TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+    {
+        BaseType_t xReturn;
+
+        if( portIS_PRIVILEGED() == pdFALSE )
+        {
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            xReturn = xQueueSendMultiple( xQueue, pvItemsToQueue, uxItemCount, xTicksToWait );
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
+        {
+            xReturn = xQueueSendMultiple( xQueue, pvItemsToQueue, uxItemCount, xTicksToWait );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t MPU_xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                          void * const pvBuffer,
+                                          const UBaseType_t uxMaxItems,
+                                          TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+    {
+        BaseType_t xReturn;
+
+        if( portIS_PRIVILEGED() == pdFALSE )
+        {
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            xReturn = xQueueReceiveMultiple( xQueue, pvBuffer, uxMaxItems, xTicksToWait );
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
+        {
+            xReturn = xQueueReceiveMultiple( xQueue, pvBuffer, uxMaxItems, xTicksToWait );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
     BaseType_t MPU_xQueuePeek( QueueHandle_t xQueue,
                                void * const pvBuffer,
                                TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
@@ -1407,6 +1574,59 @@
     #endif /* if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+    #if ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        QueueHandle_t MPU_xQueueCreateMutexWithCeiling( UBaseType_t uxCeilingPriority ) /* FREERTOS_SYSTEM_CALL */
+        {
+            QueueHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xQueueCreateMutexWithCeiling( uxCeilingPriority );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueCreateMutexWithCeiling( uxCeilingPriority );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        QueueHandle_t MPU_xQueueCreateMutexWithCeilingStatic( UBaseType_t uxCeilingPriority,
+                                                              StaticQueue_t * pxStaticQueue ) /* FREERTOS_SYSTEM_CALL */
+        {
+            QueueHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xQueueCreateMutexWithCeilingStatic( uxCeilingPriority, pxStaticQueue );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueCreateMutexWithCeilingStatic( uxCeilingPriority, pxStaticQueue );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
     #if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         QueueHandle_t MPU_xQueueCreateCountingSemaphore( UBaseType_t uxCountValue,
                                                          UBaseType_t uxInitialCount ) /* FREERTOS_SYSTEM_CALL */
@@ -2391,62 +2611,221 @@
     }
 /*-----------------------------------------------------------*/
 
-    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
-        StreamBufferHandle_t MPU_xStreamBufferGenericCreate( size_t xBufferSizeBytes,
-                                                             size_t xTriggerLevelBytes,
-                                                             BaseType_t xIsMessageBuffer,
-                                                             StreamBufferCallbackFunction_t pxSendCompletedCallback,
-                                                             StreamBufferCallbackFunction_t pxReceiveCompletedCallback ) /* FREERTOS_SYSTEM_CALL */
+    size_t MPU_xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+                                     void ** ppvData,
+                                     size_t xDataLengthBytes,
+                                     TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+    {
+        size_t xReturn;
+
+        if( portIS_PRIVILEGED() == pdFALSE )
         {
-            StreamBufferHandle_t xReturn;
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
 
-            /**
-             * Streambuffer application level callback functionality is disabled for MPU
-             * enabled ports.
-             */
-            configASSERT( ( pxSendCompletedCallback == NULL ) &&
-                          ( pxReceiveCompletedCallback == NULL ) );
+            xReturn = xStreamBufferReserve( xStreamBuffer, ppvData, xDataLengthBytes, xTicksToWait );
+            portMEMORY_BARRIER();
 
-            if( ( pxSendCompletedCallback == NULL ) &&
-                ( pxReceiveCompletedCallback == NULL ) )
-            {
-                if( portIS_PRIVILEGED() == pdFALSE )
-                {
-                    portRAISE_PRIVILEGE();
-                    portMEMORY_BARRIER();
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
+        {
+            xReturn = xStreamBufferReserve( xStreamBuffer, ppvData, xDataLengthBytes, xTicksToWait );
+        }
 
-                    xReturn = xStreamBufferGenericCreate( xBufferSizeBytes,
-                                                          xTriggerLevelBytes,
-                                                          xIsMessageBuffer,
-                                                          NULL,
-                                                          NULL );
-                    portMEMORY_BARRIER();
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
 
-                    portRESET_PRIVILEGE();
-                    portMEMORY_BARRIER();
-                }
-                else
-                {
-                    xReturn = xStreamBufferGenericCreate( xBufferSizeBytes,
-                                                          xTriggerLevelBytes,
-                                                          xIsMessageBuffer,
-                                                          NULL,
-                                                          NULL );
-                }
-            }
-            else
-            {
-                traceSTREAM_BUFFER_CREATE_FAILED( xIsMessageBuffer );
-                xReturn = NULL;
-            }
+    size_t MPU_xStreamBufferReserveMessage( StreamBufferHandle_t xStreamBuffer,
+                                            void ** ppvData,
+                                            void ** ppvWrappedData,
+                                            size_t xDataLengthBytes,
+                                            TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+    {
+        size_t xReturn;
 
-            return xReturn;
+        if( portIS_PRIVILEGED() == pdFALSE )
+        {
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            xReturn = xStreamBufferReserveMessage( xStreamBuffer, ppvData, ppvWrappedData, xDataLengthBytes, xTicksToWait );
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
         }
-    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+        else
+        {
+            xReturn = xStreamBufferReserveMessage( xStreamBuffer, ppvData, ppvWrappedData, xDataLengthBytes, xTicksToWait );
+        }
+
+        return xReturn;
+    }
 /*-----------------------------------------------------------*/
 
-    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
-        StreamBufferHandle_t MPU_xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes,
+    size_t MPU_xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer,
+                                    size_t xDataLengthBytes ) /* FREERTOS_SYSTEM_CALL */
+    {
+        size_t xReturn;
+
+        if( portIS_PRIVILEGED() == pdFALSE )
+        {
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            xReturn = xStreamBufferCommit( xStreamBuffer, xDataLengthBytes );
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
+        {
+            xReturn = xStreamBufferCommit( xStreamBuffer, xDataLengthBytes );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t MPU_xStreamBufferPeekContiguous( StreamBufferHandle_t xStreamBuffer,
+                                            void ** ppvData,
+                                            TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+    {
+        size_t xReturn;
+
+        if( portIS_PRIVILEGED() == pdFALSE )
+        {
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            xReturn = xStreamBufferPeekContiguous( xStreamBuffer, ppvData, xTicksToWait );
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
+        {
+            xReturn = xStreamBufferPeekContiguous( xStreamBuffer, ppvData, xTicksToWait );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t MPU_xStreamBufferPeekMessage( StreamBufferHandle_t xStreamBuffer,
+                                         void ** ppvData,
+                                         void ** ppvWrappedData,
+                                         size_t * pxMessageLengthBytes,
+                                         TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+    {
+        size_t xReturn;
+
+        if( portIS_PRIVILEGED() == pdFALSE )
+        {
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            xReturn = xStreamBufferPeekMessage( xStreamBuffer, ppvData, ppvWrappedData, pxMessageLengthBytes, xTicksToWait );
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
+        {
+            xReturn = xStreamBufferPeekMessage( xStreamBuffer, ppvData, ppvWrappedData, pxMessageLengthBytes, xTicksToWait );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t MPU_xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer,
+                                     size_t xDataLengthBytes ) /* FREERTOS_SYSTEM_CALL */
+    {
+        size_t xReturn;
+
+        if( portIS_PRIVILEGED() == pdFALSE )
+        {
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            xReturn = xStreamBufferConsume( xStreamBuffer, xDataLengthBytes );
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
+        {
+            xReturn = xStreamBufferConsume( xStreamBuffer, xDataLengthBytes );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        StreamBufferHandle_t MPU_xStreamBufferGenericCreate( size_t xBufferSizeBytes,
+                                                             size_t xTriggerLevelBytes,
+                                                             BaseType_t xIsMessageBuffer,
+                                                             StreamBufferCallbackFunction_t pxSendCompletedCallback,
+                                                             StreamBufferCallbackFunction_t pxReceiveCompletedCallback ) /* FREERTOS_SYSTEM_CALL */
+        {
+            StreamBufferHandle_t xReturn;
+
+            /**
+             * Streambuffer application level callback functionality is disabled for MPU
+             * enabled ports.
+             */
+            configASSERT( ( pxSendCompletedCallback == NULL ) &&
+                          ( pxReceiveCompletedCallback == NULL ) );
+
+            if( ( pxSendCompletedCallback == NULL ) &&
+                ( pxReceiveCompletedCallback == NULL ) )
+            {
+                if( portIS_PRIVILEGED() == pdFALSE )
+                {
+                    portRAISE_PRIVILEGE();
+                    portMEMORY_BARRIER();
+
+                    xReturn = xStreamBufferGenericCreate( xBufferSizeBytes,
+                                                          xTriggerLevelBytes,
+                                                          xIsMessageBuffer,
+                                                          NULL,
+                                                          NULL );
+                    portMEMORY_BARRIER();
+
+                    portRESET_PRIVILEGE();
+                    portMEMORY_BARRIER();
+                }
+                else
+                {
+                    xReturn = xStreamBufferGenericCreate( xBufferSizeBytes,
+                                                          xTriggerLevelBytes,
+                                                          xIsMessageBuffer,
+                                                          NULL,
+                                                          NULL );
+                }
+            }
+            else
+            {
+                traceSTREAM_BUFFER_CREATE_FAILED( xIsMessageBuffer );
+                xReturn = NULL;
+            }
+
+            return xReturn;
+        }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        StreamBufferHandle_t MPU_xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes,
                                                                    size_t xTriggerLevelBytes,
                                                                    BaseType_t xIsMessageBuffer,
                                                                    uint8_t * const pucStreamBufferStorageArea,
@@ -2505,6 +2884,343 @@
     #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        PoolHandle_t MPU_xPoolCreateStatic( size_t xBlockSize,
+                                            UBaseType_t uxNumberOfBlocks,
+                                            uint8_t * pucPoolStorage,
+                                            StaticPool_t * pxStaticPool ) /* FREERTOS_SYSTEM_CALL */
+        {
+            PoolHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xPoolCreateStatic( xBlockSize, uxNumberOfBlocks, pucPoolStorage, pxStaticPool );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xPoolCreateStatic( xBlockSize, uxNumberOfBlocks, pucPoolStorage, pxStaticPool );
+            }
+
+            return xReturn;
+        }
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    void * MPU_pvPoolAlloc( PoolHandle_t xPool,
+                            TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+    {
+        void * pvReturn;
+
+        if( portIS_PRIVILEGED() == pdFALSE )
+        {
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            pvReturn = pvPoolAlloc( xPool, xTicksToWait );
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
+        {
+            pvReturn = pvPoolAlloc( xPool, xTicksToWait );
+        }
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void MPU_vPoolFree( PoolHandle_t xPool,
+                        void * pvBlock ) /* FREERTOS_SYSTEM_CALL */
+    {
+        if( portIS_PRIVILEGED() == pdFALSE )
+        {
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            vPoolFree( xPool, pvBlock );
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
+        {
+            vPoolFree( xPool, pvBlock );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t MPU_uxPoolGetBlocksAvailable( PoolHandle_t xPool ) /* FREERTOS_SYSTEM_CALL */
+    {
+        UBaseType_t uxReturn;
+
+        if( portIS_PRIVILEGED() == pdFALSE )
+        {
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            uxReturn = uxPoolGetBlocksAvailable( xPool );
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
+        {
+            uxReturn = uxPoolGetBlocksAvailable( xPool );
+        }
+
+        return uxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void MPU_vPoolDelete( PoolHandle_t xPool ) /* FREERTOS_SYSTEM_CALL */
+    {
+        if( portIS_PRIVILEGED() == pdFALSE )
+        {
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            vPoolDelete( xPool );
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
+        {
+            vPoolDelete( xPool );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_WAIT_OBJECTS == 1 )
+        BaseType_t MPU_xWaitForMultipleObjects( const WaitObject_t * const pxObjects,
+                                                UBaseType_t uxObjectCount,
+                                                TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xWaitForMultipleObjects( pxObjects, uxObjectCount, xTicksToWait );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xWaitForMultipleObjects( pxObjects, uxObjectCount, xTicksToWait );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_WAIT_OBJECTS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_WORK_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        WorkQueueHandle_t MPU_xWorkQueueCreate( const char * const pcName,
+                                                UBaseType_t uxPriority,
+                                                configSTACK_DEPTH_TYPE usStackDepth ) /* FREERTOS_SYSTEM_CALL */
+        {
+            WorkQueueHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xWorkQueueCreate( pcName, uxPriority, usStackDepth );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xWorkQueueCreate( pcName, uxPriority, usStackDepth );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_WORK_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_WORK_QUEUES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        WorkQueueHandle_t MPU_xWorkQueueCreateStatic( const char * const pcName,
+                                                      UBaseType_t uxPriority,
+                                                      uint32_t ulStackDepth,
+                                                      StackType_t * const puxStackBuffer,
+                                                      StaticTask_t * const pxTaskBuffer,
+                                                      StaticWorkQueue_t * const pxWorkQueueBuffer ) /* FREERTOS_SYSTEM_CALL */
+        {
+            WorkQueueHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xWorkQueueCreateStatic( pcName, uxPriority, ulStackDepth, puxStackBuffer, pxTaskBuffer, pxWorkQueueBuffer );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xWorkQueueCreateStatic( pcName, uxPriority, ulStackDepth, puxStackBuffer, pxTaskBuffer, pxWorkQueueBuffer );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_WORK_QUEUES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_WORK_QUEUES == 1 )
+        WorkItemHandle_t MPU_xWorkItemCreateStatic( WorkFunction_t pxFunction,
+                                                    void * pvParameter1,
+                                                    uint32_t ulParameter2,
+                                                    StaticWorkItem_t * const pxWorkItemBuffer ) /* FREERTOS_SYSTEM_CALL */
+        {
+            WorkItemHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xWorkItemCreateStatic( pxFunction, pvParameter1, ulParameter2, pxWorkItemBuffer );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xWorkItemCreateStatic( pxFunction, pvParameter1, ulParameter2, pxWorkItemBuffer );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_WORK_QUEUES == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_WORK_QUEUES == 1 )
+        BaseType_t MPU_xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue,
+                                         WorkItemHandle_t xWorkItem ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xWorkQueueSubmit( xWorkQueue, xWorkItem );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xWorkQueueSubmit( xWorkQueue, xWorkItem );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_WORK_QUEUES == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_WORK_QUEUES == 1 )
+        BaseType_t MPU_xWorkItemIsPending( WorkItemHandle_t xWorkItem ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xWorkItemIsPending( xWorkItem );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xWorkItemIsPending( xWorkItem );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_WORK_QUEUES == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_WORK_QUEUES == 1 )
+        void MPU_vWorkQueueGetStats( WorkQueueHandle_t xWorkQueue,
+                                     WorkQueueStats_t * pxStats ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                vWorkQueueGetStats( xWorkQueue, pxStats );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vWorkQueueGetStats( xWorkQueue, pxStats );
+            }
+        }
+    #endif /* if ( configUSE_WORK_QUEUES == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_WORK_QUEUES == 1 )
+        TaskHandle_t MPU_xWorkQueueGetTaskHandle( WorkQueueHandle_t xWorkQueue ) /* FREERTOS_SYSTEM_CALL */
+        {
+            TaskHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xWorkQueueGetTaskHandle( xWorkQueue );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xWorkQueueGetTaskHandle( xWorkQueue );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_WORK_QUEUES == 1 ) */
+/*-----------------------------------------------------------*/
+
 
 /* Functions that the application writer wants to execute in privileged mode
  * can be defined in application_defined_privileged_functions.h.  The functions
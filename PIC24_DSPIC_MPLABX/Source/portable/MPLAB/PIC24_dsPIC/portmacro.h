@@ -144,6 +144,7 @@ extern void vPortYield( void );
 #endif
 
 #define portNOP()				asm volatile ( "NOP" )
+#define portMEMORY_BARRIER()	asm volatile ( "" ::: "memory" )
 
 #ifdef __cplusplus
 }
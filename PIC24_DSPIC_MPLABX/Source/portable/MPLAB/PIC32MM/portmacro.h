@@ -220,6 +220,7 @@ extern volatile UBaseType_t uxInterruptNesting;
 #define portASSERT_IF_IN_ISR() configASSERT( uxInterruptNesting == 0 )
 
 #define portNOP()	__asm volatile ( "nop" )
+#define portMEMORY_BARRIER()	__asm volatile ( "" ::: "memory" )
 
 /*-----------------------------------------------------------*/
 
@@ -80,6 +80,7 @@ void portENABLE_INTERRUPTS(void);
 #endif
 
 #define portNOP()         asm volatile ( "NOP" )
+#define portMEMORY_BARRIER()    asm volatile ( "" ::: "memory" )
 
 
 void __attribute__ ((naked)) portYIELD(void);
@@ -0,0 +1,809 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that, like
+ * heap_5.c, allows the heap to be defined across multiple non-contiguous
+ * regions, but that uses a two level segregated fit (TLSF) scheme in place of
+ * heap_5.c's single address ordered free list.  pvPortMalloc() and vPortFree()
+ * therefore execute in constant time, no matter how many blocks are free or how
+ * fragmented the heap has become, which makes the worst case time spent with
+ * the scheduler suspended bounded.  Adjacent free blocks are combined
+ * (coalesced) immediately when a block is freed.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of https://www.FreeRTOS.org
+ * for more information.
+ *
+ * Free blocks are kept on one of a fixed number of lists, selected by the
+ * block size.  The first level splits sizes by powers of two, and the second
+ * level splits each power of two range into ( 1 << configHEAP_TLSF_SL_BITS )
+ * equal sub-ranges.  A bitmap for each level records which lists are not
+ * empty, so a list holding a large enough block is found with a couple of
+ * find-first-set operations rather than by walking a list.  Allocations are
+ * rounded up to the start of the next sub-range before the search, so any
+ * block found is big enough (a "good fit" rather than heap_5.c's "first fit").
+ * The cost of this is that up to 1 / ( 1 << configHEAP_TLSF_SL_BITS ) of a
+ * request can be lost to internal fragmentation, and that each block carries
+ * a pointer to the block physically before it so it can be coalesced in
+ * constant time.
+ *
+ * Usage notes:
+ *
+ * vPortDefineHeapRegions() ***must*** be called before pvPortMalloc(), exactly
+ * as with heap_5.c - see the comments at the top of heap_5.c.  Unlike heap_5.c
+ * the regions do not need to appear in address order.
+ *
+ * configHEAP_TLSF_SL_BITS can be set in FreeRTOSConfig.h to trade the RAM used
+ * by the free list heads against internal fragmentation.  It defaults to 3,
+ * and must be between 2 and 4.
+ *
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+    #define configHEAP_CLEAR_MEMORY_ON_FREE    0
+#endif
+
+#ifndef configHEAP_TLSF_SL_BITS
+    #define configHEAP_TLSF_SL_BITS    3
+#endif
+
+#if ( ( configHEAP_TLSF_SL_BITS < 2 ) || ( configHEAP_TLSF_SL_BITS > 4 ) )
+    #error configHEAP_TLSF_SL_BITS must be between 2 and 4
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE         ( ( size_t ) 8 )
+
+/* Max value that fits in a size_t type. */
+#define heapSIZE_MAX              ( ~( ( size_t ) 0 ) )
+
+/* Check if multiplying a and b will result in overflow. */
+#define heapMULTIPLY_WILL_OVERFLOW( a, b )    ( ( ( a ) > 0 ) && ( ( b ) > ( heapSIZE_MAX / ( a ) ) ) )
+
+/* Check if adding a and b will result in overflow. */
+#define heapADD_WILL_OVERFLOW( a, b )         ( ( a ) > ( heapSIZE_MAX - ( b ) ) )
+
+/* The number of second level lists per first level range, and the number of
+ * first level ranges needed to cover every size a size_t can hold. */
+#define heapSL_COUNT              ( ( UBaseType_t ) 1 << configHEAP_TLSF_SL_BITS )
+#define heapFL_COUNT              ( ( UBaseType_t ) ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - configHEAP_TLSF_SL_BITS + 1 ) )
+
+/* MSB of the xBlockSize member of an BlockLink_t structure is used to track
+ * the allocation status of a block.  When MSB of the xBlockSize member of
+ * an BlockLink_t structure is set then the block belongs to the application.
+ * When the bit is free the block is still part of the free heap space. */
+#define heapBLOCK_ALLOCATED_BITMASK    ( ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 ) )
+#define heapBLOCK_SIZE_IS_VALID( xBlockSize )    ( ( ( xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) == 0 )
+#define heapBLOCK_IS_ALLOCATED( pxBlock )        ( ( ( pxBlock->xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) != 0 )
+#define heapALLOCATE_BLOCK( pxBlock )            ( ( pxBlock->xBlockSize ) |= heapBLOCK_ALLOCATED_BITMASK )
+#define heapFREE_BLOCK( pxBlock )                ( ( pxBlock->xBlockSize ) &= ~heapBLOCK_ALLOCATED_BITMASK )
+
+/* The block that physically follows pxBlock in its heap region. */
+#define heapNEXT_PHYSICAL_BLOCK( pxBlock )       ( ( BlockLink_t * ) ( ( ( uint8_t * ) ( pxBlock ) ) + ( ( pxBlock )->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK ) ) )
+
+/*-----------------------------------------------------------*/
+
+/* Define the structure placed at the start of each block.  Only the first two
+ * members are present while the block is allocated - the free list links
+ * overlay the start of the application's data so only exist while the block
+ * is free. */
+typedef struct A_BLOCK_LINK
+{
+    struct A_BLOCK_LINK * pxPrevPhysicalBlock; /*<< The block immediately before this block in memory, or NULL if this is the first block in its region. */
+    size_t xBlockSize;                         /*<< The size of the block, including this structure. */
+    struct A_BLOCK_LINK * pxNextFreeBlock;     /*<< The next block in the same free list. */
+    struct A_BLOCK_LINK * pxPrevFreeBlock;     /*<< The previous block in the same free list. */
+} BlockLink_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Calculate the free list that holds blocks of xBlockSize bytes.
+ */
+static void prvMapSizeToList( size_t xBlockSize,
+                              UBaseType_t * puxFirstLevel,
+                              UBaseType_t * puxSecondLevel );
+
+/*
+ * Find a free block of at least xWantedSize bytes in constant time, or return
+ * NULL if there is no such block.  The block is not removed from its list.
+ */
+static BlockLink_t * prvFindSuitableBlock( size_t xWantedSize );
+
+/*
+ * Add a block to, or remove a block from, the free list for its size.
+ */
+static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert );
+static void prvRemoveBlockFromFreeList( BlockLink_t * pxBlockToRemove );
+
+/*
+ * Return the bit number of the least or most significant set bit in xValue,
+ * which must not be zero.
+ */
+static UBaseType_t prvFindFirstSet( size_t xValue );
+static UBaseType_t prvFindLastSet( size_t xValue );
+
+/*-----------------------------------------------------------*/
+
+/* The size of the structure placed at the beginning of each allocated memory
+ * block must by correctly byte aligned. */
+static const size_t xHeapStructSize = ( offsetof( BlockLink_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* Block sizes must not get too small - a free block must be able to hold the
+ * free list links. */
+static const size_t xMinimumBlockSize = ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The heads of the free lists, and the bitmaps that record which lists are
+ * not empty.  Bit n of uxFirstLevelBitmap is set if any bit of
+ * uxSecondLevelBitmap[ n ] is set. */
+static BlockLink_t * pxFreeLists[ heapFL_COUNT ][ heapSL_COUNT ];
+static size_t uxFirstLevelBitmap = 0;
+static size_t uxSecondLevelBitmap[ heapFL_COUNT ];
+
+/* Set once vPortDefineHeapRegions() has been called. */
+static BaseType_t xHeapDefined = pdFALSE;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+ * number of free bytes remaining, but says nothing about fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfFreeBlocks = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxNewBlockLink;
+    void * pvReturn = NULL;
+    size_t xAdditionalRequiredSize;
+
+    /* The heap must be initialised before the first call to
+     * prvPortMalloc(). */
+    configASSERT( xHeapDefined );
+
+    vTaskSuspendAll();
+    {
+        if( xWantedSize > 0 )
+        {
+            /* The wanted size must be increased so it can contain the block
+             * header in addition to the requested amount of bytes. Some
+             * additional increment may also be needed for alignment. */
+            xAdditionalRequiredSize = xHeapStructSize + portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+
+            if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+            {
+                xWantedSize += xAdditionalRequiredSize;
+
+                /* The block must be large enough to go back on a free list
+                 * when it is freed. */
+                if( xWantedSize < xMinimumBlockSize )
+                {
+                    xWantedSize = xMinimumBlockSize;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                xWantedSize = 0;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Check the block size we are trying to allocate is not so large that the
+         * top bit is set.  The top bit of the block size member of the BlockLink_t
+         * structure is used to determine who owns the block - the application or
+         * the kernel, so it must be free. */
+        if( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 )
+        {
+            if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+            {
+                pxBlock = prvFindSuitableBlock( xWantedSize );
+
+                if( pxBlock != NULL )
+                {
+                    /* This block is being returned for use so must be taken out
+                     * of the list of free blocks. */
+                    prvRemoveBlockFromFreeList( pxBlock );
+
+                    /* If the block is larger than required it can be split into
+                     * two. */
+                    if( ( pxBlock->xBlockSize - xWantedSize ) >= xMinimumBlockSize )
+                    {
+                        /* This block is to be split into two.  Create a new
+                         * block following the number of bytes requested. The void
+                         * cast is used to prevent byte alignment warnings from the
+                         * compiler. */
+                        pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+
+                        /* Calculate the sizes of two blocks split from the
+                         * single block. */
+                        pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                        pxNewBlockLink->pxPrevPhysicalBlock = pxBlock;
+                        heapNEXT_PHYSICAL_BLOCK( pxNewBlockLink )->pxPrevPhysicalBlock = pxNewBlockLink;
+                        pxBlock->xBlockSize = xWantedSize;
+
+                        /* Insert the new block into the list of free blocks.
+                         * It cannot be merged with the block after it, as that
+                         * block would already have been merged with pxBlock. */
+                        prvInsertBlockIntoFreeList( pxNewBlockLink );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                    if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                    {
+                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* The block is being returned - it is allocated and owned
+                     * by the application. */
+                    heapALLOCATE_BLOCK( pxBlock );
+                    xNumberOfSuccessfulAllocations++;
+
+                    /* Return the memory space pointed to - jumping over the
+                     * block header at its start. */
+                    pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxLink;
+    BlockLink_t * pxNeighbour;
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have a block header immediately before
+         * it. */
+        puc -= xHeapStructSize;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxLink = ( void * ) puc;
+
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+
+        if( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 )
+        {
+            /* The block is being returned to the heap - it is no longer
+             * allocated. */
+            heapFREE_BLOCK( pxLink );
+            #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                ( void ) memset( puc + xHeapStructSize, 0, pxLink->xBlockSize - xHeapStructSize );
+            }
+            #endif
+
+            vTaskSuspendAll();
+            {
+                xFreeBytesRemaining += pxLink->xBlockSize;
+                traceFREE( pv, pxLink->xBlockSize );
+
+                /* Merge with the block that follows this block in memory if
+                 * that block is also free.  The end of each region is marked
+                 * by a permanently allocated block, so there is always a
+                 * following block to check. */
+                pxNeighbour = heapNEXT_PHYSICAL_BLOCK( pxLink );
+
+                if( heapBLOCK_IS_ALLOCATED( pxNeighbour ) == 0 )
+                {
+                    prvRemoveBlockFromFreeList( pxNeighbour );
+                    pxLink->xBlockSize += pxNeighbour->xBlockSize;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Merge with the block that precedes this block in memory if
+                 * that block is also free. */
+                pxNeighbour = pxLink->pxPrevPhysicalBlock;
+
+                if( ( pxNeighbour != NULL ) && ( heapBLOCK_IS_ALLOCATED( pxNeighbour ) == 0 ) )
+                {
+                    prvRemoveBlockFromFreeList( pxNeighbour );
+                    pxNeighbour->xBlockSize += pxLink->xBlockSize;
+                    pxLink = pxNeighbour;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                heapNEXT_PHYSICAL_BLOCK( pxLink )->pxPrevPhysicalBlock = pxLink;
+
+                /* Add this block to the list of free blocks. */
+                prvInsertBlockIntoFreeList( pxLink );
+                xNumberOfSuccessfulFrees++;
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindFirstSet( size_t xValue )
+{
+    UBaseType_t uxBit;
+
+    configASSERT( xValue != 0 );
+
+    #if defined( __GNUC__ )
+    {
+        uxBit = ( UBaseType_t ) __builtin_ctzll( ( unsigned long long ) xValue );
+    }
+    #else
+    {
+        UBaseType_t uxWidth = ( UBaseType_t ) ( sizeof( size_t ) * heapBITS_PER_BYTE ) >> 1;
+
+        /* Binary search, so the number of steps does not depend on xValue. */
+        uxBit = 0;
+
+        while( uxWidth > 0 )
+        {
+            if( ( xValue & ( ( ( size_t ) 1 << uxWidth ) - ( size_t ) 1 ) ) == 0 )
+            {
+                xValue >>= uxWidth;
+                uxBit += uxWidth;
+            }
+
+            uxWidth >>= 1;
+        }
+    }
+    #endif /* if defined( __GNUC__ ) */
+
+    return uxBit;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindLastSet( size_t xValue )
+{
+    UBaseType_t uxBit;
+
+    configASSERT( xValue != 0 );
+
+    #if defined( __GNUC__ )
+    {
+        uxBit = ( UBaseType_t ) ( ( sizeof( unsigned long long ) * heapBITS_PER_BYTE ) - 1 ) - ( UBaseType_t ) __builtin_clzll( ( unsigned long long ) xValue );
+    }
+    #else
+    {
+        UBaseType_t uxWidth = ( UBaseType_t ) ( sizeof( size_t ) * heapBITS_PER_BYTE ) >> 1;
+
+        /* Binary search, so the number of steps does not depend on xValue. */
+        uxBit = 0;
+
+        while( uxWidth > 0 )
+        {
+            if( ( xValue >> uxWidth ) != 0 )
+            {
+                xValue >>= uxWidth;
+                uxBit += uxWidth;
+            }
+
+            uxWidth >>= 1;
+        }
+    }
+    #endif /* if defined( __GNUC__ ) */
+
+    return uxBit;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMapSizeToList( size_t xBlockSize,
+                              UBaseType_t * puxFirstLevel,
+                              UBaseType_t * puxSecondLevel )
+{
+    UBaseType_t uxMostSignificantBit;
+
+    if( xBlockSize < ( size_t ) heapSL_COUNT )
+    {
+        /* Sizes too small to be split into heapSL_COUNT sub-ranges share the
+         * first first level list. */
+        *puxFirstLevel = 0;
+        *puxSecondLevel = ( UBaseType_t ) xBlockSize;
+    }
+    else
+    {
+        /* The first level is set by the most significant bit, and the second
+         * level by the configHEAP_TLSF_SL_BITS bits that follow it. */
+        uxMostSignificantBit = prvFindLastSet( xBlockSize );
+        *puxSecondLevel = ( UBaseType_t ) ( xBlockSize >> ( uxMostSignificantBit - configHEAP_TLSF_SL_BITS ) ) - heapSL_COUNT;
+        *puxFirstLevel = uxMostSignificantBit - configHEAP_TLSF_SL_BITS + 1;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvFindSuitableBlock( size_t xWantedSize )
+{
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+    size_t xBitmap;
+    BlockLink_t * pxReturn = NULL;
+
+    /* Round the size up to the start of the next sub-range, so every block on
+     * the list found below is large enough without having to search the list
+     * itself. */
+    if( xWantedSize >= ( size_t ) heapSL_COUNT )
+    {
+        xWantedSize += ( ( size_t ) 1 << ( prvFindLastSet( xWantedSize ) - configHEAP_TLSF_SL_BITS ) ) - ( size_t ) 1;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 )
+    {
+        prvMapSizeToList( xWantedSize, &uxFirstLevel, &uxSecondLevel );
+
+        /* Look for a non-empty list in the same first level range first... */
+        xBitmap = uxSecondLevelBitmap[ uxFirstLevel ] & ( heapSIZE_MAX << uxSecondLevel );
+
+        if( xBitmap == 0 )
+        {
+            /* ...then in the smallest larger first level range that has any
+             * free blocks. */
+            xBitmap = uxFirstLevelBitmap & ( heapSIZE_MAX << ( uxFirstLevel + 1 ) );
+
+            if( xBitmap != 0 )
+            {
+                uxFirstLevel = prvFindFirstSet( xBitmap );
+                xBitmap = uxSecondLevelBitmap[ uxFirstLevel ];
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xBitmap != 0 )
+        {
+            uxSecondLevel = prvFindFirstSet( xBitmap );
+            pxReturn = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert )
+{
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+    BlockLink_t * pxHead;
+
+    prvMapSizeToList( pxBlockToInsert->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+
+    /* Blocks are added to the front of their list.  All the blocks on a list
+     * are large enough for any allocation that selects the list, so the order
+     * does not matter. */
+    pxHead = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+    pxBlockToInsert->pxNextFreeBlock = pxHead;
+    pxBlockToInsert->pxPrevFreeBlock = NULL;
+
+    if( pxHead != NULL )
+    {
+        pxHead->pxPrevFreeBlock = pxBlockToInsert;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlockToInsert;
+    uxFirstLevelBitmap |= ( size_t ) 1 << uxFirstLevel;
+    uxSecondLevelBitmap[ uxFirstLevel ] |= ( size_t ) 1 << uxSecondLevel;
+    xNumberOfFreeBlocks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveBlockFromFreeList( BlockLink_t * pxBlockToRemove )
+{
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+
+    prvMapSizeToList( pxBlockToRemove->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+
+    if( pxBlockToRemove->pxNextFreeBlock != NULL )
+    {
+        pxBlockToRemove->pxNextFreeBlock->pxPrevFreeBlock = pxBlockToRemove->pxPrevFreeBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxBlockToRemove->pxPrevFreeBlock != NULL )
+    {
+        pxBlockToRemove->pxPrevFreeBlock->pxNextFreeBlock = pxBlockToRemove->pxNextFreeBlock;
+    }
+    else
+    {
+        /* The block was at the head of its list. */
+        configASSERT( pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] == pxBlockToRemove );
+        pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlockToRemove->pxNextFreeBlock;
+
+        if( pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] == NULL )
+        {
+            uxSecondLevelBitmap[ uxFirstLevel ] &= ~( ( size_t ) 1 << uxSecondLevel );
+
+            if( uxSecondLevelBitmap[ uxFirstLevel ] == 0 )
+            {
+                uxFirstLevelBitmap &= ~( ( size_t ) 1 << uxFirstLevel );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    xNumberOfFreeBlocks--;
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+{
+    BlockLink_t * pxFirstFreeBlockInRegion;
+    BlockLink_t * pxEnd;
+    portPOINTER_SIZE_TYPE xAlignedHeap;
+    size_t xTotalRegionSize, xTotalHeapSize = 0;
+    BaseType_t xDefinedRegions = 0;
+    portPOINTER_SIZE_TYPE xAddress;
+    const HeapRegion_t * pxHeapRegion;
+
+    /* Can only call once! */
+    configASSERT( xHeapDefined == pdFALSE );
+
+    pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+
+    while( pxHeapRegion->xSizeInBytes > 0 )
+    {
+        xTotalRegionSize = pxHeapRegion->xSizeInBytes;
+
+        /* Ensure the heap region starts on a correctly aligned boundary. */
+        xAddress = ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress;
+
+        if( ( xAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+        {
+            xAddress += ( portBYTE_ALIGNMENT - 1 );
+            xAddress &= ~portBYTE_ALIGNMENT_MASK;
+
+            /* Adjust the size for the bytes lost to alignment. */
+            xTotalRegionSize -= ( size_t ) ( xAddress - ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress );
+        }
+
+        xAlignedHeap = xAddress;
+
+        /* pxEnd marks the end of the region.  It is a block header that is
+         * permanently marked as allocated so blocks are never merged across
+         * the end of the region. */
+        xAddress = xAlignedHeap + xTotalRegionSize;
+        xAddress -= xHeapStructSize;
+        xAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+        pxEnd = ( BlockLink_t * ) xAddress;
+
+        /* To start with there is a single free block in this region that is
+         * sized to take up the entire heap region minus the space taken by the
+         * end marker. */
+        pxFirstFreeBlockInRegion = ( BlockLink_t * ) xAlignedHeap;
+        configASSERT( ( size_t ) ( xAddress - xAlignedHeap ) >= xMinimumBlockSize );
+        pxFirstFreeBlockInRegion->xBlockSize = ( size_t ) ( xAddress - xAlignedHeap );
+        pxFirstFreeBlockInRegion->pxPrevPhysicalBlock = NULL;
+
+        pxEnd->xBlockSize = heapBLOCK_ALLOCATED_BITMASK;
+        pxEnd->pxPrevPhysicalBlock = pxFirstFreeBlockInRegion;
+
+        prvInsertBlockIntoFreeList( pxFirstFreeBlockInRegion );
+        xTotalHeapSize += pxFirstFreeBlockInRegion->xBlockSize;
+
+        /* Move onto the next HeapRegion_t structure. */
+        xDefinedRegions++;
+        pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+    }
+
+    xMinimumEverFreeBytesRemaining = xTotalHeapSize;
+    xFreeBytesRemaining = xTotalHeapSize;
+    xHeapDefined = pdTRUE;
+
+    /* Check something was actually defined before it is accessed. */
+    configASSERT( xTotalHeapSize );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockLink_t * pxBlock;
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+    size_t xBlocks, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+    vTaskSuspendAll();
+    {
+        xBlocks = xNumberOfFreeBlocks;
+
+        if( uxFirstLevelBitmap != 0 )
+        {
+            /* The largest free block is on the highest non-empty list, and the
+             * smallest on the lowest, so only those two lists are searched. */
+            uxFirstLevel = prvFindLastSet( uxFirstLevelBitmap );
+            uxSecondLevel = prvFindLastSet( uxSecondLevelBitmap[ uxFirstLevel ] );
+
+            for( pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+            {
+                if( pxBlock->xBlockSize > xMaxSize )
+                {
+                    xMaxSize = pxBlock->xBlockSize;
+                }
+            }
+
+            uxFirstLevel = prvFindFirstSet( uxFirstLevelBitmap );
+            uxSecondLevel = prvFindFirstSet( uxSecondLevelBitmap[ uxFirstLevel ] );
+
+            for( pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+            {
+                if( pxBlock->xBlockSize < xMinSize )
+                {
+                    xMinSize = pxBlock->xBlockSize;
+                }
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
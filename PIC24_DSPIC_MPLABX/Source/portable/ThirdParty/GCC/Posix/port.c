@@ -0,0 +1,664 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the POSIX (Linux and
+ * other Unix-like host) port.
+ *
+ * Each task is backed by a host thread.  Only the thread of the task that the
+ * kernel has selected to run is ever released; every other thread is parked
+ * on its own event until a context switch hands control to it.  The tick is
+ * generated by an interval timer that raises SIGALRM, and "interrupts" are
+ * masked by blocking signals in the running thread, so the tick handler
+ * interrupts the running task exactly as a hardware timer interrupt would.
+ *
+ * The port is intended for running the kernel and the standard demo tasks on
+ * a development host or in CI.  It does not provide real time behaviour.
+ *----------------------------------------------------------*/
+
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "utils/wait_for_event.h"
+
+/*-----------------------------------------------------------*/
+
+/* Signal used to tell the thread that called vTaskStartScheduler() that the
+ * scheduler has been ended. */
+#define portSIG_RESUME    SIGUSR1
+
+/* The longest time for which the tick is suppressed in one go. */
+#define portMAX_SUPPRESSED_TICKS    ( ( TickType_t ) configTICK_RATE_HZ * ( TickType_t ) 60 )
+
+/* The data needed to manage the host thread that backs a task.  It is held at
+ * the top of the task's stack, which the task itself never uses because the
+ * thread runs on a stack allocated by the host. */
+typedef struct THREAD
+{
+    pthread_t pthread;
+    TaskFunction_t pxCode;
+    void * pvParams;
+    volatile BaseType_t xDying;
+    struct event * ev;
+} Thread_t;
+
+/*
+ * Setup the timer to generate the tick interrupts.
+ */
+static void prvSetupTimerInterrupt( void );
+
+/*
+ * The tick "interrupt" handler.
+ */
+static void prvSystemTickHandler( int iSignal );
+
+/*
+ * Block all signals in the calling thread and install the tick handler.  This
+ * is performed once, before the first task is created, so every task thread
+ * inherits a fully blocked signal mask.
+ */
+static void prvSetupSignalsAndSchedulerPolicy( void );
+
+/*
+ * Entry point of every task thread.  The thread waits until it is scheduled
+ * for the first time before calling the task function.
+ */
+static void * prvWaitForStart( void * pvParams );
+
+/*
+ * Hand the processor from pxThreadToSuspend, which must be the calling
+ * thread, to pxThreadToResume.
+ */
+static void prvSwitchThread( Thread_t * pxThreadToResume,
+                             Thread_t * pxThreadToSuspend );
+
+static void prvSuspendSelf( Thread_t * pxThread );
+static void prvResumeThread( Thread_t * pxThread );
+
+/*
+ * Report an error from a host call that the port cannot recover from.
+ */
+static void prvFatalError( const char * pcCall,
+                           int iErrno );
+
+/*-----------------------------------------------------------*/
+
+static pthread_once_t hSigSetupThread = PTHREAD_ONCE_INIT;
+static sigset_t xAllSignals;
+static sigset_t xSchedulerOriginalSignalMask;
+static pthread_t hMainThread;
+static volatile BaseType_t xSchedulerEnd = pdFALSE;
+static struct timespec xStartTime;
+
+/* The critical nesting count belongs to whichever task is running, so it is
+ * saved and restored by prvSwitchThread(). */
+static volatile UBaseType_t uxCriticalNesting = 0;
+
+/*-----------------------------------------------------------*/
+
+static Thread_t * prvGetThreadFromTask( TaskHandle_t xTask )
+{
+    /* The first member of the TCB is the top of stack pointer, which
+     * pxPortInitialiseStack() set to point just below the Thread_t. */
+    StackType_t * pxTopOfStack = *( StackType_t ** ) xTask;
+
+    return ( Thread_t * ) ( pxTopOfStack + 1 );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
+                                     TaskFunction_t pxCode,
+                                     void * pvParameters )
+{
+    Thread_t * pxThread;
+    int iRet;
+
+    ( void ) pthread_once( &hSigSetupThread, prvSetupSignalsAndSchedulerPolicy );
+
+    /* Store the thread data at the top of the stack.  pxTopOfStack is already
+     * aligned to portBYTE_ALIGNMENT, and Thread_t is a multiple of it in size. */
+    pxThread = ( Thread_t * ) ( pxTopOfStack + 1 ) - 1;
+    pxTopOfStack = ( StackType_t * ) pxThread - 1;
+
+    pxThread->pxCode = pxCode;
+    pxThread->pvParams = pvParameters;
+    pxThread->xDying = pdFALSE;
+
+    /* The new thread inherits the signal mask of the creating thread, so
+     * create it from within a critical section to ensure it starts with all
+     * signals blocked. */
+    vPortEnterCritical();
+    {
+        pxThread->ev = event_create();
+
+        if( pxThread->ev == NULL )
+        {
+            prvFatalError( "event_create", ENOMEM );
+        }
+
+        iRet = pthread_create( &pxThread->pthread, NULL, prvWaitForStart, pxThread );
+
+        if( iRet != 0 )
+        {
+            prvFatalError( "pthread_create", iRet );
+        }
+    }
+    vPortExitCritical();
+
+    return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+    int iSignal;
+    sigset_t xSignals;
+
+    hMainThread = pthread_self();
+
+    /* The thread that starts the scheduler only waits for it to end, so it
+     * must never take the tick.  Tasks created before the scheduler started
+     * may have left its signals unblocked when they exited their critical
+     * sections. */
+    ( void ) pthread_sigmask( SIG_SETMASK, &xAllSignals, NULL );
+    uxCriticalNesting = 0;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xStartTime );
+
+    /* Start the timer that generates the tick interrupt. */
+    prvSetupTimerInterrupt();
+
+    /* Start the first task. */
+    prvResumeThread( prvGetThreadFromTask( xTaskGetCurrentTaskHandle() ) );
+
+    /* Wait until signalled by vPortEndScheduler(). */
+    sigemptyset( &xSignals );
+    sigaddset( &xSignals, portSIG_RESUME );
+
+    while( xSchedulerEnd != pdTRUE )
+    {
+        ( void ) sigwait( &xSignals, &iSignal );
+    }
+
+    /* Restore the original signal mask. */
+    ( void ) pthread_sigmask( SIG_SETMASK, &xSchedulerOriginalSignalMask, NULL );
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+    struct itimerval xTimer;
+    struct sigaction xTickAction;
+
+    /* Stop the timer and ignore any SIGALRM that is still pending. */
+    memset( &xTimer, 0, sizeof( xTimer ) );
+    ( void ) setitimer( ITIMER_REAL, &xTimer, NULL );
+
+    memset( &xTickAction, 0, sizeof( xTickAction ) );
+    xTickAction.sa_handler = SIG_IGN;
+    sigemptyset( &xTickAction.sa_mask );
+    ( void ) sigaction( SIGALRM, &xTickAction, NULL );
+
+    /* Release the thread that started the scheduler, then park the calling
+     * task for good. */
+    xSchedulerEnd = pdTRUE;
+    ( void ) pthread_kill( hMainThread, portSIG_RESUME );
+
+    prvSuspendSelf( prvGetThreadFromTask( xTaskGetCurrentTaskHandle() ) );
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+    Thread_t * pxThreadToSuspend;
+    Thread_t * pxThreadToResume;
+
+    vPortEnterCritical();
+    {
+        pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+        vTaskSwitchContext();
+
+        pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+        prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+    }
+    vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+    ( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+    ( void ) pthread_sigmask( SIG_UNBLOCK, &xAllSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+    if( uxCriticalNesting == 0 )
+    {
+        vPortDisableInterrupts();
+    }
+
+    uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+    uxCriticalNesting--;
+
+    /* If we have reached 0 then re-enable the interrupts. */
+    if( uxCriticalNesting == 0 )
+    {
+        vPortEnableInterrupts();
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortSetInterruptMask( void )
+{
+    /* Signals are always blocked while a signal handler, which is the only
+     * place an "interrupt" can run, is executing. */
+    return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( BaseType_t xMask )
+{
+    ( void ) xMask;
+}
+/*-----------------------------------------------------------*/
+
+void vPortThreadDying( void * pxTaskToDelete,
+                       volatile BaseType_t * pxPendYield )
+{
+    Thread_t * pxThread = prvGetThreadFromTask( pxTaskToDelete );
+
+    ( void ) pxPendYield;
+
+    /* The task is deleting itself.  Its thread exits the next time it is
+     * switched out. */
+    pxThread->xDying = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortCancelThread( void * pxTaskToDelete )
+{
+    Thread_t * pxThread = prvGetThreadFromTask( pxTaskToDelete );
+
+    /* The thread is either parked on its event or has already exited, so
+     * waking it with xDying set makes it exit without running any more of the
+     * task.  Signals stay blocked while joining so the calling task cannot be
+     * switched out part way through. */
+    vPortEnterCritical();
+    {
+        pxThread->xDying = pdTRUE;
+        event_signal( pxThread->ev );
+        ( void ) pthread_join( pxThread->pthread, NULL );
+        event_delete( pxThread->ev );
+    }
+    vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulPortGetRunTime( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( unsigned long ) ( ( xNow.tv_sec - xStartTime.tv_sec ) * 1000000L +
+                               ( xNow.tv_nsec - xStartTime.tv_nsec ) / 1000L );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+    static uint64_t prvTimevalToMicroseconds( const struct timeval * pxTime )
+    {
+        return ( ( uint64_t ) pxTime->tv_sec * 1000000ULL ) + ( uint64_t ) pxTime->tv_usec;
+    }
+/*-----------------------------------------------------------*/
+
+    static uint64_t prvElapsedMicroseconds( const struct timespec * pxFrom,
+                                            const struct timespec * pxTo )
+    {
+        return ( ( uint64_t ) ( pxTo->tv_sec - pxFrom->tv_sec ) * 1000000ULL ) +
+               ( uint64_t ) ( ( pxTo->tv_nsec - pxFrom->tv_nsec ) / 1000L );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+    {
+        struct itimerval xTimer, xRemaining;
+        struct timespec xSleepStart, xWakeTime, xDeadline;
+        sigset_t xPendingSignals;
+        uint64_t ullToNextTickUs, ullIntendedUs, ullSleepUs, ullSleptUs, ullElapsedUs, ullNextTickUs, ullCompensationUs = 0ULL;
+        TickType_t xModifiableIdleTime, xCompleteTickPeriods, xTicksLost = 0;
+
+        /* The sleep is measured in microseconds, so limit its length to keep
+         * the arithmetic well within range. */
+        if( xExpectedIdleTime > portMAX_SUPPRESSED_TICKS )
+        {
+            xExpectedIdleTime = portMAX_SUPPRESSED_TICKS;
+        }
+
+        /* Stop the tick, keeping the time left until the next tick is due.
+         * Masking interrupts blocks SIGALRM in this thread, and every other
+         * thread already has it blocked, so a tick that is already due stays
+         * pending. */
+        vPortDisableInterrupts();
+        memset( &xTimer, 0, sizeof( xTimer ) );
+        ( void ) setitimer( ITIMER_REAL, &xTimer, &xRemaining );
+        ( void ) sigpending( &xPendingSignals );
+
+        if( ( sigismember( &xPendingSignals, SIGALRM ) == 1 ) || ( eTaskConfirmSleepModeStatus() == eAbortSleep ) )
+        {
+            /* Restart the tick from where it was stopped, and let a pending
+             * tick be handled as soon as interrupts are enabled again. */
+            xTimer.it_interval.tv_usec = portTICK_RATE_MICROSECONDS;
+            xTimer.it_value = xRemaining.it_value;
+
+            if( ( xTimer.it_value.tv_sec == 0 ) && ( xTimer.it_value.tv_usec == 0 ) )
+            {
+                xTimer.it_value = xTimer.it_interval;
+            }
+
+            ( void ) setitimer( ITIMER_REAL, &xTimer, NULL );
+            vPortEnableInterrupts();
+            return;
+        }
+
+        /* The sleep ends on the tick boundary at which the expected idle time
+         * ends.  Wake early by the learned wake latency, so the idle task
+         * actually runs again as close to that boundary as possible. */
+        ullToNextTickUs = prvTimevalToMicroseconds( &( xRemaining.it_value ) );
+        ullIntendedUs = ullToNextTickUs + ( ( uint64_t ) ( xExpectedIdleTime - 1 ) * portTICK_RATE_MICROSECONDS );
+
+        #if ( configUSE_TICKLESS_STATS == 1 )
+        {
+            ullCompensationUs = ulTaskGetTicklessWakeCompensation();
+
+            if( ullCompensationUs >= ullIntendedUs )
+            {
+                ullCompensationUs = ullIntendedUs - 1ULL;
+            }
+        }
+        #endif
+
+        ullSleepUs = ullIntendedUs - ullCompensationUs;
+
+        ( void ) clock_gettime( CLOCK_MONOTONIC, &xSleepStart );
+        xDeadline.tv_sec = xSleepStart.tv_sec + ( time_t ) ( ullSleepUs / 1000000ULL );
+        xDeadline.tv_nsec = xSleepStart.tv_nsec + ( long ) ( ( ullSleepUs % 1000000ULL ) * 1000ULL );
+
+        if( xDeadline.tv_nsec >= 1000000000L )
+        {
+            xDeadline.tv_sec++;
+            xDeadline.tv_nsec -= 1000000000L;
+        }
+
+        /* The host has no low power state, so the sleep is the host thread
+         * sleeping until the deadline.  No signal can end it early, as they are
+         * all blocked. */
+        xModifiableIdleTime = xExpectedIdleTime;
+        configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+
+        if( xModifiableIdleTime > 0 )
+        {
+            while( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &xDeadline, NULL ) == EINTR )
+            {
+            }
+        }
+
+        configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+        ( void ) clock_gettime( CLOCK_MONOTONIC, &xWakeTime );
+        ullSleptUs = prvElapsedMicroseconds( &xSleepStart, &xWakeTime );
+
+        /* Waking up to the compensation early means the idle time has ended,
+         * as the idle task would only just have had time to run again had the
+         * host actually had a low power state to wake from. */
+        ullElapsedUs = ullSleptUs;
+
+        if( ( ullElapsedUs < ullIntendedUs ) && ( ( ullElapsedUs + ullCompensationUs ) >= ullIntendedUs ) )
+        {
+            ullElapsedUs = ullIntendedUs;
+        }
+
+        /* Count the tick boundaries that passed while asleep.  Any beyond the
+         * expected idle time cannot be stepped into the tick count, so are
+         * reported as lost. */
+        if( ullElapsedUs < ullToNextTickUs )
+        {
+            xCompleteTickPeriods = 0;
+            ullNextTickUs = ullToNextTickUs;
+        }
+        else
+        {
+            xCompleteTickPeriods = ( TickType_t ) ( 1ULL + ( ( ullElapsedUs - ullToNextTickUs ) / portTICK_RATE_MICROSECONDS ) );
+            ullNextTickUs = ullToNextTickUs + ( ( uint64_t ) xCompleteTickPeriods * portTICK_RATE_MICROSECONDS );
+        }
+
+        if( xCompleteTickPeriods > xExpectedIdleTime )
+        {
+            xTicksLost = xCompleteTickPeriods - xExpectedIdleTime;
+            xCompleteTickPeriods = xExpectedIdleTime;
+        }
+
+        vTaskStepTick( xCompleteTickPeriods );
+
+        #if ( configUSE_TICKLESS_STATS == 1 )
+        {
+            vTaskReportTicklessWakeError( ( int32_t ) ( ( int64_t ) ullSleptUs - ( int64_t ) ullIntendedUs ), xTicksLost );
+        }
+        #else
+        {
+            ( void ) xTicksLost;
+        }
+        #endif
+
+        /* Restart the tick so the next tick falls on the next tick boundary,
+         * keeping the tick in phase with the time that passed while asleep. */
+        xTimer.it_interval.tv_sec = 0;
+        xTimer.it_interval.tv_usec = portTICK_RATE_MICROSECONDS;
+        xTimer.it_value.tv_sec = ( time_t ) ( ( ullNextTickUs - ullSleptUs ) / 1000000ULL );
+        xTimer.it_value.tv_usec = ( suseconds_t ) ( ( ullNextTickUs - ullSleptUs ) % 1000000ULL );
+        ( void ) setitimer( ITIMER_REAL, &xTimer, NULL );
+
+        vPortEnableInterrupts();
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+static void prvSetupSignalsAndSchedulerPolicy( void )
+{
+    struct sigaction xTickAction;
+    int iRet;
+
+    /* Leave SIGINT deliverable so the process can still be interrupted from
+     * the terminal. */
+    sigfillset( &xAllSignals );
+    sigdelset( &xAllSignals, SIGINT );
+
+    /* Block all signals in this thread so all new threads inherit this mask.
+     * When a thread is resumed for the first time, all signals will be
+     * unblocked. */
+    ( void ) pthread_sigmask( SIG_SETMASK, &xAllSignals, &xSchedulerOriginalSignalMask );
+
+    memset( &xTickAction, 0, sizeof( xTickAction ) );
+    xTickAction.sa_flags = SA_RESTART;
+    xTickAction.sa_handler = prvSystemTickHandler;
+    xTickAction.sa_mask = xAllSignals;
+
+    iRet = sigaction( SIGALRM, &xTickAction, NULL );
+
+    if( iRet != 0 )
+    {
+        prvFatalError( "sigaction", errno );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetupTimerInterrupt( void )
+{
+    struct itimerval xTimer;
+    int iRet;
+
+    xTimer.it_interval.tv_sec = 0;
+    xTimer.it_interval.tv_usec = portTICK_RATE_MICROSECONDS;
+    xTimer.it_value = xTimer.it_interval;
+
+    iRet = setitimer( ITIMER_REAL, &xTimer, NULL );
+
+    if( iRet != 0 )
+    {
+        prvFatalError( "setitimer", errno );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvSystemTickHandler( int iSignal )
+{
+    Thread_t * pxThreadToSuspend;
+    Thread_t * pxThreadToResume;
+
+    ( void ) iSignal;
+
+    /* Signals are blocked for the duration of the handler, which is the
+     * equivalent of being inside a critical section. */
+    uxCriticalNesting++;
+
+    pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+    if( xTaskIncrementTick() != pdFALSE )
+    {
+        /* Select the next task to run. */
+        vTaskSwitchContext();
+
+        pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+        prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+    }
+
+    uxCriticalNesting--;
+}
+/*-----------------------------------------------------------*/
+
+static void * prvWaitForStart( void * pvParams )
+{
+    Thread_t * pxThread = pvParams;
+
+    prvSuspendSelf( pxThread );
+
+    /* Resumed for the first time, so the task starts outside of any critical
+     * section with its signals unblocked. */
+    uxCriticalNesting = 0;
+    vPortEnableInterrupts();
+
+    pxThread->pxCode( pxThread->pvParams );
+
+    /* A task function must not return.  Delete the task if it does. */
+    vTaskDelete( NULL );
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchThread( Thread_t * pxThreadToResume,
+                             Thread_t * pxThreadToSuspend )
+{
+    UBaseType_t uxSavedCriticalNesting;
+
+    if( pxThreadToSuspend != pxThreadToResume )
+    {
+        /* The resumed thread restores its own nesting count, so this thread's
+         * count must be restored when it is resumed in turn. */
+        uxSavedCriticalNesting = uxCriticalNesting;
+
+        prvResumeThread( pxThreadToResume );
+
+        if( pxThreadToSuspend->xDying == pdTRUE )
+        {
+            pthread_exit( NULL );
+        }
+
+        prvSuspendSelf( pxThreadToSuspend );
+
+        uxCriticalNesting = uxSavedCriticalNesting;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvSuspendSelf( Thread_t * pxThread )
+{
+    event_wait( pxThread->ev );
+
+    /* The task was deleted by another task while its thread was parked. */
+    if( pxThread->xDying == pdTRUE )
+    {
+        pthread_exit( NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvResumeThread( Thread_t * pxThread )
+{
+    if( pthread_equal( pthread_self(), pxThread->pthread ) == 0 )
+    {
+        event_signal( pxThread->ev );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvFatalError( const char * pcCall,
+                           int iErrno )
+{
+    fprintf( stderr, "%s: %s\n", pcCall, strerror( iErrno ) );
+    abort();
+}
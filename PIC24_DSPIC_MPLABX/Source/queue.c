@@ -40,6 +40,10 @@
     #include "croutine.h"
 #endif
 
+#if ( configUSE_KERNEL_DATA_PAGE == 1 )
+    #include "kernel_data.h"
+#endif
+
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
@@ -74,8 +78,15 @@ typedef struct SemaphoreData
 {
     TaskHandle_t xMutexHolder;        /*< The handle of the task that holds the mutex. */
     UBaseType_t uxRecursiveCallCount; /*< Maintains a count of the number of times a recursive mutex has been recursively 'taken' when the structure is used as a mutex. */
+    #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+        UBaseType_t uxCeilingPriority; /*< The ceiling priority of a priority ceiling mutex, or queueNO_PRIORITY_CEILING for a mutex that uses priority inheritance. */
+    #endif
 } SemaphoreData_t;
 
+/* Marks a mutex that uses priority inheritance rather than a priority ceiling.
+ * No task can have this priority. */
+#define queueNO_PRIORITY_CEILING            ( ( UBaseType_t ) configMAX_PRIORITIES )
+
 /* Semaphores do not actually store or copy data, so have an item size of
  * zero. */
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH    ( ( UBaseType_t ) 0 )
@@ -90,6 +101,67 @@ typedef struct SemaphoreData
     #define queueYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
 #endif
 
+#if ( configUSE_QUEUE_SIZED_COPY == 1 )
+
+/* Items are copied into and out of the queue storage area by prvCopyItem(),
+ * which copies the common item sizes with one or two loads and stores. */
+    #define queueCOPY_ITEM( pvDestination, pvSource, uxItemSize )    prvCopyItem( ( pvDestination ), ( pvSource ), ( uxItemSize ) )
+
+/* On ports where portBYTE_ALIGNMENT is 2 the compiler cannot assume a void
+ * pointer is 2 byte aligned, so expands a memcpy() of constant size into byte
+ * moves.  prvCopyItem() therefore copies items of 2, 4 and 8 bytes as 16-bit
+ * half words when it finds both addresses are even.  The half word type is declared
+ * may_alias, as the item can be of any type. */
+    #ifndef queueCOPY_HALF_WORDS
+        #if ( portBYTE_ALIGNMENT == 2 ) && defined( __GNUC__ )
+            #define queueCOPY_HALF_WORDS    1
+        #else
+            #define queueCOPY_HALF_WORDS    0
+        #endif
+    #endif
+
+    #if ( queueCOPY_HALF_WORDS == 1 )
+        typedef uint16_t __attribute__( ( may_alias ) ) QueueHalfWord_t;
+    #endif
+#else
+    #define queueCOPY_ITEM( pvDestination, pvSource, uxItemSize )    ( void ) memcpy( ( pvDestination ), ( pvSource ), ( size_t ) ( uxItemSize ) )
+#endif
+
+#if ( configUSE_WAIT_OBJECTS == 1 )
+
+/* If a task is waiting in xWaitForMultipleObjects() for the queue, among other
+ * objects, then notify it that the queue is no longer empty.  Must be called
+ * from a critical section, or with interrupts masked in the FromISR case. */
+    #define queueNOTIFY_WAIT_OBJECT_TASK( pxQueue )                                                                             \
+    if( ( pxQueue )->xWaitObjectTask != NULL )                                                                                  \
+    {                                                                                                                           \
+        ( void ) xTaskNotifyIndexed( ( pxQueue )->xWaitObjectTask, configWAIT_OBJECTS_NOTIFY_INDEX, ( uint32_t ) 0, eNoAction ); \
+    }
+
+    #define queueNOTIFY_WAIT_OBJECT_TASK_FROM_ISR( pxQueue, pxHigherPriorityTaskWoken )                                                                                       \
+    if( ( pxQueue )->xWaitObjectTask != NULL )                                                                                                                                \
+    {                                                                                                                                                                         \
+        ( void ) xTaskNotifyIndexedFromISR( ( pxQueue )->xWaitObjectTask, configWAIT_OBJECTS_NOTIFY_INDEX, ( uint32_t ) 0, eNoAction, ( pxHigherPriorityTaskWoken ) ); \
+    }
+#else
+    #define queueNOTIFY_WAIT_OBJECT_TASK( pxQueue )
+    #define queueNOTIFY_WAIT_OBJECT_TASK_FROM_ISR( pxQueue, pxHigherPriorityTaskWoken )
+#endif
+
+#if ( configUSE_KERNEL_DATA_PAGE == 1 )
+
+/* Copy the number of items in a queue to the queue's slot of the kernel data
+ * page, if it has one.  Used whenever uxMessagesWaiting is written, which is
+ * always from a critical section or with interrupts masked. */
+    #define queueUPDATE_KERNEL_DATA( pxQueue )                                                                       \
+    if( ( pxQueue )->uxKernelDataSlot < ( UBaseType_t ) configKERNEL_DATA_PAGE_QUEUES )                              \
+    {                                                                                                                \
+        xKernelDataPage.xQueues[ ( pxQueue )->uxKernelDataSlot ].uxMessagesWaiting = ( pxQueue )->uxMessagesWaiting; \
+    }
+#else
+    #define queueUPDATE_KERNEL_DATA( pxQueue )
+#endif
+
 /*
  * Definition of the queue used by the scheduler.
  * Items are queued by copy, not reference.  See the following link for the
@@ -97,8 +169,8 @@ typedef struct SemaphoreData
  */
 typedef struct QueueDefinition /* The old naming convention is used to prevent breaking kernel aware debuggers. */
 {
-    int8_t * pcHead;           /*< Points to the beginning of the queue storage area. */
-    int8_t * pcWriteTo;        /*< Points to the free next place in the storage area. */
+    int8_t * pcHead portCACHE_LINE_ALIGNED; /*< Points to the beginning of the queue storage area. */
+    int8_t * pcWriteTo;                     /*< Points to the free next place in the storage area. */
 
     union
     {
@@ -106,15 +178,28 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         SemaphoreData_t xSemaphore; /*< Data required exclusively when this structure is used as a semaphore. */
     } u;
 
+    /* With configUSE_CACHE_LINE_LAYOUT set to 1 the item count and locks,
+     * which are read and written by every send and receive, are held next to
+     * the storage pointers instead of after the lists of waiting tasks. */
+    #if ( configUSE_CACHE_LINE_LAYOUT == 1 )
+        volatile UBaseType_t uxMessagesWaiting;
+        UBaseType_t uxLength;
+        UBaseType_t uxItemSize;
+        volatile int8_t cRxLock;
+        volatile int8_t cTxLock;
+    #endif
+
     List_t xTasksWaitingToSend;             /*< List of tasks that are blocked waiting to post onto this queue.  Stored in priority order. */
     List_t xTasksWaitingToReceive;          /*< List of tasks that are blocked waiting to read from this queue.  Stored in priority order. */
 
-    volatile UBaseType_t uxMessagesWaiting; /*< The number of items currently in the queue. */
-    UBaseType_t uxLength;                   /*< The length of the queue defined as the number of items it will hold, not the number of bytes. */
-    UBaseType_t uxItemSize;                 /*< The size of each items that the queue will hold. */
+    #if ( configUSE_CACHE_LINE_LAYOUT == 0 )
+        volatile UBaseType_t uxMessagesWaiting; /*< The number of items currently in the queue. */
+        UBaseType_t uxLength;                   /*< The length of the queue defined as the number of items it will hold, not the number of bytes. */
+        UBaseType_t uxItemSize;                 /*< The size of each items that the queue will hold. */
 
-    volatile int8_t cRxLock;                /*< Stores the number of items received from the queue (removed from the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
-    volatile int8_t cTxLock;                /*< Stores the number of items transmitted to the queue (added to the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
+        volatile int8_t cRxLock;                /*< Stores the number of items received from the queue (removed from the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
+        volatile int8_t cTxLock;                /*< Stores the number of items transmitted to the queue (added to the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
+    #endif
 
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the memory used by the queue was statically allocated to ensure no attempt is made to free the memory. */
@@ -128,6 +213,14 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
     #endif
+
+    #if ( configUSE_WAIT_OBJECTS == 1 )
+        TaskHandle_t xWaitObjectTask; /*< The task waiting for the queue in xWaitForMultipleObjects(), if any. */
+    #endif
+
+    #if ( configUSE_KERNEL_DATA_PAGE == 1 )
+        UBaseType_t uxKernelDataSlot; /*< The slot of the kernel data page that holds a copy of uxMessagesWaiting, or configKERNEL_DATA_PAGE_QUEUES if the queue does not have a slot. */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -201,6 +294,47 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_QUEUE_SIZED_COPY == 1 )
+
+/*
+ * Copies a single item of uxItemSize bytes.  Items of 1, 2, 4 and 8 bytes are
+ * copied by a memcpy() of constant size, which the compiler can replace with
+ * loads and stores that suit the alignment it can prove, so the most common
+ * item sizes do not need a call to memcpy().  Other items are copied by a
+ * memcpy() of uxItemSize bytes.  Where queueCOPY_HALF_WORDS is 1, items of 2,
+ * 4 and 8 bytes whose source and destination are both even are instead copied
+ * as 16-bit half words.
+ */
+    static void prvCopyItem( void * pvDestination,
+                             const void * pvSource,
+                             UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Copies uxItemCount items to the back of the queue, or out of the front of
+ * the queue, using at most two memcpy() calls - one either side of the point
+ * at which the storage area wraps.  The caller must have checked there is
+ * enough space or enough items.
+ */
+static void prvCopyMultipleToQueue( Queue_t * const pxQueue,
+                                    const void * pvItems,
+                                    const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+static void prvCopyMultipleFromQueue( Queue_t * const pxQueue,
+                                      void * const pvBuffer,
+                                      const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes up to uxMaxTasks tasks from pxEventList in a single pass.  Used by
+ * the multiple item functions so each task that can now make progress is
+ * unblocked once per batch, rather than the event list being checked once per
+ * item.
+ *
+ * @return pdTRUE if an unblocked task has a priority above the calling task,
+ * otherwise pdFALSE.
+ */
+static BaseType_t prvUnblockWaitingTasks( List_t * const pxEventList,
+                                          UBaseType_t uxMaxTasks ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 /*
@@ -229,6 +363,15 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
     static void prvInitialiseMutex( Queue_t * pxNewQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+
+/*
+ * Report that the priority ceiling protocol was broken while the calling task
+ * was taking the priority ceiling mutex pxMutex.
+ */
+    static void prvReportCeilingViolation( Queue_t * const pxMutex ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_MUTEXES == 1 )
 
 /*
@@ -308,6 +451,7 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
         {
             pxQueue->u.xQueue.pcTail = pxQueue->pcHead + ( pxQueue->uxLength * pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
             pxQueue->uxMessagesWaiting = ( UBaseType_t ) 0U;
+            queueUPDATE_KERNEL_DATA( pxQueue );
             pxQueue->pcWriteTo = pxQueue->pcHead;
             pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead + ( ( pxQueue->uxLength - 1U ) * pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
             pxQueue->cRxLock = queueUNLOCKED;
@@ -517,8 +661,26 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
      * defined. */
     pxNewQueue->uxLength = uxQueueLength;
     pxNewQueue->uxItemSize = uxItemSize;
+
+    #if ( configUSE_KERNEL_DATA_PAGE == 1 )
+    {
+        /* No slot until the queue has been reset. */
+        pxNewQueue->uxKernelDataSlot = ( UBaseType_t ) configKERNEL_DATA_PAGE_QUEUES;
+    }
+    #endif
+
     ( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
 
+    #if ( configUSE_KERNEL_DATA_PAGE == 1 )
+    {
+        taskENTER_CRITICAL();
+        {
+            pxNewQueue->uxKernelDataSlot = uxKernelDataClaimQueueSlot( ( void * ) pxNewQueue, pxNewQueue->uxMessagesWaiting );
+        }
+        taskEXIT_CRITICAL();
+    }
+    #endif
+
     #if ( configUSE_TRACE_FACILITY == 1 )
     {
         pxNewQueue->ucQueueType = ucQueueType;
@@ -531,6 +693,12 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
     }
     #endif /* configUSE_QUEUE_SETS */
 
+    #if ( configUSE_WAIT_OBJECTS == 1 )
+    {
+        pxNewQueue->xWaitObjectTask = NULL;
+    }
+    #endif
+
     traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -551,6 +719,14 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             /* In case this is a recursive mutex. */
             pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
 
+            #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+            {
+                /* xQueueCreateMutexWithCeiling() sets the ceiling after the
+                 * mutex has been created. */
+                pxNewQueue->u.xSemaphore.uxCeilingPriority = queueNO_PRIORITY_CEILING;
+            }
+            #endif
+
             traceCREATE_MUTEX( pxNewQueue );
 
             /* Start with the semaphore in the expected state. */
@@ -602,6 +778,78 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateMutexWithCeiling( UBaseType_t uxCeilingPriority )
+    {
+        QueueHandle_t xNewQueue;
+
+        configASSERT( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+        xNewQueue = xQueueCreateMutex( queueQUEUE_TYPE_MUTEX );
+
+        if( xNewQueue != NULL )
+        {
+            ( ( Queue_t * ) xNewQueue )->u.xSemaphore.uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateMutexWithCeilingStatic( UBaseType_t uxCeilingPriority,
+                                                      StaticQueue_t * pxStaticQueue )
+    {
+        QueueHandle_t xNewQueue;
+
+        configASSERT( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+        xNewQueue = xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, pxStaticQueue );
+
+        if( xNewQueue != NULL )
+        {
+            ( ( Queue_t * ) xNewQueue )->u.xSemaphore.uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+
+    static void prvReportCeilingViolation( Queue_t * const pxMutex )
+    {
+        traceMUTEX_CEILING_VIOLATION( pxMutex );
+
+        #if ( configUSE_MUTEX_CEILING_VIOLATION_HOOK == 1 )
+        {
+            vApplicationMutexCeilingViolationHook( ( QueueHandle_t ) pxMutex, xTaskGetCurrentTaskHandle() );
+        }
+        #else
+        {
+            /* Prevent compiler warnings when the trace macro is not used. */
+            ( void ) pxMutex;
+        }
+        #endif
+    }
+
+#endif /* configUSE_PRIORITY_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
 
     TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
@@ -775,6 +1023,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             if( xHandle != NULL )
             {
                 ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
+                queueUPDATE_KERNEL_DATA( ( Queue_t * ) xHandle );
 
                 traceCREATE_COUNTING_SEMAPHORE();
             }
@@ -810,6 +1059,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             if( xHandle != NULL )
             {
                 ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
+                queueUPDATE_KERNEL_DATA( ( Queue_t * ) xHandle );
 
                 traceCREATE_COUNTING_SEMAPHORE();
             }
@@ -959,6 +1209,8 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                 }
                 #endif /* configUSE_QUEUE_SETS */
 
+                queueNOTIFY_WAIT_OBJECT_TASK( pxQueue );
+
                 taskEXIT_CRITICAL();
                 return pdPASS;
             }
@@ -1193,6 +1445,8 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                 prvIncrementQueueTxLock( pxQueue, cTxLock );
             }
 
+            queueNOTIFY_WAIT_OBJECT_TASK_FROM_ISR( pxQueue, pxHigherPriorityTaskWoken );
+
             xReturn = pdPASS;
         }
         else
@@ -1207,143 +1461,96 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
-                              BaseType_t * const pxHigherPriorityTaskWoken )
+BaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+                               const void * const pvItemsToQueue,
+                               const UBaseType_t uxItemCount,
+                               TickType_t xTicksToWait )
 {
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxSpaces, uxCopied;
     Queue_t * const pxQueue = xQueue;
 
-    /* Similar to xQueueGenericSendFromISR() but used with semaphores where the
-     * item size is 0.  Don't directly wake a task that was blocked on a queue
-     * read, instead return a flag to say whether a context switch is required or
-     * not (i.e. has a task with a higher priority than us been woken by this
-     * post). */
-
     configASSERT( pxQueue );
+    configASSERT( pvItemsToQueue );
+    configASSERT( uxItemCount > ( UBaseType_t ) 0 );
 
-    /* xQueueGenericSendFromISR() should be used instead of xQueueGiveFromISR()
-     * if the item size is not 0. */
-    configASSERT( pxQueue->uxItemSize == 0 );
-
-    /* Normally a mutex would not be given from an interrupt, especially if
-     * there is a mutex holder, as priority inheritance makes no sense for an
-     * interrupts, only tasks. */
-    configASSERT( !( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( pxQueue->u.xSemaphore.xMutexHolder != NULL ) ) );
-
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
-
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    /* Semaphores and mutexes do not hold items, so cannot be used here. */
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
     {
-        const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
 
-        /* When the queue is used to implement a semaphore no data is ever
-         * moved through the queue but it is still valid to see if the queue 'has
-         * space'. */
-        if( uxMessagesWaiting < pxQueue->uxLength )
+    /*lint -save -e904 This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
         {
-            const int8_t cTxLock = pxQueue->cTxLock;
+            uxSpaces = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
 
-            traceQUEUE_SEND_FROM_ISR( pxQueue );
+            /* Is there room for at least one item on the queue now?  As many
+             * items as will fit are posted in one go. */
+            if( uxSpaces > ( UBaseType_t ) 0 )
+            {
+                traceQUEUE_SEND( pxQueue );
 
-            /* A task can only have an inherited priority if it is a mutex
-             * holder - and if there is a mutex holder then the mutex cannot be
-             * given from an ISR.  As this is the ISR version of the function it
-             * can be assumed there is no mutex holder and no need to determine if
-             * priority disinheritance is needed.  Simply increase the count of
-             * messages (semaphores) available. */
-            pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+                uxCopied = configMIN( uxItemCount, uxSpaces );
+                prvCopyMultipleToQueue( pxQueue, pvItemsToQueue, uxCopied );
 
-            /* The event list is not altered if the queue is locked.  This will
-             * be done when the queue is unlocked later. */
-            if( cTxLock == queueUNLOCKED )
-            {
                 #if ( configUSE_QUEUE_SETS == 1 )
                 {
                     if( pxQueue->pxQueueSetContainer != NULL )
                     {
-                        if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                        BaseType_t xYieldRequired = pdFALSE;
+                        UBaseType_t uxItem;
+
+                        /* The queue set holds one entry for each item in its
+                         * member queues, so must be notified once per item. */
+                        for( uxItem = 0; uxItem < uxCopied; uxItem++ )
                         {
-                            /* The semaphore is a member of a queue set, and
-                             * posting to the queue set caused a higher priority
-                             * task to unblock.  A context switch is required. */
-                            if( pxHigherPriorityTaskWoken != NULL )
+                            if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
                             {
-                                *pxHigherPriorityTaskWoken = pdTRUE;
+                                xYieldRequired = pdTRUE;
                             }
                             else
                             {
                                 mtCOVERAGE_TEST_MARKER();
                             }
                         }
+
+                        if( xYieldRequired != pdFALSE )
+                        {
+                            queueYIELD_IF_USING_PREEMPTION();
+                        }
                         else
                         {
                             mtCOVERAGE_TEST_MARKER();
                         }
                     }
+                    else if( prvUnblockWaitingTasks( &( pxQueue->xTasksWaitingToReceive ), uxCopied ) != pdFALSE )
+                    {
+                        /* One of the unblocked tasks has a priority higher than
+                         * our own so yield immediately. */
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
                     else
                     {
-                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-                        {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                            {
-                                /* The task waiting has a higher priority so
-                                 *  record that a context switch is required. */
-                                if( pxHigherPriorityTaskWoken != NULL )
-                                {
-                                    *pxHigherPriorityTaskWoken = pdTRUE;
-                                }
-                                else
-                                {
-                                    mtCOVERAGE_TEST_MARKER();
-                                }
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+                        mtCOVERAGE_TEST_MARKER();
                     }
                 }
                 #else /* configUSE_QUEUE_SETS */
                 {
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    /* Each item posted can satisfy one task that is waiting for
+                     * data, so unblock up to that many tasks. */
+                    if( prvUnblockWaitingTasks( &( pxQueue->xTasksWaitingToReceive ), uxCopied ) != pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                        {
-                            /* The task waiting has a higher priority so record that a
-                             * context switch is required. */
-                            if( pxHigherPriorityTaskWoken != NULL )
-                            {
-                                *pxHigherPriorityTaskWoken = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+                        /* One of the unblocked tasks has a priority higher than
+                         * our own so yield immediately. */
+                        queueYIELD_IF_USING_PREEMPTION();
                     }
                     else
                     {
@@ -1351,21 +1558,341 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
                     }
                 }
                 #endif /* configUSE_QUEUE_SETS */
+
+                queueNOTIFY_WAIT_OBJECT_TASK( pxQueue );
+
+                taskEXIT_CRITICAL();
+                return ( BaseType_t ) uxCopied;
             }
             else
             {
-                /* Increment the lock count so the task that unlocks the queue
-                 * knows that data was posted while it was locked. */
-                prvIncrementQueueTxLock( pxQueue, cTxLock );
-            }
-
-            xReturn = pdPASS;
-        }
-        else
-        {
-            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
-            xReturn = errQUEUE_FULL;
-        }
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was full and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    taskEXIT_CRITICAL();
+                    traceQUEUE_SEND_FAILED( pxQueue );
+                    return 0;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The queue was full and a block time was specified so
+                     * configure the timeout structure. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /* Interrupts and other tasks can send to and receive from the queue
+         * now the critical section has been exited. */
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
+                }
+            }
+            else
+            {
+                /* Try again. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* The timeout has expired. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            traceQUEUE_SEND_FAILED( pxQueue );
+            return 0;
+        }
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                      const void * const pvItemsToQueue,
+                                      const UBaseType_t uxItemCount,
+                                      BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    UBaseType_t uxSavedInterruptStatus, uxSpaces, uxCopied = 0;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    configASSERT( pvItemsToQueue );
+    configASSERT( uxItemCount > ( UBaseType_t ) 0 );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+    /* See the comments in xQueueGenericSendFromISR(). */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        uxSpaces = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+
+        if( uxSpaces > ( UBaseType_t ) 0 )
+        {
+            int8_t cTxLock = pxQueue->cTxLock;
+            BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+            uxCopied = configMIN( uxItemCount, uxSpaces );
+            prvCopyMultipleToQueue( pxQueue, pvItemsToQueue, uxCopied );
+
+            /* The event list is not altered if the queue is locked.  This will
+             * be done when the queue is unlocked later. */
+            if( cTxLock == queueUNLOCKED )
+            {
+                #if ( configUSE_QUEUE_SETS == 1 )
+                {
+                    if( pxQueue->pxQueueSetContainer != NULL )
+                    {
+                        UBaseType_t uxItem;
+
+                        /* The queue set holds one entry for each item in its
+                         * member queues, so must be notified once per item. */
+                        for( uxItem = 0; uxItem < uxCopied; uxItem++ )
+                        {
+                            if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                            {
+                                xHigherPriorityTaskWoken = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                    }
+                    else
+                    {
+                        xHigherPriorityTaskWoken = prvUnblockWaitingTasks( &( pxQueue->xTasksWaitingToReceive ), uxCopied );
+                    }
+                }
+                #else /* configUSE_QUEUE_SETS */
+                {
+                    xHigherPriorityTaskWoken = prvUnblockWaitingTasks( &( pxQueue->xTasksWaitingToReceive ), uxCopied );
+                }
+                #endif /* configUSE_QUEUE_SETS */
+
+                if( ( xHigherPriorityTaskWoken != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                UBaseType_t uxItem;
+
+                /* Increment the lock count once for each item posted so the
+                 * task that unlocks the queue knows how many waiting tasks can
+                 * be unblocked. */
+                for( uxItem = 0; uxItem < uxCopied; uxItem++ )
+                {
+                    prvIncrementQueueTxLock( pxQueue, cTxLock );
+                    cTxLock = pxQueue->cTxLock;
+                }
+            }
+
+            queueNOTIFY_WAIT_OBJECT_TASK_FROM_ISR( pxQueue, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    return ( BaseType_t ) uxCopied;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
+                              BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    BaseType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+
+    /* Similar to xQueueGenericSendFromISR() but used with semaphores where the
+     * item size is 0.  Don't directly wake a task that was blocked on a queue
+     * read, instead return a flag to say whether a context switch is required or
+     * not (i.e. has a task with a higher priority than us been woken by this
+     * post). */
+
+    configASSERT( pxQueue );
+
+    /* xQueueGenericSendFromISR() should be used instead of xQueueGiveFromISR()
+     * if the item size is not 0. */
+    configASSERT( pxQueue->uxItemSize == 0 );
+
+    /* Normally a mutex would not be given from an interrupt, especially if
+     * there is a mutex holder, as priority inheritance makes no sense for an
+     * interrupts, only tasks. */
+    configASSERT( !( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( pxQueue->u.xSemaphore.xMutexHolder != NULL ) ) );
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+        /* When the queue is used to implement a semaphore no data is ever
+         * moved through the queue but it is still valid to see if the queue 'has
+         * space'. */
+        if( uxMessagesWaiting < pxQueue->uxLength )
+        {
+            const int8_t cTxLock = pxQueue->cTxLock;
+
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+            /* A task can only have an inherited priority if it is a mutex
+             * holder - and if there is a mutex holder then the mutex cannot be
+             * given from an ISR.  As this is the ISR version of the function it
+             * can be assumed there is no mutex holder and no need to determine if
+             * priority disinheritance is needed.  Simply increase the count of
+             * messages (semaphores) available. */
+            pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+            queueUPDATE_KERNEL_DATA( pxQueue );
+
+            /* The event list is not altered if the queue is locked.  This will
+             * be done when the queue is unlocked later. */
+            if( cTxLock == queueUNLOCKED )
+            {
+                #if ( configUSE_QUEUE_SETS == 1 )
+                {
+                    if( pxQueue->pxQueueSetContainer != NULL )
+                    {
+                        if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                        {
+                            /* The semaphore is a member of a queue set, and
+                             * posting to the queue set caused a higher priority
+                             * task to unblock.  A context switch is required. */
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        {
+                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            {
+                                /* The task waiting has a higher priority so
+                                 *  record that a context switch is required. */
+                                if( pxHigherPriorityTaskWoken != NULL )
+                                {
+                                    *pxHigherPriorityTaskWoken = pdTRUE;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                #else /* configUSE_QUEUE_SETS */
+                {
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    {
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        {
+                            /* The task waiting has a higher priority so record that a
+                             * context switch is required. */
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_SETS */
+            }
+            else
+            {
+                /* Increment the lock count so the task that unlocks the queue
+                 * knows that data was posted while it was locked. */
+                prvIncrementQueueTxLock( pxQueue, cTxLock );
+            }
+
+            queueNOTIFY_WAIT_OBJECT_TASK_FROM_ISR( pxQueue, pxHigherPriorityTaskWoken );
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            xReturn = errQUEUE_FULL;
+        }
     }
     portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
@@ -1412,6 +1939,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                 prvCopyDataFromQueue( pxQueue, pvBuffer );
                 traceQUEUE_RECEIVE( pxQueue );
                 pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+                queueUPDATE_KERNEL_DATA( pxQueue );
 
                 /* There is now space in the queue, were any tasks waiting to
                  * post to the queue?  If so, unblock the highest priority waiting
@@ -1527,6 +2055,10 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
         BaseType_t xInheritanceOccurred = pdFALSE;
     #endif
 
+    #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+        BaseType_t xCeilingViolated = pdFALSE;
+    #endif
+
     /* Check the queue pointer is not NULL. */
     configASSERT( ( pxQueue ) );
 
@@ -1561,6 +2093,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 /* Semaphores are queues with a data size of zero and where the
                  * messages waiting is the semaphore's count.  Reduce the count. */
                 pxQueue->uxMessagesWaiting = uxSemaphoreCount - ( UBaseType_t ) 1;
+                queueUPDATE_KERNEL_DATA( pxQueue );
 
                 #if ( configUSE_MUTEXES == 1 )
                 {
@@ -1569,6 +2102,30 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                         /* Record the information required to implement
                          * priority inheritance should it become necessary. */
                         pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+
+                        #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+                        {
+                            /* A priority ceiling mutex instead raises the
+                             * priority of the new holder immediately, so no
+                             * task that shares the mutex can preempt it. */
+                            if( ( pxQueue->u.xSemaphore.uxCeilingPriority != queueNO_PRIORITY_CEILING ) &&
+                                ( pxQueue->u.xSemaphore.xMutexHolder != NULL ) )
+                            {
+                                if( xTaskPriorityRaiseToCeiling( pxQueue->u.xSemaphore.uxCeilingPriority ) == pdFAIL )
+                                {
+                                    xCeilingViolated = pdTRUE;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif /* configUSE_PRIORITY_CEILING_MUTEXES */
                     }
                     else
                     {
@@ -1581,21 +2138,35 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                  * semaphore, and if so, unblock the highest priority such task. */
                 if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                taskEXIT_CRITICAL();
+
+                #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+                {
+                    if( xCeilingViolated != pdFALSE )
                     {
-                        queueYIELD_IF_USING_PREEMPTION();
+                        prvReportCeilingViolation( pxQueue );
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                #endif
 
-                taskEXIT_CRITICAL();
                 return pdPASS;
             }
             else
@@ -1645,11 +2216,24 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 {
                     if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
                     {
-                        taskENTER_CRITICAL();
+                        #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+                            if( pxQueue->u.xSemaphore.uxCeilingPriority != queueNO_PRIORITY_CEILING )
+                            {
+                                /* The holder of a priority ceiling mutex
+                                 * already runs at the ceiling, so there is
+                                 * nothing to inherit - but a task that shares
+                                 * the mutex should never find it held. */
+                                prvReportCeilingViolation( pxQueue );
+                            }
+                            else
+                        #endif
                         {
-                            xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+                            taskENTER_CRITICAL();
+                            {
+                                xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+                            }
+                            taskEXIT_CRITICAL();
                         }
-                        taskEXIT_CRITICAL();
                     }
                     else
                     {
@@ -1722,25 +2306,271 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-    } /*lint -restore */
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueuePeek( QueueHandle_t xQueue,
+                       void * const pvBuffer,
+                       TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    int8_t * pcOriginalReadPosition;
+    Queue_t * const pxQueue = xQueue;
+
+    /* Check the pointer is not NULL. */
+    configASSERT( ( pxQueue ) );
+
+    /* The buffer into which data is received can only be NULL if the data size
+     * is zero (so no data is copied into the buffer. */
+    configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
+
+    /* Cannot block if the scheduler is suspended. */
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /*lint -save -e904  This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+            /* Is there data in the queue now?  To be running the calling task
+             * must be the highest priority task wanting to access the queue. */
+            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                /* Remember the read position so it can be reset after the data
+                 * is read from the queue as this function is only peeking the
+                 * data, not removing it. */
+                pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
+
+                prvCopyDataFromQueue( pxQueue, pvBuffer );
+                traceQUEUE_PEEK( pxQueue );
+
+                /* The data is not being removed, so reset the read pointer. */
+                pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+
+                /* The data is being left in the queue, so see if there are
+                 * any other tasks waiting for the data. */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        /* The task waiting has a higher priority than this task. */
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                taskEXIT_CRITICAL();
+                return pdPASS;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was empty and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    taskEXIT_CRITICAL();
+                    traceQUEUE_PEEK_FAILED( pxQueue );
+                    return errQUEUE_EMPTY;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The queue was empty and a block time was specified so
+                     * configure the timeout structure ready to enter the blocked
+                     * state. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /* Interrupts and other tasks can send to and receive from the queue
+         * now that the critical section has been exited. */
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            /* Timeout has not expired yet, check to see if there is data in the
+            * queue now, and if not enter the Blocked state to wait for data. */
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* There is data in the queue now, so don't enter the blocked
+                 * state, instead return to try and obtain the data. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* The timeout has expired.  If there is still no data in the queue
+             * exit, otherwise go back and try to read the data again. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceQUEUE_PEEK_FAILED( pxQueue );
+                return errQUEUE_EMPTY;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
+                                 void * const pvBuffer,
+                                 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    BaseType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+        /* Cannot block in an ISR, so check there is data available. */
+        if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+        {
+            const int8_t cRxLock = pxQueue->cRxLock;
+
+            traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+            prvCopyDataFromQueue( pxQueue, pvBuffer );
+            pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+            queueUPDATE_KERNEL_DATA( pxQueue );
+
+            /* If the queue is locked the event list will not be modified.
+             * Instead update the lock count so the task that unlocks the queue
+             * will know that an ISR has removed data while the queue was
+             * locked. */
+            if( cRxLock == queueUNLOCKED )
+            {
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        /* The task waiting has a higher priority than us so
+                         * force a context switch. */
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* Increment the lock count so the task that unlocks the queue
+                 * knows that data was removed while it was locked. */
+                prvIncrementQueueRxLock( pxQueue, cRxLock );
+            }
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+            traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueuePeek( QueueHandle_t xQueue,
-                       void * const pvBuffer,
-                       TickType_t xTicksToWait )
+BaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                  void * const pvBuffer,
+                                  const UBaseType_t uxMaxItems,
+                                  TickType_t xTicksToWait )
 {
     BaseType_t xEntryTimeSet = pdFALSE;
     TimeOut_t xTimeOut;
-    int8_t * pcOriginalReadPosition;
+    UBaseType_t uxCopied;
     Queue_t * const pxQueue = xQueue;
 
-    /* Check the pointer is not NULL. */
-    configASSERT( ( pxQueue ) );
+    configASSERT( pxQueue );
+    configASSERT( pvBuffer );
+    configASSERT( uxMaxItems > ( UBaseType_t ) 0 );
 
-    /* The buffer into which data is received can only be NULL if the data size
-     * is zero (so no data is copied into the buffer. */
-    configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    /* Semaphores and mutexes do not hold items, so cannot be used here. */
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
 
     /* Cannot block if the scheduler is suspended. */
     #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
@@ -1762,30 +2592,18 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
              * must be the highest priority task wanting to access the queue. */
             if( uxMessagesWaiting > ( UBaseType_t ) 0 )
             {
-                /* Remember the read position so it can be reset after the data
-                 * is read from the queue as this function is only peeking the
-                 * data, not removing it. */
-                pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
-
-                prvCopyDataFromQueue( pxQueue, pvBuffer );
-                traceQUEUE_PEEK( pxQueue );
-
-                /* The data is not being removed, so reset the read pointer. */
-                pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+                /* Data available, remove as many items as are wanted. */
+                uxCopied = configMIN( uxMaxItems, uxMessagesWaiting );
+                prvCopyMultipleFromQueue( pxQueue, pvBuffer, uxCopied );
+                traceQUEUE_RECEIVE( pxQueue );
+                pxQueue->uxMessagesWaiting = uxMessagesWaiting - uxCopied;
+                queueUPDATE_KERNEL_DATA( pxQueue );
 
-                /* The data is being left in the queue, so see if there are
-                 * any other tasks waiting for the data. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                /* There is now space in the queue for each item removed, so
+                 * unblock up to that many tasks that are waiting to post. */
+                if( prvUnblockWaitingTasks( &( pxQueue->xTasksWaitingToSend ), uxCopied ) != pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                    {
-                        /* The task waiting has a higher priority than this task. */
-                        queueYIELD_IF_USING_PREEMPTION();
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                    queueYIELD_IF_USING_PREEMPTION();
                 }
                 else
                 {
@@ -1793,7 +2611,7 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
                 }
 
                 taskEXIT_CRITICAL();
-                return pdPASS;
+                return ( BaseType_t ) uxCopied;
             }
             else
             {
@@ -1802,14 +2620,13 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
                     /* The queue was empty and no block time is specified (or
                      * the block time has expired) so leave now. */
                     taskEXIT_CRITICAL();
-                    traceQUEUE_PEEK_FAILED( pxQueue );
-                    return errQUEUE_EMPTY;
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    return 0;
                 }
                 else if( xEntryTimeSet == pdFALSE )
                 {
                     /* The queue was empty and a block time was specified so
-                     * configure the timeout structure ready to enter the blocked
-                     * state. */
+                     * configure the timeout structure. */
                     vTaskInternalSetTimeOutState( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
                 }
@@ -1823,7 +2640,7 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
         taskEXIT_CRITICAL();
 
         /* Interrupts and other tasks can send to and receive from the queue
-         * now that the critical section has been exited. */
+         * now the critical section has been exited. */
 
         vTaskSuspendAll();
         prvLockQueue( pxQueue );
@@ -1831,11 +2648,11 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
         /* Update the timeout state to see if it has expired yet. */
         if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
         {
-            /* Timeout has not expired yet, check to see if there is data in the
-            * queue now, and if not enter the Blocked state to wait for data. */
+            /* The timeout has not expired.  If the queue is still empty place
+             * the task on the list of tasks waiting to receive from the queue. */
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
-                traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
+                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
                 vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
                 prvUnlockQueue( pxQueue );
 
@@ -1850,23 +2667,23 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
             }
             else
             {
-                /* There is data in the queue now, so don't enter the blocked
-                 * state, instead return to try and obtain the data. */
+                /* The queue contains data again.  Loop back to try and read the
+                 * data. */
                 prvUnlockQueue( pxQueue );
                 ( void ) xTaskResumeAll();
             }
         }
         else
         {
-            /* The timeout has expired.  If there is still no data in the queue
-             * exit, otherwise go back and try to read the data again. */
+            /* Timed out.  If there is no data in the queue exit, otherwise loop
+             * back and attempt to read the data. */
             prvUnlockQueue( pxQueue );
             ( void ) xTaskResumeAll();
 
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
-                traceQUEUE_PEEK_FAILED( pxQueue );
-                return errQUEUE_EMPTY;
+                traceQUEUE_RECEIVE_FAILED( pxQueue );
+                return 0;
             }
             else
             {
@@ -1877,31 +2694,20 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
-                                 void * const pvBuffer,
-                                 BaseType_t * const pxHigherPriorityTaskWoken )
+BaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                         void * const pvBuffer,
+                                         const UBaseType_t uxMaxItems,
+                                         BaseType_t * const pxHigherPriorityTaskWoken )
 {
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
+    UBaseType_t uxSavedInterruptStatus, uxCopied = 0;
     Queue_t * const pxQueue = xQueue;
 
     configASSERT( pxQueue );
-    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( pvBuffer );
+    configASSERT( uxMaxItems > ( UBaseType_t ) 0 );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
 
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    /* See the comments in xQueueGenericSendFromISR(). */
     portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
     uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
@@ -1911,12 +2717,14 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
         /* Cannot block in an ISR, so check there is data available. */
         if( uxMessagesWaiting > ( UBaseType_t ) 0 )
         {
-            const int8_t cRxLock = pxQueue->cRxLock;
+            int8_t cRxLock = pxQueue->cRxLock;
 
             traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
 
-            prvCopyDataFromQueue( pxQueue, pvBuffer );
-            pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+            uxCopied = configMIN( uxMaxItems, uxMessagesWaiting );
+            prvCopyMultipleFromQueue( pxQueue, pvBuffer, uxCopied );
+            pxQueue->uxMessagesWaiting = uxMessagesWaiting - uxCopied;
+            queueUPDATE_KERNEL_DATA( pxQueue );
 
             /* If the queue is locked the event list will not be modified.
              * Instead update the lock count so the task that unlocks the queue
@@ -1924,25 +2732,10 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
              * locked. */
             if( cRxLock == queueUNLOCKED )
             {
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                if( ( prvUnblockWaitingTasks( &( pxQueue->xTasksWaitingToSend ), uxCopied ) != pdFALSE ) &&
+                    ( pxHigherPriorityTaskWoken != NULL ) )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
-                    {
-                        /* The task waiting has a higher priority than us so
-                         * force a context switch. */
-                        if( pxHigherPriorityTaskWoken != NULL )
-                        {
-                            *pxHigherPriorityTaskWoken = pdTRUE;
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                    *pxHigherPriorityTaskWoken = pdTRUE;
                 }
                 else
                 {
@@ -1951,22 +2744,24 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
             }
             else
             {
-                /* Increment the lock count so the task that unlocks the queue
-                 * knows that data was removed while it was locked. */
-                prvIncrementQueueRxLock( pxQueue, cRxLock );
-            }
+                UBaseType_t uxItem;
 
-            xReturn = pdPASS;
+                /* Increment the lock count once for each item removed. */
+                for( uxItem = 0; uxItem < uxCopied; uxItem++ )
+                {
+                    prvIncrementQueueRxLock( pxQueue, cRxLock );
+                    cRxLock = pxQueue->cRxLock;
+                }
+            }
         }
         else
         {
-            xReturn = pdFAIL;
             traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
         }
     }
     portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-    return xReturn;
+    return ( BaseType_t ) uxCopied;
 }
 /*-----------------------------------------------------------*/
 
@@ -2083,6 +2878,16 @@ void vQueueDelete( QueueHandle_t xQueue )
     }
     #endif
 
+    #if ( configUSE_KERNEL_DATA_PAGE == 1 )
+    {
+        taskENTER_CRITICAL();
+        {
+            vKernelDataReleaseQueueSlot( pxQueue->uxKernelDataSlot );
+        }
+        taskEXIT_CRITICAL();
+    }
+    #endif
+
     #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
     {
         /* The queue can only have been allocated dynamically - free it
@@ -2188,7 +2993,18 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
             if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
             {
                 /* The mutex is no longer being held. */
-                xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+                #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+                    if( pxQueue->u.xSemaphore.uxCeilingPriority != queueNO_PRIORITY_CEILING )
+                    {
+                        xReturn = xTaskPriorityRestoreFromCeiling( pxQueue->u.xSemaphore.xMutexHolder,
+                                                                   pxQueue->u.xSemaphore.uxCeilingPriority );
+                    }
+                    else
+                #endif
+                {
+                    xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+                }
+
                 pxQueue->u.xSemaphore.xMutexHolder = NULL;
             }
             else
@@ -2200,8 +3016,8 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
     }
     else if( xPosition == queueSEND_TO_BACK )
     {
-        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
-        pxQueue->pcWriteTo += pxQueue->uxItemSize;                                                       /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+        queueCOPY_ITEM( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        pxQueue->pcWriteTo += pxQueue->uxItemSize;                                           /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
 
         if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )                                             /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
         {
@@ -2214,7 +3030,7 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
     }
     else
     {
-        ( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
+        queueCOPY_ITEM( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
         pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
 
         if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
@@ -2248,6 +3064,7 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
     }
 
     pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+    queueUPDATE_KERNEL_DATA( pxQueue );
 
     return xReturn;
 }
@@ -2269,8 +3086,220 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
             mtCOVERAGE_TEST_MARKER();
         }
 
-        ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        queueCOPY_ITEM( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SIZED_COPY == 1 )
+
+    static void prvCopyItem( void * pvDestination,
+                             const void * pvSource,
+                             UBaseType_t uxItemSize )
+    {
+        BaseType_t xCopied = pdFALSE;
+
+        #if ( queueCOPY_HALF_WORDS == 1 )
+        {
+            const portPOINTER_SIZE_TYPE uxAddressBits = ( ( portPOINTER_SIZE_TYPE ) pvDestination ) | ( ( portPOINTER_SIZE_TYPE ) pvSource ); /*lint !e923 Only the lowest bit of each address is tested. */
+
+            /* The caller's buffer can be anywhere, so both addresses are
+             * checked before copying through half words. */
+            if( ( uxAddressBits & ( portPOINTER_SIZE_TYPE ) 1U ) == ( portPOINTER_SIZE_TYPE ) 0U )
+            {
+                QueueHalfWord_t * const pxDestination = ( QueueHalfWord_t * ) pvDestination;
+                const QueueHalfWord_t * const pxSource = ( const QueueHalfWord_t * ) pvSource;
+
+                xCopied = pdTRUE;
+
+                switch( uxItemSize )
+                {
+                    case ( UBaseType_t ) 2U:
+                        pxDestination[ 0 ] = pxSource[ 0 ];
+                        break;
+
+                    case ( UBaseType_t ) 4U:
+                        pxDestination[ 0 ] = pxSource[ 0 ];
+                        pxDestination[ 1 ] = pxSource[ 1 ];
+                        break;
+
+                    case ( UBaseType_t ) 8U:
+                        pxDestination[ 0 ] = pxSource[ 0 ];
+                        pxDestination[ 1 ] = pxSource[ 1 ];
+                        pxDestination[ 2 ] = pxSource[ 2 ];
+                        pxDestination[ 3 ] = pxSource[ 3 ];
+                        break;
+
+                    default:
+                        xCopied = pdFALSE;
+                        break;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* queueCOPY_HALF_WORDS */
+
+        if( xCopied == pdFALSE )
+        {
+            /* Neither address is known to be aligned, so copy through a
+             * memcpy() of constant size, which the compiler expands inline
+             * using whatever loads and stores the alignment it can prove
+             * allows. */
+            switch( uxItemSize )
+            {
+                case ( UBaseType_t ) 1U:
+                    ( void ) memcpy( pvDestination, pvSource, ( size_t ) 1U );
+                    break;
+
+                case ( UBaseType_t ) 2U:
+                    ( void ) memcpy( pvDestination, pvSource, ( size_t ) 2U );
+                    break;
+
+                case ( UBaseType_t ) 4U:
+                    ( void ) memcpy( pvDestination, pvSource, ( size_t ) 4U );
+                    break;
+
+                case ( UBaseType_t ) 8U:
+                    ( void ) memcpy( pvDestination, pvSource, ( size_t ) 8U );
+                    break;
+
+                default:
+                    ( void ) memcpy( pvDestination, pvSource, ( size_t ) uxItemSize );
+                    break;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_QUEUE_SIZED_COPY */
+/*-----------------------------------------------------------*/
+
+static void prvCopyMultipleToQueue( Queue_t * const pxQueue,
+                                    const void * pvItems,
+                                    const UBaseType_t uxItemCount )
+{
+    const size_t xBytesToCopy = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+    size_t xFirstBytes = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo ); /*lint !e946 !e9033 Pointer difference within the storage area. */
+
+    /* This function is called from a critical section. */
+
+    if( xFirstBytes > xBytesToCopy )
+    {
+        xFirstBytes = xBytesToCopy;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Copy up to the end of the storage area, then any remainder to the
+     * start. */
+    ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItems, xFirstBytes ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+    pxQueue->pcWriteTo += xFirstBytes;                                     /*lint !e9016 Pointer arithmetic on char types ok. */
+
+    if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+    {
+        pxQueue->pcWriteTo = pxQueue->pcHead;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xFirstBytes < xBytesToCopy )
+    {
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) ( ( const int8_t * ) pvItems + xFirstBytes ), xBytesToCopy - xFirstBytes ); /*lint !e961 !e418 !e9087 !e9079 MISRA exception as the casts are only redundant for some ports. */
+        pxQueue->pcWriteTo += ( xBytesToCopy - xFirstBytes );                                                                                    /*lint !e9016 Pointer arithmetic on char types ok. */
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxQueue->uxMessagesWaiting += uxItemCount;
+    queueUPDATE_KERNEL_DATA( pxQueue );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyMultipleFromQueue( Queue_t * const pxQueue,
+                                      void * const pvBuffer,
+                                      const UBaseType_t uxItemCount )
+{
+    const size_t xBytesToCopy = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+    int8_t * pcReadFrom = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+    size_t xFirstBytes;
+
+    /* pcReadFrom points to the last item read, so the first item to copy is
+     * the one after it. */
+    if( pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+    {
+        pcReadFrom = pxQueue->pcHead;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    xFirstBytes = ( size_t ) ( pxQueue->u.xQueue.pcTail - pcReadFrom ); /*lint !e946 !e9033 Pointer difference within the storage area. */
+
+    if( xFirstBytes > xBytesToCopy )
+    {
+        xFirstBytes = xBytesToCopy;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Copy up to the end of the storage area, then any remainder from the
+     * start. */
+    ( void ) memcpy( pvBuffer, ( void * ) pcReadFrom, xFirstBytes ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+    pcReadFrom += xFirstBytes;                                      /*lint !e9016 Pointer arithmetic on char types ok. */
+
+    if( xFirstBytes < xBytesToCopy )
+    {
+        ( void ) memcpy( ( void * ) ( ( int8_t * ) pvBuffer + xFirstBytes ), ( void * ) pxQueue->pcHead, xBytesToCopy - xFirstBytes ); /*lint !e961 !e418 !e9087 !e9079 MISRA exception as the casts are only redundant for some ports. */
+        pcReadFrom = pxQueue->pcHead + ( xBytesToCopy - xFirstBytes );                                                               /*lint !e9016 Pointer arithmetic on char types ok. */
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Leave pcReadFrom pointing at the last item read, as
+     * prvCopyDataFromQueue() does. */
+    pxQueue->u.xQueue.pcReadFrom = pcReadFrom - pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockWaitingTasks( List_t * const pxEventList,
+                                          UBaseType_t uxMaxTasks )
+{
+    BaseType_t xReturn = pdFALSE;
+
+    /* This function is called from a critical section. */
+
+    while( ( uxMaxTasks > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( pxEventList ) == pdFALSE ) )
+    {
+        if( xTaskRemoveFromEventList( pxEventList ) != pdFALSE )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        --uxMaxTasks;
     }
+
+    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
@@ -3083,3 +4112,24 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
     }
 
 #endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAIT_OBJECTS == 1 )
+
+    void vQueueSetWaitObjectTask( QueueHandle_t xQueue,
+                                  TaskHandle_t xTask )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        /* This function must be called from a critical section. */
+
+        configASSERT( pxQueue );
+
+        /* Only one task at a time can wait for a queue or semaphore as one of
+         * several objects. */
+        configASSERT( ( xTask == NULL ) || ( pxQueue->xWaitObjectTask == NULL ) || ( pxQueue->xWaitObjectTask == xTask ) );
+
+        pxQueue->xWaitObjectTask = xTask;
+    }
+
+#endif /* configUSE_WAIT_OBJECTS */
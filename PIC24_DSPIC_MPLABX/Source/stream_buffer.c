@@ -54,23 +54,56 @@
  * correct privileged Vs unprivileged linkage and placement. */
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
 
+/* With configUSE_SB_LOCK_FREE set to 1 the writer and reader do not enter a
+ * critical section unless they block, so the accesses each makes to the buffer
+ * must be ordered against its update of xHead or xTail, and against its check
+ * for a task waiting on the other side of the buffer. */
+#if ( configUSE_SB_LOCK_FREE == 1 )
+    #define sbMEMORY_BARRIER()    portMEMORY_BARRIER()
+#else
+    #define sbMEMORY_BARRIER()
+#endif
+
 /* If the user has not provided application specific Rx notification macros,
  * or #defined the notification macros away, then provide default implementations
  * that uses task notifications. */
 /*lint -save -e9026 Function like macros allowed and needed here so they can be overridden. */
 #ifndef sbRECEIVE_COMPLETED
-    #define sbRECEIVE_COMPLETED( pxStreamBuffer )                         \
-    vTaskSuspendAll();                                                    \
-    {                                                                     \
-        if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )              \
-        {                                                                 \
-            ( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToSend, \
-                                  ( uint32_t ) 0,                         \
-                                  eNoAction );                            \
-            ( pxStreamBuffer )->xTaskWaitingToSend = NULL;                \
-        }                                                                 \
-    }                                                                     \
+    #if ( configUSE_SB_LOCK_FREE == 1 )
+
+/* A writer that is about to wait records itself in xTaskWaitingToSend and
+ * then checks for space again, so the scheduler only has to be suspended if a
+ * writer is seen after xTail has been updated. */
+        #define sbRECEIVE_COMPLETED( pxStreamBuffer )                             \
+    sbMEMORY_BARRIER();                                                           \
+    if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )                          \
+    {                                                                             \
+        vTaskSuspendAll();                                                        \
+        {                                                                         \
+            if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )                  \
+            {                                                                     \
+                ( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToSend,     \
+                                      ( uint32_t ) 0,                             \
+                                      eNoAction );                                \
+                ( pxStreamBuffer )->xTaskWaitingToSend = NULL;                    \
+            }                                                                     \
+        }                                                                         \
+        ( void ) xTaskResumeAll();                                                \
+    }
+    #else /* if ( configUSE_SB_LOCK_FREE == 1 ) */
+        #define sbRECEIVE_COMPLETED( pxStreamBuffer )                         \
+    vTaskSuspendAll();                                                        \
+    {                                                                         \
+        if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )                  \
+        {                                                                     \
+            ( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToSend,     \
+                                  ( uint32_t ) 0,                             \
+                                  eNoAction );                                \
+            ( pxStreamBuffer )->xTaskWaitingToSend = NULL;                    \
+        }                                                                     \
+    }                                                                         \
     ( void ) xTaskResumeAll();
+    #endif /* if ( configUSE_SB_LOCK_FREE == 1 ) */
 #endif /* sbRECEIVE_COMPLETED */
 
 /* If user has provided a per-instance receive complete callback, then
@@ -136,18 +169,40 @@
  * implementation that uses task notifications.
  */
 #ifndef sbSEND_COMPLETED
-    #define sbSEND_COMPLETED( pxStreamBuffer )                               \
-    vTaskSuspendAll();                                                       \
-    {                                                                        \
-        if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )              \
-        {                                                                    \
-            ( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToReceive, \
-                                  ( uint32_t ) 0,                            \
-                                  eNoAction );                               \
-            ( pxStreamBuffer )->xTaskWaitingToReceive = NULL;                \
-        }                                                                    \
-    }                                                                        \
+    #if ( configUSE_SB_LOCK_FREE == 1 )
+
+/* As sbRECEIVE_COMPLETED(), a reader that is about to wait checks for data
+ * again after recording itself in xTaskWaitingToReceive. */
+        #define sbSEND_COMPLETED( pxStreamBuffer )                                \
+    sbMEMORY_BARRIER();                                                           \
+    if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )                       \
+    {                                                                             \
+        vTaskSuspendAll();                                                        \
+        {                                                                         \
+            if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )               \
+            {                                                                     \
+                ( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToReceive,  \
+                                      ( uint32_t ) 0,                             \
+                                      eNoAction );                                \
+                ( pxStreamBuffer )->xTaskWaitingToReceive = NULL;                 \
+            }                                                                     \
+        }                                                                         \
+        ( void ) xTaskResumeAll();                                                \
+    }
+    #else /* if ( configUSE_SB_LOCK_FREE == 1 ) */
+        #define sbSEND_COMPLETED( pxStreamBuffer )                            \
+    vTaskSuspendAll();                                                        \
+    {                                                                         \
+        if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )               \
+        {                                                                     \
+            ( void ) xTaskNotify( ( pxStreamBuffer )->xTaskWaitingToReceive,  \
+                                  ( uint32_t ) 0,                             \
+                                  eNoAction );                                \
+            ( pxStreamBuffer )->xTaskWaitingToReceive = NULL;                 \
+        }                                                                     \
+    }                                                                         \
     ( void ) xTaskResumeAll();
+    #endif /* if ( configUSE_SB_LOCK_FREE == 1 ) */
 #endif /* sbSEND_COMPLETED */
 
 /* If user has provided a per-instance send completed callback, then
@@ -208,6 +263,48 @@
     sbSEND_COMPLETE_FROM_ISR( ( pxStreamBuffer ), ( pxHigherPriorityTaskWoken ) )
 #endif /* if ( configUSE_SB_COMPLETED_CALLBACK == 1 ) */
 
+#if ( configUSE_WAIT_OBJECTS == 1 )
+
+/* If a task is waiting in xWaitForMultipleObjects() for the stream buffer,
+ * among other objects, then notify it that the trigger level was reached. */
+    #define sbNOTIFY_WAIT_OBJECT_TASK( pxStreamBuffer )                                \
+    if( ( pxStreamBuffer )->xWaitObjectTask != NULL )                                  \
+    {                                                                                  \
+        taskENTER_CRITICAL();                                                          \
+        {                                                                              \
+            if( ( pxStreamBuffer )->xWaitObjectTask != NULL )                          \
+            {                                                                          \
+                ( void ) xTaskNotifyIndexed( ( pxStreamBuffer )->xWaitObjectTask,      \
+                                             configWAIT_OBJECTS_NOTIFY_INDEX,          \
+                                             ( uint32_t ) 0,                           \
+                                             eNoAction );                              \
+            }                                                                          \
+        }                                                                              \
+        taskEXIT_CRITICAL();                                                           \
+    }
+
+    #define sbNOTIFY_WAIT_OBJECT_TASK_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken )    \
+    {                                                                                          \
+        UBaseType_t uxSavedInterruptStatus;                                                    \
+                                                                                               \
+        uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();            \
+        {                                                                                      \
+            if( ( pxStreamBuffer )->xWaitObjectTask != NULL )                                  \
+            {                                                                                  \
+                ( void ) xTaskNotifyIndexedFromISR( ( pxStreamBuffer )->xWaitObjectTask,       \
+                                                    configWAIT_OBJECTS_NOTIFY_INDEX,           \
+                                                    ( uint32_t ) 0,                            \
+                                                    eNoAction,                                 \
+                                                    ( pxHigherPriorityTaskWoken ) );           \
+            }                                                                                  \
+        }                                                                                      \
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );                           \
+    }
+#else /* if ( configUSE_WAIT_OBJECTS == 1 ) */
+    #define sbNOTIFY_WAIT_OBJECT_TASK( pxStreamBuffer )
+    #define sbNOTIFY_WAIT_OBJECT_TASK_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken )
+#endif /* if ( configUSE_WAIT_OBJECTS == 1 ) */
+
 /*lint -restore (9026) */
 
 /* The number of bytes used to hold the length of a message in the buffer. */
@@ -239,6 +336,10 @@ typedef struct StreamBufferDef_t                 /*lint !e9058 Style convention
         StreamBufferCallbackFunction_t pxSendCompletedCallback;    /* Optional callback called on send complete. sbSEND_COMPLETED is called if this is NULL. */
         StreamBufferCallbackFunction_t pxReceiveCompletedCallback; /* Optional callback called on receive complete.  sbRECEIVE_COMPLETED is called if this is NULL. */
     #endif
+
+    #if ( configUSE_WAIT_OBJECTS == 1 )
+        volatile TaskHandle_t xWaitObjectTask; /* Holds the handle of a task waiting for the stream buffer in xWaitForMultipleObjects(), or NULL if there is none. */
+    #endif
 } StreamBuffer_t;
 
 /*
@@ -304,6 +405,39 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
                                       size_t xCount,
                                       size_t xTail ) PRIVILEGED_FUNCTION;
 
+/*
+ * Used by the send, receive, zero copy reserve and peek functions to block the
+ * calling task until either xRequiredSpace bytes are free in the buffer, or
+ * more than xBytesToStoreMessageLength bytes are available to read,
+ * respectively.  Both return the space or bytes available when they exit,
+ * which may be less than was wanted if the block time expired.
+ */
+static size_t prvWaitForSpace( StreamBuffer_t * const pxStreamBuffer,
+                               size_t xRequiredSpace,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+static size_t prvWaitForData( StreamBuffer_t * const pxStreamBuffer,
+                              size_t xBytesToStoreMessageLength,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Publish xDataLengthBytes bytes previously written directly into the buffer's
+ * storage area by moving the buffer's xHead.  If the stream buffer is being
+ * used as a message buffer then the length of the message is written in front
+ * of the data first.  Common to xStreamBufferCommit() and
+ * xStreamBufferCommitFromISR().
+ */
+static size_t prvCommitBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                      size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Release xDataLengthBytes bytes previously read directly out of the buffer's
+ * storage area by moving the buffer's xTail.  If the stream buffer is being
+ * used as a message buffer then the message length is released too.  Common to
+ * xStreamBufferConsume() and xStreamBufferConsumeFromISR().
+ */
+static size_t prvConsumeBytesFromBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                         size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
  * initialise the members of the newly created stream buffer structure.
@@ -517,6 +651,10 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
         UBaseType_t uxStreamBufferNumber;
     #endif
 
+    #if ( configUSE_WAIT_OBJECTS == 1 )
+        TaskHandle_t xWaitObjectTask;
+    #endif
+
     configASSERT( pxStreamBuffer );
 
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -539,6 +677,14 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_WAIT_OBJECTS == 1 )
+            {
+                /* A task waiting for the stream buffer among other objects is
+                 * not blocked on the stream buffer itself, so keep it. */
+                xWaitObjectTask = pxStreamBuffer->xWaitObjectTask;
+            }
+            #endif
+
             prvInitialiseNewStreamBuffer( pxStreamBuffer,
                                           pxStreamBuffer->pucBuffer,
                                           pxStreamBuffer->xLength,
@@ -553,6 +699,12 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_WAIT_OBJECTS == 1 )
+            {
+                pxStreamBuffer->xWaitObjectTask = xWaitObjectTask;
+            }
+            #endif
+
             traceSTREAM_BUFFER_RESET( xStreamBuffer );
 
             xReturn = pdPASS;
@@ -623,6 +775,9 @@ size_t xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer )
         mtCOVERAGE_TEST_MARKER();
     }
 
+    /* Do not write into the space before the reader has finished with it. */
+    sbMEMORY_BARRIER();
+
     return xSpace;
 }
 /*-----------------------------------------------------------*/
@@ -645,9 +800,8 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
                           TickType_t xTicksToWait )
 {
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-    size_t xReturn, xSpace = 0;
+    size_t xReturn, xSpace;
     size_t xRequiredSpace = xDataLengthBytes;
-    TimeOut_t xTimeOut;
     size_t xMaxReportedSpace = 0;
 
     configASSERT( pvTxData );
@@ -696,53 +850,8 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         }
     }
 
-    if( xTicksToWait != ( TickType_t ) 0 )
-    {
-        vTaskSetTimeOutState( &xTimeOut );
-
-        do
-        {
-            /* Wait until the required number of bytes are free in the message
-             * buffer. */
-            taskENTER_CRITICAL();
-            {
-                xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-
-                if( xSpace < xRequiredSpace )
-                {
-                    /* Clear notification state as going to wait for space. */
-                    ( void ) xTaskNotifyStateClear( NULL );
-
-                    /* Should only be one writer. */
-                    configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
-                    pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
-                }
-                else
-                {
-                    taskEXIT_CRITICAL();
-                    break;
-                }
-            }
-            taskEXIT_CRITICAL();
-
-            traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
-            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
-            pxStreamBuffer->xTaskWaitingToSend = NULL;
-        } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
-
-    if( xSpace == ( size_t ) 0 )
-    {
-        xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
+    /* Wait until the required number of bytes are free in the buffer. */
+    xSpace = prvWaitForSpace( pxStreamBuffer, xRequiredSpace, xTicksToWait );
 
     xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
 
@@ -754,6 +863,7 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
         {
             prvSEND_COMPLETED( pxStreamBuffer );
+            sbNOTIFY_WAIT_OBJECT_TASK( pxStreamBuffer );
         }
         else
         {
@@ -804,6 +914,7 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
         if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
         {
             prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            sbNOTIFY_WAIT_OBJECT_TASK_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
         }
         else
         {
@@ -863,8 +974,10 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
 
     if( xDataLengthBytes != ( size_t ) 0 )
     {
-        /* Write the data to the buffer. */
-        pxStreamBuffer->xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, xNextHead ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alignment and access. */
+        /* Write the data to the buffer, then make it visible to the reader. */
+        xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, xNextHead ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alignment and access. */
+        sbMEMORY_BARRIER();
+        pxStreamBuffer->xHead = xNextHead;
     }
 
     return xDataLengthBytes;
@@ -896,54 +1009,7 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
         xBytesToStoreMessageLength = 0;
     }
 
-    if( xTicksToWait != ( TickType_t ) 0 )
-    {
-        /* Checking if there is data and clearing the notification state must be
-         * performed atomically. */
-        taskENTER_CRITICAL();
-        {
-            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
-
-            /* If this function was invoked by a message buffer read then
-             * xBytesToStoreMessageLength holds the number of bytes used to hold
-             * the length of the next discrete message.  If this function was
-             * invoked by a stream buffer read then xBytesToStoreMessageLength will
-             * be 0. */
-            if( xBytesAvailable <= xBytesToStoreMessageLength )
-            {
-                /* Clear notification state as going to wait for data. */
-                ( void ) xTaskNotifyStateClear( NULL );
-
-                /* Should only be one reader. */
-                configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
-                pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-        }
-        taskEXIT_CRITICAL();
-
-        if( xBytesAvailable <= xBytesToStoreMessageLength )
-        {
-            /* Wait for data to be available. */
-            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
-            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
-            pxStreamBuffer->xTaskWaitingToReceive = NULL;
-
-            /* Recheck the data available after blocking. */
-            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-    }
-    else
-    {
-        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
-    }
+    xBytesAvailable = prvWaitForData( pxStreamBuffer, xBytesToStoreMessageLength, xTicksToWait );
 
     /* Whether receiving a discrete message (where xBytesToStoreMessageLength
      * holds the number of bytes used to store the message length) or a stream of
@@ -1117,7 +1183,9 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
     if( xCount != ( size_t ) 0 )
     {
         /* Read the actual data and update the tail to mark the data as officially consumed. */
-        pxStreamBuffer->xTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xCount, xNextTail ); /*lint !e9079 Data storage area is implemented as uint8_t array for ease of sizing, indexing and alignment. */
+        xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xCount, xNextTail ); /*lint !e9079 Data storage area is implemented as uint8_t array for ease of sizing, indexing and alignment. */
+        sbMEMORY_BARRIER();
+        pxStreamBuffer->xTail = xNextTail;
     }
 
     return xCount;
@@ -1245,128 +1313,755 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
-                                     const uint8_t * pucData,
-                                     size_t xCount,
-                                     size_t xHead )
+static size_t prvWaitForSpace( StreamBuffer_t * const pxStreamBuffer,
+                               size_t xRequiredSpace,
+                               TickType_t xTicksToWait )
 {
-    size_t xFirstLength;
-
-    configASSERT( xCount > ( size_t ) 0 );
-
-    /* Calculate the number of bytes that can be added in the first write -
-     * which may be less than the total number of bytes that need to be added if
-     * the buffer will wrap back to the beginning. */
-    xFirstLength = configMIN( pxStreamBuffer->xLength - xHead, xCount );
-
-    /* Write as many bytes as can be written in the first write. */
-    configASSERT( ( xHead + xFirstLength ) <= pxStreamBuffer->xLength );
-    ( void ) memcpy( ( void * ) ( &( pxStreamBuffer->pucBuffer[ xHead ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+    size_t xSpace = 0;
+    TimeOut_t xTimeOut;
 
-    /* If the number of bytes written was less than the number that could be
-     * written in the first write... */
-    if( xCount > xFirstLength )
-    {
-        /* ...then write the remaining bytes to the start of the buffer. */
-        configASSERT( ( xCount - xFirstLength ) <= pxStreamBuffer->xLength );
-        ( void ) memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
-    }
-    else
+    #if ( configUSE_SB_LOCK_FREE == 1 )
     {
-        mtCOVERAGE_TEST_MARKER();
-    }
-
-    xHead += xCount;
+        /* Only the reader can free space, so if there is enough space now
+         * there will still be enough when the data is written. */
+        xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
 
-    if( xHead >= pxStreamBuffer->xLength )
-    {
-        xHead -= pxStreamBuffer->xLength;
+        if( xSpace >= xRequiredSpace )
+        {
+            xTicksToWait = ( TickType_t ) 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
-    else
+    #endif /* configUSE_SB_LOCK_FREE */
+
+    if( xTicksToWait != ( TickType_t ) 0 )
     {
-        mtCOVERAGE_TEST_MARKER();
-    }
+        vTaskSetTimeOutState( &xTimeOut );
 
-    return xHead;
-}
-/*-----------------------------------------------------------*/
+        do
+        {
+            /* Wait until the required number of bytes are free in the
+             * buffer. */
+            taskENTER_CRITICAL();
+            {
+                xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
 
-static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
-                                      uint8_t * pucData,
-                                      size_t xCount,
-                                      size_t xTail )
-{
-    size_t xFirstLength;
+                if( xSpace < xRequiredSpace )
+                {
+                    /* Clear notification state as going to wait for space. */
+                    ( void ) xTaskNotifyStateClear( NULL );
 
-    configASSERT( xCount != ( size_t ) 0 );
+                    /* Should only be one writer. */
+                    configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+                    pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+                }
+                else
+                {
+                    taskEXIT_CRITICAL();
+                    break;
+                }
+            }
+            taskEXIT_CRITICAL();
 
-    /* Calculate the number of bytes that can be read - which may be
-     * less than the number wanted if the data wraps around to the start of
-     * the buffer. */
-    xFirstLength = configMIN( pxStreamBuffer->xLength - xTail, xCount );
+            #if ( configUSE_SB_LOCK_FREE == 1 )
+            {
+                /* The reader checks xTaskWaitingToSend without entering a
+                 * critical section, so may have freed space without seeing
+                 * this task was about to wait.  Check again now this task is
+                 * recorded as waiting. */
+                sbMEMORY_BARRIER();
+                xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
 
-    /* Obtain the number of bytes it is possible to obtain in the first
-     * read.  Asserts check bounds of read and write. */
-    configASSERT( xFirstLength <= xCount );
-    configASSERT( ( xTail + xFirstLength ) <= pxStreamBuffer->xLength );
-    ( void ) memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+                if( xSpace >= xRequiredSpace )
+                {
+                    pxStreamBuffer->xTaskWaitingToSend = NULL;
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_SB_LOCK_FREE */
 
-    /* If the total number of wanted bytes is greater than the number
-     * that could be read in the first read... */
-    if( xCount > xFirstLength )
-    {
-        /* ...then read the remaining bytes from the start of the buffer. */
-        ( void ) memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+            traceBLOCKING_ON_STREAM_BUFFER_SEND( pxStreamBuffer );
+            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            pxStreamBuffer->xTaskWaitingToSend = NULL;
+        } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
     }
     else
     {
         mtCOVERAGE_TEST_MARKER();
     }
 
-    /* Move the tail pointer to effectively remove the data read from the buffer. */
-    xTail += xCount;
-
-    if( xTail >= pxStreamBuffer->xLength )
-    {
-        xTail -= pxStreamBuffer->xLength;
-    }
-
-    return xTail;
-}
-/*-----------------------------------------------------------*/
-
-static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
-{
-/* Returns the distance between xTail and xHead. */
-    size_t xCount;
-
-    xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
-    xCount -= pxStreamBuffer->xTail;
-
-    if( xCount >= pxStreamBuffer->xLength )
+    if( xSpace == ( size_t ) 0 )
     {
-        xCount -= pxStreamBuffer->xLength;
+        xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
     }
     else
     {
         mtCOVERAGE_TEST_MARKER();
     }
 
-    return xCount;
+    return xSpace;
 }
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
-                                          uint8_t * const pucBuffer,
-                                          size_t xBufferSizeBytes,
-                                          size_t xTriggerLevelBytes,
-                                          uint8_t ucFlags,
-                                          StreamBufferCallbackFunction_t pxSendCompletedCallback,
-                                          StreamBufferCallbackFunction_t pxReceiveCompletedCallback )
+static size_t prvWaitForData( StreamBuffer_t * const pxStreamBuffer,
+                              size_t xBytesToStoreMessageLength,
+                              TickType_t xTicksToWait )
 {
-    /* Assert here is deliberately writing to the entire buffer to ensure it can
-     * be written to without generating exceptions, and is setting the buffer to a
-     * known value to assist in development/debugging. */
+    size_t xBytesAvailable;
+
+    #if ( configUSE_SB_LOCK_FREE == 1 )
+    {
+        /* Only the writer can add data, so if there is data now it will still
+         * be there when it is read. */
+        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+        if( xBytesAvailable > xBytesToStoreMessageLength )
+        {
+            xTicksToWait = ( TickType_t ) 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_SB_LOCK_FREE */
+
+    if( xTicksToWait != ( TickType_t ) 0 )
+    {
+        /* Checking if there is data and clearing the notification state must be
+         * performed atomically. */
+        taskENTER_CRITICAL();
+        {
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+            if( xBytesAvailable <= xBytesToStoreMessageLength )
+            {
+                /* Clear notification state as going to wait for data. */
+                ( void ) xTaskNotifyStateClear( NULL );
+
+                /* Should only be one reader. */
+                configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+                pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        #if ( configUSE_SB_LOCK_FREE == 1 )
+        {
+            /* As in prvWaitForSpace(), the writer may have added data without
+             * seeing this task was about to wait. */
+            if( xBytesAvailable <= xBytesToStoreMessageLength )
+            {
+                sbMEMORY_BARRIER();
+                xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+                if( xBytesAvailable > xBytesToStoreMessageLength )
+                {
+                    pxStreamBuffer->xTaskWaitingToReceive = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_SB_LOCK_FREE */
+
+        if( xBytesAvailable <= xBytesToStoreMessageLength )
+        {
+            /* Wait for data to be available. */
+            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( pxStreamBuffer );
+            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+            /* Recheck the data available after blocking. */
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        /* With configUSE_SB_LOCK_FREE set to 1 the bytes available have
+         * already been read. */
+        #if ( configUSE_SB_LOCK_FREE == 0 )
+        {
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+        }
+        #endif
+    }
+
+    return xBytesAvailable;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+                             void ** ppvData,
+                             size_t xDataLengthBytes,
+                             TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn, xSpace, xRequiredSpace;
+
+    configASSERT( ppvData );
+    configASSERT( pxStreamBuffer );
+
+    /* Message buffers must use xStreamBufferReserveMessage() so the space for
+     * the message length is accounted for. */
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+    /* As with xStreamBufferSend(), only wait for as much space as the buffer
+     * could ever report. */
+    xRequiredSpace = configMIN( xDataLengthBytes, pxStreamBuffer->xLength - ( size_t ) 1 );
+    xSpace = prvWaitForSpace( pxStreamBuffer, xRequiredSpace, xTicksToWait );
+
+    /* Only the bytes between xHead and the end of the storage area can be
+     * handed out as a single block.  The caller reserves again after committing
+     * to obtain the bytes that wrap to the start of the storage area. */
+    xReturn = configMIN( xDataLengthBytes, xSpace );
+    xReturn = configMIN( xReturn, pxStreamBuffer->xLength - pxStreamBuffer->xHead );
+
+    if( xReturn > ( size_t ) 0 )
+    {
+        *ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ pxStreamBuffer->xHead ] );
+    }
+    else
+    {
+        *ppvData = NULL;
+        traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReserveMessage( StreamBufferHandle_t xStreamBuffer,
+                                    void ** ppvData,
+                                    void ** ppvWrappedData,
+                                    size_t xDataLengthBytes,
+                                    TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn = 0, xSpace, xRequiredSpace, xStart;
+
+    configASSERT( ppvData );
+    configASSERT( ppvWrappedData );
+    configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 );
+
+    /* Ensure the data length given fits within configMESSAGE_BUFFER_LENGTH_TYPE. */
+    configASSERT( ( size_t ) ( ( configMESSAGE_BUFFER_LENGTH_TYPE ) xDataLengthBytes ) == xDataLengthBytes );
+
+    *ppvData = NULL;
+    *ppvWrappedData = NULL;
+
+    xRequiredSpace = xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+    /* Overflow? */
+    configASSERT( xRequiredSpace > xDataLengthBytes );
+
+    /* The whole message must fit, and there is no point waiting for space
+     * that can never become available. */
+    if( ( xDataLengthBytes != ( size_t ) 0 ) && ( xRequiredSpace < pxStreamBuffer->xLength ) )
+    {
+        xSpace = prvWaitForSpace( pxStreamBuffer, xRequiredSpace, xTicksToWait );
+
+        if( xSpace >= xRequiredSpace )
+        {
+            /* The message length is written in front of the data by
+             * xStreamBufferCommit(), so the data starts after it. */
+            xStart = pxStreamBuffer->xHead + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+            if( xStart >= pxStreamBuffer->xLength )
+            {
+                xStart -= pxStreamBuffer->xLength;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            *ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ xStart ] );
+            xReturn = configMIN( xDataLengthBytes, pxStreamBuffer->xLength - xStart );
+
+            if( xReturn < xDataLengthBytes )
+            {
+                /* The remainder of the message wraps to the start of the
+                 * storage area. */
+                *ppvWrappedData = ( void * ) pxStreamBuffer->pucBuffer;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xReturn == ( size_t ) 0 )
+    {
+        traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCommitBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                      size_t xDataLengthBytes )
+{
+    size_t xNextHead = pxStreamBuffer->xHead;
+    configMESSAGE_BUFFER_LENGTH_TYPE xMessageLength;
+
+    if( xDataLengthBytes != ( size_t ) 0 )
+    {
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            /* Cannot commit more than was reserved. */
+            configASSERT( ( xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH ) <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+
+            /* The data is already in place, so write the length in front of it
+             * to complete the message. */
+            xMessageLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xDataLengthBytes;
+            configASSERT( ( size_t ) xMessageLength == xDataLengthBytes );
+            xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xMessageLength ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
+        }
+        else
+        {
+            configASSERT( xDataLengthBytes <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+        }
+
+        xNextHead += xDataLengthBytes;
+
+        if( xNextHead >= pxStreamBuffer->xLength )
+        {
+            xNextHead -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Make the data visible to the reader. */
+        sbMEMORY_BARRIER();
+        pxStreamBuffer->xHead = xNextHead;
+    }
+    else
+    {
+        /* Committing zero bytes abandons the reservation. */
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xDataLengthBytes;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer,
+                            size_t xDataLengthBytes )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn;
+
+    configASSERT( pxStreamBuffer );
+
+    xReturn = prvCommitBytesToBuffer( pxStreamBuffer, xDataLengthBytes );
+
+    if( xReturn > ( size_t ) 0 )
+    {
+        traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            prvSEND_COMPLETED( pxStreamBuffer );
+            sbNOTIFY_WAIT_OBJECT_TASK( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                   size_t xDataLengthBytes,
+                                   BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn;
+
+    configASSERT( pxStreamBuffer );
+
+    xReturn = prvCommitBytesToBuffer( pxStreamBuffer, xDataLengthBytes );
+
+    if( xReturn > ( size_t ) 0 )
+    {
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            sbNOTIFY_WAIT_OBJECT_TASK_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferPeekContiguous( StreamBufferHandle_t xStreamBuffer,
+                                    void ** ppvData,
+                                    TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn, xBytesAvailable;
+
+    configASSERT( ppvData );
+    configASSERT( pxStreamBuffer );
+
+    /* Message buffers must use xStreamBufferPeekMessage() so the message
+     * length is skipped. */
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+    xBytesAvailable = prvWaitForData( pxStreamBuffer, 0, xTicksToWait );
+
+    /* Only the bytes between xTail and the end of the storage area can be
+     * handed out as a single block.  The caller peeks again after consuming to
+     * obtain the bytes that wrap to the start of the storage area. */
+    xReturn = configMIN( xBytesAvailable, pxStreamBuffer->xLength - pxStreamBuffer->xTail );
+
+    if( xReturn > ( size_t ) 0 )
+    {
+        *ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ pxStreamBuffer->xTail ] );
+    }
+    else
+    {
+        *ppvData = NULL;
+        traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferPeekMessage( StreamBufferHandle_t xStreamBuffer,
+                                 void ** ppvData,
+                                 void ** ppvWrappedData,
+                                 size_t * pxMessageLengthBytes,
+                                 TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn = 0, xBytesAvailable, xMessageLength = 0, xStart;
+    configMESSAGE_BUFFER_LENGTH_TYPE xTempMessageLength;
+
+    configASSERT( ppvData );
+    configASSERT( ppvWrappedData );
+    configASSERT( pxMessageLengthBytes );
+    configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 );
+
+    *ppvData = NULL;
+    *ppvWrappedData = NULL;
+
+    xBytesAvailable = prvWaitForData( pxStreamBuffer, sbBYTES_TO_STORE_MESSAGE_LENGTH, xTicksToWait );
+
+    if( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH )
+    {
+        /* Only the length is copied out - the message itself is left in
+         * place. */
+        xStart = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, pxStreamBuffer->xTail );
+        xMessageLength = ( size_t ) xTempMessageLength;
+
+        *ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ xStart ] );
+        xReturn = configMIN( xMessageLength, pxStreamBuffer->xLength - xStart );
+
+        if( xReturn < xMessageLength )
+        {
+            /* The remainder of the message wraps to the start of the storage
+             * area. */
+            *ppvWrappedData = ( void * ) pxStreamBuffer->pucBuffer;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+    }
+
+    *pxMessageLengthBytes = xMessageLength;
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvConsumeBytesFromBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                         size_t xDataLengthBytes )
+{
+    size_t xNextTail = pxStreamBuffer->xTail;
+    configMESSAGE_BUFFER_LENGTH_TYPE xTempMessageLength;
+
+    if( xDataLengthBytes != ( size_t ) 0 )
+    {
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            /* Messages are consumed whole. */
+            xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextTail );
+            configASSERT( ( size_t ) xTempMessageLength == xDataLengthBytes );
+            ( void ) xTempMessageLength;
+        }
+        else
+        {
+            configASSERT( xDataLengthBytes <= prvBytesInBuffer( pxStreamBuffer ) );
+        }
+
+        xNextTail += xDataLengthBytes;
+
+        if( xNextTail >= pxStreamBuffer->xLength )
+        {
+            xNextTail -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Return the space to the writer. */
+        sbMEMORY_BARRIER();
+        pxStreamBuffer->xTail = xNextTail;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xDataLengthBytes;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer,
+                             size_t xDataLengthBytes )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn;
+
+    configASSERT( pxStreamBuffer );
+
+    xReturn = prvConsumeBytesFromBuffer( pxStreamBuffer, xDataLengthBytes );
+
+    /* Was a task waiting for space in the buffer? */
+    if( xReturn != ( size_t ) 0 )
+    {
+        traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReturn );
+        prvRECEIVE_COMPLETED( pxStreamBuffer );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+                                    size_t xDataLengthBytes,
+                                    BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn;
+
+    configASSERT( pxStreamBuffer );
+
+    xReturn = prvConsumeBytesFromBuffer( pxStreamBuffer, xDataLengthBytes );
+
+    /* Was a task waiting for space in the buffer? */
+    if( xReturn != ( size_t ) 0 )
+    {
+        prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                     const uint8_t * pucData,
+                                     size_t xCount,
+                                     size_t xHead )
+{
+    size_t xFirstLength;
+
+    configASSERT( xCount > ( size_t ) 0 );
+
+    /* Calculate the number of bytes that can be added in the first write -
+     * which may be less than the total number of bytes that need to be added if
+     * the buffer will wrap back to the beginning. */
+    xFirstLength = configMIN( pxStreamBuffer->xLength - xHead, xCount );
+
+    /* Write as many bytes as can be written in the first write. */
+    configASSERT( ( xHead + xFirstLength ) <= pxStreamBuffer->xLength );
+    ( void ) memcpy( ( void * ) ( &( pxStreamBuffer->pucBuffer[ xHead ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+    /* If the number of bytes written was less than the number that could be
+     * written in the first write... */
+    if( xCount > xFirstLength )
+    {
+        /* ...then write the remaining bytes to the start of the buffer. */
+        configASSERT( ( xCount - xFirstLength ) <= pxStreamBuffer->xLength );
+        ( void ) memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    xHead += xCount;
+
+    if( xHead >= pxStreamBuffer->xLength )
+    {
+        xHead -= pxStreamBuffer->xLength;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xHead;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
+                                      uint8_t * pucData,
+                                      size_t xCount,
+                                      size_t xTail )
+{
+    size_t xFirstLength;
+
+    configASSERT( xCount != ( size_t ) 0 );
+
+    /* Calculate the number of bytes that can be read - which may be
+     * less than the number wanted if the data wraps around to the start of
+     * the buffer. */
+    xFirstLength = configMIN( pxStreamBuffer->xLength - xTail, xCount );
+
+    /* Obtain the number of bytes it is possible to obtain in the first
+     * read.  Asserts check bounds of read and write. */
+    configASSERT( xFirstLength <= xCount );
+    configASSERT( ( xTail + xFirstLength ) <= pxStreamBuffer->xLength );
+    ( void ) memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+    /* If the total number of wanted bytes is greater than the number
+     * that could be read in the first read... */
+    if( xCount > xFirstLength )
+    {
+        /* ...then read the remaining bytes from the start of the buffer. */
+        ( void ) memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Move the tail pointer to effectively remove the data read from the buffer. */
+    xTail += xCount;
+
+    if( xTail >= pxStreamBuffer->xLength )
+    {
+        xTail -= pxStreamBuffer->xLength;
+    }
+
+    return xTail;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
+{
+/* Returns the distance between xTail and xHead. */
+    size_t xCount;
+
+    xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
+    xCount -= pxStreamBuffer->xTail;
+
+    if( xCount >= pxStreamBuffer->xLength )
+    {
+        xCount -= pxStreamBuffer->xLength;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Do not read the data before the writer has finished writing it. */
+    sbMEMORY_BARRIER();
+
+    return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                          uint8_t * const pucBuffer,
+                                          size_t xBufferSizeBytes,
+                                          size_t xTriggerLevelBytes,
+                                          uint8_t ucFlags,
+                                          StreamBufferCallbackFunction_t pxSendCompletedCallback,
+                                          StreamBufferCallbackFunction_t pxReceiveCompletedCallback )
+{
+    /* Assert here is deliberately writing to the entire buffer to ensure it can
+     * be written to without generating exceptions, and is setting the buffer to a
+     * known value to assist in development/debugging. */
     #if ( configASSERT_DEFINED == 1 )
     {
         /* The value written just has to be identifiable when looking at the
@@ -1425,3 +2120,24 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_WAIT_OBJECTS == 1 )
+
+    void vStreamBufferSetWaitObjectTask( StreamBufferHandle_t xStreamBuffer,
+                                         TaskHandle_t xTask )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        /* This function must be called from a critical section. */
+
+        configASSERT( pxStreamBuffer );
+
+        /* Only one task at a time can wait for a stream buffer as one of
+         * several objects. */
+        configASSERT( ( xTask == NULL ) || ( pxStreamBuffer->xWaitObjectTask == NULL ) || ( pxStreamBuffer->xWaitObjectTask == xTask ) );
+
+        pxStreamBuffer->xWaitObjectTask = xTask;
+    }
+
+#endif /* configUSE_WAIT_OBJECTS */
+/*-----------------------------------------------------------*/
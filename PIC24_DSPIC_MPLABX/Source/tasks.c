@@ -41,6 +41,10 @@
 #include "timers.h"
 #include "stack_macros.h"
 
+#if ( configUSE_KERNEL_DATA_PAGE == 1 )
+    #include "kernel_data.h"
+#endif
+
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
@@ -72,6 +76,22 @@
 #define taskWAITING_NOTIFICATION                  ( ( uint8_t ) 1 )
 #define taskNOTIFICATION_RECEIVED                 ( ( uint8_t ) 2 )
 
+#if ( configUSE_WAIT_OBJECTS == 1 )
+
+/* A task waiting in xWaitForMultipleObjects() is blocked on the notification
+ * at index configWAIT_OBJECTS_NOTIFY_INDEX.  If one of the objects it is
+ * waiting for is its notification at uxIndexToNotify then that index is
+ * notified too, so the task is unblocked. */
+    #define taskNOTIFY_WAIT_OBJECT_INDEX( pxTCB, uxIndexToNotify, ucOriginalNotifyState )                                   \
+    if( ( ( pxTCB )->uxWaitObjectNotifyMask & ( ( UBaseType_t ) 1U << ( uxIndexToNotify ) ) ) != ( UBaseType_t ) 0U ) \
+    {                                                                                                                  \
+        ( ucOriginalNotifyState ) = ( pxTCB )->ucNotifyState[ configWAIT_OBJECTS_NOTIFY_INDEX ];                       \
+        ( pxTCB )->ucNotifyState[ configWAIT_OBJECTS_NOTIFY_INDEX ] = taskNOTIFICATION_RECEIVED;                       \
+    }
+#else
+    #define taskNOTIFY_WAIT_OBJECT_INDEX( pxTCB, uxIndexToNotify, ucOriginalNotifyState )
+#endif
+
 /*
  * The value used to fill the stack of a task when the task is created.  This
  * is used purely for checking the high water mark for tasks.
@@ -86,7 +106,7 @@
 /* If any of the following are set then task stacks are filled with a known
  * value so the high water mark can be determined.  If none of the following are
  * set then don't fill the stack so there is no unnecessary dependency on memset. */
-#if ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+#if ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) || ( configUSE_STACK_SAMPLER == 1 ) )
     #define tskSET_NEW_STACKS_TO_KNOWN_VALUE    1
 #else
     #define tskSET_NEW_STACKS_TO_KNOWN_VALUE    0
@@ -196,30 +216,137 @@
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+
+/* Each task keeps a bitmap of the ceiling priorities of the priority ceiling
+ * mutexes it holds, so the highest can be found without looking at every
+ * priority.  The port's method of finding the highest set bit is used when it
+ * provides one. */
+    #define taskRECORD_CEILING_PRIORITY( uxPriority, uxCeilingPriorities )    ( uxCeilingPriorities ) |= ( ( UBaseType_t ) 1U << ( uxPriority ) )
+    #define taskRESET_CEILING_PRIORITY( uxPriority, uxCeilingPriorities )     ( uxCeilingPriorities ) &= ~( ( UBaseType_t ) 1U << ( uxPriority ) )
+
+    #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+        #define taskGET_HIGHEST_CEILING_PRIORITY( uxTopPriority, uxCeilingPriorities )                               \
+        {                                                                                                            \
+            ( uxTopPriority ) = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;                           \
+                                                                                                                     \
+            while( ( ( uxCeilingPriorities ) & ( ( UBaseType_t ) 1U << ( uxTopPriority ) ) ) == ( UBaseType_t ) 0U ) \
+            {                                                                                                        \
+                --( uxTopPriority );                                                                                 \
+            }                                                                                                        \
+        }
+    #else
+        #define taskGET_HIGHEST_CEILING_PRIORITY( uxTopPriority, uxCeilingPriorities )    portGET_HIGHEST_PRIORITY( ( uxTopPriority ), ( uxCeilingPriorities ) )
+    #endif
+
+#endif /* configUSE_PRIORITY_CEILING_MUTEXES */
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
  * count overflows. */
-#define taskSWITCH_DELAYED_LISTS()                                                \
-    {                                                                             \
-        List_t * pxTemp;                                                          \
-                                                                                  \
-        /* The delayed tasks list should be empty when the lists are switched. */ \
-        configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );               \
-                                                                                  \
-        pxTemp = pxDelayedTaskList;                                               \
-        pxDelayedTaskList = pxOverflowDelayedTaskList;                            \
-        pxOverflowDelayedTaskList = pxTemp;                                       \
-        xNumOfOverflows++;                                                        \
-        prvResetNextTaskUnblockTime();                                            \
+    #define taskSWITCH_DELAYED_LISTS()                                                \
+    {                                                                                 \
+        List_t * pxTemp;                                                              \
+                                                                                      \
+        /* The delayed tasks list should be empty when the lists are switched. */     \
+        configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );                   \
+                                                                                      \
+        pxTemp = pxDelayedTaskList;                                                   \
+        pxDelayedTaskList = pxOverflowDelayedTaskList;                                \
+        pxOverflowDelayedTaskList = pxTemp;                                           \
+        xNumOfOverflows++;                                                            \
+        prvResetNextTaskUnblockTime();                                                \
+    }
+
+#else /* configUSE_DELAYED_TASK_WHEEL */
+
+/* Geometry of the delayed task wheels.  Level n of a wheel is indexed by the
+ * nth group of configDELAYED_TASK_WHEEL_SLOT_BITS bits of a task's wake time,
+ * so enough levels are provided to cover every bit of TickType_t. */
+    #define taskDELAY_WHEEL_SLOTS        ( ( UBaseType_t ) 1U << configDELAYED_TASK_WHEEL_SLOT_BITS )
+    #define taskDELAY_WHEEL_SLOT_MASK    ( ( TickType_t ) taskDELAY_WHEEL_SLOTS - ( TickType_t ) 1U )
+    #define taskDELAY_WHEEL_LEVELS       ( ( ( sizeof( TickType_t ) * ( size_t ) 8U ) + ( size_t ) configDELAYED_TASK_WHEEL_SLOT_BITS - ( size_t ) 1U ) / ( size_t ) configDELAYED_TASK_WHEEL_SLOT_BITS )
+
+/* pxDelayedTaskWheel and pxOverflowDelayedTaskWheel are switched when the tick
+ * count overflows.  Tasks in the overflow wheel were placed relative to a wheel
+ * time of 0, which is the tick count immediately after the overflow. */
+    #define taskSWITCH_DELAYED_LISTS()                                                \
+    {                                                                                 \
+        DelayedTaskWheel_t * pxTemp;                                                  \
+                                                                                      \
+        /* The delayed task wheel should be empty when the wheels are switched. */    \
+        configASSERT( ( prvDelayedTaskWheelIsEmpty( pxDelayedTaskWheel ) ) );         \
+                                                                                      \
+        pxTemp = pxDelayedTaskWheel;                                                  \
+        pxTemp->xWheelTime = ( TickType_t ) 0U;                                       \
+        pxDelayedTaskWheel = pxOverflowDelayedTaskWheel;                              \
+        pxOverflowDelayedTaskWheel = pxTemp;                                          \
+        xNumOfOverflows++;                                                            \
+        prvResetNextTaskUnblockTime();                                                \
     }
 
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
 /*-----------------------------------------------------------*/
 
+/*
+ * Note the time at which the task represented by pxTCB entered the Ready
+ * state, so the time it waits to run can be recorded when it is switched in.
+ */
+#if ( configUSE_RUN_TIME_HISTOGRAMS == 1 )
+    #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+        #define taskRECORD_READY_TIME( pxTCB )    portALT_GET_RUN_TIME_COUNTER_VALUE( ( pxTCB )->ulReadyTime )
+    #else
+        #define taskRECORD_READY_TIME( pxTCB )    ( pxTCB )->ulReadyTime = portGET_RUN_TIME_COUNTER_VALUE()
+    #endif
+#else
+    #define taskRECORD_READY_TIME( pxTCB )
+#endif
+
+/*
+ * Copy the state of the task represented by pxTCB, or the tick count, to the
+ * kernel data page.  Only tasks that have a slot of the page are copied.
+ */
+#if ( configUSE_KERNEL_DATA_PAGE == 1 )
+    #define taskSET_KERNEL_DATA_STATE( pxTCB, eNewState )                             \
+    if( ( pxTCB )->uxKernelDataSlot < ( UBaseType_t ) configKERNEL_DATA_PAGE_TASKS )  \
+    {                                                                                 \
+        xKernelDataPage.xTasks[ ( pxTCB )->uxKernelDataSlot ].eState = ( eNewState ); \
+    }
+    #define taskSET_KERNEL_DATA_TICK_COUNT()    xKernelDataPage.xTickCount = xTickCount
+#else
+    #define taskSET_KERNEL_DATA_STATE( pxTCB, eNewState )
+    #define taskSET_KERNEL_DATA_TICK_COUNT()
+#endif
+
+/*
+ * The stack sampler scans each stack from the end furthest from the initial
+ * stack pointer towards the initial stack pointer, so the first word found not
+ * to hold the fill value marks the deepest point the stack has reached.
+ */
+#if ( configUSE_STACK_SAMPLER == 1 )
+    #if ( portSTACK_GROWTH < 0 )
+        #define taskSTACK_SAMPLE_START( pxTCB )               ( ( pxTCB )->pxStack )
+        #define taskSTACK_SAMPLE_FREE_WORDS( pxTCB, pxWord )  ( ( configSTACK_DEPTH_TYPE ) ( ( pxWord ) - ( pxTCB )->pxStack ) )
+        #define taskSTACK_SAMPLE_IS_DEEPER( pxWord, pxThan )  ( ( pxWord ) < ( pxThan ) )
+    #else
+        #define taskSTACK_SAMPLE_START( pxTCB )               ( ( pxTCB )->pxEndOfStack )
+        #define taskSTACK_SAMPLE_FREE_WORDS( pxTCB, pxWord )  ( ( configSTACK_DEPTH_TYPE ) ( ( pxTCB )->pxEndOfStack - ( pxWord ) ) )
+        #define taskSTACK_SAMPLE_IS_DEEPER( pxWord, pxThan )  ( ( pxWord ) > ( pxThan ) )
+    #endif
+#endif
+
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
  * the task.  It is inserted at the end of the list.
  */
 #define prvAddTaskToReadyList( pxTCB )                                                                 \
     traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
+    taskRECORD_READY_TIME( pxTCB );                                                                    \
+    taskSET_KERNEL_DATA_STATE( pxTCB, ( ( pxTCB ) == pxCurrentTCB ) ? eRunning : eReady );            \
     taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
     listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
     tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
@@ -254,7 +381,7 @@
  */
 typedef struct tskTaskControlBlock       /* The old naming convention is used to prevent breaking kernel aware debuggers. */
 {
-    volatile StackType_t * pxTopOfStack; /*< Points to the location of the last item placed on the tasks stack.  THIS MUST BE THE FIRST MEMBER OF THE TCB STRUCT. */
+    volatile StackType_t * pxTopOfStack portCACHE_LINE_ALIGNED; /*< Points to the location of the last item placed on the tasks stack.  THIS MUST BE THE FIRST MEMBER OF THE TCB STRUCT. */
 
     #if ( portUSING_MPU_WRAPPERS == 1 )
         xMPU_SETTINGS xMPUSettings; /*< The MPU settings are defined as part of the port layer.  THIS MUST BE THE SECOND MEMBER OF THE TCB STRUCT. */
@@ -263,6 +390,32 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     ListItem_t xStateListItem;                  /*< The list that the state list item of a task is reference from denotes the state of that task (Ready, Blocked, Suspended ). */
     ListItem_t xEventListItem;                  /*< Used to reference a task from an event list. */
     UBaseType_t uxPriority;                     /*< The priority of the task.  0 is the lowest priority. */
+
+    /* With configUSE_CACHE_LINE_LAYOUT set to 1 the members that are written
+     * by other tasks and interrupts when the task is scheduled, notified or
+     * inherits a priority are held here, next to the members above, instead
+     * of after the members that are only used when the task is created,
+     * deleted or inspected. */
+    #if ( configUSE_CACHE_LINE_LAYOUT == 1 )
+        #if ( portCRITICAL_NESTING_IN_TCB == 1 )
+            UBaseType_t uxCriticalNesting;
+        #endif
+
+        #if ( configUSE_MUTEXES == 1 )
+            UBaseType_t uxBasePriority;
+            UBaseType_t uxMutexesHeld;
+        #endif
+
+        #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+            volatile uint32_t ulNotifiedValue[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+            volatile uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+        #endif
+
+        #if ( INCLUDE_xTaskAbortDelay == 1 )
+            uint8_t ucDelayAborted;
+        #endif
+    #endif /* configUSE_CACHE_LINE_LAYOUT */
+
     StackType_t * pxStack;                      /*< Points to the start of the stack. */
     char pcTaskName[ configMAX_TASK_NAME_LEN ]; /*< Descriptive name given to the task when created.  Facilitates debugging only. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 
@@ -270,7 +423,7 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         StackType_t * pxEndOfStack; /*< Points to the highest valid address for the stack. */
     #endif
 
-    #if ( portCRITICAL_NESTING_IN_TCB == 1 )
+    #if ( ( portCRITICAL_NESTING_IN_TCB == 1 ) && ( configUSE_CACHE_LINE_LAYOUT == 0 ) )
         UBaseType_t uxCriticalNesting; /*< Holds the critical section nesting depth for ports that do not maintain their own count in the port layer. */
     #endif
 
@@ -279,11 +432,17 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         UBaseType_t uxTaskNumber; /*< Stores a number specifically for use by third party trace code. */
     #endif
 
-    #if ( configUSE_MUTEXES == 1 )
+    #if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_CACHE_LINE_LAYOUT == 0 ) )
         UBaseType_t uxBasePriority; /*< The priority last assigned to the task - used by the priority inheritance mechanism. */
         UBaseType_t uxMutexesHeld;
     #endif
 
+    #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+        UBaseType_t uxCeilingPrioritiesHeld;                  /*< A bit is set for each ceiling priority the task holds a priority ceiling mutex for, so giving one back can restore the priority set by those still held. */
+        UBaseType_t uxCeilingMutexesHeld;                     /*< The number of priority ceiling mutexes the task holds. */
+        uint8_t ucCeilingMutexesHeld[ configMAX_PRIORITIES ]; /*< The number of priority ceiling mutexes the task holds for each ceiling priority, so a bit is only cleared when the last is given back. */
+    #endif
+
     #if ( configUSE_APPLICATION_TASK_TAG == 1 )
         TaskHookFunction_t pxTaskTag;
     #endif
@@ -300,7 +459,7 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         configTLS_BLOCK_TYPE xTLSBlock; /*< Memory block used as Thread Local Storage (TLS) Block for the task. */
     #endif
 
-    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+    #if ( ( configUSE_TASK_NOTIFICATIONS == 1 ) && ( configUSE_CACHE_LINE_LAYOUT == 0 ) )
         volatile uint32_t ulNotifiedValue[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
         volatile uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
     #endif
@@ -311,13 +470,38 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         uint8_t ucStaticallyAllocated;                     /*< Set to pdTRUE if the task is a statically allocated to ensure no attempt is made to free the memory. */
     #endif
 
-    #if ( INCLUDE_xTaskAbortDelay == 1 )
+    #if ( ( INCLUDE_xTaskAbortDelay == 1 ) && ( configUSE_CACHE_LINE_LAYOUT == 0 ) )
         uint8_t ucDelayAborted;
     #endif
 
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if ( configUSE_WAIT_OBJECTS == 1 )
+        UBaseType_t uxWaitObjectNotifyMask; /*< One bit for each notification index the task is waiting for within xWaitForMultipleObjects(). */
+    #endif
+
+    #if ( configUSE_RUN_TIME_HISTOGRAMS == 1 )
+        volatile UBaseType_t uxHistogramSequence;                             /*< Incremented before and after each histogram update, so xTaskGetRunTimeHistogram() can detect a copy that raced with an update. */
+        configRUN_TIME_COUNTER_TYPE ulReadyTime;                              /*< The run time counter value when the task last entered the Ready state. */
+        uint32_t ulRunSliceHistogram[ configRUN_TIME_HISTOGRAM_BUCKETS ];     /*< Counts the periods the task spent in the Running state, by length. */
+        uint32_t ulReadyLatencyHistogram[ configRUN_TIME_HISTOGRAM_BUCKETS ]; /*< Counts the periods the task spent in the Ready state before running, by length. */
+    #endif
+
+    #if ( configUSE_STACK_SAMPLER == 1 )
+        struct tskTaskControlBlock * pxStackSamplerNext;    /*< Links every task that exists so the idle task can sample their stacks in turn. */
+        StackType_t * pxStackSampleLimit;                   /*< The deepest stack word found to have been used by the last completed sampling pass. */
+        StackType_t * pxStackSampleCursor;                  /*< The next stack word the sampling pass in progress will examine. */
+        uint32_t ulStackSamplePasses;                       /*< The number of completed sampling passes. */
+        #if ( configSTACK_SAMPLER_RECORD_SWITCH_SP == 1 )
+            volatile StackType_t * pxStackDeepestSwitchSP;  /*< The deepest stack pointer saved when the task was switched out. */
+        #endif
+    #endif
+
+    #if ( configUSE_KERNEL_DATA_PAGE == 1 )
+        UBaseType_t uxKernelDataSlot; /*< The slot of the kernel data page that holds a copy of the task's state, or configKERNEL_DATA_PAGE_TASKS if the task does not have a slot. */
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -333,10 +517,32 @@ portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
  * doing so breaks some kernel aware debuggers and debuggers that rely on removing
  * the static qualifier. */
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ]; /*< Prioritised ready tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList1;                         /*< Delayed tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList2;                         /*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+    PRIVILEGED_DATA static List_t xDelayedTaskList1;                    /*< Delayed tasks. */
+    PRIVILEGED_DATA static List_t xDelayedTaskList2;                    /*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+    PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;         /*< Points to the delayed task list currently being used. */
+    PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList; /*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#else
+
+/* A delayed task is held in the level of a wheel selected by the most
+ * significant group of bits in which its wake time differs from xWheelTime, so
+ * the nearest wake times are always held in level 0.  Tasks that share a slot
+ * are not sorted.  A bit of ulOccupied is set when a task is placed in the
+ * corresponding slot, and only cleared once the slot is seen to be empty, as
+ * tasks can leave the Blocked state without the wheel being told. */
+    typedef struct xDELAYED_TASK_WHEEL
+    {
+        List_t xSlots[ taskDELAY_WHEEL_LEVELS ][ taskDELAY_WHEEL_SLOTS ]; /*< Delayed tasks, indexed by groups of bits of their wake time. */
+        uint32_t ulOccupied[ taskDELAY_WHEEL_LEVELS ];                    /*< One bit for each slot that might not be empty. */
+        TickType_t xWheelTime;                                             /*< The time relative to which tasks are placed in the wheel. */
+    } DelayedTaskWheel_t;
+
+    PRIVILEGED_DATA static DelayedTaskWheel_t xDelayedTaskWheels[ 2 ];               /*< Delayed tasks (two wheels are used - one for delays that have overflowed the current tick count. */
+    PRIVILEGED_DATA static DelayedTaskWheel_t * volatile pxDelayedTaskWheel;         /*< Points to the delayed task wheel currently being used. */
+    PRIVILEGED_DATA static DelayedTaskWheel_t * volatile pxOverflowDelayedTaskWheel; /*< Points to the delayed task wheel currently being used to hold tasks that have overflowed the current tick count. */
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
 PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -394,6 +600,38 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t
 
 #endif
 
+#if ( configUSE_RUN_TIME_HISTOGRAMS == 1 )
+
+/* The times returned by vTaskGetCoreRunTime(), and a sequence count that is
+ * incremented before and after each update so they can be read without
+ * entering a critical section. */
+    PRIVILEGED_DATA static CoreRunTime_t xCoreRunTime = { 0 };
+    PRIVILEGED_DATA static volatile UBaseType_t uxCoreRunTimeSequence = ( UBaseType_t ) 0U;
+    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulRunSliceStartTime = 0UL; /*< Holds the value of the run time counter when the Running state task last changed. */
+
+#endif
+
+#if ( configUSE_TICKLESS_STATS == 1 )
+
+/* The statistics returned by vTaskGetTicklessStats().  The wake compensation
+ * is held separately, scaled up by configTICKLESS_WAKE_LATENCY_SHIFT bits, so
+ * errors smaller than the scaling factor still move it. */
+    PRIVILEGED_DATA static TicklessStats_t xTicklessStats = { 0 };
+    PRIVILEGED_DATA static uint32_t ulScaledWakeCompensation = 0UL;
+
+#endif
+
+#if ( configUSE_STACK_SAMPLER == 1 )
+
+/* Every task that exists is on the stack sampler list, which the idle task
+ * walks in turn, sampling a bounded number of stack words each time it runs.
+ * pxStackSamplerTCB is the task whose stack is currently being sampled, or
+ * NULL to start again from the head of the list. */
+    PRIVILEGED_DATA static TCB_t * pxStackSamplerTasks = NULL;
+    PRIVILEGED_DATA static TCB_t * pxStackSamplerTCB = NULL;
+
+#endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -516,6 +754,89 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+
+/*
+ * Move the running task to the ready list for uxNewPriority, used when it takes
+ * or gives a priority ceiling mutex.
+ */
+    static void prvSetCurrentTaskPriority( UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_RUN_TIME_HISTOGRAMS == 1 )
+
+/*
+ * Returns the index of the run time histogram bucket that counts periods
+ * ulPeriod run time counter ticks long - the index of the most significant set
+ * bit of ulPeriod, limited to configRUN_TIME_HISTOGRAM_BUCKETS - 1.
+ */
+    static UBaseType_t prvGetRunTimeHistogramBucket( configRUN_TIME_COUNTER_TYPE ulPeriod ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from vTaskSwitchContext() when the Running state task changes to add
+ * the period pxOutgoingTCB was running to its run slice histogram, and the
+ * period the newly selected task was ready to its ready latency histogram.
+ */
+    static void prvUpdateRunTimeHistograms( TCB_t * const pxOutgoingTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_STACK_SAMPLER == 1 )
+
+/*
+ * Called from the idle task to examine at most configSTACK_SAMPLER_WORDS_PER_STEP
+ * words of the stack of the task currently being sampled, moving on to the
+ * next task once a complete pass of its stack has been made.
+ */
+    static void prvStackSamplerStep( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove pxTCB from the list of tasks whose stacks are sampled.  Must be
+ * called from within a critical section.
+ */
+    static void prvStackSamplerRemoveTask( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+/*
+ * Place a delayed task's state list item in the slot of pxWheel selected by its
+ * wake time relative to the wheel time, which must not be after the wake time.
+ * Returns the time at which the tick interrupt must next look at the slot,
+ * which is the wake time itself for a level 0 slot, or the start of a higher
+ * level slot, at which point the task is moved down.
+ */
+    static TickType_t prvInsertTaskInDelayedTaskWheel( DelayedTaskWheel_t * const pxWheel,
+                                                       ListItem_t * const pxListItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from the tick interrupt to move the current delayed task wheel forward
+ * to xNewTime, moving the tasks held in any higher level slot that xNewTime has
+ * reached down to the lower levels.  Returns the level 0 slot that holds the
+ * tasks whose wake time is xNewTime.
+ */
+    static List_t * prvAdvanceDelayedTaskWheel( const TickType_t xNewTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if pxList is one of the slots of either delayed task wheel.
+ */
+    #if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
+        static BaseType_t prvListIsDelayedTaskWheelSlot( const List_t * const pxList ) PRIVILEGED_FUNCTION;
+    #endif
+
+    #if ( configASSERT_DEFINED == 1 )
+
+/*
+ * Returns pdTRUE if no tasks are referenced from pxWheel.
+ */
+        static BaseType_t prvDelayedTaskWheelIsEmpty( const DelayedTaskWheel_t * const pxWheel ) PRIVILEGED_FUNCTION;
+
+    #endif
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
 /*
@@ -1010,6 +1331,22 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     }
     #endif /* portUSING_MPU_WRAPPERS */
 
+    #if ( configUSE_STACK_SAMPLER == 1 )
+    {
+        /* Nothing is known about the stack until the first sampling pass
+         * completes, so the first pass scans the whole stack. */
+        pxNewTCB->pxStackSampleLimit = pxTopOfStack;
+        pxNewTCB->pxStackSampleCursor = taskSTACK_SAMPLE_START( pxNewTCB );
+        pxNewTCB->ulStackSamplePasses = 0UL;
+
+        #if ( configSTACK_SAMPLER_RECORD_SWITCH_SP == 1 )
+        {
+            pxNewTCB->pxStackDeepestSwitchSP = pxNewTCB->pxTopOfStack;
+        }
+        #endif
+    }
+    #endif /* configUSE_STACK_SAMPLER */
+
     if( pxCreatedTask != NULL )
     {
         /* Pass the handle out in an anonymous way.  The handle can be used to
@@ -1081,6 +1418,20 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         #endif /* configUSE_TRACE_FACILITY */
         traceTASK_CREATE( pxNewTCB );
 
+        #if ( configUSE_STACK_SAMPLER == 1 )
+        {
+            pxNewTCB->pxStackSamplerNext = pxStackSamplerTasks;
+            pxStackSamplerTasks = pxNewTCB;
+        }
+        #endif
+
+        #if ( configUSE_KERNEL_DATA_PAGE == 1 )
+        {
+            /* prvAddTaskToReadyList() sets the state held in the slot. */
+            pxNewTCB->uxKernelDataSlot = uxKernelDataClaimTaskSlot( ( void * ) pxNewTCB, eReady );
+        }
+        #endif
+
         prvAddTaskToReadyList( pxNewTCB );
 
         portSETUP_TCB( pxNewTCB );
@@ -1145,6 +1496,19 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
              * not return. */
             uxTaskNumber++;
 
+            #if ( configUSE_STACK_SAMPLER == 1 )
+            {
+                prvStackSamplerRemoveTask( pxTCB );
+            }
+            #endif
+
+            #if ( configUSE_KERNEL_DATA_PAGE == 1 )
+            {
+                vKernelDataReleaseTaskSlot( pxTCB->uxKernelDataSlot );
+                pxTCB->uxKernelDataSlot = ( UBaseType_t ) configKERNEL_DATA_PAGE_TASKS;
+            }
+            #endif
+
             if( pxTCB == pxCurrentTCB )
             {
                 /* A task is deleting itself.  This cannot complete within the
@@ -1347,10 +1711,13 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
         eTaskState eReturn;
         List_t const * pxStateList;
-        List_t const * pxDelayedList;
-        List_t const * pxOverflowedDelayedList;
         const TCB_t * const pxTCB = xTask;
 
+        #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+            List_t const * pxDelayedList;
+            List_t const * pxOverflowedDelayedList;
+        #endif
+
         configASSERT( pxTCB );
 
         if( pxTCB == pxCurrentTCB )
@@ -1363,12 +1730,21 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             taskENTER_CRITICAL();
             {
                 pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
-                pxDelayedList = pxDelayedTaskList;
-                pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+
+                #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+                {
+                    pxDelayedList = pxDelayedTaskList;
+                    pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+                }
+                #endif
             }
             taskEXIT_CRITICAL();
 
-            if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+                if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            #else
+                if( prvListIsDelayedTaskWheelSlot( pxStateList ) != pdFALSE )
+            #endif
             {
                 /* The task being queried is referenced from one of the Blocked
                  * lists. */
@@ -1704,6 +2080,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             }
 
             vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
+            taskSET_KERNEL_DATA_STATE( pxTCB, eSuspended );
 
             #if ( configUSE_TASK_NOTIFICATIONS == 1 )
             {
@@ -2036,6 +2413,7 @@ void vTaskStartScheduler( void )
         xNextTaskUnblockTime = portMAX_DELAY;
         xSchedulerRunning = pdTRUE;
         xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
+        taskSET_KERNEL_DATA_TICK_COUNT();
 
         /* If configGENERATE_RUN_TIME_STATS is defined then the following
          * macro must be defined to configure the timer/counter used to generate
@@ -2162,6 +2540,11 @@ void vTaskSuspendAll( void )
         }
         else
         {
+            /* Software timers are included, as the timer service task blocks
+             * until the next timer expires.  When the timing wheel is used the
+             * timer service task blocks until the next timer actually expires,
+             * rather than until the next time timers are moved between the
+             * levels of the wheel, for the same reason. */
             xReturn = xNextTaskUnblockTime - xTickCount;
         }
 
@@ -2446,15 +2829,34 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
             } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
             /* Search the delayed lists. */
-            if( pxTCB == NULL )
+            #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
             {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
-            }
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+                }
 
-            if( pxTCB == NULL )
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+                }
+            }
+            #else
             {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+                UBaseType_t uxWheel, uxLevel, uxSlot;
+
+                for( uxWheel = 0U; uxWheel < ( UBaseType_t ) 2U; uxWheel++ )
+                {
+                    for( uxLevel = 0U; uxLevel < ( UBaseType_t ) taskDELAY_WHEEL_LEVELS; uxLevel++ )
+                    {
+                        for( uxSlot = 0U; ( uxSlot < taskDELAY_WHEEL_SLOTS ) && ( pxTCB == NULL ); uxSlot++ )
+                        {
+                            pxTCB = prvSearchForNameWithinSingleList( &( xDelayedTaskWheels[ uxWheel ].xSlots[ uxLevel ][ uxSlot ] ), pcNameToQuery );
+                        }
+                    }
+                }
             }
+            #endif /* configUSE_DELAYED_TASK_WHEEL */
 
             #if ( INCLUDE_vTaskSuspend == 1 )
             {
@@ -2507,8 +2909,27 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
 
                 /* Fill in an TaskStatus_t structure with information on each
                  * task in the Blocked state. */
-                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+                #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+                {
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+                }
+                #else
+                {
+                    UBaseType_t uxWheel, uxLevel, uxSlot;
+
+                    for( uxWheel = 0U; uxWheel < ( UBaseType_t ) 2U; uxWheel++ )
+                    {
+                        for( uxLevel = 0U; uxLevel < ( UBaseType_t ) taskDELAY_WHEEL_LEVELS; uxLevel++ )
+                        {
+                            for( uxSlot = 0U; uxSlot < taskDELAY_WHEEL_SLOTS; uxSlot++ )
+                            {
+                                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedTaskWheels[ uxWheel ].xSlots[ uxLevel ][ uxSlot ] ), eBlocked );
+                            }
+                        }
+                    }
+                }
+                #endif /* configUSE_DELAYED_TASK_WHEEL */
 
                 #if ( INCLUDE_vTaskDelete == 1 )
                 {
@@ -2607,6 +3028,7 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
         }
 
         xTickCount += xTicksToJump;
+        taskSET_KERNEL_DATA_TICK_COUNT();
         traceINCREASE_TICK_COUNT( xTicksToJump );
     }
 
@@ -2737,6 +3159,7 @@ BaseType_t xTaskIncrementTick( void )
         /* Increment the RTOS tick, switching the delayed and overflowed
          * delayed lists if it wraps to 0. */
         xTickCount = xConstTickCount;
+        taskSET_KERNEL_DATA_TICK_COUNT();
 
         if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
         {
@@ -2753,16 +3176,35 @@ BaseType_t xTaskIncrementTick( void )
          * look any further down the list. */
         if( xConstTickCount >= xNextTaskUnblockTime )
         {
+            #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+                List_t * const pxWakeList = pxDelayedTaskList;
+            #else
+
+                /* Every task in the returned wheel slot has a wake time equal
+                 * to the tick count, so the loop below unblocks all of them. */
+                List_t * const pxWakeList = prvAdvanceDelayedTaskWheel( xConstTickCount );
+            #endif
+
             for( ; ; )
             {
-                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+                if( listLIST_IS_EMPTY( pxWakeList ) != pdFALSE )
                 {
-                    /* The delayed list is empty.  Set xNextTaskUnblockTime
-                     * to the maximum possible value so it is extremely
-                     * unlikely that the
-                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
-                     * next time through. */
-                    xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+                    {
+                        /* The delayed list is empty.  Set xNextTaskUnblockTime
+                         * to the maximum possible value so it is extremely
+                         * unlikely that the
+                         * if( xTickCount >= xNextTaskUnblockTime ) test will pass
+                         * next time through. */
+                        xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    }
+                    #else
+                    {
+                        /* Find the next slot of the wheel that needs looking
+                         * at. */
+                        prvResetNextTaskUnblockTime();
+                    }
+                    #endif
                     break;
                 }
                 else
@@ -2771,7 +3213,7 @@ BaseType_t xTaskIncrementTick( void )
                      * item at the head of the delayed list.  This is the time
                      * at which the task at the head of the delayed list must
                      * be removed from the Blocked state. */
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxWakeList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
                     xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
 
                     if( xConstTickCount < xItemValue )
@@ -3016,6 +3458,10 @@ void vTaskSwitchContext( void )
     }
     else
     {
+        #if ( configUSE_RUN_TIME_HISTOGRAMS == 1 )
+            TCB_t * const pxOutgoingTCB = pxCurrentTCB;
+        #endif
+
         xYieldPending = pdFALSE;
         traceTASK_SWITCHED_OUT();
 
@@ -3037,6 +3483,25 @@ void vTaskSwitchContext( void )
             if( ulTotalRunTime > ulTaskSwitchedInTime )
             {
                 pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+
+                #if ( configUSE_RUN_TIME_HISTOGRAMS == 1 )
+                {
+                    uxCoreRunTimeSequence++;
+                    portMEMORY_BARRIER();
+
+                    if( pxCurrentTCB == xIdleTaskHandle )
+                    {
+                        xCoreRunTime.ulIdleTime += ( ulTotalRunTime - ulTaskSwitchedInTime );
+                    }
+                    else
+                    {
+                        xCoreRunTime.ulBusyTime += ( ulTotalRunTime - ulTaskSwitchedInTime );
+                    }
+
+                    portMEMORY_BARRIER();
+                    uxCoreRunTimeSequence++;
+                }
+                #endif
             }
             else
             {
@@ -3047,6 +3512,21 @@ void vTaskSwitchContext( void )
         }
         #endif /* configGENERATE_RUN_TIME_STATS */
 
+        #if ( ( configUSE_STACK_SAMPLER == 1 ) && ( configSTACK_SAMPLER_RECORD_SWITCH_SP == 1 ) )
+        {
+            /* pxTopOfStack holds the stack pointer saved as the task was
+             * switched out. */
+            if( taskSTACK_SAMPLE_IS_DEEPER( pxCurrentTCB->pxTopOfStack, pxCurrentTCB->pxStackDeepestSwitchSP ) )
+            {
+                pxCurrentTCB->pxStackDeepestSwitchSP = pxCurrentTCB->pxTopOfStack;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
         /* Check for stack overflow, if configured. */
         taskCHECK_FOR_STACK_OVERFLOW();
 
@@ -3057,10 +3537,42 @@ void vTaskSwitchContext( void )
         }
         #endif
 
+        #if ( configUSE_KERNEL_DATA_PAGE == 1 )
+        {
+            /* The task being switched out is still Ready unless it has
+             * blocked, been suspended or been deleted. */
+            if( ( pxCurrentTCB->uxKernelDataSlot < ( UBaseType_t ) configKERNEL_DATA_PAGE_TASKS ) &&
+                ( xKernelDataPage.xTasks[ pxCurrentTCB->uxKernelDataSlot ].eState == eRunning ) )
+            {
+                xKernelDataPage.xTasks[ pxCurrentTCB->uxKernelDataSlot ].eState = eReady;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
         /* Select a new task to run using either the generic C or port
          * optimised asm code. */
         taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
         traceTASK_SWITCHED_IN();
+        taskSET_KERNEL_DATA_STATE( pxCurrentTCB, eRunning );
+
+        /* A period in the Running state only ends when a different task is
+         * selected, not each time the scheduler runs. */
+        #if ( configUSE_RUN_TIME_HISTOGRAMS == 1 )
+        {
+            if( pxCurrentTCB != pxOutgoingTCB )
+            {
+                prvUpdateRunTimeHistograms( pxOutgoingTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
 
         /* After the new task is switched in, update the global errno. */
         #if ( configUSE_POSIX_ERRNO == 1 )
@@ -3112,8 +3624,12 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
     configASSERT( pxEventList );
 
     /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
-     * the event groups implementation. */
-    configASSERT( uxSchedulerSuspended != 0 );
+     * the event groups implementation.  When configUSE_EVENT_GROUPS_DIRECT is 1
+     * it is instead called from a critical section, as interrupts then access
+     * event groups directly. */
+    #if ( configUSE_EVENT_GROUPS_DIRECT == 0 )
+        configASSERT( uxSchedulerSuspended != 0 );
+    #endif
 
     /* Store the item value in the event list item.  It is safe to access the
      * event list item here as interrupts won't access the event list item of a
@@ -3122,9 +3638,10 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
 
     /* Place the event list item of the TCB at the end of the appropriate event
      * list.  It is safe to access the event list here because it is part of an
-     * event group implementation - and interrupts don't access event groups
-     * directly (instead they access them indirectly by pending function calls to
-     * the task level). */
+     * event group implementation - and interrupts either don't access event
+     * groups directly (instead they access them indirectly by pending function
+     * calls to the task level), or this function is called from a critical
+     * section. */
     listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
 
     prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
@@ -3283,29 +3800,87 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
 }
 /*-----------------------------------------------------------*/
 
-void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
-{
-    configASSERT( pxTimeOut );
-    taskENTER_CRITICAL();
+#if ( configUSE_EVENT_GROUPS_DIRECT == 1 )
+
+    BaseType_t xTaskRemoveItemFromEventList( ListItem_t * pxEventListItem,
+                                             const TickType_t xItemValue )
     {
-        pxTimeOut->xOverflowCount = xNumOfOverflows;
-        pxTimeOut->xTimeOnEntering = xTickCount;
-    }
-    taskEXIT_CRITICAL();
-}
-/*-----------------------------------------------------------*/
+        TCB_t * pxUnblockedTCB;
+        BaseType_t xReturn;
 
-void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
-{
-    /* For internal use only as it does not use a critical section. */
-    pxTimeOut->xOverflowCount = xNumOfOverflows;
-    pxTimeOut->xTimeOnEntering = xTickCount;
-}
-/*-----------------------------------------------------------*/
+        /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
+         * called from a critical section within an ISR.  It is used by the event
+         * groups implementation when interrupts access event groups directly. */
 
-BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
-                                 TickType_t * const pxTicksToWait )
-{
+        /* Store the new item value in the event list item. */
+        listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+        pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        configASSERT( pxUnblockedTCB );
+        listREMOVE_ITEM( pxEventListItem );
+
+        if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+        {
+            listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+            prvAddTaskToReadyList( pxUnblockedTCB );
+
+            #if ( configUSE_TICKLESS_IDLE != 0 )
+            {
+                /* See the comment in xTaskRemoveFromEventList(). */
+                prvResetNextTaskUnblockTime();
+            }
+            #endif
+        }
+        else
+        {
+            /* The delayed and ready lists cannot be accessed, so hold this task
+             * pending until the scheduler is resumed.  The item value is left
+             * holding the event bits for the task to read once it runs. */
+            listINSERT_END( &( xPendingReadyList ), pxEventListItem );
+        }
+
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        {
+            /* Mark that a yield is pending in case the user is not using the
+             * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS
+             * function. */
+            xReturn = pdTRUE;
+            xYieldPending = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_EVENT_GROUPS_DIRECT */
+/*-----------------------------------------------------------*/
+
+void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    configASSERT( pxTimeOut );
+    taskENTER_CRITICAL();
+    {
+        pxTimeOut->xOverflowCount = xNumOfOverflows;
+        pxTimeOut->xTimeOnEntering = xTickCount;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    /* For internal use only as it does not use a critical section. */
+    pxTimeOut->xOverflowCount = xNumOfOverflows;
+    pxTimeOut->xTimeOnEntering = xTickCount;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
+                                 TickType_t * const pxTicksToWait )
+{
     BaseType_t xReturn;
 
     configASSERT( pxTimeOut );
@@ -3475,6 +4050,14 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
         }
         #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
 
+        #if ( configUSE_STACK_SAMPLER == 1 )
+        {
+            /* Sample a bounded part of one task's stack, so the time spent
+             * here does not depend on the size of the stacks. */
+            prvStackSamplerStep();
+        }
+        #endif /* configUSE_STACK_SAMPLER */
+
         #if ( configUSE_IDLE_HOOK == 1 )
         {
             extern void vApplicationIdleHook( void );
@@ -3520,9 +4103,43 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 
                     if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
                     {
+                        #if ( configUSE_TICKLESS_STATS == 1 )
+                            const TickType_t xTicksBeforeSleep = xTickCount + xPendedTicks;
+                        #endif
+
                         traceLOW_POWER_IDLE_BEGIN();
                         portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
                         traceLOW_POWER_IDLE_END();
+
+                        #if ( configUSE_TICKLESS_STATS == 1 )
+                        {
+                            /* The scheduler is suspended, so every tick that
+                             * passed while asleep is either stepped into the
+                             * tick count or held in xPendedTicks. */
+                            const TickType_t xTicksSlept = ( xTickCount + xPendedTicks ) - xTicksBeforeSleep;
+
+                            taskENTER_CRITICAL();
+                            {
+                                xTicklessStats.ulSleepCount++;
+                                xTicklessStats.ulTicksExpected += ( uint32_t ) xExpectedIdleTime;
+                                xTicklessStats.ulTicksSlept += ( uint32_t ) xTicksSlept;
+
+                                if( xTicksSlept == ( TickType_t ) 0 )
+                                {
+                                    xTicklessStats.ulAbortedCount++;
+                                }
+                                else if( xTicksSlept < xExpectedIdleTime )
+                                {
+                                    xTicklessStats.ulEarlyWakeCount++;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                            taskEXIT_CRITICAL();
+                        }
+                        #endif /* configUSE_TICKLESS_STATS */
                     }
                     else
                     {
@@ -3592,6 +4209,82 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 #endif /* configUSE_TICKLESS_IDLE */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_STATS == 1 )
+
+    uint32_t ulTaskGetTicklessWakeCompensation( void )
+    {
+        /* Called by the port with interrupts disabled. */
+        return xTicklessStats.ulWakeCompensation;
+    }
+
+#endif /* configUSE_TICKLESS_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_STATS == 1 )
+
+    void vTaskReportTicklessWakeError( int32_t lWakeError,
+                                       TickType_t xTicksLost )
+    {
+        /* Called by the port with interrupts disabled.  The port woke late by
+         * lWakeError even after waking early by the current compensation, so
+         * the compensation moves by a fraction of the error each time.  The
+         * compensation cannot be negative, as the port cannot wake before it
+         * went to sleep. */
+        if( lWakeError >= 0 )
+        {
+            ulScaledWakeCompensation += ( uint32_t ) lWakeError;
+        }
+        else if( ( uint32_t ) -lWakeError < ulScaledWakeCompensation )
+        {
+            ulScaledWakeCompensation -= ( uint32_t ) -lWakeError;
+        }
+        else
+        {
+            ulScaledWakeCompensation = 0UL;
+        }
+
+        xTicklessStats.ulWakeCompensation = ulScaledWakeCompensation >> configTICKLESS_WAKE_LATENCY_SHIFT;
+        xTicklessStats.lLastWakeError = lWakeError;
+        xTicklessStats.lTickDrift += lWakeError;
+        xTicklessStats.ulTicksLost += ( uint32_t ) xTicksLost;
+    }
+
+#endif /* configUSE_TICKLESS_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_STATS == 1 )
+
+    void vTaskGetTicklessStats( TicklessStats_t * pxTicklessStats )
+    {
+        configASSERT( pxTicklessStats );
+
+        taskENTER_CRITICAL();
+        {
+            *pxTicklessStats = xTicklessStats;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_TICKLESS_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_STATS == 1 )
+
+    void vTaskResetTicklessStats( void )
+    {
+        taskENTER_CRITICAL();
+        {
+            const uint32_t ulWakeCompensation = xTicklessStats.ulWakeCompensation;
+
+            ( void ) memset( &xTicklessStats, 0x00, sizeof( xTicklessStats ) );
+            xTicklessStats.ulWakeCompensation = ulWakeCompensation;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_TICKLESS_STATS */
+/*-----------------------------------------------------------*/
+
 #if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
 
     void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet,
@@ -3663,8 +4356,6 @@ static void prvInitialiseTaskLists( void )
         vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
     }
 
-    vListInitialise( &xDelayedTaskList1 );
-    vListInitialise( &xDelayedTaskList2 );
     vListInitialise( &xPendingReadyList );
 
     #if ( INCLUDE_vTaskDelete == 1 )
@@ -3679,10 +4370,42 @@ static void prvInitialiseTaskLists( void )
     }
     #endif /* INCLUDE_vTaskSuspend */
 
-    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-     * using list2. */
-    pxDelayedTaskList = &xDelayedTaskList1;
-    pxOverflowDelayedTaskList = &xDelayedTaskList2;
+    #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+    {
+        vListInitialise( &xDelayedTaskList1 );
+        vListInitialise( &xDelayedTaskList2 );
+
+        /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+         * using list2. */
+        pxDelayedTaskList = &xDelayedTaskList1;
+        pxOverflowDelayedTaskList = &xDelayedTaskList2;
+    }
+    #else
+    {
+        UBaseType_t uxWheel, uxLevel, uxSlot;
+
+        for( uxWheel = 0U; uxWheel < ( UBaseType_t ) 2U; uxWheel++ )
+        {
+            for( uxLevel = 0U; uxLevel < ( UBaseType_t ) taskDELAY_WHEEL_LEVELS; uxLevel++ )
+            {
+                for( uxSlot = 0U; uxSlot < taskDELAY_WHEEL_SLOTS; uxSlot++ )
+                {
+                    vListInitialise( &( xDelayedTaskWheels[ uxWheel ].xSlots[ uxLevel ][ uxSlot ] ) );
+                }
+
+                xDelayedTaskWheels[ uxWheel ].ulOccupied[ uxLevel ] = 0UL;
+            }
+
+            xDelayedTaskWheels[ uxWheel ].xWheelTime = xTickCount;
+        }
+
+        /* The overflow wheel always starts from the tick count that follows
+         * the overflow. */
+        pxDelayedTaskWheel = &( xDelayedTaskWheels[ 0 ] );
+        pxOverflowDelayedTaskWheel = &( xDelayedTaskWheels[ 1 ] );
+        pxOverflowDelayedTaskWheel->xWheelTime = ( TickType_t ) 0U;
+    }
+    #endif /* configUSE_DELAYED_TASK_WHEEL */
 }
 /*-----------------------------------------------------------*/
 
@@ -3941,6 +4664,148 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_uxTaskGetStackHighWaterMark */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_STACK_SAMPLER == 1 )
+
+    static void prvStackSamplerStep( void )
+    {
+        TCB_t * pxTCB;
+        StackType_t * pxWord;
+        StackType_t xFillWord;
+        UBaseType_t uxBudget = ( UBaseType_t ) configSTACK_SAMPLER_WORDS_PER_STEP;
+
+        ( void ) memset( ( void * ) &xFillWord, ( int ) tskSTACK_FILL_BYTE, sizeof( xFillWord ) );
+
+        /* Stop other tasks running, and so being deleted, while their stack is
+         * examined.  Interrupts remain enabled. */
+        vTaskSuspendAll();
+        {
+            if( pxStackSamplerTCB == NULL )
+            {
+                pxStackSamplerTCB = pxStackSamplerTasks;
+            }
+
+            pxTCB = pxStackSamplerTCB;
+
+            if( pxTCB != NULL )
+            {
+                pxWord = pxTCB->pxStackSampleCursor;
+
+                while( ( pxWord != pxTCB->pxStackSampleLimit ) && ( *pxWord == xFillWord ) && ( uxBudget > ( UBaseType_t ) 0U ) )
+                {
+                    pxWord -= portSTACK_GROWTH;
+                    uxBudget--;
+                }
+
+                if( ( pxWord == pxTCB->pxStackSampleLimit ) || ( *pxWord != xFillWord ) )
+                {
+                    /* The pass is complete.  The stack never shrinks back
+                     * below its deepest point, so the next pass need only scan
+                     * up to the word found here. */
+                    taskENTER_CRITICAL();
+                    {
+                        pxTCB->pxStackSampleLimit = pxWord;
+                        pxTCB->pxStackSampleCursor = taskSTACK_SAMPLE_START( pxTCB );
+                        pxTCB->ulStackSamplePasses++;
+                    }
+                    taskEXIT_CRITICAL();
+
+                    pxStackSamplerTCB = pxTCB->pxStackSamplerNext;
+                }
+                else
+                {
+                    /* Out of budget - carry on from here next time. */
+                    pxTCB->pxStackSampleCursor = pxWord;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        ( void ) xTaskResumeAll();
+    }
+
+#endif /* configUSE_STACK_SAMPLER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STACK_SAMPLER == 1 )
+
+    static void prvStackSamplerRemoveTask( TCB_t * pxTCB )
+    {
+        TCB_t ** ppxLink = &pxStackSamplerTasks;
+
+        while( ( *ppxLink != NULL ) && ( *ppxLink != pxTCB ) )
+        {
+            ppxLink = &( ( *ppxLink )->pxStackSamplerNext );
+        }
+
+        if( *ppxLink != NULL )
+        {
+            *ppxLink = pxTCB->pxStackSamplerNext;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pxStackSamplerTCB == pxTCB )
+        {
+            pxStackSamplerTCB = pxTCB->pxStackSamplerNext;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_STACK_SAMPLER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STACK_SAMPLER == 1 )
+
+    BaseType_t xTaskGetStackSample( TaskHandle_t xTask,
+                                    TaskStackSample_t * pxSample )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xReturn;
+
+        configASSERT( pxSample );
+
+        /* Only cached values are read, so this never scans the stack. */
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            pxSample->uxHighWaterMark = taskSTACK_SAMPLE_FREE_WORDS( pxTCB, pxTCB->pxStackSampleLimit );
+            pxSample->ulPasses = pxTCB->ulStackSamplePasses;
+
+            #if ( configSTACK_SAMPLER_RECORD_SWITCH_SP == 1 )
+            {
+                pxSample->uxSwitchHighWaterMark = taskSTACK_SAMPLE_FREE_WORDS( pxTCB, pxTCB->pxStackDeepestSwitchSP );
+            }
+            #else
+            {
+                pxSample->uxSwitchHighWaterMark = ( configSTACK_DEPTH_TYPE ) 0;
+            }
+            #endif
+
+            if( pxTCB->ulStackSamplePasses != 0UL )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_STACK_SAMPLER */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskDelete == 1 )
 
     static void prvDeleteTCB( TCB_t * pxTCB )
@@ -3978,43 +4843,229 @@ static void prvCheckTasksWaitingTermination( void )
             }
             else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
             {
-                /* Only the stack was statically allocated, so the TCB is the
-                 * only memory that must be freed. */
-                vPortFree( pxTCB );
+                /* Only the stack was statically allocated, so the TCB is the
+                 * only memory that must be freed. */
+                vPortFree( pxTCB );
+            }
+            else
+            {
+                /* Neither the stack nor the TCB were allocated dynamically, so
+                 * nothing needs to be freed. */
+                configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB );
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+    }
+
+#endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+
+    static void prvResetNextTaskUnblockTime( void )
+    {
+        if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+        {
+            /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+             * the maximum possible value so it is  extremely unlikely that the
+             * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+             * there is an item in the delayed list. */
+            xNextTaskUnblockTime = portMAX_DELAY;
+        }
+        else
+        {
+            /* The new current delayed list is not empty, get the value of
+             * the item at the head of the delayed list.  This is the time at
+             * which the task at the head of the delayed list should be removed
+             * from the Blocked state. */
+            xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        }
+    }
+
+#else /* configUSE_DELAYED_TASK_WHEEL */
+
+    static void prvResetNextTaskUnblockTime( void )
+    {
+        DelayedTaskWheel_t * const pxWheel = pxDelayedTaskWheel;
+        const TickType_t xWheelTime = pxWheel->xWheelTime;
+        UBaseType_t uxLevel, uxSlot, uxShift;
+        uint32_t ulPending;
+        BaseType_t xFound = pdFALSE;
+
+        /* If the wheel is empty set xNextTaskUnblockTime to the maximum possible
+         * value so it is extremely unlikely that the
+         * if( xTickCount >= xNextTaskUnblockTime ) test will pass until there
+         * is a task in the wheel. */
+        xNextTaskUnblockTime = portMAX_DELAY;
+
+        /* Every task in level 0 wakes before any task in level 1 has to be
+         * moved down, and so on, so the first occupied slot in level order
+         * holds the next time at which the wheel must be looked at.  Within a
+         * level no slot before the one indexed by the wheel time can be
+         * occupied.  The search is bounded by the size of the wheel, not by the
+         * number of Blocked tasks. */
+        for( uxLevel = 0U; ( uxLevel < ( UBaseType_t ) taskDELAY_WHEEL_LEVELS ) && ( xFound == pdFALSE ); uxLevel++ )
+        {
+            uxShift = uxLevel * ( UBaseType_t ) configDELAYED_TASK_WHEEL_SLOT_BITS;
+            uxSlot = ( UBaseType_t ) ( ( xWheelTime >> uxShift ) & taskDELAY_WHEEL_SLOT_MASK );
+            ulPending = pxWheel->ulOccupied[ uxLevel ] & ( ~0UL << uxSlot );
+
+            while( ( ulPending != 0UL ) && ( xFound == pdFALSE ) )
+            {
+                if( ( ulPending & ( 1UL << uxSlot ) ) == 0UL )
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+                else if( listLIST_IS_EMPTY( &( pxWheel->xSlots[ uxLevel ][ uxSlot ] ) ) != pdFALSE )
+                {
+                    /* The tasks that were in this slot left the Blocked state
+                     * for another reason. */
+                    pxWheel->ulOccupied[ uxLevel ] &= ~( 1UL << uxSlot );
+                }
+                else
+                {
+                    xNextTaskUnblockTime = ( TickType_t ) ( ( ( xWheelTime >> uxShift ) >> configDELAYED_TASK_WHEEL_SLOT_BITS ) << configDELAYED_TASK_WHEEL_SLOT_BITS );
+                    xNextTaskUnblockTime = ( TickType_t ) ( ( xNextTaskUnblockTime | ( TickType_t ) uxSlot ) << uxShift );
+                    xFound = pdTRUE;
+                }
+
+                ulPending &= ~( 1UL << uxSlot );
+                uxSlot++;
+            }
+        }
+    }
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+    static TickType_t prvInsertTaskInDelayedTaskWheel( DelayedTaskWheel_t * const pxWheel,
+                                                       ListItem_t * const pxListItem )
+    {
+        const TickType_t xTimeToWake = listGET_LIST_ITEM_VALUE( pxListItem );
+        TickType_t xDifference = ( TickType_t ) ( xTimeToWake ^ pxWheel->xWheelTime );
+        UBaseType_t uxLevel = 0U, uxShift = 0U, uxSlot;
+
+        /* Select the level from the most significant group of bits in which the
+         * wake time differs from the wheel time. */
+        xDifference >>= configDELAYED_TASK_WHEEL_SLOT_BITS;
+
+        while( xDifference != ( TickType_t ) 0U )
+        {
+            uxLevel++;
+            uxShift += ( UBaseType_t ) configDELAYED_TASK_WHEEL_SLOT_BITS;
+            xDifference >>= configDELAYED_TASK_WHEEL_SLOT_BITS;
+        }
+
+        uxSlot = ( UBaseType_t ) ( ( xTimeToWake >> uxShift ) & taskDELAY_WHEEL_SLOT_MASK );
+
+        /* Inserting at the end keeps tasks that wake at the same time in the
+         * order in which they entered the Blocked state, as vListInsert()
+         * does. */
+        listINSERT_END( &( pxWheel->xSlots[ uxLevel ][ uxSlot ] ), pxListItem );
+        pxWheel->ulOccupied[ uxLevel ] |= ( 1UL << uxSlot );
+
+        return ( TickType_t ) ( ( xTimeToWake >> uxShift ) << uxShift );
+    }
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+    static List_t * prvAdvanceDelayedTaskWheel( const TickType_t xNewTime )
+    {
+        DelayedTaskWheel_t * const pxWheel = pxDelayedTaskWheel;
+        UBaseType_t uxLevel, uxSlot;
+        List_t * pxSlot;
+        ListItem_t * pxListItem;
+
+        pxWheel->xWheelTime = xNewTime;
+
+        /* Any higher level slot indexed by the new wheel time can only hold
+         * tasks if the wheel time has just reached the start of that slot.
+         * Working from the top level down means a task that moves down more
+         * than one level is handled in this pass too.  Each task can only move
+         * down a bounded number of times between entering and leaving the
+         * Blocked state. */
+        for( uxLevel = ( UBaseType_t ) taskDELAY_WHEEL_LEVELS - 1U; uxLevel > 0U; uxLevel-- )
+        {
+            uxSlot = ( UBaseType_t ) ( ( xNewTime >> ( uxLevel * ( UBaseType_t ) configDELAYED_TASK_WHEEL_SLOT_BITS ) ) & taskDELAY_WHEEL_SLOT_MASK );
+
+            if( ( pxWheel->ulOccupied[ uxLevel ] & ( 1UL << uxSlot ) ) != 0UL )
+            {
+                pxSlot = &( pxWheel->xSlots[ uxLevel ][ uxSlot ] );
+                pxWheel->ulOccupied[ uxLevel ] &= ~( 1UL << uxSlot );
+
+                while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+                {
+                    pxListItem = listGET_HEAD_ENTRY( pxSlot );
+                    listREMOVE_ITEM( pxListItem );
+                    ( void ) prvInsertTaskInDelayedTaskWheel( pxWheel, pxListItem );
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return &( pxWheel->xSlots[ 0 ][ xNewTime & taskDELAY_WHEEL_SLOT_MASK ] );
+    }
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_DELAYED_TASK_WHEEL == 1 ) && ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) ) )
+
+    static BaseType_t prvListIsDelayedTaskWheelSlot( const List_t * const pxList )
+    {
+        BaseType_t xReturn = pdFALSE;
+        UBaseType_t uxWheel;
+
+        for( uxWheel = 0U; uxWheel < ( UBaseType_t ) 2U; uxWheel++ )
+        {
+            if( ( ( portPOINTER_SIZE_TYPE ) pxList >= ( portPOINTER_SIZE_TYPE ) &( xDelayedTaskWheels[ uxWheel ].xSlots[ 0 ][ 0 ] ) ) &&
+                ( ( portPOINTER_SIZE_TYPE ) pxList <= ( portPOINTER_SIZE_TYPE ) &( xDelayedTaskWheels[ uxWheel ].xSlots[ taskDELAY_WHEEL_LEVELS - 1U ][ taskDELAY_WHEEL_SLOTS - 1U ] ) ) )
+            {
+                xReturn = pdTRUE;
             }
             else
             {
-                /* Neither the stack nor the TCB were allocated dynamically, so
-                 * nothing needs to be freed. */
-                configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB );
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+        return xReturn;
     }
 
-#endif /* INCLUDE_vTaskDelete */
+#endif /* ( ( configUSE_DELAYED_TASK_WHEEL == 1 ) && ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) ) ) */
 /*-----------------------------------------------------------*/
 
-static void prvResetNextTaskUnblockTime( void )
-{
-    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-    {
-        /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-         * the maximum possible value so it is  extremely unlikely that the
-         * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-         * there is an item in the delayed list. */
-        xNextTaskUnblockTime = portMAX_DELAY;
-    }
-    else
+#if ( ( configUSE_DELAYED_TASK_WHEEL == 1 ) && ( configASSERT_DEFINED == 1 ) )
+
+    static BaseType_t prvDelayedTaskWheelIsEmpty( const DelayedTaskWheel_t * const pxWheel )
     {
-        /* The new current delayed list is not empty, get the value of
-         * the item at the head of the delayed list.  This is the time at
-         * which the task at the head of the delayed list should be removed
-         * from the Blocked state. */
-        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        BaseType_t xReturn = pdTRUE;
+        UBaseType_t uxLevel, uxSlot;
+
+        for( uxLevel = 0U; uxLevel < ( UBaseType_t ) taskDELAY_WHEEL_LEVELS; uxLevel++ )
+        {
+            for( uxSlot = 0U; uxSlot < taskDELAY_WHEEL_SLOTS; uxSlot++ )
+            {
+                if( listLIST_IS_EMPTY( &( pxWheel->xSlots[ uxLevel ][ uxSlot ] ) ) == pdFALSE )
+                {
+                    xReturn = pdFALSE;
+                }
+            }
+        }
+
+        return xReturn;
     }
-}
+
+#endif /* ( ( configUSE_DELAYED_TASK_WHEEL == 1 ) && ( configASSERT_DEFINED == 1 ) ) */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
@@ -4338,6 +5389,157 @@ static void prvResetNextTaskUnblockTime( void )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+
+    static void prvSetCurrentTaskPriority( UBaseType_t uxNewPriority )
+    {
+        /* The running task is always in the ready list for its priority, so
+         * it can be moved without first checking which list it is in. */
+        if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+        {
+            portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceTASK_PRIORITY_CEILING( pxCurrentTCB, uxNewPriority );
+        pxCurrentTCB->uxPriority = uxNewPriority;
+
+        /* The event list item value cannot be in use for any other purpose
+         * while the task is running. */
+        listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+        prvAddTaskToReadyList( pxCurrentTCB );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority )
+    {
+        BaseType_t xReturn = pdPASS;
+
+        /* Record the ceiling so the priority can be restored correctly however
+         * the mutexes the task holds are given back.  The bitmap must be wide
+         * enough to hold a bit for every priority. */
+        configASSERT( uxCeilingPriority < ( UBaseType_t ) ( sizeof( UBaseType_t ) * ( size_t ) 8U ) );
+        configASSERT( pxCurrentTCB->ucCeilingMutexesHeld[ uxCeilingPriority ] < ( uint8_t ) 0xffU );
+        ( pxCurrentTCB->ucCeilingMutexesHeld[ uxCeilingPriority ] )++;
+        ( pxCurrentTCB->uxCeilingMutexesHeld )++;
+        taskRECORD_CEILING_PRIORITY( uxCeilingPriority, pxCurrentTCB->uxCeilingPrioritiesHeld );
+
+        /* Raising the priority of the running task can never require a
+         * context switch, and no other task is involved. */
+        if( pxCurrentTCB->uxPriority < uxCeilingPriority )
+        {
+            prvSetCurrentTaskPriority( uxCeilingPriority );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Only the priority assigned to the task can violate the ceiling - a
+         * priority raised by another mutex the task holds does not. */
+        if( pxCurrentTCB->uxBasePriority > uxCeilingPriority )
+        {
+            xReturn = pdFAIL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTaskPriorityRestoreFromCeiling( TaskHandle_t const pxMutexHolder,
+                                                UBaseType_t uxCeilingPriority )
+    {
+        TCB_t * const pxTCB = pxMutexHolder;
+        UBaseType_t uxPriorityToUse, uxHighestCeiling;
+        BaseType_t xReturn = pdFALSE;
+
+        /* pxMutexHolder is NULL when the mutex is given for the first time as
+         * it is created. */
+        if( pxMutexHolder != NULL )
+        {
+            configASSERT( pxTCB == pxCurrentTCB );
+            configASSERT( pxTCB->uxMutexesHeld );
+            configASSERT( pxTCB->ucCeilingMutexesHeld[ uxCeilingPriority ] );
+            ( pxTCB->uxMutexesHeld )--;
+            ( pxTCB->uxCeilingMutexesHeld )--;
+            ( pxTCB->ucCeilingMutexesHeld[ uxCeilingPriority ] )--;
+
+            if( pxTCB->ucCeilingMutexesHeld[ uxCeilingPriority ] == ( uint8_t ) 0U )
+            {
+                taskRESET_CEILING_PRIORITY( uxCeilingPriority, pxTCB->uxCeilingPrioritiesHeld );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The task must run at no less than the highest ceiling of the
+             * ceiling mutexes it still holds, whatever order they were taken
+             * and given back in. */
+            uxPriorityToUse = pxTCB->uxBasePriority;
+
+            if( pxTCB->uxCeilingPrioritiesHeld != ( UBaseType_t ) 0U )
+            {
+                taskGET_HIGHEST_CEILING_PRIORITY( uxHighestCeiling, pxTCB->uxCeilingPrioritiesHeld );
+
+                if( uxHighestCeiling > uxPriorityToUse )
+                {
+                    uxPriorityToUse = uxHighestCeiling;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pxTCB->uxMutexesHeld > pxTCB->uxCeilingMutexesHeld )
+            {
+                /* The task also holds a standard mutex, so may have inherited
+                 * a priority through it.  As with xTaskPriorityDisinherit(),
+                 * leave the priority where it is until that mutex is given
+                 * back. */
+                uxPriorityToUse = pxTCB->uxPriority;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( uxPriorityToUse < pxTCB->uxPriority )
+            {
+                prvSetCurrentTaskPriority( uxPriorityToUse );
+
+                /* A task of a priority between the old and new priorities
+                 * might now be able to run. */
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_PRIORITY_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if ( portCRITICAL_NESTING_IN_TCB == 1 )
 
     void vTaskEnterCritical( void )
@@ -4917,6 +6119,8 @@ TickType_t uxTaskResetEventItemValue( void )
 
             traceTASK_NOTIFY( uxIndexToNotify );
 
+            taskNOTIFY_WAIT_OBJECT_INDEX( pxTCB, uxIndexToNotify, ucOriginalNotifyState );
+
             /* If the task is in the blocked state specifically to wait for a
              * notification then unblock it now. */
             if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
@@ -5059,6 +6263,8 @@ TickType_t uxTaskResetEventItemValue( void )
 
             traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify );
 
+            taskNOTIFY_WAIT_OBJECT_INDEX( pxTCB, uxIndexToNotify, ucOriginalNotifyState );
+
             /* If the task is in the blocked state specifically to wait for a
              * notification then unblock it now. */
             if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
@@ -5150,6 +6356,8 @@ TickType_t uxTaskResetEventItemValue( void )
 
             traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify );
 
+            taskNOTIFY_WAIT_OBJECT_INDEX( pxTCB, uxIndexToNotify, ucOriginalNotifyState );
+
             /* If the task is in the blocked state specifically to wait for a
              * notification then unblock it now. */
             if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
@@ -5257,6 +6465,48 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_WAIT_OBJECTS == 1 )
+
+    void vTaskSetWaitObjectNotifyMask( UBaseType_t uxIndexMask )
+    {
+        taskENTER_CRITICAL();
+        {
+            pxCurrentTCB->uxWaitObjectNotifyMask = uxIndexMask;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_WAIT_OBJECTS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAIT_OBJECTS == 1 )
+
+    UBaseType_t uxTaskGetNotifyPendingMask( void )
+    {
+        UBaseType_t uxIndex, uxReturn = 0;
+
+        taskENTER_CRITICAL();
+        {
+            for( uxIndex = 0; uxIndex < configTASK_NOTIFICATION_ARRAY_ENTRIES; uxIndex++ )
+            {
+                if( pxCurrentTCB->ucNotifyState[ uxIndex ] == taskNOTIFICATION_RECEIVED )
+                {
+                    uxReturn |= ( UBaseType_t ) 1U << uxIndex;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return uxReturn;
+    }
+
+#endif /* configUSE_WAIT_OBJECTS */
+/*-----------------------------------------------------------*/
+
 #if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
 
     configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
@@ -5294,12 +6544,167 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_RUN_TIME_HISTOGRAMS == 1 )
+
+    static UBaseType_t prvGetRunTimeHistogramBucket( configRUN_TIME_COUNTER_TYPE ulPeriod )
+    {
+        uint32_t ulBits;
+        UBaseType_t uxBucket = ( UBaseType_t ) 0U;
+
+        /* Periods that do not fit in 32 bits always fall in the last bucket.
+         * The shift is split in two so it is valid for a 32-bit counter. */
+        if( ( ( ulPeriod >> 16 ) >> 16 ) != ( configRUN_TIME_COUNTER_TYPE ) 0 )
+        {
+            ulBits = 0xFFFFFFFFUL;
+        }
+        else
+        {
+            ulBits = ( uint32_t ) ulPeriod;
+        }
+
+        /* Find the most significant set bit with a fixed number of steps so
+         * the time taken does not depend on the period. */
+        if( ulBits >= 0x10000UL )
+        {
+            ulBits >>= 16;
+            uxBucket += ( UBaseType_t ) 16U;
+        }
+
+        if( ulBits >= 0x100UL )
+        {
+            ulBits >>= 8;
+            uxBucket += ( UBaseType_t ) 8U;
+        }
+
+        if( ulBits >= 0x10UL )
+        {
+            ulBits >>= 4;
+            uxBucket += ( UBaseType_t ) 4U;
+        }
+
+        if( ulBits >= 0x4UL )
+        {
+            ulBits >>= 2;
+            uxBucket += ( UBaseType_t ) 2U;
+        }
+
+        if( ulBits >= 0x2UL )
+        {
+            uxBucket += ( UBaseType_t ) 1U;
+        }
+
+        if( uxBucket >= ( UBaseType_t ) configRUN_TIME_HISTOGRAM_BUCKETS )
+        {
+            uxBucket = ( UBaseType_t ) configRUN_TIME_HISTOGRAM_BUCKETS - ( UBaseType_t ) 1U;
+        }
+
+        return uxBucket;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvUpdateRunTimeHistograms( TCB_t * const pxOutgoingTCB )
+    {
+        configRUN_TIME_COUNTER_TYPE ulPeriod;
+
+        /* ulTotalRunTime was updated by vTaskSwitchContext() immediately
+         * before this function was called.  As with the run time counters the
+         * guards are against suspect counter implementations. */
+        if( ulTotalRunTime > ulRunSliceStartTime )
+        {
+            ulPeriod = ulTotalRunTime - ulRunSliceStartTime;
+        }
+        else
+        {
+            ulPeriod = 0;
+        }
+
+        pxOutgoingTCB->uxHistogramSequence++;
+        portMEMORY_BARRIER();
+        ( pxOutgoingTCB->ulRunSliceHistogram[ prvGetRunTimeHistogramBucket( ulPeriod ) ] )++;
+        portMEMORY_BARRIER();
+        pxOutgoingTCB->uxHistogramSequence++;
+
+        /* If the outgoing task is still in the Ready state it was preempted
+         * or yielded, so starts waiting to run again now.  If it blocked, the
+         * time is overwritten when it next enters the Ready state. */
+        pxOutgoingTCB->ulReadyTime = ulTotalRunTime;
+
+        if( ulTotalRunTime > pxCurrentTCB->ulReadyTime )
+        {
+            ulPeriod = ulTotalRunTime - pxCurrentTCB->ulReadyTime;
+        }
+        else
+        {
+            ulPeriod = 0;
+        }
+
+        pxCurrentTCB->uxHistogramSequence++;
+        portMEMORY_BARRIER();
+        ( pxCurrentTCB->ulReadyLatencyHistogram[ prvGetRunTimeHistogramBucket( ulPeriod ) ] )++;
+        portMEMORY_BARRIER();
+        pxCurrentTCB->uxHistogramSequence++;
+
+        ulRunSliceStartTime = ulTotalRunTime;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskGetRunTimeHistogram( TaskHandle_t xTask,
+                                   TaskHistogram_t * pxHistogram )
+    {
+        const TCB_t * pxTCB;
+        UBaseType_t uxSequence;
+
+        configASSERT( pxHistogram );
+
+        /* If null is passed in here then the histogram of the calling task is
+         * being queried. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        /* The histograms are only written by the context switch, which
+         * increments the sequence count before and after each update.  Copy
+         * them until a copy is made that no update overlapped, rather than
+         * suspending the scheduler or masking interrupts while copying. */
+        do
+        {
+            uxSequence = pxTCB->uxHistogramSequence;
+            portMEMORY_BARRIER();
+            ( void ) memcpy( ( void * ) pxHistogram->ulRunSlice, ( const void * ) pxTCB->ulRunSliceHistogram, sizeof( pxHistogram->ulRunSlice ) );
+            ( void ) memcpy( ( void * ) pxHistogram->ulReadyLatency, ( const void * ) pxTCB->ulReadyLatencyHistogram, sizeof( pxHistogram->ulReadyLatency ) );
+            portMEMORY_BARRIER();
+        } while( ( ( uxSequence & ( UBaseType_t ) 1U ) != ( UBaseType_t ) 0U ) ||
+                 ( uxSequence != pxTCB->uxHistogramSequence ) );
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskGetCoreRunTime( CoreRunTime_t * pxCoreRunTime )
+    {
+        UBaseType_t uxSequence;
+
+        configASSERT( pxCoreRunTime );
+
+        do
+        {
+            uxSequence = uxCoreRunTimeSequence;
+            portMEMORY_BARRIER();
+            *pxCoreRunTime = xCoreRunTime;
+            portMEMORY_BARRIER();
+        } while( ( ( uxSequence & ( UBaseType_t ) 1U ) != ( UBaseType_t ) 0U ) ||
+                 ( uxSequence != uxCoreRunTimeSequence ) );
+    }
+
+#endif /* configUSE_RUN_TIME_HISTOGRAMS */
+/*-----------------------------------------------------------*/
+
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                             const BaseType_t xCanBlockIndefinitely )
 {
     TickType_t xTimeToWake;
     const TickType_t xConstTickCount = xTickCount;
 
+    /* eTaskGetState() reports a task that is waiting for an event, even
+     * indefinitely, as Blocked rather than Suspended. */
+    taskSET_KERNEL_DATA_STATE( pxCurrentTCB, eBlocked );
+
     #if ( INCLUDE_xTaskAbortDelay == 1 )
     {
         /* About to enter a delayed list, so ensure the ucDelayAborted flag is
@@ -5345,13 +6750,36 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
             {
                 /* Wake time has overflowed.  Place this item in the overflow
                  * list. */
-                vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+                {
+                    vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                }
+                #else
+                {
+                    ( void ) prvInsertTaskInDelayedTaskWheel( pxOverflowDelayedTaskWheel, &( pxCurrentTCB->xStateListItem ) );
+                }
+                #endif
             }
             else
             {
                 /* The wake time has not overflowed, so the current block list
                  * is used. */
-                vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+                {
+                    vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                }
+                #else
+                {
+                    /* No part of the wheel needs looking at before the next
+                     * tick, so the wheel can be moved straight to the current
+                     * time, which places the task in as low a level as
+                     * possible.  xTimeToWake then becomes the time at which
+                     * the tick interrupt must look at the slot the task was
+                     * placed in, which is no later than its wake time. */
+                    pxDelayedTaskWheel->xWheelTime = xConstTickCount;
+                    xTimeToWake = prvInsertTaskInDelayedTaskWheel( pxDelayedTaskWheel, &( pxCurrentTCB->xStateListItem ) );
+                }
+                #endif
 
                 /* If the task entering the blocked state was placed at the
                  * head of the list of blocked tasks then xNextTaskUnblockTime
@@ -5380,12 +6808,31 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
         if( xTimeToWake < xConstTickCount )
         {
             /* Wake time has overflowed.  Place this item in the overflow list. */
-            vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+            {
+                vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            }
+            #else
+            {
+                ( void ) prvInsertTaskInDelayedTaskWheel( pxOverflowDelayedTaskWheel, &( pxCurrentTCB->xStateListItem ) );
+            }
+            #endif
         }
         else
         {
             /* The wake time has not overflowed, so the current block list is used. */
-            vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+            {
+                vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            }
+            #else
+            {
+                /* As above, move the wheel to the current time, then record
+                 * when the tick interrupt must look at the task's slot. */
+                pxDelayedTaskWheel->xWheelTime = xConstTickCount;
+                xTimeToWake = prvInsertTaskInDelayedTaskWheel( pxDelayedTaskWheel, &( pxCurrentTCB->xStateListItem ) );
+            }
+            #endif
 
             /* If the task entering the blocked state was placed at the head of the
              * list of blocked tasks then xNextTaskUnblockTime needs to be updated
@@ -71,6 +71,17 @@
     #define tmrSTATUS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 0x02 )
     #define tmrSTATUS_IS_AUTORELOAD              ( ( uint8_t ) 0x04 )
 
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/* Geometry of the timing wheel.  Level n of the wheel is indexed by the nth
+ * group of configTIMER_WHEEL_SLOT_BITS bits of a timer's expiry time, so
+ * enough levels are provided to cover every bit of TickType_t. */
+        #define tmrWHEEL_SLOTS        ( ( UBaseType_t ) 1U << configTIMER_WHEEL_SLOT_BITS )
+        #define tmrWHEEL_SLOT_MASK    ( ( TickType_t ) tmrWHEEL_SLOTS - ( TickType_t ) 1U )
+        #define tmrWHEEL_LEVELS       ( ( ( sizeof( TickType_t ) * ( size_t ) 8U ) + ( size_t ) configTIMER_WHEEL_SLOT_BITS - ( size_t ) 1U ) / ( size_t ) configTIMER_WHEEL_SLOT_BITS )
+
+    #endif /* configUSE_TIMER_WHEEL */
+
 /* The definition of the timers themselves. */
     typedef struct tmrTimerControl                  /* The old naming convention is used to prevent breaking kernel aware debuggers. */
     {
@@ -134,10 +145,26 @@
  * xActiveTimerList1 and xActiveTimerList2 could be at function scope but that
  * breaks some kernel aware debuggers, and debuggers that reply on removing the
  * static qualifier. */
-    PRIVILEGED_DATA static List_t xActiveTimerList1;
-    PRIVILEGED_DATA static List_t xActiveTimerList2;
-    PRIVILEGED_DATA static List_t * pxCurrentTimerList;
-    PRIVILEGED_DATA static List_t * pxOverflowTimerList;
+    #if ( configUSE_TIMER_WHEEL == 0 )
+        PRIVILEGED_DATA static List_t xActiveTimerList1;
+        PRIVILEGED_DATA static List_t xActiveTimerList2;
+        PRIVILEGED_DATA static List_t * pxCurrentTimerList;
+        PRIVILEGED_DATA static List_t * pxOverflowTimerList;
+    #else
+
+/* When the timing wheel is used, timers that expire before the tick count
+ * next overflows are referenced from a slot of xTimerWheel, and timers that
+ * expire after the tick count overflows are referenced, unsorted, from
+ * xOverflowTimerList.  A timer is held in the level selected by the most
+ * significant group of bits in which its expiry time differs from
+ * xTimerWheelTime, so the nearest expiry times are always held in level 0.
+ * ulTimerWheelOccupied has one bit set for each slot that is not empty. */
+        PRIVILEGED_DATA static List_t xTimerWheel[ tmrWHEEL_LEVELS ][ tmrWHEEL_SLOTS ];
+        PRIVILEGED_DATA static uint32_t ulTimerWheelOccupied[ tmrWHEEL_LEVELS ];
+        PRIVILEGED_DATA static TickType_t xTimerWheelTime = ( TickType_t ) 0U;
+        PRIVILEGED_DATA static List_t xOverflowTimerList;
+        PRIVILEGED_DATA static List_t * const pxOverflowTimerList = &xOverflowTimerList;
+    #endif /* configUSE_TIMER_WHEEL */
 
 /* A queue that is used to send commands to the timer service task. */
     PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
@@ -175,6 +202,34 @@
                                                   const TickType_t xTimeNow,
                                                   const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
 
+/*
+ * Remove the timer from whichever active timer list or timing wheel slot is
+ * referencing it.
+ */
+    static void prvRemoveTimerFromActiveList( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/*
+ * Place the timer in the timing wheel slot selected by its expiry time relative
+ * to xTimerWheelTime.  The expiry time must not be before xTimerWheelTime.
+ */
+        static void prvInsertTimerInWheel( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move the timing wheel forward to xNewTime, redistributing the timers held in
+ * any higher level slot that xNewTime has reached into the lower levels.
+ * Returns the level 0 slot that holds timers that expire at xNewTime.
+ */
+        static List_t * prvAdvanceTimerWheel( const TickType_t xNewTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if no timers are referenced from the timing wheel.
+ */
+        static BaseType_t prvTimerWheelIsEmpty( void ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_TIMER_WHEEL */
+
 /*
  * Reload the specified auto-reload timer.  If the reloading is backlogged,
  * clear the backlog, calling the callback for each additional reload.  When
@@ -538,31 +593,94 @@
     }
 /*-----------------------------------------------------------*/
 
-    static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
-                                        const TickType_t xTimeNow )
-    {
-        Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+    #if ( configUSE_TIMER_WHEEL == 0 )
 
-        /* Remove the timer from the list of active timers.  A check has already
-         * been performed to ensure the list is not empty. */
+        static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
+                                            const TickType_t xTimeNow )
+        {
+            Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
-        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+            /* Remove the timer from the list of active timers.  A check has already
+             * been performed to ensure the list is not empty. */
 
-        /* If the timer is an auto-reload timer then calculate the next
-         * expiry time and re-insert the timer in the list of active timers. */
-        if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
-        {
-            prvReloadTimer( pxTimer, xNextExpireTime, xTimeNow );
+            ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+
+            /* If the timer is an auto-reload timer then calculate the next
+             * expiry time and re-insert the timer in the list of active timers. */
+            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+            {
+                prvReloadTimer( pxTimer, xNextExpireTime, xTimeNow );
+            }
+            else
+            {
+                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+            }
+
+            /* Call the timer callback. */
+            traceTIMER_EXPIRED( pxTimer );
+            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
         }
-        else
+
+    #else /* configUSE_TIMER_WHEEL */
+
+        static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
+                                            const TickType_t xTimeNow )
         {
-            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+            Timer_t * pxTimer;
+            TickType_t xExpiredTime = xNextExpireTime;
+            BaseType_t xWheelWasEmpty = pdFALSE;
+            List_t * pxSlot = prvAdvanceTimerWheel( xExpiredTime );
+
+            /* xNextExpireTime is either the expiry time of the timers in a level 0
+             * slot, or the start of a higher level slot whose timers have just
+             * been moved down to the lower levels.  In the latter case keep moving
+             * the wheel forward until either a timer that has expired is found,
+             * or it is found that no timer has expired yet.  Each step moves the
+             * timers in one slot down at least one level, so the number of steps
+             * is bounded by the number of levels. */
+            while( ( listLIST_IS_EMPTY( pxSlot ) != pdFALSE ) && ( xWheelWasEmpty == pdFALSE ) )
+            {
+                xExpiredTime = prvGetNextExpireTime( &xWheelWasEmpty );
+
+                if( ( xWheelWasEmpty == pdFALSE ) && ( xExpiredTime <= xTimeNow ) )
+                {
+                    pxSlot = prvAdvanceTimerWheel( xExpiredTime );
+                }
+                else
+                {
+                    /* Nothing has expired yet. */
+                    xWheelWasEmpty = pdTRUE;
+                }
+            }
+
+            if( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+            {
+                pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                prvRemoveTimerFromActiveList( pxTimer );
+
+                /* If the timer is an auto-reload timer then calculate the next
+                 * expiry time and re-insert the timer in the timing wheel. */
+                if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+                {
+                    prvReloadTimer( pxTimer, xExpiredTime, xTimeNow );
+                }
+                else
+                {
+                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                }
+
+                /* Call the timer callback. */
+                traceTIMER_EXPIRED( pxTimer );
+                pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
 
-        /* Call the timer callback. */
-        traceTIMER_EXPIRED( pxTimer );
-        pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-    }
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     static portTASK_FUNCTION( prvTimerTask, pvParameters )
@@ -663,31 +781,133 @@
     }
 /*-----------------------------------------------------------*/
 
-    static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
-    {
-        TickType_t xNextExpireTime;
-
-        /* Timers are listed in expiry time order, with the head of the list
-         * referencing the task that will expire first.  Obtain the time at which
-         * the timer with the nearest expiry time will expire.  If there are no
-         * active timers then just set the next expire time to 0.  That will cause
-         * this task to unblock when the tick count overflows, at which point the
-         * timer lists will be switched and the next expiry time can be
-         * re-assessed.  */
-        *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+    #if ( configUSE_TIMER_WHEEL == 0 )
 
-        if( *pxListWasEmpty == pdFALSE )
+        static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            TickType_t xNextExpireTime;
+
+            /* Timers are listed in expiry time order, with the head of the list
+             * referencing the task that will expire first.  Obtain the time at which
+             * the timer with the nearest expiry time will expire.  If there are no
+             * active timers then just set the next expire time to 0.  That will cause
+             * this task to unblock when the tick count overflows, at which point the
+             * timer lists will be switched and the next expiry time can be
+             * re-assessed.  */
+            *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+
+            if( *pxListWasEmpty == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            }
+            else
+            {
+                /* Ensure the task unblocks when the tick count rolls over. */
+                xNextExpireTime = ( TickType_t ) 0U;
+            }
+
+            return xNextExpireTime;
         }
-        else
+
+    #else /* configUSE_TIMER_WHEEL */
+
+        static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
         {
-            /* Ensure the task unblocks when the tick count rolls over. */
-            xNextExpireTime = ( TickType_t ) 0U;
+            TickType_t xNextExpireTime = ( TickType_t ) 0U;
+            TickType_t xDigit;
+            UBaseType_t uxLevel, uxSlot = 0U, uxShift;
+            uint32_t ulPending = 0UL;
+
+            #if ( configUSE_TICKLESS_IDLE != 0 )
+                UBaseType_t uxNearestLevel = 0U;
+            #endif
+
+            /* Every timer in level 0 expires before any timer in level 1, every
+             * timer in level 1 expires before any timer in level 2, and so on, so
+             * the lowest occupied level holds the nearest expiry time.  Within a
+             * level no slot before the one indexed by xTimerWheelTime can be
+             * occupied.  The search is bounded by the size of the wheel, not by
+             * the number of active timers. */
+            for( uxLevel = 0U; ( uxLevel < ( UBaseType_t ) tmrWHEEL_LEVELS ) && ( ulPending == 0UL ); uxLevel++ )
+            {
+                uxShift = uxLevel * ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS;
+                xDigit = ( xTimerWheelTime >> uxShift ) & tmrWHEEL_SLOT_MASK;
+                ulPending = ulTimerWheelOccupied[ uxLevel ] & ( ~0UL << xDigit );
+
+                if( ulPending != 0UL )
+                {
+                    for( uxSlot = ( UBaseType_t ) xDigit; ( ulPending & ( 1UL << uxSlot ) ) == 0UL; uxSlot++ )
+                    {
+                    }
+
+                    /* A level 0 slot holds timers that all expire at the same
+                     * time.  A higher level slot holds timers that expire at or
+                     * after the start of the slot, which is when they must be
+                     * moved down to the lower levels. */
+                    xNextExpireTime = ( TickType_t ) ( ( ( xTimerWheelTime >> uxShift ) >> configTIMER_WHEEL_SLOT_BITS ) << configTIMER_WHEEL_SLOT_BITS );
+                    xNextExpireTime = ( TickType_t ) ( ( xNextExpireTime | ( TickType_t ) uxSlot ) << uxShift );
+
+                    #if ( configUSE_TICKLESS_IDLE != 0 )
+                    {
+                        uxNearestLevel = uxLevel;
+                    }
+                    #endif
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            #if ( configUSE_TICKLESS_IDLE != 0 )
+            {
+                const ListItem_t * pxItem;
+                const ListItem_t * pxEndMarker;
+                TickType_t xExpiryTime;
+
+                /* The start of a higher level slot is only a time at which its
+                 * timers are moved down, not a time at which a timer expires, so
+                 * waking then would bring the processor out of its low power
+                 * state for nothing.  When the tick can be suppressed return the
+                 * earliest expiry time in the slot instead, which costs one pass
+                 * over the timers in the slot.  prvAdvanceTimerWheel() moves the
+                 * timers in the slot down correctly when passed any time within
+                 * the slot, and no lower level slot is occupied. */
+                if( ( ulPending != 0UL ) && ( uxNearestLevel > 0U ) )
+                {
+                    pxEndMarker = listGET_END_MARKER( &( xTimerWheel[ uxNearestLevel ][ uxSlot ] ) );
+                    pxItem = listGET_HEAD_ENTRY( &( xTimerWheel[ uxNearestLevel ][ uxSlot ] ) );
+                    xNextExpireTime = listGET_LIST_ITEM_VALUE( pxItem );
+
+                    while( pxItem != pxEndMarker )
+                    {
+                        xExpiryTime = listGET_LIST_ITEM_VALUE( pxItem );
+
+                        if( xExpiryTime < xNextExpireTime )
+                        {
+                            xNextExpireTime = xExpiryTime;
+                        }
+
+                        pxItem = listGET_NEXT( pxItem );
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_TICKLESS_IDLE */
+
+            /* If the wheel is empty then just set the next expire time to 0.
+             * That will cause this task to unblock when the tick count overflows,
+             * at which point the overflowed timers will be moved into the wheel
+             * and the next expiry time can be re-assessed. */
+            *pxListWasEmpty = ( ulPending == 0UL ) ? pdTRUE : pdFALSE;
+
+            return xNextExpireTime;
         }
 
-        return xNextExpireTime;
-    }
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
@@ -735,7 +955,18 @@
             }
             else
             {
-                vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                #if ( configUSE_TIMER_WHEEL == 0 )
+                {
+                    vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                }
+                #else
+                {
+                    /* The overflow list is only walked when the tick count
+                     * overflows, at which point every timer it references is
+                     * moved into the wheel, so it does not need to be sorted. */
+                    vListInsertEnd( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                }
+                #endif /* configUSE_TIMER_WHEEL */
             }
         }
         else
@@ -749,7 +980,27 @@
             }
             else
             {
-                vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                #if ( configUSE_TIMER_WHEEL == 0 )
+                {
+                    vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                }
+                #else
+                {
+                    /* If there are no timers in the wheel it can be moved
+                     * straight to the current time, which keeps the new timer in
+                     * as low a level as possible. */
+                    if( prvTimerWheelIsEmpty() != pdFALSE )
+                    {
+                        xTimerWheelTime = xTimeNow;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    prvInsertTimerInWheel( pxTimer );
+                }
+                #endif /* configUSE_TIMER_WHEEL */
             }
         }
 
@@ -757,6 +1008,127 @@
     }
 /*-----------------------------------------------------------*/
 
+    static void prvRemoveTimerFromActiveList( Timer_t * const pxTimer )
+    {
+        #if ( configUSE_TIMER_WHEEL == 0 )
+        {
+            ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+        }
+        #else
+        {
+            List_t * const pxList = listLIST_ITEM_CONTAINER( &( pxTimer->xTimerListItem ) );
+            UBaseType_t uxIndex;
+
+            /* Clear the occupied bit of a wheel slot when the last timer is
+             * removed from it.  The level and slot are recovered from the
+             * position of the list within xTimerWheel. */
+            if( ( uxListRemove( &( pxTimer->xTimerListItem ) ) == ( UBaseType_t ) 0 ) && ( pxList != pxOverflowTimerList ) )
+            {
+                uxIndex = ( UBaseType_t ) ( pxList - &( xTimerWheel[ 0 ][ 0 ] ) );
+                ulTimerWheelOccupied[ uxIndex >> configTIMER_WHEEL_SLOT_BITS ] &= ~( 1UL << ( uxIndex & ( tmrWHEEL_SLOTS - 1U ) ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TIMER_WHEEL */
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static void prvInsertTimerInWheel( Timer_t * const pxTimer )
+        {
+            const TickType_t xNextExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+            TickType_t xDifference = xNextExpiryTime ^ xTimerWheelTime;
+            UBaseType_t uxLevel = 0U;
+            UBaseType_t uxSlot;
+
+            /* Select the level from the most significant group of bits in which
+             * the expiry time differs from the wheel time.  Timers that expire
+             * within the current level 0 revolution go in level 0, and so on. */
+            xDifference >>= configTIMER_WHEEL_SLOT_BITS;
+
+            while( xDifference != ( TickType_t ) 0U )
+            {
+                uxLevel++;
+                xDifference >>= configTIMER_WHEEL_SLOT_BITS;
+            }
+
+            uxSlot = ( UBaseType_t ) ( ( xNextExpiryTime >> ( uxLevel * ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS ) ) & tmrWHEEL_SLOT_MASK );
+
+            /* Timers that share a slot are not sorted.  Inserting at the end
+             * keeps timers that expire at the same time in the order in which
+             * they were started, as vListInsert() does. */
+            vListInsertEnd( &( xTimerWheel[ uxLevel ][ uxSlot ] ), &( pxTimer->xTimerListItem ) );
+            ulTimerWheelOccupied[ uxLevel ] |= ( 1UL << uxSlot );
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static List_t * prvAdvanceTimerWheel( const TickType_t xNewTime )
+        {
+            UBaseType_t uxLevel, uxSlot;
+            List_t * pxSlot;
+            Timer_t * pxTimer;
+
+            xTimerWheelTime = xNewTime;
+
+            /* Any higher level slot indexed by the new wheel time can only be
+             * occupied if the wheel time has just reached the start of that
+             * slot.  Its timers are now closer than the level they are held in
+             * allows, so move them down.  Working from the top level down means a
+             * timer moved down more than one level is handled in this pass too. */
+            for( uxLevel = ( UBaseType_t ) tmrWHEEL_LEVELS - 1U; uxLevel > 0U; uxLevel-- )
+            {
+                uxSlot = ( UBaseType_t ) ( ( xNewTime >> ( uxLevel * ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS ) ) & tmrWHEEL_SLOT_MASK );
+
+                if( ( ulTimerWheelOccupied[ uxLevel ] & ( 1UL << uxSlot ) ) != 0UL )
+                {
+                    pxSlot = &( xTimerWheel[ uxLevel ][ uxSlot ] );
+                    ulTimerWheelOccupied[ uxLevel ] &= ~( 1UL << uxSlot );
+
+                    while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+                    {
+                        pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                        prvInsertTimerInWheel( pxTimer );
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            return &( xTimerWheel[ 0 ][ xNewTime & tmrWHEEL_SLOT_MASK ] );
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static BaseType_t prvTimerWheelIsEmpty( void )
+        {
+            UBaseType_t uxLevel;
+            uint32_t ulOccupied = 0UL;
+
+            for( uxLevel = 0U; uxLevel < ( UBaseType_t ) tmrWHEEL_LEVELS; uxLevel++ )
+            {
+                ulOccupied |= ulTimerWheelOccupied[ uxLevel ];
+            }
+
+            return ( ulOccupied == 0UL ) ? pdTRUE : pdFALSE;
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
     static void prvProcessReceivedCommands( void )
     {
         DaemonTaskMessage_t xMessage;
@@ -799,7 +1171,7 @@
                 if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
                 {
                     /* The timer is in a list, remove it. */
-                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                    prvRemoveTimerFromActiveList( pxTimer );
                 }
                 else
                 {
@@ -908,25 +1280,58 @@
     static void prvSwitchTimerLists( void )
     {
         TickType_t xNextExpireTime;
-        List_t * pxTemp;
+
+        #if ( configUSE_TIMER_WHEEL == 0 )
+            List_t * pxTemp;
+        #endif
 
         /* The tick count has overflowed.  The timer lists must be switched.
          * If there are any timers still referenced from the current timer list
          * then they must have expired and should be processed before the lists
          * are switched. */
-        while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+        #if ( configUSE_TIMER_WHEEL == 0 )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+
+                /* Process the expired timer.  For auto-reload timers, be careful to
+                 * process only expirations that occur on the current list.  Further
+                 * expirations must wait until after the lists are switched. */
+                prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+            }
 
-            /* Process the expired timer.  For auto-reload timers, be careful to
-             * process only expirations that occur on the current list.  Further
-             * expirations must wait until after the lists are switched. */
-            prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+            pxTemp = pxCurrentTimerList;
+            pxCurrentTimerList = pxOverflowTimerList;
+            pxOverflowTimerList = pxTemp;
         }
+        #else /* configUSE_TIMER_WHEEL */
+        {
+            BaseType_t xWheelWasEmpty;
+            Timer_t * pxTimer;
+
+            xNextExpireTime = prvGetNextExpireTime( &xWheelWasEmpty );
 
-        pxTemp = pxCurrentTimerList;
-        pxCurrentTimerList = pxOverflowTimerList;
-        pxOverflowTimerList = pxTemp;
+            while( xWheelWasEmpty == pdFALSE )
+            {
+                /* As above, auto-reload timers are only processed up to the
+                 * point at which the tick count overflowed. */
+                prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+                xNextExpireTime = prvGetNextExpireTime( &xWheelWasEmpty );
+            }
+
+            /* The wheel is now empty, so restart it from the beginning of the
+             * new tick count epoch and move the overflowed timers into it. */
+            xTimerWheelTime = ( TickType_t ) 0U;
+
+            while( listLIST_IS_EMPTY( pxOverflowTimerList ) == pdFALSE )
+            {
+                pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxOverflowTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                prvInsertTimerInWheel( pxTimer );
+            }
+        }
+        #endif /* configUSE_TIMER_WHEEL */
     }
 /*-----------------------------------------------------------*/
 
@@ -939,10 +1344,30 @@
         {
             if( xTimerQueue == NULL )
             {
-                vListInitialise( &xActiveTimerList1 );
-                vListInitialise( &xActiveTimerList2 );
-                pxCurrentTimerList = &xActiveTimerList1;
-                pxOverflowTimerList = &xActiveTimerList2;
+                #if ( configUSE_TIMER_WHEEL == 0 )
+                {
+                    vListInitialise( &xActiveTimerList1 );
+                    vListInitialise( &xActiveTimerList2 );
+                    pxCurrentTimerList = &xActiveTimerList1;
+                    pxOverflowTimerList = &xActiveTimerList2;
+                }
+                #else
+                {
+                    UBaseType_t uxLevel, uxSlot;
+
+                    for( uxLevel = 0U; uxLevel < ( UBaseType_t ) tmrWHEEL_LEVELS; uxLevel++ )
+                    {
+                        for( uxSlot = 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+                        {
+                            vListInitialise( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+                        }
+
+                        ulTimerWheelOccupied[ uxLevel ] = 0UL;
+                    }
+
+                    vListInitialise( &xOverflowTimerList );
+                }
+                #endif /* configUSE_TIMER_WHEEL */
 
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
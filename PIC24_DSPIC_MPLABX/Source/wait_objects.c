@@ -0,0 +1,252 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+#include "wait_objects.h"
+
+/* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021 See comment above. */
+
+/* This file builds to nothing if configUSE_WAIT_OBJECTS is not set to 1. */
+#if ( configUSE_WAIT_OBJECTS == 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the position in pxObjects of the first object that is ready, or
+ * waitOBJECTS_TIMEOUT if none are.
+ */
+    static BaseType_t prvGetReadyObject( const WaitObject_t * const pxObjects,
+                                         UBaseType_t uxObjectCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Record xTask as the task to notify when any of the queues and stream buffers
+ * in pxObjects becomes ready, or stop notifying it if xTask is NULL.
+ */
+    static void prvSetWaitObjectTask( const WaitObject_t * const pxObjects,
+                                      UBaseType_t uxObjectCount,
+                                      TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWaitForMultipleObjects( const WaitObject_t * const pxObjects,
+                                        UBaseType_t uxObjectCount,
+                                        TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn;
+        TimeOut_t xTimeOut;
+        UBaseType_t uxObject, uxNotifyMask = 0;
+        TaskHandle_t const xCurrentTask = xTaskGetCurrentTaskHandle();
+
+        configASSERT( pxObjects );
+        configASSERT( uxObjectCount > ( UBaseType_t ) 0 );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /* Collect the notification indexes that are waited for, so notifying
+         * any of them also notifies configWAIT_OBJECTS_NOTIFY_INDEX. */
+        for( uxObject = 0; uxObject < uxObjectCount; uxObject++ )
+        {
+            if( pxObjects[ uxObject ].eType == eWaitObjectNotification )
+            {
+                configASSERT( pxObjects[ uxObject ].uxIndex < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES );
+                configASSERT( pxObjects[ uxObject ].uxIndex != ( UBaseType_t ) configWAIT_OBJECTS_NOTIFY_INDEX );
+                configASSERT( pxObjects[ uxObject ].uxIndex < ( UBaseType_t ) ( sizeof( UBaseType_t ) * 8U ) );
+
+                uxNotifyMask |= ( UBaseType_t ) 1U << pxObjects[ uxObject ].uxIndex;
+            }
+            else
+            {
+                configASSERT( pxObjects[ uxObject ].pvObject );
+            }
+        }
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in
+         * the interest of execution time efficiency. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                xReturn = prvGetReadyObject( pxObjects, uxObjectCount );
+
+                if( ( xReturn == waitOBJECTS_TIMEOUT ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+                {
+                    /* Nothing is ready, so ask each object to notify this task
+                     * when it becomes ready.  Objects are only ever made ready
+                     * from a critical section, so no object can become ready
+                     * unnoticed between the check above and this point.  Any
+                     * notification left pending from an earlier wait is out of
+                     * date. */
+                    ( void ) xTaskNotifyStateClearIndexed( NULL, configWAIT_OBJECTS_NOTIFY_INDEX );
+                    prvSetWaitObjectTask( pxObjects, uxObjectCount, xCurrentTask );
+                    vTaskSetWaitObjectNotifyMask( uxNotifyMask );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( ( xReturn != waitOBJECTS_TIMEOUT ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+            {
+                traceWAIT_OBJECTS_READY( pxObjects, xReturn );
+                return xReturn;
+            }
+
+            /* Block until one of the objects notifies this task.  If that
+             * happened after the critical section above was exited then the
+             * notification is already pending and the task does not block. */
+            traceBLOCKING_ON_WAIT_OBJECTS( pxObjects, uxObjectCount );
+            ( void ) xTaskNotifyWaitIndexed( configWAIT_OBJECTS_NOTIFY_INDEX, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+
+            taskENTER_CRITICAL();
+            {
+                prvSetWaitObjectTask( pxObjects, uxObjectCount, NULL );
+                vTaskSetWaitObjectNotifyMask( 0 );
+            }
+            taskEXIT_CRITICAL();
+
+            /* Another task might have read from the object that became ready
+             * before this task ran, so look again.  If the block time has
+             * expired look one last time without blocking. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                xTicksToWait = 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        } /*lint -restore */
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvGetReadyObject( const WaitObject_t * const pxObjects,
+                                         UBaseType_t uxObjectCount )
+    {
+        BaseType_t xReturn = waitOBJECTS_TIMEOUT;
+        UBaseType_t uxObject, uxNotifyPending = 0;
+        BaseType_t xNotifyPendingRead = pdFALSE;
+
+        for( uxObject = 0; ( uxObject < uxObjectCount ) && ( xReturn == waitOBJECTS_TIMEOUT ); uxObject++ )
+        {
+            switch( pxObjects[ uxObject ].eType )
+            {
+                case eWaitObjectQueue:
+
+                    if( uxQueueMessagesWaiting( ( QueueHandle_t ) pxObjects[ uxObject ].pvObject ) != ( UBaseType_t ) 0 )
+                    {
+                        xReturn = ( BaseType_t ) uxObject;
+                    }
+
+                    break;
+
+                case eWaitObjectStreamBuffer:
+
+                    if( xStreamBufferIsEmpty( ( StreamBufferHandle_t ) pxObjects[ uxObject ].pvObject ) == pdFALSE )
+                    {
+                        xReturn = ( BaseType_t ) uxObject;
+                    }
+
+                    break;
+
+                case eWaitObjectNotification:
+
+                    /* All the notification states are read at once, and only
+                     * if a notification is waited for. */
+                    if( xNotifyPendingRead == pdFALSE )
+                    {
+                        uxNotifyPending = uxTaskGetNotifyPendingMask();
+                        xNotifyPendingRead = pdTRUE;
+                    }
+
+                    if( ( uxNotifyPending & ( ( UBaseType_t ) 1U << pxObjects[ uxObject ].uxIndex ) ) != ( UBaseType_t ) 0 )
+                    {
+                        xReturn = ( BaseType_t ) uxObject;
+                    }
+
+                    break;
+
+                default:
+
+                    /* Should not get here if all enums are handled. */
+                    configASSERT( pdFALSE );
+                    break;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSetWaitObjectTask( const WaitObject_t * const pxObjects,
+                                      UBaseType_t uxObjectCount,
+                                      TaskHandle_t xTask )
+    {
+        UBaseType_t uxObject;
+
+        for( uxObject = 0; uxObject < uxObjectCount; uxObject++ )
+        {
+            if( pxObjects[ uxObject ].eType == eWaitObjectQueue )
+            {
+                vQueueSetWaitObjectTask( ( QueueHandle_t ) pxObjects[ uxObject ].pvObject, xTask );
+            }
+            else if( pxObjects[ uxObject ].eType == eWaitObjectStreamBuffer )
+            {
+                vStreamBufferSetWaitObjectTask( ( StreamBufferHandle_t ) pxObjects[ uxObject ].pvObject, xTask );
+            }
+            else
+            {
+                /* Notifications are handled by vTaskSetWaitObjectNotifyMask(). */
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_WAIT_OBJECTS */
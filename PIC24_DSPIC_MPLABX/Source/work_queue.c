@@ -0,0 +1,643 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+#include "work_queue.h"
+
+/* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021 See comment above. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include work queue functionality.  This #if is closed at the very bottom
+ * of this file. */
+#if ( configUSE_WORK_QUEUES == 1 )
+
+/* Values of the ulPending work item member. */
+    #define workqueueITEM_IDLE       ( ( uint32_t ) 0UL )
+    #define workqueueITEM_PENDING    ( ( uint32_t ) 1UL )
+
+    #if ( configWORK_QUEUE_USE_ATOMICS == 1 )
+
+/* Work items are added to and removed from a work queue using atomic.h, so no
+ * critical section is needed around prvPushWorkItem() and prvTakeWorkItems(). */
+        #define workqueueCOMPARE_AND_SWAP( pulDestination, ulExchange, ulComparand )               Atomic_CompareAndSwap_u32( ( pulDestination ), ( ulExchange ), ( ulComparand ) )
+        #define workqueueCOMPARE_AND_SWAP_POINTERS( ppvDestination, pvExchange, pvComparand )    Atomic_CompareAndSwapPointers_p32( ( ppvDestination ), ( pvExchange ), ( pvComparand ) )
+        #define workqueueSWAP_POINTERS( ppvDestination, pvExchange )                               Atomic_SwapPointers_p32( ( ppvDestination ), ( pvExchange ) )
+        #define workqueueENTER_CRITICAL()
+        #define workqueueEXIT_CRITICAL()
+        #define workqueueSET_INTERRUPT_MASK_FROM_ISR()                                             ( ( UBaseType_t ) 0 )
+        #define workqueueCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedStatusValue )                       ( void ) ( uxSavedStatusValue )
+    #else
+
+/* The port cannot use atomic.h from both tasks and interrupts (see the
+ * definition of configPOOL_USE_ATOMICS in FreeRTOS.h), so prvPushWorkItem() and
+ * prvTakeWorkItems() are called from inside a critical section, and the compare
+ * and swap operations always succeed. */
+        #define workqueueCOMPARE_AND_SWAP( pulDestination, ulExchange, ulComparand )               ( ( *( pulDestination ) == ( ulComparand ) ) ? ( ( *( pulDestination ) = ( ulExchange ) ), ATOMIC_COMPARE_AND_SWAP_SUCCESS ) : ATOMIC_COMPARE_AND_SWAP_FAILURE )
+        #define workqueueCOMPARE_AND_SWAP_POINTERS( ppvDestination, pvExchange, pvComparand )    ( ( *( ppvDestination ) = ( pvExchange ) ), ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+        #define workqueueSWAP_POINTERS( ppvDestination, pvExchange )                               prvSwapPointers( ( ppvDestination ), ( pvExchange ) )
+        #define workqueueENTER_CRITICAL()                                                          taskENTER_CRITICAL()
+        #define workqueueEXIT_CRITICAL()                                                           taskEXIT_CRITICAL()
+        #define workqueueSET_INTERRUPT_MASK_FROM_ISR()                                             portSET_INTERRUPT_MASK_FROM_ISR()
+        #define workqueueCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedStatusValue )                       portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedStatusValue )
+    #endif /* configWORK_QUEUE_USE_ATOMICS */
+
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            #define workqueueGET_RUN_TIME_COUNTER_VALUE( ulCounter )    portALT_GET_RUN_TIME_COUNTER_VALUE( ( ulCounter ) )
+        #else
+            #define workqueueGET_RUN_TIME_COUNTER_VALUE( ulCounter )    ( ulCounter ) = portGET_RUN_TIME_COUNTER_VALUE()
+        #endif
+    #endif
+
+/*
+ * Definition of a work item.
+ */
+    typedef struct WorkItemDefinition
+    {
+        struct WorkItemDefinition * pxNext;           /*< The next work item waiting to run on the same work queue. */
+        WorkFunction_t pxFunction;                    /*< The function the work item runs. */
+        void * pvParameter1;                          /*< Passed to pxFunction as its first parameter. */
+        uint32_t ulParameter2;                        /*< Passed to pxFunction as its second parameter. */
+        volatile uint32_t ulPending;                  /*< workqueueITEM_PENDING from when the work item is submitted until its function starts to run. */
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            configRUN_TIME_COUNTER_TYPE ulSubmitTime; /*< The value of the run time counter when the work item was submitted. */
+        #endif
+    } WorkItem_t;
+
+/*
+ * Definition of a work queue.
+ */
+    typedef struct WorkQueueDefinition
+    {
+        void * volatile pvPendingItems;                     /*< The work items waiting to run, most recently submitted first. */
+        TaskHandle_t xTask;                                 /*< The task that runs the work items. */
+        uint32_t ulItemsRun;                                /*< The number of work items run. */
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            configRUN_TIME_COUNTER_TYPE ulTotalLatency;     /*< The sum of the time each work item run waited to start. */
+            configRUN_TIME_COUNTER_TYPE ulMaxLatency;       /*< The longest time any work item run waited to start. */
+        #endif
+    } WorkQueue_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The task created for each work queue.  It waits to be notified that work
+ * items have been submitted, then runs them in the order they were submitted.
+ */
+    static portTASK_FUNCTION_PROTO( prvWorkQueueTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds a work item to the head of a work queue's list of pending work items,
+ * and returns pdTRUE if the list was empty before the work item was added - in
+ * which case the work queue's task must be notified.  If
+ * configWORK_QUEUE_USE_ATOMICS is 1 this can be called from tasks and
+ * interrupts without a critical section.
+ */
+    static BaseType_t prvPushWorkItem( WorkQueue_t * const pxWorkQueue,
+                                       WorkItem_t * const pxWorkItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes all the pending work items from a work queue and returns them in the
+ * order in which they were submitted.
+ */
+    static WorkItem_t * prvTakeWorkItems( WorkQueue_t * const pxWorkQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Sets the members of a newly created work queue to their initial values.
+ */
+    static void prvInitialiseNewWorkQueue( WorkQueue_t * const pxWorkQueue ) PRIVILEGED_FUNCTION;
+
+    #if ( configWORK_QUEUE_USE_ATOMICS != 1 )
+
+/*
+ * Used in place of Atomic_SwapPointers_p32() when the caller is already inside
+ * a critical section.
+ */
+        static void * prvSwapPointers( void * volatile * ppvDestination,
+                                       void * pvExchange ) PRIVILEGED_FUNCTION;
+    #endif
+
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        WorkQueueHandle_t xWorkQueueCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                            UBaseType_t uxPriority,
+                                            configSTACK_DEPTH_TYPE usStackDepth )
+        {
+            WorkQueue_t * pxNewWorkQueue;
+
+            pxNewWorkQueue = ( WorkQueue_t * ) pvPortMalloc( sizeof( WorkQueue_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of WorkQueue_t is always a pointer. */
+
+            if( pxNewWorkQueue != NULL )
+            {
+                prvInitialiseNewWorkQueue( pxNewWorkQueue );
+
+                if( xTaskCreate( prvWorkQueueTask,
+                                 pcName,
+                                 usStackDepth,
+                                 ( void * ) pxNewWorkQueue,
+                                 uxPriority | portPRIVILEGE_BIT,
+                                 &( pxNewWorkQueue->xTask ) ) != pdPASS )
+                {
+                    vPortFree( pxNewWorkQueue );
+                    pxNewWorkQueue = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pxNewWorkQueue != NULL )
+            {
+                traceWORK_QUEUE_CREATE( pxNewWorkQueue );
+            }
+            else
+            {
+                traceWORK_QUEUE_CREATE_FAILED();
+            }
+
+            return pxNewWorkQueue;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        WorkQueueHandle_t xWorkQueueCreateStatic( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                                  UBaseType_t uxPriority,
+                                                  uint32_t ulStackDepth,
+                                                  StackType_t * const puxStackBuffer,
+                                                  StaticTask_t * const pxTaskBuffer,
+                                                  StaticWorkQueue_t * const pxWorkQueueBuffer )
+        {
+            WorkQueue_t * pxNewWorkQueue = NULL;
+
+            configASSERT( puxStackBuffer != NULL );
+            configASSERT( pxTaskBuffer != NULL );
+            configASSERT( pxWorkQueueBuffer != NULL );
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticWorkQueue_t equals the size of the real
+                 * work queue structure. */
+                volatile size_t xSize = sizeof( StaticWorkQueue_t );
+                configASSERT( xSize == sizeof( WorkQueue_t ) );
+            } /*lint !e529 xSize is referenced if configASSERT() is defined. */
+            #endif /* configASSERT_DEFINED */
+
+            if( ( puxStackBuffer != NULL ) && ( pxTaskBuffer != NULL ) && ( pxWorkQueueBuffer != NULL ) )
+            {
+                pxNewWorkQueue = ( WorkQueue_t * ) pxWorkQueueBuffer; /*lint !e740 !e9087 WorkQueue_t and StaticWorkQueue_t are deliberately aliased for data hiding purposes and guaranteed to have the same size and alignment requirement - checked by configASSERT(). */
+                prvInitialiseNewWorkQueue( pxNewWorkQueue );
+
+                pxNewWorkQueue->xTask = xTaskCreateStatic( prvWorkQueueTask,
+                                                           pcName,
+                                                           ulStackDepth,
+                                                           ( void * ) pxNewWorkQueue,
+                                                           uxPriority | portPRIVILEGE_BIT,
+                                                           puxStackBuffer,
+                                                           pxTaskBuffer );
+
+                if( pxNewWorkQueue->xTask == NULL )
+                {
+                    pxNewWorkQueue = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pxNewWorkQueue != NULL )
+            {
+                traceWORK_QUEUE_CREATE( pxNewWorkQueue );
+            }
+            else
+            {
+                traceWORK_QUEUE_CREATE_FAILED();
+            }
+
+            return pxNewWorkQueue;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseNewWorkQueue( WorkQueue_t * const pxWorkQueue )
+    {
+        pxWorkQueue->pvPendingItems = NULL;
+        pxWorkQueue->xTask = NULL;
+        pxWorkQueue->ulItemsRun = 0;
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            pxWorkQueue->ulTotalLatency = 0;
+            pxWorkQueue->ulMaxLatency = 0;
+        }
+        #endif
+    }
+/*-----------------------------------------------------------*/
+
+    WorkItemHandle_t xWorkItemCreateStatic( WorkFunction_t pxFunction,
+                                            void * pvParameter1,
+                                            uint32_t ulParameter2,
+                                            StaticWorkItem_t * const pxWorkItemBuffer )
+    {
+        WorkItem_t * const pxWorkItem = ( WorkItem_t * ) pxWorkItemBuffer; /*lint !e740 !e9087 WorkItem_t and StaticWorkItem_t are deliberately aliased for data hiding purposes and guaranteed to have the same size and alignment requirement - checked by configASSERT(). */
+
+        configASSERT( pxFunction != NULL );
+        configASSERT( pxWorkItemBuffer != NULL );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticWorkItem_t equals the size of the real work
+             * item structure. */
+            volatile size_t xSize = sizeof( StaticWorkItem_t );
+            configASSERT( xSize == sizeof( WorkItem_t ) );
+        } /*lint !e529 xSize is referenced if configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        if( pxWorkItem != NULL )
+        {
+            pxWorkItem->pxNext = NULL;
+            pxWorkItem->pxFunction = pxFunction;
+            pxWorkItem->pvParameter1 = pvParameter1;
+            pxWorkItem->ulParameter2 = ulParameter2;
+            pxWorkItem->ulPending = workqueueITEM_IDLE;
+
+            #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            {
+                pxWorkItem->ulSubmitTime = 0;
+            }
+            #endif
+        }
+
+        return pxWorkItem;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvPushWorkItem( WorkQueue_t * const pxWorkQueue,
+                                       WorkItem_t * const pxWorkItem )
+    {
+        void * pvHead;
+
+        /* The list of pending work items is only ever removed from as a whole,
+         * by prvTakeWorkItems(), so the head of the list cannot be removed and
+         * put back between it being read and the compare and swap below (the
+         * 'ABA' problem cannot occur). */
+        do
+        {
+            pvHead = pxWorkQueue->pvPendingItems;
+            pxWorkItem->pxNext = ( WorkItem_t * ) pvHead;
+        } while( workqueueCOMPARE_AND_SWAP_POINTERS( &( pxWorkQueue->pvPendingItems ), ( void * ) pxWorkItem, pvHead ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS );
+
+        return ( pvHead == NULL ) ? pdTRUE : pdFALSE;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configWORK_QUEUE_USE_ATOMICS != 1 )
+
+        static void * prvSwapPointers( void * volatile * ppvDestination,
+                                       void * pvExchange )
+        {
+            void * pvReturn = *ppvDestination;
+
+            *ppvDestination = pvExchange;
+
+            return pvReturn;
+        }
+
+    #endif /* configWORK_QUEUE_USE_ATOMICS */
+/*-----------------------------------------------------------*/
+
+    static WorkItem_t * prvTakeWorkItems( WorkQueue_t * const pxWorkQueue )
+    {
+        WorkItem_t * pxItem;
+        WorkItem_t * pxNext;
+        WorkItem_t * pxReversed = NULL;
+
+        workqueueENTER_CRITICAL();
+        {
+            pxItem = ( WorkItem_t * ) workqueueSWAP_POINTERS( &( pxWorkQueue->pvPendingItems ), NULL );
+        }
+        workqueueEXIT_CRITICAL();
+
+        /* The list is held most recently submitted first, so reverse it to run
+         * the work items in the order in which they were submitted.  No other
+         * task or interrupt can access these work items until their ulPending
+         * members are cleared. */
+        while( pxItem != NULL )
+        {
+            pxNext = pxItem->pxNext;
+            pxItem->pxNext = pxReversed;
+            pxReversed = pxItem;
+            pxItem = pxNext;
+        }
+
+        return pxReversed;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue,
+                                 WorkItemHandle_t xWorkItem )
+    {
+        WorkQueue_t * const pxWorkQueue = xWorkQueue;
+        WorkItem_t * const pxWorkItem = xWorkItem;
+        BaseType_t xReturn = pdFAIL;
+        BaseType_t xNotify = pdFALSE;
+
+        configASSERT( pxWorkQueue );
+        configASSERT( pxWorkItem );
+
+        workqueueENTER_CRITICAL();
+        {
+            /* Only the caller that moves the work item from idle to pending
+             * may add it to the list, so a work item is never on a list twice. */
+            if( workqueueCOMPARE_AND_SWAP( &( pxWorkItem->ulPending ), workqueueITEM_PENDING, workqueueITEM_IDLE ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+            {
+                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                {
+                    workqueueGET_RUN_TIME_COUNTER_VALUE( pxWorkItem->ulSubmitTime );
+                }
+                #endif
+
+                xNotify = prvPushWorkItem( pxWorkQueue, pxWorkItem );
+                xReturn = pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        workqueueEXIT_CRITICAL();
+
+        traceWORK_QUEUE_SUBMIT( pxWorkQueue, pxWorkItem, xReturn );
+
+        /* The work queue's task only needs to be notified when the list was
+         * empty, as otherwise it has already been notified and has not yet
+         * taken the list. */
+        if( xNotify != pdFALSE )
+        {
+            ( void ) xTaskNotifyGive( pxWorkQueue->xTask );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue,
+                                        WorkItemHandle_t xWorkItem,
+                                        BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        WorkQueue_t * const pxWorkQueue = xWorkQueue;
+        WorkItem_t * const pxWorkItem = xWorkItem;
+        BaseType_t xReturn = pdFAIL;
+        BaseType_t xNotify = pdFALSE;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( pxWorkQueue );
+        configASSERT( pxWorkItem );
+
+        /* See the comments in xQueueGenericSendFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = workqueueSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( workqueueCOMPARE_AND_SWAP( &( pxWorkItem->ulPending ), workqueueITEM_PENDING, workqueueITEM_IDLE ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+            {
+                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                {
+                    workqueueGET_RUN_TIME_COUNTER_VALUE( pxWorkItem->ulSubmitTime );
+                }
+                #endif
+
+                xNotify = prvPushWorkItem( pxWorkQueue, pxWorkItem );
+                xReturn = pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        workqueueCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        traceWORK_QUEUE_SUBMIT_FROM_ISR( pxWorkQueue, pxWorkItem, xReturn );
+
+        if( xNotify != pdFALSE )
+        {
+            vTaskNotifyGiveFromISR( pxWorkQueue->xTask, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static portTASK_FUNCTION( prvWorkQueueTask, pvParameters )
+    {
+        WorkQueue_t * const pxWorkQueue = ( WorkQueue_t * ) pvParameters;
+        WorkItem_t * pxWorkItem;
+        WorkItem_t * pxNext;
+        WorkFunction_t pxFunction;
+        void * pvParameter1;
+        uint32_t ulParameter2;
+        uint32_t ulItemsRun;
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            configRUN_TIME_COUNTER_TYPE ulNow, ulLatency, ulTotalLatency, ulMaxLatency;
+        #endif
+
+        for( ; ; )
+        {
+            /* Wait to be notified that the list of pending work items has
+             * changed from empty to not empty.  The notification value can be
+             * left non-zero after the list has already been taken, in which
+             * case the list is found to be empty and this task waits again. */
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+            pxWorkItem = prvTakeWorkItems( pxWorkQueue );
+            ulItemsRun = 0;
+
+            #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            {
+                ulTotalLatency = 0;
+                ulMaxLatency = 0;
+            }
+            #endif
+
+            while( pxWorkItem != NULL )
+            {
+                /* Copy everything needed from the work item before marking it
+                 * as idle, as from then on it can be submitted again, possibly
+                 * from an interrupt, or to a different work queue. */
+                pxNext = pxWorkItem->pxNext;
+                pxFunction = pxWorkItem->pxFunction;
+                pvParameter1 = pxWorkItem->pvParameter1;
+                ulParameter2 = pxWorkItem->ulParameter2;
+
+                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                {
+                    workqueueGET_RUN_TIME_COUNTER_VALUE( ulNow );
+                    ulLatency = ulNow - pxWorkItem->ulSubmitTime;
+                    ulTotalLatency += ulLatency;
+
+                    if( ulLatency > ulMaxLatency )
+                    {
+                        ulMaxLatency = ulLatency;
+                    }
+                }
+                #endif /* configGENERATE_RUN_TIME_STATS */
+
+                traceWORK_QUEUE_RUN_ITEM( pxWorkQueue, pxWorkItem );
+                pxWorkItem->ulPending = workqueueITEM_IDLE;
+
+                pxFunction( pvParameter1, ulParameter2 );
+
+                ulItemsRun++;
+                pxWorkItem = pxNext;
+            }
+
+            /* The statistics are only written by this task, and are updated
+             * once per batch of work items so vWorkQueueGetStats() never sees
+             * a partial update. */
+            if( ulItemsRun != 0UL )
+            {
+                taskENTER_CRITICAL();
+                {
+                    pxWorkQueue->ulItemsRun += ulItemsRun;
+
+                    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                    {
+                        pxWorkQueue->ulTotalLatency += ulTotalLatency;
+
+                        if( ulMaxLatency > pxWorkQueue->ulMaxLatency )
+                        {
+                            pxWorkQueue->ulMaxLatency = ulMaxLatency;
+                        }
+                    }
+                    #endif
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWorkItemIsPending( WorkItemHandle_t xWorkItem )
+    {
+        const WorkItem_t * const pxWorkItem = xWorkItem;
+
+        configASSERT( pxWorkItem );
+
+        return ( pxWorkItem->ulPending == workqueueITEM_PENDING ) ? pdTRUE : pdFALSE;
+    }
+/*-----------------------------------------------------------*/
+
+    void vWorkQueueGetStats( WorkQueueHandle_t xWorkQueue,
+                             WorkQueueStats_t * pxStats )
+    {
+        const WorkQueue_t * const pxWorkQueue = xWorkQueue;
+
+        configASSERT( pxWorkQueue );
+        configASSERT( pxStats );
+
+        taskENTER_CRITICAL();
+        {
+            pxStats->ulItemsRun = pxWorkQueue->ulItemsRun;
+
+            #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            {
+                pxStats->ulTotalLatency = pxWorkQueue->ulTotalLatency;
+                pxStats->ulMaxLatency = pxWorkQueue->ulMaxLatency;
+            }
+            #else
+            {
+                pxStats->ulTotalLatency = 0;
+                pxStats->ulMaxLatency = 0;
+            }
+            #endif
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    TaskHandle_t xWorkQueueGetTaskHandle( WorkQueueHandle_t xWorkQueue )
+    {
+        const WorkQueue_t * const pxWorkQueue = xWorkQueue;
+
+        configASSERT( pxWorkQueue );
+
+        return pxWorkQueue->xTask;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include work queue functionality.  If you want to include work queues then
+ * ensure configUSE_WORK_QUEUES is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_WORK_QUEUES == 1 */